@@ -0,0 +1,559 @@
+#include "Benchmark.h"
+#include "common/JobSystem.h"
+#include "core/GeometryCompression.h"
+#include "core/Object3D.h"
+#include "ecs/TransformWorld.h"
+#include "extras/Earcut.h"
+#include "extras/curves/CatmullRomCurve3.h"
+#include "geometries/ExtrudeGeometry.h"
+#include "math/Box3.h"
+#include "math/Color.h"
+#include "math/FloatingOrigin.h"
+#include "math/Frustum.h"
+#include "math/Matrix4.h"
+#include "math/Quaternion.h"
+#include "math/Triangle.h"
+#include "math/Vector3.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Batch kernels over float buffers. These take their SIMD path from the
+// instruction set the binary targets, so the per-ISA variants of
+// threecpp_bench compare them directly.
+
+static std::vector<float> sampleFloats(size_t count, float scale = 1)
+{
+    std::vector<float> values(count);
+    uint32_t seed = 12345;
+    for (float &value : values)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        value = ((seed >> 8) * (1.0f / 16777216.0f)) * scale;
+    }
+    return values;
+}
+
+static void Matrix4MultiplyMatricesArray(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<float> a = sampleFloats(16 * count), b = sampleFloats(16 * count);
+    std::vector<float> out(16 * count);
+
+    while (state.keepRunning())
+    {
+        Matrix4::multiplyMatricesArray(out.data(), a.data(), b.data(), count);
+        Benchmark::doNotOptimize(out.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(Matrix4MultiplyMatricesArray).range(64, 65536, 32);
+
+static void FrustumIntersectsSpheres(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    Matrix4 projection;
+    projection.makePerspective(-1, 1, 1, -1, 1, 1000);
+    Frustum frustum;
+    frustum.setFromProjectionMatrix(projection);
+
+    std::vector<float> spheres = sampleFloats(4 * count, 200);
+    for (size_t i = 0; i < count; i++)
+    {
+        spheres[4 * i + 0] -= 100;
+        spheres[4 * i + 1] -= 100;
+        spheres[4 * i + 2] = -spheres[4 * i + 2] * 5;
+        spheres[4 * i + 3] *= 0.01f;
+    }
+    std::vector<uint32_t> visible(count);
+
+    while (state.keepRunning())
+        Benchmark::doNotOptimize(frustum.intersectsSpheres(spheres.data(), count, visible.data()));
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(FrustumIntersectsSpheres).range(1024, 1 << 20, 32);
+
+static void ColorSRGBToLinear(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<float> values = sampleFloats(count);
+    std::vector<float> result(count);
+
+    while (state.keepRunning())
+    {
+        Color::SRGBToLinear(values, result);
+        Benchmark::doNotOptimize(result.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+    state.setBytesProcessed(state.iterations() * count * sizeof(float));
+}
+THREECPP_BENCHMARK(ColorSRGBToLinear).arg(1 << 16);
+
+static void ColorLinearToSRGB(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<float> values = sampleFloats(count);
+    std::vector<float> result(count);
+
+    while (state.keepRunning())
+    {
+        Color::LinearToSRGB(values, result);
+        Benchmark::doNotOptimize(result.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+    state.setBytesProcessed(state.iterations() * count * sizeof(float));
+}
+THREECPP_BENCHMARK(ColorLinearToSRGB).arg(1 << 16);
+
+static void GeometryCompressionDecodePositions(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const Box3 bounds(Vector3(-1, -1, -1), Vector3(1, 1, 1));
+    std::vector<float> positions = sampleFloats(3 * count, 2);
+    for (float &value : positions)
+        value -= 1;
+    std::vector<uint16_t> quantized(3 * count);
+    GeometryCompression::encodePositions(positions, bounds, quantized);
+
+    while (state.keepRunning())
+    {
+        GeometryCompression::decodePositions(quantized, bounds, positions);
+        Benchmark::doNotOptimize(positions.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(GeometryCompressionDecodePositions).arg(1 << 16);
+
+static void GeometryCompressionDecodeOctahedral(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<float> normals = sampleFloats(3 * count, 2);
+    for (size_t i = 0; i < count; i++)
+    {
+        float *n = &normals[3 * i];
+        n[0] -= 1, n[1] -= 1, n[2] -= 1;
+        const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) + 1e-6f;
+        n[0] /= length, n[1] /= length, n[2] /= length;
+    }
+    std::vector<int16_t> encoded(2 * count);
+    GeometryCompression::encodeOctahedral(normals, encoded);
+
+    while (state.keepRunning())
+    {
+        GeometryCompression::decodeOctahedral(std::span<const int16_t>(encoded), normals);
+        Benchmark::doNotOptimize(normals.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(GeometryCompressionDecodeOctahedral).arg(1 << 16);
+
+static void GeometryCompressionDecodeHalf(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<float> values = sampleFloats(count, 100);
+    std::vector<uint16_t> halves(count);
+    GeometryCompression::encodeHalf(values, halves);
+
+    while (state.keepRunning())
+    {
+        GeometryCompression::decodeHalf(halves, values);
+        Benchmark::doNotOptimize(values.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(GeometryCompressionDecodeHalf).arg(1 << 16);
+
+static void FloatingOriginRebaseMatrices(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    std::vector<double> world(16 * count, 0.0);
+    for (size_t i = 0; i < count; i++)
+    {
+        double *m = world.data() + 16 * i;
+        m[0] = m[5] = m[10] = m[15] = 1;
+        m[12] = 6.4e6 + static_cast<double>(i);
+        m[13] = -3.1e6;
+        m[14] = 1.2e6;
+    }
+    std::vector<float> out(16 * count);
+
+    FloatingOrigin origin;
+    origin.update({6.4e6, -3.1e6, 1.2e6});
+
+    while (state.keepRunning())
+    {
+        origin.rebaseMatrices(world, out);
+        Benchmark::doNotOptimize(out.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(FloatingOriginRebaseMatrices).range(1024, 1 << 18, 16);
+
+static void FloatingOriginRebaseSplitPositions(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    std::vector<double> positions(3 * count);
+    for (size_t i = 0; i < positions.size(); i++)
+        positions[i] = 6.4e6 + static_cast<double>(i) * 0.001;
+    std::vector<float> high(positions.size()), low(positions.size()), out(positions.size());
+    FloatingOrigin::split(positions, high, low);
+
+    FloatingOrigin origin;
+    origin.update({6.4e6, 6.4e6, 6.4e6});
+
+    while (state.keepRunning())
+    {
+        origin.rebaseSplitPositions(high, low, out);
+        Benchmark::doNotOptimize(out.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(FloatingOriginRebaseSplitPositions).arg(1 << 16);
+
+// A camera rail / tube path sampled at equal arc-length steps: one point at a
+// time through a cursor versus one batch with tangents.
+
+static CatmullRomCurve3 sampleRail()
+{
+    std::vector<Vector3> points;
+    for (int i = 0; i < 256; i++)
+        points.emplace_back(i * 4.0, std::sin(i * 0.1) * 20, std::cos(i * 0.07) * 10);
+
+    CatmullRomCurve3 rail(points);
+    rail.setArcLengthDivisions(4096);
+    rail.getLength();
+    return rail;
+}
+
+static void CurveCursorGetPointAt(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const CatmullRomCurve3 rail = sampleRail();
+
+    while (state.keepRunning())
+    {
+        Curve::Cursor cursor(rail);
+        HIGH_PRECISION sum = 0;
+        for (size_t i = 0; i < count; i++)
+            sum += cursor.getPointAt(static_cast<HIGH_PRECISION>(i) / (count - 1)).x();
+        Benchmark::doNotOptimize(sum);
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(CurveCursorGetPointAt).arg(1 << 16);
+
+static void CurveEvaluateAt(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const CatmullRomCurve3 rail = sampleRail();
+
+    std::vector<float> u(count), points(count * 3), tangents(count * 3);
+    for (size_t i = 0; i < count; i++)
+        u[i] = static_cast<float>(i) / static_cast<float>(count - 1);
+
+    while (state.keepRunning())
+    {
+        rail.evaluateAt(u, points, tangents);
+        Benchmark::doNotOptimize(points.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(CurveEvaluateAt).arg(1 << 16);
+
+static void CurveComputeFrenetFrames(Benchmark::State &state)
+{
+    const size_t segments = static_cast<size_t>(state.range(0));
+    const CatmullRomCurve3 rail = sampleRail();
+
+    std::vector<float> tangents((segments + 1) * 3), normals((segments + 1) * 3), binormals((segments + 1) * 3);
+
+    while (state.keepRunning())
+    {
+        rail.computeFrenetFrames(segments, false, tangents, normals, binormals);
+        Benchmark::doNotOptimize(normals.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * segments);
+}
+THREECPP_BENCHMARK(CurveComputeFrenetFrames).arg(4096);
+
+// A ring of `n` vertices with a wavy edge, so ears are not trivially convex;
+// above 80 vertices earcut switches to its z-order hash.
+
+static std::vector<double> samplePolygon(size_t n)
+{
+    std::vector<double> data;
+    for (size_t i = 0; i < n; i++)
+    {
+        const double angle = MATH_PI * 2 * static_cast<double>(i) / static_cast<double>(n);
+        const double radius = 10 + std::sin(angle * 17);
+        data.push_back(radius * std::cos(angle));
+        data.push_back(radius * std::sin(angle));
+    }
+    return data;
+}
+
+static void EarcutTriangulate(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const std::vector<double> data = samplePolygon(count);
+    std::vector<uint32_t> triangles;
+
+    while (state.keepRunning())
+    {
+        Earcut::triangulate(data, {}, triangles);
+        Benchmark::doNotOptimize(triangles.data());
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(EarcutTriangulate).range(16, 4096, 16);
+
+// A map tile of building footprints with a courtyard, extruded in one batch.
+
+static void ExtrudeGeometryFootprints(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    Shape footprint({{0, 0}, {20, 0}, {20, 12}, {12, 16}, {0, 12}});
+    footprint.holes().push_back(Path({{8, 4}, {12, 4}, {12, 8}, {8, 8}}));
+
+    std::vector<Shape> shapes(count, footprint);
+    std::vector<Matrix3> transforms(count);
+    for (size_t i = 0; i < count; i++)
+        transforms[i].translate(static_cast<HIGH_PRECISION>(i % 64) * 30, static_cast<HIGH_PRECISION>(i / 64) * 30);
+
+    ExtrudeGeometry::Options options;
+    options.depth = 30;
+    options.bevelSegments = 2;
+
+    while (state.keepRunning())
+    {
+        ExtrudeGeometry geometry(shapes, options, transforms);
+        Benchmark::doNotOptimize(geometry.getIndex().data());
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(ExtrudeGeometryFootprints).arg(4096);
+
+// BVH leaf processing: the nearest of a run of triangles to a query point,
+// and attribute interpolation at a batch of picking hits.
+
+static Triangle::Arrays sampleTriangles(size_t count)
+{
+    Triangle::Arrays triangles;
+    triangles.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const HIGH_PRECISION x = static_cast<HIGH_PRECISION>(i % 256);
+        const HIGH_PRECISION z = static_cast<HIGH_PRECISION>(i / 256);
+        triangles.push(Triangle(Vector3(x, std::sin(x * 0.1), z), Vector3(x + 1, 0, z), Vector3(x, std::cos(z * 0.1), z + 1)));
+    }
+
+    return triangles;
+}
+
+static void TriangleNearestToPoint(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const Triangle::Arrays triangles = sampleTriangles(count);
+    const Vector3 point(100.3, 2, 3.7);
+    Vector3 target;
+
+    while (state.keepRunning())
+    {
+        float distanceSq = std::numeric_limits<float>::infinity();
+        Benchmark::doNotOptimize(Triangle::nearestToPoint(triangles, 0, count, point, target, distanceSq));
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(TriangleNearestToPoint).range(16, 4096, 16);
+
+static void TriangleInterpolateAttribute(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    const size_t vertexCount = 1 << 16;
+
+    std::vector<float> normals(vertexCount * 3);
+    for (size_t i = 0; i < normals.size(); i++)
+        normals[i] = std::sin(static_cast<float>(i));
+
+    std::vector<uint32_t> index((vertexCount - 2) * 3);
+    for (size_t i = 0; i < index.size(); i++)
+        index[i] = static_cast<uint32_t>(i / 3 + i % 3);
+
+    std::vector<uint32_t> faces(count);
+    std::vector<float> barycoords(count * 3);
+    for (size_t i = 0; i < count; i++)
+    {
+        faces[i] = static_cast<uint32_t>((i * 7919) % (vertexCount - 2));
+        barycoords[i * 3 + 0] = 0.2f;
+        barycoords[i * 3 + 1] = 0.3f;
+        barycoords[i * 3 + 2] = 0.5f;
+    }
+
+    std::vector<float> target(count * 3);
+
+    while (state.keepRunning())
+    {
+        Triangle::interpolateAttribute(faces, barycoords, index, normals, 3, target);
+        Benchmark::doNotOptimize(target.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(TriangleInterpolateAttribute).arg(1 << 16);
+
+// Thread scaling of the job system on a fixed compute-bound workload. Counts
+// above the hardware concurrency are labelled, as they only show the cost of
+// oversubscription.
+
+static void JobSystemParallelFor(Benchmark::State &state)
+{
+    const size_t threads = static_cast<size_t>(state.range(0));
+    const size_t count = 1 << 20;
+    const std::vector<float> values = sampleFloats(count);
+    std::vector<float> result(count);
+
+    JobSystem jobs(threads);
+    while (state.keepRunning())
+    {
+        jobs.parallelFor(0, count, [&](size_t begin, size_t end)
+                         {
+                             for (size_t i = begin; i < end; i++)
+                                 result[i] = std::sqrt(values[i]) * std::sin(values[i]) + std::exp(-values[i]); });
+        Benchmark::doNotOptimize(result.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+    if (threads > std::max(1u, std::thread::hardware_concurrency()))
+        state.setLabel("oversubscribed");
+}
+THREECPP_BENCHMARK(JobSystemParallelFor).range(1, 64, 2);
+
+// Transform propagation of a three level hierarchy: the data-oriented world
+// against the Object3D graph. Every root has ten children with ten children
+// each.
+
+static const size_t FANOUT = 10;
+
+static void TransformWorldUpdate(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    // percentage of entities moved every frame
+    const int64_t changed = state.range(1);
+
+    TransformWorld world;
+    std::vector<TransformWorld::Entity> entities;
+    entities.reserve(count);
+    for (size_t root = 0; entities.size() < count; root++)
+    {
+        const auto parent = world.create();
+        entities.push_back(parent);
+        for (size_t i = 0; i < FANOUT && entities.size() < count; i++)
+        {
+            const auto child = world.create(TransformWorld::TRS, parent);
+            entities.push_back(child);
+            for (size_t j = 0; j < FANOUT && entities.size() < count; j++)
+                entities.push_back(world.create(TransformWorld::TRS, child));
+        }
+    }
+    for (size_t i = 0; i < entities.size(); i++)
+        world.setPosition(entities[i], Vector3(i % 7, i % 5, i % 3));
+    world.update();
+
+    const size_t step = changed > 0 ? 100 / changed : 0;
+    size_t frame = 0;
+    while (state.keepRunning())
+    {
+        if (step > 0)
+        {
+            state.pauseTiming();
+            for (size_t i = frame % step; i < entities.size(); i += step)
+                world.setPosition(entities[i], Vector3(frame % 7, i % 5, 1));
+            frame++;
+            state.resumeTiming();
+        }
+
+        world.update();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(TransformWorldUpdate)
+    .args({100000, 100})
+    .args({100000, 1})
+    .args({100000, 0})
+    .args({1000000, 100})
+    .args({1000000, 1})
+    .args({1000000, 0})
+    .iterations(10);
+
+static void Object3DUpdateMatrixWorld(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    std::vector<std::shared_ptr<Object3D>> roots;
+    size_t created = 0;
+    while (created < count)
+    {
+        auto root = std::make_shared<Object3D>();
+        created++;
+        for (size_t i = 0; i < FANOUT && created < count; i++)
+        {
+            auto child = std::make_shared<Object3D>();
+            child->position().set(i % 7, i % 5, i % 3);
+            root->add(child);
+            created++;
+            for (size_t j = 0; j < FANOUT && created < count; j++)
+            {
+                auto grandchild = std::make_shared<Object3D>();
+                grandchild->position().set(j % 7, j % 5, j % 3);
+                child->add(grandchild);
+                created++;
+            }
+        }
+        roots.push_back(root);
+    }
+
+    while (state.keepRunning())
+    {
+        for (const auto &root : roots)
+            root->updateMatrixWorld(true);
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK(Object3DUpdateMatrixWorld).arg(100000).arg(1000000).iterations(3);
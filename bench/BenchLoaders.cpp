@@ -0,0 +1,350 @@
+#include "Benchmark.h"
+#include "core/BufferGeometry.h"
+#include "loaders/OBJLoader.h"
+#include "loaders/PLYLoader.h"
+#include "loaders/STLLoader.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+// Load time and memory of the geometry loaders on a generated grid mesh of
+// `state.range(0)` vertices, read from a temporary file so the mapped path is
+// measured. The label holds the size of the produced buffers next to the peak
+// resident set size of a fresh process that loads the file once; the
+// benchmark binary re-runs itself for that, with LOAD_ONLY naming the file,
+// so the figure belongs to the case and not to whatever ran before it. The
+// child reports its own VmHWM: exec carries the parent's high-water mark
+// into ru_maxrss, which would make every case show the largest so far.
+
+namespace
+{
+    struct GridMesh
+    {
+        std::vector<float> positions;
+        std::vector<uint32_t> triangles;
+    };
+
+    GridMesh gridMesh(size_t vertexCount)
+    {
+        size_t side = 2;
+        while (side * side < vertexCount)
+            side++;
+
+        GridMesh grid;
+        grid.positions.reserve(side * side * 3);
+        for (size_t y = 0; y < side; y++)
+        {
+            for (size_t x = 0; x < side; x++)
+            {
+                grid.positions.push_back(static_cast<float>(x) * 0.01f);
+                grid.positions.push_back(static_cast<float>(y) * 0.01f);
+                grid.positions.push_back(static_cast<float>((x * 7 + y * 13) % 17) * 0.001f);
+            }
+        }
+
+        grid.triangles.reserve((side - 1) * (side - 1) * 6);
+        for (size_t y = 0; y + 1 < side; y++)
+        {
+            for (size_t x = 0; x + 1 < side; x++)
+            {
+                const uint32_t a = static_cast<uint32_t>(y * side + x);
+                const uint32_t b = a + 1;
+                const uint32_t c = a + static_cast<uint32_t>(side);
+                const uint32_t d = c + 1;
+                grid.triangles.insert(grid.triangles.end(), {a, b, d, a, d, c});
+            }
+        }
+
+        return grid;
+    }
+
+    // written straight to disk, so generating the file adds little to the peak
+    class TemporaryFile
+    {
+    public:
+        explicit TemporaryFile(const std::string &name)
+            : m_path(std::filesystem::temp_directory_path() / name)
+        {
+        }
+
+        ~TemporaryFile()
+        {
+            std::error_code ignored;
+            std::filesystem::remove(m_path, ignored);
+        }
+
+        std::string path() const
+        {
+            return m_path.string();
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    void writePLY(const std::string &path, const GridMesh &grid, bool binary)
+    {
+        const size_t vertexCount = grid.positions.size() / 3;
+        const size_t faceCount = grid.triangles.size() / 3;
+
+        std::ofstream file(path, std::ios::binary);
+        file << "ply\nformat " << (binary ? "binary_little_endian" : "ascii") << " 1.0\n"
+             << "element vertex " << vertexCount << "\nproperty float x\nproperty float y\nproperty float z\n"
+             << "element face " << faceCount << "\nproperty list uchar int vertex_indices\nend_header\n";
+
+        char line[128];
+
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const float *p = grid.positions.data() + i * 3;
+            if (binary)
+            {
+                // host order, little endian on the bench machines
+                file.write(reinterpret_cast<const char *>(p), 3 * sizeof(float));
+            }
+            else
+            {
+                const int length = std::snprintf(line, sizeof(line), "%g %g %g\n", p[0], p[1], p[2]);
+                file.write(line, length);
+            }
+        }
+
+        for (size_t f = 0; f < faceCount; f++)
+        {
+            const uint32_t *t = grid.triangles.data() + f * 3;
+            if (binary)
+            {
+                const char corners = 3;
+                file.write(&corners, 1);
+                for (size_t k = 0; k < 3; k++)
+                {
+                    const int32_t index = static_cast<int32_t>(t[k]);
+                    file.write(reinterpret_cast<const char *>(&index), sizeof(index));
+                }
+            }
+            else
+            {
+                const int length = std::snprintf(line, sizeof(line), "3 %u %u %u\n", t[0], t[1], t[2]);
+                file.write(line, length);
+            }
+        }
+    }
+
+    void writeOBJ(const std::string &path, const GridMesh &grid)
+    {
+        std::ofstream file(path, std::ios::binary);
+        char line[128];
+
+        for (size_t i = 0; i < grid.positions.size(); i += 3)
+        {
+            const float *p = grid.positions.data() + i;
+            const int length = std::snprintf(line, sizeof(line), "v %g %g %g\n", p[0], p[1], p[2]);
+            file.write(line, length);
+        }
+
+        for (size_t i = 0; i < grid.triangles.size(); i += 3)
+        {
+            const uint32_t *t = grid.triangles.data() + i;
+            const int length = std::snprintf(line, sizeof(line), "f %u %u %u\n", t[0] + 1, t[1] + 1, t[2] + 1);
+            file.write(line, length);
+        }
+    }
+
+    void writeSTL(const std::string &path, const GridMesh &grid)
+    {
+        std::ofstream file(path, std::ios::binary);
+
+        const char header[80] = "threecpp benchmark grid";
+        const uint32_t faceCount = static_cast<uint32_t>(grid.triangles.size() / 3);
+        file.write(header, sizeof(header));
+        file.write(reinterpret_cast<const char *>(&faceCount), sizeof(faceCount));
+
+        for (size_t f = 0; f < faceCount; f++)
+        {
+            // normal, three corners and the attribute byte count; host
+            // order, little endian on the bench machines
+            float facet[12] = {0.0f, 0.0f, 1.0f};
+            for (size_t k = 0; k < 3; k++)
+            {
+                const float *p = grid.positions.data() + grid.triangles[f * 3 + k] * 3;
+                std::copy(p, p + 3, facet + 3 + k * 3);
+            }
+
+            const uint16_t attributes = 0;
+            file.write(reinterpret_cast<const char *>(facet), sizeof(facet));
+            file.write(reinterpret_cast<const char *>(&attributes), sizeof(attributes));
+        }
+    }
+
+    constexpr const char *LOAD_ONLY = "THREECPP_BENCH_LOAD_ONLY";
+
+    // descriptor the child writes its peak to
+    constexpr int REPORT_FD = 3;
+
+    // in the child started by freshPeakResidentBytes: load the named file
+    // once, report the peak and exit before the case generates anything
+    template <typename Loader>
+    void loadOnlyWhenChild()
+    {
+#if defined(__linux__)
+        const char *path = std::getenv(LOAD_ONLY);
+        if (path == nullptr)
+            return;
+
+        try
+        {
+            Loader loader;
+            auto geometry = loader.load(path);
+            Benchmark::doNotOptimize(geometry);
+        }
+        catch (...)
+        {
+            std::_Exit(EXIT_FAILURE);
+        }
+
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind("VmHWM:", 0) == 0)
+            {
+                const std::string kilobytes = std::to_string(std::strtoull(line.c_str() + 6, nullptr, 10));
+                if (write(REPORT_FD, kilobytes.data(), kilobytes.size()) == static_cast<ssize_t>(kilobytes.size()))
+                    std::_Exit(EXIT_SUCCESS);
+            }
+        }
+
+        std::_Exit(EXIT_FAILURE);
+#endif
+    }
+
+    // peak resident set size of this binary re-run on `name` alone with
+    // LOAD_ONLY set, or 0 where that is not available
+    size_t freshPeakResidentBytes(const std::string &name, const TemporaryFile &file)
+    {
+#if defined(__linux__)
+        std::string filter = "--benchmark_filter=^" + name + "$";
+        std::string loadOnly = std::string(LOAD_ONLY) + "=" + file.path();
+
+        std::vector<char *> environment;
+        for (char **variable = environ; *variable != nullptr; variable++)
+            environment.push_back(*variable);
+        environment.push_back(loadOnly.data());
+        environment.push_back(nullptr);
+
+        char program[] = "/proc/self/exe";
+        char *arguments[] = {program, filter.data(), nullptr};
+
+        int report[2];
+        if (pipe2(report, O_CLOEXEC) != 0)
+            return 0;
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_adddup2(&actions, report[1], REPORT_FD);
+
+        pid_t pid;
+        const int spawned = posix_spawn(&pid, program, &actions, nullptr, arguments, environment.data());
+        posix_spawn_file_actions_destroy(&actions);
+        close(report[1]);
+
+        std::string kilobytes;
+        if (spawned == 0)
+        {
+            char buffer[32];
+            ssize_t length;
+            while ((length = read(report[0], buffer, sizeof(buffer))) > 0)
+                kilobytes.append(buffer, static_cast<size_t>(length));
+        }
+        close(report[0]);
+
+        if (spawned != 0)
+            return 0;
+
+        int status = 0;
+        if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+            return 0;
+
+        return static_cast<size_t>(std::strtoull(kilobytes.c_str(), nullptr, 10)) * 1024;
+#else
+        (void)name;
+        (void)file;
+        return 0;
+#endif
+    }
+
+    std::string memoryLabel(const LoadStats &stats, size_t peakResidentBytes)
+    {
+        char label[96];
+        std::snprintf(label, sizeof(label), "buffers %.1f MiB, fresh peak RSS %.1f MiB",
+                      static_cast<double>(stats.outputBytes) / (1 << 20), static_cast<double>(peakResidentBytes) / (1 << 20));
+        return label;
+    }
+
+    template <typename Loader>
+    void loadFile(Benchmark::State &state, const char *name, const TemporaryFile &file)
+    {
+        Loader loader;
+
+        while (state.keepRunning())
+        {
+            auto geometry = loader.load(file.path());
+            Benchmark::doNotOptimize(geometry);
+        }
+
+        const std::string run = std::string(name) + "/" + std::to_string(state.range(0));
+        state.setBytesProcessed(state.iterations() * loader.stats().fileBytes);
+        state.setLabel(memoryLabel(loader.stats(), freshPeakResidentBytes(run, file)));
+    }
+}
+
+static void PLYLoaderBinary(Benchmark::State &state)
+{
+    loadOnlyWhenChild<PLYLoader>();
+    const TemporaryFile file("threecpp_bench_binary.ply");
+    writePLY(file.path(), gridMesh(static_cast<size_t>(state.range(0))), true);
+    loadFile<PLYLoader>(state, "PLYLoaderBinary", file);
+}
+THREECPP_BENCHMARK(PLYLoaderBinary).arg(1 << 16).arg(1 << 20);
+
+static void PLYLoaderASCII(Benchmark::State &state)
+{
+    loadOnlyWhenChild<PLYLoader>();
+    const TemporaryFile file("threecpp_bench_ascii.ply");
+    writePLY(file.path(), gridMesh(static_cast<size_t>(state.range(0))), false);
+    loadFile<PLYLoader>(state, "PLYLoaderASCII", file);
+}
+THREECPP_BENCHMARK(PLYLoaderASCII).arg(1 << 16).arg(1 << 20);
+
+static void OBJLoaderASCII(Benchmark::State &state)
+{
+    loadOnlyWhenChild<OBJLoader>();
+    const TemporaryFile file("threecpp_bench.obj");
+    writeOBJ(file.path(), gridMesh(static_cast<size_t>(state.range(0))));
+    loadFile<OBJLoader>(state, "OBJLoaderASCII", file);
+}
+THREECPP_BENCHMARK(OBJLoaderASCII).arg(1 << 16).arg(1 << 20);
+
+static void STLLoaderBinary(Benchmark::State &state)
+{
+    loadOnlyWhenChild<STLLoader>();
+    const TemporaryFile file("threecpp_bench.stl");
+    writeSTL(file.path(), gridMesh(static_cast<size_t>(state.range(0))));
+    loadFile<STLLoader>(state, "STLLoaderBinary", file);
+}
+THREECPP_BENCHMARK(STLLoaderBinary).arg(1 << 16).arg(1 << 20);
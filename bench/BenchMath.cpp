@@ -0,0 +1,387 @@
+#include "Benchmark.h"
+#include "math/MathUtils.h"
+#include "math/Matrix3.h"
+#include "math/Matrix4.h"
+#include "math/Quaternion.h"
+#include "math/Vector2.h"
+#include "math/Vector3.h"
+#include <cmath>
+#include <vector>
+
+// Scalar operations of the math types, in the precision this binary was
+// built with (see THREECPP_HIGH_PRECISION).
+
+// Vector2
+
+static void Vector2Add(Benchmark::State &state)
+{
+    Vector2 a(1, 2), b(0.5, -0.25);
+    while (state.keepRunning())
+    {
+        a.add(b);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector2Add);
+
+static void Vector2Dot(Benchmark::State &state)
+{
+    Vector2 a(1, 2), b(0.5, -0.25);
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(a.dot(b));
+        Benchmark::clobberMemory();
+    }
+}
+THREECPP_BENCHMARK(Vector2Dot);
+
+static void Vector2Normalize(Benchmark::State &state)
+{
+    Vector2 a(3, 4);
+    while (state.keepRunning())
+    {
+        a.normalize();
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector2Normalize);
+
+static void Vector2Lerp(Benchmark::State &state)
+{
+    Vector2 a(1, 2), b(3, 4);
+    while (state.keepRunning())
+    {
+        a.lerp(b, 0.5);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector2Lerp);
+
+// Vector3
+
+static void Vector3Add(Benchmark::State &state)
+{
+    Vector3 a(1, 2, 3), b(0.5, -0.25, 0.125);
+    while (state.keepRunning())
+    {
+        a.add(b);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector3Add);
+
+static void Vector3Dot(Benchmark::State &state)
+{
+    Vector3 a(1, 2, 3), b(0.5, -0.25, 0.125);
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(a.dot(b));
+        Benchmark::clobberMemory();
+    }
+}
+THREECPP_BENCHMARK(Vector3Dot);
+
+static void Vector3Cross(Benchmark::State &state)
+{
+    Vector3 a(1, 2, 3), b(0.5, -0.25, 0.125);
+    while (state.keepRunning())
+    {
+        a.cross(b);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector3Cross);
+
+static void Vector3Normalize(Benchmark::State &state)
+{
+    Vector3 a(1, 2, 3);
+    while (state.keepRunning())
+    {
+        a.normalize();
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector3Normalize);
+
+static void Vector3Lerp(Benchmark::State &state)
+{
+    Vector3 a(1, 2, 3), b(4, 5, 6);
+    while (state.keepRunning())
+    {
+        a.lerp(b, 0.5);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector3Lerp);
+
+static void Vector3ApplyMatrix4(Benchmark::State &state)
+{
+    Matrix4 m;
+    m.makeRotationAxis(Vector3(0, 1, 0), 0.5f);
+    Vector3 a(1, 2, 3);
+    while (state.keepRunning())
+    {
+        a.applyMatrix4(m);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector3ApplyMatrix4);
+
+static void Vector3ApplyQuaternion(Benchmark::State &state)
+{
+    Quaternion q;
+    q.setFromAxisAngle(Vector3(0, 1, 0), 0.5);
+    Vector3 a(1, 2, 3);
+    while (state.keepRunning())
+    {
+        a.applyQuaternion(q);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Vector3ApplyQuaternion);
+
+// Matrix3
+
+static Matrix3 sampleMatrix3()
+{
+    return Matrix3(2, 0.5, 0.25, -1, 3, 0.5, 0.125, 0.25, 4);
+}
+
+static void Matrix3Multiply(Benchmark::State &state)
+{
+    Matrix3 a = sampleMatrix3(), b = sampleMatrix3();
+    while (state.keepRunning())
+    {
+        a.multiplyMatrices(b, b);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Matrix3Multiply);
+
+static void Matrix3Invert(Benchmark::State &state)
+{
+    Matrix3 a = sampleMatrix3();
+    while (state.keepRunning())
+    {
+        a.invert();
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Matrix3Invert);
+
+static void Matrix3Determinant(Benchmark::State &state)
+{
+    Matrix3 a = sampleMatrix3();
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(a);
+        Benchmark::doNotOptimize(a.determinant());
+    }
+}
+THREECPP_BENCHMARK(Matrix3Determinant);
+
+// Matrix4
+
+static Matrix4 sampleMatrix4()
+{
+    Matrix4 m;
+    Quaternion q;
+    q.setFromAxisAngle(Vector3(0.6, 0.8, 0), 0.75);
+    m.compose(Vector3(1, -2, 3), q, Vector3(1.5, 2, 0.5));
+    return m;
+}
+
+static void Matrix4Multiply(Benchmark::State &state)
+{
+    Matrix4 a = sampleMatrix4(), b = sampleMatrix4();
+    while (state.keepRunning())
+    {
+        a.multiplyMatrices(b, b);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Matrix4Multiply);
+
+static void Matrix4Invert(Benchmark::State &state)
+{
+    Matrix4 a = sampleMatrix4();
+    while (state.keepRunning())
+    {
+        a.invert();
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Matrix4Invert);
+
+static void Matrix4Determinant(Benchmark::State &state)
+{
+    Matrix4 a = sampleMatrix4();
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(a);
+        Benchmark::doNotOptimize(a.determinant());
+    }
+}
+THREECPP_BENCHMARK(Matrix4Determinant);
+
+static void Matrix4LookAt(Benchmark::State &state)
+{
+    Matrix4 a;
+    Vector3 eye(1, 2, 3), target(0, 0, 0), up(0, 1, 0);
+    while (state.keepRunning())
+    {
+        a.lookAt(eye, target, up);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Matrix4LookAt);
+
+static void Matrix4Compose(Benchmark::State &state)
+{
+    Matrix4 a;
+    Quaternion q;
+    q.setFromAxisAngle(Vector3(0.6, 0.8, 0), 0.75);
+    const Vector3 position(1, -2, 3), scale(1.5, 2, 0.5);
+    while (state.keepRunning())
+    {
+        a.compose(position, q, scale);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(Matrix4Compose);
+
+static void Matrix4Decompose(Benchmark::State &state)
+{
+    const Matrix4 a = sampleMatrix4();
+    Vector3 position, scale;
+    Quaternion q;
+    while (state.keepRunning())
+    {
+        a.decompose(position, q, scale);
+        Benchmark::doNotOptimize(position);
+        Benchmark::doNotOptimize(q);
+        Benchmark::doNotOptimize(scale);
+    }
+}
+THREECPP_BENCHMARK(Matrix4Decompose);
+
+// Quaternion
+
+static void QuaternionMultiply(Benchmark::State &state)
+{
+    Quaternion a, b;
+    a.setFromAxisAngle(Vector3(1, 0, 0), 0.25);
+    b.setFromAxisAngle(Vector3(0, 1, 0), 0.5);
+    while (state.keepRunning())
+    {
+        a.multiply(b);
+        Benchmark::doNotOptimize(a);
+    }
+}
+THREECPP_BENCHMARK(QuaternionMultiply);
+
+static void QuaternionSlerp(Benchmark::State &state)
+{
+    Quaternion a, b;
+    b.setFromAxisAngle(Vector3(0, 1, 0), 2);
+    while (state.keepRunning())
+    {
+        Quaternion c = a;
+        c.slerp(b, 0.3);
+        Benchmark::doNotOptimize(c);
+    }
+}
+THREECPP_BENCHMARK(QuaternionSlerp);
+
+// MathUtils
+
+static void MathUtilsGenerateUUID(Benchmark::State &state)
+{
+    while (state.keepRunning())
+        Benchmark::doNotOptimize(MathUtils::generateUUID());
+}
+THREECPP_BENCHMARK(MathUtilsGenerateUUID);
+
+static void MathUtilsClamp(Benchmark::State &state)
+{
+    HIGH_PRECISION value = 0.25;
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(value);
+        Benchmark::doNotOptimize(MathUtils::clamp(value, 0, 1));
+    }
+}
+THREECPP_BENCHMARK(MathUtilsClamp);
+
+static void MathUtilsSmootherstep(Benchmark::State &state)
+{
+    HIGH_PRECISION value = 0.25;
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(value);
+        Benchmark::doNotOptimize(MathUtils::smootherstep(value, 0, 1));
+    }
+}
+THREECPP_BENCHMARK(MathUtilsSmootherstep);
+
+static void MathUtilsDamp(Benchmark::State &state)
+{
+    HIGH_PRECISION value = 0.25;
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(value);
+        Benchmark::doNotOptimize(MathUtils::damp(value, 1, 4, 1.0 / 60));
+    }
+}
+THREECPP_BENCHMARK(MathUtilsDamp);
+
+// The inline templates are the one place every scalar type is available in
+// the same binary, so they run over a buffer of each.
+
+template <typename T>
+static void MathUtilsLerpBuffer(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<T> a(count), b(count), result(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        a[i] = static_cast<T>(i);
+        b[i] = static_cast<T>(count - i);
+    }
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+            result[i] = MathUtils::lerp(a[i], b[i], static_cast<T>(0.25));
+        Benchmark::doNotOptimize(result.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+    state.setBytesProcessed(state.iterations() * count * sizeof(T) * 3);
+}
+THREECPP_BENCHMARK_TEMPLATE(MathUtilsLerpBuffer, float).arg(4096);
+THREECPP_BENCHMARK_TEMPLATE(MathUtilsLerpBuffer, double).arg(4096);
+THREECPP_BENCHMARK_TEMPLATE(MathUtilsLerpBuffer, long double).arg(4096);
+
+template <typename T>
+static void MathUtilsSmoothstepBuffer(Benchmark::State &state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<T> values(count), result(count);
+    for (size_t i = 0; i < count; i++)
+        values[i] = static_cast<T>(i) / count;
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+            result[i] = MathUtils::smoothstep(values[i], static_cast<T>(0.1), static_cast<T>(0.9));
+        Benchmark::doNotOptimize(result.data());
+        Benchmark::clobberMemory();
+    }
+
+    state.setItemsProcessed(state.iterations() * count);
+}
+THREECPP_BENCHMARK_TEMPLATE(MathUtilsSmoothstepBuffer, float).arg(4096);
+THREECPP_BENCHMARK_TEMPLATE(MathUtilsSmoothstepBuffer, double).arg(4096);
+THREECPP_BENCHMARK_TEMPLATE(MathUtilsSmoothstepBuffer, long double).arg(4096);
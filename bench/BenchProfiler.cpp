@@ -0,0 +1,53 @@
+#include "Benchmark.h"
+#include "common/Profiler.h"
+
+// Cost of the instrumentation itself. These use Profiler directly, so they
+// measure it whether or not THREECPP_PROFILING is defined.
+
+static void ProfilerZone(Benchmark::State &state)
+{
+    Profiler::setEnabled(true);
+    size_t recorded = 0;
+    while (state.keepRunning())
+    {
+        {
+            Profiler::Zone zone("ProfilerZone");
+            Benchmark::clobberMemory();
+        }
+
+        // keep the buffer from filling up, which would only time the drop path
+        if (++recorded == Profiler::EVENTS_PER_THREAD)
+        {
+            state.pauseTiming();
+            Profiler::instance().clear();
+            recorded = 0;
+            state.resumeTiming();
+        }
+    }
+
+    Profiler::instance().clear();
+}
+THREECPP_BENCHMARK(ProfilerZone);
+
+static void ProfilerZoneDisabled(Benchmark::State &state)
+{
+    Profiler::setEnabled(false);
+    while (state.keepRunning())
+    {
+        Profiler::Zone zone("ProfilerZoneDisabled");
+        Benchmark::clobberMemory();
+    }
+    Profiler::setEnabled(true);
+}
+THREECPP_BENCHMARK(ProfilerZoneDisabled);
+
+static void ProfilerCount(Benchmark::State &state)
+{
+    Profiler::setEnabled(true);
+    while (state.keepRunning())
+    {
+        Profiler::count(Profiler::NodesUpdated);
+        Benchmark::clobberMemory();
+    }
+}
+THREECPP_BENCHMARK(ProfilerCount);
@@ -0,0 +1,462 @@
+#include "Benchmark.h"
+#include "common/BasicType.h"
+#include "common/CPUFeatures.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#define THREECPP_BENCHMARK_STRING2(value) #value
+#define THREECPP_BENCHMARK_STRING(value) THREECPP_BENCHMARK_STRING2(value)
+
+namespace Benchmark
+{
+    static double cpuNow()
+    {
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+    }
+
+    // State
+
+    State::State(size_t iterations, std::vector<int64_t> arguments)
+        : m_iterations(iterations), m_remaining(iterations), m_arguments(std::move(arguments))
+    {
+    }
+
+    bool State::keepRunning()
+    {
+        if (!m_started)
+        {
+            m_started = true;
+            resumeTiming();
+        }
+
+        if (m_remaining > 0)
+        {
+            m_remaining--;
+            return true;
+        }
+
+        if (m_running)
+            pauseTiming();
+        return false;
+    }
+
+    size_t State::iterations() const
+    {
+        return m_iterations;
+    }
+
+    int64_t State::range(size_t index) const
+    {
+        if (index >= m_arguments.size())
+            throw std::out_of_range("Benchmark: no argument " + std::to_string(index));
+        return m_arguments[index];
+    }
+
+    void State::pauseTiming()
+    {
+        m_realSeconds += std::chrono::duration<double>(Clock::now() - m_realStart).count();
+        m_cpuSeconds += cpuNow() - m_cpuStart;
+        m_running = false;
+    }
+
+    void State::resumeTiming()
+    {
+        m_running = true;
+        m_cpuStart = cpuNow();
+        m_realStart = Clock::now();
+    }
+
+    void State::setItemsProcessed(size_t count)
+    {
+        m_items = count;
+    }
+
+    void State::setBytesProcessed(size_t count)
+    {
+        m_bytes = count;
+    }
+
+    void State::setLabel(const std::string &label)
+    {
+        m_label = label;
+    }
+
+    double State::realSeconds() const
+    {
+        return m_realSeconds;
+    }
+
+    double State::cpuSeconds() const
+    {
+        return m_cpuSeconds;
+    }
+
+    size_t State::itemsProcessed() const
+    {
+        return m_items;
+    }
+
+    size_t State::bytesProcessed() const
+    {
+        return m_bytes;
+    }
+
+    const std::string &State::label() const
+    {
+        return m_label;
+    }
+
+    // Registration
+
+    Registration::Registration(std::string name, Function function)
+        : m_name(std::move(name)), m_function(std::move(function))
+    {
+    }
+
+    Registration &Registration::arg(int64_t value)
+    {
+        m_arguments.push_back({value});
+        return *this;
+    }
+
+    Registration &Registration::args(std::vector<int64_t> values)
+    {
+        m_arguments.push_back(std::move(values));
+        return *this;
+    }
+
+    Registration &Registration::range(int64_t start, int64_t limit, int64_t multiplier)
+    {
+        if (start <= 0 || multiplier < 2)
+            throw std::invalid_argument("Benchmark: range needs a positive start and a multiplier of at least 2");
+
+        int64_t value = start;
+        for (; value < limit; value *= multiplier)
+            arg(value);
+        arg(limit);
+
+        return *this;
+    }
+
+    Registration &Registration::iterations(size_t count)
+    {
+        m_iterations = count;
+        return *this;
+    }
+
+    const std::string &Registration::name() const
+    {
+        return m_name;
+    }
+
+    const Function &Registration::function() const
+    {
+        return m_function;
+    }
+
+    const std::vector<std::vector<int64_t>> &Registration::argumentSets() const
+    {
+        return m_arguments;
+    }
+
+    size_t Registration::fixedIterations() const
+    {
+        return m_iterations;
+    }
+
+    static std::vector<std::unique_ptr<Registration>> &registry()
+    {
+        static std::vector<std::unique_ptr<Registration>> registrations;
+        return registrations;
+    }
+
+    Registration &registerBenchmark(const std::string &name, Function function)
+    {
+        registry().push_back(std::make_unique<Registration>(name, std::move(function)));
+        return *registry().back();
+    }
+
+    // runner
+
+    namespace
+    {
+        struct Options
+        {
+            std::string filter = ".*";
+            double minTime = 0.5;
+            size_t repetitions = 1;
+            std::string out;
+            bool list = false;
+        };
+
+        struct Result
+        {
+            std::string name;
+            size_t iterations = 0;
+            size_t repetitions = 1;
+            // per iteration, nanoseconds
+            double realTime = 0;
+            double cpuTime = 0;
+            double itemsPerSecond = 0;
+            double bytesPerSecond = 0;
+            std::string label;
+        };
+
+        Options parseOptions(int argc, char **argv)
+        {
+            Options options;
+
+            for (int i = 1; i < argc; i++)
+            {
+                const std::string argument = argv[i];
+                auto value = [&argument](const std::string &flag, std::string &target)
+                {
+                    if (argument.rfind(flag + "=", 0) != 0)
+                        return false;
+                    target = argument.substr(flag.size() + 1);
+                    return true;
+                };
+
+                std::string text;
+                if (value("--benchmark_filter", text))
+                    options.filter = text;
+                else if (value("--benchmark_min_time", text))
+                    options.minTime = std::stod(text);
+                else if (value("--benchmark_repetitions", text))
+                    options.repetitions = std::max<size_t>(1, std::stoul(text));
+                else if (value("--benchmark_out", text))
+                    options.out = text;
+                else if (argument == "--benchmark_list")
+                    options.list = true;
+                else
+                    throw std::invalid_argument("Benchmark: unknown flag " + argument);
+            }
+
+            return options;
+        }
+
+        std::string simdLevel()
+        {
+#if defined(__AVX512F__)
+            return "avx512";
+#elif defined(__AVX2__)
+            return "avx2";
+#elif defined(__AVX__)
+            return "avx";
+#elif defined(__SSE4_2__)
+            return "sse4.2";
+#elif defined(__SSE2__)
+            return "sse2";
+#elif defined(__ARM_NEON)
+            return "neon";
+#else
+            return "scalar";
+#endif
+        }
+
+        std::string escape(const std::string &text)
+        {
+            std::string escaped;
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                    escaped += '\\';
+                escaped += c;
+            }
+            return escaped;
+        }
+
+        Result measure(const Registration &registration, const std::vector<int64_t> &arguments, const std::string &name, const Options &options)
+        {
+            auto runOnce = [&](size_t iterations)
+            {
+                State state(iterations, arguments);
+                registration.function()(state);
+                return state;
+            };
+
+            size_t iterations = registration.fixedIterations();
+            if (iterations == 0)
+            {
+                // grow the count until one run is long enough to extrapolate from
+                iterations = 1;
+                while (true)
+                {
+                    const State probe = runOnce(iterations);
+                    const double seconds = probe.realSeconds();
+                    if (seconds >= options.minTime || iterations >= 1000000000)
+                        break;
+
+                    const double scale = seconds > 0 ? options.minTime * 1.4 / seconds : 100;
+                    iterations = static_cast<size_t>(std::clamp(iterations * scale, iterations * 2.0, iterations * 100.0));
+                }
+            }
+
+            std::vector<Result> runs;
+            for (size_t r = 0; r < options.repetitions; r++)
+            {
+                const State state = runOnce(iterations);
+
+                Result result;
+                result.name = name;
+                result.iterations = iterations;
+                result.realTime = state.realSeconds() * 1e9 / iterations;
+                result.cpuTime = state.cpuSeconds() * 1e9 / iterations;
+                if (state.realSeconds() > 0)
+                {
+                    result.itemsPerSecond = state.itemsProcessed() / state.realSeconds();
+                    result.bytesPerSecond = state.bytesProcessed() / state.realSeconds();
+                }
+                result.label = state.label();
+                runs.push_back(result);
+            }
+
+            // the median repetition is the least disturbed by outliers
+            std::sort(runs.begin(), runs.end(), [](const Result &a, const Result &b)
+                      { return a.realTime < b.realTime; });
+            Result median = runs[runs.size() / 2];
+            median.repetitions = options.repetitions;
+            return median;
+        }
+
+        void printResult(const Result &result)
+        {
+            char line[512];
+            std::snprintf(line, sizeof(line), "%-56s %14.1f ns %14.1f ns %12zu", result.name.c_str(), result.realTime, result.cpuTime, result.iterations);
+            std::cout << line;
+
+            if (result.itemsPerSecond > 0)
+            {
+                std::snprintf(line, sizeof(line), "  items/s=%.4g", result.itemsPerSecond);
+                std::cout << line;
+            }
+            if (result.bytesPerSecond > 0)
+            {
+                std::snprintf(line, sizeof(line), "  bytes/s=%.4g", result.bytesPerSecond);
+                std::cout << line;
+            }
+            if (!result.label.empty())
+                std::cout << "  " << result.label;
+
+            std::cout << std::endl;
+        }
+
+        void writeJSON(const std::string &path, const std::vector<Result> &results)
+        {
+            std::ofstream file(path);
+            if (!file)
+                throw std::runtime_error("Benchmark: cannot write " + path);
+
+            const std::time_t now = std::time(nullptr);
+            char date[64];
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+            file << "{\n  \"context\": {\n";
+            file << "    \"date\": \"" << date << "\",\n";
+            file << "    \"num_cpus\": " << std::max(1u, std::thread::hardware_concurrency()) << ",\n";
+#if defined(NDEBUG)
+            file << "    \"library_build_type\": \"release\",\n";
+#else
+            file << "    \"library_build_type\": \"debug\",\n";
+#endif
+            file << "    \"scalar\": \"" << THREECPP_BENCHMARK_STRING(HIGH_PRECISION) << "\",\n";
+            file << "    \"simd\": \"" << simdLevel() << "\",\n";
+            // the widest instruction set of this machine, used by the kernel clones
+            file << "    \"cpu_simd\": \"" << CPUFeatures::best() << "\"\n";
+            file << "  },\n  \"benchmarks\": [\n";
+
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                const Result &result = results[i];
+                file << "    {\n";
+                file << "      \"name\": \"" << escape(result.name) << "\",\n";
+                file << "      \"run_name\": \"" << escape(result.name) << "\",\n";
+                file << "      \"run_type\": \"iteration\",\n";
+                file << "      \"repetitions\": " << result.repetitions << ",\n";
+                file << "      \"iterations\": " << result.iterations << ",\n";
+                file << "      \"real_time\": " << result.realTime << ",\n";
+                file << "      \"cpu_time\": " << result.cpuTime << ",\n";
+                if (result.itemsPerSecond > 0)
+                    file << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+                if (result.bytesPerSecond > 0)
+                    file << "      \"bytes_per_second\": " << result.bytesPerSecond << ",\n";
+                if (!result.label.empty())
+                    file << "      \"label\": \"" << escape(result.label) << "\",\n";
+                file << "      \"time_unit\": \"ns\"\n";
+                file << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+            }
+
+            file << "  ]\n}\n";
+        }
+    }
+
+    int run(int argc, char **argv)
+    {
+        Options options;
+        try
+        {
+            options = parseOptions(argc, argv);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 2;
+        }
+
+        const std::regex filter(options.filter);
+        std::vector<Result> results;
+
+        if (!options.list)
+        {
+            std::cout << "scalar: " << THREECPP_BENCHMARK_STRING(HIGH_PRECISION) << ", simd: " << simdLevel() << ", cpu: " << CPUFeatures::best() << ", cpus: " << std::thread::hardware_concurrency() << std::endl;
+            std::cout << std::string(110, '-') << std::endl;
+        }
+
+        for (const auto &registration : registry())
+        {
+            auto argumentSets = registration->argumentSets();
+            if (argumentSets.empty())
+                argumentSets.push_back({});
+
+            for (const auto &arguments : argumentSets)
+            {
+                std::string name = registration->name();
+                for (int64_t argument : arguments)
+                {
+                    name += '/';
+                    name += std::to_string(argument);
+                }
+
+                if (!std::regex_search(name, filter))
+                    continue;
+
+                if (options.list)
+                {
+                    std::cout << name << std::endl;
+                    continue;
+                }
+
+                results.push_back(measure(*registration, arguments, name, options));
+                printResult(results.back());
+            }
+        }
+
+        if (!options.out.empty())
+            writeJSON(options.out, results);
+
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    return Benchmark::run(argc, argv);
+}
@@ -0,0 +1,213 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal micro-benchmark harness for `threecpp_bench`, modelled on Google
+ * Benchmark: the same loop structure, command line flags and JSON layout,
+ * so its tools can read the output too.
+ * ```c++
+ * static void Matrix4Multiply(Benchmark::State &state)
+ * {
+ *     Matrix4 a, b;
+ *     while (state.keepRunning())
+ *     {
+ *         a.multiply(b);
+ *         Benchmark::doNotOptimize(a);
+ *     }
+ * }
+ * THREECPP_BENCHMARK(Matrix4Multiply);
+ * ```
+ * Flags: `--benchmark_filter=<regex>`, `--benchmark_min_time=<seconds>`,
+ * `--benchmark_repetitions=<n>`, `--benchmark_out=<file.json>` and
+ * `--benchmark_list`.
+ */
+namespace Benchmark
+{
+    /**
+     * Drives the timed loop of one benchmark run. Only the time spent
+     * inside the loop is measured; setup before it is free.
+     */
+    class State
+    {
+    public:
+        State(size_t iterations, std::vector<int64_t> arguments);
+
+        /**
+         * Returns `true` while the loop shall run another iteration. Timing
+         * starts on the first call and stops when it returns `false`.
+         *
+         * @return {bool}
+         */
+        bool keepRunning();
+        size_t iterations() const;
+        /**
+         * The `index`-th argument of this run, see {@link Benchmark::Registration#arg}.
+         *
+         * @param {size_t} [index=0] - The argument index.
+         * @return {int64_t}
+         */
+        int64_t range(size_t index = 0) const;
+
+        /**
+         * Excludes the code between `pauseTiming` and `resumeTiming` from
+         * the measurement, e.g. resetting state every iteration.
+         */
+        void pauseTiming();
+        void resumeTiming();
+
+        /**
+         * Items or bytes handled by the whole loop; reported per second.
+         *
+         * @param {size_t} count - The total over all iterations.
+         */
+        void setItemsProcessed(size_t count);
+        void setBytesProcessed(size_t count);
+        void setLabel(const std::string &label);
+
+        double realSeconds() const;
+        double cpuSeconds() const;
+        size_t itemsProcessed() const;
+        size_t bytesProcessed() const;
+        const std::string &label() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        size_t m_iterations;
+        size_t m_remaining;
+        bool m_started = false;
+        bool m_running = false;
+        std::vector<int64_t> m_arguments;
+
+        Clock::time_point m_realStart;
+        double m_cpuStart = 0;
+        double m_realSeconds = 0;
+        double m_cpuSeconds = 0;
+
+        size_t m_items = 0;
+        size_t m_bytes = 0;
+        std::string m_label;
+    };
+
+    using Function = std::function<void(State &)>;
+
+    /**
+     * A registered benchmark; the setters return it for chaining.
+     */
+    class Registration
+    {
+    public:
+        Registration(std::string name, Function function);
+
+        /**
+         * Adds a run with one argument, available as `state.range(0)`.
+         *
+         * @param {int64_t} value - The argument.
+         * @return {Registration} A reference to this registration.
+         */
+        Registration &arg(int64_t value);
+        Registration &args(std::vector<int64_t> values);
+        /**
+         * Adds one run per power of `multiplier` in `[start, limit]`, both
+         * ends included.
+         *
+         * @param {int64_t} start - The first argument.
+         * @param {int64_t} limit - The last argument.
+         * @param {int64_t} [multiplier=8] - The factor between arguments.
+         * @return {Registration} A reference to this registration.
+         */
+        Registration &range(int64_t start, int64_t limit, int64_t multiplier = 8);
+        /**
+         * Runs exactly `count` iterations instead of calibrating, for slow
+         * benchmarks with expensive setup.
+         *
+         * @param {size_t} count - The number of iterations.
+         * @return {Registration} A reference to this registration.
+         */
+        Registration &iterations(size_t count);
+
+        const std::string &name() const;
+        const Function &function() const;
+        const std::vector<std::vector<int64_t>> &argumentSets() const;
+        size_t fixedIterations() const;
+
+    private:
+        std::string m_name;
+        Function m_function;
+        std::vector<std::vector<int64_t>> m_arguments;
+        size_t m_iterations = 0;
+    };
+
+    Registration &registerBenchmark(const std::string &name, Function function);
+
+    /**
+     * Runs the benchmarks selected on the command line.
+     *
+     * @param {int} argc - The argument count of `main`.
+     * @param {char**} argv - The arguments of `main`.
+     * @return {int} The process exit code.
+     */
+    int run(int argc, char **argv);
+
+    /**
+     * Keeps the compiler from discarding `value` or the computation that
+     * produced it.
+     */
+    template <typename T>
+    inline void doNotOptimize(T const &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    template <typename T>
+    inline void doNotOptimize(T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : "+r,m"(value) : : "memory");
+#else
+        static volatile void *sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * Forces pending writes to memory to be treated as observed.
+     */
+    inline void clobberMemory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+}
+
+#define THREECPP_BENCHMARK_CONCAT2(a, b) a##b
+#define THREECPP_BENCHMARK_CONCAT(a, b) THREECPP_BENCHMARK_CONCAT2(a, b)
+
+/**
+ * Registers `function` under its own name at static initialization.
+ */
+#define THREECPP_BENCHMARK(function)                                                                  \
+    [[maybe_unused]] static ::Benchmark::Registration &THREECPP_BENCHMARK_CONCAT(_benchmark_, __LINE__) = \
+        ::Benchmark::registerBenchmark(#function, function)
+
+/**
+ * Registers `function<type>` under the name `function<type>`.
+ */
+#define THREECPP_BENCHMARK_TEMPLATE(function, type)                                                   \
+    [[maybe_unused]] static ::Benchmark::Registration &THREECPP_BENCHMARK_CONCAT(_benchmark_, __LINE__) = \
+        ::Benchmark::registerBenchmark(#function "<" #type ">", function<type>)
+
+#endif
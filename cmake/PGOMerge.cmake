@@ -0,0 +1,31 @@
+# Turns the raw profiles of a pgo_train run into what THREECPP_PGO=USE
+# reads. GCC reads its .gcda files directly; Clang needs them merged into
+# one .profdata file with llvm-profdata.
+#
+# Expects PGO_DIR, COMPILER_ID and COMPILER.
+
+if(NOT COMPILER_ID MATCHES "Clang")
+    file(GLOB_RECURSE profiles "${PGO_DIR}/*.gcda")
+    list(LENGTH profiles count)
+    message(STATUS "PGO: ${count} profiles in ${PGO_DIR}")
+    return()
+endif()
+
+get_filename_component(compilerDir "${COMPILER}" DIRECTORY)
+find_program(LLVM_PROFDATA NAMES llvm-profdata HINTS "${compilerDir}")
+if(NOT LLVM_PROFDATA)
+    message(FATAL_ERROR "PGO: llvm-profdata not found next to ${COMPILER}")
+endif()
+
+file(GLOB profiles "${PGO_DIR}/*.profraw")
+if(NOT profiles)
+    message(FATAL_ERROR "PGO: no .profraw files in ${PGO_DIR}")
+endif()
+
+execute_process(
+    COMMAND "${LLVM_PROFDATA}" merge -output=${PGO_DIR}/threecpp.profdata ${profiles}
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "PGO: llvm-profdata merge failed")
+endif()
+message(STATUS "PGO: wrote ${PGO_DIR}/threecpp.profdata")
@@ -0,0 +1,177 @@
+#ifndef ANIMATION_ACTION_H
+#define ANIMATION_ACTION_H
+
+#include "animation/AnimationClip.h"
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class AnimationMixer;
+class Object3D;
+
+/**
+ * An instance of {@link AnimationAction} schedules the playback of an animation which is
+ * stored in {@link AnimationClip}.
+ *
+ * Actions are created and owned by the mixer, see {@link AnimationMixer#clipAction}.
+ * Each action keeps one keyframe cursor per channel of its clip so that
+ * sampling continues from the interval used in the previous frame.
+ */
+class AnimationAction
+{
+public:
+    AnimationAction(AnimationMixer *mixer, std::shared_ptr<AnimationClip> clip, Object3D *localRoot);
+    ~AnimationAction();
+
+    /**
+     * The loop mode.
+     */
+    LoopMode loop = LoopMode::Repeat;
+    /**
+     * The number of repetitions of the performed clip over the course of this action.
+     */
+    int repetitions = INT_MAX;
+    /**
+     * The local time of this action (in seconds, starting with `0`).
+     */
+    float time = 0;
+    /**
+     * Scaling factor for the time. A value of `0` causes the animation to pause.
+     * Negative values cause the animation to play backwards.
+     */
+    float timeScale = 1;
+    /**
+     * The degree of influence of this action (in the interval `[0, 1]`).
+     */
+    float weight = 1;
+    /**
+     * If set to `false`, the action is disabled so it has no impact.
+     */
+    bool enabled = true;
+    /**
+     * If set to `true`, the playback of the action is paused.
+     */
+    bool paused = false;
+    /**
+     * If set to true the animation will automatically be paused on its last frame.
+     */
+    bool clampWhenFinished = false;
+
+    /**
+     * Starts the playback of the animation.
+     *
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &play();
+    /**
+     * Stops the playback of the animation.
+     *
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &stop();
+    /**
+     * Resets the playback of the animation.
+     *
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &reset();
+    /**
+     * Returns `true` if the animation is running.
+     *
+     * @return {bool} Whether the animation is running or not.
+     */
+    bool isRunning() const;
+    /**
+     * Returns `true` when {@link AnimationAction#play} has been called.
+     *
+     * @return {bool} Whether the animation is scheduled or not.
+     */
+    bool isScheduled() const;
+
+    /**
+     * Configures the loop settings for this action.
+     *
+     * @param {LoopMode} mode - The loop mode.
+     * @param {int} repetitions - The number of repetitions.
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &setLoop(LoopMode mode, int repetitions);
+    /**
+     * Sets the weight of this action and stops any scheduled fading.
+     *
+     * @param {float} weight - The weight to set.
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &setEffectiveWeight(float weight);
+    /**
+     * Returns the effective weight of this action, including fading, as used
+     * by the last mixer update.
+     *
+     * @return {float} The effective weight.
+     */
+    float getEffectiveWeight() const;
+    /**
+     * Fades the animation in by increasing its weight gradually from `0` to `1`,
+     * within the passed time interval.
+     *
+     * @param {float} duration - The duration of the fade.
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &fadeIn(float duration);
+    /**
+     * Fades the animation out by decreasing its weight gradually from `1` to `0`,
+     * within the passed time interval. The action stops when the fade completes.
+     *
+     * @param {float} duration - The duration of the fade.
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &fadeOut(float duration);
+    /**
+     * Causes this action to fade out and the given action to fade in, within the
+     * passed time interval.
+     *
+     * @param {AnimationAction} fadeInAction - The animation action to fade in.
+     * @param {float} duration - The duration of the fade.
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &crossFadeTo(AnimationAction &fadeInAction, float duration);
+    /**
+     * Stops any fading which is applied to this action.
+     *
+     * @return {AnimationAction} A reference to this animation action.
+     */
+    AnimationAction &stopFading();
+
+    AnimationMixer *getMixer() const;
+    std::shared_ptr<AnimationClip> getClip() const;
+    Object3D *getRoot() const;
+
+private:
+    friend class AnimationMixer;
+
+    // advances the local time and returns the time to sample the clip at
+    float updateTime(float deltaTime);
+    // evaluates weight and fading at the given mixer time
+    float updateWeight(float mixerTime);
+    void scheduleFading(float duration, float weightNow, float weightThen);
+
+    AnimationMixer *m_mixer;
+    std::shared_ptr<AnimationClip> m_clip;
+    Object3D *m_localRoot;
+
+    // per channel: keyframe cursor and mixer binding
+    std::vector<uint32_t> m_cursors;
+    std::vector<uint32_t> m_bindings;
+
+    int m_loopCount = -1;
+    float m_effectiveWeight = 0;
+
+    bool m_fading = false;
+    float m_fadeStart = 0;
+    float m_fadeDuration = 0;
+    float m_fadeFrom = 0;
+    float m_fadeTo = 0;
+};
+
+#endif
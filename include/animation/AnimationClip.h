@@ -0,0 +1,127 @@
+#ifndef ANIMATION_CLIP_H
+#define ANIMATION_CLIP_H
+
+#include "animation/AnimationCompression.h"
+#include "animation/KeyframeTrack.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A reusable set of keyframe tracks which represent an animation.
+ *
+ * Besides the track objects, the clip keeps all key times and all key values
+ * packed back to back in two contiguous buffers, with one {@link AnimationClip::Channel}
+ * header per track. Sampling only touches the packed buffers. Call
+ * {@link AnimationClip#pack} after editing tracks in place.
+ *
+ * {@link AnimationClip#compress} replaces the packed float buffers and the
+ * tracks with quantized, key-reduced storage that is decoded while sampling.
+ */
+class AnimationClip
+{
+public:
+    /**
+     * Location of one track inside the packed buffers.
+     */
+    struct Channel
+    {
+        uint32_t timeOffset;
+        uint32_t keyCount;
+        uint32_t valueOffset;
+        uint32_t valueSize;
+        InterpolationMode interpolation;
+        TrackValueType type;
+    };
+
+    /**
+     * Constructs a new animation clip.
+     *
+     * @param {std::string} [name=''] - The clip's name.
+     * @param {float} [duration=-1] - The clip's duration in seconds. If a negative value is passed,
+     * the duration will be calculated from the passed keyframes.
+     * @param {std::vector<std::shared_ptr<KeyframeTrack>>} tracks - An array of keyframe tracks.
+     */
+    AnimationClip(std::string name = "", float duration = -1, std::vector<std::shared_ptr<KeyframeTrack>> tracks = {});
+    ~AnimationClip();
+
+    const std::string &uuid() const;
+    void uuid(const std::string &value);
+    const std::string &name() const;
+    float duration() const;
+    const std::vector<std::shared_ptr<KeyframeTrack>> &tracks() const;
+
+    const std::vector<Channel> &channels() const;
+    const std::vector<float> &packedTimes() const;
+    const std::vector<float> &packedValues() const;
+    /**
+     * The track names, one per channel; kept when the clip is compressed.
+     *
+     * @return {std::vector<std::string>}
+     */
+    const std::vector<std::string> &channelNames() const;
+
+    /**
+     * Sets the duration of this clip to the duration of its longest keyframe track.
+     *
+     * @return {AnimationClip} A reference to this animation clip.
+     */
+    AnimationClip &resetDuration();
+    /**
+     * Trims all tracks to the clip's duration.
+     *
+     * @return {AnimationClip} A reference to this animation clip.
+     */
+    AnimationClip &trim();
+    /**
+     * Optimizes each track by removing equivalent sequential keys.
+     *
+     * @return {AnimationClip} A reference to this animation clip.
+     */
+    AnimationClip &optimize();
+    /**
+     * Performs minimal validation on each track in the clip. Returns `true` if all
+     * tracks are valid.
+     *
+     * @return {bool} Whether the clip's keyframes are valid or not.
+     */
+    bool validate() const;
+    /**
+     * Rebuilds the packed time and value buffers from the tracks.
+     */
+    void pack();
+
+    /**
+     * Compresses the clip in place. The tracks and packed float buffers are
+     * released; {@link AnimationClip#trim}, {@link AnimationClip#optimize} and
+     * {@link AnimationClip#pack} have no effect afterwards. Copy the clip first
+     * to keep an uncompressed version, e.g. for {@link AnimationCompression::measureError}.
+     *
+     * @param {AnimationCompression::Settings} settings - The error tolerances.
+     * @return {AnimationClip} A reference to this animation clip.
+     */
+    AnimationClip &compress(const AnimationCompression::Settings &settings = {});
+    bool isCompressed() const;
+    /**
+     * The compressed storage, or `nullptr` if the clip is not compressed.
+     *
+     * @return {AnimationCompression::CompressedClip}
+     */
+    const AnimationCompression::CompressedClip *compressed() const;
+
+private:
+    std::string m_uuid;
+    std::string m_name;
+    float m_duration;
+    std::vector<std::shared_ptr<KeyframeTrack>> m_tracks;
+
+    std::vector<Channel> m_channels;
+    std::vector<float> m_times;
+    std::vector<float> m_values;
+    std::vector<std::string> m_channelNames;
+
+    std::shared_ptr<const AnimationCompression::CompressedClip> m_compressed;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef ANIMATION_COMPRESSION_H
+#define ANIMATION_COMPRESSION_H
+
+#include "animation/AnimationConstants.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AnimationClip;
+
+/**
+ * Compressed keyframe storage for {@link AnimationClip}.
+ *
+ * - Key times are stored as 16-bit ticks: whole frames if all keys lie on
+ *   a common frame grid (24 to 240 fps), else 1/65535 of the clip duration.
+ * - Quaternions are stored smallest-three: the index of the largest
+ *   component plus the other three at 15 bits each, 48 bits per key.
+ * - Positions, scales and numbers are quantized to 16 bits per component
+ *   relative to the per-track value range, via {@link MathUtils::normalize}.
+ *   A track whose range is too wide for its tolerance at 16 bits
+ *   (`extent / 65535 > 2 * tolerance`) keeps float values instead.
+ * - Linear tracks drop every key that linear interpolation between its kept
+ *   neighbours reproduces within the track's tolerance, measured on the
+ *   decoded values.
+ * - Every encoded track is then checked against its source, sampled at all
+ *   source and kept key times and halfway between them. A track that leaves
+ *   its tolerance there falls back to float values, then to float key times
+ *   (which removes the time rounding of off-grid clips), and finally to a
+ *   verbatim copy of its keys. Discrete tracks off the tick grid keep float
+ *   key times from the start, as rounding would move their jumps.
+ *   Between the checked times the error of position, scale and number tracks
+ *   is linear and so stays within the tolerance as well, up to float
+ *   rounding; quaternion tracks are bounded at the checked times.
+ *   {@link CompressedClip#stats} counts the fallbacks and
+ *   {@link AnimationCompression::measureError} reports the error reached.
+ *
+ * Keys are decoded on the fly while sampling; {@link AnimationMixer} does
+ * this transparently for clips compressed with {@link AnimationClip#compress}.
+ */
+namespace AnimationCompression
+{
+    /**
+     * Maximum error allowed per track when dropping keys. Rotation tolerance
+     * is an angle in radians; the others are absolute per component. Tracks
+     * are classified by the property in their name (`.position`, `.scale`).
+     */
+    struct Settings
+    {
+        float translationTolerance = 1e-4f;
+        float rotationTolerance = 1e-4f;
+        float scaleTolerance = 1e-4f;
+        float valueTolerance = 1e-4f;
+    };
+
+    /**
+     * How the key times or values of a track are stored.
+     */
+    enum class KeyFormat : uint8_t
+    {
+        // 16-bit words in CompressedClip::times / CompressedClip::data
+        Quantized,
+        // floats in CompressedClip::exactTimes / CompressedClip::values
+        Float
+    };
+
+    /**
+     * Location and dequantization parameters of one compressed track.
+     * A quantized quaternion key takes three 16-bit words, any other
+     * quantized key `valueSize`. `timeOffset` and `dataOffset` index the
+     * arrays of the respective {@link KeyFormat}.
+     */
+    struct Channel
+    {
+        uint32_t timeOffset;
+        uint32_t keyCount;
+        uint32_t dataOffset;
+        uint32_t valueSize;
+        // `valueSize` minima then `valueSize` extents in CompressedClip::ranges
+        uint32_t rangeOffset;
+        InterpolationMode interpolation;
+        TrackValueType type;
+        KeyFormat timeFormat;
+        KeyFormat valueFormat;
+        float tolerance;
+    };
+
+    /**
+     * Sizes before and after compression.
+     */
+    struct Stats
+    {
+        size_t keysBefore = 0;
+        size_t keysAfter = 0;
+        size_t bytesBefore = 0;
+        size_t bytesAfter = 0;
+        // tracks stored with float values / float key times to stay within tolerance
+        size_t floatValueChannels = 0;
+        size_t floatTimeChannels = 0;
+
+        double ratio() const;
+    };
+
+    /**
+     * Result of {@link AnimationCompression::measureError}.
+     */
+    struct ErrorReport
+    {
+        float maxValueError = 0;
+        float maxRotationError = 0;
+        size_t channelsOutOfTolerance = 0;
+        size_t samples = 0;
+        double decodeSeconds = 0;
+
+        /**
+         * Decoded channel samples per second.
+         *
+         * @return {double}
+         */
+        double throughput() const;
+    };
+
+    /**
+     * The compressed tracks of one clip.
+     */
+    struct CompressedClip
+    {
+        float duration = 0;
+        // time ticks per second
+        float timeScale = 0;
+        std::vector<Channel> channels;
+        std::vector<uint16_t> times;
+        std::vector<uint16_t> data;
+        std::vector<float> exactTimes;
+        std::vector<float> values;
+        std::vector<float> ranges;
+        Stats stats;
+    };
+
+    /**
+     * Compresses the packed tracks of `clip`. Tracks are processed in parallel.
+     *
+     * @param {AnimationClip} clip - The uncompressed clip.
+     * @param {Settings} settings - The error tolerances.
+     * @return {CompressedClip}
+     */
+    CompressedClip compress(const AnimationClip &clip, const Settings &settings = {});
+
+    /**
+     * Samples one compressed track at time `t` and writes `valueSize` floats
+     * to `result`. Same contract as {@link Interpolant::evaluate}.
+     *
+     * @param {CompressedClip} clip - The compressed clip.
+     * @param {size_t} channel - The track index.
+     * @param {float} t - The sample time.
+     * @param {uint32_t} cursor - The cached interval of the channel.
+     * @param {float*} result - Receives the sampled value.
+     */
+    void evaluate(const CompressedClip &clip, size_t channel, float t, uint32_t &cursor, float *result);
+
+    /**
+     * Samples `reference` and `compressed` at `sampleRate` over the whole
+     * duration and reports the largest deviation, the number of tracks
+     * exceeding their tolerance and the time spent decoding.
+     *
+     * @param {AnimationClip} reference - The uncompressed clip.
+     * @param {CompressedClip} compressed - The compressed version of `reference`.
+     * @param {float} [sampleRate=60] - Samples per second.
+     * @return {ErrorReport}
+     */
+    ErrorReport measureError(const AnimationClip &reference, const CompressedClip &compressed, float sampleRate = 60);
+}
+
+#endif
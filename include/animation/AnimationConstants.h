@@ -0,0 +1,36 @@
+#ifndef ANIMATION_CONSTANTS_H
+#define ANIMATION_CONSTANTS_H
+
+/**
+ * Interpolation modes of a {@link KeyframeTrack}.
+ */
+enum class InterpolationMode
+{
+    Discrete,
+    Linear,
+    // linear interpolation eased with MathUtils::smoothstep between keys
+    Smooth
+};
+
+/**
+ * The kind of value a {@link KeyframeTrack} animates. Quaternion tracks are
+ * interpolated with a spherical linear interpolation.
+ */
+enum class TrackValueType
+{
+    Number,
+    Vector,
+    Quaternion
+};
+
+/**
+ * Loop modes of an {@link AnimationAction}.
+ */
+enum class LoopMode
+{
+    Once,
+    Repeat,
+    PingPong
+};
+
+#endif
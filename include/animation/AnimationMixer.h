@@ -0,0 +1,168 @@
+#ifndef ANIMATION_MIXER_H
+#define ANIMATION_MIXER_H
+
+#include "animation/AnimationAction.h"
+#include "common/Allocators.h"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Object3D;
+
+/**
+ * `AnimationMixer` is a player for animations on a particular object in the
+ * scene. When multiple objects in the scene are animated independently, one
+ * `AnimationMixer` may be used for each object.
+ *
+ * Every animated property is a binding with a slot in one contiguous
+ * accumulation buffer. {@link AnimationMixer#update} samples all channels of
+ * all running actions and blends them into those slots, then writes every
+ * touched binding back to its target in a single pass. Both passes are split
+ * across threads for large channel counts.
+ * ```c++
+ * AnimationMixer mixer(root.get());
+ * mixer.clipAction(clip)->play();
+ * mixer.update(deltaTime);
+ * ```
+ */
+class AnimationMixer
+{
+public:
+    static constexpr uint32_t NO_BINDING = UINT32_MAX;
+
+    /**
+     * Constructs a new animation mixer.
+     *
+     * @param {Object3D} root - The object whose animations shall be played by this mixer.
+     * @param {std::pmr::memory_resource} [resource=std::pmr::get_default_resource()] - Backs the actions and the binding buffers.
+     */
+    AnimationMixer(Object3D *root, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+    ~AnimationMixer();
+
+    /**
+     * The global mixer time (in seconds; starting with `0` on the mixer's creation).
+     */
+    float time = 0;
+    /**
+     * A scaling factor for the global time.
+     */
+    float timeScale = 1;
+
+    /**
+     * Returns an instance of {@link AnimationAction} for the passed clip.
+     * Calling this method several times with the same clip and root returns the
+     * same action.
+     *
+     * @param {std::shared_ptr<AnimationClip>} clip - An animation clip.
+     * @param {Object3D} [optionalRoot] - An alternative root object; defaults to the mixer root.
+     * @return {AnimationAction} The animation action.
+     */
+    AnimationAction *clipAction(const std::shared_ptr<AnimationClip> &clip, Object3D *optionalRoot = nullptr);
+    /**
+     * Returns an existing animation action for the passed clip, or `nullptr`.
+     *
+     * @param {std::shared_ptr<AnimationClip>} clip - An animation clip.
+     * @param {Object3D} [optionalRoot] - An alternative root object.
+     * @return {AnimationAction} The animation action.
+     */
+    AnimationAction *existingAction(const std::shared_ptr<AnimationClip> &clip, Object3D *optionalRoot = nullptr) const;
+    /**
+     * Registers an animatable float property that is not a transform of an
+     * {@link Object3D}, e.g. a morph target influence. Tracks whose name equals
+     * `path` write `valueSize` floats to `target`. Must be called before the
+     * actions using it are created.
+     *
+     * @param {std::string} path - The track name to match.
+     * @param {float*} target - The property storage.
+     * @param {uint32_t} valueSize - The number of floats.
+     */
+    void registerProperty(const std::string &path, float *target, uint32_t valueSize);
+
+    /**
+     * Advances the global mixer time and updates the animation.
+     *
+     * @param {float} deltaTime - The delta time in seconds.
+     * @return {AnimationMixer} A reference to this animation mixer.
+     */
+    AnimationMixer &update(float deltaTime);
+    /**
+     * Sets the global mixer to a specific time and updates the animation accordingly.
+     *
+     * @param {float} time - The time to set in seconds.
+     * @return {AnimationMixer} A reference to this animation mixer.
+     */
+    AnimationMixer &setTime(float time);
+    /**
+     * Deactivates all previously scheduled actions on this mixer.
+     *
+     * @return {AnimationMixer} A reference to this animation mixer.
+     */
+    AnimationMixer &stopAllAction();
+    /**
+     * Deallocates all memory resources for a clip. Its actions are stopped
+     * and destroyed.
+     *
+     * @param {std::shared_ptr<AnimationClip>} clip - The clip to uncache.
+     */
+    void uncacheClip(const std::shared_ptr<AnimationClip> &clip);
+
+    Object3D *getRoot() const;
+    size_t bindingCount() const;
+    size_t activeActionCount() const;
+
+private:
+    friend class AnimationAction;
+
+    enum class PropertyType
+    {
+        Position,
+        Quaternion,
+        Scale,
+        Custom
+    };
+
+    struct Binding
+    {
+        Object3D *node;
+        float *custom;
+        PropertyType property;
+        TrackValueType valueType;
+        uint32_t valueSize;
+        uint32_t offset;
+    };
+
+    void activateAction(AnimationAction *action);
+    void deactivateAction(AnimationAction *action);
+    bool isActive(const AnimationAction *action) const;
+    void accumulateChannels(AnimationAction &action, float clipTime, float weight, size_t begin, size_t end);
+    void applyBindings(size_t begin, size_t end);
+    Object3D *findNode(Object3D *root, const std::string &name);
+    uint32_t resolveBinding(const std::string &trackName, Object3D *root, const AnimationClip::Channel &channel);
+    void readBinding(const Binding &binding, float *values) const;
+    void writeBinding(const Binding &binding, const float *values);
+
+    Object3D *m_root;
+
+    // actions are pooled, so clips cached and uncached during play reuse memory
+    ObjectPool<AnimationAction> m_actionPool;
+    std::pmr::vector<AnimationAction *> m_actions;
+    std::pmr::vector<AnimationAction *> m_activeActions;
+
+    std::pmr::vector<Binding> m_bindings;
+    std::unordered_map<std::string, uint32_t> m_bindingsByName;
+    std::unordered_map<std::string, std::pair<float *, uint32_t>> m_customProperties;
+    // name -> node lookup per root, built on first use instead of one tree walk per track
+    std::unordered_map<Object3D *, std::unordered_map<std::string, Object3D *>> m_nodesByName;
+
+    // accumulation state, indexed by Binding::offset (values) or binding index (weights)
+    std::pmr::vector<float> m_accumulator;
+    std::pmr::vector<float> m_original;
+    std::pmr::vector<float> m_cumulativeWeight;
+    // the widest channel with a binding, which sizes the sample scratch
+    uint32_t m_maxValueSize = 0;
+};
+
+#endif
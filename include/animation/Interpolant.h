@@ -0,0 +1,54 @@
+#ifndef INTERPOLANT_H
+#define INTERPOLANT_H
+
+#include "animation/AnimationConstants.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Keyframe sampling over packed `times`/`values` buffers.
+ *
+ * Every channel keeps a cursor: the index of the key interval sampled last.
+ * Animation time moves forward in small steps, so the next sample almost
+ * always lies in the same or the following interval and {@link Interpolant::seek}
+ * is O(1) amortized. Only jumps (seeking, loop wrap) fall back to a binary
+ * search.
+ */
+namespace Interpolant
+{
+    /**
+     * Finds the key interval `[times[i], times[i + 1])` that contains `t`,
+     * starting from and updating `cursor`. The result is clamped to
+     * `[0, count - 2]`.
+     *
+     * @param {const float*} times - The key times, sorted ascending.
+     * @param {uint32_t} count - The number of keys, at least `2`.
+     * @param {float} t - The sample time.
+     * @param {uint32_t} cursor - The cached interval of the channel.
+     * @return {uint32_t} The interval index.
+     */
+    uint32_t seek(const float *times, uint32_t count, float t, uint32_t &cursor);
+    /**
+     * Same as above for 16-bit quantized key times; `t` is given in the
+     * same quantized units.
+     */
+    uint32_t seek(const uint16_t *times, uint32_t count, float t, uint32_t &cursor);
+
+    /**
+     * Samples one channel at time `t` and writes `valueSize` floats to `result`.
+     *
+     * @param {const float*} times - The key times of the channel.
+     * @param {const float*} values - The key values of the channel, `valueSize` per key.
+     * @param {uint32_t} count - The number of keys.
+     * @param {uint32_t} valueSize - The number of values per key.
+     * @param {InterpolationMode} interpolation - The interpolation mode.
+     * @param {TrackValueType} type - The value type; quaternions are slerped.
+     * @param {float} t - The sample time.
+     * @param {uint32_t} cursor - The cached interval of the channel.
+     * @param {float*} result - Receives the sampled value.
+     */
+    void evaluate(const float *times, const float *values, uint32_t count, uint32_t valueSize,
+                  InterpolationMode interpolation, TrackValueType type, float t, uint32_t &cursor, float *result);
+}
+
+#endif
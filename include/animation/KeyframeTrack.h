@@ -0,0 +1,92 @@
+#ifndef KEYFRAME_TRACK_H
+#define KEYFRAME_TRACK_H
+
+#include "animation/AnimationConstants.h"
+#include <string>
+#include <vector>
+
+/**
+ * A track of keyframes: a timed sequence of values for one animated property.
+ *
+ * The track name addresses the animated property as `nodeName.property`,
+ * e.g. `"Hips.quaternion"`. An empty node name refers to the mixer root.
+ * ```c++
+ * VectorKeyframeTrack track(".position", {0, 1}, {0, 0, 0, 0, 1, 0});
+ * ```
+ */
+class KeyframeTrack
+{
+public:
+    /**
+     * Constructs a new keyframe track.
+     *
+     * @param {std::string} name - The keyframe track's name.
+     * @param {std::vector<float>} times - A list of keyframe times.
+     * @param {std::vector<float>} values - A list of keyframe values, `valueSize` per key.
+     * @param {InterpolationMode} [interpolation=Linear] - The interpolation type.
+     */
+    KeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation = InterpolationMode::Linear);
+    virtual ~KeyframeTrack();
+
+    virtual TrackValueType valueType() const = 0;
+    virtual std::string valueTypeName() const = 0;
+
+    const std::string &name() const;
+    const std::vector<float> &times() const;
+    const std::vector<float> &values() const;
+    InterpolationMode interpolation() const;
+    KeyframeTrack &setInterpolation(InterpolationMode interpolation);
+    size_t keyCount() const;
+    /**
+     * Returns the value size, i.e. the number of values per keyframe.
+     *
+     * @return {size_t} The value size.
+     */
+    size_t getValueSize() const;
+
+    /**
+     * Moves all keyframes either forward or backward in time.
+     *
+     * @param {float} timeOffset - The offset to move the time values.
+     * @return {KeyframeTrack} A reference to this keyframe track.
+     */
+    KeyframeTrack &shift(float timeOffset);
+    /**
+     * Scale all keyframe times by a factor (useful for frame - seconds conversions).
+     *
+     * @param {float} timeScale - The time scale.
+     * @return {KeyframeTrack} A reference to this keyframe track.
+     */
+    KeyframeTrack &scale(float timeScale);
+    /**
+     * Removes keyframes before and after animation without changing any values
+     * within the defined time range.
+     *
+     * @param {float} startTime - The start time.
+     * @param {float} endTime - The end time.
+     * @return {KeyframeTrack} A reference to this keyframe track.
+     */
+    KeyframeTrack &trim(float startTime, float endTime);
+    /**
+     * Performs minimal validation on the keyframe track. Returns `true` if the values
+     * are valid.
+     *
+     * @return {bool} Whether the keyframes are valid or not.
+     */
+    bool validate() const;
+    /**
+     * Optimizes this keyframe track by removing equivalent sequential keys (which are
+     * common in morph target sequences).
+     *
+     * @return {KeyframeTrack} A reference to this keyframe track.
+     */
+    KeyframeTrack &optimize();
+
+protected:
+    std::string m_name;
+    std::vector<float> m_times;
+    std::vector<float> m_values;
+    InterpolationMode m_interpolation;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef NUMBER_KEYFRAME_TRACK_H
+#define NUMBER_KEYFRAME_TRACK_H
+
+#include "animation/KeyframeTrack.h"
+
+/**
+ * A track for numeric keyframe values.
+ */
+class NumberKeyframeTrack : public KeyframeTrack
+{
+public:
+    NumberKeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation = InterpolationMode::Linear);
+    ~NumberKeyframeTrack() override;
+
+    TrackValueType valueType() const override;
+    std::string valueTypeName() const override;
+};
+
+#endif
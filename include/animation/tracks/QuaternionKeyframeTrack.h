@@ -0,0 +1,20 @@
+#ifndef QUATERNION_KEYFRAME_TRACK_H
+#define QUATERNION_KEYFRAME_TRACK_H
+
+#include "animation/KeyframeTrack.h"
+
+/**
+ * A track for quaternion keyframe values, stored as `(x, y, z, w)`.
+ * Linear and smooth modes use a spherical linear interpolation.
+ */
+class QuaternionKeyframeTrack : public KeyframeTrack
+{
+public:
+    QuaternionKeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation = InterpolationMode::Linear);
+    ~QuaternionKeyframeTrack() override;
+
+    TrackValueType valueType() const override;
+    std::string valueTypeName() const override;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef VECTOR_KEYFRAME_TRACK_H
+#define VECTOR_KEYFRAME_TRACK_H
+
+#include "animation/KeyframeTrack.h"
+
+/**
+ * A track for vector keyframe values. The value size follows from the
+ * number of values per key (2, 3 or 4 components).
+ */
+class VectorKeyframeTrack : public KeyframeTrack
+{
+public:
+    VectorKeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation = InterpolationMode::Linear);
+    ~VectorKeyframeTrack() override;
+
+    TrackValueType valueType() const override;
+    std::string valueTypeName() const override;
+};
+
+#endif
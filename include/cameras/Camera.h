@@ -0,0 +1,49 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "core/Object3D.h"
+
+/**
+ * Abstract base class for cameras. This class should always be inherited
+ * when you build a new camera.
+ */
+class Camera : public Object3D
+{
+public:
+    Camera();
+    ~Camera() override;
+
+    std::string type() const override;
+
+    /**
+     * The inverse of the camera's world matrix.
+     *
+     * @return {Matrix4}
+     */
+    Matrix4 &matrixWorldInverse();
+    const Matrix4 &matrixWorldInverse() const;
+    /**
+     * The camera's projection matrix.
+     *
+     * @return {Matrix4}
+     */
+    Matrix4 &projectionMatrix();
+    const Matrix4 &projectionMatrix() const;
+    /**
+     * The inverse of the camera's projection matrix.
+     *
+     * @return {Matrix4}
+     */
+    Matrix4 &projectionMatrixInverse();
+    const Matrix4 &projectionMatrixInverse() const;
+
+    void updateMatrixWorld(bool force = false) override;
+    void updateWorldMatrix(bool updateParents, bool updateChildren) override;
+
+private:
+    Matrix4 m_matrixWorldInverse;
+    Matrix4 m_projectionMatrix;
+    Matrix4 m_projectionMatrixInverse;
+};
+
+#endif
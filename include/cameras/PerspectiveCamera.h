@@ -0,0 +1,57 @@
+#ifndef PERSPECTIVE_CAMERA_H
+#define PERSPECTIVE_CAMERA_H
+
+#include "cameras/Camera.h"
+
+/**
+ * Camera that uses perspective projection.
+ * ```c++
+ * auto camera = std::make_shared<PerspectiveCamera>(45, width / height, 1, 1000);
+ * scene->add(camera);
+ * ```
+ */
+class PerspectiveCamera : public Camera
+{
+public:
+    /**
+     * Constructs a new perspective camera.
+     *
+     * @param {float} [fov=50] - The vertical field of view, in degrees.
+     * @param {float} [aspect=1] - The aspect ratio.
+     * @param {float} [near=0.1] - The camera's near plane.
+     * @param {float} [far=2000] - The camera's far plane.
+     */
+    PerspectiveCamera(float fov = 50, float aspect = 1, float near = 0.1f, float far = 2000);
+    ~PerspectiveCamera() override;
+
+    std::string type() const override;
+
+    /**
+     * The vertical field of view, from bottom to top of view, in degrees.
+     */
+    float fov;
+    /**
+     * The zoom factor of the camera.
+     */
+    float zoom = 1;
+    /**
+     * The camera's near plane. Must be greater than `0`.
+     */
+    float near;
+    /**
+     * The camera's far plane. Must be greater than {@link PerspectiveCamera#near}.
+     */
+    float far;
+    /**
+     * The aspect ratio, usually the canvas width divided by the canvas height.
+     */
+    float aspect;
+
+    /**
+     * Updates the camera's projection matrix. Must be called after any change
+     * of the camera's properties.
+     */
+    void updateProjectionMatrix();
+};
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef ALLOCATORS_H
+#define ALLOCATORS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Counters of a memory resource. `bytes` and `allocations` only grow;
+ * `liveBytes` is what is currently handed out and `peakBytes` its maximum.
+ * `upstreamAllocations` counts the blocks a resource had to request from
+ * its upstream, so it stays constant once a frame loop reached steady state.
+ */
+struct AllocationStats
+{
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytes = 0;
+    size_t liveBytes = 0;
+    size_t peakBytes = 0;
+    size_t upstreamAllocations = 0;
+    size_t upstreamBytes = 0;
+
+    size_t liveAllocations() const;
+};
+
+/**
+ * Forwards to an upstream resource and counts every allocation. Safe to use
+ * from several threads.
+ * ```c++
+ * TrackingResource tracking;
+ * std::pmr::vector<float> values(&tracking);
+ * values.resize(1024);
+ * printf("%zu bytes\n", tracking.stats().liveBytes);
+ * ```
+ */
+class TrackingResource : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @param {std::pmr::memory_resource} [upstream=std::pmr::get_default_resource()] - The resource that allocates.
+     */
+    explicit TrackingResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    ~TrackingResource() override;
+
+    AllocationStats stats() const;
+    void resetStats();
+
+private:
+    std::pmr::memory_resource *m_upstream;
+
+    std::atomic<size_t> m_allocations{0};
+    std::atomic<size_t> m_deallocations{0};
+    std::atomic<size_t> m_bytes{0};
+    std::atomic<size_t> m_liveBytes{0};
+    std::atomic<size_t> m_peakBytes{0};
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+};
+
+/**
+ * Linear allocator for memory that lives until the end of a frame.
+ * Allocating bumps a pointer, deallocating does nothing and
+ * {@link FrameArena#reset} releases everything at once.
+ *
+ * When a frame overflows the arena another block is taken from upstream;
+ * the next reset merges all blocks into one of the combined size, so after
+ * the first few frames the arena no longer allocates at all. Not safe to
+ * share between threads; use one arena per thread.
+ * ```c++
+ * FrameArena arena(1 << 20);
+ * while (running)
+ * {
+ *     std::pmr::vector<Vector3> hits(&arena);
+ *     auto weights = arena.allocateArray<float>(count);
+ *     ...
+ *     arena.reset();
+ * }
+ * ```
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @param {size_t} [capacity=1048576] - Bytes reserved up front.
+     * @param {std::pmr::memory_resource} [upstream=std::pmr::get_default_resource()] - The resource blocks come from.
+     */
+    explicit FrameArena(size_t capacity = size_t(1) << 20, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /**
+     * Returns uninitialized storage for `count` objects of a trivially
+     * destructible type, valid until the next reset.
+     *
+     * @param {size_t} count - The number of objects.
+     * @return {std::span<T>}
+     */
+    template <typename T>
+    std::span<T> allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena: objects are never destroyed");
+        return {static_cast<T *>(allocate(count * sizeof(T), alignof(T))), count};
+    }
+
+    /**
+     * Releases everything allocated since the last reset. Invalidates all
+     * pointers into the arena.
+     */
+    void reset();
+
+    size_t capacity() const;
+    size_t used() const;
+    /**
+     * Counters since construction; `liveBytes` is the usage of the current
+     * frame and `peakBytes` the largest frame so far.
+     *
+     * @return {AllocationStats}
+     */
+    AllocationStats stats() const;
+
+private:
+    struct Block
+    {
+        std::byte *data;
+        size_t size;
+    };
+
+    std::pmr::memory_resource *m_upstream;
+    std::vector<Block> m_blocks;
+    std::byte *m_cursor = nullptr;
+    std::byte *m_end = nullptr;
+    // bytes in the blocks before the current one
+    size_t m_usedBefore = 0;
+    AllocationStats m_stats;
+
+    void addBlock(size_t size);
+    void releaseBlocks();
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+};
+
+/**
+ * Fixed-size block allocator. Requests up to `blockSize` bytes are served
+ * from a free list refilled in chunks of `blocksPerChunk` blocks, larger
+ * ones go upstream. Freed blocks are reused but chunks are only returned
+ * on destruction or {@link PoolResource#release}. Not safe to share
+ * between threads.
+ */
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @param {size_t} blockSize - The largest request served from the pool.
+     * @param {size_t} [blocksPerChunk=256] - Blocks taken from upstream at once.
+     * @param {std::pmr::memory_resource} [upstream=std::pmr::get_default_resource()] - The resource chunks come from.
+     */
+    explicit PoolResource(size_t blockSize, size_t blocksPerChunk = 256, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    ~PoolResource() override;
+
+    PoolResource(const PoolResource &) = delete;
+    PoolResource &operator=(const PoolResource &) = delete;
+
+    size_t blockSize() const;
+    /**
+     * Returns all chunks upstream. Every block must have been deallocated.
+     */
+    void release();
+    AllocationStats stats() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    size_t m_blockSize;
+    size_t m_blocksPerChunk;
+    std::pmr::memory_resource *m_upstream;
+    std::vector<std::pair<void *, size_t>> m_chunks;
+    FreeBlock *m_free = nullptr;
+    AllocationStats m_stats;
+
+    bool fits(size_t bytes, size_t alignment) const;
+    void refill();
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+};
+
+/**
+ * Typed pool for objects created and destroyed often, e.g. scene nodes,
+ * animation actions or hit records. Objects must not outlive the pool.
+ * ```c++
+ * ObjectPool<Mesh> meshes;
+ * auto mesh = meshes.makeShared(geometry);  // node and control block pooled
+ * scene->add(mesh);
+ * ```
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    // room for the control block of makeShared, which holds the deleter
+    static constexpr size_t CONTROL_BLOCK_SIZE = 64;
+
+    /**
+     * @param {size_t} [objectsPerChunk=256] - Objects allocated upstream at once.
+     * @param {std::pmr::memory_resource} [upstream=std::pmr::get_default_resource()] - The resource chunks come from.
+     */
+    explicit ObjectPool(size_t objectsPerChunk = 256, std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : m_objects(sizeof(T), objectsPerChunk, upstream),
+          m_controlBlocks(CONTROL_BLOCK_SIZE, objectsPerChunk, upstream)
+    {
+    }
+
+    template <typename... Args>
+    T *create(Args &&...args)
+    {
+        void *storage = m_objects.allocate(sizeof(T), alignof(T));
+        try
+        {
+            return ::new (storage) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            m_objects.deallocate(storage, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+
+    void destroy(T *object)
+    {
+        if (object == nullptr)
+            return;
+        object->~T();
+        m_objects.deallocate(object, sizeof(T), alignof(T));
+    }
+
+    /**
+     * Creates an object owned by a `std::shared_ptr` whose object and
+     * control block both come from the pool.
+     *
+     * @return {std::shared_ptr<T>}
+     */
+    template <typename... Args>
+    std::shared_ptr<T> makeShared(Args &&...args)
+    {
+        T *object = create(std::forward<Args>(args)...);
+        return std::shared_ptr<T>(object, [this](T *pointer)
+                                  { destroy(pointer); },
+                                  std::pmr::polymorphic_allocator<T>(&m_controlBlocks));
+    }
+
+    AllocationStats stats() const
+    {
+        return m_objects.stats();
+    }
+
+private:
+    PoolResource m_objects;
+    PoolResource m_controlBlocks;
+};
+
+#endif
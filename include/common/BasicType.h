@@ -4,7 +4,10 @@
 #include <numbers>
 #include <random> 
 
-#if defined(__x86_64__) || defined(__i386__)
+// THREECPP_HIGH_PRECISION overrides the scalar type, e.g. for benchmarking
+#if defined(THREECPP_HIGH_PRECISION)
+  #define HIGH_PRECISION THREECPP_HIGH_PRECISION
+#elif defined(__x86_64__) || defined(__i386__)
   #define HIGH_PRECISION long double
 #else
   #define HIGH_PRECISION double
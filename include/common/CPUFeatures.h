@@ -0,0 +1,58 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+/**
+ * Function multiversioning for hot loops written in plain C++.
+ *
+ * A function marked with `THREECPP_TARGET_CLONES` is compiled once per
+ * instruction set and the dynamic loader binds the best one for the running
+ * CPU, so a baseline x86-64 build still uses AVX2 or AVX-512 where present.
+ * The clones enable no FMA, so every path rounds exactly like SSE2.
+ * Requires GCC or Clang on an ELF platform with ifunc support; elsewhere,
+ * with `THREECPP_MULTIVERSIONING` undefined (CMake option
+ * `THREECPP_ENABLE_MULTIVERSIONING`) or when the build already targets
+ * AVX-512, the macro is empty.
+ * ```c++
+ * THREECPP_TARGET_CLONES
+ * void scale(float *__restrict values, size_t count, float factor)
+ * {
+ *     for (size_t i = 0; i < count; i++)
+ *         values[i] *= factor;
+ * }
+ * ```
+ */
+#if defined(THREECPP_MULTIVERSIONING) && (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && defined(__ELF__) && !defined(__AVX512F__)
+#define THREECPP_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define THREECPP_TARGET_CLONES
+#endif
+
+namespace CPUFeatures
+{
+    /**
+     * The widest instruction set of the running CPU that the clones use:
+     * `"avx512f"`, `"avx2"`, `"sse2"`, `"neon"` or `"scalar"`.
+     *
+     * @return {const char*}
+     */
+    inline const char *best()
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        if (__builtin_cpu_supports("avx512f"))
+            return "avx512f";
+        if (__builtin_cpu_supports("avx2"))
+            return "avx2";
+        if (__builtin_cpu_supports("sse2"))
+            return "sse2";
+        return "scalar";
+#elif defined(__x86_64__) || defined(_M_X64)
+        return "sse2";
+#elif defined(__ARM_NEON)
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+}
+
+#endif
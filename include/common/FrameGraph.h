@@ -0,0 +1,85 @@
+#ifndef FRAME_GRAPH_H
+#define FRAME_GRAPH_H
+
+#include "common/JobSystem.h"
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * The per-frame work of an application as passes with dependencies, built
+ * once and executed every frame on a {@link JobSystem}. Independent passes
+ * run concurrently; a pass may itself split its work with
+ * {@link Parallel::parallelFor}, e.g. the batch matrix, bounding volume,
+ * skinning and culling kernels.
+ * ```c++
+ * FrameGraph frame;
+ * auto animation = frame.addPass("animation", [&]() { mixer.update(delta); });
+ * auto skinning = frame.addPass("skinning", [&]() { CPUSkinning::skinMeshes(skinnedMeshes, CPUSkinning::SkinningMethod::LinearBlend); }, {animation});
+ * auto culling = frame.addPass("culling", [&]() { instances->cull(viewProjection, visible); });
+ * frame.addPass("submit", [&]() { submit(visible); }, {skinning, culling});
+ * frame.execute();
+ * ```
+ */
+class FrameGraph
+{
+public:
+    using Pass = size_t;
+
+    FrameGraph();
+    ~FrameGraph();
+
+    /**
+     * Adds a pass that runs after the passes in `after`. Passes can only
+     * depend on earlier passes, so the graph never has cycles.
+     *
+     * @param {std::string} name - The name of the pass.
+     * @param {std::function<void()>} execute - The work of the pass.
+     * @param {std::vector<Pass>} [after={}] - Passes that must finish first.
+     * @return {Pass} The handle of the new pass.
+     */
+    Pass addPass(std::string name, std::function<void()> execute, std::vector<Pass> after = {});
+    void clear();
+
+    size_t size() const;
+    const std::string &name(Pass pass) const;
+    /**
+     * Wall time of `pass` in the last {@link FrameGraph#execute}.
+     *
+     * @param {Pass} pass - The pass.
+     * @return {double} The time in seconds.
+     */
+    double seconds(Pass pass) const;
+
+    /**
+     * Runs every pass once and returns when all have finished. The first
+     * exception thrown by a pass is rethrown afterwards.
+     *
+     * @param {JobSystem} [jobs=JobSystem::instance()] - The scheduler to run on.
+     */
+    void execute(JobSystem &jobs = JobSystem::instance());
+
+private:
+    struct PassData
+    {
+        std::string name;
+        std::function<void()> execute;
+        std::vector<Pass> after;
+        size_t dependents = 0;
+        double seconds = 0;
+        // the name as a profiler zone, when profiling is compiled in
+        const char *zone = nullptr;
+    };
+
+    std::vector<PassData> m_passes;
+    std::vector<JobSystem::Job *> m_jobs;
+    std::exception_ptr m_error;
+    std::mutex m_errorMutex;
+
+    void runPass(Pass pass);
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * A minimal JSON document model, enough to read asset descriptions such as
+ * glTF. Objects keep their members in file order; lookups are linear, which
+ * is fine for the small objects these formats use.
+ * ```c++
+ * auto document = JSON::parse(R"({"asset": {"version": "2.0"}})");
+ * document["asset"]["version"].asString(); // "2.0"
+ * ```
+ */
+namespace JSON
+{
+    enum class Type
+    {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    class Value
+    {
+    public:
+        Value() = default;
+
+        Type type() const;
+        bool isNull() const;
+        bool isNumber() const;
+        bool isString() const;
+        bool isArray() const;
+        bool isObject() const;
+
+        bool asBool(bool fallback = false) const;
+        double asNumber(double fallback = 0) const;
+        /**
+         * The value as an integer, `fallback` if it is not a number.
+         *
+         * @param {long long} [fallback=0] - The value to return otherwise.
+         * @return {long long}
+         */
+        long long asInt(long long fallback = 0) const;
+        const std::string &asString() const;
+
+        /**
+         * Number of array elements or object members, `0` otherwise.
+         *
+         * @return {size_t}
+         */
+        size_t size() const;
+        /**
+         * The array element at `index`, or a null value if out of range.
+         */
+        const Value &operator[](size_t index) const;
+        /**
+         * The object member named `key`, or a null value if missing.
+         */
+        const Value &operator[](std::string_view key) const;
+        bool contains(std::string_view key) const;
+
+        const std::vector<Value> &elements() const;
+        const std::vector<std::pair<std::string, Value>> &members() const;
+
+    private:
+        friend class Parser;
+
+        Type m_type = Type::Null;
+        bool m_bool = false;
+        double m_number = 0;
+        std::string m_string;
+        std::vector<Value> m_elements;
+        std::vector<std::pair<std::string, Value>> m_members;
+    };
+
+    /**
+     * Parses a JSON document. Throws `std::runtime_error` on malformed input.
+     *
+     * @param {std::string_view} text - The JSON text.
+     * @return {Value} The root value.
+     */
+    Value parse(std::string_view text);
+}
+
+#endif
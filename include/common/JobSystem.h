@@ -0,0 +1,232 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Work-stealing task scheduler. Every thread owns a deque: it pushes and
+ * pops its own jobs at the back, idle threads steal from the front of the
+ * others. A thread waiting for a job keeps executing other jobs meanwhile,
+ * so jobs may spawn and wait for jobs (fork/join) without blocking a worker.
+ *
+ * Jobs live in per-thread ring pools and store their callable inline, so
+ * creating one allocates nothing. Slots are handed out round-robin and
+ * skipped while their job is still in flight; a thread with all
+ * {@link JobSystem::POOL_SIZE} slots in flight runs other jobs until one
+ * finishes, so creating a job never fails.
+ *
+ * - A job counts as finished once it and all its children have run.
+ * - {@link JobSystem#addDependency} defers a job until another finished.
+ * - {@link JobSystem#parallelFor} splits a range into chunk jobs.
+ *
+ * {@link Parallel::parallelFor} runs on {@link JobSystem::instance}.
+ * ```c++
+ * auto &jobs = JobSystem::instance();
+ * auto *root = jobs.createEmpty();
+ * auto *a = jobs.create([&]() { updateAnimation(); }, root);
+ * auto *b = jobs.create([&]() { updateSkinning(); }, root);
+ * jobs.addDependency(b, a);
+ * jobs.run(a);
+ * jobs.run(b);
+ * jobs.run(root);
+ * jobs.wait(root);
+ * ```
+ */
+class JobSystem
+{
+public:
+    // jobs per thread pool, and capacity of each deque
+    static constexpr size_t POOL_SIZE = 4096;
+    // bytes available for a job's callable
+    static constexpr size_t PAYLOAD_SIZE = 64;
+    // jobs that may depend on a single job
+    static constexpr size_t MAX_SUCCESSORS = 12;
+    // chunks per thread when parallelFor picks the grain
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    struct Job
+    {
+        void (*function)(Job &) = nullptr;
+        Job *parent = nullptr;
+        // this job plus its unfinished children
+        std::atomic<int32_t> unfinished{0};
+        // unfinished prerequisites plus one until run() is called
+        std::atomic<int32_t> pending{0};
+        std::atomic<uint32_t> successorCount{0};
+        Job *successors[MAX_SUCCESSORS];
+        alignas(16) unsigned char payload[PAYLOAD_SIZE];
+    };
+
+    /**
+     * Scheduling counters since construction.
+     */
+    struct Stats
+    {
+        size_t executed = 0;
+        size_t stolen = 0;
+    };
+
+    /**
+     * Starts `threadCount - 1` worker threads; the thread calling
+     * {@link JobSystem#wait} is the last one.
+     *
+     * @param {size_t} [threadCount=0] - The number of threads, `0` for {@link Parallel::workerCount}.
+     */
+    explicit JobSystem(size_t threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /**
+     * The shared scheduler, created on first use with one thread per core.
+     *
+     * @return {JobSystem}
+     */
+    static JobSystem &instance();
+
+    size_t threadCount() const;
+    Stats stats() const;
+
+    /**
+     * Creates a job running `function`, a callable of at most
+     * {@link JobSystem::PAYLOAD_SIZE} bytes that is trivially destructible,
+     * e.g. a lambda capturing by reference or a few values. Nothing runs
+     * until {@link JobSystem#run}.
+     *
+     * @param {F} function - The work, called once without arguments.
+     * @param {Job*} [parent=nullptr] - A job that only finishes after this one.
+     * @return {Job*}
+     */
+    template <typename F>
+    Job *create(F &&function, Job *parent = nullptr)
+    {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= PAYLOAD_SIZE, "JobSystem: callable too large, capture by reference");
+        static_assert(alignof(Callable) <= 16, "JobSystem: callable over-aligned");
+        static_assert(std::is_trivially_destructible_v<Callable>, "JobSystem: callable must be trivially destructible");
+
+        Job *job = allocate(parent);
+        ::new (static_cast<void *>(job->payload)) Callable(std::forward<F>(function));
+        job->function = [](Job &self)
+        {
+            (*std::launder(reinterpret_cast<Callable *>(self.payload)))();
+        };
+
+        return job;
+    }
+    /**
+     * Creates a job without work, to group children or as a join point.
+     *
+     * @param {Job*} [parent=nullptr] - A job that only finishes after this one.
+     * @return {Job*}
+     */
+    Job *createEmpty(Job *parent = nullptr);
+
+    /**
+     * Defers `job` until `prerequisite` has finished. Both must be created
+     * and neither run yet.
+     *
+     * @param {Job*} job - The dependent job.
+     * @param {Job*} prerequisite - The job to finish first.
+     */
+    void addDependency(Job *job, Job *prerequisite);
+    /**
+     * Schedules `job`; it starts once all its prerequisites have finished.
+     *
+     * @param {Job*} job - The job to schedule.
+     */
+    void run(Job *job);
+    /**
+     * Executes other jobs until `job` and its children have finished.
+     *
+     * @param {Job*} job - The job to wait for.
+     */
+    void wait(Job *job);
+    bool isFinished(const Job *job) const;
+
+    /**
+     * Grain that splits `count` items into {@link JobSystem::CHUNKS_PER_THREAD}
+     * chunks per thread, so stealing can balance uneven chunks.
+     *
+     * @param {size_t} count - The number of items.
+     * @return {size_t}
+     */
+    size_t autoGrain(size_t count) const;
+
+    /**
+     * Runs `body(begin, end)` over contiguous chunks of `[begin, end)` of at
+     * least `grainSize` items and waits for all of them. The caller works on
+     * chunks too; a single chunk runs inline.
+     *
+     * @param {size_t} begin - First index of the range.
+     * @param {size_t} end - One past the last index of the range.
+     * @param {F} body - Called once per chunk with its sub-range.
+     * @param {size_t} [grainSize=0] - Minimum items per chunk, `0` for {@link JobSystem#autoGrain}.
+     */
+    template <typename F>
+    void parallelFor(size_t begin, size_t end, const F &body, size_t grainSize = 0)
+    {
+        if (end <= begin)
+            return;
+
+        const size_t total = end - begin;
+        const size_t grain = grainSize > 0 ? grainSize : autoGrain(total);
+        const size_t chunks = std::min((total + grain - 1) / grain, threadCount() * CHUNKS_PER_THREAD);
+
+        if (chunks <= 1)
+        {
+            body(begin, end);
+            return;
+        }
+
+        const size_t chunkSize = (total + chunks - 1) / chunks;
+        Job *root = createEmpty();
+
+        for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize)
+        {
+            const size_t chunkEnd = std::min(end, chunkBegin + chunkSize);
+            run(create([&body, chunkBegin, chunkEnd]()
+                       { body(chunkBegin, chunkEnd); },
+                       root));
+        }
+
+        run(root);
+        wait(root);
+    }
+
+private:
+    struct Queue;
+    struct Pool;
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::unique_ptr<Pool>> m_pools;
+    std::vector<std::jthread> m_workers;
+
+    // jobs sitting in any queue; idle workers sleep while it is zero
+    std::atomic<int64_t> m_queued{0};
+    std::atomic<size_t> m_sleeping{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_stop{false};
+
+    Job *allocate(Job *parent);
+    size_t threadIndex() const;
+    void push(Job *job);
+    Job *next(size_t index);
+    void execute(Job *job);
+    void finish(Job *job);
+    void workerLoop(size_t index);
+};
+
+#endif
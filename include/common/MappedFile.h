@@ -0,0 +1,54 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+/**
+ * A read-only memory mapping of a whole file. Loaders parse straight out of
+ * the mapped pages instead of reading the file into a buffer first, and hand
+ * consumed ranges back with {@link MappedFile#release} so large files do not
+ * stay resident while their output is built.
+ *
+ * Move-only; the mapping is removed on destruction. Throws
+ * `std::runtime_error` if the file cannot be opened or mapped.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    const char *data() const;
+    size_t size() const;
+    std::span<const char> span() const;
+    bool isOpen() const;
+
+    /**
+     * Tells the OS that the bytes `[offset, offset + length)` will not be read
+     * again, so their pages can be dropped from the resident set. Only whole
+     * pages inside the range are released.
+     *
+     * @param {size_t} offset - First byte of the range.
+     * @param {size_t} length - Length of the range in bytes.
+     */
+    void release(size_t offset, size_t length) const;
+    void close();
+
+private:
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+#if defined(_WIN32)
+    void *m_file = nullptr;
+    void *m_mapping = nullptr;
+#endif
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "common/JobSystem.h"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+
+/**
+ * Minimal data-parallel helpers shared by the batch kernels (skinning,
+ * culling, geometry processing). A range is split into contiguous chunks of at
+ * least `grainSize` items and each chunk is handed to `body(begin, end)`.
+ * Small ranges run inline on the calling thread. Chunks are jobs of
+ * {@link JobSystem::instance}, so nested calls share its threads.
+ */
+namespace Parallel
+{
+    /**
+     * Number of threads the helpers will use at most.
+     *
+     * @return {size_t} The worker count, at least `1`.
+     */
+    size_t workerCount();
+
+    /**
+     * Runs `body` over `[begin, end)` split into contiguous chunks. An
+     * exception thrown by `body` is rethrown once every chunk has finished.
+     *
+     * @param {size_t} begin - First index of the range.
+     * @param {size_t} end - One past the last index of the range.
+     * @param {size_t} grainSize - Minimum number of items per chunk.
+     * @param {F} body - Called once per chunk with its sub-range.
+     */
+    template <typename F>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, const F &body)
+    {
+        // an exception must not escape a worker; the first one is rethrown
+        // here once all chunks are done
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        JobSystem::instance().parallelFor(begin, end, [&](size_t chunkBegin, size_t chunkEnd)
+                                          {
+            try
+            {
+                body(chunkBegin, chunkEnd);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            } }, std::max<size_t>(1, grainSize));
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+#endif
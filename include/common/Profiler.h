@@ -0,0 +1,304 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+/**
+ * Scoped timing zones and per-frame counters for the hot paths of the
+ * library, exported as Chrome trace JSON (readable by `chrome://tracing`
+ * and Perfetto) or read through {@link Profiler#frames} and
+ * {@link Profiler#zoneStats}.
+ *
+ * The instrumentation macros compile to nothing unless `THREECPP_PROFILING`
+ * is defined (CMake option `THREECPP_ENABLE_PROFILING`). When compiled in,
+ * a zone reads the time stamp counter twice and appends one event to a
+ * buffer owned by the calling thread, without locks or allocations.
+ * ```c++
+ * void update()
+ * {
+ *     THREECPP_PROFILE_ZONE("update");
+ *     THREECPP_PROFILE_COUNT(NodesUpdated, nodes.size());
+ *     ...
+ * }
+ *
+ * while (running)
+ * {
+ *     update();
+ *     THREECPP_PROFILE_FRAME();
+ * }
+ * Profiler::instance().writeChromeTrace("trace.json");
+ * ```
+ */
+class Profiler
+{
+public:
+    enum Counter : uint32_t
+    {
+        NodesUpdated,
+        MatricesComposed,
+        ObjectsCulled,
+        Allocations
+    };
+    static constexpr size_t COUNTER_COUNT = 4;
+
+    // events kept per thread until the next clear; later zones are dropped
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+    static constexpr size_t FRAME_HISTORY = 256;
+
+    /**
+     * Counter totals of one frame, from one {@link Profiler#frame} call to
+     * the next.
+     */
+    struct FrameStats
+    {
+        uint64_t index = 0;
+        // seconds since the profiler started
+        double start = 0;
+        double seconds = 0;
+        std::array<uint64_t, COUNTER_COUNT> counters{};
+    };
+
+    /**
+     * All recorded events of one zone name.
+     */
+    struct ZoneStats
+    {
+        std::string name;
+        size_t count = 0;
+        double totalSeconds = 0;
+        double maxSeconds = 0;
+    };
+
+    /**
+     * Times the scope it lives in. Prefer {@link THREECPP_PROFILE_ZONE},
+     * which disappears in builds without profiling.
+     */
+    class Zone
+    {
+    public:
+        /**
+         * @param {const char*} name - A string that outlives the profiler, e.g. a literal or {@link Profiler#intern}.
+         * @param {bool} [active=true] - Records nothing when `false`.
+         */
+        explicit Zone(const char *name, bool active = true)
+            : m_name(name), m_start(active && enabled() ? now() : 0)
+        {
+        }
+
+        ~Zone()
+        {
+            if (m_start != 0)
+                record(m_name, m_start, now());
+        }
+
+        Zone(const Zone &) = delete;
+        Zone &operator=(const Zone &) = delete;
+
+    private:
+        const char *m_name;
+        uint64_t m_start;
+    };
+
+    static Profiler &instance();
+
+    /**
+     * Pauses and resumes recording at runtime. Enabled by default.
+     *
+     * @param {bool} enabled - Whether zones and counters record.
+     */
+    static void setEnabled(bool enabled);
+    static bool enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Adds `amount` to `counter` for the current frame.
+     *
+     * @param {Counter} counter - The counter.
+     * @param {uint64_t} [amount=1] - The increment.
+     */
+    static void count(Counter counter, uint64_t amount = 1)
+    {
+        if (!enabled())
+            return;
+
+        // only this thread writes its counters, so no read-modify-write is needed
+        std::atomic<uint64_t> &value = thread()->counters[counter];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * Names the calling thread in exported traces.
+     *
+     * @param {std::string} name - The thread name.
+     */
+    static void setThreadName(const std::string &name);
+    static const char *counterName(Counter counter);
+
+    /**
+     * Returns a copy of `name` that lives as long as the profiler, for zone
+     * names built at runtime.
+     *
+     * @param {std::string} name - The name.
+     * @return {const char*}
+     */
+    const char *intern(const std::string &name);
+
+    /**
+     * Ends the current frame: stores its counter totals and starts the next.
+     */
+    void frame();
+    /**
+     * The last {@link Profiler::FRAME_HISTORY} frames, oldest first.
+     *
+     * @return {std::vector<FrameStats>}
+     */
+    std::vector<FrameStats> frames() const;
+    FrameStats lastFrame() const;
+    /**
+     * Per zone name totals over all events recorded since the last clear,
+     * sorted by total time, longest first.
+     *
+     * @return {std::vector<ZoneStats>}
+     */
+    std::vector<ZoneStats> zoneStats() const;
+    size_t eventCount() const;
+    size_t droppedEvents() const;
+
+    /**
+     * The recorded zones, thread names and per-frame counters in the Chrome
+     * trace event format.
+     *
+     * @return {std::string} The JSON document.
+     */
+    std::string chromeTrace() const;
+    void writeChromeTrace(const std::string &path) const;
+    /**
+     * Discards all events and frames. No zone may be open on another thread.
+     */
+    void clear();
+
+    /**
+     * The current time stamp in ticks of an unspecified unit.
+     *
+     * @return {uint64_t}
+     */
+    static uint64_t now()
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+private:
+    struct Event
+    {
+        const char *name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    struct ThreadData
+    {
+        uint32_t id = 0;
+        std::string name;
+        std::unique_ptr<Event[]> events;
+        // published with release so readers see complete events
+        std::atomic<size_t> size{0};
+        std::atomic<size_t> dropped{0};
+        std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{};
+    };
+
+    inline static std::atomic<bool> s_enabled{true};
+    inline static thread_local ThreadData *s_thread = nullptr;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadData>> m_threads;
+    // data of exited threads, reused by new ones
+    std::vector<ThreadData *> m_freeThreads;
+    std::deque<std::string> m_names;
+
+    std::deque<FrameStats> m_frames;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_frameStart;
+    std::array<uint64_t, COUNTER_COUNT> m_frameTotals{};
+
+    uint64_t m_originTicks;
+    std::chrono::steady_clock::time_point m_originTime;
+
+    Profiler();
+    ~Profiler();
+
+    static ThreadData *thread()
+    {
+        return s_thread != nullptr ? s_thread : registerThread();
+    }
+
+    static ThreadData *registerThread();
+    static void releaseThread(ThreadData *data);
+
+    static void record(const char *name, uint64_t start, uint64_t end)
+    {
+        ThreadData *data = thread();
+        const size_t size = data->size.load(std::memory_order_relaxed);
+        if (size == EVENTS_PER_THREAD)
+        {
+            data->dropped.store(data->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+
+        data->events[size] = {name, start, end};
+        data->size.store(size + 1, std::memory_order_release);
+    }
+
+    double secondsPerTick() const;
+    double secondsSinceOrigin(uint64_t ticks) const;
+    std::array<uint64_t, COUNTER_COUNT> counterTotals() const;
+};
+
+#define THREECPP_PROFILE_CONCAT2(a, b) a##b
+#define THREECPP_PROFILE_CONCAT(a, b) THREECPP_PROFILE_CONCAT2(a, b)
+
+#if defined(THREECPP_PROFILING)
+/**
+ * Times the enclosing scope as `name`, a string literal.
+ */
+#define THREECPP_PROFILE_ZONE(name) ::Profiler::Zone THREECPP_PROFILE_CONCAT(_profileZone, __LINE__)(name)
+/**
+ * Times the enclosing scope only when `condition` holds, e.g. for the
+ * outermost call of a recursion.
+ */
+#define THREECPP_PROFILE_ZONE_IF(name, condition) ::Profiler::Zone THREECPP_PROFILE_CONCAT(_profileZone, __LINE__)(name, condition)
+/**
+ * Adds `amount` to the {@link Profiler::Counter} `counter`.
+ */
+#define THREECPP_PROFILE_COUNT(counter, amount) ::Profiler::count(::Profiler::counter, amount)
+#define THREECPP_PROFILE_THREAD(name) ::Profiler::setThreadName(name)
+#define THREECPP_PROFILE_FRAME() ::Profiler::instance().frame()
+#else
+#define THREECPP_PROFILE_ZONE(name) ((void)0)
+#define THREECPP_PROFILE_ZONE_IF(name, condition) ((void)0)
+#define THREECPP_PROFILE_COUNT(counter, amount) ((void)0)
+#define THREECPP_PROFILE_THREAD(name) ((void)0)
+#define THREECPP_PROFILE_FRAME() ((void)0)
+#endif
+
+#endif
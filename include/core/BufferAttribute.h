@@ -0,0 +1,99 @@
+#ifndef BUFFER_ATTRIBUTE_H
+#define BUFFER_ATTRIBUTE_H
+
+#include "common/BasicType.h"
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * This class stores data for an attribute (such as vertex positions, face
+ * indices, normals, colors, UVs, and any custom attributes) associated with a
+ * geometry, which allows for more efficient passing of data to the GPU and to
+ * the CPU batch kernels.
+ *
+ * Data is stored as a tightly packed `float` array of `count * itemSize`
+ * components.
+ * ```c++
+ * auto position = std::make_shared<BufferAttribute>(std::vector<float>{0, 0, 0, 1, 0, 0}, 3);
+ * position->count(); // 2
+ * ```
+ */
+class BufferAttribute
+{
+public:
+    /**
+     * Constructs a new buffer attribute.
+     *
+     * @param {std::vector<float>} array - The array holding the attribute data.
+     * @param {size_t} itemSize - The item size (number of components per vertex).
+     * @param {bool} [normalized=false] - Whether the data are normalized or not.
+     */
+    BufferAttribute(std::vector<float> array, size_t itemSize, bool normalized = false);
+    /**
+     * Constructs a zero-initialized buffer attribute of `count` items.
+     *
+     * @param {size_t} count - The number of items.
+     * @param {size_t} itemSize - The item size (number of components per vertex).
+     */
+    BufferAttribute(size_t count, size_t itemSize);
+    ~BufferAttribute();
+
+    float *array();
+    const float *array() const;
+    std::span<float> span();
+    std::span<const float> span() const;
+    /**
+     * The number of items (vertices) stored in this attribute.
+     *
+     * @return {size_t}
+     */
+    size_t count() const;
+    size_t itemSize() const;
+    bool normalized() const;
+    const std::string &name() const;
+    void name(const std::string &value);
+
+    /**
+     * A version number, incremented every time {@link BufferAttribute#needsUpdate} is called.
+     *
+     * @return {unsigned int}
+     */
+    unsigned int version() const;
+    /**
+     * Flags this attribute as modified so consumers re-upload or re-read it.
+     */
+    void needsUpdate();
+
+    float getComponent(size_t index, size_t component) const;
+    BufferAttribute &setComponent(size_t index, size_t component, float value);
+    float getX(size_t index) const;
+    float getY(size_t index) const;
+    float getZ(size_t index) const;
+    float getW(size_t index) const;
+    BufferAttribute &setX(size_t index, float x);
+    BufferAttribute &setY(size_t index, float y);
+    BufferAttribute &setZ(size_t index, float z);
+    BufferAttribute &setW(size_t index, float w);
+    BufferAttribute &setXY(size_t index, float x, float y);
+    BufferAttribute &setXYZ(size_t index, float x, float y, float z);
+    BufferAttribute &setXYZW(size_t index, float x, float y, float z, float w);
+    /**
+     * Copies the array of the given attribute into this one. Both attributes
+     * must have the same item size.
+     *
+     * @param {BufferAttribute} source - The attribute to copy.
+     * @return {BufferAttribute} A reference to this instance.
+     */
+    BufferAttribute &copy(const BufferAttribute &source);
+
+private:
+    std::vector<float> m_array;
+    size_t m_itemSize;
+    size_t m_count;
+    bool m_normalized;
+    unsigned int m_version = 0;
+    std::string m_name;
+};
+
+#endif
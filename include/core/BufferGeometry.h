@@ -0,0 +1,125 @@
+#ifndef BUFFER_GEOMETRY_H
+#define BUFFER_GEOMETRY_H
+
+#include "core/BufferAttribute.h"
+#include "core/MorphTarget.h"
+#include "math/Box3.h"
+#include "math/Sphere.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A representation of mesh, line, or point geometry. Includes vertex
+ * positions, face indices, normals, colors, UVs, and custom attributes
+ * within buffers.
+ * ```c++
+ * auto geometry = std::make_shared<BufferGeometry>();
+ * geometry->setAttribute("position", std::make_shared<BufferAttribute>(vertices, 3));
+ * ```
+ */
+class BufferGeometry
+{
+public:
+    BufferGeometry();
+    virtual ~BufferGeometry();
+
+    /**
+     * The type of this geometry, e.g. `"BufferGeometry"`, `"BoxGeometry"`.
+     *
+     * @return {std::string}
+     */
+    virtual std::string type() const;
+
+    const std::string &uuid() const;
+    const std::string &name() const;
+    void name(const std::string &value);
+
+    /**
+     * Returns the index buffer. Empty if the geometry is non-indexed.
+     *
+     * @return {std::vector<uint32_t>} The index buffer.
+     */
+    const std::vector<uint32_t> &getIndex() const;
+    std::vector<uint32_t> &getIndex();
+    /**
+     * Sets the given index buffer to this geometry.
+     *
+     * @param {std::vector<uint32_t>} index - The index to set.
+     * @return {BufferGeometry} A reference to this instance.
+     */
+    BufferGeometry &setIndex(std::vector<uint32_t> index);
+    bool hasIndex() const;
+
+    /**
+     * Returns the buffer attribute for the given name, or `nullptr`.
+     *
+     * @param {std::string} name - The attribute name.
+     * @return {std::shared_ptr<BufferAttribute>} The buffer attribute.
+     */
+    std::shared_ptr<BufferAttribute> getAttribute(const std::string &name) const;
+    /**
+     * Sets the given attribute for the given name.
+     *
+     * @param {std::string} name - The attribute name.
+     * @param {std::shared_ptr<BufferAttribute>} attribute - The attribute to set.
+     * @return {BufferGeometry} A reference to this instance.
+     */
+    BufferGeometry &setAttribute(const std::string &name, std::shared_ptr<BufferAttribute> attribute);
+    BufferGeometry &deleteAttribute(const std::string &name);
+    bool hasAttribute(const std::string &name) const;
+    const std::unordered_map<std::string, std::shared_ptr<BufferAttribute>> &attributes() const;
+
+    /**
+     * The sparse morph targets of this geometry, blended by
+     * {@link CPUMorphing::morphMesh} with the influences of a {@link Mesh}.
+     *
+     * @return {std::vector<MorphTarget>}
+     */
+    const std::vector<MorphTarget> &morphTargets() const;
+    std::vector<MorphTarget> &morphTargets();
+    /**
+     * Appends a morph target.
+     *
+     * @param {MorphTarget} target - The target to add.
+     * @return {BufferGeometry} A reference to this instance.
+     */
+    BufferGeometry &addMorphTarget(MorphTarget target);
+
+    /**
+     * Bounding box for the geometry, `nullptr` until {@link BufferGeometry#computeBoundingBox} is called.
+     *
+     * @return {Box3}
+     */
+    const Box3 *boundingBox() const;
+    /**
+     * Bounding sphere for the geometry, `nullptr` until {@link BufferGeometry#computeBoundingSphere} is called.
+     *
+     * @return {Sphere}
+     */
+    const Sphere *boundingSphere() const;
+    /**
+     * Computes the bounding box of the geometry from the `position` attribute,
+     * including every morph target at full influence.
+     */
+    void computeBoundingBox();
+    /**
+     * Computes the bounding sphere of the geometry: centered on the bounding
+     * box, with the radius of the farthest position (morph targets included).
+     */
+    void computeBoundingSphere();
+
+private:
+    std::string m_uuid;
+    std::string m_name;
+    std::vector<uint32_t> m_index;
+    std::unordered_map<std::string, std::shared_ptr<BufferAttribute>> m_attributes;
+    std::vector<MorphTarget> m_morphTargets;
+    std::optional<Box3> m_boundingBox;
+    std::optional<Sphere> m_boundingSphere;
+};
+
+#endif
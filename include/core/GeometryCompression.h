@@ -0,0 +1,159 @@
+#ifndef GEOMETRY_COMPRESSION_H
+#define GEOMETRY_COMPRESSION_H
+
+#include "core/BufferGeometry.h"
+#include "math/Box3.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Quantized storage for {@link BufferGeometry}.
+ *
+ * - Positions are quantized to 16 bits per component relative to the
+ *   bounding box of the mesh, via {@link MathUtils::normalize}; the box is
+ *   the dequantization transform.
+ * - Normals are octahedral encoded, two signed 8 or 16-bit components per
+ *   normal.
+ * - UVs (`uv`, `uv1`, ... with item size 2) are stored as half floats.
+ * - Indices are stored as zigzag varint deltas to the previous index, which
+ *   is small after {@link IndexOptimizer::optimizeVertexFetch}.
+ * - Other attributes and morph targets are kept as they are.
+ *
+ * The attribute decoders run four values at a time with SSE.
+ * ```c++
+ * auto compressed = GeometryCompression::compress(*geometry);
+ * printf("%.2fx\n", compressed.stats.ratio());
+ * auto decoded = GeometryCompression::decompress(compressed);
+ * ```
+ */
+namespace GeometryCompression
+{
+    /**
+     * Precision of {@link GeometryCompression::compress}.
+     */
+    struct Settings
+    {
+        // 8 or 16 bits per octahedral component
+        int normalBits = 16;
+    };
+
+    /**
+     * Size and accuracy of one compressed attribute. The error is the
+     * largest absolute component error for positions and UVs, and the
+     * largest angle in radians for normals.
+     */
+    struct AttributeStats
+    {
+        std::string name;
+        size_t bytesBefore = 0;
+        size_t bytesAfter = 0;
+        float maxError = 0;
+    };
+
+    /**
+     * Sizes before and after compression, the index included.
+     */
+    struct Stats
+    {
+        std::vector<AttributeStats> attributes;
+        size_t bytesBefore = 0;
+        size_t bytesAfter = 0;
+        double seconds = 0;
+
+        double ratio() const;
+    };
+
+    /**
+     * The compressed buffers of one geometry.
+     */
+    struct CompressedGeometry
+    {
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+
+        // dequantization transform: min + (max - min) * q / 65535
+        Box3 bounds;
+        std::vector<uint16_t> positions;
+
+        int normalBits = 0;
+        std::vector<int8_t> normals8;
+        std::vector<int16_t> normals16;
+
+        std::vector<std::pair<std::string, std::vector<uint16_t>>> uvs;
+        std::vector<uint8_t> indices;
+
+        std::unordered_map<std::string, std::shared_ptr<BufferAttribute>> uncompressed;
+        std::vector<MorphTarget> morphTargets;
+
+        Stats stats;
+    };
+
+    /**
+     * Compresses `geometry` and measures the error of every attribute.
+     *
+     * @param {BufferGeometry} geometry - The geometry to compress.
+     * @param {Settings} settings - The normal precision.
+     * @return {CompressedGeometry}
+     */
+    CompressedGeometry compress(const BufferGeometry &geometry, const Settings &settings = {});
+    /**
+     * Decodes `compressed` into a new geometry.
+     *
+     * @param {CompressedGeometry} compressed - The compressed geometry.
+     * @return {std::shared_ptr<BufferGeometry>}
+     */
+    std::shared_ptr<BufferGeometry> decompress(const CompressedGeometry &compressed);
+
+    /**
+     * Quantizes `xyz` positions to 16 bits per component inside `bounds`.
+     *
+     * @param {std::span<const float>} positions - Three floats per vertex.
+     * @param {Box3} bounds - A box enclosing all positions.
+     * @param {std::span<uint16_t>} quantized - Receives three values per vertex.
+     */
+    void encodePositions(std::span<const float> positions, const Box3 &bounds, std::span<uint16_t> quantized);
+    void decodePositions(std::span<const uint16_t> quantized, const Box3 &bounds, std::span<float> positions);
+
+    /**
+     * Octahedral encodes `xyz` normals, two components per normal. Each is
+     * rounded to the neighbouring grid point closest in angle.
+     *
+     * @param {std::span<const float>} normals - Three floats per normal, not necessarily unit length.
+     * @param {std::span<int16_t>} encoded - Receives two values per normal.
+     */
+    void encodeOctahedral(std::span<const float> normals, std::span<int16_t> encoded);
+    void encodeOctahedral(std::span<const float> normals, std::span<int8_t> encoded);
+    void decodeOctahedral(std::span<const int16_t> encoded, std::span<float> normals);
+    void decodeOctahedral(std::span<const int8_t> encoded, std::span<float> normals);
+
+    /**
+     * Converts floats to IEEE half floats, rounding to nearest even.
+     *
+     * @param {std::span<const float>} values - The values.
+     * @param {std::span<uint16_t>} halves - Receives one half per value.
+     */
+    void encodeHalf(std::span<const float> values, std::span<uint16_t> halves);
+    void decodeHalf(std::span<const uint16_t> halves, std::span<float> values);
+
+    /**
+     * Delta encodes an index buffer as zigzag varints.
+     *
+     * @param {std::span<const uint32_t>} indices - The index buffer.
+     * @return {std::vector<uint8_t>}
+     */
+    std::vector<uint8_t> encodeIndices(std::span<const uint32_t> indices);
+    /**
+     * Decodes exactly `indices.size()` indices from `bytes`.
+     *
+     * @param {std::span<const uint8_t>} bytes - Output of {@link GeometryCompression::encodeIndices}.
+     * @param {std::span<uint32_t>} indices - Receives the index buffer.
+     */
+    void decodeIndices(std::span<const uint8_t> bytes, std::span<uint32_t> indices);
+}
+
+#endif
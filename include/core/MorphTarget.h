@@ -0,0 +1,74 @@
+#ifndef MORPH_TARGET_H
+#define MORPH_TARGET_H
+
+#include "core/BufferAttribute.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * A morph target (blend shape) stored sparsely: the indices of the vertices
+ * it moves, in ascending order, and one position delta and optionally one
+ * normal delta per listed vertex. Facial targets typically touch a small
+ * fraction of a mesh, so storage and blending cost scale with the touched
+ * vertices only.
+ * ```c++
+ * geometry->addMorphTarget(MorphTarget::fromDense("smile", *base, *smilePosition));
+ * mesh->updateMorphTargets();
+ * mesh->morphTargetInfluences[mesh->morphTargetDictionary["smile"]] = 0.5f;
+ * ```
+ */
+class MorphTarget
+{
+public:
+    /**
+     * Constructs a new morph target from sparse data.
+     *
+     * @param {std::string} name - The target name.
+     * @param {std::vector<uint32_t>} indices - The touched vertices, strictly ascending.
+     * @param {std::vector<float>} positionDeltas - Three floats per index.
+     * @param {std::vector<float>} [normalDeltas] - Three floats per index, or empty.
+     */
+    MorphTarget(std::string name, std::vector<uint32_t> indices, std::vector<float> positionDeltas, std::vector<float> normalDeltas = {});
+    ~MorphTarget();
+
+    /**
+     * Builds a sparse target from a dense one in the three.js layout: one
+     * position (and normal) per vertex of the base geometry, either absolute
+     * or relative to the base. Vertices whose deltas are all within `epsilon`
+     * are left out.
+     *
+     * @param {std::string} name - The target name.
+     * @param {BufferAttribute} basePosition - The base `position` attribute.
+     * @param {BufferAttribute} position - The target positions.
+     * @param {const BufferAttribute*} [baseNormal=nullptr] - The base `normal` attribute.
+     * @param {const BufferAttribute*} [normal=nullptr] - The target normals.
+     * @param {bool} [relative=false] - Whether the target stores deltas (`morphTargetsRelative`).
+     * @param {float} [epsilon=0] - Deltas up to this magnitude count as zero.
+     * @return {MorphTarget}
+     */
+    static MorphTarget fromDense(std::string name, const BufferAttribute &basePosition, const BufferAttribute &position,
+                                 const BufferAttribute *baseNormal = nullptr, const BufferAttribute *normal = nullptr,
+                                 bool relative = false, float epsilon = 0);
+
+    const std::string &name() const;
+    std::span<const uint32_t> indices() const;
+    std::span<const float> positionDeltas() const;
+    std::span<const float> normalDeltas() const;
+    bool hasNormals() const;
+    /**
+     * The number of vertices this target moves.
+     *
+     * @return {size_t}
+     */
+    size_t count() const;
+
+private:
+    std::string m_name;
+    std::vector<uint32_t> m_indices;
+    std::vector<float> m_positionDeltas;
+    std::vector<float> m_normalDeltas;
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef OBJECT3D_H
+#define OBJECT3D_H
+
+#include "math/Vector3.h"
+#include "math/Quaternion.h"
+#include "math/Matrix4.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * This is the base class for most objects in three.cpp and provides a set of
+ * properties and methods for manipulating objects in 3D space.
+ *
+ * Children are owned by their parent through `std::shared_ptr`; the parent
+ * link is a plain back pointer.
+ * ```c++
+ * auto root = std::make_shared<Object3D>();
+ * auto child = std::make_shared<Object3D>();
+ * root->add(child);
+ * child->position().set(0, 1, 0);
+ * root->updateMatrixWorld();
+ * ```
+ */
+class Object3D
+{
+public:
+    Object3D();
+    virtual ~Object3D();
+
+    /**
+     * The type of this object, e.g. `"Object3D"`, `"Bone"`, `"Mesh"`.
+     *
+     * @return {std::string}
+     */
+    virtual std::string type() const;
+
+    unsigned int id() const;
+    const std::string &uuid() const;
+    void uuid(const std::string &value);
+    const std::string &name() const;
+    void name(const std::string &value);
+
+    Object3D *parent() const;
+    const std::vector<std::shared_ptr<Object3D>> &children() const;
+
+    /**
+     * Represents the object's local position.
+     *
+     * @return {Vector3}
+     */
+    Vector3 &position();
+    const Vector3 &position() const;
+    /**
+     * Represents the object's local rotation as a quaternion.
+     *
+     * @return {Quaternion}
+     */
+    Quaternion &quaternion();
+    const Quaternion &quaternion() const;
+    /**
+     * Represents the object's local scale.
+     *
+     * @return {Vector3}
+     */
+    Vector3 &scale();
+    const Vector3 &scale() const;
+    /**
+     * Represents the object's transformation matrix in local space.
+     *
+     * @return {Matrix4}
+     */
+    Matrix4 &matrix();
+    const Matrix4 &matrix() const;
+    /**
+     * Represents the object's transformation matrix in world space.
+     * If the object has no parent, then it's identical to the local
+     * transformation {@link Object3D#matrix}.
+     *
+     * @return {Matrix4}
+     */
+    Matrix4 &matrixWorld();
+    const Matrix4 &matrixWorld() const;
+
+    bool matrixAutoUpdate = true;
+    bool matrixWorldAutoUpdate = true;
+    bool matrixWorldNeedsUpdate = false;
+    bool visible = true;
+
+    /**
+     * Adds the given object as a child of this 3D object. An object can have
+     * only one parent; it is removed from its previous parent first.
+     *
+     * @param {std::shared_ptr<Object3D>} object - The 3D object to add.
+     * @return {Object3D} A reference to this instance.
+     */
+    Object3D &add(const std::shared_ptr<Object3D> &object);
+    /**
+     * Removes the given object as child of this 3D object.
+     *
+     * @param {Object3D} object - The 3D object to remove.
+     * @return {Object3D} A reference to this instance.
+     */
+    Object3D &remove(Object3D *object);
+    Object3D &removeFromParent();
+    Object3D &clear();
+
+    /**
+     * Searches through this object and its children, starting with the object
+     * itself, and returns the first with a matching name.
+     *
+     * @param {std::string} name - The name of the object.
+     * @return {Object3D} The found object, or `nullptr`.
+     */
+    Object3D *getObjectByName(const std::string &name);
+    /**
+     * Executes the callback on this object and all descendants.
+     *
+     * @param {std::function<void(Object3D&)>} callback - A function with as first argument a 3D object.
+     */
+    void traverse(const std::function<void(Object3D &)> &callback);
+
+    /**
+     * Updates the transformation matrix in local space by composing
+     * position, quaternion and scale.
+     */
+    void updateMatrix();
+    /**
+     * Updates the transformation matrix in world space of this 3D objects and its descendants.
+     *
+     * @param {bool} [force=false] - When set to `true`, a recomputation of world matrices is forced even
+     * when {@link Object3D#matrixWorldAutoUpdate} is set to `false`.
+     */
+    virtual void updateMatrixWorld(bool force = false);
+    /**
+     * An alternative version of {@link Object3D#updateMatrixWorld} with more control over the
+     * update of parent and child 3D objects.
+     *
+     * @param {bool} updateParents - Whether ancestor 3D objects should be updated or not.
+     * @param {bool} updateChildren - Whether descendant 3D objects should be updated or not.
+     */
+    virtual void updateWorldMatrix(bool updateParents, bool updateChildren);
+
+    void localToWorld(Vector3 &vector) const;
+    void worldToLocal(Vector3 &vector) const;
+    void getWorldPosition(Vector3 &target);
+    void getWorldQuaternion(Quaternion &target);
+    void getWorldScale(Vector3 &target);
+
+private:
+    unsigned int m_id;
+    std::string m_uuid;
+    std::string m_name;
+
+    Object3D *m_parent = nullptr;
+    std::vector<std::shared_ptr<Object3D>> m_children;
+
+    Vector3 m_position;
+    Quaternion m_quaternion;
+    Vector3 m_scale = Vector3(1, 1, 1);
+    Matrix4 m_matrix;
+    Matrix4 m_matrixWorld;
+};
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef TRANSFORM_WORLD_H
+#define TRANSFORM_WORLD_H
+
+#include "math/Box3.h"
+#include "math/Matrix4.h"
+#include "math/Quaternion.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * Data-oriented alternative to a graph of {@link Object3D} nodes for scenes
+ * with hundreds of thousands of transforms.
+ *
+ * Entities are ids; their components live in chunks of
+ * {@link TransformWorld::CHUNK_CAPACITY} entities that share an archetype,
+ * i.e. the same component set and the same depth in the hierarchy. Every
+ * chunk stores one array per component (`float` data, `3` per position and
+ * scale, `4` per rotation, `16` per matrix in column-major order, `6` per
+ * box as min then max).
+ *
+ * {@link TransformWorld#update} runs three systems over whole chunks, split
+ * across threads:
+ * - compose: position, rotation and scale into the local matrix,
+ * - propagate: parent world matrix times local matrix, one depth at a time,
+ * - bounds: local box through the world matrix, plus one box per chunk.
+ *
+ * Every chunk records the version in which each component last changed,
+ * and a system skips chunks whose inputs did not change since it last ran.
+ * ```c++
+ * TransformWorld world;
+ * auto root = world.create();
+ * auto child = world.create(TransformWorld::TRS | TransformWorld::Bounds, root);
+ * world.setPosition(child, Vector3(0, 1, 0));
+ * world.setLocalBounds(child, box);
+ * world.update();
+ * Matrix4 matrix = world.worldMatrix(child);
+ * ```
+ */
+class TransformWorld
+{
+public:
+    static constexpr size_t CHUNK_CAPACITY = 128;
+
+    enum Component : uint32_t
+    {
+        Position = 1 << 0,
+        Rotation = 1 << 1,
+        Scale = 1 << 2,
+        LocalMatrix = 1 << 3,
+        WorldMatrix = 1 << 4,
+        // a local box and the world box derived from it
+        Bounds = 1 << 5,
+
+        TRS = Position | Rotation | Scale
+    };
+    static constexpr size_t COMPONENT_COUNT = 6;
+
+    /**
+     * A handle to an entity. Stale handles of destroyed entities are
+     * detected through the generation.
+     */
+    struct Entity
+    {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        explicit operator bool() const;
+        bool operator==(const Entity &other) const = default;
+    };
+
+    /**
+     * Work done by one system in the last {@link TransformWorld#update}.
+     */
+    struct SystemStats
+    {
+        size_t chunks = 0;
+        size_t skipped = 0;
+        size_t entities = 0;
+        double seconds = 0;
+    };
+
+    struct Stats
+    {
+        SystemStats compose;
+        SystemStats propagate;
+        SystemStats bounds;
+    };
+
+    struct Chunk;
+
+    /**
+     * Access to the arrays of one chunk. The non-const accessors mark the
+     * component as changed, so systems pick up direct writes.
+     */
+    class ChunkView
+    {
+    public:
+        uint32_t components() const;
+        uint32_t depth() const;
+        size_t size() const;
+        std::span<const uint32_t> entities() const;
+        /**
+         * Version in which `component` last changed.
+         *
+         * @param {Component} component - A single component.
+         * @return {uint32_t}
+         */
+        uint32_t version(Component component) const;
+
+        std::span<float> positions();
+        std::span<float> rotations();
+        std::span<float> scales();
+        std::span<float> localMatrices();
+        std::span<float> localBounds();
+
+        std::span<const float> positions() const;
+        std::span<const float> rotations() const;
+        std::span<const float> scales() const;
+        std::span<const float> localMatrices() const;
+        std::span<const float> worldMatrices() const;
+        std::span<const float> localBounds() const;
+        std::span<const float> worldBounds() const;
+        /**
+         * The union of the world boxes of the chunk, or an empty box.
+         *
+         * @return {Box3}
+         */
+        Box3 bounds() const;
+
+    private:
+        friend class TransformWorld;
+
+        ChunkView(Chunk *chunk, uint32_t version);
+        std::span<float> span(uint32_t component) const;
+
+        Chunk *m_chunk;
+        uint32_t m_version;
+    };
+
+    TransformWorld();
+    ~TransformWorld();
+
+    TransformWorld(const TransformWorld &) = delete;
+    TransformWorld &operator=(const TransformWorld &) = delete;
+
+    /**
+     * Creates an entity with an identity transform. The local and world
+     * matrices are always present.
+     *
+     * @param {uint32_t} [components=TRS] - The components of the entity.
+     * @param {Entity} [parent] - The parent, none by default.
+     * @return {Entity}
+     */
+    Entity create(uint32_t components = TRS);
+    Entity create(uint32_t components, Entity parent);
+    /**
+     * Destroys `entity`; its children become roots.
+     *
+     * @param {Entity} entity - The entity to destroy.
+     */
+    void destroy(Entity entity);
+    bool alive(Entity entity) const;
+    size_t size() const;
+
+    uint32_t components(Entity entity) const;
+    /**
+     * Adds and removes components; the entity moves to the chunks of its
+     * new archetype.
+     *
+     * @param {Entity} entity - The entity.
+     * @param {uint32_t} components - The new component set.
+     */
+    void setComponents(Entity entity, uint32_t components);
+
+    Entity parent(Entity entity) const;
+    uint32_t depth(Entity entity) const;
+    /**
+     * Attaches `entity` to `parent`, or makes it a root for an empty handle.
+     * The local transform is kept, so the world transform changes.
+     *
+     * @param {Entity} entity - The entity.
+     * @param {Entity} parent - The new parent, not a descendant of `entity`.
+     */
+    void setParent(Entity entity, Entity parent);
+
+    Vector3 position(Entity entity) const;
+    Quaternion rotation(Entity entity) const;
+    Vector3 scale(Entity entity) const;
+    Matrix4 localMatrix(Entity entity) const;
+    Matrix4 worldMatrix(Entity entity) const;
+    Box3 localBounds(Entity entity) const;
+    Box3 worldBounds(Entity entity) const;
+
+    void setPosition(Entity entity, const Vector3 &position);
+    void setRotation(Entity entity, const Quaternion &rotation);
+    void setScale(Entity entity, const Vector3 &scale);
+    /**
+     * Sets the local matrix, which is how entities without position,
+     * rotation and scale are placed. For the others the next compose
+     * overwrites it.
+     *
+     * @param {Entity} entity - The entity.
+     * @param {Matrix4} matrix - The local transform.
+     */
+    void setLocalMatrix(Entity entity, const Matrix4 &matrix);
+    void setLocalBounds(Entity entity, const Box3 &box);
+
+    /**
+     * Runs compose, propagate and bounds, then starts a new version.
+     */
+    void update();
+    void compose();
+    void propagate();
+    void computeBounds();
+
+    /**
+     * The current version; changes made now are stamped with it.
+     *
+     * @return {uint32_t}
+     */
+    uint32_t version() const;
+    const Stats &stats() const;
+
+    size_t chunkCount() const;
+    ChunkView chunk(size_t index);
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Record
+    {
+        uint32_t chunk = NONE;
+        uint32_t slot = 0;
+        uint32_t generation = 0;
+        uint32_t parent = NONE;
+        uint32_t firstChild = NONE;
+        uint32_t nextSibling = NONE;
+        uint32_t previousSibling = NONE;
+    };
+
+    struct Archetype
+    {
+        uint32_t components;
+        uint32_t depth;
+        std::vector<uint32_t> chunks;
+        // chunks that may have free slots
+        std::vector<uint32_t> open;
+    };
+
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<Archetype> m_archetypes;
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> m_archetypesByKey;
+    // chunk indices per depth, the order propagate walks them in
+    std::vector<std::vector<uint32_t>> m_levels;
+
+    std::vector<Record> m_records;
+    std::vector<uint32_t> m_freeRecords;
+    size_t m_size = 0;
+
+    uint32_t m_version = 1;
+    // version at which each system last ran
+    uint32_t m_composed = 0;
+    uint32_t m_propagated = 0;
+    uint32_t m_bounded = 0;
+    Stats m_stats;
+    // chunks a system will process, kept to avoid allocating every frame
+    std::vector<uint32_t> m_dirty;
+
+    const Record &record(Entity entity) const;
+    uint32_t archetype(uint32_t components, uint32_t depth);
+    uint32_t archetypeOf(uint32_t index) const;
+    void insert(uint32_t index, uint32_t archetype);
+    void remove(uint32_t index);
+    void move(uint32_t index, uint32_t archetype);
+    void moveSubtree(uint32_t index, uint32_t depth);
+    void link(uint32_t index, uint32_t parent);
+    void unlink(uint32_t index);
+    void trackParentChunk(uint32_t index);
+    void touch(uint32_t chunk, uint32_t components);
+    float *component(Entity entity, Component component, size_t stride);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef EARCUT_H
+#define EARCUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * Polygon triangulation by ear clipping, a port of
+ * [earcut](https://github.com/mapbox/earcut). Holes are bridged into the
+ * outer ring first; polygons of more than 80 vertices index their vertices
+ * along a z-order curve, so an ear test only visits the vertices near the
+ * ear instead of the whole ring.
+ * ```c++
+ * // a square with a triangular hole
+ * std::vector<double> data = {0, 0, 10, 0, 10, 10, 0, 10, 2, 2, 8, 2, 5, 8};
+ * std::vector<uint32_t> holes = {4};
+ * std::vector<uint32_t> triangles;
+ * Earcut::triangulate(data, holes, triangles);
+ * ```
+ */
+namespace Earcut
+{
+    /**
+     * A polygon in the flat layout of {@link Earcut::triangulate}.
+     */
+    struct Polygon
+    {
+        std::span<const double> data;
+        std::span<const uint32_t> holeIndices;
+    };
+
+    /**
+     * Triangulates a polygon with holes.
+     *
+     * @param {std::span<const double>} data - Flat `xy` coordinates of the outer ring followed by the rings of the holes.
+     * @param {std::span<const uint32_t>} holeIndices - The index of the first vertex of every hole.
+     * @param {std::vector<uint32_t>} triangles - Receives three vertex indices per triangle; cleared first.
+     */
+    void triangulate(std::span<const double> data, std::span<const uint32_t> holeIndices, std::vector<uint32_t> &triangles);
+
+    /**
+     * Triangulates many independent polygons, e.g. the footprints of a city
+     * tile, split across threads.
+     *
+     * @param {std::span<const Polygon>} polygons - The polygons.
+     * @param {std::vector<std::vector<uint32_t>>} triangles - Resized to the number of polygons; receives the triangles of each.
+     */
+    void triangulateBatch(std::span<const Polygon> polygons, std::vector<std::vector<uint32_t>> &triangles);
+}
+
+#endif
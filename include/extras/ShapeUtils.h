@@ -0,0 +1,46 @@
+#ifndef SHAPE_UTILS_H
+#define SHAPE_UTILS_H
+
+#include "common/BasicType.h"
+#include "math/Vector2.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A namespace containing utility functions for shapes.
+ */
+namespace ShapeUtils
+{
+    /**
+     * Calculate area of a ( 2D ) contour polygon.
+     *
+     * @param {std::vector<Vector2>} contour - An array of 2D points.
+     * @return {HIGH_PRECISION} The area, positive for counterclockwise contours.
+     */
+    HIGH_PRECISION area(const std::vector<Vector2> &contour);
+    /**
+     * Note that this is a linear-time operation.
+     *
+     * @param {std::vector<Vector2>} pts - An array of 2D points defining a polygon.
+     * @return {bool} Whether the given array of points is clockwise or not.
+     */
+    bool isClockWise(const std::vector<Vector2> &pts);
+    /**
+     * Drops the last point of a closed ring, which repeats the first one.
+     *
+     * @param {std::vector<Vector2>} points - The ring.
+     */
+    void removeDupEndPts(std::vector<Vector2> &points);
+    /**
+     * Triangulates the given shape definition with {@link Earcut::triangulate}.
+     * A last point repeating the first one is ignored.
+     *
+     * @param {std::vector<Vector2>} contour - The outer ring.
+     * @param {std::vector<std::vector<Vector2>>} holes - The rings of the holes.
+     * @return {std::vector<std::array<uint32_t,3>>} Triangles indexing the contour followed by the holes.
+     */
+    std::vector<std::array<uint32_t, 3>> triangulateShape(const std::vector<Vector2> &contour, const std::vector<std::vector<Vector2>> &holes);
+}
+
+#endif
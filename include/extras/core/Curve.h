@@ -0,0 +1,249 @@
+#ifndef CURVE_H
+#define CURVE_H
+
+#include "common/BasicType.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * An abstract base class for creating curves in 3D space. Subclasses
+ * implement {@link Curve#getPoint}; everything else is derived from it.
+ *
+ * `t` is the curve parameter, `u` the fraction of the arc length. The
+ * arc-length table that maps `u` to `t` is built on first use and cached
+ * until {@link Curve#updateArcLengths}. A {@link Curve::Cursor} maps
+ * increasing or decreasing `u` in amortized `O(1)` instead of the binary
+ * search of {@link Curve#getUtoTmapping}.
+ *
+ * The batch methods write float `xyz` buffers. Curves with a piecewise cubic
+ * form (lines, Béziers, Catmull-Rom splines) evaluate four parameters per
+ * SIMD step; others fall back to {@link Curve#getPoint}. Caches are built
+ * lazily by `const` methods, so build them, e.g. with
+ * {@link Curve#getLength}, before sharing a curve between threads.
+ * ```c++
+ * CatmullRomCurve3 rail({{0, 0, 0}, {10, 5, 0}, {20, 0, 10}});
+ * Curve::Cursor cursor(rail);
+ * for (size_t frame = 0; frame < frames; frame++)
+ *     camera->position().copy(cursor.getPointAt(frame / (frames - 1.0)));
+ * ```
+ */
+class Curve
+{
+public:
+    /**
+     * Tangent, normal and binormal vectors along a curve.
+     */
+    struct FrenetFrames
+    {
+        std::vector<Vector3> tangents;
+        std::vector<Vector3> normals;
+        std::vector<Vector3> binormals;
+    };
+
+    /**
+     * Maps `u` to `t` by walking the arc-length table from the previous
+     * lookup, which costs `O(1)` for monotone sampling. The curve must
+     * outlive the cursor and must not change while it is used.
+     */
+    class Cursor
+    {
+    public:
+        /**
+         * @param {Curve} curve - The curve to sample. Builds its arc-length table.
+         */
+        explicit Cursor(const Curve &curve);
+
+        /**
+         * @param {HIGH_PRECISION} u - A fraction of the arc length in `[0,1]`.
+         * @return {HIGH_PRECISION} The curve parameter `t` at `u`.
+         */
+        HIGH_PRECISION map(HIGH_PRECISION u);
+        /**
+         * @param {HIGH_PRECISION} u - A fraction of the arc length in `[0,1]`.
+         * @return {Vector3} The point at `u`.
+         */
+        Vector3 getPointAt(HIGH_PRECISION u);
+        /**
+         * Restarts the walk at the beginning of the curve.
+         */
+        void reset();
+
+    private:
+        const Curve *m_curve;
+        const std::vector<HIGH_PRECISION> *m_lengths;
+        size_t m_index = 0;
+    };
+
+    Curve();
+    virtual ~Curve();
+
+    virtual std::string type() const;
+
+    /**
+     * Returns a point on the curve for the given interpolation factor.
+     *
+     * @param {HIGH_PRECISION} t - A interpolation factor representing a position on the curve. Must be in the range `[0,1]`.
+     * @return {Vector3} The position on the curve.
+     */
+    virtual Vector3 getPoint(HIGH_PRECISION t) const = 0;
+    /**
+     * Returns a point on the curve for the given fraction of its length.
+     *
+     * @param {HIGH_PRECISION} u - The fraction of the arc length. Must be in the range `[0,1]`.
+     * @return {Vector3} The position on the curve.
+     */
+    virtual Vector3 getPointAt(HIGH_PRECISION u) const;
+    /**
+     * Samples the curve at `divisions + 1` equally spaced values of `t`.
+     *
+     * @param {size_t} [divisions=5] - The number of divisions.
+     * @return {std::vector<Vector3>}
+     */
+    virtual std::vector<Vector3> getPoints(size_t divisions = 5) const;
+    /**
+     * Samples the curve at `divisions + 1` points equally spaced along its length.
+     *
+     * @param {size_t} [divisions=5] - The number of divisions.
+     * @return {std::vector<Vector3>}
+     */
+    std::vector<Vector3> getSpacedPoints(size_t divisions = 5) const;
+
+    /**
+     * @return {HIGH_PRECISION} The total arc length of the curve.
+     */
+    virtual HIGH_PRECISION getLength() const;
+    /**
+     * The cumulative arc length at `t = i / divisions` for every `i`, where
+     * `divisions` is {@link Curve#arcLengthDivisions}.
+     *
+     * @return {std::vector<HIGH_PRECISION>}
+     */
+    const std::vector<HIGH_PRECISION> &getLengths() const;
+    /**
+     * Drops the cached arc-length table and cubic form. Call it after
+     * changing the curve.
+     */
+    virtual void updateArcLengths();
+    /**
+     * Maps a fraction of the arc length to the curve parameter with a
+     * binary search of the arc-length table.
+     *
+     * @param {HIGH_PRECISION} u - The fraction of the arc length in `[0,1]`.
+     * @return {HIGH_PRECISION} The curve parameter `t`.
+     */
+    HIGH_PRECISION getUtoTmapping(HIGH_PRECISION u) const;
+
+    size_t arcLengthDivisions() const;
+    void setArcLengthDivisions(size_t divisions);
+
+    /**
+     * Returns the unit tangent at `t`. The default uses a central difference
+     * of {@link Curve#getPoint}.
+     *
+     * @param {HIGH_PRECISION} t - The curve parameter in `[0,1]`.
+     * @return {Vector3}
+     */
+    virtual Vector3 getTangent(HIGH_PRECISION t) const;
+    /**
+     * @param {HIGH_PRECISION} u - The fraction of the arc length in `[0,1]`.
+     * @return {Vector3} The unit tangent at `u`.
+     */
+    virtual Vector3 getTangentAt(HIGH_PRECISION u) const;
+
+    /**
+     * Computes rotation-minimizing frames at `segments + 1` points equally
+     * spaced along the curve, as used for tubes and camera rails.
+     *
+     * @param {size_t} segments - The number of segments.
+     * @param {bool} [closed=false] - Whether the frames should wrap around, spreading the twist between the first and the last frame along the curve.
+     * @return {FrenetFrames}
+     */
+    FrenetFrames computeFrenetFrames(size_t segments, bool closed = false) const;
+    /**
+     * Float buffer variant of {@link Curve#computeFrenetFrames}. The
+     * tangents are evaluated in one batch, the frames are then transported
+     * without trigonometry.
+     *
+     * @param {size_t} segments - The number of segments.
+     * @param {bool} closed - Whether the frames should wrap around.
+     * @param {std::span<float>} tangents - Receives `(segments + 1) * 3` values.
+     * @param {std::span<float>} normals - Receives `(segments + 1) * 3` values.
+     * @param {std::span<float>} binormals - Receives `(segments + 1) * 3` values.
+     */
+    void computeFrenetFrames(size_t segments, bool closed, std::span<float> tangents, std::span<float> normals, std::span<float> binormals) const;
+
+    /**
+     * Evaluates the curve at many parameters. Large batches are split
+     * across threads.
+     *
+     * @param {std::span<const float>} t - Curve parameters in `[0,1]`, clamped.
+     * @param {std::span<float>} points - Receives three values per parameter.
+     * @param {std::span<float>} [tangents] - Receives the unit tangents if not empty.
+     */
+    void evaluate(std::span<const float> t, std::span<float> points, std::span<float> tangents = {}) const;
+    /**
+     * Like {@link Curve#evaluate} with fractions of the arc length, mapped
+     * through the arc-length table with one {@link Curve::Cursor} per chunk,
+     * so sorted input maps in linear time.
+     *
+     * @param {std::span<const float>} u - Fractions of the arc length in `[0,1]`.
+     * @param {std::span<float>} points - Receives three values per fraction.
+     * @param {std::span<float>} [tangents] - Receives the unit tangents if not empty.
+     */
+    void evaluateAt(std::span<const float> u, std::span<float> points, std::span<float> tangents = {}) const;
+
+protected:
+    /**
+     * One piece of a piecewise cubic curve: `c[0] + c[1] t + c[2] t² + c[3] t³`
+     * per axis for a local `t` in `[0,1]`.
+     */
+    struct Cubic
+    {
+        float x[4];
+        float y[4];
+        float z[4];
+    };
+
+    /**
+     * Appends the cubic form of the curve, pieces spanning equal intervals
+     * of `t`. Curves without one append nothing and are evaluated with
+     * {@link Curve#getPoint} in batches.
+     *
+     * @param {std::vector<Cubic>} cubics - Receives the pieces.
+     */
+    virtual void buildCubics(std::vector<Cubic> &cubics) const;
+    /**
+     * Builds every lazy cache, before a batch goes parallel.
+     */
+    virtual void prepare() const;
+
+    static Cubic cubicFromCoefficients(const HIGH_PRECISION x[4], const HIGH_PRECISION y[4], const HIGH_PRECISION z[4]);
+    /**
+     * Evaluates a cubic given by its power basis coefficients per axis.
+     *
+     * @return {Vector3}
+     */
+    static Vector3 cubicPoint(const HIGH_PRECISION x[4], const HIGH_PRECISION y[4], const HIGH_PRECISION z[4], HIGH_PRECISION t);
+    /**
+     * The derivative of a cubic given by its power basis coefficients.
+     *
+     * @return {Vector3} Not normalized; zero where the derivative vanishes.
+     */
+    static Vector3 cubicDerivative(const HIGH_PRECISION x[4], const HIGH_PRECISION y[4], const HIGH_PRECISION z[4], HIGH_PRECISION t);
+
+private:
+    const std::vector<Cubic> &cubics() const;
+    static void evaluateCubics(const Cubic *pieces, size_t pieceCount, const float *t, size_t count, float *points, float *tangents);
+
+    size_t m_arcLengthDivisions = 200;
+
+    // empty until built
+    mutable std::vector<HIGH_PRECISION> m_lengths;
+    mutable std::vector<Cubic> m_cubics;
+    mutable bool m_cubicsBuilt = false;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef CURVE_PATH_H
+#define CURVE_PATH_H
+
+#include "extras/core/Curve.h"
+#include <memory>
+
+/**
+ * A curve made of a sequence of connected curves, e.g. lines and Béziers
+ * of a camera rail. `t` is split between the curves by their length.
+ * ```c++
+ * CurvePath path;
+ * path.add(std::make_shared<LineCurve3>(Vector3(0, 0, 0), Vector3(10, 0, 0)));
+ * path.add(std::make_shared<QuadraticBezierCurve3>(Vector3(10, 0, 0), Vector3(15, 0, 5), Vector3(15, 0, 10)));
+ * path.closePath();
+ * ```
+ */
+class CurvePath : public Curve
+{
+public:
+    CurvePath();
+    ~CurvePath() override;
+
+    std::string type() const override;
+
+    /**
+     * Adds a curve to the end of the path.
+     *
+     * @param {std::shared_ptr<Curve>} curve - The curve to add.
+     */
+    void add(std::shared_ptr<Curve> curve);
+    /**
+     * Adds a line from the end of the last curve to the start of the first
+     * one, unless they already meet.
+     */
+    void closePath();
+    const std::vector<std::shared_ptr<Curve>> &curves() const;
+
+    /**
+     * Whether {@link CurvePath#getPoints} repeats the first point at the end.
+     *
+     * @return {bool}
+     */
+    bool autoClose() const;
+    void setAutoClose(bool autoClose);
+
+    Vector3 getPoint(HIGH_PRECISION t) const override;
+    HIGH_PRECISION getLength() const override;
+    void updateArcLengths() override;
+    /**
+     * The cumulative length at the end of every curve.
+     *
+     * @return {std::vector<HIGH_PRECISION>}
+     */
+    const std::vector<HIGH_PRECISION> &getCurveLengths() const;
+    /**
+     * Samples every curve with a resolution suited to its type, lines with
+     * their end points only, and drops repeated points at the joints.
+     *
+     * @param {size_t} [divisions=12] - The number of divisions per curve.
+     * @return {std::vector<Vector3>}
+     */
+    std::vector<Vector3> getPoints(size_t divisions = 12) const override;
+
+protected:
+    void prepare() const override;
+
+private:
+    std::vector<std::shared_ptr<Curve>> m_curves;
+    bool m_autoClose = false;
+
+    // empty until built
+    mutable std::vector<HIGH_PRECISION> m_cacheLengths;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef PATH_H
+#define PATH_H
+
+#include "extras/core/CurvePath.h"
+#include "math/Vector2.h"
+
+/**
+ * A 2D path representation. The class provides methods for creating paths
+ * and contours of 2D shapes similar to the 2D Canvas API. The segments are
+ * kept as curves in the XY plane of a {@link CurvePath}.
+ * ```c++
+ * Path path;
+ * path.lineTo(0, 0.8).quadraticCurveTo(0, 1, 0.2, 1).lineTo(1, 1);
+ * std::vector<Vector2> points = path.getPoints();
+ * ```
+ */
+class Path
+{
+public:
+    /**
+     * @param {std::vector<Vector2>} [points] - An array of 2D points defining the path.
+     */
+    Path(const std::vector<Vector2> &points = {});
+    virtual ~Path();
+
+    virtual std::string type() const;
+
+    /**
+     * Creates a path from the given list of points. The points are added
+     * to the path as instances of {@link LineCurve3}.
+     *
+     * @param {std::vector<Vector2>} points - An array of 2D points.
+     * @return {Path} A reference to this path.
+     */
+    Path &setFromPoints(const std::vector<Vector2> &points);
+    /**
+     * Moves {@link Path#currentPoint} to the given point.
+     *
+     * @param {HIGH_PRECISION} x - The x coordinate.
+     * @param {HIGH_PRECISION} y - The y coordinate.
+     * @return {Path} A reference to this path.
+     */
+    Path &moveTo(HIGH_PRECISION x, HIGH_PRECISION y);
+    /**
+     * Adds a straight line from {@link Path#currentPoint} to the given point.
+     *
+     * @param {HIGH_PRECISION} x - The x coordinate of the end point.
+     * @param {HIGH_PRECISION} y - The y coordinate of the end point.
+     * @return {Path} A reference to this path.
+     */
+    Path &lineTo(HIGH_PRECISION x, HIGH_PRECISION y);
+    /**
+     * Adds a quadratic curve from {@link Path#currentPoint} with the given
+     * control point and end point.
+     *
+     * @param {HIGH_PRECISION} aCPx - The x coordinate of the control point.
+     * @param {HIGH_PRECISION} aCPy - The y coordinate of the control point.
+     * @param {HIGH_PRECISION} aX - The x coordinate of the end point.
+     * @param {HIGH_PRECISION} aY - The y coordinate of the end point.
+     * @return {Path} A reference to this path.
+     */
+    Path &quadraticCurveTo(HIGH_PRECISION aCPx, HIGH_PRECISION aCPy, HIGH_PRECISION aX, HIGH_PRECISION aY);
+    /**
+     * Adds a cubic Bézier curve from {@link Path#currentPoint} with the
+     * given control points and end point.
+     *
+     * @param {HIGH_PRECISION} aCP1x - The x coordinate of the first control point.
+     * @param {HIGH_PRECISION} aCP1y - The y coordinate of the first control point.
+     * @param {HIGH_PRECISION} aCP2x - The x coordinate of the second control point.
+     * @param {HIGH_PRECISION} aCP2y - The y coordinate of the second control point.
+     * @param {HIGH_PRECISION} aX - The x coordinate of the end point.
+     * @param {HIGH_PRECISION} aY - The y coordinate of the end point.
+     * @return {Path} A reference to this path.
+     */
+    Path &bezierCurveTo(HIGH_PRECISION aCP1x, HIGH_PRECISION aCP1y, HIGH_PRECISION aCP2x, HIGH_PRECISION aCP2y, HIGH_PRECISION aX, HIGH_PRECISION aY);
+    /**
+     * Adds a uniform Catmull-Rom spline from {@link Path#currentPoint}
+     * through the given points.
+     *
+     * @param {std::vector<Vector2>} pts - The points the spline passes through.
+     * @return {Path} A reference to this path.
+     */
+    Path &splineThru(const std::vector<Vector2> &pts);
+    /**
+     * Adds an arc whose center is relative to {@link Path#currentPoint}.
+     *
+     * @param {HIGH_PRECISION} aX - The x coordinate of the center, relative to the current point.
+     * @param {HIGH_PRECISION} aY - The y coordinate of the center, relative to the current point.
+     * @param {HIGH_PRECISION} aRadius - The radius of the arc.
+     * @param {HIGH_PRECISION} aStartAngle - The start angle in radians.
+     * @param {HIGH_PRECISION} aEndAngle - The end angle in radians.
+     * @param {bool} [aClockwise=false] - Whether to sweep the arc clockwise or not.
+     * @return {Path} A reference to this path.
+     */
+    Path &arc(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION aRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise = false);
+    /**
+     * Adds an absolutely positioned arc.
+     *
+     * @param {HIGH_PRECISION} aX - The x coordinate of the center.
+     * @param {HIGH_PRECISION} aY - The y coordinate of the center.
+     * @param {HIGH_PRECISION} aRadius - The radius of the arc.
+     * @param {HIGH_PRECISION} aStartAngle - The start angle in radians.
+     * @param {HIGH_PRECISION} aEndAngle - The end angle in radians.
+     * @param {bool} [aClockwise=false] - Whether to sweep the arc clockwise or not.
+     * @return {Path} A reference to this path.
+     */
+    Path &absarc(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION aRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise = false);
+    /**
+     * Adds an ellipse whose center is relative to {@link Path#currentPoint}.
+     *
+     * @param {HIGH_PRECISION} aX - The x coordinate of the center, relative to the current point.
+     * @param {HIGH_PRECISION} aY - The y coordinate of the center, relative to the current point.
+     * @param {HIGH_PRECISION} xRadius - The radius of the ellipse in the x axis.
+     * @param {HIGH_PRECISION} yRadius - The radius of the ellipse in the y axis.
+     * @param {HIGH_PRECISION} aStartAngle - The start angle in radians.
+     * @param {HIGH_PRECISION} aEndAngle - The end angle in radians.
+     * @param {bool} [aClockwise=false] - Whether to sweep the ellipse clockwise or not.
+     * @param {HIGH_PRECISION} [aRotation=0] - The rotation angle of the ellipse in radians, counterclockwise from the positive X axis.
+     * @return {Path} A reference to this path.
+     */
+    Path &ellipse(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION xRadius, HIGH_PRECISION yRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise = false, HIGH_PRECISION aRotation = 0);
+    /**
+     * Adds an absolutely positioned ellipse. A line from
+     * {@link Path#currentPoint} to the start of the ellipse is added first
+     * if they do not meet.
+     *
+     * @param {HIGH_PRECISION} aX - The x coordinate of the center.
+     * @param {HIGH_PRECISION} aY - The y coordinate of the center.
+     * @param {HIGH_PRECISION} xRadius - The radius of the ellipse in the x axis.
+     * @param {HIGH_PRECISION} yRadius - The radius of the ellipse in the y axis.
+     * @param {HIGH_PRECISION} aStartAngle - The start angle in radians.
+     * @param {HIGH_PRECISION} aEndAngle - The end angle in radians.
+     * @param {bool} [aClockwise=false] - Whether to sweep the ellipse clockwise or not.
+     * @param {HIGH_PRECISION} [aRotation=0] - The rotation angle of the ellipse in radians, counterclockwise from the positive X axis.
+     * @return {Path} A reference to this path.
+     */
+    Path &absellipse(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION xRadius, HIGH_PRECISION yRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise = false, HIGH_PRECISION aRotation = 0);
+    /**
+     * Adds a line back to the start of the path unless it is closed already.
+     *
+     * @return {Path} A reference to this path.
+     */
+    Path &closePath();
+
+    /**
+     * The current offset of the path. Any new curve added will start here.
+     *
+     * @return {Vector2}
+     */
+    const Vector2 &currentPoint() const;
+    /**
+     * The curves of the path.
+     *
+     * @return {CurvePath}
+     */
+    CurvePath &curvePath();
+    const CurvePath &curvePath() const;
+
+    /**
+     * Samples the path, see {@link CurvePath#getPoints}.
+     *
+     * @param {size_t} [divisions=12] - The number of divisions per curve.
+     * @return {std::vector<Vector2>}
+     */
+    std::vector<Vector2> getPoints(size_t divisions = 12) const;
+    /**
+     * Samples the path at points equally spaced along its length.
+     *
+     * @param {size_t} [divisions=40] - The number of divisions.
+     * @return {std::vector<Vector2>}
+     */
+    std::vector<Vector2> getSpacedPoints(size_t divisions = 40) const;
+
+private:
+    CurvePath m_curvePath;
+    Vector2 m_currentPoint;
+};
+
+#endif
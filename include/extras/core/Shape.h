@@ -0,0 +1,64 @@
+#ifndef SHAPE_H
+#define SHAPE_H
+
+#include "extras/core/Path.h"
+
+/**
+ * Defines an arbitrary 2D shape plane using paths with optional holes. It
+ * can be used with {@link ExtrudeGeometry} or triangulated with
+ * {@link ShapeUtils::triangulateShape}.
+ * ```c++
+ * Shape footprint({{0, 0}, {20, 0}, {20, 12}, {0, 12}});
+ * footprint.holes().push_back(Path({{8, 4}, {12, 4}, {12, 8}, {8, 8}}));
+ * auto geometry = std::make_shared<ExtrudeGeometry>(std::vector<Shape>{footprint});
+ * ```
+ */
+class Shape : public Path
+{
+public:
+    /**
+     * The sampled outline and holes of a shape.
+     */
+    struct Points
+    {
+        std::vector<Vector2> shape;
+        std::vector<std::vector<Vector2>> holes;
+    };
+
+    /**
+     * @param {std::vector<Vector2>} [points] - An array of 2D points defining the outline.
+     */
+    Shape(const std::vector<Vector2> &points = {});
+    ~Shape() override;
+
+    std::string type() const override;
+
+    /**
+     * The paths that define the holes in the shape.
+     *
+     * @return {std::vector<Path>}
+     */
+    std::vector<Path> &holes();
+    const std::vector<Path> &holes() const;
+
+    /**
+     * Returns an array representing each contour of the holes as a list
+     * of 2D points.
+     *
+     * @param {size_t} divisions - The fineness of the result.
+     * @return {std::vector<std::vector<Vector2>>}
+     */
+    std::vector<std::vector<Vector2>> getPointsHoles(size_t divisions) const;
+    /**
+     * Returns the sampled outline and holes of the shape.
+     *
+     * @param {size_t} divisions - The fineness of the result.
+     * @return {Points}
+     */
+    Points extractPoints(size_t divisions) const;
+
+private:
+    std::vector<Path> m_holes;
+};
+
+#endif
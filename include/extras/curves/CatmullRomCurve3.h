@@ -0,0 +1,89 @@
+#ifndef CATMULL_ROM_CURVE3_H
+#define CATMULL_ROM_CURVE3_H
+
+#include "extras/core/Curve.h"
+#include <array>
+
+/**
+ * A curve representing a Catmull-Rom spline through a list of points.
+ * The cubic of every span between two points is cached until
+ * {@link Curve#updateArcLengths}, so {@link CatmullRomCurve3#getPoint} is a
+ * polynomial evaluation and batches cost the same as for a Bézier curve.
+ * ```c++
+ * CatmullRomCurve3 curve({{-10, 0, 10}, {-5, 5, 5}, {0, 0, 0}, {5, -5, 5}, {10, 0, 10}});
+ * std::vector<Vector3> points = curve.getPoints(50);
+ * ```
+ */
+class CatmullRomCurve3 : public Curve
+{
+public:
+    enum class CurveType
+    {
+        /**
+         * Knots spaced by the square root of the chord length; no cusps or
+         * self-intersections within a span.
+         */
+        Centripetal,
+        /**
+         * Knots spaced by the chord length.
+         */
+        Chordal,
+        /**
+         * Uniform knots with a configurable tension.
+         */
+        CatmullRom
+    };
+
+    /**
+     * @param {std::vector<Vector3>} [points] - An array of points.
+     * @param {bool} [closed=false] - Whether the curve is closed.
+     * @param {CurveType} [curveType=CurveType::Centripetal] - The curve type.
+     * @param {HIGH_PRECISION} [tension=0.5] - Tension of the curve, used by `CurveType::CatmullRom` only.
+     */
+    CatmullRomCurve3(std::vector<Vector3> points = {}, bool closed = false, CurveType curveType = CurveType::Centripetal, HIGH_PRECISION tension = 0.5);
+    ~CatmullRomCurve3() override;
+
+    std::string type() const override;
+
+    const std::vector<Vector3> &points() const;
+    void setPoints(std::vector<Vector3> points);
+    bool closed() const;
+    void setClosed(bool closed);
+    CurveType curveType() const;
+    void setCurveType(CurveType curveType);
+    HIGH_PRECISION tension() const;
+    void setTension(HIGH_PRECISION tension);
+
+    Vector3 getPoint(HIGH_PRECISION t) const override;
+    /**
+     * The normalized derivative of the span at `t`, or the central
+     * difference of the base class where the derivative vanishes.
+     *
+     * @param {HIGH_PRECISION} t - The curve parameter in `[0,1]`.
+     * @return {Vector3}
+     */
+    Vector3 getTangent(HIGH_PRECISION t) const override;
+    void updateArcLengths() override;
+
+protected:
+    void buildCubics(std::vector<Cubic> &cubics) const override;
+
+private:
+    // x, y and z power basis coefficients of one span
+    using Span = std::array<HIGH_PRECISION, 12>;
+
+    // the span holding t and the parameter local to it
+    const Span &locate(HIGH_PRECISION t, HIGH_PRECISION &local) const;
+    const std::vector<Span> &spans() const;
+    Span computeSpan(size_t index) const;
+
+    std::vector<Vector3> m_points;
+    bool m_closed;
+    CurveType m_curveType;
+    HIGH_PRECISION m_tension;
+
+    // empty until built
+    mutable std::vector<Span> m_spans;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef CUBIC_BEZIER_CURVE3_H
+#define CUBIC_BEZIER_CURVE3_H
+
+#include "extras/core/Curve.h"
+
+/**
+ * A curve representing a 3D cubic Bézier curve.
+ * ```c++
+ * CubicBezierCurve3 curve({-10, 0, 0}, {-5, 15, 0}, {20, 15, 0}, {10, 0, 0});
+ * std::vector<Vector3> points = curve.getPoints(50);
+ * ```
+ */
+class CubicBezierCurve3 : public Curve
+{
+public:
+    /**
+     * @param {Vector3} [v0] - The start point.
+     * @param {Vector3} [v1] - The first control point.
+     * @param {Vector3} [v2] - The second control point.
+     * @param {Vector3} [v3] - The end point.
+     */
+    CubicBezierCurve3(const Vector3 &v0 = Vector3(), const Vector3 &v1 = Vector3(), const Vector3 &v2 = Vector3(), const Vector3 &v3 = Vector3());
+    ~CubicBezierCurve3() override;
+
+    std::string type() const override;
+
+    /**
+     * The control points. Call {@link Curve#updateArcLengths} after
+     * changing one.
+     *
+     * @return {Vector3}
+     */
+    Vector3 &v0();
+    const Vector3 &v0() const;
+    Vector3 &v1();
+    const Vector3 &v1() const;
+    Vector3 &v2();
+    const Vector3 &v2() const;
+    Vector3 &v3();
+    const Vector3 &v3() const;
+
+    Vector3 getPoint(HIGH_PRECISION t) const override;
+    /**
+     * The normalized derivative, or the central difference of the base
+     * class where the derivative vanishes.
+     *
+     * @param {HIGH_PRECISION} t - The curve parameter in `[0,1]`.
+     * @return {Vector3}
+     */
+    Vector3 getTangent(HIGH_PRECISION t) const override;
+
+protected:
+    void buildCubics(std::vector<Cubic> &cubics) const override;
+
+private:
+    // power basis coefficients per axis
+    void coefficients(HIGH_PRECISION x[4], HIGH_PRECISION y[4], HIGH_PRECISION z[4]) const;
+
+    Vector3 m_v0;
+    Vector3 m_v1;
+    Vector3 m_v2;
+    Vector3 m_v3;
+};
+
+#endif
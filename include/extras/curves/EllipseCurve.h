@@ -0,0 +1,46 @@
+#ifndef ELLIPSE_CURVE_H
+#define ELLIPSE_CURVE_H
+
+#include "extras/core/Curve.h"
+
+/**
+ * A curve representing an ellipse or an arc of one in the XY plane, the
+ * building block of the arcs of {@link Path}.
+ * ```c++
+ * EllipseCurve curve(0, 0, 10, 10, 0, 2 * MATH_PI, false, 0);
+ * std::vector<Vector3> points = curve.getPoints(50);
+ * ```
+ */
+class EllipseCurve : public Curve
+{
+public:
+    /**
+     * @param {HIGH_PRECISION} [aX=0] - The X center of the ellipse.
+     * @param {HIGH_PRECISION} [aY=0] - The Y center of the ellipse.
+     * @param {HIGH_PRECISION} [xRadius=1] - The radius of the ellipse in the x direction.
+     * @param {HIGH_PRECISION} [yRadius=1] - The radius of the ellipse in the y direction.
+     * @param {HIGH_PRECISION} [aStartAngle=0] - The start angle of the curve in radians starting from the positive X axis.
+     * @param {HIGH_PRECISION} [aEndAngle=Math.PI*2] - The end angle of the curve in radians starting from the positive X axis.
+     * @param {bool} [aClockwise=false] - Whether the ellipse is drawn clockwise or not.
+     * @param {HIGH_PRECISION} [aRotation=0] - The rotation angle of the ellipse in radians, counterclockwise from the positive X axis.
+     */
+    EllipseCurve(HIGH_PRECISION aX = 0, HIGH_PRECISION aY = 0, HIGH_PRECISION xRadius = 1, HIGH_PRECISION yRadius = 1,
+                 HIGH_PRECISION aStartAngle = 0, HIGH_PRECISION aEndAngle = MATH_PI * 2, bool aClockwise = false, HIGH_PRECISION aRotation = 0);
+    ~EllipseCurve() override;
+
+    std::string type() const override;
+
+    Vector3 getPoint(HIGH_PRECISION t) const override;
+
+private:
+    HIGH_PRECISION m_aX;
+    HIGH_PRECISION m_aY;
+    HIGH_PRECISION m_xRadius;
+    HIGH_PRECISION m_yRadius;
+    HIGH_PRECISION m_aStartAngle;
+    HIGH_PRECISION m_aEndAngle;
+    bool m_aClockwise;
+    HIGH_PRECISION m_aRotation;
+};
+
+#endif
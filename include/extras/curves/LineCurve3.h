@@ -0,0 +1,51 @@
+#ifndef LINE_CURVE3_H
+#define LINE_CURVE3_H
+
+#include "extras/core/Curve.h"
+
+/**
+ * A curve representing a 3D line segment. It is parameterized by arc
+ * length already, so the `At` methods skip the arc-length table.
+ */
+class LineCurve3 : public Curve
+{
+public:
+    /**
+     * @param {Vector3} [v1] - The start point.
+     * @param {Vector3} [v2] - The end point.
+     */
+    LineCurve3(const Vector3 &v1 = Vector3(), const Vector3 &v2 = Vector3());
+    ~LineCurve3() override;
+
+    std::string type() const override;
+
+    /**
+     * The start point. Call {@link Curve#updateArcLengths} after changing it.
+     *
+     * @return {Vector3}
+     */
+    Vector3 &v1();
+    const Vector3 &v1() const;
+    /**
+     * The end point. Call {@link Curve#updateArcLengths} after changing it.
+     *
+     * @return {Vector3}
+     */
+    Vector3 &v2();
+    const Vector3 &v2() const;
+
+    Vector3 getPoint(HIGH_PRECISION t) const override;
+    Vector3 getPointAt(HIGH_PRECISION u) const override;
+    HIGH_PRECISION getLength() const override;
+    Vector3 getTangent(HIGH_PRECISION t) const override;
+    Vector3 getTangentAt(HIGH_PRECISION u) const override;
+
+protected:
+    void buildCubics(std::vector<Cubic> &cubics) const override;
+
+private:
+    Vector3 m_v1;
+    Vector3 m_v2;
+};
+
+#endif
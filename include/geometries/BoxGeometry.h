@@ -0,0 +1,59 @@
+#ifndef BOX_GEOMETRY_H
+#define BOX_GEOMETRY_H
+
+#include "core/BufferGeometry.h"
+#include "geometries/GeometryUtils.h"
+
+/**
+ * A geometry class for a rectangular cuboid with a given width, height, and
+ * depth, centered on the origin. Each face is a separate grid, so edges have
+ * split normals and uvs.
+ * ```c++
+ * auto geometry = std::make_shared<BoxGeometry>(1, 1, 1);
+ * auto cube = std::make_shared<Mesh>(geometry);
+ * ```
+ */
+class BoxGeometry : public BufferGeometry
+{
+public:
+    struct Parameters
+    {
+        float width;
+        float height;
+        float depth;
+        size_t widthSegments;
+        size_t heightSegments;
+        size_t depthSegments;
+    };
+
+    /**
+     * Constructs a new box geometry.
+     *
+     * @param {float} [width=1] - The width along the X axis.
+     * @param {float} [height=1] - The height along the Y axis.
+     * @param {float} [depth=1] - The depth along the Z axis.
+     * @param {size_t} [widthSegments=1] - The number of segments along the X axis.
+     * @param {size_t} [heightSegments=1] - The number of segments along the Y axis.
+     * @param {size_t} [depthSegments=1] - The number of segments along the Z axis.
+     */
+    BoxGeometry(float width = 1, float height = 1, float depth = 1, size_t widthSegments = 1, size_t heightSegments = 1, size_t depthSegments = 1);
+    ~BoxGeometry() override;
+
+    std::string type() const override;
+
+    /**
+     * The parameters the geometry was generated with.
+     *
+     * @return {Parameters}
+     */
+    const Parameters &parameters() const;
+
+private:
+    Parameters m_parameters;
+
+    static void buildPlane(const GeometryUtils::Streams &streams, size_t vertexOffset, size_t indexOffset,
+                           size_t u, size_t v, size_t w, float udir, float vdir,
+                           float width, float height, float depth, size_t gridX, size_t gridY);
+};
+
+#endif
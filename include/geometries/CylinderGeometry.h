@@ -0,0 +1,59 @@
+#ifndef CYLINDER_GEOMETRY_H
+#define CYLINDER_GEOMETRY_H
+
+#include "common/BasicType.h"
+#include "core/BufferGeometry.h"
+
+/**
+ * A geometry class for a cylinder along the Y axis, centered on the origin.
+ * Different top and bottom radii make cones and frustums.
+ * ```c++
+ * auto geometry = std::make_shared<CylinderGeometry>(5, 5, 20, 32);
+ * auto cylinder = std::make_shared<Mesh>(geometry);
+ * ```
+ */
+class CylinderGeometry : public BufferGeometry
+{
+public:
+    struct Parameters
+    {
+        float radiusTop;
+        float radiusBottom;
+        float height;
+        size_t radialSegments;
+        size_t heightSegments;
+        bool openEnded;
+        float thetaStart;
+        float thetaLength;
+    };
+
+    /**
+     * Constructs a new cylinder geometry.
+     *
+     * @param {float} [radiusTop=1] - Radius of the cylinder at the top.
+     * @param {float} [radiusBottom=1] - Radius of the cylinder at the bottom.
+     * @param {float} [height=1] - Height of the cylinder.
+     * @param {size_t} [radialSegments=32] - Number of segmented faces around the circumference.
+     * @param {size_t} [heightSegments=1] - Number of rows of faces along the height.
+     * @param {bool} [openEnded=false] - Whether the ends of the cylinder are open or capped.
+     * @param {float} [thetaStart=0] - Start angle for the first segment, in radians.
+     * @param {float} [thetaLength=Math.PI*2] - The central angle of the circular sector.
+     */
+    CylinderGeometry(float radiusTop = 1, float radiusBottom = 1, float height = 1, size_t radialSegments = 32, size_t heightSegments = 1,
+                     bool openEnded = false, float thetaStart = 0, float thetaLength = MATH_PI * 2);
+    ~CylinderGeometry() override;
+
+    std::string type() const override;
+
+    /**
+     * The parameters the geometry was generated with.
+     *
+     * @return {Parameters}
+     */
+    const Parameters &parameters() const;
+
+private:
+    Parameters m_parameters;
+};
+
+#endif
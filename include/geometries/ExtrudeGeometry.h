@@ -0,0 +1,85 @@
+#ifndef EXTRUDE_GEOMETRY_H
+#define EXTRUDE_GEOMETRY_H
+
+#include "core/BufferGeometry.h"
+#include "extras/core/Curve.h"
+#include "extras/core/Shape.h"
+#include "math/Matrix3.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Creates extruded geometry from path shapes. Every shape is sampled,
+ * triangulated and beveled on its own, so a batch of shapes (e.g. the
+ * building footprints of a map tile) is prepared in parallel and then
+ * written straight into one set of buffers.
+ * ```c++
+ * Shape footprint({{0, 0}, {20, 0}, {20, 12}, {0, 12}});
+ * ExtrudeGeometry::Options options;
+ * options.depth = 30;
+ * options.bevelEnabled = false;
+ * auto geometry = std::make_shared<ExtrudeGeometry>(std::vector<Shape>{footprint}, options);
+ * auto building = std::make_shared<Mesh>(geometry);
+ * ```
+ */
+class ExtrudeGeometry : public BufferGeometry
+{
+public:
+    struct Options
+    {
+        // number of points on the curves
+        size_t curveSegments = 12;
+        // number of points used for subdividing segments along the depth of the extruded spline
+        size_t steps = 1;
+        // depth to extrude the shape
+        float depth = 1;
+        // whether to apply beveling to the shape
+        bool bevelEnabled = true;
+        // how deep into the original shape the bevel goes
+        float bevelThickness = 0.2f;
+        // distance from the shape outline that the bevel extends
+        float bevelSize = 0.1f;
+        // distance from the shape outline that the bevel starts
+        float bevelOffset = 0;
+        // number of bevel layers
+        size_t bevelSegments = 3;
+        // a 3D spline path along which the shape should be extruded; disables beveling
+        std::shared_ptr<Curve> extrudePath;
+    };
+
+    /**
+     * Constructs a new extrude geometry with the default settings.
+     *
+     * @param {std::vector<Shape>} shapes - The shapes to extrude.
+     */
+    explicit ExtrudeGeometry(const std::vector<Shape> &shapes);
+    /**
+     * Constructs a new extrude geometry.
+     *
+     * @param {std::vector<Shape>} shapes - The shapes to extrude.
+     * @param {Options} options - The extrude settings.
+     * @param {std::vector<Matrix3>} [transforms] - A 2D transform per shape, applied to its sampled points. Empty for none.
+     */
+    ExtrudeGeometry(const std::vector<Shape> &shapes, const Options &options, const std::vector<Matrix3> &transforms = {});
+    /**
+     * @param {Shape} shape - The shape to extrude.
+     * @param {Options} options - The extrude settings.
+     */
+    ExtrudeGeometry(const Shape &shape, const Options &options);
+    ~ExtrudeGeometry() override;
+
+    std::string type() const override;
+
+    /**
+     * The settings the geometry was generated with.
+     *
+     * @return {Options}
+     */
+    const Options &options() const;
+
+private:
+    Options m_options;
+};
+
+#endif
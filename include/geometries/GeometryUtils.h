@@ -0,0 +1,60 @@
+#ifndef GEOMETRY_UTILS_H
+#define GEOMETRY_UTILS_H
+
+#include "core/BufferGeometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Shared helpers of the primitive generators. Generators compute their exact
+ * vertex and index counts first, allocate every buffer once at its final
+ * size and then fill rows in parallel straight into the buffers.
+ */
+namespace GeometryUtils
+{
+    /**
+     * Write pointers into the buffers of a generated geometry.
+     */
+    struct Streams
+    {
+        float *position;
+        float *normal;
+        float *uv;
+        uint32_t *index;
+    };
+
+    /**
+     * Allocates `position`, `normal` and `uv` attributes of `vertexCount`
+     * vertices and an index of `indexCount` entries on `geometry`.
+     *
+     * @param {BufferGeometry} geometry - The geometry to fill.
+     * @param {size_t} vertexCount - The exact number of vertices.
+     * @param {size_t} indexCount - The exact number of indices.
+     * @return {Streams} Pointers to the start of each buffer.
+     */
+    Streams allocate(BufferGeometry &geometry, size_t vertexCount, size_t indexCount);
+
+    /**
+     * Tabulates `sin` and `cos` of `start + length * i / segments` for
+     * `i = 0..segments`, so row loops do not evaluate them per vertex.
+     *
+     * @param {double} start - The first angle.
+     * @param {double} length - The angle covered.
+     * @param {size_t} segments - The number of segments.
+     * @param {std::vector<float>} sines - Receives `segments + 1` sines.
+     * @param {std::vector<float>} cosines - Receives `segments + 1` cosines.
+     */
+    void sinCosTable(double start, double length, size_t segments, std::vector<float> &sines, std::vector<float> &cosines);
+
+    /**
+     * The number of rows per task for rows of `verticesPerRow` vertices;
+     * small geometries end up in one task on the calling thread.
+     *
+     * @param {size_t} verticesPerRow - Vertices written per row.
+     * @return {size_t}
+     */
+    size_t rowGrain(size_t verticesPerRow);
+}
+
+#endif
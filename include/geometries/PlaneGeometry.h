@@ -0,0 +1,48 @@
+#ifndef PLANE_GEOMETRY_H
+#define PLANE_GEOMETRY_H
+
+#include "core/BufferGeometry.h"
+
+/**
+ * A geometry class for a rectangular plane in the XY plane, facing +Z.
+ * ```c++
+ * auto geometry = std::make_shared<PlaneGeometry>(1, 1, 64, 64);
+ * auto plane = std::make_shared<Mesh>(geometry);
+ * ```
+ */
+class PlaneGeometry : public BufferGeometry
+{
+public:
+    struct Parameters
+    {
+        float width;
+        float height;
+        size_t widthSegments;
+        size_t heightSegments;
+    };
+
+    /**
+     * Constructs a new plane geometry.
+     *
+     * @param {float} [width=1] - The width along the X axis.
+     * @param {float} [height=1] - The height along the Y axis.
+     * @param {size_t} [widthSegments=1] - The number of segments along the X axis.
+     * @param {size_t} [heightSegments=1] - The number of segments along the Y axis.
+     */
+    PlaneGeometry(float width = 1, float height = 1, size_t widthSegments = 1, size_t heightSegments = 1);
+    ~PlaneGeometry() override;
+
+    std::string type() const override;
+
+    /**
+     * The parameters the geometry was generated with.
+     *
+     * @return {Parameters}
+     */
+    const Parameters &parameters() const;
+
+private:
+    Parameters m_parameters;
+};
+
+#endif
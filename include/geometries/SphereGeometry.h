@@ -0,0 +1,57 @@
+#ifndef SPHERE_GEOMETRY_H
+#define SPHERE_GEOMETRY_H
+
+#include "common/BasicType.h"
+#include "core/BufferGeometry.h"
+
+/**
+ * A class for generating sphere geometries. Partial spheres are created by
+ * restricting the horizontal (phi) and vertical (theta) sweep.
+ * ```c++
+ * auto geometry = std::make_shared<SphereGeometry>(15, 32, 16);
+ * auto sphere = std::make_shared<Mesh>(geometry);
+ * ```
+ */
+class SphereGeometry : public BufferGeometry
+{
+public:
+    struct Parameters
+    {
+        float radius;
+        size_t widthSegments;
+        size_t heightSegments;
+        float phiStart;
+        float phiLength;
+        float thetaStart;
+        float thetaLength;
+    };
+
+    /**
+     * Constructs a new sphere geometry.
+     *
+     * @param {float} [radius=1] - The sphere radius.
+     * @param {size_t} [widthSegments=32] - The number of horizontal segments. Minimum value is `3`.
+     * @param {size_t} [heightSegments=16] - The number of vertical segments. Minimum value is `2`.
+     * @param {float} [phiStart=0] - The horizontal starting angle in radians.
+     * @param {float} [phiLength=Math.PI*2] - The horizontal sweep angle size.
+     * @param {float} [thetaStart=0] - The vertical starting angle in radians.
+     * @param {float} [thetaLength=Math.PI] - The vertical sweep angle size.
+     */
+    SphereGeometry(float radius = 1, size_t widthSegments = 32, size_t heightSegments = 16,
+                   float phiStart = 0, float phiLength = MATH_PI * 2, float thetaStart = 0, float thetaLength = MATH_PI);
+    ~SphereGeometry() override;
+
+    std::string type() const override;
+
+    /**
+     * The parameters the geometry was generated with.
+     *
+     * @return {Parameters}
+     */
+    const Parameters &parameters() const;
+
+private:
+    Parameters m_parameters;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef TORUS_GEOMETRY_H
+#define TORUS_GEOMETRY_H
+
+#include "common/BasicType.h"
+#include "core/BufferGeometry.h"
+
+/**
+ * A geometry class for a torus in the XY plane.
+ * ```c++
+ * auto geometry = std::make_shared<TorusGeometry>(10, 3, 16, 100);
+ * auto torus = std::make_shared<Mesh>(geometry);
+ * ```
+ */
+class TorusGeometry : public BufferGeometry
+{
+public:
+    struct Parameters
+    {
+        float radius;
+        float tube;
+        size_t radialSegments;
+        size_t tubularSegments;
+        float arc;
+    };
+
+    /**
+     * Constructs a new torus geometry.
+     *
+     * @param {float} [radius=1] - Radius of the torus, from the center of the torus to the center of the tube.
+     * @param {float} [tube=0.4] - Radius of the tube. Must be smaller than `radius`.
+     * @param {size_t} [radialSegments=12] - The number of radial segments.
+     * @param {size_t} [tubularSegments=48] - The number of tubular segments.
+     * @param {float} [arc=Math.PI*2] - Central angle in radians.
+     */
+    TorusGeometry(float radius = 1, float tube = 0.4f, size_t radialSegments = 12, size_t tubularSegments = 48, float arc = MATH_PI * 2);
+    ~TorusGeometry() override;
+
+    std::string type() const override;
+
+    /**
+     * The parameters the geometry was generated with.
+     *
+     * @return {Parameters}
+     */
+    const Parameters &parameters() const;
+
+private:
+    Parameters m_parameters;
+};
+
+#endif
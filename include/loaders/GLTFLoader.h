@@ -0,0 +1,149 @@
+#ifndef GLTF_LOADER_H
+#define GLTF_LOADER_H
+
+#include "animation/AnimationClip.h"
+#include "core/Object3D.h"
+#include "loaders/LoaderUtils.h"
+#include "objects/Skeleton.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+/**
+ * The result of {@link GLTFLoader}: scenes, the objects of all nodes, skins
+ * and animation clips.
+ */
+struct GLTF
+{
+    // the default scene, or the first one
+    std::shared_ptr<Object3D> scene;
+    std::vector<std::shared_ptr<Object3D>> scenes;
+    // the object created for each glTF node, by node index
+    std::vector<std::shared_ptr<Object3D>> nodes;
+    // the skeleton created for each glTF skin, by skin index
+    std::vector<std::shared_ptr<Skeleton>> skins;
+    std::vector<std::shared_ptr<AnimationClip>> animations;
+};
+
+/**
+ * A loader for glTF 2.0 assets, both `.gltf` (JSON with external or embedded
+ * buffers) and binary `.glb` files.
+ *
+ * - Nodes become {@link Object3D}s, {@link Bone}s for skin joints, and
+ *   {@link Mesh}es or {@link SkinnedMesh}es; a node with several primitives
+ *   gets one mesh child per primitive. `matrix` nodes are split with
+ *   {@link Matrix4#decompose}.
+ * - Attributes map to the three.js names (`POSITION` to `position`,
+ *   `TEXCOORD_0` to `uv`, `JOINTS_0` to `skinIndex`, ...). `JOINTS_0` is
+ *   checked against the joints of every skin using the mesh. Morph targets
+ *   become sparse {@link MorphTarget}s.
+ * - Animation samplers become keyframe tracks on the node names. `STEP` maps
+ *   to discrete interpolation; `CUBICSPLINE` keeps the key values and drops
+ *   the tangents, played back linearly. Morph weight tracks target
+ *   `<node>.morphTargetInfluences` with one value per target; bind them
+ *   with {@link AnimationMixer#registerProperty}, passing the mesh's
+ *   `morphTargetInfluences` and its target count.
+ * - Materials, textures and cameras are not imported. Assets listing an
+ *   extension in `extensionsRequired` are rejected.
+ *
+ * Files are memory-mapped. Accessors are read through {@link GLTFLoader::AccessorView}s
+ * pointing straight into the mapped buffers, so the only pass over vertex
+ * data is the conversion into the attribute arrays, split across threads
+ * for all meshes at once.
+ * ```c++
+ * GLTFLoader loader;
+ * GLTF gltf = loader.load("models/gltf/Soldier.glb");
+ * scene->add(gltf.scene);
+ * ```
+ */
+class GLTFLoader
+{
+public:
+    enum class ComponentType
+    {
+        Int8 = 5120,
+        UInt8 = 5121,
+        Int16 = 5122,
+        UInt16 = 5123,
+        UInt32 = 5125,
+        Float32 = 5126
+    };
+
+    /**
+     * A typed, strided view of accessor data inside a loaded buffer. Nothing
+     * is copied; {@link GLTFLoader::AccessorView#read} converts to floats,
+     * denormalizing integer data with {@link MathUtils::denormalize} when the
+     * accessor is `normalized`.
+     */
+    struct AccessorView
+    {
+        const char *data = nullptr;
+        size_t count = 0;
+        size_t itemSize = 0;
+        // bytes between the starts of two items
+        size_t byteStride = 0;
+        ComponentType componentType = ComponentType::Float32;
+        bool normalized = false;
+
+        /**
+         * Reads component `component` of item `index`.
+         *
+         * @param {size_t} index - The item index.
+         * @param {size_t} component - The component index.
+         * @return {float}
+         */
+        float get(size_t index, size_t component) const;
+        /**
+         * Converts the items `[begin, end)` to floats, tightly packed into `target`.
+         *
+         * @param {float*} target - Receives `(end - begin) * itemSize` floats.
+         * @param {size_t} begin - First item.
+         * @param {size_t} end - One past the last item.
+         */
+        void read(float *target, size_t begin, size_t end) const;
+        /**
+         * Converts the items `[begin, end)` to unsigned integers; used for indices.
+         *
+         * @param {uint32_t*} target - Receives `(end - begin) * itemSize` values.
+         * @param {size_t} begin - First item.
+         * @param {size_t} end - One past the last item.
+         */
+        void read(uint32_t *target, size_t begin, size_t end) const;
+    };
+
+    GLTFLoader();
+    ~GLTFLoader();
+
+    /**
+     * Loads the asset at `path`; external buffers are resolved relative to it.
+     * Throws `std::runtime_error` on I/O or format errors.
+     *
+     * @param {std::string} path - The path of a `.gltf` or `.glb` file.
+     * @return {GLTF} The loaded asset.
+     */
+    GLTF load(const std::string &path);
+    /**
+     * Parses a `.gltf` or `.glb` file held in memory.
+     *
+     * @param {std::span<const char>} data - The raw file contents.
+     * @param {std::string} [resourcePath=""] - Directory for external buffers.
+     * @return {GLTF} The loaded asset.
+     */
+    GLTF parse(std::span<const char> data, const std::string &resourcePath = "");
+
+    /**
+     * Statistics of the last load or parse.
+     *
+     * @return {LoadStats}
+     */
+    const LoadStats &stats() const;
+
+private:
+    LoadStats m_stats;
+};
+
+#endif
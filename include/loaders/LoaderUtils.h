@@ -0,0 +1,135 @@
+#ifndef LOADER_UTILS_H
+#define LOADER_UTILS_H
+
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * Timing and memory figures of the last load of a geometry loader.
+ */
+struct LoadStats
+{
+    size_t fileBytes = 0;
+    // bytes held by the produced attributes and index
+    size_t outputBytes = 0;
+    double seconds = 0;
+    // peak resident set size of the process after the load, `0` if unknown
+    size_t peakResidentBytes = 0;
+};
+
+/**
+ * Shared helpers of the geometry loaders: chunking text on line boundaries
+ * for parallel parsing, and allocation-free number parsing on top of
+ * `std::from_chars`.
+ */
+namespace LoaderUtils
+{
+    /**
+     * Peak resident set size of the process in bytes, `0` where unsupported.
+     *
+     * @return {size_t}
+     */
+    size_t peakResidentBytes();
+
+    /**
+     * Splits `text` into about `chunkCount` pieces, each ending right after a
+     * newline (the last one at the end of `text`). Chunks smaller than
+     * `minChunkSize` are merged.
+     *
+     * @param {std::span<const char>} text - The text to split.
+     * @param {size_t} chunkCount - The desired number of chunks.
+     * @param {size_t} [minChunkSize=1<<20] - Minimum chunk size in bytes.
+     * @return {std::vector<std::span<const char>>} The chunks, in order.
+     */
+    std::vector<std::span<const char>> splitLines(std::span<const char> text, size_t chunkCount, size_t minChunkSize = 1 << 20);
+
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char *skipSpaces(const char *p, const char *end)
+    {
+        while (p < end && isSpace(*p))
+            ++p;
+        return p;
+    }
+
+    inline const char *skipLine(const char *p, const char *end)
+    {
+        const void *newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        return newline == nullptr ? end : static_cast<const char *>(newline) + 1;
+    }
+
+    inline const char *skipToken(const char *p, const char *end)
+    {
+        while (p < end && !isSpace(*p) && *p != '\n')
+            ++p;
+        return p;
+    }
+
+    /**
+     * Parses a number after optional blanks and advances `p` past it. Leaves
+     * `p` unchanged and returns `false` if there is none.
+     */
+    template <typename T>
+    inline bool parseNumber(const char *&p, const char *end, T &value)
+    {
+        const char *start = skipSpaces(p, end);
+
+        // from_chars rejects a leading '+'
+        if (start < end && *start == '+')
+            ++start;
+
+        const auto result = std::from_chars(start, end, value);
+        if (result.ec != std::errc())
+            return false;
+
+        p = result.ptr;
+        return true;
+    }
+
+    /**
+     * Reads a value stored in little- or big-endian byte order from a
+     * possibly unaligned address.
+     */
+    template <typename T>
+    inline T readValue(const char *p, bool littleEndian = true)
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+
+        if constexpr (sizeof(T) > 1)
+        {
+            if (littleEndian != (std::endian::native == std::endian::little))
+            {
+                char bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                for (size_t i = 0; i < sizeof(T) / 2; i++)
+                    std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+                std::memcpy(&value, bytes, sizeof(T));
+            }
+        }
+
+        return value;
+    }
+
+    /**
+     * The whitespace-delimited token at `p` (after blanks); `p` moves past it.
+     */
+    inline std::string_view nextToken(const char *&p, const char *end)
+    {
+        const char *start = skipSpaces(p, end);
+        p = skipToken(start, end);
+        return std::string_view(start, static_cast<size_t>(p - start));
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+#include "core/BufferGeometry.h"
+#include "loaders/LoaderUtils.h"
+#include <memory>
+#include <span>
+#include <string>
+
+class MappedFile;
+
+/**
+ * A loader for the Wavefront OBJ format. Reads `v` (with optional vertex
+ * colors), `vt`, `vn` and `f` statements, including negative indices;
+ * polygons are triangulated as fans. Groups, objects and materials are not
+ * separated, the whole file becomes one geometry.
+ *
+ * The file is memory-mapped and split into line-aligned chunks that are
+ * parsed in parallel: a counting pass sizes the output, a second pass parses
+ * straight into it. With `deduplicateVertices` (the default) every distinct
+ * `v/vt/vn` corner becomes one vertex of an indexed geometry; otherwise the
+ * result is non-indexed, as three.js produces it.
+ * ```c++
+ * OBJLoader loader;
+ * auto geometry = loader.load("models/obj/male02/male02.obj");
+ * ```
+ */
+class OBJLoader
+{
+public:
+    /**
+     * Whether identical corners are merged into an indexed geometry.
+     *
+     * @type {bool}
+     * @default true
+     */
+    bool deduplicateVertices = true;
+
+    OBJLoader();
+    ~OBJLoader();
+
+    /**
+     * Loads the file at `path`. Throws `std::runtime_error` on I/O or format errors.
+     *
+     * @param {std::string} path - The path of the file.
+     * @return {std::shared_ptr<BufferGeometry>} The parsed geometry.
+     */
+    std::shared_ptr<BufferGeometry> load(const std::string &path);
+    /**
+     * Parses the given OBJ text.
+     *
+     * @param {std::span<const char>} data - The raw file contents.
+     * @return {std::shared_ptr<BufferGeometry>} The parsed geometry.
+     */
+    std::shared_ptr<BufferGeometry> parse(std::span<const char> data);
+
+    /**
+     * Statistics of the last load or parse.
+     *
+     * @return {LoadStats}
+     */
+    const LoadStats &stats() const;
+
+private:
+    LoadStats m_stats;
+
+    std::shared_ptr<BufferGeometry> parse(std::span<const char> data, const MappedFile *source);
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef PLY_LOADER_H
+#define PLY_LOADER_H
+
+#include "core/BufferGeometry.h"
+#include "loaders/LoaderUtils.h"
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+/**
+ * A loader for PLY (Polygon File Format) files, also known as the Stanford
+ * Triangle Format. Supports ASCII and binary (little and big endian) files.
+ *
+ * Vertex properties `x/y/z`, `nx/ny/nz`, `s/t` (or `u/v`, `texture_u/texture_v`)
+ * and `red/green/blue` become the `position`, `normal`, `uv` and `color`
+ * attributes; faces become the index, polygons triangulated as fans. Colors
+ * are converted from sRGB to linear.
+ *
+ * Files are memory-mapped. Binary vertex records are decoded in parallel
+ * straight from the mapped pages into the attribute buffers; ASCII bodies are
+ * split into line-aligned chunks and parsed in parallel with `std::from_chars`.
+ * ```c++
+ * PLYLoader loader;
+ * auto geometry = loader.load("models/ply/binary/Lucy100k.ply");
+ * ```
+ */
+class PLYLoader
+{
+public:
+    PLYLoader();
+    ~PLYLoader();
+
+    /**
+     * Loads the file at `path`. Throws `std::runtime_error` on I/O or format errors.
+     *
+     * @param {std::string} path - The path of the file.
+     * @return {std::shared_ptr<BufferGeometry>} The parsed geometry.
+     */
+    std::shared_ptr<BufferGeometry> load(const std::string &path);
+    /**
+     * Parses the given PLY data.
+     *
+     * @param {std::span<const char>} data - The raw file contents.
+     * @return {std::shared_ptr<BufferGeometry>} The parsed geometry.
+     */
+    std::shared_ptr<BufferGeometry> parse(std::span<const char> data);
+
+    /**
+     * Statistics of the last load or parse.
+     *
+     * @return {LoadStats}
+     */
+    const LoadStats &stats() const;
+
+private:
+    LoadStats m_stats;
+
+    std::shared_ptr<BufferGeometry> parse(std::span<const char> data, const MappedFile *source);
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef STL_LOADER_H
+#define STL_LOADER_H
+
+#include "core/BufferGeometry.h"
+#include "loaders/LoaderUtils.h"
+#include <memory>
+#include <span>
+#include <string>
+
+class MappedFile;
+
+/**
+ * A loader for the STL format, as created by many CAD programs and 3D
+ * scanners. Supports both binary and ASCII encoded files.
+ *
+ * The result is a non-indexed geometry with `position` and per-face `normal`
+ * attributes. Files are memory-mapped; binary triangles are decoded straight
+ * from the mapped pages into the attribute buffers, ASCII files are parsed in
+ * parallel chunks split on line boundaries.
+ * ```c++
+ * STLLoader loader;
+ * auto geometry = loader.load("models/stl/slotted_disk.stl");
+ * ```
+ */
+class STLLoader
+{
+public:
+    STLLoader();
+    ~STLLoader();
+
+    /**
+     * Loads the file at `path`. Throws `std::runtime_error` on I/O or format errors.
+     *
+     * @param {std::string} path - The path of the file.
+     * @return {std::shared_ptr<BufferGeometry>} The parsed geometry.
+     */
+    std::shared_ptr<BufferGeometry> load(const std::string &path);
+    /**
+     * Parses the given STL data.
+     *
+     * @param {std::span<const char>} data - The raw file contents.
+     * @return {std::shared_ptr<BufferGeometry>} The parsed geometry.
+     */
+    std::shared_ptr<BufferGeometry> parse(std::span<const char> data);
+
+    /**
+     * Statistics of the last load or parse.
+     *
+     * @return {LoadStats}
+     */
+    const LoadStats &stats() const;
+
+private:
+    LoadStats m_stats;
+
+    std::shared_ptr<BufferGeometry> parse(std::span<const char> data, const MappedFile *source);
+    std::shared_ptr<BufferGeometry> parseBinary(std::span<const char> data, const MappedFile *source);
+    std::shared_ptr<BufferGeometry> parseASCII(std::span<const char> data, const MappedFile *source);
+};
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef SCENE_SNAPSHOT_H
+#define SCENE_SNAPSHOT_H
+
+#include "animation/AnimationClip.h"
+#include "common/MappedFile.h"
+#include "core/Object3D.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A compact binary snapshot of a scene: the node hierarchy with names,
+ * UUIDs, local and world transforms, geometries (attributes, index, morph
+ * targets), skins, instances and animation clips.
+ *
+ * The format is versioned, little-endian and built from flat record arrays,
+ * each section and each data array aligned to 64 bytes. Opening a snapshot
+ * maps the file once and resolves the section table; every record and array
+ * is then read in place, without parsing or per-object allocation. The
+ * records are exposed directly, so a renderer can draw the first frame from
+ * {@link SceneSnapshot#worldMatrices} and the attribute spans;
+ * {@link SceneSnapshot#instantiate} builds a regular {@link Object3D} graph
+ * when one is needed.
+ *
+ * The header carries a 64-bit hash of the payload for cache invalidation.
+ * Writing an instantiated snapshot again reproduces the same bytes.
+ * ```c++
+ * SceneSnapshot::write("cache/level.t3s", *gltf.scene, gltf.animations);
+ *
+ * SceneSnapshot snapshot("cache/level.t3s");
+ * auto scene = snapshot.instantiate();
+ * auto clips = snapshot.animations();
+ * ```
+ */
+class SceneSnapshot
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t ALIGNMENT = 64;
+    // "none" for record indices
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    enum class NodeType : uint32_t
+    {
+        Object3D,
+        Bone,
+        Mesh,
+        SkinnedMesh,
+        InstancedMesh
+    };
+
+    enum NodeFlags : uint32_t
+    {
+        VISIBLE = 1,
+        MATRIX_AUTO_UPDATE = 2
+    };
+
+    enum class Section : uint32_t
+    {
+        Strings,
+        StringTable,
+        Nodes,
+        Transforms,
+        WorldMatrices,
+        Geometries,
+        Attributes,
+        MorphTargets,
+        Skins,
+        Joints,
+        SkinBindings,
+        Instances,
+        Clips,
+        Channels,
+        Data,
+        Count
+    };
+
+    // Records. Strings are indices into the string table; data fields are
+    // byte offsets into the data section.
+
+    struct String
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    // nodes are stored depth-first, so parents precede their children
+    struct Node
+    {
+        uint32_t parent;
+        NodeType type;
+        uint32_t name;
+        uint32_t uuid;
+        uint32_t geometry;
+        // index of the node's SkinBinding
+        uint32_t skin;
+        uint32_t instances;
+        uint32_t flags;
+        uint32_t morphInfluenceCount;
+        uint32_t reserved;
+        uint64_t morphInfluences;
+    };
+
+    struct Transform
+    {
+        float position[3];
+        float quaternion[4];
+        float scale[3];
+    };
+
+    struct Geometry
+    {
+        uint32_t firstAttribute;
+        uint32_t attributeCount;
+        uint32_t firstMorphTarget;
+        uint32_t morphTargetCount;
+        uint64_t index;
+        uint64_t indexCount;
+    };
+
+    struct Attribute
+    {
+        uint32_t name;
+        uint32_t itemSize;
+        uint32_t normalized;
+        uint32_t reserved;
+        uint64_t count;
+        uint64_t data;
+    };
+
+    struct MorphTarget
+    {
+        uint32_t name;
+        uint32_t hasNormals;
+        uint64_t count;
+        uint64_t indices;
+        uint64_t positionDeltas;
+        uint64_t normalDeltas;
+    };
+
+    struct Skin
+    {
+        uint32_t firstJoint;
+        uint32_t jointCount;
+        // jointCount matrices
+        uint64_t boneInverses;
+    };
+
+    struct SkinBinding
+    {
+        uint32_t skin;
+        uint32_t reserved;
+        uint64_t bindMatrix;
+    };
+
+    struct Instances
+    {
+        uint64_t count;
+        uint64_t matrices;
+        // 0 if the mesh has no instance colors
+        uint64_t colors;
+    };
+
+    struct Clip
+    {
+        uint32_t name;
+        uint32_t uuid;
+        float duration;
+        uint32_t firstChannel;
+        uint32_t channelCount;
+        uint32_t reserved;
+        uint64_t times;
+        uint64_t timeCount;
+        uint64_t values;
+        uint64_t valueCount;
+    };
+
+    // same layout as AnimationClip::Channel plus the track name
+    struct Channel
+    {
+        uint32_t name;
+        uint32_t timeOffset;
+        uint32_t keyCount;
+        uint32_t valueOffset;
+        uint32_t valueSize;
+        uint32_t interpolation;
+        uint32_t type;
+        uint32_t reserved;
+    };
+
+    /**
+     * Serializes `root`, its descendants and `animations`. Compressed clips
+     * are rejected with `std::invalid_argument`.
+     *
+     * @param {Object3D} root - The root of the scene.
+     * @param {std::vector<std::shared_ptr<AnimationClip>>} [animations] - The clips to store.
+     * @return {std::vector<char>} The snapshot bytes.
+     */
+    static std::vector<char> serialize(const Object3D &root, const std::vector<std::shared_ptr<AnimationClip>> &animations = {});
+    /**
+     * Serializes a scene into the file at `path`.
+     *
+     * @param {std::string} path - The output path.
+     * @param {Object3D} root - The root of the scene.
+     * @param {std::vector<std::shared_ptr<AnimationClip>>} [animations] - The clips to store.
+     */
+    static void write(const std::string &path, const Object3D &root, const std::vector<std::shared_ptr<AnimationClip>> &animations = {});
+    /**
+     * The 64-bit content hash used by the format.
+     *
+     * @param {std::span<const char>} bytes - The bytes to hash.
+     * @return {uint64_t}
+     */
+    static uint64_t hash(std::span<const char> bytes);
+
+    /**
+     * Maps and opens the snapshot at `path`. Throws `std::runtime_error` if
+     * the file is not a snapshot of this version.
+     *
+     * @param {std::string} path - The snapshot file.
+     */
+    explicit SceneSnapshot(const std::string &path);
+    ~SceneSnapshot();
+
+    /**
+     * Opens a snapshot held in memory. The bytes must outlive the returned
+     * object and be 8-byte aligned.
+     *
+     * @param {std::span<const char>} bytes - The snapshot bytes.
+     * @return {SceneSnapshot}
+     */
+    static SceneSnapshot fromBytes(std::span<const char> bytes);
+
+    SceneSnapshot(SceneSnapshot &&other) noexcept = default;
+    SceneSnapshot &operator=(SceneSnapshot &&other) noexcept = default;
+
+    uint32_t version() const;
+    uint64_t contentHash() const;
+    /**
+     * Recomputes the payload hash and compares it to the stored one.
+     *
+     * @return {bool} Whether the snapshot is intact.
+     */
+    bool verify() const;
+
+    std::string_view string(uint32_t index) const;
+    std::span<const Node> nodes() const;
+    std::span<const Transform> transforms() const;
+    /**
+     * The world matrix of every node at the time of writing, 16 column-major
+     * floats per node.
+     *
+     * @return {std::span<const float>}
+     */
+    std::span<const float> worldMatrices() const;
+    std::span<const Geometry> geometries() const;
+    std::span<const Attribute> attributes(const Geometry &geometry) const;
+    std::span<const MorphTarget> morphTargets(const Geometry &geometry) const;
+    std::span<const Skin> skins() const;
+    std::span<const uint32_t> joints(const Skin &skin) const;
+    std::span<const SkinBinding> skinBindings() const;
+    std::span<const Instances> instances() const;
+    std::span<const Clip> clips() const;
+    std::span<const Channel> channels(const Clip &clip) const;
+
+    /**
+     * A typed array of the data section.
+     *
+     * @param {uint64_t} offset - Byte offset inside the data section.
+     * @param {size_t} count - Number of elements.
+     * @return {std::span<const T>}
+     */
+    template <typename T>
+    std::span<const T> data(uint64_t offset, size_t count) const
+    {
+        checkData(offset, count * sizeof(T), alignof(T));
+        return {reinterpret_cast<const T *>(m_data.data() + offset), count};
+    }
+
+    /**
+     * Builds the object graph. Node 0 is the returned root.
+     *
+     * @return {std::shared_ptr<Object3D>}
+     */
+    std::shared_ptr<Object3D> instantiate() const;
+    /**
+     * Builds the stored animation clips.
+     *
+     * @return {std::vector<std::shared_ptr<AnimationClip>>}
+     */
+    std::vector<std::shared_ptr<AnimationClip>> animations() const;
+
+private:
+    SceneSnapshot() = default;
+
+    MappedFile m_file;
+    std::span<const char> m_bytes;
+    uint32_t m_version = 0;
+    uint64_t m_contentHash = 0;
+    // the resolved sections
+    std::span<const char> m_sections[static_cast<size_t>(Section::Count)];
+    std::span<const char> m_data;
+
+    void open();
+    void checkData(uint64_t offset, size_t bytes, size_t alignment) const;
+
+    template <typename T>
+    std::span<const T> section(Section section) const
+    {
+        const auto bytes = m_sections[static_cast<size_t>(section)];
+        return {reinterpret_cast<const T *>(bytes.data()), bytes.size() / sizeof(T)};
+    }
+};
+
+#endif
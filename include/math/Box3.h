@@ -0,0 +1,84 @@
+#ifndef BOX3_H
+#define BOX3_H
+
+#include "math/Vector3.h"
+#include <span>
+#include <vector>
+
+class Matrix4;
+class Sphere;
+class Plane;
+class BufferAttribute;
+
+/**
+ * Represents an axis-aligned bounding box (AABB) in 3D space.
+ * ```c++
+ * Box3 box;
+ * box.setFromBufferAttribute(*geometry->getAttribute("position"));
+ * ```
+ */
+class Box3
+{
+public:
+    /**
+     * Constructs a new bounding box. The default box is empty.
+     *
+     * @param {Vector3} [min=(Infinity,Infinity,Infinity)] - A vector representing the lower boundary of the box.
+     * @param {Vector3} [max=(-Infinity,-Infinity,-Infinity)] - A vector representing the upper boundary of the box.
+     */
+    Box3();
+    Box3(const Vector3 &min, const Vector3 &max);
+    ~Box3();
+
+    Vector3 &min();
+    const Vector3 &min() const;
+    Vector3 &max();
+    const Vector3 &max() const;
+
+    void set(const Vector3 &min, const Vector3 &max);
+    /**
+     * Sets the box to enclose the `itemSize`-strided points of a flat array.
+     * Only the first three components of each item are used.
+     *
+     * @param {std::span<const float>} array - The point data.
+     * @param {size_t} [itemSize=3] - The stride between points.
+     */
+    void setFromArray(std::span<const float> array, size_t itemSize = 3);
+    void setFromBufferAttribute(const BufferAttribute &attribute);
+    void setFromPoints(const std::vector<Vector3> &points);
+    void setFromCenterAndSize(const Vector3 &center, const Vector3 &size);
+    Box3 clone() const;
+    void copy(const Box3 &box);
+    void makeEmpty();
+    bool isEmpty() const;
+    void getCenter(Vector3 &target) const;
+    void getSize(Vector3 &target) const;
+    void expandByPoint(const Vector3 &point);
+    void expandByVector(const Vector3 &vector);
+    void expandByScalar(HIGH_PRECISION scalar);
+    bool containsPoint(const Vector3 &point) const;
+    bool containsBox(const Box3 &box) const;
+    bool intersectsBox(const Box3 &box) const;
+    bool intersectsSphere(const Sphere &sphere) const;
+    bool intersectsPlane(const Plane &plane) const;
+    void clampPoint(const Vector3 &point, Vector3 &target) const;
+    HIGH_PRECISION distanceToPoint(const Vector3 &point) const;
+    void getBoundingSphere(Sphere &target) const;
+    void intersect(const Box3 &box);
+    void unionBox(const Box3 &box);
+    /**
+     * Transforms this box with the given matrix; the result is the box
+     * enclosing the eight transformed corners.
+     *
+     * @param {Matrix4} matrix - The transformation matrix.
+     */
+    void applyMatrix4(const Matrix4 &matrix);
+    void translate(const Vector3 &offset);
+    bool equals(const Box3 &box) const;
+
+private:
+    Vector3 m_min;
+    Vector3 m_max;
+};
+
+#endif
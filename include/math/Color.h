@@ -0,0 +1,188 @@
+#ifndef COLOR_H
+#define COLOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+/**
+ * The color space a color's components are expressed in. Colors are stored
+ * in the linear working color space; sRGB is used for hex values and
+ * 8-bit images.
+ */
+enum class ColorSpace
+{
+    LinearSRGB,
+    SRGB
+};
+
+/**
+ * Class representing a color in the linear-sRGB working color space.
+ *
+ * Conversions between sRGB and linear use a polynomial `pow` that matches
+ * `std::pow` to within a few float ulps, and have batch versions for whole
+ * vertex-color and image buffers that run four values at a time with SSE.
+ * ```c++
+ * Color color(0xff8800);       // sRGB hex, stored linear
+ * color.setHSL(0.5f, 1, 0.5f);
+ * Color::SRGBToLinear(srgbColors, linearColors);
+ * ```
+ */
+class Color
+{
+public:
+    /**
+     * The components of a color in HSL, each in `[0, 1]`.
+     */
+    struct HSL
+    {
+        float h = 0;
+        float s = 0;
+        float l = 0;
+    };
+
+    /**
+     * Constructs a new color, white by default.
+     *
+     * @param {float} r - The red component, linear.
+     * @param {float} g - The green component, linear.
+     * @param {float} b - The blue component, linear.
+     */
+    Color();
+    Color(float r, float g, float b);
+    /**
+     * Constructs a color from an sRGB hexadecimal value such as `0xff0000`.
+     *
+     * @param {uint32_t} hex - The hexadecimal value.
+     */
+    explicit Color(uint32_t hex);
+    ~Color();
+
+    float r = 1;
+    float g = 1;
+    float b = 1;
+
+    Color &setScalar(float scalar);
+    /**
+     * Sets this color from a hexadecimal value.
+     *
+     * @param {uint32_t} hex - The hexadecimal value.
+     * @param {ColorSpace} [colorSpace=ColorSpace::SRGB] - The color space of `hex`.
+     * @return {Color} A reference to this color.
+     */
+    Color &setHex(uint32_t hex, ColorSpace colorSpace = ColorSpace::SRGB);
+    /**
+     * Sets this color from RGB values.
+     *
+     * @param {float} r - Red channel value between `0` and `1`.
+     * @param {float} g - Green channel value between `0` and `1`.
+     * @param {float} b - Blue channel value between `0` and `1`.
+     * @param {ColorSpace} [colorSpace=ColorSpace::LinearSRGB] - The color space of the values.
+     * @return {Color} A reference to this color.
+     */
+    Color &setRGB(float r, float g, float b, ColorSpace colorSpace = ColorSpace::LinearSRGB);
+    /**
+     * Sets this color from HSL values.
+     *
+     * @param {float} h - Hue value between `0` and `1`, wrapped.
+     * @param {float} s - Saturation value between `0` and `1`.
+     * @param {float} l - Lightness value between `0` and `1`.
+     * @param {ColorSpace} [colorSpace=ColorSpace::LinearSRGB] - The color space of the values.
+     * @return {Color} A reference to this color.
+     */
+    Color &setHSL(float h, float s, float l, ColorSpace colorSpace = ColorSpace::LinearSRGB);
+
+    Color clone() const;
+    Color &copy(const Color &color);
+    Color &copySRGBToLinear(const Color &color);
+    Color &copyLinearToSRGB(const Color &color);
+    Color &convertSRGBToLinear();
+    Color &convertLinearToSRGB();
+
+    /**
+     * Returns the hexadecimal value of this color, components clamped to
+     * `[0, 1]` and rounded.
+     *
+     * @param {ColorSpace} [colorSpace=ColorSpace::SRGB] - The color space of the result.
+     * @return {uint32_t}
+     */
+    uint32_t getHex(ColorSpace colorSpace = ColorSpace::SRGB) const;
+    /**
+     * Returns the hexadecimal value of this color as a six digit lowercase
+     * string without prefix, e.g. `"ff0000"`.
+     *
+     * @param {ColorSpace} [colorSpace=ColorSpace::SRGB] - The color space of the result.
+     * @return {std::string}
+     */
+    std::string getHexString(ColorSpace colorSpace = ColorSpace::SRGB) const;
+    HSL getHSL(ColorSpace colorSpace = ColorSpace::LinearSRGB) const;
+    Color getRGB(ColorSpace colorSpace = ColorSpace::LinearSRGB) const;
+
+    Color &offsetHSL(float h, float s, float l);
+    Color &add(const Color &color);
+    Color &addColors(const Color &color1, const Color &color2);
+    Color &addScalar(float s);
+    Color &sub(const Color &color);
+    Color &multiply(const Color &color);
+    Color &multiplyScalar(float s);
+    /**
+     * Linearly interpolates this color's RGB values toward the given color.
+     *
+     * @param {Color} color - The color to converge on.
+     * @param {float} alpha - The interpolation factor in the closed interval `[0,1]`.
+     * @return {Color} A reference to this color.
+     */
+    Color &lerp(const Color &color, float alpha);
+    Color &lerpColors(const Color &color1, const Color &color2, float alpha);
+    /**
+     * Linearly interpolates this color's HSL values toward the given color.
+     * The hue takes the direct path, not the shortest one around the wheel.
+     *
+     * @param {Color} color - The color to converge on.
+     * @param {float} alpha - The interpolation factor in the closed interval `[0,1]`.
+     * @return {Color} A reference to this color.
+     */
+    Color &lerpHSL(const Color &color, float alpha);
+    bool equals(const Color &color) const;
+
+    Color &fromArray(const float *array, size_t offset = 0);
+    void toArray(float *array, size_t offset = 0) const;
+
+    /**
+     * Converts one component from sRGB to linear.
+     *
+     * @param {float} c - The sRGB value.
+     * @return {float}
+     */
+    static float SRGBToLinear(float c);
+    static float LinearToSRGB(float c);
+
+    /**
+     * Converts every value of `values` from sRGB to linear, e.g. a vertex
+     * color attribute or a float image. `result` may alias `values`. Large
+     * buffers are split across threads.
+     *
+     * @param {std::span<const float>} values - The sRGB values.
+     * @param {std::span<float>} result - Receives the linear values.
+     */
+    static void SRGBToLinear(std::span<const float> values, std::span<float> result);
+    static void LinearToSRGB(std::span<const float> values, std::span<float> result);
+    /**
+     * Converts 8-bit sRGB values, e.g. texels, to linear floats through a
+     * lookup table.
+     *
+     * @param {std::span<const uint8_t>} values - The sRGB values.
+     * @param {std::span<float>} result - Receives the linear values.
+     */
+    static void SRGB8ToLinear(std::span<const uint8_t> values, std::span<float> result);
+    /**
+     * Converts linear floats to 8-bit sRGB, clamped and rounded.
+     *
+     * @param {std::span<const float>} values - The linear values.
+     * @param {std::span<uint8_t>} result - Receives the sRGB values.
+     */
+    static void LinearToSRGB8(std::span<const float> values, std::span<uint8_t> result);
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef FLOATING_ORIGIN_H
+#define FLOATING_ORIGIN_H
+
+#include "math/Matrix4.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * Camera-relative rendering for scenes larger than float precision allows.
+ *
+ * A float resolves about half a millimetre at 10 km and half a metre at
+ * the radius of the earth, so float world coordinates jitter when the
+ * camera is far from `0`. Instead of raising the precision of every
+ * {@link Vector3}, world transforms are kept in `double` by whoever owns
+ * them and rebased: the origin is subtracted in `double` and only the small
+ * difference is converted to float, right before culling and projection.
+ * {@link FloatingOrigin#update} moves the origin along with the camera.
+ *
+ * For vertex data that stays on the GPU, {@link FloatingOrigin::split}
+ * stores each `double` as two floats, `high + low`. A shader, or
+ * {@link FloatingOrigin#rebaseSplitPositions} on the CPU, then computes
+ * `(high - originHigh) + (low - originLow)` in float without the error of
+ * the large values.
+ * ```c++
+ * FloatingOrigin origin;
+ * origin.update({cameraWorld[12], cameraWorld[13], cameraWorld[14]});
+ * Matrix4 viewProjection;
+ * viewProjection.multiplyMatrices(projection, origin.viewMatrix(cameraWorld));
+ * frustum.setFromProjectionMatrix(viewProjection);
+ * origin.rebaseSpheres(worldSpheres, relativeSpheres);
+ * origin.rebaseMatrices(worldMatrices, relativeMatrices);
+ * ```
+ */
+class FloatingOrigin
+{
+public:
+    /**
+     * @param {double} [threshold=4096] - Distance from the origin at which {@link FloatingOrigin#update} recenters.
+     */
+    explicit FloatingOrigin(double threshold = 4096.0);
+
+    const std::array<double, 3> &origin() const;
+    /**
+     * Moves the origin and starts a new version, so rebased data cached by
+     * the caller must be rebuilt.
+     *
+     * @param {std::array<double,3>} origin - The new origin in world space.
+     */
+    void setOrigin(const std::array<double, 3> &origin);
+    /**
+     * Recenters when `position` moved farther than the threshold from the
+     * origin along any axis. The new origin is `position` snapped to a grid
+     * of the threshold, so it does not depend on the path of the camera.
+     *
+     * @param {std::array<double,3>} position - Usually the camera position.
+     * @return {bool} Whether the origin moved.
+     */
+    bool update(const std::array<double, 3> &position);
+    double threshold() const;
+    void setThreshold(double threshold);
+    /**
+     * Incremented by every origin change.
+     *
+     * @return {uint32_t}
+     */
+    uint32_t version() const;
+
+    /**
+     * `world` with the origin subtracted from its translation.
+     *
+     * @param {std::span<const double,16>} world - A column-major world matrix.
+     * @return {Matrix4}
+     */
+    Matrix4 rebase(std::span<const double, 16> world) const;
+    /**
+     * The view matrix of a camera, relative to the origin.
+     *
+     * @param {std::span<const double,16>} cameraWorld - The world matrix of the camera.
+     * @return {Matrix4}
+     */
+    Matrix4 viewMatrix(std::span<const double, 16> cameraWorld) const;
+
+    /**
+     * Rebases column-major world matrices, `16` values each, to float. Large
+     * batches are split across threads.
+     *
+     * @param {std::span<const double>} world - The world matrices.
+     * @param {std::span<float>} result - Receives as many values as `world` has.
+     */
+    void rebaseMatrices(std::span<const double> world, std::span<float> result) const;
+    /**
+     * Rebases `xyz` positions to float.
+     *
+     * @param {std::span<const double>} positions - Three values per position.
+     * @param {std::span<float>} result - Receives as many values as `positions` has.
+     */
+    void rebasePositions(std::span<const double> positions, std::span<float> result) const;
+    /**
+     * Rebases bounding spheres stored as `(x, y, z, radius)`, the layout of
+     * {@link Frustum#intersectsSpheres}.
+     *
+     * @param {std::span<const double>} spheres - Four values per sphere.
+     * @param {std::span<float>} result - Receives as many values as `spheres` has.
+     */
+    void rebaseSpheres(std::span<const double> spheres, std::span<float> result) const;
+    /**
+     * Rebases `xyz` positions in split form, see {@link FloatingOrigin::split},
+     * with float arithmetic only, as a vertex shader would.
+     *
+     * @param {std::span<const float>} high - The high parts.
+     * @param {std::span<const float>} low - The low parts.
+     * @param {std::span<float>} result - Receives as many values as `high` has.
+     */
+    void rebaseSplitPositions(std::span<const float> high, std::span<const float> low, std::span<float> result) const;
+    /**
+     * The origin in split form, the uniforms of a relative-to-eye shader.
+     *
+     * @param {float*} high - Receives three values.
+     * @param {float*} low - Receives three values.
+     */
+    void splitOrigin(float *high, float *low) const;
+
+    /**
+     * Splits every value into the float nearest to it and the float nearest
+     * to the remainder, which together keep about 48 bits of mantissa.
+     *
+     * @param {std::span<const double>} values - The values, e.g. `xyz` positions.
+     * @param {std::span<float>} high - Receives the high parts.
+     * @param {std::span<float>} low - Receives the low parts.
+     */
+    static void split(std::span<const double> values, std::span<float> high, std::span<float> low);
+
+private:
+    std::array<double, 3> m_origin{0, 0, 0};
+    // m_origin in split form
+    std::array<float, 3> m_originHigh{0, 0, 0};
+    std::array<float, 3> m_originLow{0, 0, 0};
+    double m_threshold;
+    uint32_t m_version = 0;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "math/Plane.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class Matrix4;
+class Sphere;
+class Box3;
+
+/**
+ * Frustums are used to determine what is inside the camera's field of view.
+ * They help speed up the rendering process - objects which lie outside a
+ * camera's frustum can safely be excluded from rendering.
+ *
+ * Besides the per-object tests, {@link Frustum#intersectsSpheres} tests
+ * packed bounding spheres in bulk and compacts the survivors into an index
+ * list, for instanced and clustered geometry.
+ */
+class Frustum
+{
+public:
+    Frustum();
+    Frustum(const Plane &p0, const Plane &p1, const Plane &p2, const Plane &p3, const Plane &p4, const Plane &p5);
+    ~Frustum();
+
+    const std::array<Plane, 6> &planes() const;
+
+    void set(const Plane &p0, const Plane &p1, const Plane &p2, const Plane &p3, const Plane &p4, const Plane &p5);
+    void copy(const Frustum &frustum);
+    /**
+     * Sets the frustum planes from the given projection matrix (WebGL clip
+     * space). Multiplying in a model matrix moves the frustum into that
+     * model's local space.
+     *
+     * @param {Matrix4} m - The projection matrix.
+     */
+    void setFromProjectionMatrix(const Matrix4 &m);
+    bool intersectsSphere(const Sphere &sphere) const;
+    bool intersectsBox(const Box3 &box) const;
+    bool containsPoint(const Vector3 &point) const;
+
+    /**
+     * Tests `count` spheres stored as `(x, y, z, radius)` against the frustum
+     * and writes `indexOffset + i` for every sphere `i` that intersects it,
+     * in order. Uses SSE when available.
+     *
+     * @param {const float*} spheres - `4 * count` floats.
+     * @param {size_t} count - The number of spheres.
+     * @param {uint32_t*} visible - Receives up to `count` indices.
+     * @param {uint32_t} [indexOffset=0] - Added to every written index.
+     * @return {size_t} The number of indices written.
+     */
+    size_t intersectsSpheres(const float *spheres, size_t count, uint32_t *visible, uint32_t indexOffset = 0) const;
+
+private:
+    std::array<Plane, 6> m_planes;
+
+    // float copy of the planes as (nx, ny, nz, constant) for the batch test
+    float m_packed[6][4];
+
+    void pack();
+};
+
+#endif
@@ -3,9 +3,11 @@
 
 #include "common/BasicType.h"
 #include <algorithm>
+#include <memory_resource>
 #include <span>
 #include <vector>
 #include <ranges>
+#include <concepts>
 
 namespace MathUtils
 {
@@ -32,6 +34,31 @@ namespace MathUtils
     // function setQuaternionFromProperEuler( q, a, b, c, order )
     std::vector<HIGH_PRECISION> convertSpanToVector(const std::span<const HIGH_PRECISION, 9> &src_span);
     std::vector<HIGH_PRECISION> convertSpanToVector(const std::span<const HIGH_PRECISION, 16> &src_span);
+    // same, allocating from `resource`, e.g. a FrameArena for per-frame temporaries
+    std::pmr::vector<HIGH_PRECISION> convertSpanToVector(const std::span<const HIGH_PRECISION, 9> &src_span, std::pmr::memory_resource *resource);
+    std::pmr::vector<HIGH_PRECISION> convertSpanToVector(const std::span<const HIGH_PRECISION, 16> &src_span, std::pmr::memory_resource *resource);
+
+    // Inline overloads for hot loops working on float/double buffers (animation
+    // sampling, blending). Calls with HIGH_PRECISION arguments still resolve to
+    // the out-of-line versions above.
+    template <std::floating_point T>
+    inline T lerp(T x, T y, T t)
+    {
+        return (1 - t) * x + t * y;
+    }
+
+    template <std::floating_point T>
+    inline T smoothstep(T x, T min, T max)
+    {
+        if (x <= min)
+            return 0;
+        if (x >= max)
+            return 1;
+
+        x = (x - min) / (max - min);
+
+        return x * x * (3 - 2 * x);
+    }
     
     template <typename T>
     HIGH_PRECISION denormalize(HIGH_PRECISION value)
@@ -57,15 +84,15 @@ namespace MathUtils
         {
             if constexpr (std::is_same_v<T, int32_t>)
             {
-                return std::max(value / 2147483647.0, (HIGH_PRECISION)-1.0);
+                return std::max<HIGH_PRECISION>(value / 2147483647.0, -1.0);
             }
             else if constexpr (std::is_same_v<T, int16_t>)
             {
-                return std::max(value / 32767.0, (HIGH_PRECISION)-1.0);
+                return std::max<HIGH_PRECISION>(value / 32767.0, -1.0);
             }
             else if constexpr (std::is_same_v<T, int8_t>)
             {
-                return std::max(value / 127.0, (HIGH_PRECISION)-1.0);
+                return std::max<HIGH_PRECISION>(value / 127.0, -1.0);
             }
         }
         //
@@ -13,6 +13,7 @@ public:
         HIGH_PRECISION n11 = 1.0, HIGH_PRECISION n12 = 0.0, HIGH_PRECISION n13 = 0.0, 
         HIGH_PRECISION n21 = 0.0, HIGH_PRECISION n22 = 1.0, HIGH_PRECISION n23 = 0.0, 
         HIGH_PRECISION n31 = 0.0, HIGH_PRECISION n32 = 0.0, HIGH_PRECISION n33 = 1.0);
+    Matrix3(const Matrix3 &) = default;
     ~Matrix3();
     std::span<const HIGH_PRECISION, 9> elements() const;
     void set(
@@ -3,9 +3,11 @@
 
 #include "common/BasicType.h"
 #include <span>
+#include <vector>
 
 class Vector3;
 class Matrix3;
+class Quaternion;
 
 class Matrix4
 {
@@ -31,7 +33,7 @@ public:
     void makeBasis(const Vector3 &xAxis, const Vector3 &yAxis, const Vector3 &zAxis);
     void extractRotation(const Matrix4 &m);
     // makeRotationFromEuler( euler )
-    // makeRotationFromQuaternion( q )
+    void makeRotationFromQuaternion(const Quaternion &q);
     void lookAt(Vector3 &eye, Vector3 &target, Vector3 &up);
     void multiply(const Matrix4 &m);
     void premultiply(const Matrix4 &m);
@@ -43,7 +45,7 @@ public:
     void setPosition(const Vector3 &v);
     void invert();
     void scale(const Vector3 &v);
-    HIGH_PRECISION getMaxScaleOnAxis();
+    HIGH_PRECISION getMaxScaleOnAxis() const;
     void makeTranslation(HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z);
     void makeTranslation(const Vector3 &v);
     void makeRotationX(float theta);
@@ -52,7 +54,38 @@ public:
     void makeRotationAxis(const Vector3 &axis, float angle);
     void makeScale(HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z);
     void makeShear(HIGH_PRECISION xy, HIGH_PRECISION xz, HIGH_PRECISION yx, HIGH_PRECISION yz, HIGH_PRECISION zx, HIGH_PRECISION zy);
-    // void Matrix4::compose( position, quaternion, scale ) 
+    /**
+     * Sets this matrix to a perspective projection of the given frustum
+     * (OpenGL clip space, `z` in `[-1, 1]`).
+     */
+    void makePerspective(HIGH_PRECISION left, HIGH_PRECISION right, HIGH_PRECISION top, HIGH_PRECISION bottom, HIGH_PRECISION near, HIGH_PRECISION far);
+    /**
+     * Sets this matrix to an orthographic projection of the given box
+     * (OpenGL clip space, `z` in `[-1, 1]`).
+     */
+    void makeOrthographic(HIGH_PRECISION left, HIGH_PRECISION right, HIGH_PRECISION top, HIGH_PRECISION bottom, HIGH_PRECISION near, HIGH_PRECISION far);
+    void compose(const Vector3 &position, const Quaternion &quaternion, const Vector3 &scale);
+    void decompose(Vector3 &position, Quaternion &quaternion, Vector3 &scale) const;
+    bool equals(const Matrix4 &matrix, float epsilon = 1e-6) const;
+    void fromArray(const std::vector<HIGH_PRECISION> &array, size_t offset = 0);
+    void fromArray(const float *array, size_t offset = 0);
+    void fromArray(const double *array, size_t offset = 0);
+    void toArray(std::vector<HIGH_PRECISION> &array, size_t offset = 0) const;
+    void toArray(float *array, size_t offset = 0) const;
+    void toArray(double *array, size_t offset = 0) const;
+
+    /**
+     * Multiplies `count` pairs of column-major 4x4 matrices stored back to back
+     * in flat float arrays: `out[i] = a[i] * b[i]`. Used by the batched kernels
+     * (bone palettes, instance transforms) that keep their matrices in
+     * contiguous buffers instead of `Matrix4` objects.
+     *
+     * @param {float*} out - Destination array of `16 * count` floats. May not alias `a` or `b`.
+     * @param {const float*} a - Left-hand matrices.
+     * @param {const float*} b - Right-hand matrices.
+     * @param {size_t} count - Number of matrices.
+     */
+    static void multiplyMatricesArray(float *out, const float *a, const float *b, size_t count);
 
 private:
     bool m_isMatrix4 = false;
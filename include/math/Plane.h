@@ -0,0 +1,53 @@
+#ifndef PLANE_H
+#define PLANE_H
+
+#include "math/Vector3.h"
+
+class Sphere;
+class Box3;
+
+/**
+ * A two dimensional surface that extends infinitely in 3D space, represented
+ * in Hessian normal form by a unit length normal vector and a constant.
+ */
+class Plane
+{
+public:
+    /**
+     * Constructs a new plane.
+     *
+     * @param {Vector3} [normal=(1,0,0)] - A unit length vector defining the normal of the plane.
+     * @param {HIGH_PRECISION} [constant=0] - The signed distance from the origin to the plane.
+     */
+    Plane(const Vector3 &normal = Vector3(1, 0, 0), HIGH_PRECISION constant = 0);
+    ~Plane();
+
+    Vector3 &normal();
+    const Vector3 &normal() const;
+    HIGH_PRECISION constant;
+
+    void set(const Vector3 &normal, HIGH_PRECISION constant);
+    void setComponents(HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z, HIGH_PRECISION w);
+    void setFromNormalAndCoplanarPoint(const Vector3 &normal, const Vector3 &point);
+    void setFromCoplanarPoints(const Vector3 &a, const Vector3 &b, const Vector3 &c);
+    Plane clone() const;
+    void copy(const Plane &plane);
+    /**
+     * Normalizes the plane normal and adjusts the constant accordingly.
+     */
+    void normalize();
+    void negate();
+    HIGH_PRECISION distanceToPoint(const Vector3 &point) const;
+    HIGH_PRECISION distanceToSphere(const Sphere &sphere) const;
+    void projectPoint(const Vector3 &point, Vector3 &target) const;
+    bool intersectsBox(const Box3 &box) const;
+    bool intersectsSphere(const Sphere &sphere) const;
+    void coplanarPoint(Vector3 &target) const;
+    void translate(const Vector3 &offset);
+    bool equals(const Plane &plane) const;
+
+private:
+    Vector3 m_normal;
+};
+
+#endif
@@ -0,0 +1,319 @@
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include "common/BasicType.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+class Vector3;
+class Matrix4;
+
+/**
+ * Class for representing a Quaternion. Quaternions are used in three.cpp to
+ * represent rotations.
+ *
+ * Iterating through a quaternion instance will yield its components `(x, y, z, w)`
+ * in the corresponding order.
+ * ```c++
+ * Quaternion quaternion;
+ * quaternion.setFromAxisAngle(Vector3(1, 0, 0), MATH_PI / 2);
+ *
+ * Vector3 vector(1, 0, 0);
+ * vector.applyQuaternion(quaternion);
+ * ```
+ */
+class Quaternion
+{
+public:
+    /**
+     * Constructs a new quaternion.
+     *
+     * @param {HIGH_PRECISION} [x=0] - The x value of this quaternion.
+     * @param {HIGH_PRECISION} [y=0] - The y value of this quaternion.
+     * @param {HIGH_PRECISION} [z=0] - The z value of this quaternion.
+     * @param {HIGH_PRECISION} [w=1] - The w value of this quaternion.
+     */
+    Quaternion(HIGH_PRECISION x = 0.0, HIGH_PRECISION y = 0.0, HIGH_PRECISION z = 0.0, HIGH_PRECISION w = 1.0);
+    ~Quaternion();
+
+    /**
+     * Interpolates between two quaternions stored in flat arrays. The arrays
+     * can be of any floating point type, which makes this the entry point for
+     * animation buffers that keep their keyframes in `float`.
+     *
+     * @param {T*} dst - The destination array.
+     * @param {size_t} dstOffset - An offset into the destination array.
+     * @param {const T*} src0 - The source array of the first quaternion.
+     * @param {size_t} srcOffset0 - An offset into the first source array.
+     * @param {const T*} src1 - The source array of the second quaternion.
+     * @param {size_t} srcOffset1 - An offset into the second source array.
+     * @param {T} t - The interpolation factor in the range `[0,1]`.
+     */
+    template <typename T>
+    static void slerpFlat(T *dst, size_t dstOffset, const T *src0, size_t srcOffset0, const T *src1, size_t srcOffset1, T t);
+
+    /**
+     * Multiplies two quaternions stored in flat arrays.
+     *
+     * @param {T*} dst - The destination array.
+     * @param {size_t} dstOffset - An offset into the destination array.
+     * @param {const T*} src0 - The source array of the first quaternion.
+     * @param {size_t} srcOffset0 - An offset into the first source array.
+     * @param {const T*} src1 - The source array of the second quaternion.
+     * @param {size_t} srcOffset1 - An offset into the second source array.
+     */
+    template <typename T>
+    static void multiplyQuaternionsFlat(T *dst, size_t dstOffset, const T *src0, size_t srcOffset0, const T *src1, size_t srcOffset1);
+
+    HIGH_PRECISION x() const;
+    HIGH_PRECISION y() const;
+    HIGH_PRECISION z() const;
+    HIGH_PRECISION w() const;
+
+    /**
+     * Sets the quaternion components.
+     *
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &set(HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z, HIGH_PRECISION w);
+    /**
+     * Sets this quaternion to the identity rotation.
+     *
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &identity();
+    /**
+     * Returns a new quaternion with copied values from this instance.
+     *
+     * @return {Quaternion} A clone of this instance.
+     */
+    Quaternion clone() const;
+    /**
+     * Copies the values of the given quaternion to this instance.
+     *
+     * @param {Quaternion} quaternion - The quaternion to copy.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &copy(const Quaternion &quaternion);
+    /**
+     * Sets this quaternion from the given axis and angle.
+     *
+     * @param {Vector3} axis - The normalized axis.
+     * @param {HIGH_PRECISION} angle - The angle in radians.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &setFromAxisAngle(const Vector3 &axis, HIGH_PRECISION angle);
+    /**
+     * Sets this quaternion from the given rotation matrix. The upper 3x3 of
+     * the matrix is assumed to be a pure (unscaled) rotation matrix.
+     *
+     * @param {Matrix4} m - A 4x4 matrix of which the upper 3x3 of matrix is a pure rotation matrix.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &setFromRotationMatrix(const Matrix4 &m);
+    /**
+     * Sets this quaternion to the rotation required to rotate the direction
+     * vector `vFrom` to the direction vector `vTo`.
+     *
+     * @param {Vector3} vFrom - The first (normalized) direction vector.
+     * @param {Vector3} vTo - The second (normalized) direction vector.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &setFromUnitVectors(const Vector3 &vFrom, const Vector3 &vTo);
+    /**
+     * Returns the angle between this quaternion and the given one in radians.
+     *
+     * @param {Quaternion} q - The quaternion to compute the angle with.
+     * @return {HIGH_PRECISION} The angle in radians.
+     */
+    HIGH_PRECISION angleTo(const Quaternion &q) const;
+    /**
+     * Rotates this quaternion by a given angular step to the given quaternion.
+     *
+     * @param {Quaternion} q - The target quaternion.
+     * @param {HIGH_PRECISION} step - The angular step in radians.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &rotateTowards(const Quaternion &q, HIGH_PRECISION step);
+    /**
+     * Inverts this quaternion via {@link Quaternion#conjugate}. The
+     * quaternion is assumed to have unit length.
+     *
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &invert();
+    /**
+     * Returns the rotational conjugate of this quaternion.
+     *
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &conjugate();
+    HIGH_PRECISION dot(const Quaternion &v) const;
+    HIGH_PRECISION lengthSq() const;
+    HIGH_PRECISION length() const;
+    /**
+     * Normalizes this quaternion - that is, calculated the quaternion that performs
+     * the same rotation as this one, but has a length equal to `1`.
+     *
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &normalize();
+    /**
+     * Multiplies this quaternion by the given one.
+     *
+     * @param {Quaternion} q - The quaternion.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &multiply(const Quaternion &q);
+    /**
+     * Pre-multiplies this quaternion by the given one.
+     *
+     * @param {Quaternion} q - The quaternion.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &premultiply(const Quaternion &q);
+    /**
+     * Multiplies the given quaternions and stores the result in this instance.
+     *
+     * @param {Quaternion} a - The first quaternion.
+     * @param {Quaternion} b - The second quaternion.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &multiplyQuaternions(const Quaternion &a, const Quaternion &b);
+    /**
+     * Performs a spherical linear interpolation between this quaternion and
+     * the given one.
+     *
+     * @param {Quaternion} qb - The target quaternion.
+     * @param {HIGH_PRECISION} t - The interpolation factor in the closed interval `[0, 1]`.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &slerp(const Quaternion &qb, HIGH_PRECISION t);
+    /**
+     * Performs a spherical linear interpolation between the given quaternions
+     * and stores the result in this quaternion.
+     *
+     * @param {Quaternion} qa - The source quaternion.
+     * @param {Quaternion} qb - The target quaternion.
+     * @param {HIGH_PRECISION} t - The interpolation factor in the closed interval `[0, 1]`.
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &slerpQuaternions(const Quaternion &qa, const Quaternion &qb, HIGH_PRECISION t);
+    bool equals(const Quaternion &quaternion, float epsilon = 1e-6) const;
+    Quaternion &fromArray(const std::vector<HIGH_PRECISION> &array, size_t offset = 0);
+    std::vector<HIGH_PRECISION> &toArray(std::vector<HIGH_PRECISION> &array, size_t offset = 0) const;
+    /**
+     * Sets this quaternion to a uniformly random, normalized quaternion.
+     *
+     * @return {Quaternion} A reference to this quaternion.
+     */
+    Quaternion &random();
+
+public:
+    Quaternion operator*(const Quaternion &q) const;
+    bool operator==(const Quaternion &q) const;
+    HIGH_PRECISION operator[](size_t index) const;
+
+private:
+    HIGH_PRECISION m_x;
+    HIGH_PRECISION m_y;
+    HIGH_PRECISION m_z;
+    HIGH_PRECISION m_w;
+};
+
+template <typename T>
+void Quaternion::slerpFlat(T *dst, size_t dstOffset, const T *src0, size_t srcOffset0, const T *src1, size_t srcOffset1, T t)
+{
+    // fuzz-free, array-based Quaternion SLERP operation
+
+    T x0 = src0[srcOffset0 + 0],
+      y0 = src0[srcOffset0 + 1],
+      z0 = src0[srcOffset0 + 2],
+      w0 = src0[srcOffset0 + 3];
+
+    const T x1 = src1[srcOffset1 + 0],
+            y1 = src1[srcOffset1 + 1],
+            z1 = src1[srcOffset1 + 2],
+            w1 = src1[srcOffset1 + 3];
+
+    if (t <= 0)
+    {
+        dst[dstOffset + 0] = x0;
+        dst[dstOffset + 1] = y0;
+        dst[dstOffset + 2] = z0;
+        dst[dstOffset + 3] = w0;
+        return;
+    }
+
+    if (t >= 1)
+    {
+        dst[dstOffset + 0] = x1;
+        dst[dstOffset + 1] = y1;
+        dst[dstOffset + 2] = z1;
+        dst[dstOffset + 3] = w1;
+        return;
+    }
+
+    if (w0 != w1 || x0 != x1 || y0 != y1 || z0 != z1)
+    {
+        T s = 1 - t;
+        const T cos = x0 * x1 + y0 * y1 + z0 * z1 + w0 * w1,
+                dir = (cos >= 0 ? 1 : -1),
+                sqrSin = 1 - cos * cos;
+
+        // Skip the Slerp for tiny steps to avoid numeric problems:
+        if (sqrSin > std::numeric_limits<T>::epsilon())
+        {
+            const T sin = std::sqrt(sqrSin),
+                    len = std::atan2(sin, cos * dir);
+
+            s = std::sin(s * len) / sin;
+            t = std::sin(t * len) / sin;
+        }
+
+        const T tDir = t * dir;
+
+        x0 = x0 * s + x1 * tDir;
+        y0 = y0 * s + y1 * tDir;
+        z0 = z0 * s + z1 * tDir;
+        w0 = w0 * s + w1 * tDir;
+
+        // Normalize in case we just did a lerp:
+        if (s == 1 - t)
+        {
+            const T f = 1 / std::sqrt(x0 * x0 + y0 * y0 + z0 * z0 + w0 * w0);
+
+            x0 *= f;
+            y0 *= f;
+            z0 *= f;
+            w0 *= f;
+        }
+    }
+
+    dst[dstOffset] = x0;
+    dst[dstOffset + 1] = y0;
+    dst[dstOffset + 2] = z0;
+    dst[dstOffset + 3] = w0;
+}
+
+template <typename T>
+void Quaternion::multiplyQuaternionsFlat(T *dst, size_t dstOffset, const T *src0, size_t srcOffset0, const T *src1, size_t srcOffset1)
+{
+    const T x0 = src0[srcOffset0];
+    const T y0 = src0[srcOffset0 + 1];
+    const T z0 = src0[srcOffset0 + 2];
+    const T w0 = src0[srcOffset0 + 3];
+
+    const T x1 = src1[srcOffset1];
+    const T y1 = src1[srcOffset1 + 1];
+    const T z1 = src1[srcOffset1 + 2];
+    const T w1 = src1[srcOffset1 + 3];
+
+    dst[dstOffset] = x0 * w1 + w0 * x1 + y0 * z1 - z0 * y1;
+    dst[dstOffset + 1] = y0 * w1 + w0 * y1 + z0 * x1 - x0 * z1;
+    dst[dstOffset + 2] = z0 * w1 + w0 * z1 + x0 * y1 - y0 * x1;
+    dst[dstOffset + 3] = w0 * w1 - x0 * x1 - y0 * y1 - z0 * z1;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SPHERE_H
+#define SPHERE_H
+
+#include "math/Vector3.h"
+#include <vector>
+
+class Box3;
+class Plane;
+class Matrix4;
+
+/**
+ * An analytical 3D sphere defined by a center and radius. This class is mainly
+ * used as a bounding volume for 3D objects.
+ */
+class Sphere
+{
+public:
+    /**
+     * Constructs a new sphere.
+     *
+     * @param {Vector3} [center=(0,0,0)] - The center of the sphere
+     * @param {HIGH_PRECISION} [radius=-1] - The radius of the sphere.
+     */
+    Sphere(const Vector3 &center = Vector3(), HIGH_PRECISION radius = -1);
+    ~Sphere();
+
+    Vector3 &center();
+    const Vector3 &center() const;
+    HIGH_PRECISION radius;
+
+    void set(const Vector3 &center, HIGH_PRECISION radius);
+    /**
+     * Computes the minimum bounding sphere for the given points. If `optionalCenter`
+     * is given, it is used as the sphere's center; otherwise the center of the
+     * points' bounding box is used.
+     *
+     * @param {std::vector<Vector3>} points - The points.
+     * @param {const Vector3*} [optionalCenter] - The center of the sphere.
+     */
+    void setFromPoints(const std::vector<Vector3> &points, const Vector3 *optionalCenter = nullptr);
+    Sphere clone() const;
+    void copy(const Sphere &sphere);
+    /**
+     * Returns `true` if the sphere is empty (the radius set to a negative number).
+     * Spheres with a radius of `0` contain only their center point and are not
+     * considered to be empty.
+     *
+     * @return {bool}
+     */
+    bool isEmpty() const;
+    void makeEmpty();
+    bool containsPoint(const Vector3 &point) const;
+    HIGH_PRECISION distanceToPoint(const Vector3 &point) const;
+    bool intersectsSphere(const Sphere &sphere) const;
+    bool intersectsBox(const Box3 &box) const;
+    bool intersectsPlane(const Plane &plane) const;
+    void clampPoint(const Vector3 &point, Vector3 &target) const;
+    void getBoundingBox(Box3 &target) const;
+    /**
+     * Transforms this sphere with the given 4x4 transformation matrix. The
+     * radius grows with the largest axis scale.
+     *
+     * @param {Matrix4} matrix - The transformation matrix.
+     */
+    void applyMatrix4(const Matrix4 &matrix);
+    void translate(const Vector3 &offset);
+    void expandByPoint(const Vector3 &point);
+    void unionSphere(const Sphere &sphere);
+    bool equals(const Sphere &sphere) const;
+
+private:
+    Vector3 m_center;
+};
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef TRIANGLE_H
+#define TRIANGLE_H
+
+#include "math/Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Box3;
+class Plane;
+class BufferAttribute;
+
+/**
+ * A geometric triangle as defined by three vectors representing its three
+ * corners.
+ *
+ * The static batch kernels work on many triangles stored in
+ * {@link Triangle::Arrays}, for BVH leaves, picking, decal projection and
+ * navmesh queries. They evaluate four triangles per SSE step.
+ * ```c++
+ * Triangle::Arrays leaf;
+ * leaf.setFromArrays(positions, indices);
+ * float distanceSq = maxDistance * maxDistance;
+ * Vector3 closest;
+ * size_t face = Triangle::nearestToPoint(leaf, 0, leaf.size(), query, closest, distanceSq);
+ * ```
+ */
+class Triangle
+{
+public:
+    /**
+     * Triangles stored as one array per corner coordinate.
+     */
+    struct Arrays
+    {
+        std::vector<float> ax, ay, az;
+        std::vector<float> bx, by, bz;
+        std::vector<float> cx, cy, cz;
+
+        size_t size() const;
+        void clear();
+        void reserve(size_t count);
+        void push(const Triangle &triangle);
+        /**
+         * Replaces the triangles with the ones of a geometry.
+         *
+         * @param {std::span<const float>} positions - `xyz` per vertex.
+         * @param {std::span<const uint32_t>} [index] - Three vertex indices per triangle; empty for consecutive vertices.
+         */
+        void setFromArrays(std::span<const float> positions, std::span<const uint32_t> index = {});
+    };
+
+    /**
+     * Constructs a new triangle.
+     *
+     * @param {Vector3} [a=(0,0,0)] - The first corner of the triangle.
+     * @param {Vector3} [b=(0,0,0)] - The second corner of the triangle.
+     * @param {Vector3} [c=(0,0,0)] - The third corner of the triangle.
+     */
+    Triangle(const Vector3 &a = Vector3(), const Vector3 &b = Vector3(), const Vector3 &c = Vector3());
+    ~Triangle();
+
+    Vector3 &a();
+    const Vector3 &a() const;
+    Vector3 &b();
+    const Vector3 &b() const;
+    Vector3 &c();
+    const Vector3 &c() const;
+
+    /**
+     * Computes the normal vector of a triangle.
+     *
+     * @param {Vector3} a - The first corner of the triangle.
+     * @param {Vector3} b - The second corner of the triangle.
+     * @param {Vector3} c - The third corner of the triangle.
+     * @param {Vector3} target - The target vector that is used to store the method's result; zero for degenerate triangles.
+     */
+    static void getNormal(const Vector3 &a, const Vector3 &b, const Vector3 &c, Vector3 &target);
+    /**
+     * Computes a barycentric coordinates from the given vector.
+     *
+     * @param {Vector3} point - A point in 3D space.
+     * @param {Vector3} a - The first corner of the triangle.
+     * @param {Vector3} b - The second corner of the triangle.
+     * @param {Vector3} c - The third corner of the triangle.
+     * @param {Vector3} target - The target vector that is used to store the method's result.
+     * @return {bool} `false` if the triangle is degenerate; `target` is then zero.
+     */
+    static bool getBarycoord(const Vector3 &point, const Vector3 &a, const Vector3 &b, const Vector3 &c, Vector3 &target);
+    /**
+     * Returns `true` if the given point, when projected onto the plane of the
+     * triangle, lies within the triangle.
+     *
+     * @param {Vector3} point - The point in 3D space to test.
+     * @param {Vector3} a - The first corner of the triangle.
+     * @param {Vector3} b - The second corner of the triangle.
+     * @param {Vector3} c - The third corner of the triangle.
+     * @return {bool}
+     */
+    static bool containsPoint(const Vector3 &point, const Vector3 &a, const Vector3 &b, const Vector3 &c);
+    /**
+     * Computes the value barycentrically interpolated for the given point on
+     * the triangle.
+     *
+     * @param {Vector3} point - Position of interpolated point.
+     * @param {Vector3} p1 - The first corner of the triangle.
+     * @param {Vector3} p2 - The second corner of the triangle.
+     * @param {Vector3} p3 - The third corner of the triangle.
+     * @param {Vector3} v1 - Value to interpolate of first vertex.
+     * @param {Vector3} v2 - Value to interpolate of second vertex.
+     * @param {Vector3} v3 - Value to interpolate of third vertex.
+     * @param {Vector3} target - The target vector that is used to store the method's result.
+     * @return {bool} `false` if the triangle is degenerate; `target` is then zero.
+     */
+    static bool getInterpolation(const Vector3 &point, const Vector3 &p1, const Vector3 &p2, const Vector3 &p3,
+                                 const Vector3 &v1, const Vector3 &v2, const Vector3 &v3, Vector3 &target);
+    /**
+     * Returns `true` if the triangle is oriented towards the given direction.
+     *
+     * @param {Vector3} a - The first corner of the triangle.
+     * @param {Vector3} b - The second corner of the triangle.
+     * @param {Vector3} c - The third corner of the triangle.
+     * @param {Vector3} direction - The (normalized) direction vector.
+     * @return {bool}
+     */
+    static bool isFrontFacing(const Vector3 &a, const Vector3 &b, const Vector3 &c, const Vector3 &direction);
+
+    void set(const Vector3 &a, const Vector3 &b, const Vector3 &c);
+    void setFromPointsAndIndices(const std::vector<Vector3> &points, size_t i0, size_t i1, size_t i2);
+    void setFromAttributeAndIndices(const BufferAttribute &attribute, size_t i0, size_t i1, size_t i2);
+    Triangle clone() const;
+    void copy(const Triangle &triangle);
+
+    HIGH_PRECISION getArea() const;
+    void getMidpoint(Vector3 &target) const;
+    void getNormal(Vector3 &target) const;
+    void getPlane(Plane &target) const;
+    bool getBarycoord(const Vector3 &point, Vector3 &target) const;
+    bool getInterpolation(const Vector3 &point, const Vector3 &v1, const Vector3 &v2, const Vector3 &v3, Vector3 &target) const;
+    bool containsPoint(const Vector3 &point) const;
+    bool isFrontFacing(const Vector3 &direction) const;
+    /**
+     * Returns `true` if the triangle intersects the given box, by the
+     * separating axis test of the box axes, the triangle normal and the
+     * nine edge cross products.
+     *
+     * @param {Box3} box - The box to intersect.
+     * @return {bool}
+     */
+    bool intersectsBox(const Box3 &box) const;
+    /**
+     * Returns the closest point on the triangle to the given point.
+     *
+     * @param {Vector3} point - The point to compute the closest point for.
+     * @param {Vector3} target - The target vector that is used to store the method's result.
+     */
+    void closestPointToPoint(const Vector3 &point, Vector3 &target) const;
+    bool equals(const Triangle &triangle) const;
+
+    /**
+     * Computes the closest point of every triangle to `point`. Large batches
+     * are split across threads.
+     *
+     * @param {Arrays} triangles - The triangles.
+     * @param {Vector3} point - The query point.
+     * @param {std::span<float>} targets - Receives `xyz` per triangle.
+     * @param {std::span<float>} [distancesSq] - Receives the squared distance per triangle if not empty.
+     */
+    static void closestPointsToPoint(const Arrays &triangles, const Vector3 &point, std::span<float> targets, std::span<float> distancesSq = {});
+    /**
+     * Finds the triangle in `[begin, end)` closest to `point` and closer than
+     * `distanceSq`, as done per leaf while descending a BVH.
+     *
+     * @param {Arrays} triangles - The triangles.
+     * @param {size_t} begin - The first triangle.
+     * @param {size_t} end - One past the last triangle.
+     * @param {Vector3} point - The query point.
+     * @param {Vector3} target - Receives the closest point if one is found.
+     * @param {float} distanceSq - The squared distance to beat, e.g. the best one so far; updated if one is found.
+     * @return {size_t} The index of the closest triangle, or `end` if none is closer than `distanceSq`.
+     */
+    static size_t nearestToPoint(const Arrays &triangles, size_t begin, size_t end, const Vector3 &point, Vector3 &target, float &distanceSq);
+    /**
+     * Interpolates a vertex attribute at many hits, e.g. the uvs or normals
+     * at the results of a raycast batch. Large batches are split across
+     * threads.
+     *
+     * @param {std::span<const uint32_t>} faces - The triangle of every hit.
+     * @param {std::span<const float>} barycoords - The barycentric coordinates of every hit, three per hit.
+     * @param {std::span<const uint32_t>} index - Three vertex indices per triangle; empty for consecutive vertices.
+     * @param {std::span<const float>} attribute - The attribute data.
+     * @param {size_t} itemSize - The components per vertex.
+     * @param {std::span<float>} target - Receives `itemSize` values per hit.
+     */
+    static void interpolateAttribute(std::span<const uint32_t> faces, std::span<const float> barycoords, std::span<const uint32_t> index,
+                                     std::span<const float> attribute, size_t itemSize, std::span<float> target);
+
+private:
+    Vector3 m_a;
+    Vector3 m_b;
+    Vector3 m_c;
+};
+
+#endif
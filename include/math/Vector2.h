@@ -41,6 +41,7 @@ public:
      * @param {HIGH_PRECISION} [y=0] - The y value of this vector.
      */
     Vector2(HIGH_PRECISION x = 0.0, HIGH_PRECISION y = 0.0);
+    Vector2(const Vector2 &) = default;
     ~Vector2();
     /**
      * The x value of this vector.
@@ -306,14 +307,14 @@ public:
      * @param {Vector2} v - The vector to compute the dot product with.
      * @return {HIGH_PRECISION} The result of the dot product.
      */
-    HIGH_PRECISION dot(const Vector2 &v);
+    HIGH_PRECISION dot(const Vector2 &v) const;
     /**
      * Calculates the cross product of the given vector with this instance.
      *
      * @param {Vector2} v - The vector to compute the cross product with.
      * @return {HIGH_PRECISION} The result of the cross product.
      */
-    HIGH_PRECISION cross(const Vector2 &v);
+    HIGH_PRECISION cross(const Vector2 &v) const;
     /**
      * Computes the square of the Euclidean length (straight-line length) from
      * (0, 0) to (x, y). If you are comparing the lengths of vectors, you should
@@ -2,14 +2,19 @@
 #define VECTOR3_H
 
 #include "common/BasicType.h"
+#include <span>
+#include <vector>
 
 class Matrix3;
 class Matrix4;
+class Quaternion;
+class BufferAttribute;
 
 class Vector3
 {
 public:
     Vector3(HIGH_PRECISION x = 0.0, HIGH_PRECISION y = 0.0, HIGH_PRECISION z = 0.0);
+    Vector3(const Vector3 &) = default;
     ~Vector3();
 
     HIGH_PRECISION x() const;
@@ -42,11 +47,11 @@ public:
     // applyAxisAngle( axis, angle )
     void applyMatrix3(Matrix3 &m);
     void applyNormalMatrix(Matrix3 &m);
-    // applyMatrix4( m )
-    // applyQuaternion( q )
+    void applyMatrix4(const Matrix4 &m);
+    void applyQuaternion(const Quaternion &q);
     // project( camera )
     // unproject( camera )
-    // transformDirection( m )
+    void transformDirection(const Matrix4 &m);
     void divide(const Vector3 &v);
     void divideScalar(HIGH_PRECISION scalar);
     void min(const Vector3 &v);
@@ -81,16 +86,16 @@ public:
     void setFromSphericalCoords(float radius, float phi, float theta);
     // setFromCylindrical( c )
     void setFromCylindricalCoords(float radius, float theta, HIGH_PRECISION y);
-    // setFromMatrixPosition( m )
-    // setFromMatrixScale( m )
+    void setFromMatrixPosition(const Matrix4 &m);
+    void setFromMatrixScale(const Matrix4 &m);
     void setFromMatrixColumn(const Matrix4 &m, size_t index);
     void setFromMatrix3Column(const Matrix3 &m, size_t index);
     // setFromEuler( e )
     // setFromColor( c )
     bool equals(const Vector3 &v, float epsilon = 1e-6) const;
-    void fromArray(const std::vector<HIGH_PRECISION> &array, size_t offset = 0);
+    void fromArray(std::span<const HIGH_PRECISION> array, size_t offset = 0);
     void toArray(std::vector<HIGH_PRECISION> &array, size_t offset = 0);
-    // fromBufferAttribute( attribute, index )
+    void fromBufferAttribute(const BufferAttribute &attribute, size_t index);
     void random();
     void randomDirection();
 
@@ -0,0 +1,136 @@
+#ifndef INDEX_OPTIMIZER_H
+#define INDEX_OPTIMIZER_H
+
+#include "core/BufferGeometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * Reorders triangles and vertices of indexed geometries for the GPU; the
+ * rendered result is unchanged.
+ *
+ * - {@link IndexOptimizer::optimizeVertexCache} orders triangles for the
+ *   post-transform vertex cache with Tipsify (Sander et al. 2007), so each
+ *   vertex is shaded as few times as possible.
+ * - {@link IndexOptimizer::optimizeOverdraw} splits that order into clusters
+ *   that cost little cache efficiency and sorts the clusters front to back
+ *   from the outside, so early depth testing rejects more pixels.
+ * - {@link IndexOptimizer::optimizeVertexFetch} renumbers vertices in order
+ *   of first use, so vertex fetches stream through memory, and drops
+ *   unreferenced vertices.
+ *
+ * Cache efficiency is measured as ACMR (average cache miss ratio, vertex
+ * shader runs per triangle; `0.5` is ideal for large grids, `3` the worst)
+ * and ATVR (average transformed vertex ratio, shader runs per vertex; `1`
+ * is ideal), on a FIFO cache.
+ * ```c++
+ * auto stats = IndexOptimizer::optimize(*geometry);
+ * printf("ACMR %.3f -> %.3f\n", stats.before.acmr, stats.after.acmr);
+ * ```
+ */
+namespace IndexOptimizer
+{
+    /**
+     * Vertex cache efficiency of an index buffer.
+     */
+    struct CacheStats
+    {
+        // vertex shader invocations
+        size_t transformed = 0;
+        // transformed vertices per triangle
+        float acmr = 0;
+        // transformed vertices per referenced vertex
+        float atvr = 0;
+    };
+
+    /**
+     * Result of {@link IndexOptimizer::optimize}.
+     */
+    struct Stats
+    {
+        CacheStats before;
+        CacheStats after;
+        // vertices dropped because no triangle referenced them
+        size_t verticesRemoved = 0;
+        double seconds = 0;
+    };
+
+    /**
+     * Which passes {@link IndexOptimizer::optimize} runs.
+     */
+    struct Options
+    {
+        // entries of the simulated FIFO cache
+        size_t cacheSize = 16;
+        // whether to reorder clusters for overdraw; needs a position attribute
+        bool overdraw = true;
+        // ACMR an overdraw cluster may reach, relative to the cache order
+        float overdrawThreshold = 1.05f;
+        // whether to renumber vertices in first use order
+        bool vertexFetch = true;
+    };
+
+    /**
+     * Simulates a FIFO vertex cache of `cacheSize` entries on `indices`.
+     *
+     * @param {std::span<const uint32_t>} indices - Three indices per triangle.
+     * @param {size_t} vertexCount - The number of vertices.
+     * @param {size_t} [cacheSize=16] - Entries of the cache.
+     * @return {CacheStats}
+     */
+    CacheStats analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, size_t cacheSize = 16);
+
+    /**
+     * Reorders triangles for vertex cache locality (Tipsify).
+     *
+     * @param {std::span<const uint32_t>} indices - Three indices per triangle.
+     * @param {size_t} vertexCount - The number of vertices.
+     * @param {size_t} [cacheSize=16] - Entries of the targeted cache.
+     * @return {std::vector<uint32_t>} The reordered triangles.
+     */
+    std::vector<uint32_t> optimizeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, size_t cacheSize = 16);
+
+    /**
+     * Reorders clusters of a cache-optimized index buffer to reduce
+     * overdraw. Clusters end where the cache order restarts, or earlier as
+     * long as their ACMR stays within `threshold` times that of their
+     * region; they are sorted by how far they face outward from the mesh
+     * center.
+     *
+     * @param {std::span<const uint32_t>} indices - Output of {@link IndexOptimizer::optimizeVertexCache}.
+     * @param {std::span<const float>} positions - Three floats per vertex.
+     * @param {size_t} [cacheSize=16] - Entries of the targeted cache.
+     * @param {float} [threshold=1.05] - Allowed ACMR degradation, `1` keeps the cache order intact.
+     * @return {std::vector<uint32_t>} The reordered triangles.
+     */
+    std::vector<uint32_t> optimizeOverdraw(std::span<const uint32_t> indices, std::span<const float> positions, size_t cacheSize = 16,
+                                           float threshold = 1.05f);
+
+    /**
+     * Computes the renumbering of vertices in order of first use.
+     * Unreferenced vertices map to `~0u`.
+     *
+     * @param {std::span<const uint32_t>} indices - Three indices per triangle.
+     * @param {size_t} vertexCount - The number of vertices.
+     * @param {std::vector<uint32_t>} remap - Receives the new index of each old vertex.
+     * @return {size_t} The number of referenced vertices.
+     */
+    size_t optimizeVertexFetch(std::span<const uint32_t> indices, size_t vertexCount, std::vector<uint32_t> &remap);
+
+    /**
+     * Runs the enabled passes on `geometry`: the index is reordered in place,
+     * renumbered attributes and morph targets replace the old ones. The old
+     * attributes are not modified, so geometries sharing them (such as
+     * {@link SimplifyModifier} levels) are unaffected. Unindexed geometries
+     * are left alone.
+     *
+     * @param {BufferGeometry} geometry - The geometry to optimize.
+     * @param {Options} options - The passes to run.
+     * @return {Stats}
+     */
+    Stats optimize(BufferGeometry &geometry, const Options &options = {});
+}
+
+#endif
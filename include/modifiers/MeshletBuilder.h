@@ -0,0 +1,117 @@
+#ifndef MESHLET_BUILDER_H
+#define MESHLET_BUILDER_H
+
+#include "core/BufferGeometry.h"
+#include "math/Frustum.h"
+#include "math/Sphere.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * Splits indexed geometry into meshlets: small clusters of up to `64`
+ * vertices and `124` triangles that mesh shaders and the CPU culling path
+ * process as a unit. Each meshlet carries a bounding sphere for frustum
+ * culling and a normal cone for backface culling of the whole cluster.
+ *
+ * Meshlets grow greedily through shared vertices, preferring triangles
+ * that add no new vertex and staying close to their center, so they are
+ * compact on connected surfaces; small disconnected pieces share a meshlet
+ * when they lie close together in index order.
+ * ```c++
+ * auto meshlets = MeshletBuilder::build(*geometry);
+ * std::vector<uint32_t> visible;
+ * MeshletBuilder::cull(meshlets, frustum, cameraPosition, visible);
+ * ```
+ */
+namespace MeshletBuilder
+{
+    /**
+     * One cluster; its vertices and triangles are ranges of
+     * {@link MeshletBuilder::Meshlets#vertices} and
+     * {@link MeshletBuilder::Meshlets#triangles}.
+     */
+    struct Meshlet
+    {
+        uint32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        // offset in triangles, not bytes
+        uint32_t triangleOffset = 0;
+        uint32_t triangleCount = 0;
+
+        Sphere boundingSphere;
+
+        // the meshlet faces away from every point `p` for which
+        // `dot(normalize(coneApex - p), coneAxis) >= coneCutoff`; a cutoff
+        // above `1` marks normals too spread out to ever cull
+        Vector3 coneApex;
+        Vector3 coneAxis;
+        float coneCutoff = 2;
+    };
+
+    /**
+     * The meshlets of one geometry.
+     */
+    struct Meshlets
+    {
+        std::vector<Meshlet> meshlets;
+        // meshlet-local vertex to geometry vertex
+        std::vector<uint32_t> vertices;
+        // three meshlet-local vertex indices per triangle
+        std::vector<uint8_t> triangles;
+
+        // float copies of the bounds for {@link MeshletBuilder::cull}: spheres
+        // as `(x, y, z, radius)`, cones as `(apex, cutoff, axis, 0)`
+        std::vector<float> spheres;
+        std::vector<float> cones;
+    };
+
+    /**
+     * Limits of {@link MeshletBuilder::build}.
+     */
+    struct Options
+    {
+        // at most 256, local indices are bytes
+        size_t maxVertices = 64;
+        // at most 512
+        size_t maxTriangles = 124;
+    };
+
+    /**
+     * Builds meshlets from an index buffer and positions.
+     *
+     * @param {std::span<const uint32_t>} indices - Three indices per triangle.
+     * @param {std::span<const float>} positions - Three floats per vertex.
+     * @param {Options} options - The meshlet limits.
+     * @return {Meshlets}
+     */
+    Meshlets build(std::span<const uint32_t> indices, std::span<const float> positions, const Options &options = {});
+    /**
+     * Builds meshlets from the index and `position` attribute of `geometry`;
+     * unindexed geometries are treated as consecutive triangles.
+     *
+     * @param {BufferGeometry} geometry - The source geometry.
+     * @param {Options} options - The meshlet limits.
+     * @return {Meshlets}
+     */
+    Meshlets build(const BufferGeometry &geometry, const Options &options = {});
+
+    /**
+     * Tests every meshlet against `frustum` and its normal cone against
+     * `cameraPosition`, both in the geometry's local space, and writes the
+     * indices of the meshlets that may be visible to `visible` in ascending
+     * order. The sphere test runs four meshlets at a time with SSE, the
+     * batches run in parallel chunks.
+     *
+     * @param {Meshlets} meshlets - The meshlets to test.
+     * @param {Frustum} frustum - The frustum in local space.
+     * @param {Vector3} cameraPosition - The camera position in local space.
+     * @param {std::vector<uint32_t>} visible - Receives the visible meshlet indices.
+     * @return {size_t} The number of visible meshlets.
+     */
+    size_t cull(const Meshlets &meshlets, const Frustum &frustum, const Vector3 &cameraPosition, std::vector<uint32_t> &visible);
+}
+
+#endif
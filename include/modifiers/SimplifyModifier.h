@@ -0,0 +1,102 @@
+#ifndef SIMPLIFY_MODIFIER_H
+#define SIMPLIFY_MODIFIER_H
+
+#include "core/BufferGeometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+/**
+ * Reduces the triangle count of an indexed geometry by edge collapses
+ * ordered by quadric error (Garland-Heckbert).
+ *
+ * - Vertices are classified once: interior (manifold), border, attribute
+ *   seam (two vertices sharing a position, e.g. a UV split) or locked.
+ *   Border and seam vertices only slide along their border or seam, and
+ *   both sides of a seam collapse together, so no cracks open up.
+ * - A vertex always collapses onto the other end of its edge, so the
+ *   surviving vertices keep their original attributes and the simplified
+ *   geometry shares the vertex buffers of its source.
+ * - Collapses run in passes. Candidate edges are costed in parallel, with
+ *   both directions and a triangle flip test evaluated per edge, queued by
+ *   error and taken cheapest first; a collapse is skipped if it touches a
+ *   vertex already moved in the pass.
+ * - The result depends on the input only, never on the thread count.
+ *
+ * Unindexed geometries are treated as one triangle per three vertices; each
+ * corner is its own vertex there, so nothing collapses. Weld them first.
+ * ```c++
+ * SimplifyModifier modifier;
+ * auto lod = modifier.modify(*geometry, {.targetCount = geometry->getIndex().size() / 3 / 4});
+ * float error = modifier.stats().error;
+ * ```
+ */
+class SimplifyModifier
+{
+public:
+    /**
+     * When to stop. Simplification stops as soon as `targetCount` triangles
+     * remain or the next collapse would exceed `targetError`.
+     */
+    struct Options
+    {
+        // triangles to keep, `0` to simplify as far as `targetError` allows
+        size_t targetCount = 0;
+        // maximum error as a fraction of the largest bounding box side
+        float targetError = 1e-2f;
+        // whether border vertices stay in place
+        bool lockBorder = false;
+    };
+
+    /**
+     * Figures of the last simplification.
+     */
+    struct Stats
+    {
+        size_t trianglesBefore = 0;
+        size_t trianglesAfter = 0;
+        size_t passes = 0;
+        // largest deviation introduced, in geometry units
+        float error = 0;
+        double seconds = 0;
+    };
+
+    SimplifyModifier();
+    ~SimplifyModifier();
+
+    /**
+     * Returns a simplified copy of `geometry`. The copy shares the attributes
+     * and morph targets of `geometry` and owns a new index.
+     *
+     * @param {BufferGeometry} geometry - The geometry to simplify. Must have a `position` attribute.
+     * @param {Options} [options] - The stopping criteria.
+     * @return {std::shared_ptr<BufferGeometry>}
+     */
+    std::shared_ptr<BufferGeometry> modify(const BufferGeometry &geometry, const Options &options);
+    std::shared_ptr<BufferGeometry> modify(const BufferGeometry &geometry);
+
+    /**
+     * Simplifies a raw triangle list.
+     *
+     * @param {std::span<const uint32_t>} indices - Three indices per triangle.
+     * @param {std::span<const float>} positions - Three floats per vertex.
+     * @param {Options} [options] - The stopping criteria.
+     * @return {std::vector<uint32_t>} The indices of the kept triangles, referring to the same vertices.
+     */
+    std::vector<uint32_t> simplify(std::span<const uint32_t> indices, std::span<const float> positions, const Options &options);
+    std::vector<uint32_t> simplify(std::span<const uint32_t> indices, std::span<const float> positions);
+
+    /**
+     * Figures of the last call to {@link SimplifyModifier#modify} or {@link SimplifyModifier#simplify}.
+     *
+     * @return {Stats}
+     */
+    const Stats &stats() const;
+
+private:
+    Stats m_stats;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef BONE_H
+#define BONE_H
+
+#include "core/Object3D.h"
+
+/**
+ * A bone which is part of a {@link Skeleton}. The skeleton in turn is used by
+ * the {@link SkinnedMesh}.
+ * ```c++
+ * auto root = std::make_shared<Bone>();
+ * auto child = std::make_shared<Bone>();
+ * root->add(child);
+ * child->position().setY(5);
+ * ```
+ */
+class Bone : public Object3D
+{
+public:
+    Bone();
+    ~Bone() override;
+
+    std::string type() const override;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef CPU_MORPHING_H
+#define CPU_MORPHING_H
+
+#include "core/MorphTarget.h"
+#include <cstddef>
+#include <span>
+
+class Mesh;
+
+/**
+ * CPU morph target blending over sparse {@link MorphTarget} deltas:
+ * `out = base + Σ influence[t] * delta[t]`.
+ *
+ * Targets with a zero influence are skipped and only the vertices a target
+ * lists are touched. The vertex range is split across threads; since target
+ * indices are sorted, every chunk finds its slice of each target with a
+ * binary search and writes only its own vertices.
+ */
+namespace CPUMorphing
+{
+    /**
+     * Raw input and output streams for one blend pass, three floats per vertex.
+     * `normals` and `outNormals` may both be `nullptr`.
+     */
+    struct MorphStreams
+    {
+        const float *positions = nullptr;
+        const float *normals = nullptr;
+        float *outPositions = nullptr;
+        float *outNormals = nullptr;
+    };
+
+    /**
+     * Blends the vertices `[begin, end)`.
+     *
+     * @param {MorphStreams} streams - The vertex streams.
+     * @param {std::span<const MorphTarget>} targets - The morph targets.
+     * @param {std::span<const float>} influences - One weight per target; missing entries count as zero.
+     * @param {size_t} begin - First vertex.
+     * @param {size_t} end - One past the last vertex.
+     */
+    void blendMorphTargets(const MorphStreams &streams, std::span<const MorphTarget> targets, std::span<const float> influences,
+                           size_t begin, size_t end);
+
+    /**
+     * Blends the morph targets of a mesh's geometry with its
+     * {@link Mesh#morphTargetInfluences} into {@link Mesh#morphedPosition}
+     * and {@link Mesh#morphedNormal}.
+     *
+     * @param {Mesh} mesh - The mesh to morph.
+     * @param {bool} [parallel=true] - Whether to split the vertex range across threads.
+     */
+    void morphMesh(Mesh &mesh, bool parallel = true);
+}
+
+#endif
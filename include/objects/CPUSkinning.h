@@ -0,0 +1,121 @@
+#ifndef CPU_SKINNING_H
+#define CPU_SKINNING_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+class SkinnedMesh;
+class BufferAttribute;
+
+/**
+ * CPU skinning kernels. They deform the bind-pose `position` and `normal`
+ * attributes of a {@link SkinnedMesh} with up to four bone influences per
+ * vertex, so animation baking and collision proxies can run headless.
+ *
+ * Both kernels work on flat float streams: positions/normals with three
+ * components per vertex, skin indices/weights with four. The linear blend
+ * kernel uses SSE when available; the vertex range is split across threads.
+ */
+namespace CPUSkinning
+{
+    enum class SkinningMethod
+    {
+        LinearBlend,
+        DualQuaternion
+    };
+
+    /**
+     * Raw input and output streams for one skinning pass. `normals` and
+     * `outNormals` may both be `nullptr`.
+     */
+    struct SkinningStreams
+    {
+        const float *positions = nullptr;
+        const float *normals = nullptr;
+        const float *skinIndices = nullptr;
+        const float *skinWeights = nullptr;
+        float *outPositions = nullptr;
+        float *outNormals = nullptr;
+    };
+
+    /**
+     * Builds the per-mesh skinning palette `bindMatrixInverse * boneMatrix * bindMatrix`,
+     * `16` floats per bone.
+     *
+     * @param {SkinnedMesh} mesh - The skinned mesh with a bound, updated skeleton.
+     * @param {std::vector<float>} palette - Receives the palette.
+     */
+    void computeSkinningMatrices(const SkinnedMesh &mesh, std::vector<float> &palette);
+
+    /**
+     * Converts a matrix palette into unit dual quaternions, `8` floats per bone
+     * laid out as `(real.xyzw, dual.xyzw)`. Scale is discarded.
+     *
+     * @param {const float*} palette - The matrix palette, `16` floats per bone.
+     * @param {size_t} boneCount - The number of bones.
+     * @param {float*} dualQuaternions - Receives `8 * boneCount` floats.
+     */
+    void computeDualQuaternions(const float *palette, size_t boneCount, float *dualQuaternions);
+
+    /**
+     * Checks that `skinIndex` and `skinWeight` hold four components for each
+     * of `vertexCount` vertices and that every bone index is below
+     * `boneCount`. The kernels index the palette unchecked.
+     *
+     * @param {BufferAttribute} skinIndex - The bone indices.
+     * @param {BufferAttribute} skinWeight - The bone weights.
+     * @param {size_t} vertexCount - The number of vertices to skin.
+     * @param {size_t} boneCount - The number of bones in the palette.
+     * @throws {std::invalid_argument} If an attribute does not fit or an index is out of range.
+     */
+    void validateSkinAttributes(const BufferAttribute &skinIndex, const BufferAttribute &skinWeight, size_t vertexCount, size_t boneCount);
+
+    /**
+     * Linear blend skinning of the vertices `[begin, end)`.
+     *
+     * @param {SkinningStreams} streams - The vertex streams.
+     * @param {const float*} palette - The matrix palette, `16` floats per bone.
+     * @param {size_t} begin - First vertex.
+     * @param {size_t} end - One past the last vertex.
+     */
+    void skinLinearBlend(const SkinningStreams &streams, const float *palette, size_t begin, size_t end);
+
+    /**
+     * Dual quaternion skinning of the vertices `[begin, end)`.
+     *
+     * @param {SkinningStreams} streams - The vertex streams.
+     * @param {const float*} dualQuaternions - The dual quaternion palette, `8` floats per bone.
+     * @param {size_t} begin - First vertex.
+     * @param {size_t} end - One past the last vertex.
+     */
+    void skinDualQuaternion(const SkinningStreams &streams, const float *dualQuaternions, size_t begin, size_t end);
+
+    /**
+     * Skins one mesh into its {@link SkinnedMesh#skinnedPosition} and
+     * {@link SkinnedMesh#skinnedNormal} attributes. If the geometry has morph
+     * targets and {@link Mesh#computeMorphedAttributes} ran, the morphed
+     * attributes are skinned instead of the bind pose.
+     *
+     * The skin attributes are validated with
+     * {@link CPUSkinning::validateSkinAttributes} whenever they, their
+     * version or the bone count changed since the last pass. The palette
+     * scratch lives on the mesh, so passes of different meshes may run
+     * concurrently, but one mesh must not be skinned twice at once.
+     *
+     * @param {SkinnedMesh} mesh - The mesh to skin.
+     * @param {SkinningMethod} method - The skinning method.
+     * @param {bool} [parallel=true] - Whether to split the vertex range across threads.
+     */
+    void skinMesh(SkinnedMesh &mesh, SkinningMethod method, bool parallel = true);
+
+    /**
+     * Skins many meshes, one mesh per task.
+     *
+     * @param {std::span<SkinnedMesh* const>} meshes - The meshes to skin.
+     * @param {SkinningMethod} method - The skinning method.
+     */
+    void skinMeshes(std::span<SkinnedMesh *const> meshes, SkinningMethod method);
+}
+
+#endif
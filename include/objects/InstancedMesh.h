@@ -0,0 +1,163 @@
+#ifndef INSTANCED_MESH_H
+#define INSTANCED_MESH_H
+
+#include "objects/Mesh.h"
+#include "math/Color.h"
+#include "math/Frustum.h"
+#include "math/Sphere.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * A special version of a mesh with instanced rendering support. Use
+ * this class if you have to render a large number of objects with the same
+ * geometry and material but with different world transformations.
+ *
+ * Instance transforms live in one contiguous {@link InstancedMesh#instanceMatrix}
+ * attribute, `16` floats per instance in column-major order, rather than in
+ * `Matrix4` or `Object3D` instances. Writes are tracked as dirty ranges so
+ * uploads and bounding sphere refreshes only touch what changed.
+ * ```c++
+ * auto mesh = std::make_shared<InstancedMesh>(geometry, 100000);
+ * mesh->setMatrixAt(0, matrix);
+ * mesh->cull(viewProjection, drawList);
+ * ```
+ */
+class InstancedMesh : public Mesh
+{
+public:
+    /**
+     * A span of instances, `[start, start + count)`.
+     */
+    struct UpdateRange
+    {
+        size_t start;
+        size_t count;
+    };
+
+    /**
+     * Constructs a new instanced mesh. All instances start with the identity transform.
+     *
+     * @param {std::shared_ptr<BufferGeometry>} geometry - The mesh geometry.
+     * @param {size_t} count - The number of instances.
+     */
+    InstancedMesh(std::shared_ptr<BufferGeometry> geometry, size_t count);
+    ~InstancedMesh() override;
+
+    std::string type() const override;
+
+    size_t count() const;
+    /**
+     * The instance transforms, `16` floats per instance.
+     *
+     * @return {std::shared_ptr<BufferAttribute>}
+     */
+    std::shared_ptr<BufferAttribute> instanceMatrix() const;
+    /**
+     * The instance colors, `3` floats per instance, or `nullptr` until
+     * {@link InstancedMesh#setColorAt} is first called.
+     *
+     * @return {std::shared_ptr<BufferAttribute>}
+     */
+    std::shared_ptr<BufferAttribute> instanceColor() const;
+
+    /**
+     * Gets the local transformation matrix of the defined instance.
+     *
+     * @param {size_t} index - The index of an instance.
+     * @param {Matrix4} matrix - The target object that is used to store the method's result.
+     */
+    void getMatrixAt(size_t index, Matrix4 &matrix) const;
+    /**
+     * Sets the given local transformation matrix to the defined instance.
+     *
+     * @param {size_t} index - The index of an instance.
+     * @param {Matrix4} matrix - The local transformation.
+     */
+    void setMatrixAt(size_t index, const Matrix4 &matrix);
+    /**
+     * Copies `matrices.size() / 16` column-major matrices to the instances
+     * starting at `start`, marking them as one dirty range.
+     *
+     * @param {size_t} start - The index of the first instance.
+     * @param {std::span<const float>} matrices - The matrices, `16` floats each.
+     */
+    void setMatricesAt(size_t start, std::span<const float> matrices);
+    void getColorAt(size_t index, float *rgb) const;
+    void getColorAt(size_t index, Color &color) const;
+    void setColorAt(size_t index, float r, float g, float b);
+    void setColorAt(size_t index, const Color &color);
+
+    /**
+     * Instances written since the last {@link InstancedMesh#clearUpdateRanges},
+     * as ranges coalesced in write order. A renderer uploads these and then
+     * clears them.
+     *
+     * @return {std::vector<UpdateRange>}
+     */
+    const std::vector<UpdateRange> &matrixUpdateRanges() const;
+    const std::vector<UpdateRange> &colorUpdateRanges() const;
+    void clearUpdateRanges();
+
+    /**
+     * The bounding sphere of every instance in local space, `(x, y, z, radius)`.
+     * Refreshed for dirty instances only.
+     *
+     * @return {std::vector<float>}
+     */
+    const std::vector<float> &instanceSpheres();
+    /**
+     * Bounding sphere enclosing all instances, `nullptr` until
+     * {@link InstancedMesh#computeBoundingSphere} is called.
+     *
+     * @return {Sphere}
+     */
+    const Sphere *boundingSphere() const;
+    void computeBoundingSphere();
+
+    /**
+     * Tests every instance's bounding sphere against `frustum`, given in this
+     * mesh's local space, and writes the indices of the visible instances to
+     * `drawList` in ascending order. Runs in parallel chunks.
+     *
+     * @param {Frustum} frustum - The frustum in local space.
+     * @param {std::vector<uint32_t>} drawList - Receives the visible instance indices.
+     * @return {size_t} The number of visible instances.
+     */
+    size_t cull(const Frustum &frustum, std::vector<uint32_t> &drawList);
+    /**
+     * Same as above for a world space view-projection matrix; the frustum is
+     * moved into local space with {@link Object3D#matrixWorld}.
+     *
+     * @param {Matrix4} viewProjection - `projectionMatrix * matrixWorldInverse` of the camera.
+     * @param {std::vector<uint32_t>} drawList - Receives the visible instance indices.
+     * @return {size_t} The number of visible instances.
+     */
+    size_t cull(const Matrix4 &viewProjection, std::vector<uint32_t> &drawList);
+
+private:
+    size_t m_count;
+    std::shared_ptr<BufferAttribute> m_instanceMatrix;
+    std::shared_ptr<BufferAttribute> m_instanceColor;
+
+    std::vector<UpdateRange> m_matrixRanges;
+    std::vector<UpdateRange> m_colorRanges;
+
+    // per-instance bounding spheres and the instances whose sphere is stale
+    std::vector<float> m_instanceSpheres;
+    std::vector<UpdateRange> m_sphereRanges;
+    Sphere m_geometrySphere;
+
+    std::optional<Sphere> m_boundingSphere;
+
+    // scratch for the parallel cull
+    std::vector<uint32_t> m_chunkCounts;
+
+    void markDirty(size_t start, size_t count);
+    void updateInstanceSpheres();
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef LOD_H
+#define LOD_H
+
+#include "core/Object3D.h"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+class Camera;
+
+/**
+ * Level of detail: shows one of several versions of an object, picked by how
+ * large the geometric error of each version appears on screen.
+ *
+ * Every level declares its error in local units, e.g. the
+ * {@link SimplifyModifier} error it was generated with (`0` for the full
+ * detail version). The error is scaled by the largest axis scale of the
+ * world matrix and projected at the distance to the camera; the coarsest
+ * level whose projected error stays within {@link LOD#maxScreenError} pixels
+ * is shown.
+ *
+ * Hysteresis keeps levels from flickering at the threshold: a coarser level
+ * is only taken once its error is `hysteresis` (a fraction) below the
+ * threshold, while a finer level is taken as soon as the current one
+ * exceeds it.
+ * ```c++
+ * auto lod = std::make_shared<LOD>();
+ * lod->addLevel(highMesh, 0);
+ * lod->addLevel(mediumMesh, mediumError);
+ * lod->addLevel(lowMesh, lowError);
+ * scene->add(lod);
+ *
+ * // each frame, for all LOD nodes at once
+ * LOD::update(lods, *camera, screenHeight);
+ * ```
+ */
+class LOD : public Object3D
+{
+public:
+    struct Level
+    {
+        std::shared_ptr<Object3D> object;
+        // geometric error of the level, in local units
+        float error;
+        // fraction below the threshold needed to switch to this level
+        float hysteresis;
+    };
+
+    LOD();
+    ~LOD() override;
+
+    std::string type() const override;
+
+    /**
+     * Adds a mesh that will display at a certain level of detail. The object
+     * becomes a child of this LOD; levels are kept ordered by error.
+     *
+     * @param {std::shared_ptr<Object3D>} object - The 3D object to display at this level.
+     * @param {float} [error=0] - The geometric error of the level, in local units.
+     * @param {float} [hysteresis=0.1] - Fraction of the threshold the error must stay below before this level is taken.
+     * @return {LOD} A reference to this instance.
+     */
+    LOD &addLevel(const std::shared_ptr<Object3D> &object, float error = 0, float hysteresis = 0.1f);
+
+    /**
+     * The levels, finest first.
+     *
+     * @return {std::vector<Level>}
+     */
+    const std::vector<Level> &levels() const;
+    /**
+     * The index of the level shown.
+     *
+     * @return {size_t}
+     */
+    size_t getCurrentLevel() const;
+
+    /**
+     * Picks the level to show for a screen space error of `pixelsPerUnit`
+     * pixels per local unit, starting from the current level.
+     *
+     * @param {float} pixelsPerUnit - Screen pixels covered by one local unit.
+     * @return {size_t} The level index.
+     */
+    size_t getLevelForScale(float pixelsPerUnit) const;
+
+    /**
+     * Selects the level for `camera` and shows it. World matrices of the LOD
+     * and the camera must be up to date.
+     *
+     * @param {Camera} camera - The camera the scene is rendered with.
+     * @param {float} screenHeight - The height of the viewport in pixels.
+     */
+    void update(const Camera &camera, float screenHeight);
+
+    /**
+     * Selects the levels of many LOD nodes against one camera, in parallel.
+     * Nodes with {@link LOD#autoUpdate} set to `false` are skipped.
+     *
+     * @param {std::span<LOD*const>} lods - The LOD nodes.
+     * @param {Camera} camera - The camera the scene is rendered with.
+     * @param {float} screenHeight - The height of the viewport in pixels.
+     * @return {size_t} The number of nodes that switched level.
+     */
+    static size_t update(std::span<LOD *const> lods, const Camera &camera, float screenHeight);
+
+    /**
+     * Collects the LOD nodes below `root` (including `root`), in traversal order.
+     *
+     * @param {Object3D} root - The root of the scene graph to search.
+     * @return {std::vector<LOD*>}
+     */
+    static std::vector<LOD *> collect(Object3D &root);
+
+    /**
+     * Largest projected error allowed, in pixels.
+     */
+    float maxScreenError = 1;
+    /**
+     * Whether the batch {@link LOD#update} selects this node's level.
+     */
+    bool autoUpdate = true;
+
+private:
+    std::vector<Level> m_levels;
+    size_t m_currentLevel = 0;
+
+    bool select(size_t level);
+};
+
+#endif
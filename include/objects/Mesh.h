@@ -0,0 +1,74 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include "core/Object3D.h"
+#include "core/BufferGeometry.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Class representing triangular polygon mesh based objects.
+ * ```c++
+ * auto mesh = std::make_shared<Mesh>(geometry);
+ * scene->add(mesh);
+ * ```
+ */
+class Mesh : public Object3D
+{
+public:
+    /**
+     * Constructs a new mesh.
+     *
+     * @param {std::shared_ptr<BufferGeometry>} [geometry] - The mesh geometry.
+     */
+    Mesh(std::shared_ptr<BufferGeometry> geometry = std::make_shared<BufferGeometry>());
+    ~Mesh() override;
+
+    std::string type() const override;
+
+    std::shared_ptr<BufferGeometry> geometry() const;
+    void geometry(std::shared_ptr<BufferGeometry> value);
+
+    /**
+     * Weights of the geometry's morph targets, one per target.
+     */
+    std::vector<float> morphTargetInfluences;
+    /**
+     * Maps morph target names to their index in {@link Mesh#morphTargetInfluences}.
+     */
+    std::unordered_map<std::string, size_t> morphTargetDictionary;
+
+    /**
+     * Sets the values of {@link Mesh#morphTargetDictionary} and {@link Mesh#morphTargetInfluences}
+     * to make sure existing morph targets can influence this mesh. Existing
+     * influences are kept.
+     */
+    void updateMorphTargets();
+    /**
+     * Blends the morph targets on the CPU into {@link Mesh#morphedPosition} and
+     * {@link Mesh#morphedNormal}; the source geometry is left untouched.
+     *
+     * @param {bool} [parallel=true] - Whether to split the vertex range across threads.
+     */
+    void computeMorphedAttributes(bool parallel = true);
+    /**
+     * Output of the last {@link Mesh#computeMorphedAttributes}, or `nullptr`.
+     *
+     * @return {std::shared_ptr<BufferAttribute>}
+     */
+    std::shared_ptr<BufferAttribute> morphedPosition() const;
+    std::shared_ptr<BufferAttribute> morphedNormal() const;
+    /**
+     * Makes sure the morphed attributes match the geometry's vertex count.
+     */
+    void allocateMorphedAttributes();
+
+private:
+    std::shared_ptr<BufferGeometry> m_geometry;
+    std::shared_ptr<BufferAttribute> m_morphedPosition;
+    std::shared_ptr<BufferAttribute> m_morphedNormal;
+};
+
+#endif
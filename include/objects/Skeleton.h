@@ -0,0 +1,90 @@
+#ifndef SKELETON_H
+#define SKELETON_H
+
+#include "objects/Bone.h"
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Class for representing the armatures in three.cpp. The skeleton holds an
+ * array of bones and their inverse bind matrices and maintains the bone
+ * matrix palette (`boneMatrixWorld * boneInverse`) consumed by skinning.
+ *
+ * The palette is kept as one contiguous `float` buffer of `16 * boneCount`
+ * column-major values and is rebuilt by {@link Skeleton#update} in a single
+ * batched matrix pass.
+ * ```c++
+ * auto skeleton = std::make_shared<Skeleton>(bones);
+ * root->updateMatrixWorld();
+ * skeleton->update();
+ * ```
+ */
+class Skeleton
+{
+public:
+    /**
+     * Constructs a new skeleton.
+     *
+     * @param {std::vector<std::shared_ptr<Bone>>} [bones] - An array of bones.
+     * @param {std::vector<Matrix4>} [boneInverses] - An array of bone inverse matrices.
+     * If not provided, these matrices will be computed automatically via {@link Skeleton#calculateInverses}.
+     */
+    Skeleton(std::vector<std::shared_ptr<Bone>> bones = {}, std::vector<Matrix4> boneInverses = {});
+    ~Skeleton();
+
+    /**
+     * Updates the bone matrix palettes of many skeletons at once, spreading the
+     * skeletons over the worker threads. Bone world matrices must be current.
+     *
+     * @param {std::span<Skeleton* const>} skeletons - The skeletons to update.
+     */
+    static void updateSkeletons(std::span<Skeleton *const> skeletons);
+
+    const std::string &uuid() const;
+    size_t boneCount() const;
+    const std::vector<std::shared_ptr<Bone>> &bones() const;
+    const std::vector<Matrix4> &boneInverses() const;
+    /**
+     * The bone matrix palette, `16` floats per bone.
+     *
+     * @return {std::vector<float>}
+     */
+    const std::vector<float> &boneMatrices() const;
+
+    /**
+     * Computes the bone inverse matrices from the current world matrices of
+     * the bones.
+     */
+    void calculateInverses();
+    /**
+     * Resets the skeleton to the base pose.
+     */
+    void pose();
+    /**
+     * Recomputes the bone matrix palette. Bone world matrices are expected to
+     * be up to date (e.g. via {@link Object3D#updateMatrixWorld} on the root).
+     */
+    void update();
+    /**
+     * Searches through the skeleton's bone array and returns the first with a
+     * matching name.
+     *
+     * @param {std::string} name - The name of the bone.
+     * @return {std::shared_ptr<Bone>} The found bone, or `nullptr`.
+     */
+    std::shared_ptr<Bone> getBoneByName(const std::string &name) const;
+
+private:
+    void syncInverseElements();
+
+    std::string m_uuid;
+    std::vector<std::shared_ptr<Bone>> m_bones;
+    std::vector<Matrix4> m_boneInverses;
+    std::vector<float> m_boneMatrices;
+    std::vector<float> m_boneInverseElements;
+    std::vector<float> m_boneWorldElements;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef SKINNED_MESH_H
+#define SKINNED_MESH_H
+
+#include "objects/Mesh.h"
+#include "objects/Skeleton.h"
+#include "objects/CPUSkinning.h"
+#include <memory>
+
+/**
+ * A mesh that has a {@link Skeleton} that can then be used to animate the
+ * vertices of the geometry with skinning.
+ *
+ * The geometry is expected to provide `position`, `skinIndex` and
+ * `skinWeight` attributes (`skinIndex` and `skinWeight` with four components
+ * per vertex), plus an optional `normal` attribute. Deformed positions and
+ * normals produced on the CPU are written to {@link SkinnedMesh#skinnedPosition}
+ * and {@link SkinnedMesh#skinnedNormal}; the source geometry is left untouched.
+ */
+class SkinnedMesh : public Mesh
+{
+public:
+    enum class BindMode
+    {
+        /**
+         * The skinned mesh shares the same world space as the skeleton.
+         */
+        Attached,
+        /**
+         * The skinned mesh does not share the same world space as the skeleton.
+         * This is useful when a skeleton is shared across multiple skinned meshes.
+         */
+        Detached
+    };
+
+    SkinnedMesh(std::shared_ptr<BufferGeometry> geometry = std::make_shared<BufferGeometry>());
+    ~SkinnedMesh() override;
+
+    std::string type() const override;
+
+    BindMode bindMode = BindMode::Attached;
+
+    std::shared_ptr<Skeleton> skeleton() const;
+    const Matrix4 &bindMatrix() const;
+    const Matrix4 &bindMatrixInverse() const;
+
+    /**
+     * Binds the given skeleton to the skinned mesh. The bind matrix gets saved
+     * so that subsequent skinning happens relative to it.
+     *
+     * @param {std::shared_ptr<Skeleton>} skeleton - The skeleton to bind.
+     * @param {Matrix4} [bindMatrix] - The bind matrix. Defaults to the current world matrix of this mesh.
+     */
+    void bind(std::shared_ptr<Skeleton> skeleton);
+    void bind(std::shared_ptr<Skeleton> skeleton, const Matrix4 &bindMatrix);
+    /**
+     * This method sets the skinned mesh in the rest pose.
+     */
+    void pose();
+    /**
+     * Normalizes the skin weights which are defined in the `skinWeight` attribute.
+     */
+    void normalizeSkinWeights();
+    void updateMatrixWorld(bool force = false) override;
+    /**
+     * Applies the bone transform associated with the given index to the given
+     * vertex position. Returns the updated vector.
+     *
+     * @param {size_t} index - The vertex index.
+     * @param {Vector3} target - The target object that is used to store the method's result.
+     * @return {Vector3} The updated vertex position.
+     */
+    Vector3 &applyBoneTransform(size_t index, Vector3 &target) const;
+
+    /**
+     * Runs the CPU skinning kernel for this mesh. The skeleton palette must
+     * have been updated with {@link Skeleton#update}.
+     *
+     * @param {CPUSkinning::SkinningMethod} [method=LinearBlend] - Linear blend or dual quaternion skinning.
+     */
+    void computeSkinnedAttributes(CPUSkinning::SkinningMethod method = CPUSkinning::SkinningMethod::LinearBlend);
+
+    /**
+     * Positions produced by the last CPU skinning pass, or `nullptr`.
+     *
+     * @return {std::shared_ptr<BufferAttribute>}
+     */
+    std::shared_ptr<BufferAttribute> skinnedPosition() const;
+    /**
+     * Normals produced by the last CPU skinning pass, or `nullptr`.
+     *
+     * @return {std::shared_ptr<BufferAttribute>}
+     */
+    std::shared_ptr<BufferAttribute> skinnedNormal() const;
+    /**
+     * Makes sure the skinned output attributes exist and match the vertex
+     * count of the geometry.
+     */
+    void allocateSkinnedAttributes();
+
+private:
+    friend void CPUSkinning::skinMesh(SkinnedMesh &mesh, CPUSkinning::SkinningMethod method, bool parallel);
+
+    /**
+     * Validates the skin attributes against `boneCount` unless the same
+     * attributes at the same version already passed for it.
+     */
+    void validateSkinAttributes(size_t boneCount);
+
+    std::shared_ptr<Skeleton> m_skeleton;
+    Matrix4 m_bindMatrix;
+    Matrix4 m_bindMatrixInverse;
+    std::shared_ptr<BufferAttribute> m_skinnedPosition;
+    std::shared_ptr<BufferAttribute> m_skinnedNormal;
+
+    // CPU skinning scratch, owned per mesh: jobs of one pass read it while
+    // the thread that started the pass may run other passes
+    std::vector<float> m_palette;
+    std::vector<float> m_dualQuaternions;
+
+    // the skin attributes that last passed validation, and for which bone count
+    std::shared_ptr<BufferAttribute> m_validatedSkinIndex;
+    std::shared_ptr<BufferAttribute> m_validatedSkinWeight;
+    unsigned int m_validatedSkinIndexVersion = 0;
+    unsigned int m_validatedSkinWeightVersion = 0;
+    size_t m_validatedVertexCount = 0;
+    size_t m_validatedBoneCount = 0;
+};
+
+#endif
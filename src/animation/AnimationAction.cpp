@@ -0,0 +1,264 @@
+#include "animation/AnimationAction.h"
+#include "animation/AnimationMixer.h"
+#include "math/MathUtils.h"
+#include <algorithm>
+#include <cmath>
+
+AnimationAction::AnimationAction(AnimationMixer *mixer, std::shared_ptr<AnimationClip> clip, Object3D *localRoot)
+    : m_mixer(mixer), m_clip(std::move(clip)), m_localRoot(localRoot)
+{
+    const auto &channels = m_clip->channels();
+    const auto &names = m_clip->channelNames();
+
+    m_cursors.assign(channels.size(), 0);
+    m_bindings.resize(channels.size());
+
+    for (size_t i = 0; i < channels.size(); i++)
+        m_bindings[i] = m_mixer->resolveBinding(names[i], m_localRoot, channels[i]);
+
+    // a clip may hold two tracks of the same name; only the first one is
+    // played, so no two channels of an action write the same binding
+    std::vector<uint32_t> seen(m_bindings);
+    std::sort(seen.begin(), seen.end());
+
+    if (std::adjacent_find(seen.begin(), seen.end(), [](uint32_t a, uint32_t b)
+                           { return a == b && a != AnimationMixer::NO_BINDING; }) != seen.end())
+    {
+        std::vector<bool> bound(m_mixer->bindingCount(), false);
+
+        for (auto &binding : m_bindings)
+        {
+            if (binding == AnimationMixer::NO_BINDING)
+                continue;
+            if (bound[binding])
+                binding = AnimationMixer::NO_BINDING;
+            else
+                bound[binding] = true;
+        }
+    }
+}
+
+AnimationAction::~AnimationAction()
+{
+}
+
+AnimationAction &AnimationAction::play()
+{
+    m_mixer->activateAction(this);
+    return *this;
+}
+
+AnimationAction &AnimationAction::stop()
+{
+    m_mixer->deactivateAction(this);
+    return this->reset();
+}
+
+AnimationAction &AnimationAction::reset()
+{
+    paused = false;
+    enabled = true;
+
+    time = 0;
+    m_loopCount = -1;
+    std::fill(m_cursors.begin(), m_cursors.end(), 0);
+
+    return this->stopFading();
+}
+
+bool AnimationAction::isRunning() const
+{
+    return enabled && !paused && timeScale != 0 && m_mixer->isActive(this);
+}
+
+bool AnimationAction::isScheduled() const
+{
+    return m_mixer->isActive(this);
+}
+
+AnimationAction &AnimationAction::setLoop(LoopMode mode, int repetitions)
+{
+    this->loop = mode;
+    this->repetitions = repetitions;
+    return *this;
+}
+
+AnimationAction &AnimationAction::setEffectiveWeight(float weight)
+{
+    this->weight = weight;
+
+    // note: same logic as when updated at runtime
+    m_effectiveWeight = enabled ? weight : 0;
+
+    return this->stopFading();
+}
+
+float AnimationAction::getEffectiveWeight() const
+{
+    return m_effectiveWeight;
+}
+
+AnimationAction &AnimationAction::fadeIn(float duration)
+{
+    scheduleFading(duration, 0, 1);
+    return *this;
+}
+
+AnimationAction &AnimationAction::fadeOut(float duration)
+{
+    scheduleFading(duration, 1, 0);
+    return *this;
+}
+
+AnimationAction &AnimationAction::crossFadeTo(AnimationAction &fadeInAction, float duration)
+{
+    this->fadeOut(duration);
+    fadeInAction.fadeIn(duration);
+    return *this;
+}
+
+AnimationAction &AnimationAction::stopFading()
+{
+    m_fading = false;
+    return *this;
+}
+
+AnimationMixer *AnimationAction::getMixer() const
+{
+    return m_mixer;
+}
+
+std::shared_ptr<AnimationClip> AnimationAction::getClip() const
+{
+    return m_clip;
+}
+
+Object3D *AnimationAction::getRoot() const
+{
+    return m_localRoot;
+}
+
+float AnimationAction::updateTime(float deltaTime)
+{
+    const float duration = m_clip->duration();
+
+    if (paused)
+        deltaTime = 0;
+    else
+        deltaTime *= timeScale;
+
+    float t = time + deltaTime;
+
+    if (deltaTime != 0)
+    {
+        if (loop == LoopMode::Once)
+        {
+            if (m_loopCount == -1)
+                m_loopCount = 0;
+
+            bool finished = false;
+
+            if (t >= duration)
+            {
+                t = duration;
+                finished = true;
+            }
+            else if (t < 0)
+            {
+                t = 0;
+                finished = true;
+            }
+
+            if (finished)
+            {
+                if (clampWhenFinished)
+                    paused = true;
+                else
+                    enabled = false;
+            }
+        }
+        else
+        {
+            if (m_loopCount == -1)
+                m_loopCount = 0;
+
+            if (duration <= 0)
+            {
+                t = 0;
+            }
+            else if (t >= duration || t < 0)
+            {
+                // wrap around
+
+                const float loopDelta = std::floor(t / duration);
+                t -= duration * loopDelta;
+                m_loopCount += static_cast<int>(std::abs(loopDelta));
+
+                if (m_loopCount >= repetitions)
+                {
+                    // have to stop (switch state, clamp time)
+
+                    if (clampWhenFinished)
+                        paused = true;
+                    else
+                        enabled = false;
+
+                    t = deltaTime > 0 ? duration : 0;
+                    m_loopCount = repetitions - 1;
+                }
+            }
+        }
+    }
+
+    time = t;
+
+    if (loop == LoopMode::PingPong && (m_loopCount & 1) == 1)
+    {
+        // invert time for the "pong round"
+        return duration - t;
+    }
+
+    return t;
+}
+
+float AnimationAction::updateWeight(float mixerTime)
+{
+    float w = 0;
+
+    if (enabled)
+    {
+        w = weight;
+
+        if (m_fading)
+        {
+            const float fadeEnd = m_fadeStart + m_fadeDuration;
+
+            if (mixerTime >= fadeEnd || m_fadeDuration <= 0)
+            {
+                w *= m_fadeTo;
+                m_fading = false;
+
+                // faded out, disable
+                if (m_fadeTo == 0)
+                    enabled = false;
+            }
+            else
+            {
+                const float alpha = (mixerTime - m_fadeStart) / m_fadeDuration;
+                w *= MathUtils::lerp(m_fadeFrom, m_fadeTo, std::max(alpha, 0.0f));
+            }
+        }
+    }
+
+    m_effectiveWeight = w;
+    return w;
+}
+
+void AnimationAction::scheduleFading(float duration, float weightNow, float weightThen)
+{
+    m_fading = true;
+    m_fadeStart = m_mixer->time;
+    m_fadeDuration = duration;
+    m_fadeFrom = weightNow;
+    m_fadeTo = weightThen;
+}
@@ -0,0 +1,170 @@
+#include "animation/AnimationClip.h"
+#include "math/MathUtils.h"
+#include <algorithm>
+
+AnimationClip::AnimationClip(std::string name, float duration, std::vector<std::shared_ptr<KeyframeTrack>> tracks)
+    : m_name(std::move(name)), m_duration(duration), m_tracks(std::move(tracks))
+{
+    m_uuid = MathUtils::generateUUID();
+
+    // this means it should figure out its duration by scanning the tracks
+    if (m_duration < 0)
+        resetDuration();
+
+    pack();
+}
+
+AnimationClip::~AnimationClip()
+{
+}
+
+const std::string &AnimationClip::uuid() const
+{
+    return m_uuid;
+}
+
+void AnimationClip::uuid(const std::string &value)
+{
+    m_uuid = value;
+}
+
+const std::string &AnimationClip::name() const
+{
+    return m_name;
+}
+
+float AnimationClip::duration() const
+{
+    return m_duration;
+}
+
+const std::vector<std::shared_ptr<KeyframeTrack>> &AnimationClip::tracks() const
+{
+    return m_tracks;
+}
+
+const std::vector<AnimationClip::Channel> &AnimationClip::channels() const
+{
+    return m_channels;
+}
+
+const std::vector<float> &AnimationClip::packedTimes() const
+{
+    return m_times;
+}
+
+const std::vector<float> &AnimationClip::packedValues() const
+{
+    return m_values;
+}
+
+const std::vector<std::string> &AnimationClip::channelNames() const
+{
+    return m_channelNames;
+}
+
+AnimationClip &AnimationClip::resetDuration()
+{
+    float duration = 0;
+
+    for (auto &track : m_tracks)
+        duration = std::max(duration, track->times().back());
+
+    m_duration = duration;
+
+    return *this;
+}
+
+AnimationClip &AnimationClip::trim()
+{
+    for (auto &track : m_tracks)
+        track->trim(0, m_duration);
+
+    pack();
+
+    return *this;
+}
+
+AnimationClip &AnimationClip::optimize()
+{
+    for (auto &track : m_tracks)
+        track->optimize();
+
+    pack();
+
+    return *this;
+}
+
+bool AnimationClip::validate() const
+{
+    return std::all_of(m_tracks.begin(), m_tracks.end(),
+                       [](const std::shared_ptr<KeyframeTrack> &track)
+                       { return track->validate(); });
+}
+
+void AnimationClip::pack()
+{
+    if (m_compressed)
+        return;
+
+    size_t timeCount = 0, valueCount = 0;
+    for (auto &track : m_tracks)
+    {
+        timeCount += track->times().size();
+        valueCount += track->values().size();
+    }
+
+    m_channels.clear();
+    m_channels.reserve(m_tracks.size());
+    m_times.clear();
+    m_times.reserve(timeCount);
+    m_values.clear();
+    m_values.reserve(valueCount);
+    m_channelNames.clear();
+    m_channelNames.reserve(m_tracks.size());
+
+    for (auto &track : m_tracks)
+    {
+        Channel channel;
+        channel.timeOffset = static_cast<uint32_t>(m_times.size());
+        channel.keyCount = static_cast<uint32_t>(track->keyCount());
+        channel.valueOffset = static_cast<uint32_t>(m_values.size());
+        channel.valueSize = static_cast<uint32_t>(track->getValueSize());
+        channel.interpolation = track->interpolation();
+        channel.type = track->valueType();
+        m_channels.push_back(channel);
+
+        m_times.insert(m_times.end(), track->times().begin(), track->times().end());
+        m_values.insert(m_values.end(), track->values().begin(), track->values().end());
+        m_channelNames.push_back(track->name());
+    }
+}
+
+AnimationClip &AnimationClip::compress(const AnimationCompression::Settings &settings)
+{
+    if (m_compressed)
+        return *this;
+
+    m_compressed = std::make_shared<AnimationCompression::CompressedClip>(AnimationCompression::compress(*this, settings));
+
+    // the channel headers keep describing mode, type and value size; offsets
+    // into the released buffers are meaningless from here on
+    for (size_t i = 0; i < m_channels.size(); i++)
+        m_channels[i].keyCount = m_compressed->channels[i].keyCount;
+
+    m_tracks = {};
+    m_times = {};
+    m_values = {};
+
+    return *this;
+}
+
+bool AnimationClip::isCompressed() const
+{
+    return m_compressed != nullptr;
+}
+
+const AnimationCompression::CompressedClip *AnimationClip::compressed() const
+{
+    return m_compressed.get();
+}
@@ -0,0 +1,719 @@
+#include "animation/AnimationCompression.h"
+#include "animation/AnimationClip.h"
+#include "animation/Interpolant.h"
+#include "common/Parallel.h"
+#include "math/MathUtils.h"
+#include "math/Quaternion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <string_view>
+
+namespace AnimationCompression
+{
+    static constexpr float TIME_STEPS = 65535.0f;
+    static constexpr float VALUE_STEPS = 65535.0f;
+    // frame rates tried when looking for a grid that holds every key time
+    static constexpr float FRAME_RATES[] = {24, 25, 30, 48, 50, 60, 90, 120, 240};
+    static constexpr float QUATERNION_STEPS = 32767.0f;
+    static constexpr float SQRT1_2 = 0.70710678f;
+
+    double Stats::ratio() const
+    {
+        return bytesAfter == 0 ? 0.0 : static_cast<double>(bytesBefore) / static_cast<double>(bytesAfter);
+    }
+
+    double ErrorReport::throughput() const
+    {
+        return decodeSeconds <= 0 ? 0.0 : static_cast<double>(samples) / decodeSeconds;
+    }
+
+    // smallest-three: drop the largest component (recoverable from unit length),
+    // flip the sign so it is positive and store the other three in [-1/√2, 1/√2]
+
+    static void encodeQuaternion(const float *q, uint16_t *words)
+    {
+        uint32_t largest = 0;
+        for (uint32_t k = 1; k < 4; k++)
+        {
+            if (std::abs(q[k]) > std::abs(q[largest]))
+                largest = k;
+        }
+
+        const float sign = q[largest] < 0 ? -1.0f : 1.0f;
+
+        uint64_t bits = largest;
+        uint32_t shift = 2;
+        for (uint32_t k = 0; k < 4; k++)
+        {
+            if (k == largest)
+                continue;
+
+            const float v = std::clamp(q[k] * sign / SQRT1_2 * 0.5f + 0.5f, 0.0f, 1.0f);
+            bits |= static_cast<uint64_t>(std::lround(v * QUATERNION_STEPS)) << shift;
+            shift += 15;
+        }
+
+        words[0] = static_cast<uint16_t>(bits);
+        words[1] = static_cast<uint16_t>(bits >> 16);
+        words[2] = static_cast<uint16_t>(bits >> 32);
+    }
+
+    static inline void decodeQuaternion(const uint16_t *words, float *q)
+    {
+        const uint64_t bits = static_cast<uint64_t>(words[0]) |
+                              static_cast<uint64_t>(words[1]) << 16 |
+                              static_cast<uint64_t>(words[2]) << 32;
+
+        const uint32_t largest = static_cast<uint32_t>(bits & 3);
+
+        float sumSq = 0;
+        uint32_t shift = 2;
+        for (uint32_t k = 0; k < 4; k++)
+        {
+            if (k == largest)
+                continue;
+
+            const float v = static_cast<float>((bits >> shift) & 0x7FFF) / QUATERNION_STEPS;
+            q[k] = (v * 2.0f - 1.0f) * SQRT1_2;
+            sumSq += q[k] * q[k];
+            shift += 15;
+        }
+
+        q[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+    }
+
+    namespace
+    {
+        // the keys of one track, inside a CompressedClip or still being encoded
+        struct TrackView
+        {
+            const Channel *channel;
+            float timeScale;
+            const uint16_t *times;
+            const float *exactTimes;
+            const uint16_t *data;
+            const float *values;
+            const float *range;
+        };
+    }
+
+    // key time in the units `sampleUnits` maps sample times to
+    static inline float keyUnits(const TrackView &track, uint32_t i)
+    {
+        return track.channel->timeFormat == KeyFormat::Float ? track.exactTimes[i] : static_cast<float>(track.times[i]);
+    }
+
+    static inline float sampleUnits(const TrackView &track, float t)
+    {
+        return track.channel->timeFormat == KeyFormat::Float ? t : t * track.timeScale;
+    }
+
+    // component `k` of a non-quaternion key
+    static inline float decodeComponent(const TrackView &track, uint32_t i, uint32_t k)
+    {
+        const uint32_t valueSize = track.channel->valueSize;
+        const size_t offset = static_cast<size_t>(i) * valueSize + k;
+
+        if (track.channel->valueFormat == KeyFormat::Float)
+            return track.values[offset];
+
+        return track.range[k] + track.range[valueSize + k] * static_cast<float>(MathUtils::denormalize<uint16_t>(track.data[offset]));
+    }
+
+    static inline void decodeKey(const TrackView &track, uint32_t i, float *result)
+    {
+        const Channel &channel = *track.channel;
+
+        if (channel.type == TrackValueType::Quaternion && channel.valueFormat == KeyFormat::Quantized)
+        {
+            decodeQuaternion(track.data + static_cast<size_t>(i) * 3, result);
+            return;
+        }
+
+        for (uint32_t k = 0; k < channel.valueSize; k++)
+            result[k] = decodeComponent(track, i, k);
+    }
+
+    static void encodeKey(const Channel &channel, const float *range, const float *value, uint16_t *words)
+    {
+        if (channel.type == TrackValueType::Quaternion)
+        {
+            encodeQuaternion(value, words);
+            return;
+        }
+
+        for (uint32_t k = 0; k < channel.valueSize; k++)
+        {
+            const float extent = range[channel.valueSize + k];
+            words[k] = extent > 0 ? MathUtils::normalize<uint16_t>((value[k] - range[k]) / extent) : 0;
+        }
+    }
+
+    // interpolates two decoded keys; `alpha` already accounts for the mode
+    static inline void blend(const Channel &channel, const float *a, const float *b, float alpha, float *result)
+    {
+        if (channel.type == TrackValueType::Quaternion)
+        {
+            Quaternion::slerpFlat(result, 0, a, 0, b, 0, alpha);
+            return;
+        }
+
+        for (uint32_t k = 0; k < channel.valueSize; k++)
+            result[k] = MathUtils::lerp(a[k], b[k], alpha);
+    }
+
+    static inline float keyAlpha(float t, float t0, float t1)
+    {
+        const float span = t1 - t0;
+        return span > 0 ? (t - t0) / span : 1.0f;
+    }
+
+    // angle between two unit quaternions, or the largest component difference
+    static inline float keyError(const Channel &channel, const float *a, const float *b)
+    {
+        if (channel.type == TrackValueType::Quaternion)
+        {
+            // from the chord length: acos of a dot product close to 1 is too
+            // coarse in float for tolerances around 1e-4
+            const float sign = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0 ? -1.0f : 1.0f;
+
+            float chordSq = 0;
+            for (uint32_t k = 0; k < 4; k++)
+                chordSq += (a[k] - sign * b[k]) * (a[k] - sign * b[k]);
+
+            return 4.0f * std::asin(std::min(std::sqrt(chordSq) * 0.5f, 1.0f));
+        }
+
+        float error = 0;
+        for (uint32_t k = 0; k < channel.valueSize; k++)
+            error = std::max(error, std::abs(a[k] - b[k]));
+
+        return error;
+    }
+
+    // leaves room for float rounding in the two samplers being compared
+    static inline bool exceedsTolerance(float error, float tolerance)
+    {
+        return error > tolerance * 1.01f + 1e-6f;
+    }
+
+    static float toleranceFor(const std::string &trackName, TrackValueType type, const Settings &settings)
+    {
+        if (type == TrackValueType::Quaternion)
+            return settings.rotationTolerance;
+
+        const auto dot = trackName.find_last_of('.');
+        const auto property = dot == std::string::npos ? std::string_view() : std::string_view(trackName).substr(dot + 1);
+
+        if (property == "position")
+            return settings.translationTolerance;
+
+        if (property == "scale")
+            return settings.scaleTolerance;
+
+        return settings.valueTolerance;
+    }
+
+    // key times in 16-bit ticks: whole frames when every key sits on the
+    // grid of a common frame rate (exact), else 65535 ticks over the duration
+
+    static bool onGrid(const float *times, size_t count, float rate)
+    {
+        return std::all_of(times, times + count, [rate](float time)
+                           { return std::abs(time * rate - std::round(time * rate)) < 1e-3f; });
+    }
+
+    static float chooseTimeScale(const std::vector<float> &times, float duration)
+    {
+        if (duration <= 0)
+            return 0;
+
+        for (float rate : FRAME_RATES)
+        {
+            if (duration * rate > TIME_STEPS)
+                break;
+
+            if (onGrid(times.data(), times.size(), rate))
+                return rate;
+        }
+
+        return TIME_STEPS / duration;
+    }
+
+    namespace
+    {
+        struct EncodedTrack
+        {
+            Channel channel;
+            std::vector<uint16_t> times;
+            std::vector<float> exactTimes;
+            std::vector<uint16_t> data;
+            std::vector<float> values;
+            std::vector<float> ranges;
+
+            TrackView view(float timeScale) const
+            {
+                return {&channel, timeScale, times.data(), exactTimes.data(), data.data(), values.data(), ranges.data()};
+            }
+        };
+    }
+
+    static void sampleTrack(const TrackView &track, float t, uint32_t &cursor, float *result)
+    {
+        const Channel &channel = *track.channel;
+        const uint32_t count = channel.keyCount;
+        const float u = sampleUnits(track, t);
+
+        if (count == 1 || u <= keyUnits(track, 0))
+        {
+            cursor = 0;
+            decodeKey(track, 0, result);
+            return;
+        }
+
+        if (u >= keyUnits(track, count - 1))
+        {
+            cursor = count - 2;
+            decodeKey(track, count - 1, result);
+            return;
+        }
+
+        const uint32_t i = channel.timeFormat == KeyFormat::Float
+                               ? Interpolant::seek(track.exactTimes, count, u, cursor)
+                               : Interpolant::seek(track.times, count, u, cursor);
+
+        if (channel.interpolation == InterpolationMode::Discrete)
+        {
+            decodeKey(track, i, result);
+            return;
+        }
+
+        const float t0 = keyUnits(track, i), t1 = keyUnits(track, i + 1);
+        const float alpha = channel.interpolation == InterpolationMode::Smooth
+                                ? MathUtils::smoothstep(u, t0, t1)
+                                : keyAlpha(u, t0, t1);
+
+        if (channel.type == TrackValueType::Quaternion)
+        {
+            float q0[4], q1[4];
+            decodeKey(track, i, q0);
+            decodeKey(track, i + 1, q1);
+            Quaternion::slerpFlat(result, 0, q0, 0, q1, 0, alpha);
+            return;
+        }
+
+        // per component, so tracks of any width need no scratch
+        for (uint32_t k = 0; k < channel.valueSize; k++)
+            result[k] = MathUtils::lerp(decodeComponent(track, i, k), decodeComponent(track, i + 1, k), alpha);
+    }
+
+    // 16 bits per component hold every key within tolerance only while half a
+    // quantization step stays below it
+    static bool fitsQuantization(const Channel &channel, const float *values)
+    {
+        if (channel.type == TrackValueType::Quaternion)
+            return true;
+
+        for (uint32_t k = 0; k < channel.valueSize; k++)
+        {
+            float lo = values[k], hi = values[k];
+            for (uint32_t i = 1; i < channel.keyCount; i++)
+            {
+                lo = std::min(lo, values[i * channel.valueSize + k]);
+                hi = std::max(hi, values[i * channel.valueSize + k]);
+            }
+
+            if ((hi - lo) / VALUE_STEPS > 2.0f * channel.tolerance)
+                return false;
+        }
+
+        return true;
+    }
+
+    // encodes the keys in the formats set on `channel`; with `reduce`, linear
+    // tracks drop the keys their neighbours reproduce within tolerance
+
+    static EncodedTrack encodeKeys(Channel channel, const float *times, const float *values, float timeScale, bool reduce)
+    {
+        const uint32_t count = channel.keyCount;
+        const uint32_t valueSize = channel.valueSize;
+        const bool quantizedValues = channel.valueFormat == KeyFormat::Quantized;
+        const uint32_t words = channel.type == TrackValueType::Quaternion ? 3 : valueSize;
+
+        EncodedTrack all;
+        all.channel = channel;
+
+        // per component range for quantized values of everything but quaternions
+
+        if (quantizedValues && channel.type != TrackValueType::Quaternion)
+        {
+            all.ranges.resize(2 * static_cast<size_t>(valueSize));
+
+            for (uint32_t k = 0; k < valueSize; k++)
+            {
+                float lo = values[k], hi = values[k];
+                for (uint32_t i = 1; i < count; i++)
+                {
+                    lo = std::min(lo, values[i * valueSize + k]);
+                    hi = std::max(hi, values[i * valueSize + k]);
+                }
+
+                all.ranges[k] = lo;
+                all.ranges[valueSize + k] = hi - lo;
+            }
+        }
+
+        if (channel.timeFormat == KeyFormat::Float)
+        {
+            all.exactTimes.assign(times, times + count);
+        }
+        else
+        {
+            all.times.resize(count);
+            for (uint32_t i = 0; i < count; i++)
+                all.times[i] = static_cast<uint16_t>(std::clamp(std::round(times[i] * timeScale), 0.0f, TIME_STEPS));
+        }
+
+        if (quantizedValues)
+        {
+            all.data.resize(static_cast<size_t>(count) * words);
+            for (uint32_t i = 0; i < count; i++)
+                encodeKey(channel, all.ranges.data(), values + i * valueSize, all.data.data() + i * words);
+        }
+        else
+        {
+            all.values.assign(values, values + static_cast<size_t>(count) * valueSize);
+        }
+
+        if (!reduce || channel.interpolation != InterpolationMode::Linear)
+            return all;
+
+        // decode every key again so key reduction measures the error that
+        // sampling will actually produce
+
+        const TrackView view = all.view(timeScale);
+        const float unitScale = channel.timeFormat == KeyFormat::Float ? 1.0f : timeScale;
+
+        std::vector<float> decoded(static_cast<size_t>(count) * valueSize);
+        for (uint32_t i = 0; i < count; i++)
+            decodeKey(view, i, decoded.data() + i * valueSize);
+
+        std::vector<uint32_t> kept;
+        kept.reserve(count);
+        kept.push_back(0);
+
+        // greedy: extend each segment while every skipped key is reproduced
+        // within tolerance
+
+        std::vector<float> sample(valueSize);
+        uint32_t a = 0;
+
+        while (a + 1 < count)
+        {
+            uint32_t b = a + 1;
+
+            while (b + 1 < count)
+            {
+                const uint32_t candidate = b + 1;
+                bool fits = true;
+
+                for (uint32_t i = a + 1; i < candidate && fits; i++)
+                {
+                    // the sampler sees the exact key time, not its quantized one
+                    const float alpha = keyAlpha(times[i] * unitScale, keyUnits(view, a), keyUnits(view, candidate));
+                    blend(channel, decoded.data() + a * valueSize, decoded.data() + candidate * valueSize, alpha, sample.data());
+                    fits = keyError(channel, sample.data(), values + i * valueSize) <= channel.tolerance;
+                }
+
+                if (!fits)
+                    break;
+
+                b = candidate;
+            }
+
+            kept.push_back(b);
+            a = b;
+        }
+
+        // a constant track needs a single key
+        if (kept.size() == 2 && keyError(channel, decoded.data(), decoded.data() + kept[1] * valueSize) == 0)
+            kept.pop_back();
+
+        EncodedTrack track;
+        track.ranges = std::move(all.ranges);
+
+        for (auto i : kept)
+        {
+            if (channel.timeFormat == KeyFormat::Float)
+                track.exactTimes.push_back(all.exactTimes[i]);
+            else
+                track.times.push_back(all.times[i]);
+
+            if (quantizedValues)
+                track.data.insert(track.data.end(), all.data.begin() + i * words, all.data.begin() + (i + 1) * words);
+            else
+                track.values.insert(track.values.end(), all.values.begin() + i * valueSize, all.values.begin() + (i + 1) * valueSize);
+        }
+
+        channel.keyCount = static_cast<uint32_t>(kept.size());
+        track.channel = channel;
+
+        return track;
+    }
+
+    // samples the encoded track at every source and kept key time and halfway
+    // between them, and compares it with the source through Interpolant
+
+    static bool matchesSource(const EncodedTrack &track, float timeScale, const float *times, const float *values, uint32_t count)
+    {
+        const Channel &channel = track.channel;
+        const TrackView view = track.view(timeScale);
+
+        // a discrete track jumps at its (rounded) key times; compare the steps
+        // between the source keys instead of the jumps themselves
+        const bool atKeys = channel.interpolation != InterpolationMode::Discrete;
+
+        std::vector<float> keyTimes(times, times + count);
+        for (uint32_t i = 0; atKeys && i < channel.keyCount; i++)
+            keyTimes.push_back(channel.timeFormat == KeyFormat::Float ? keyUnits(view, i) : timeScale > 0 ? keyUnits(view, i) / timeScale : 0.0f);
+
+        std::sort(keyTimes.begin(), keyTimes.end());
+        keyTimes.erase(std::unique(keyTimes.begin(), keyTimes.end()), keyTimes.end());
+
+        std::vector<float> exact(channel.valueSize), sample(channel.valueSize);
+        uint32_t referenceCursor = 0, cursor = 0;
+
+        const auto matches = [&](float t)
+        {
+            Interpolant::evaluate(times, values, count, channel.valueSize, channel.interpolation, channel.type, t, referenceCursor, exact.data());
+            sampleTrack(view, t, cursor, sample.data());
+
+            return !exceedsTolerance(keyError(channel, sample.data(), exact.data()), channel.tolerance);
+        };
+
+        for (size_t i = 0; i < keyTimes.size(); i++)
+        {
+            if (atKeys && !matches(keyTimes[i]))
+                return false;
+
+            if (i + 1 < keyTimes.size() && !matches(0.5f * (keyTimes[i] + keyTimes[i + 1])))
+                return false;
+        }
+
+        return atKeys || keyTimes.size() != 1 || matches(keyTimes[0]);
+    }
+
+    // tries the most compact encoding first and falls back while the track
+    // leaves its tolerance
+
+    static EncodedTrack encodeTrack(Channel channel, const float *times, const float *values, float timeScale)
+    {
+        // rounding the key times of a discrete track moves its jumps, which
+        // no value tolerance covers
+        const bool roundsTimes = channel.interpolation == InterpolationMode::Discrete && !onGrid(times, channel.keyCount, timeScale);
+
+        channel.timeFormat = roundsTimes ? KeyFormat::Float : KeyFormat::Quantized;
+        channel.valueFormat = fitsQuantization(channel, values) ? KeyFormat::Quantized : KeyFormat::Float;
+
+        for (;;)
+        {
+            EncodedTrack track = encodeKeys(channel, times, values, timeScale, true);
+
+            if (matchesSource(track, timeScale, times, values, channel.keyCount))
+                return track;
+
+            if (channel.valueFormat == KeyFormat::Quantized)
+                channel.valueFormat = KeyFormat::Float;
+            else if (channel.timeFormat == KeyFormat::Quantized)
+                channel.timeFormat = KeyFormat::Float;
+            else
+                break;
+        }
+
+        // float rounding of the reduced keys still adds up past the tolerance:
+        // keep the source keys as they are
+        return encodeKeys(channel, times, values, timeScale, false);
+    }
+
+    CompressedClip compress(const AnimationClip &clip, const Settings &settings)
+    {
+        const auto &sourceChannels = clip.channels();
+        const auto &names = clip.channelNames();
+        const float *times = clip.packedTimes().data();
+        const float *values = clip.packedValues().data();
+
+        CompressedClip result;
+        result.duration = clip.duration();
+
+        result.timeScale = chooseTimeScale(clip.packedTimes(), result.duration);
+        const float timeScale = result.timeScale;
+
+        std::vector<EncodedTrack> tracks(sourceChannels.size());
+
+        Parallel::parallelFor(0, sourceChannels.size(), 16, [&](size_t begin, size_t end)
+                              {
+            for (size_t i = begin; i < end; i++)
+            {
+                const auto &source = sourceChannels[i];
+
+                Channel channel{};
+                channel.keyCount = source.keyCount;
+                channel.valueSize = source.valueSize;
+                channel.interpolation = source.interpolation;
+                channel.type = source.type;
+                channel.tolerance = toleranceFor(names[i], source.type, settings);
+
+                tracks[i] = encodeTrack(channel, times + source.timeOffset, values + source.valueOffset, timeScale);
+            } });
+
+        // concatenate
+
+        size_t timeCount = 0, exactTimeCount = 0, dataCount = 0, valueCount = 0, rangeCount = 0;
+        for (auto &track : tracks)
+        {
+            timeCount += track.times.size();
+            exactTimeCount += track.exactTimes.size();
+            dataCount += track.data.size();
+            valueCount += track.values.size();
+            rangeCount += track.ranges.size();
+        }
+
+        result.channels.reserve(tracks.size());
+        result.times.reserve(timeCount);
+        result.exactTimes.reserve(exactTimeCount);
+        result.data.reserve(dataCount);
+        result.values.reserve(valueCount);
+        result.ranges.reserve(rangeCount);
+
+        auto &stats = result.stats;
+
+        for (auto &track : tracks)
+        {
+            auto &channel = track.channel;
+            const bool exactTimes = channel.timeFormat == KeyFormat::Float;
+            const bool floatValues = channel.valueFormat == KeyFormat::Float;
+
+            channel.timeOffset = static_cast<uint32_t>(exactTimes ? result.exactTimes.size() : result.times.size());
+            channel.dataOffset = static_cast<uint32_t>(floatValues ? result.values.size() : result.data.size());
+            channel.rangeOffset = static_cast<uint32_t>(result.ranges.size());
+            result.channels.push_back(channel);
+
+            result.times.insert(result.times.end(), track.times.begin(), track.times.end());
+            result.exactTimes.insert(result.exactTimes.end(), track.exactTimes.begin(), track.exactTimes.end());
+            result.data.insert(result.data.end(), track.data.begin(), track.data.end());
+            result.values.insert(result.values.end(), track.values.begin(), track.values.end());
+            result.ranges.insert(result.ranges.end(), track.ranges.begin(), track.ranges.end());
+
+            stats.keysAfter += channel.keyCount;
+            stats.floatTimeChannels += exactTimes;
+            stats.floatValueChannels += floatValues;
+        }
+
+        stats.keysBefore = clip.packedTimes().size();
+        stats.bytesBefore = sourceChannels.size() * sizeof(AnimationClip::Channel) +
+                            (clip.packedTimes().size() + clip.packedValues().size()) * sizeof(float);
+        stats.bytesAfter = result.channels.size() * sizeof(Channel) +
+                           (result.times.size() + result.data.size()) * sizeof(uint16_t) +
+                           (result.exactTimes.size() + result.values.size() + result.ranges.size()) * sizeof(float);
+
+        return result;
+    }
+
+    void evaluate(const CompressedClip &clip, size_t index, float t, uint32_t &cursor, float *result)
+    {
+        const auto &channel = clip.channels[index];
+        const bool exactTimes = channel.timeFormat == KeyFormat::Float;
+        const bool floatValues = channel.valueFormat == KeyFormat::Float;
+
+        TrackView track{&channel, clip.timeScale, nullptr, nullptr, nullptr, nullptr, nullptr};
+
+        if (exactTimes)
+            track.exactTimes = clip.exactTimes.data() + channel.timeOffset;
+        else
+            track.times = clip.times.data() + channel.timeOffset;
+
+        if (floatValues)
+            track.values = clip.values.data() + channel.dataOffset;
+        else
+            track.data = clip.data.data() + channel.dataOffset;
+
+        if (!clip.ranges.empty())
+            track.range = clip.ranges.data() + channel.rangeOffset;
+
+        sampleTrack(track, t, cursor, result);
+    }
+
+    ErrorReport measureError(const AnimationClip &reference, const CompressedClip &compressed, float sampleRate)
+    {
+        const auto &channels = reference.channels();
+        const float *times = reference.packedTimes().data();
+        const float *values = reference.packedValues().data();
+
+        const size_t steps = static_cast<size_t>(std::ceil(reference.duration() * sampleRate));
+        const auto sampleTime = [&](size_t s)
+        { return std::min(static_cast<float>(s) / sampleRate, reference.duration()); };
+
+        size_t maxValueSize = 0;
+        for (const auto &channel : channels)
+            maxValueSize = std::max<size_t>(maxValueSize, channel.valueSize);
+
+        ErrorReport report;
+        std::vector<float> exact(maxValueSize), sample(maxValueSize);
+
+        for (size_t c = 0; c < channels.size(); c++)
+        {
+            const auto &channel = channels[c];
+            const auto &target = compressed.channels[c];
+            uint32_t referenceCursor = 0, cursor = 0;
+            float channelError = 0;
+
+            for (size_t s = 0; s <= steps; s++)
+            {
+                const float t = sampleTime(s);
+
+                Interpolant::evaluate(times + channel.timeOffset, values + channel.valueOffset, channel.keyCount, channel.valueSize,
+                                      channel.interpolation, channel.type, t, referenceCursor, exact.data());
+                evaluate(compressed, c, t, cursor, sample.data());
+
+                channelError = std::max(channelError, keyError(target, sample.data(), exact.data()));
+            }
+
+            if (channel.type == TrackValueType::Quaternion)
+                report.maxRotationError = std::max(report.maxRotationError, channelError);
+            else
+                report.maxValueError = std::max(report.maxValueError, channelError);
+
+            if (exceedsTolerance(channelError, target.tolerance))
+                report.channelsOutOfTolerance++;
+        }
+
+        // decode throughput: the whole clip frame by frame, as the mixer does
+
+        std::vector<uint32_t> cursors(channels.size(), 0);
+        float checksum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t s = 0; s <= steps; s++)
+        {
+            const float t = sampleTime(s);
+
+            for (size_t c = 0; c < channels.size(); c++)
+            {
+                evaluate(compressed, c, t, cursors[c], sample.data());
+                checksum += sample[0];
+            }
+        }
+
+        report.decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report.samples = (steps + 1) * channels.size();
+
+        // keep the decode loop from being optimized away
+        volatile float sink = checksum;
+        (void)sink;
+
+        return report;
+    }
+}
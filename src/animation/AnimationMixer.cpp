@@ -0,0 +1,427 @@
+#include "animation/AnimationMixer.h"
+#include "animation/Interpolant.h"
+#include "core/Object3D.h"
+#include "math/MathUtils.h"
+#include "math/Quaternion.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+// channels (or bindings) per task when a frame is split across threads
+static constexpr size_t CHANNEL_GRAIN = 8192;
+
+// actions taken from the resource at once
+static constexpr size_t ACTIONS_PER_CHUNK = 32;
+
+AnimationMixer::AnimationMixer(Object3D *root, std::pmr::memory_resource *resource)
+    : m_root(root),
+      m_actionPool(ACTIONS_PER_CHUNK, resource),
+      m_actions(resource),
+      m_activeActions(resource),
+      m_bindings(resource),
+      m_accumulator(resource),
+      m_original(resource),
+      m_cumulativeWeight(resource)
+{
+}
+
+AnimationMixer::~AnimationMixer()
+{
+    for (auto action : m_actions)
+        m_actionPool.destroy(action);
+}
+
+AnimationAction *AnimationMixer::clipAction(const std::shared_ptr<AnimationClip> &clip, Object3D *optionalRoot)
+{
+    auto existing = existingAction(clip, optionalRoot);
+    if (existing != nullptr)
+        return existing;
+
+    Object3D *root = optionalRoot != nullptr ? optionalRoot : m_root;
+    m_actions.push_back(m_actionPool.create(this, clip, root));
+
+    return m_actions.back();
+}
+
+AnimationAction *AnimationMixer::existingAction(const std::shared_ptr<AnimationClip> &clip, Object3D *optionalRoot) const
+{
+    Object3D *root = optionalRoot != nullptr ? optionalRoot : m_root;
+
+    for (auto &action : m_actions)
+    {
+        if (action->getClip() == clip && action->getRoot() == root)
+            return action;
+    }
+
+    return nullptr;
+}
+
+void AnimationMixer::registerProperty(const std::string &path, float *target, uint32_t valueSize)
+{
+    m_customProperties[path] = {target, valueSize};
+}
+
+AnimationMixer &AnimationMixer::update(float deltaTime)
+{
+    THREECPP_PROFILE_ZONE("AnimationMixer::update");
+
+    deltaTime *= timeScale;
+    time += deltaTime;
+
+    // sample and accumulate, action by action; every channel goes through the
+    // packed buffers of its clip and the accumulation slot of its binding.
+    // Actions drop repeated tracks of a clip, so no two channels of one
+    // action share a binding and they can be split across threads.
+
+    for (auto action : m_activeActions)
+    {
+        const float clipTime = action->updateTime(deltaTime);
+        const float weight = action->updateWeight(time);
+
+        if (weight <= 0)
+            continue;
+
+        Parallel::parallelFor(0, action->m_cursors.size(), CHANNEL_GRAIN, [this, action, clipTime, weight](size_t begin, size_t end)
+                              { accumulateChannels(*action, clipTime, weight, begin, end); });
+    }
+
+    // apply: one pass over the bindings touched this frame, blending in the
+    // original state for the remaining weight
+
+    Parallel::parallelFor(0, m_bindings.size(), CHANNEL_GRAIN, [this](size_t begin, size_t end)
+                          { applyBindings(begin, end); });
+
+    // retire actions that finished or faded out during this update
+
+    m_activeActions.erase(std::remove_if(m_activeActions.begin(), m_activeActions.end(),
+                                         [](AnimationAction *action)
+                                         { return !action->enabled; }),
+                          m_activeActions.end());
+
+    return *this;
+}
+
+void AnimationMixer::accumulateChannels(AnimationAction &action, float clipTime, float weight, size_t begin, size_t end)
+{
+    const auto &clip = *action.m_clip;
+    const auto *compressed = clip.compressed();
+    const auto *channels = clip.channels().data();
+    const float *times = clip.packedTimes().data();
+    const float *values = clip.packedValues().data();
+    uint32_t *cursors = action.m_cursors.data();
+    const uint32_t *bindings = action.m_bindings.data();
+
+    // channels are as wide as the widest bound one, e.g. all the morph
+    // target influences of a mesh
+    float inlineSample[16];
+    std::vector<float> heapSample;
+    float *sample = inlineSample;
+
+    if (m_maxValueSize > std::size(inlineSample))
+    {
+        heapSample.resize(m_maxValueSize);
+        sample = heapSample.data();
+    }
+
+    for (size_t i = begin; i < end; i++)
+    {
+        const uint32_t b = bindings[i];
+        if (b == NO_BINDING)
+            continue;
+
+        if (compressed != nullptr)
+        {
+            AnimationCompression::evaluate(*compressed, i, clipTime, cursors[i], sample);
+        }
+        else
+        {
+            const auto &channel = channels[i];
+            Interpolant::evaluate(times + channel.timeOffset, values + channel.valueOffset, channel.keyCount, channel.valueSize,
+                                  channel.interpolation, channel.type, clipTime, cursors[i], sample);
+        }
+
+        const auto &binding = m_bindings[b];
+        float *accumulator = m_accumulator.data() + binding.offset;
+        float &cumulativeWeight = m_cumulativeWeight[b];
+
+        if (cumulativeWeight == 0)
+        {
+            std::copy(sample, sample + binding.valueSize, accumulator);
+            cumulativeWeight = weight;
+        }
+        else
+        {
+            cumulativeWeight += weight;
+            const float mix = weight / cumulativeWeight;
+
+            if (binding.valueType == TrackValueType::Quaternion)
+            {
+                Quaternion::slerpFlat(accumulator, 0, accumulator, 0, sample, 0, mix);
+            }
+            else
+            {
+                for (uint32_t k = 0; k < binding.valueSize; k++)
+                    accumulator[k] = MathUtils::lerp(accumulator[k], sample[k], mix);
+            }
+        }
+    }
+}
+
+void AnimationMixer::applyBindings(size_t begin, size_t end)
+{
+    for (size_t b = begin; b < end; b++)
+    {
+        const float cumulativeWeight = m_cumulativeWeight[b];
+        if (cumulativeWeight == 0)
+            continue;
+
+        const auto &binding = m_bindings[b];
+        float *accumulator = m_accumulator.data() + binding.offset;
+        const float *original = m_original.data() + binding.offset;
+
+        if (cumulativeWeight < 1)
+        {
+            if (binding.valueType == TrackValueType::Quaternion)
+            {
+                Quaternion::slerpFlat(accumulator, 0, original, 0, accumulator, 0, cumulativeWeight);
+            }
+            else
+            {
+                for (uint32_t k = 0; k < binding.valueSize; k++)
+                    accumulator[k] = MathUtils::lerp(original[k], accumulator[k], cumulativeWeight);
+            }
+        }
+
+        writeBinding(binding, accumulator);
+        m_cumulativeWeight[b] = 0;
+    }
+}
+
+AnimationMixer &AnimationMixer::setTime(float time)
+{
+    // zero out time attribute for all associated Action objects
+    this->time = 0;
+    for (auto &action : m_actions)
+        action->time = 0;
+
+    // then update the mixer by the requested delta, independent of the time scale
+    const float scale = timeScale;
+    timeScale = 1;
+    update(time);
+    timeScale = scale;
+
+    return *this;
+}
+
+AnimationMixer &AnimationMixer::stopAllAction()
+{
+    auto active = m_activeActions;
+    for (auto action : active)
+        action->stop();
+
+    return *this;
+}
+
+void AnimationMixer::uncacheClip(const std::shared_ptr<AnimationClip> &clip)
+{
+    auto removed = std::stable_partition(m_actions.begin(), m_actions.end(),
+                                         [&clip](AnimationAction *action)
+                                         { return action->getClip() != clip; });
+
+    for (auto it = removed; it != m_actions.end(); ++it)
+    {
+        deactivateAction(*it);
+        m_actionPool.destroy(*it);
+    }
+
+    m_actions.erase(removed, m_actions.end());
+
+    // the scene may have changed since the lookup was built
+    m_nodesByName.clear();
+}
+
+Object3D *AnimationMixer::getRoot() const
+{
+    return m_root;
+}
+
+size_t AnimationMixer::bindingCount() const
+{
+    return m_bindings.size();
+}
+
+size_t AnimationMixer::activeActionCount() const
+{
+    return m_activeActions.size();
+}
+
+void AnimationMixer::activateAction(AnimationAction *action)
+{
+    if (!isActive(action))
+        m_activeActions.push_back(action);
+}
+
+void AnimationMixer::deactivateAction(AnimationAction *action)
+{
+    m_activeActions.erase(std::remove(m_activeActions.begin(), m_activeActions.end(), action), m_activeActions.end());
+}
+
+bool AnimationMixer::isActive(const AnimationAction *action) const
+{
+    return std::find(m_activeActions.begin(), m_activeActions.end(), action) != m_activeActions.end();
+}
+
+Object3D *AnimationMixer::findNode(Object3D *root, const std::string &name)
+{
+    auto cached = m_nodesByName.find(root);
+
+    if (cached == m_nodesByName.end())
+    {
+        cached = m_nodesByName.emplace(root, std::unordered_map<std::string, Object3D *>()).first;
+        auto &nodes = cached->second;
+
+        // first match in traversal order wins, as with Object3D::getObjectByName
+        root->traverse([&nodes](Object3D &node)
+                       { nodes.emplace(node.name(), &node); });
+    }
+
+    auto it = cached->second.find(name);
+    return it == cached->second.end() ? nullptr : it->second;
+}
+
+uint32_t AnimationMixer::resolveBinding(const std::string &trackName, Object3D *root, const AnimationClip::Channel &channel)
+{
+    const std::string key = std::to_string(root != nullptr ? root->id() : 0) + "/" + trackName;
+
+    auto cached = m_bindingsByName.find(key);
+    if (cached != m_bindingsByName.end())
+    {
+        // a narrower track of the same name would leave part of the slot unwritten
+        if (cached->second != NO_BINDING && m_bindings[cached->second].valueSize > channel.valueSize)
+            return NO_BINDING;
+
+        m_maxValueSize = std::max(m_maxValueSize, channel.valueSize);
+        return cached->second;
+    }
+
+    Binding binding{nullptr, nullptr, PropertyType::Custom, channel.type, channel.valueSize, 0};
+    bool resolved = false;
+
+    auto custom = m_customProperties.find(trackName);
+    if (custom != m_customProperties.end())
+    {
+        binding.custom = custom->second.first;
+        binding.valueSize = std::min(channel.valueSize, custom->second.second);
+        resolved = true;
+    }
+    else if (root != nullptr)
+    {
+        const auto dot = trackName.rfind('.');
+        const std::string nodeName = dot == std::string::npos ? "" : trackName.substr(0, dot);
+        const std::string propertyName = dot == std::string::npos ? trackName : trackName.substr(dot + 1);
+
+        Object3D *node = nodeName.empty() ? root : findNode(root, nodeName);
+
+        if (node != nullptr)
+        {
+            binding.node = node;
+
+            if (propertyName == "position" && channel.valueSize == 3)
+            {
+                binding.property = PropertyType::Position;
+                resolved = true;
+            }
+            else if (propertyName == "quaternion" && channel.valueSize == 4)
+            {
+                binding.property = PropertyType::Quaternion;
+                resolved = true;
+            }
+            else if (propertyName == "scale" && channel.valueSize == 3)
+            {
+                binding.property = PropertyType::Scale;
+                resolved = true;
+            }
+        }
+    }
+
+    // unresolved tracks are skipped during playback
+    if (!resolved)
+    {
+        m_bindingsByName[key] = NO_BINDING;
+        return NO_BINDING;
+    }
+
+    // the sample scratch holds all values of a channel, bound or not
+    m_maxValueSize = std::max(m_maxValueSize, channel.valueSize);
+
+    binding.offset = static_cast<uint32_t>(m_accumulator.size());
+
+    m_accumulator.resize(m_accumulator.size() + binding.valueSize, 0.0f);
+    m_original.resize(m_original.size() + binding.valueSize, 0.0f);
+    m_cumulativeWeight.push_back(0.0f);
+
+    // remember the state before animation for partial weights
+    readBinding(binding, m_original.data() + binding.offset);
+
+    const uint32_t index = static_cast<uint32_t>(m_bindings.size());
+    m_bindings.push_back(binding);
+    m_bindingsByName[key] = index;
+
+    return index;
+}
+
+void AnimationMixer::readBinding(const Binding &binding, float *values) const
+{
+    switch (binding.property)
+    {
+    case PropertyType::Position:
+    {
+        const auto &p = binding.node->position();
+        values[0] = static_cast<float>(p.x());
+        values[1] = static_cast<float>(p.y());
+        values[2] = static_cast<float>(p.z());
+        break;
+    }
+    case PropertyType::Quaternion:
+    {
+        const auto &q = binding.node->quaternion();
+        values[0] = static_cast<float>(q.x());
+        values[1] = static_cast<float>(q.y());
+        values[2] = static_cast<float>(q.z());
+        values[3] = static_cast<float>(q.w());
+        break;
+    }
+    case PropertyType::Scale:
+    {
+        const auto &s = binding.node->scale();
+        values[0] = static_cast<float>(s.x());
+        values[1] = static_cast<float>(s.y());
+        values[2] = static_cast<float>(s.z());
+        break;
+    }
+    case PropertyType::Custom:
+        std::copy(binding.custom, binding.custom + binding.valueSize, values);
+        break;
+    }
+}
+
+void AnimationMixer::writeBinding(const Binding &binding, const float *values)
+{
+    switch (binding.property)
+    {
+    case PropertyType::Position:
+        binding.node->position().set(values[0], values[1], values[2]);
+        break;
+    case PropertyType::Quaternion:
+        binding.node->quaternion().set(values[0], values[1], values[2], values[3]);
+        break;
+    case PropertyType::Scale:
+        binding.node->scale().set(values[0], values[1], values[2]);
+        break;
+    case PropertyType::Custom:
+        std::copy(values, values + binding.valueSize, binding.custom);
+        break;
+    }
+}
@@ -0,0 +1,101 @@
+#include "animation/Interpolant.h"
+#include "math/MathUtils.h"
+#include "math/Quaternion.h"
+#include <algorithm>
+
+namespace Interpolant
+{
+    // forward steps tried before giving up on the cached cursor
+    static constexpr uint32_t LINEAR_SCAN_STEPS = 4;
+
+    template <typename T>
+    static inline uint32_t binarySearch(const T *times, uint32_t count, float t)
+    {
+        const auto it = std::upper_bound(times, times + count, t);
+        const uint32_t index = static_cast<uint32_t>(it - times);
+        return index == 0 ? 0 : std::min(index - 1, count - 2);
+    }
+
+    template <typename T>
+    static inline uint32_t seekImpl(const T *times, uint32_t count, float t, uint32_t &cursor)
+    {
+        uint32_t i = std::min(cursor, count - 2);
+
+        if (t < times[i])
+        {
+            // one step back covers ping-pong and small negative time scales
+            i = (i > 0 && t >= times[i - 1]) ? i - 1 : binarySearch(times, i + 1, t);
+        }
+        else
+        {
+            uint32_t steps = 0;
+            while (i + 2 < count && t >= times[i + 1])
+            {
+                if (++steps > LINEAR_SCAN_STEPS)
+                {
+                    i = binarySearch(times, count, t);
+                    break;
+                }
+                ++i;
+            }
+        }
+
+        cursor = i;
+        return i;
+    }
+
+    uint32_t seek(const float *times, uint32_t count, float t, uint32_t &cursor)
+    {
+        return seekImpl(times, count, t, cursor);
+    }
+
+    uint32_t seek(const uint16_t *times, uint32_t count, float t, uint32_t &cursor)
+    {
+        return seekImpl(times, count, t, cursor);
+    }
+
+    void evaluate(const float *times, const float *values, uint32_t count, uint32_t valueSize,
+                  InterpolationMode interpolation, TrackValueType type, float t, uint32_t &cursor, float *result)
+    {
+        // before the first and after the last key the value is held
+
+        if (count == 1 || t <= times[0])
+        {
+            cursor = 0;
+            std::copy(values, values + valueSize, result);
+            return;
+        }
+
+        if (t >= times[count - 1])
+        {
+            cursor = count - 2;
+            const float *last = values + (count - 1) * valueSize;
+            std::copy(last, last + valueSize, result);
+            return;
+        }
+
+        const uint32_t i = seek(times, count, t, cursor);
+        const float *v0 = values + i * valueSize;
+        const float *v1 = v0 + valueSize;
+
+        if (interpolation == InterpolationMode::Discrete)
+        {
+            std::copy(v0, v0 + valueSize, result);
+            return;
+        }
+
+        const float t0 = times[i], t1 = times[i + 1];
+        const float alpha = interpolation == InterpolationMode::Smooth
+                                ? MathUtils::smoothstep(t, t0, t1)
+                                : (t - t0) / (t1 - t0);
+
+        if (type == TrackValueType::Quaternion)
+        {
+            Quaternion::slerpFlat(result, 0, v0, 0, v1, 0, alpha);
+            return;
+        }
+
+        for (uint32_t k = 0; k < valueSize; k++)
+            result[k] = MathUtils::lerp(v0[k], v1[k], alpha);
+    }
+}
@@ -0,0 +1,203 @@
+#include "animation/KeyframeTrack.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+KeyframeTrack::KeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation)
+    : m_name(std::move(name)), m_times(std::move(times)), m_values(std::move(values)), m_interpolation(interpolation)
+{
+    if (m_name.empty())
+        throw std::invalid_argument("KeyframeTrack: track name is undefined");
+
+    if (m_times.empty())
+        throw std::invalid_argument("KeyframeTrack: no keyframes in track named " + m_name);
+}
+
+KeyframeTrack::~KeyframeTrack()
+{
+}
+
+const std::string &KeyframeTrack::name() const
+{
+    return m_name;
+}
+
+const std::vector<float> &KeyframeTrack::times() const
+{
+    return m_times;
+}
+
+const std::vector<float> &KeyframeTrack::values() const
+{
+    return m_values;
+}
+
+InterpolationMode KeyframeTrack::interpolation() const
+{
+    return m_interpolation;
+}
+
+KeyframeTrack &KeyframeTrack::setInterpolation(InterpolationMode interpolation)
+{
+    m_interpolation = interpolation;
+    return *this;
+}
+
+size_t KeyframeTrack::keyCount() const
+{
+    return m_times.size();
+}
+
+size_t KeyframeTrack::getValueSize() const
+{
+    return m_values.size() / m_times.size();
+}
+
+KeyframeTrack &KeyframeTrack::shift(float timeOffset)
+{
+    if (timeOffset != 0.0f)
+    {
+        for (auto &time : m_times)
+            time += timeOffset;
+    }
+
+    return *this;
+}
+
+KeyframeTrack &KeyframeTrack::scale(float timeScale)
+{
+    if (timeScale != 1.0f)
+    {
+        for (auto &time : m_times)
+            time *= timeScale;
+    }
+
+    return *this;
+}
+
+KeyframeTrack &KeyframeTrack::trim(float startTime, float endTime)
+{
+    const size_t nKeys = m_times.size();
+    const size_t stride = getValueSize();
+
+    size_t from = 0, to = nKeys - 1;
+
+    while (from != nKeys && m_times[from] < startTime)
+        ++from;
+
+    while (to != static_cast<size_t>(-1) && m_times[to] > endTime)
+        --to;
+
+    ++to; // inclusive -> exclusive bound
+
+    if (from != 0 || to != nKeys)
+    {
+        // empty tracks are forbidden, so keep at least one keyframe
+        if (from >= to)
+        {
+            to = std::max<size_t>(to, 1);
+            from = to - 1;
+        }
+
+        m_times = std::vector<float>(m_times.begin() + from, m_times.begin() + to);
+        m_values = std::vector<float>(m_values.begin() + from * stride, m_values.begin() + to * stride);
+    }
+
+    return *this;
+}
+
+bool KeyframeTrack::validate() const
+{
+    const size_t nKeys = m_times.size();
+
+    if (m_values.size() % nKeys != 0)
+        return false;
+
+    float prevTime = 0;
+    for (size_t i = 0; i < nKeys; i++)
+    {
+        const float currTime = m_times[i];
+
+        if (std::isnan(currTime))
+            return false;
+
+        if (i > 0 && currTime < prevTime)
+            return false;
+
+        prevTime = currTime;
+    }
+
+    for (auto value : m_values)
+    {
+        if (std::isnan(value))
+            return false;
+    }
+
+    return true;
+}
+
+KeyframeTrack &KeyframeTrack::optimize()
+{
+    // times or values may be shared with other tracks, so overwriting is unsafe
+
+    const size_t stride = getValueSize();
+    const size_t lastIndex = m_times.size() - 1;
+    const bool smoothInterpolation = m_interpolation == InterpolationMode::Smooth;
+
+    std::vector<float> times;
+    std::vector<float> values;
+    times.reserve(m_times.size());
+    values.reserve(m_values.size());
+
+    for (size_t i = 0; i <= lastIndex; i++)
+    {
+        bool keep = false;
+
+        const float time = m_times[i];
+        const float timeNext = i < lastIndex ? m_times[i + 1] : time;
+
+        // remove adjacent keyframes scheduled at the same time
+
+        if (i == 0 || i == lastIndex)
+        {
+            keep = true;
+        }
+        else if (time != timeNext && (i != 1 || time != m_times[0]))
+        {
+            if (!smoothInterpolation)
+            {
+                // remove unnecessary keyframes same as their neighbors
+
+                const size_t offset = i * stride,
+                             offsetP = offset - stride,
+                             offsetN = offset + stride;
+
+                for (size_t j = 0; j != stride; ++j)
+                {
+                    const float value = m_values[offset + j];
+
+                    if (value != m_values[offsetP + j] || value != m_values[offsetN + j])
+                    {
+                        keep = true;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                keep = true;
+            }
+        }
+
+        if (keep)
+        {
+            times.push_back(time);
+            values.insert(values.end(), m_values.begin() + i * stride, m_values.begin() + (i + 1) * stride);
+        }
+    }
+
+    m_times = std::move(times);
+    m_values = std::move(values);
+
+    return *this;
+}
@@ -0,0 +1,20 @@
+#include "animation/tracks/NumberKeyframeTrack.h"
+
+NumberKeyframeTrack::NumberKeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation)
+    : KeyframeTrack(std::move(name), std::move(times), std::move(values), interpolation)
+{
+}
+
+NumberKeyframeTrack::~NumberKeyframeTrack()
+{
+}
+
+TrackValueType NumberKeyframeTrack::valueType() const
+{
+    return TrackValueType::Number;
+}
+
+std::string NumberKeyframeTrack::valueTypeName() const
+{
+    return "number";
+}
@@ -0,0 +1,20 @@
+#include "animation/tracks/QuaternionKeyframeTrack.h"
+
+QuaternionKeyframeTrack::QuaternionKeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation)
+    : KeyframeTrack(std::move(name), std::move(times), std::move(values), interpolation)
+{
+}
+
+QuaternionKeyframeTrack::~QuaternionKeyframeTrack()
+{
+}
+
+TrackValueType QuaternionKeyframeTrack::valueType() const
+{
+    return TrackValueType::Quaternion;
+}
+
+std::string QuaternionKeyframeTrack::valueTypeName() const
+{
+    return "quaternion";
+}
@@ -0,0 +1,20 @@
+#include "animation/tracks/VectorKeyframeTrack.h"
+
+VectorKeyframeTrack::VectorKeyframeTrack(std::string name, std::vector<float> times, std::vector<float> values, InterpolationMode interpolation)
+    : KeyframeTrack(std::move(name), std::move(times), std::move(values), interpolation)
+{
+}
+
+VectorKeyframeTrack::~VectorKeyframeTrack()
+{
+}
+
+TrackValueType VectorKeyframeTrack::valueType() const
+{
+    return TrackValueType::Vector;
+}
+
+std::string VectorKeyframeTrack::valueTypeName() const
+{
+    return "vector";
+}
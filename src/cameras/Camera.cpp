@@ -0,0 +1,60 @@
+#include "cameras/Camera.h"
+
+Camera::Camera()
+{
+}
+
+Camera::~Camera()
+{
+}
+
+std::string Camera::type() const
+{
+    return "Camera";
+}
+
+Matrix4 &Camera::matrixWorldInverse()
+{
+    return m_matrixWorldInverse;
+}
+
+const Matrix4 &Camera::matrixWorldInverse() const
+{
+    return m_matrixWorldInverse;
+}
+
+Matrix4 &Camera::projectionMatrix()
+{
+    return m_projectionMatrix;
+}
+
+const Matrix4 &Camera::projectionMatrix() const
+{
+    return m_projectionMatrix;
+}
+
+Matrix4 &Camera::projectionMatrixInverse()
+{
+    return m_projectionMatrixInverse;
+}
+
+const Matrix4 &Camera::projectionMatrixInverse() const
+{
+    return m_projectionMatrixInverse;
+}
+
+void Camera::updateMatrixWorld(bool force)
+{
+    Object3D::updateMatrixWorld(force);
+
+    m_matrixWorldInverse.copy(matrixWorld());
+    m_matrixWorldInverse.invert();
+}
+
+void Camera::updateWorldMatrix(bool updateParents, bool updateChildren)
+{
+    Object3D::updateWorldMatrix(updateParents, updateChildren);
+
+    m_matrixWorldInverse.copy(matrixWorld());
+    m_matrixWorldInverse.invert();
+}
@@ -0,0 +1,31 @@
+#include "cameras/PerspectiveCamera.h"
+#include "math/MathUtils.h"
+#include <cmath>
+
+PerspectiveCamera::PerspectiveCamera(float fov, float aspect, float near, float far)
+    : fov(fov), near(near), far(far), aspect(aspect)
+{
+    updateProjectionMatrix();
+}
+
+PerspectiveCamera::~PerspectiveCamera()
+{
+}
+
+std::string PerspectiveCamera::type() const
+{
+    return "PerspectiveCamera";
+}
+
+void PerspectiveCamera::updateProjectionMatrix()
+{
+    const float top = near * std::tan(MathUtils::degToRad(0.5f * fov)) / zoom;
+    const float height = 2 * top;
+    const float width = aspect * height;
+    const float left = -0.5f * width;
+
+    projectionMatrix().makePerspective(left, left + width, top, top - height, near, far);
+
+    projectionMatrixInverse().copy(projectionMatrix());
+    projectionMatrixInverse().invert();
+}
@@ -0,0 +1,303 @@
+#include "common/Allocators.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <stdexcept>
+
+static constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+static size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t AllocationStats::liveAllocations() const
+{
+    return allocations - deallocations;
+}
+
+// TrackingResource
+
+TrackingResource::TrackingResource(std::pmr::memory_resource *upstream)
+    : m_upstream(upstream)
+{
+}
+
+TrackingResource::~TrackingResource() {}
+
+AllocationStats TrackingResource::stats() const
+{
+    AllocationStats stats;
+    stats.allocations = m_allocations.load(std::memory_order_relaxed);
+    stats.deallocations = m_deallocations.load(std::memory_order_relaxed);
+    stats.bytes = m_bytes.load(std::memory_order_relaxed);
+    stats.liveBytes = m_liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = m_peakBytes.load(std::memory_order_relaxed);
+    // every allocation is forwarded
+    stats.upstreamAllocations = stats.allocations;
+    stats.upstreamBytes = stats.bytes;
+    return stats;
+}
+
+void TrackingResource::resetStats()
+{
+    m_allocations = 0;
+    m_deallocations = 0;
+    m_bytes = 0;
+    m_peakBytes = m_liveBytes.load();
+}
+
+void *TrackingResource::do_allocate(size_t bytes, size_t alignment)
+{
+    void *pointer = m_upstream->allocate(bytes, alignment);
+    THREECPP_PROFILE_COUNT(Allocations, 1);
+
+    m_allocations.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    const size_t live = m_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    size_t peak = m_peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !m_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+
+    return pointer;
+}
+
+void TrackingResource::do_deallocate(void *pointer, size_t bytes, size_t alignment)
+{
+    m_upstream->deallocate(pointer, bytes, alignment);
+
+    m_deallocations.fetch_add(1, std::memory_order_relaxed);
+    m_liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+bool TrackingResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+// FrameArena
+
+FrameArena::FrameArena(size_t capacity, std::pmr::memory_resource *upstream)
+    : m_upstream(upstream)
+{
+    if (capacity > 0)
+        addBlock(capacity);
+}
+
+FrameArena::~FrameArena()
+{
+    releaseBlocks();
+}
+
+void FrameArena::reset()
+{
+    // one block of the combined size holds the next frame of the same size
+    if (m_blocks.size() > 1)
+    {
+        const size_t total = capacity();
+        releaseBlocks();
+        addBlock(total);
+    }
+
+    if (!m_blocks.empty())
+    {
+        m_cursor = m_blocks.front().data;
+        m_end = m_cursor + m_blocks.front().size;
+    }
+
+    m_usedBefore = 0;
+    m_stats.liveBytes = 0;
+}
+
+size_t FrameArena::capacity() const
+{
+    size_t total = 0;
+    for (const auto &block : m_blocks)
+        total += block.size;
+    return total;
+}
+
+size_t FrameArena::used() const
+{
+    return m_blocks.empty() ? 0 : m_usedBefore + static_cast<size_t>(m_cursor - m_blocks.back().data);
+}
+
+AllocationStats FrameArena::stats() const
+{
+    return m_stats;
+}
+
+void FrameArena::addBlock(size_t size)
+{
+    size = alignUp(size, BLOCK_ALIGNMENT);
+    auto *data = static_cast<std::byte *>(m_upstream->allocate(size, BLOCK_ALIGNMENT));
+    THREECPP_PROFILE_COUNT(Allocations, 1);
+
+    if (!m_blocks.empty())
+        m_usedBefore += static_cast<size_t>(m_cursor - m_blocks.back().data);
+
+    m_blocks.push_back({data, size});
+    m_cursor = data;
+    m_end = data + size;
+
+    m_stats.upstreamAllocations++;
+    m_stats.upstreamBytes += size;
+}
+
+void FrameArena::releaseBlocks()
+{
+    for (const auto &block : m_blocks)
+        m_upstream->deallocate(block.data, block.size, BLOCK_ALIGNMENT);
+
+    m_blocks.clear();
+    m_cursor = nullptr;
+    m_end = nullptr;
+}
+
+void *FrameArena::do_allocate(size_t bytes, size_t alignment)
+{
+    auto aligned = [alignment](std::byte *pointer)
+    {
+        return reinterpret_cast<std::byte *>(alignUp(reinterpret_cast<uintptr_t>(pointer), alignment));
+    };
+
+    std::byte *pointer = aligned(m_cursor);
+    if (m_cursor == nullptr || static_cast<size_t>(m_end - m_cursor) < bytes + static_cast<size_t>(pointer - m_cursor))
+    {
+        // grow geometrically so a frame overflows only a few times
+        const size_t last = m_blocks.empty() ? 0 : m_blocks.back().size;
+        addBlock(std::max(last * 2, bytes + alignment));
+        pointer = aligned(m_cursor);
+    }
+
+    m_cursor = pointer + bytes;
+
+    m_stats.allocations++;
+    m_stats.bytes += bytes;
+    m_stats.liveBytes += bytes;
+    m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.liveBytes);
+
+    return pointer;
+}
+
+void FrameArena::do_deallocate(void *, size_t, size_t)
+{
+    // released in bulk by reset()
+    m_stats.deallocations++;
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+// PoolResource
+
+PoolResource::PoolResource(size_t blockSize, size_t blocksPerChunk, std::pmr::memory_resource *upstream)
+    : m_blockSize(alignUp(std::max(blockSize, sizeof(FreeBlock)), BLOCK_ALIGNMENT)),
+      m_blocksPerChunk(blocksPerChunk),
+      m_upstream(upstream)
+{
+    if (blocksPerChunk == 0)
+        throw std::invalid_argument("PoolResource: blocksPerChunk must be at least 1");
+}
+
+PoolResource::~PoolResource()
+{
+    release();
+}
+
+size_t PoolResource::blockSize() const
+{
+    return m_blockSize;
+}
+
+void PoolResource::release()
+{
+    for (const auto &[chunk, size] : m_chunks)
+        m_upstream->deallocate(chunk, size, BLOCK_ALIGNMENT);
+
+    m_chunks.clear();
+    m_free = nullptr;
+    m_stats.liveBytes = 0;
+}
+
+AllocationStats PoolResource::stats() const
+{
+    return m_stats;
+}
+
+bool PoolResource::fits(size_t bytes, size_t alignment) const
+{
+    return bytes <= m_blockSize && alignment <= BLOCK_ALIGNMENT;
+}
+
+void PoolResource::refill()
+{
+    const size_t size = m_blockSize * m_blocksPerChunk;
+    auto *chunk = static_cast<std::byte *>(m_upstream->allocate(size, BLOCK_ALIGNMENT));
+    THREECPP_PROFILE_COUNT(Allocations, 1);
+    m_chunks.emplace_back(chunk, size);
+
+    // thread the free list in address order
+    for (size_t i = m_blocksPerChunk; i-- > 0;)
+    {
+        auto *block = reinterpret_cast<FreeBlock *>(chunk + i * m_blockSize);
+        block->next = m_free;
+        m_free = block;
+    }
+
+    m_stats.upstreamAllocations++;
+    m_stats.upstreamBytes += size;
+}
+
+void *PoolResource::do_allocate(size_t bytes, size_t alignment)
+{
+    void *pointer;
+
+    if (fits(bytes, alignment))
+    {
+        if (m_free == nullptr)
+            refill();
+
+        pointer = m_free;
+        m_free = m_free->next;
+    }
+    else
+    {
+        pointer = m_upstream->allocate(bytes, alignment);
+        THREECPP_PROFILE_COUNT(Allocations, 1);
+        m_stats.upstreamAllocations++;
+        m_stats.upstreamBytes += bytes;
+    }
+
+    m_stats.allocations++;
+    m_stats.bytes += bytes;
+    m_stats.liveBytes += bytes;
+    m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.liveBytes);
+
+    return pointer;
+}
+
+void PoolResource::do_deallocate(void *pointer, size_t bytes, size_t alignment)
+{
+    if (fits(bytes, alignment))
+    {
+        auto *block = static_cast<FreeBlock *>(pointer);
+        block->next = m_free;
+        m_free = block;
+    }
+    else
+    {
+        m_upstream->deallocate(pointer, bytes, alignment);
+    }
+
+    m_stats.deallocations++;
+    m_stats.liveBytes -= bytes;
+}
+
+bool PoolResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
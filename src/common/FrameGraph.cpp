@@ -0,0 +1,101 @@
+#include "common/FrameGraph.h"
+#include "common/Profiler.h"
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+FrameGraph::FrameGraph() {}
+
+FrameGraph::~FrameGraph() {}
+
+FrameGraph::Pass FrameGraph::addPass(std::string name, std::function<void()> execute, std::vector<Pass> after)
+{
+    const Pass pass = m_passes.size();
+
+    for (Pass dependency : after)
+    {
+        if (dependency >= pass)
+            throw std::invalid_argument("FrameGraph: a pass can only run after earlier passes");
+        if (m_passes[dependency].dependents == JobSystem::MAX_SUCCESSORS)
+            throw std::invalid_argument("FrameGraph: too many passes run after '" + m_passes[dependency].name + "'");
+    }
+
+    for (Pass dependency : after)
+        m_passes[dependency].dependents++;
+
+    m_passes.push_back({std::move(name), std::move(execute), std::move(after)});
+#if defined(THREECPP_PROFILING)
+    m_passes.back().zone = Profiler::instance().intern(m_passes.back().name);
+#endif
+    return pass;
+}
+
+void FrameGraph::clear()
+{
+    m_passes.clear();
+}
+
+size_t FrameGraph::size() const
+{
+    return m_passes.size();
+}
+
+const std::string &FrameGraph::name(Pass pass) const
+{
+    return m_passes.at(pass).name;
+}
+
+double FrameGraph::seconds(Pass pass) const
+{
+    return m_passes.at(pass).seconds;
+}
+
+void FrameGraph::execute(JobSystem &jobs)
+{
+    if (m_passes.empty())
+        return;
+
+    JobSystem::Job *frame = jobs.createEmpty();
+
+    m_jobs.resize(m_passes.size());
+    for (Pass pass = 0; pass < m_passes.size(); pass++)
+        m_jobs[pass] = jobs.create([this, pass]()
+                                   { runPass(pass); },
+                                   frame);
+
+    // every edge is in place before the first pass can start
+    for (Pass pass = 0; pass < m_passes.size(); pass++)
+        for (Pass dependency : m_passes[pass].after)
+            jobs.addDependency(m_jobs[pass], m_jobs[dependency]);
+
+    for (JobSystem::Job *job : m_jobs)
+        jobs.run(job);
+
+    jobs.run(frame);
+    jobs.wait(frame);
+
+    if (m_error)
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+void FrameGraph::runPass(Pass pass)
+{
+    PassData &data = m_passes[pass];
+
+    THREECPP_PROFILE_ZONE(data.zone);
+
+    const auto start = std::chrono::steady_clock::now();
+    try
+    {
+        if (data.execute)
+            data.execute();
+    }
+    catch (...)
+    {
+        // passes after this one still run; the error surfaces in execute()
+        std::lock_guard lock(m_errorMutex);
+        if (!m_error)
+            m_error = std::current_exception();
+    }
+    data.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,378 @@
+#include "common/JSON.h"
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+
+namespace JSON
+{
+    static const Value NULL_VALUE;
+    static const std::string EMPTY_STRING;
+    static const std::vector<Value> EMPTY_ELEMENTS;
+    static const std::vector<std::pair<std::string, Value>> EMPTY_MEMBERS;
+
+    Type Value::type() const
+    {
+        return m_type;
+    }
+
+    bool Value::isNull() const
+    {
+        return m_type == Type::Null;
+    }
+
+    bool Value::isNumber() const
+    {
+        return m_type == Type::Number;
+    }
+
+    bool Value::isString() const
+    {
+        return m_type == Type::String;
+    }
+
+    bool Value::isArray() const
+    {
+        return m_type == Type::Array;
+    }
+
+    bool Value::isObject() const
+    {
+        return m_type == Type::Object;
+    }
+
+    bool Value::asBool(bool fallback) const
+    {
+        return m_type == Type::Boolean ? m_bool : fallback;
+    }
+
+    double Value::asNumber(double fallback) const
+    {
+        return m_type == Type::Number ? m_number : fallback;
+    }
+
+    long long Value::asInt(long long fallback) const
+    {
+        return m_type == Type::Number ? static_cast<long long>(m_number) : fallback;
+    }
+
+    const std::string &Value::asString() const
+    {
+        return m_type == Type::String ? m_string : EMPTY_STRING;
+    }
+
+    size_t Value::size() const
+    {
+        if (m_type == Type::Array)
+            return m_elements.size();
+        if (m_type == Type::Object)
+            return m_members.size();
+        return 0;
+    }
+
+    const Value &Value::operator[](size_t index) const
+    {
+        return m_type == Type::Array && index < m_elements.size() ? m_elements[index] : NULL_VALUE;
+    }
+
+    const Value &Value::operator[](std::string_view key) const
+    {
+        if (m_type == Type::Object)
+        {
+            for (auto &[name, value] : m_members)
+            {
+                if (name == key)
+                    return value;
+            }
+        }
+
+        return NULL_VALUE;
+    }
+
+    bool Value::contains(std::string_view key) const
+    {
+        return !(*this)[key].isNull();
+    }
+
+    const std::vector<Value> &Value::elements() const
+    {
+        return m_type == Type::Array ? m_elements : EMPTY_ELEMENTS;
+    }
+
+    const std::vector<std::pair<std::string, Value>> &Value::members() const
+    {
+        return m_type == Type::Object ? m_members : EMPTY_MEMBERS;
+    }
+
+    class Parser
+    {
+    public:
+        explicit Parser(std::string_view text)
+            : m_p(text.data()), m_end(text.data() + text.size())
+        {
+        }
+
+        Value parseDocument()
+        {
+            Value value = parseValue(0);
+
+            skipWhitespace();
+            if (m_p != m_end)
+                fail("trailing characters");
+
+            return value;
+        }
+
+    private:
+        // guards against stack exhaustion on hostile input
+        static constexpr int MAX_DEPTH = 256;
+
+        const char *m_p;
+        const char *m_end;
+
+        [[noreturn]] void fail(const char *message) const
+        {
+            throw std::runtime_error(std::string("JSON: ") + message);
+        }
+
+        void skipWhitespace()
+        {
+            while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r'))
+                ++m_p;
+        }
+
+        bool consume(std::string_view literal)
+        {
+            if (static_cast<size_t>(m_end - m_p) < literal.size() || std::string_view(m_p, literal.size()) != literal)
+                return false;
+
+            m_p += literal.size();
+            return true;
+        }
+
+        void expect(char c)
+        {
+            skipWhitespace();
+            if (m_p >= m_end || *m_p != c)
+                fail("unexpected character");
+            ++m_p;
+        }
+
+        Value parseValue(int depth)
+        {
+            if (depth > MAX_DEPTH)
+                fail("nesting too deep");
+
+            skipWhitespace();
+            if (m_p >= m_end)
+                fail("unexpected end of input");
+
+            Value value;
+
+            switch (*m_p)
+            {
+            case '{':
+                value.m_type = Type::Object;
+                ++m_p;
+                skipWhitespace();
+
+                if (m_p < m_end && *m_p == '}')
+                {
+                    ++m_p;
+                    break;
+                }
+
+                while (true)
+                {
+                    skipWhitespace();
+                    std::string key = parseString();
+                    expect(':');
+                    value.m_members.emplace_back(std::move(key), parseValue(depth + 1));
+
+                    skipWhitespace();
+                    if (m_p < m_end && *m_p == ',')
+                    {
+                        ++m_p;
+                        continue;
+                    }
+
+                    expect('}');
+                    break;
+                }
+                break;
+
+            case '[':
+                value.m_type = Type::Array;
+                ++m_p;
+                skipWhitespace();
+
+                if (m_p < m_end && *m_p == ']')
+                {
+                    ++m_p;
+                    break;
+                }
+
+                while (true)
+                {
+                    value.m_elements.push_back(parseValue(depth + 1));
+
+                    skipWhitespace();
+                    if (m_p < m_end && *m_p == ',')
+                    {
+                        ++m_p;
+                        continue;
+                    }
+
+                    expect(']');
+                    break;
+                }
+                break;
+
+            case '"':
+                value.m_type = Type::String;
+                value.m_string = parseString();
+                break;
+
+            case 't':
+            case 'f':
+                value.m_type = Type::Boolean;
+                value.m_bool = *m_p == 't';
+                if (!consume(value.m_bool ? "true" : "false"))
+                    fail("invalid literal");
+                break;
+
+            case 'n':
+                if (!consume("null"))
+                    fail("invalid literal");
+                break;
+
+            default:
+            {
+                value.m_type = Type::Number;
+                const auto result = std::from_chars(m_p, m_end, value.m_number);
+                if (result.ec != std::errc())
+                    fail("invalid number");
+                m_p = result.ptr;
+                break;
+            }
+            }
+
+            return value;
+        }
+
+        static void appendUTF8(std::string &out, uint32_t codePoint)
+        {
+            if (codePoint < 0x80)
+            {
+                out += static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (codePoint >> 6));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (codePoint >> 12));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (codePoint >> 18));
+                out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        uint32_t parseHex4()
+        {
+            if (m_end - m_p < 4)
+                fail("invalid escape");
+
+            uint32_t value = 0;
+            const auto result = std::from_chars(m_p, m_p + 4, value, 16);
+            if (result.ec != std::errc() || result.ptr != m_p + 4)
+                fail("invalid escape");
+
+            m_p += 4;
+            return value;
+        }
+
+        std::string parseString()
+        {
+            if (m_p >= m_end || *m_p != '"')
+                fail("expected string");
+            ++m_p;
+
+            std::string out;
+
+            while (true)
+            {
+                // copy plain runs at once
+                const char *run = m_p;
+                while (m_p < m_end && *m_p != '"' && *m_p != '\\')
+                    ++m_p;
+                out.append(run, m_p);
+
+                if (m_p >= m_end)
+                    fail("unterminated string");
+
+                if (*m_p++ == '"')
+                    return out;
+
+                if (m_p >= m_end)
+                    fail("unterminated string");
+
+                switch (*m_p++)
+                {
+                case '"':
+                    out += '"';
+                    break;
+                case '\\':
+                    out += '\\';
+                    break;
+                case '/':
+                    out += '/';
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u':
+                {
+                    uint32_t codePoint = parseHex4();
+
+                    // surrogate pair
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && consume("\\u"))
+                    {
+                        const uint32_t low = parseHex4();
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+
+                    appendUTF8(out, codePoint);
+                    break;
+                }
+                default:
+                    fail("invalid escape");
+                }
+            }
+        }
+    };
+
+    Value parse(std::string_view text)
+    {
+        return Parser(text).parseDocument();
+    }
+}
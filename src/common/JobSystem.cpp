@@ -0,0 +1,296 @@
+#include "common/JobSystem.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <array>
+#include <stdexcept>
+
+namespace
+{
+    // the scheduler and slot the current thread works for; other threads
+    // share slot 0
+    struct WorkerSlot
+    {
+        const JobSystem *owner = nullptr;
+        size_t index = 0;
+    };
+
+    thread_local WorkerSlot t_slot;
+}
+
+struct alignas(64) JobSystem::Queue
+{
+    std::mutex mutex;
+    std::array<Job *, POOL_SIZE> jobs{};
+    // monotonic, the live jobs are [head, tail)
+    size_t head = 0;
+    size_t tail = 0;
+    // read without the lock to skip empty queues when stealing
+    std::atomic<size_t> size{0};
+
+    std::atomic<size_t> executed{0};
+    std::atomic<size_t> stolen{0};
+
+    bool push(Job *job)
+    {
+        std::lock_guard lock(mutex);
+        if (tail - head == POOL_SIZE)
+            return false;
+        jobs[tail++ % POOL_SIZE] = job;
+        size.store(tail - head, std::memory_order_relaxed);
+        return true;
+    }
+
+    Job *pop()
+    {
+        std::lock_guard lock(mutex);
+        if (tail == head)
+            return nullptr;
+        Job *job = jobs[--tail % POOL_SIZE];
+        size.store(tail - head, std::memory_order_relaxed);
+        return job;
+    }
+
+    Job *steal()
+    {
+        if (size.load(std::memory_order_relaxed) == 0)
+            return nullptr;
+        std::lock_guard lock(mutex);
+        if (tail == head)
+            return nullptr;
+        Job *job = jobs[head++ % POOL_SIZE];
+        size.store(tail - head, std::memory_order_relaxed);
+        return job;
+    }
+};
+
+struct alignas(64) JobSystem::Pool
+{
+    std::array<Job, POOL_SIZE> jobs;
+    std::atomic<size_t> next{0};
+};
+
+JobSystem::JobSystem(size_t threadCount)
+{
+    const size_t count = threadCount > 0 ? threadCount : Parallel::workerCount();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_queues.push_back(std::make_unique<Queue>());
+        m_pools.push_back(std::make_unique<Pool>());
+    }
+
+    m_workers.reserve(count - 1);
+    for (size_t i = 1; i < count; i++)
+        m_workers.emplace_back([this, i]()
+                               { workerLoop(i); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_stop.store(true);
+    }
+    m_wake.notify_all();
+    m_workers.clear();
+}
+
+JobSystem &JobSystem::instance()
+{
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+size_t JobSystem::threadCount() const
+{
+    return m_queues.size();
+}
+
+JobSystem::Stats JobSystem::stats() const
+{
+    Stats stats;
+    for (const auto &queue : m_queues)
+    {
+        stats.executed += queue->executed.load(std::memory_order_relaxed);
+        stats.stolen += queue->stolen.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+JobSystem::Job *JobSystem::createEmpty(Job *parent)
+{
+    return allocate(parent);
+}
+
+void JobSystem::addDependency(Job *job, Job *prerequisite)
+{
+    const uint32_t slot = prerequisite->successorCount.load(std::memory_order_relaxed);
+    if (slot == MAX_SUCCESSORS)
+        throw std::out_of_range("JobSystem: too many jobs depend on one job");
+
+    prerequisite->successors[slot] = job;
+    prerequisite->successorCount.store(slot + 1, std::memory_order_release);
+    job->pending.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobSystem::run(Job *job)
+{
+    if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        push(job);
+}
+
+void JobSystem::wait(Job *job)
+{
+    const size_t index = threadIndex();
+
+    while (!isFinished(job))
+    {
+        if (Job *next = this->next(index))
+            execute(next);
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::isFinished(const Job *job) const
+{
+    return job->unfinished.load(std::memory_order_acquire) == 0;
+}
+
+size_t JobSystem::autoGrain(size_t count) const
+{
+    const size_t chunks = threadCount() * CHUNKS_PER_THREAD;
+    return std::max<size_t>(1, (count + chunks - 1) / chunks);
+}
+
+JobSystem::Job *JobSystem::allocate(Job *parent)
+{
+    const size_t index = threadIndex();
+    Pool &pool = *m_pools[index];
+    Job *job = nullptr;
+
+    // round-robin over the slots, skipping the ones still referenced by a job
+    // in flight; the claim is atomic as threads outside the system share a pool
+    while (!job)
+    {
+        for (size_t probe = 0; probe < POOL_SIZE && !job; probe++)
+        {
+            Job &slot = pool.jobs[pool.next.fetch_add(1, std::memory_order_relaxed) % POOL_SIZE];
+            int32_t expected = 0;
+            if (slot.unfinished.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+                job = &slot;
+        }
+
+        // every slot is in flight: help until one finishes
+        if (!job)
+        {
+            if (Job *other = next(index))
+                execute(other);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    job->function = nullptr;
+    job->parent = parent;
+    job->pending.store(1, std::memory_order_relaxed);
+    job->successorCount.store(0, std::memory_order_relaxed);
+
+    if (parent)
+        parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+
+    return job;
+}
+
+size_t JobSystem::threadIndex() const
+{
+    return t_slot.owner == this ? t_slot.index : 0;
+}
+
+void JobSystem::push(Job *job)
+{
+    // a full deque means the thread is far ahead of the others; running the
+    // job right away keeps it from growing further
+    if (!m_queues[threadIndex()]->push(job))
+    {
+        execute(job);
+        return;
+    }
+
+    // pairs with the check in workerLoop: either the worker sees the job or
+    // this thread sees the sleeper
+    m_queued.fetch_add(1);
+    if (m_sleeping.load() > 0)
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_wake.notify_one();
+    }
+}
+
+JobSystem::Job *JobSystem::next(size_t index)
+{
+    Queue &own = *m_queues[index];
+    Job *job = own.pop();
+
+    for (size_t i = 1; !job && i < m_queues.size(); i++)
+    {
+        job = m_queues[(index + i) % m_queues.size()]->steal();
+        if (job)
+            own.stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (job)
+    {
+        m_queued.fetch_sub(1);
+        own.executed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+void JobSystem::execute(Job *job)
+{
+    if (job->function)
+        job->function(*job);
+    finish(job);
+}
+
+void JobSystem::finish(Job *job)
+{
+    // copied first: once the count drops to zero a waiter may return and the
+    // slot be reused
+    Job *parent = job->parent;
+    const uint32_t successorCount = job->successorCount.load(std::memory_order_acquire);
+    std::array<Job *, MAX_SUCCESSORS> successors;
+    std::copy_n(job->successors, successorCount, successors.begin());
+
+    if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    for (uint32_t i = 0; i < successorCount; i++)
+        run(successors[i]);
+
+    if (parent)
+        finish(parent);
+}
+
+void JobSystem::workerLoop(size_t index)
+{
+    t_slot = {this, index};
+    THREECPP_PROFILE_THREAD("worker " + std::to_string(index));
+
+    while (!m_stop.load(std::memory_order_relaxed))
+    {
+        if (Job *job = next(index))
+        {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_sleeping.fetch_add(1);
+        m_wake.wait(lock, [this]()
+                    { return m_queued.load() > 0 || m_stop.load(); });
+        m_sleeping.fetch_sub(1);
+    }
+}
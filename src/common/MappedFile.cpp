@@ -0,0 +1,161 @@
+#include "common/MappedFile.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &path)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("MappedFile: cannot open " + path);
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    m_file = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    if (m_size == 0)
+        return;
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr)
+    {
+        close();
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+
+    m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        close();
+        throw std::runtime_error("MappedFile: cannot map " + path);
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("MappedFile: cannot open " + path);
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("MappedFile: cannot stat " + path);
+    }
+
+    m_size = static_cast<size_t>(info.st_size);
+
+    if (m_size > 0)
+    {
+        void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            ::close(fd);
+            m_size = 0;
+            throw std::runtime_error("MappedFile: cannot map " + path);
+        }
+
+        ::madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char *>(data);
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+#if defined(_WIN32)
+        std::swap(m_file, other.m_file);
+        std::swap(m_mapping, other.m_mapping);
+#endif
+    }
+
+    return *this;
+}
+
+const char *MappedFile::data() const
+{
+    return m_data;
+}
+
+size_t MappedFile::size() const
+{
+    return m_size;
+}
+
+std::span<const char> MappedFile::span() const
+{
+    return {m_data, m_size};
+}
+
+bool MappedFile::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+void MappedFile::release(size_t offset, size_t length) const
+{
+#if !defined(_WIN32)
+    if (m_data == nullptr || offset >= m_size)
+        return;
+
+    static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    // shrink to whole pages so bytes still in use by a neighbouring range stay mapped
+    const size_t end = std::min(offset + length, m_size);
+    const size_t first = (offset + pageSize - 1) / pageSize * pageSize;
+    const size_t last = end == m_size ? end : end / pageSize * pageSize;
+
+    if (first < last)
+        ::madvise(const_cast<char *>(m_data) + first, last - first, MADV_DONTNEED);
+#else
+    (void)offset;
+    (void)length;
+#endif
+}
+
+void MappedFile::close()
+{
+#if defined(_WIN32)
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+    if (m_mapping != nullptr)
+        CloseHandle(m_mapping);
+    if (m_file != nullptr)
+        CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data != nullptr)
+        ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
@@ -0,0 +1,12 @@
+#include "common/Parallel.h"
+#include <algorithm>
+#include <thread>
+
+namespace Parallel
+{
+    size_t workerCount()
+    {
+        static const size_t count = std::max<size_t>(1, std::thread::hardware_concurrency());
+        return count;
+    }
+}
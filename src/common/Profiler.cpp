@@ -0,0 +1,360 @@
+#include "common/Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+    thread_local std::string t_threadName;
+
+    // returns the data of an exiting thread to the profiler
+    struct ThreadRelease
+    {
+        void (*release)(void *) = nullptr;
+        void *data = nullptr;
+
+        ~ThreadRelease()
+        {
+            if (data != nullptr)
+                release(data);
+        }
+    };
+
+    void appendEscaped(std::string &out, std::string_view text)
+    {
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20)
+                out += c;
+        }
+    }
+
+    void appendNumber(std::string &out, double value)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+        out += buffer;
+    }
+}
+
+Profiler::Profiler()
+    : m_originTicks(now()), m_originTime(std::chrono::steady_clock::now())
+{
+    m_frameStart = m_originTicks;
+}
+
+Profiler::~Profiler() {}
+
+Profiler &Profiler::instance()
+{
+    // never destroyed: worker threads may still release their data during exit
+    static Profiler *profiler = new Profiler();
+    return *profiler;
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string &name)
+{
+    t_threadName = name;
+
+    if (s_thread != nullptr)
+    {
+        std::lock_guard lock(instance().m_mutex);
+        s_thread->name = name;
+    }
+}
+
+const char *Profiler::counterName(Counter counter)
+{
+    switch (counter)
+    {
+    case NodesUpdated:
+        return "nodesUpdated";
+    case MatricesComposed:
+        return "matricesComposed";
+    case ObjectsCulled:
+        return "objectsCulled";
+    case Allocations:
+        return "allocations";
+    }
+    throw std::invalid_argument("Profiler: unknown counter");
+}
+
+Profiler::ThreadData *Profiler::registerThread()
+{
+    Profiler &profiler = instance();
+    ThreadData *data;
+    {
+        std::lock_guard lock(profiler.m_mutex);
+
+        if (!profiler.m_freeThreads.empty())
+        {
+            data = profiler.m_freeThreads.back();
+            profiler.m_freeThreads.pop_back();
+        }
+        else
+        {
+            profiler.m_threads.push_back(std::make_unique<ThreadData>());
+            data = profiler.m_threads.back().get();
+            data->id = static_cast<uint32_t>(profiler.m_threads.size());
+            data->events = std::make_unique<Event[]>(EVENTS_PER_THREAD);
+        }
+
+        data->name = t_threadName.empty() ? "thread " + std::to_string(data->id) : t_threadName;
+    }
+
+    static thread_local ThreadRelease release;
+    release.release = [](void *pointer)
+    { releaseThread(static_cast<ThreadData *>(pointer)); };
+    release.data = data;
+
+    s_thread = data;
+    return data;
+}
+
+void Profiler::releaseThread(ThreadData *data)
+{
+    Profiler &profiler = instance();
+    std::lock_guard lock(profiler.m_mutex);
+    profiler.m_freeThreads.push_back(data);
+    s_thread = nullptr;
+}
+
+const char *Profiler::intern(const std::string &name)
+{
+    std::lock_guard lock(m_mutex);
+
+    for (const std::string &interned : m_names)
+        if (interned == name)
+            return interned.c_str();
+
+    // a deque never moves its elements, so the pointers stay valid
+    m_names.push_back(name);
+    return m_names.back().c_str();
+}
+
+double Profiler::secondsPerTick() const
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    // the longer the interval since the origin, the more exact the ratio
+    auto ticks = now();
+    auto time = std::chrono::steady_clock::now();
+    while (time - m_originTime < std::chrono::milliseconds(10))
+    {
+        ticks = now();
+        time = std::chrono::steady_clock::now();
+    }
+
+    return std::chrono::duration<double>(time - m_originTime).count() / static_cast<double>(ticks - m_originTicks);
+#else
+    return static_cast<double>(std::chrono::steady_clock::period::num) / std::chrono::steady_clock::period::den;
+#endif
+}
+
+double Profiler::secondsSinceOrigin(uint64_t ticks) const
+{
+    if (ticks <= m_originTicks)
+        return 0;
+    return static_cast<double>(ticks - m_originTicks) * secondsPerTick();
+}
+
+std::array<uint64_t, Profiler::COUNTER_COUNT> Profiler::counterTotals() const
+{
+    std::array<uint64_t, COUNTER_COUNT> totals{};
+    for (const auto &data : m_threads)
+        for (size_t i = 0; i < COUNTER_COUNT; i++)
+            totals[i] += data->counters[i].load(std::memory_order_relaxed);
+    return totals;
+}
+
+void Profiler::frame()
+{
+    const uint64_t ticks = now();
+    const double scale = secondsPerTick();
+
+    std::lock_guard lock(m_mutex);
+
+    // counters only grow, so a frame is the difference of two totals
+    const auto totals = counterTotals();
+
+    FrameStats stats;
+    stats.index = m_frameIndex++;
+    stats.start = secondsSinceOrigin(m_frameStart);
+    stats.seconds = static_cast<double>(ticks - m_frameStart) * scale;
+    for (size_t i = 0; i < COUNTER_COUNT; i++)
+        stats.counters[i] = totals[i] - m_frameTotals[i];
+
+    m_frameTotals = totals;
+    m_frameStart = ticks;
+
+    m_frames.push_back(stats);
+    if (m_frames.size() > FRAME_HISTORY)
+        m_frames.pop_front();
+}
+
+std::vector<Profiler::FrameStats> Profiler::frames() const
+{
+    std::lock_guard lock(m_mutex);
+    return std::vector<FrameStats>(m_frames.begin(), m_frames.end());
+}
+
+Profiler::FrameStats Profiler::lastFrame() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_frames.empty() ? FrameStats() : m_frames.back();
+}
+
+std::vector<Profiler::ZoneStats> Profiler::zoneStats() const
+{
+    const double scale = secondsPerTick();
+    std::map<std::string_view, ZoneStats> zones;
+
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto &data : m_threads)
+        {
+            const size_t size = data->size.load(std::memory_order_acquire);
+            for (size_t i = 0; i < size; i++)
+            {
+                const Event &event = data->events[i];
+                const double seconds = static_cast<double>(event.end - event.start) * scale;
+
+                ZoneStats &zone = zones[event.name];
+                zone.count++;
+                zone.totalSeconds += seconds;
+                zone.maxSeconds = std::max(zone.maxSeconds, seconds);
+            }
+        }
+    }
+
+    std::vector<ZoneStats> result;
+    result.reserve(zones.size());
+    for (auto &[name, zone] : zones)
+    {
+        zone.name = name;
+        result.push_back(std::move(zone));
+    }
+
+    std::sort(result.begin(), result.end(), [](const ZoneStats &a, const ZoneStats &b)
+              { return a.totalSeconds > b.totalSeconds; });
+    return result;
+}
+
+size_t Profiler::eventCount() const
+{
+    std::lock_guard lock(m_mutex);
+
+    size_t count = 0;
+    for (const auto &data : m_threads)
+        count += data->size.load(std::memory_order_acquire);
+    return count;
+}
+
+size_t Profiler::droppedEvents() const
+{
+    std::lock_guard lock(m_mutex);
+
+    size_t count = 0;
+    for (const auto &data : m_threads)
+        count += data->dropped.load(std::memory_order_relaxed);
+    return count;
+}
+
+std::string Profiler::chromeTrace() const
+{
+    const double scale = secondsPerTick();
+    auto microseconds = [this, scale](uint64_t ticks)
+    {
+        return ticks <= m_originTicks ? 0.0 : static_cast<double>(ticks - m_originTicks) * scale * 1e6;
+    };
+
+    std::lock_guard lock(m_mutex);
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separate = [&out, &first]()
+    {
+        if (!first)
+            out += ",\n";
+        first = false;
+    };
+
+    for (const auto &data : m_threads)
+    {
+        separate();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(data->id) + ",\"args\":{\"name\":\"";
+        appendEscaped(out, data->name);
+        out += "\"}}";
+
+        const size_t size = data->size.load(std::memory_order_acquire);
+        for (size_t i = 0; i < size; i++)
+        {
+            const Event &event = data->events[i];
+            const double start = microseconds(event.start);
+
+            separate();
+            out += "{\"name\":\"";
+            appendEscaped(out, event.name);
+            out += "\",\"cat\":\"threecpp\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(data->id) + ",\"ts\":";
+            appendNumber(out, start);
+            out += ",\"dur\":";
+            appendNumber(out, std::max(0.0, microseconds(event.end) - start));
+            out += "}";
+        }
+    }
+
+    // one counter sample per frame, at its end
+    for (const FrameStats &frame : m_frames)
+    {
+        separate();
+        out += "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"ts\":";
+        appendNumber(out, (frame.start + frame.seconds) * 1e6);
+        out += ",\"args\":{";
+        for (size_t i = 0; i < COUNTER_COUNT; i++)
+        {
+            if (i > 0)
+                out += ",";
+            out += '"';
+            out += counterName(static_cast<Counter>(i));
+            out += "\":";
+            out += std::to_string(frame.counters[i]);
+        }
+        out += "}}";
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+void Profiler::writeChromeTrace(const std::string &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Profiler: cannot write " + path);
+
+    file << chromeTrace();
+}
+
+void Profiler::clear()
+{
+    std::lock_guard lock(m_mutex);
+
+    for (const auto &data : m_threads)
+    {
+        data->size.store(0, std::memory_order_relaxed);
+        data->dropped.store(0, std::memory_order_relaxed);
+    }
+
+    m_frames.clear();
+    m_frameIndex = 0;
+    m_frameStart = now();
+}
@@ -0,0 +1,174 @@
+#include "core/BufferAttribute.h"
+#include <stdexcept>
+
+BufferAttribute::BufferAttribute(std::vector<float> array, size_t itemSize, bool normalized)
+    : m_array(std::move(array)), m_itemSize(itemSize), m_normalized(normalized)
+{
+    if (m_itemSize == 0)
+        throw std::invalid_argument("BufferAttribute: itemSize must be greater than 0");
+    m_count = m_array.size() / m_itemSize;
+}
+
+BufferAttribute::BufferAttribute(size_t count, size_t itemSize)
+    : BufferAttribute(std::vector<float>(count * itemSize, 0.0f), itemSize)
+{
+}
+
+BufferAttribute::~BufferAttribute()
+{
+}
+
+float *BufferAttribute::array()
+{
+    return m_array.data();
+}
+
+const float *BufferAttribute::array() const
+{
+    return m_array.data();
+}
+
+std::span<float> BufferAttribute::span()
+{
+    return m_array;
+}
+
+std::span<const float> BufferAttribute::span() const
+{
+    return m_array;
+}
+
+size_t BufferAttribute::count() const
+{
+    return m_count;
+}
+
+size_t BufferAttribute::itemSize() const
+{
+    return m_itemSize;
+}
+
+bool BufferAttribute::normalized() const
+{
+    return m_normalized;
+}
+
+const std::string &BufferAttribute::name() const
+{
+    return m_name;
+}
+
+void BufferAttribute::name(const std::string &value)
+{
+    m_name = value;
+}
+
+unsigned int BufferAttribute::version() const
+{
+    return m_version;
+}
+
+void BufferAttribute::needsUpdate()
+{
+    m_version++;
+}
+
+float BufferAttribute::getComponent(size_t index, size_t component) const
+{
+    return m_array[index * m_itemSize + component];
+}
+
+BufferAttribute &BufferAttribute::setComponent(size_t index, size_t component, float value)
+{
+    m_array[index * m_itemSize + component] = value;
+    return *this;
+}
+
+float BufferAttribute::getX(size_t index) const
+{
+    return m_array[index * m_itemSize];
+}
+
+float BufferAttribute::getY(size_t index) const
+{
+    return m_array[index * m_itemSize + 1];
+}
+
+float BufferAttribute::getZ(size_t index) const
+{
+    return m_array[index * m_itemSize + 2];
+}
+
+float BufferAttribute::getW(size_t index) const
+{
+    return m_array[index * m_itemSize + 3];
+}
+
+BufferAttribute &BufferAttribute::setX(size_t index, float x)
+{
+    m_array[index * m_itemSize] = x;
+    return *this;
+}
+
+BufferAttribute &BufferAttribute::setY(size_t index, float y)
+{
+    m_array[index * m_itemSize + 1] = y;
+    return *this;
+}
+
+BufferAttribute &BufferAttribute::setZ(size_t index, float z)
+{
+    m_array[index * m_itemSize + 2] = z;
+    return *this;
+}
+
+BufferAttribute &BufferAttribute::setW(size_t index, float w)
+{
+    m_array[index * m_itemSize + 3] = w;
+    return *this;
+}
+
+BufferAttribute &BufferAttribute::setXY(size_t index, float x, float y)
+{
+    index *= m_itemSize;
+
+    m_array[index + 0] = x;
+    m_array[index + 1] = y;
+
+    return *this;
+}
+
+BufferAttribute &BufferAttribute::setXYZ(size_t index, float x, float y, float z)
+{
+    index *= m_itemSize;
+
+    m_array[index + 0] = x;
+    m_array[index + 1] = y;
+    m_array[index + 2] = z;
+
+    return *this;
+}
+
+BufferAttribute &BufferAttribute::setXYZW(size_t index, float x, float y, float z, float w)
+{
+    index *= m_itemSize;
+
+    m_array[index + 0] = x;
+    m_array[index + 1] = y;
+    m_array[index + 2] = z;
+    m_array[index + 3] = w;
+
+    return *this;
+}
+
+BufferAttribute &BufferAttribute::copy(const BufferAttribute &source)
+{
+    if (source.itemSize() != m_itemSize)
+        throw std::invalid_argument("BufferAttribute: copy() requires matching item sizes");
+
+    m_array.assign(source.array(), source.array() + source.count() * source.itemSize());
+    m_count = source.count();
+    m_normalized = source.normalized();
+
+    return *this;
+}
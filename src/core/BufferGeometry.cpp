@@ -0,0 +1,189 @@
+#include "core/BufferGeometry.h"
+#include <algorithm>
+#include <cmath>
+#include "math/MathUtils.h"
+
+BufferGeometry::BufferGeometry()
+{
+    m_uuid = MathUtils::generateUUID();
+}
+
+BufferGeometry::~BufferGeometry()
+{
+}
+
+std::string BufferGeometry::type() const
+{
+    return "BufferGeometry";
+}
+
+const std::string &BufferGeometry::uuid() const
+{
+    return m_uuid;
+}
+
+const std::string &BufferGeometry::name() const
+{
+    return m_name;
+}
+
+void BufferGeometry::name(const std::string &value)
+{
+    m_name = value;
+}
+
+const std::vector<uint32_t> &BufferGeometry::getIndex() const
+{
+    return m_index;
+}
+
+std::vector<uint32_t> &BufferGeometry::getIndex()
+{
+    return m_index;
+}
+
+BufferGeometry &BufferGeometry::setIndex(std::vector<uint32_t> index)
+{
+    m_index = std::move(index);
+    return *this;
+}
+
+bool BufferGeometry::hasIndex() const
+{
+    return !m_index.empty();
+}
+
+std::shared_ptr<BufferAttribute> BufferGeometry::getAttribute(const std::string &name) const
+{
+    auto it = m_attributes.find(name);
+    return it == m_attributes.end() ? nullptr : it->second;
+}
+
+BufferGeometry &BufferGeometry::setAttribute(const std::string &name, std::shared_ptr<BufferAttribute> attribute)
+{
+    m_attributes[name] = std::move(attribute);
+    return *this;
+}
+
+BufferGeometry &BufferGeometry::deleteAttribute(const std::string &name)
+{
+    m_attributes.erase(name);
+    return *this;
+}
+
+bool BufferGeometry::hasAttribute(const std::string &name) const
+{
+    return m_attributes.find(name) != m_attributes.end();
+}
+
+const std::unordered_map<std::string, std::shared_ptr<BufferAttribute>> &BufferGeometry::attributes() const
+{
+    return m_attributes;
+}
+
+const std::vector<MorphTarget> &BufferGeometry::morphTargets() const
+{
+    return m_morphTargets;
+}
+
+std::vector<MorphTarget> &BufferGeometry::morphTargets()
+{
+    return m_morphTargets;
+}
+
+BufferGeometry &BufferGeometry::addMorphTarget(MorphTarget target)
+{
+    m_morphTargets.push_back(std::move(target));
+    return *this;
+}
+
+const Box3 *BufferGeometry::boundingBox() const
+{
+    return m_boundingBox ? &*m_boundingBox : nullptr;
+}
+
+const Sphere *BufferGeometry::boundingSphere() const
+{
+    return m_boundingSphere ? &*m_boundingSphere : nullptr;
+}
+
+void BufferGeometry::computeBoundingBox()
+{
+    if (!m_boundingBox)
+        m_boundingBox.emplace();
+
+    auto position = getAttribute("position");
+    if (!position)
+    {
+        m_boundingBox->makeEmpty();
+        return;
+    }
+
+    m_boundingBox->setFromBufferAttribute(*position);
+
+    // process morph targets if present
+
+    Vector3 _vector;
+    for (auto &target : m_morphTargets)
+    {
+        const auto indices = target.indices();
+        const auto deltas = target.positionDeltas();
+
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            _vector.fromBufferAttribute(*position, indices[i]);
+            _vector.add(Vector3(deltas[i * 3], deltas[i * 3 + 1], deltas[i * 3 + 2]));
+            m_boundingBox->expandByPoint(_vector);
+        }
+    }
+}
+
+void BufferGeometry::computeBoundingSphere()
+{
+    if (!m_boundingSphere)
+        m_boundingSphere.emplace();
+
+    auto position = getAttribute("position");
+    if (!position)
+    {
+        m_boundingSphere->makeEmpty();
+        return;
+    }
+
+    // first, find the center of the bounding sphere
+
+    computeBoundingBox();
+    Vector3 center;
+    m_boundingBox->getCenter(center);
+
+    // second, try to find a boundingSphere with a radius smaller than the
+    // boundingSphere of the boundingBox: sqrt(3) smaller in the best case
+
+    const float cx = static_cast<float>(center.x()), cy = static_cast<float>(center.y()), cz = static_cast<float>(center.z());
+    const float *array = position->array();
+    const size_t itemSize = position->itemSize();
+
+    float maxRadiusSq = 0;
+
+    for (size_t i = 0, il = position->count(); i < il; i++)
+    {
+        const float *p = array + i * itemSize;
+        const float dx = p[0] - cx, dy = p[1] - cy, dz = p[2] - cz;
+        maxRadiusSq = std::max(maxRadiusSq, dx * dx + dy * dy + dz * dz);
+    }
+
+    for (auto &target : m_morphTargets)
+    {
+        const auto indices = target.indices();
+        const auto deltas = target.positionDeltas();
+
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            const float *p = array + indices[i] * itemSize;
+            const float dx = p[0] + deltas[i * 3] - cx, dy = p[1] + deltas[i * 3 + 1] - cy, dz = p[2] + deltas[i * 3 + 2] - cz;
+            maxRadiusSq = std::max(maxRadiusSq, dx * dx + dy * dy + dz * dz);
+        }
+    }
+
+    m_boundingSphere->set(center, std::sqrt(maxRadiusSq));
+}
@@ -0,0 +1,620 @@
+#include "core/GeometryCompression.h"
+#include "common/Parallel.h"
+#include "math/MathUtils.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// vertices per task when decoding
+static constexpr size_t VERTEX_GRAIN = 65536;
+
+namespace
+{
+    bool isUV(const std::string &name, const BufferAttribute &attribute)
+    {
+        if (attribute.itemSize() != 2 || name.compare(0, 2, "uv") != 0)
+            return false;
+
+        return std::all_of(name.begin() + 2, name.end(), [](char c)
+                           { return c >= '0' && c <= '9'; });
+    }
+
+    // dequantization as float offset and step per axis, shared by the
+    // scalar and SSE paths so both decode bit-identical values
+    void positionTransform(const Box3 &bounds, float offset[3], float scale[3])
+    {
+        const Vector3 &min = bounds.min();
+        const Vector3 &max = bounds.max();
+        const HIGH_PRECISION lo[3] = {min.x(), min.y(), min.z()};
+        const HIGH_PRECISION hi[3] = {max.x(), max.y(), max.z()};
+
+        for (int c = 0; c < 3; c++)
+        {
+            offset[c] = static_cast<float>(lo[c]);
+            scale[c] = static_cast<float>((hi[c] - lo[c]) * MathUtils::denormalize<uint16_t>(1));
+        }
+    }
+
+    inline void octahedralToNormal(float x, float y, float *n)
+    {
+        x = std::max(x, -1.0f);
+        y = std::max(y, -1.0f);
+
+        // unfold the lower hemisphere
+        const float z = 1 - std::abs(x) - std::abs(y);
+        const float t = std::max(-z, 0.0f);
+        x = x >= 0 ? x - t : x + t;
+        y = y >= 0 ? y - t : y + t;
+
+        const float inverse = 1 / std::sqrt(x * x + y * y + z * z);
+        n[0] = x * inverse;
+        n[1] = y * inverse;
+        n[2] = z * inverse;
+    }
+
+    template <typename T>
+    void encodeOctahedralT(std::span<const float> normals, std::span<T> encoded)
+    {
+        constexpr float steps = static_cast<float>(std::numeric_limits<T>::max());
+        const size_t count = normals.size() / 3;
+
+        if (encoded.size() < count * 2)
+            throw std::invalid_argument("GeometryCompression: octahedral output too small");
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const float *n = normals.data() + i * 3;
+            const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            const float sum = std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]);
+
+            if (sum == 0)
+            {
+                encoded[i * 2] = 0;
+                encoded[i * 2 + 1] = 0;
+                continue;
+            }
+
+            // project onto the octahedron, fold the lower hemisphere over
+            float x = n[0] / sum;
+            float y = n[1] / sum;
+            if (n[2] < 0)
+            {
+                const float fx = (1 - std::abs(y)) * (x >= 0 ? 1.0f : -1.0f);
+                const float fy = (1 - std::abs(x)) * (y >= 0 ? 1.0f : -1.0f);
+                x = fx;
+                y = fy;
+            }
+
+            // the rounded grid point is not always the closest in angle:
+            // try its neighbours too
+            const int qx = MathUtils::normalize<T>(x);
+            const int qy = MathUtils::normalize<T>(y);
+            const int limit = static_cast<int>(steps);
+
+            int bestX = qx, bestY = qy;
+            float bestDot = -2;
+
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    const int cx = std::clamp(qx + dx, -limit, limit);
+                    const int cy = std::clamp(qy + dy, -limit, limit);
+
+                    float decoded[3];
+                    octahedralToNormal(cx / steps, cy / steps, decoded);
+                    const float dot = (decoded[0] * n[0] + decoded[1] * n[1] + decoded[2] * n[2]) / length;
+
+                    if (dot > bestDot)
+                    {
+                        bestDot = dot;
+                        bestX = cx;
+                        bestY = cy;
+                    }
+                }
+            }
+
+            encoded[i * 2] = static_cast<T>(bestX);
+            encoded[i * 2 + 1] = static_cast<T>(bestY);
+        }
+    }
+
+#if defined(__SSE2__)
+    // four normals from sign-extended 32-bit components; stores four floats
+    // per normal, so the caller must leave room for one more normal
+    inline void decodeOctahedral4(__m128i xi, __m128i yi, float inverseSteps, float *out)
+    {
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+
+        __m128 x = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(xi), _mm_set1_ps(inverseSteps)), minusOne);
+        __m128 y = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(yi), _mm_set1_ps(inverseSteps)), minusOne);
+        __m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, x)), _mm_andnot_ps(sign, y));
+
+        // x -= copysign(t, x) unfolds the lower hemisphere
+        const __m128 t = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+        x = _mm_sub_ps(x, _mm_xor_ps(t, _mm_and_ps(x, sign)));
+        y = _mm_sub_ps(y, _mm_xor_ps(t, _mm_and_ps(y, sign)));
+
+        const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 inverse = _mm_div_ps(one, _mm_sqrt_ps(lengthSq));
+        x = _mm_mul_ps(x, inverse);
+        y = _mm_mul_ps(y, inverse);
+        z = _mm_mul_ps(z, inverse);
+
+        __m128 w = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        _mm_storeu_ps(out, x);
+        _mm_storeu_ps(out + 3, y);
+        _mm_storeu_ps(out + 6, z);
+        _mm_storeu_ps(out + 9, w);
+    }
+#endif
+
+    inline uint16_t floatToHalf(float value)
+    {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        const uint32_t sign = (bits >> 16) & 0x8000;
+        uint32_t magnitude = bits & 0x7FFFFFFF;
+
+        // rounds to infinity, or is infinity or NaN
+        if (magnitude >= 0x477FF000)
+            return static_cast<uint16_t>(sign | (magnitude > 0x7F800000 ? 0x7E00 : 0x7C00));
+
+        // subnormal half: let the FPU round in units of 2^-24
+        if (magnitude < 0x38800000)
+            return static_cast<uint16_t>(sign | static_cast<uint32_t>(std::nearbyint(std::bit_cast<float>(magnitude) * 16777216.0f)));
+
+        // rebias the exponent and round the mantissa to nearest even
+        magnitude += 0xC8000FFF + ((magnitude >> 13) & 1);
+        return static_cast<uint16_t>(sign | (magnitude >> 13));
+    }
+
+    inline float halfToFloat(uint16_t half)
+    {
+        // shifting the exponent and mantissa into place and scaling by 2^112
+        // rebiases normal and subnormal halves alike
+        const uint32_t shifted = static_cast<uint32_t>(half & 0x7FFF) << 13;
+        uint32_t bits = std::bit_cast<uint32_t>(std::bit_cast<float>(shifted) * std::bit_cast<float>(0x77800000u));
+
+        if (shifted >= 0x0F800000)
+            bits |= 0x7F800000;
+
+        return std::bit_cast<float>(bits | static_cast<uint32_t>(half & 0x8000) << 16);
+    }
+
+    template <typename T>
+    void decodeOctahedralChunk(const T *encoded, size_t count, float *normals);
+
+    template <>
+    void decodeOctahedralChunk<int16_t>(const int16_t *encoded, size_t count, float *normals)
+    {
+        constexpr float inverseSteps = 1.0f / 32767.0f;
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        for (; i + 5 <= count; i += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(encoded + i * 2));
+            decodeOctahedral4(_mm_srai_epi32(_mm_slli_epi32(v, 16), 16), _mm_srai_epi32(v, 16), inverseSteps, normals + i * 3);
+        }
+#endif
+
+        for (; i < count; i++)
+            octahedralToNormal(encoded[i * 2] * inverseSteps, encoded[i * 2 + 1] * inverseSteps, normals + i * 3);
+    }
+
+    template <>
+    void decodeOctahedralChunk<int8_t>(const int8_t *encoded, size_t count, float *normals)
+    {
+        constexpr float inverseSteps = 1.0f / 127.0f;
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        for (; i + 5 <= count; i += 4)
+        {
+            const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(encoded + i * 2));
+            // sign extend bytes to 16 bits, then split x and y as above
+            const __m128i v = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+            decodeOctahedral4(_mm_srai_epi32(_mm_slli_epi32(v, 16), 16), _mm_srai_epi32(v, 16), inverseSteps, normals + i * 3);
+        }
+#endif
+
+        for (; i < count; i++)
+            octahedralToNormal(encoded[i * 2] * inverseSteps, encoded[i * 2 + 1] * inverseSteps, normals + i * 3);
+    }
+
+    void decodePositionsChunk(const uint16_t *quantized, size_t count, const float offset[3], const float scale[3], float *positions)
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        // eight vertices, 24 components, per step; the per-axis transform
+        // repeats every three registers
+        const __m128 o0 = _mm_setr_ps(offset[0], offset[1], offset[2], offset[0]);
+        const __m128 o1 = _mm_setr_ps(offset[1], offset[2], offset[0], offset[1]);
+        const __m128 o2 = _mm_setr_ps(offset[2], offset[0], offset[1], offset[2]);
+        const __m128 s0 = _mm_setr_ps(scale[0], scale[1], scale[2], scale[0]);
+        const __m128 s1 = _mm_setr_ps(scale[1], scale[2], scale[0], scale[1]);
+        const __m128 s2 = _mm_setr_ps(scale[2], scale[0], scale[1], scale[2]);
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i *src = reinterpret_cast<const __m128i *>(quantized + i * 3);
+            const __m128i a = _mm_loadu_si128(src);
+            const __m128i b = _mm_loadu_si128(src + 1);
+            const __m128i c = _mm_loadu_si128(src + 2);
+            float *dst = positions + i * 3;
+
+            _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(a, zero)), s0), o0));
+            _mm_storeu_ps(dst + 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(a, zero)), s1), o1));
+            _mm_storeu_ps(dst + 8, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(b, zero)), s2), o2));
+            _mm_storeu_ps(dst + 12, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(b, zero)), s0), o0));
+            _mm_storeu_ps(dst + 16, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(c, zero)), s1), o1));
+            _mm_storeu_ps(dst + 20, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(c, zero)), s2), o2));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            for (int c = 0; c < 3; c++)
+                positions[i * 3 + c] = static_cast<float>(quantized[i * 3 + c]) * scale[c] + offset[c];
+        }
+    }
+
+    void decodeHalfChunk(const uint16_t *halves, size_t count, float *values)
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i magnitudeMask = _mm_set1_epi32(0x7FFF);
+        const __m128i signMask = _mm_set1_epi32(0x8000);
+        const __m128i infinity = _mm_set1_epi32(0x7F800000);
+        const __m128i largestFinite = _mm_set1_epi32(0x0F7FFFFF);
+        const __m128 rebias = _mm_castsi128_ps(_mm_set1_epi32(0x77800000));
+
+        const auto convert = [&](__m128i h)
+        {
+            const __m128i shifted = _mm_slli_epi32(_mm_and_si128(h, magnitudeMask), 13);
+            const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, signMask), 16);
+            const __m128i special = _mm_and_si128(_mm_cmpgt_epi32(shifted, largestFinite), infinity);
+            const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(shifted), rebias);
+
+            return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(special, sign)));
+        };
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(halves + i));
+            _mm_storeu_ps(values + i, convert(_mm_unpacklo_epi16(v, zero)));
+            _mm_storeu_ps(values + i + 4, convert(_mm_unpackhi_epi16(v, zero)));
+        }
+#endif
+
+        for (; i < count; i++)
+            values[i] = halfToFloat(halves[i]);
+    }
+
+    float maxAbsError(std::span<const float> a, std::span<const float> b)
+    {
+        float error = 0;
+        for (size_t i = 0; i < a.size(); i++)
+            error = std::max(error, std::abs(a[i] - b[i]));
+        return error;
+    }
+
+    float maxAngleError(std::span<const float> reference, std::span<const float> decoded)
+    {
+        double minCos = 1;
+
+        for (size_t i = 0; i + 2 < reference.size(); i += 3)
+        {
+            const double x = reference[i], y = reference[i + 1], z = reference[i + 2];
+            const double length = std::sqrt(x * x + y * y + z * z);
+            if (length == 0)
+                continue;
+
+            const double dot = (x * decoded[i] + y * decoded[i + 1] + z * decoded[i + 2]) / length;
+            minCos = std::min(minCos, dot);
+        }
+
+        return static_cast<float>(std::acos(std::clamp(minCos, -1.0, 1.0)));
+    }
+}
+
+namespace GeometryCompression
+{
+    double Stats::ratio() const
+    {
+        return bytesAfter == 0 ? 0.0 : static_cast<double>(bytesBefore) / static_cast<double>(bytesAfter);
+    }
+
+    void encodePositions(std::span<const float> positions, const Box3 &bounds, std::span<uint16_t> quantized)
+    {
+        if (quantized.size() < positions.size() - positions.size() % 3)
+            throw std::invalid_argument("GeometryCompression: position output too small");
+
+        const Vector3 &min = bounds.min();
+        const Vector3 &max = bounds.max();
+        const HIGH_PRECISION lo[3] = {min.x(), min.y(), min.z()};
+        const HIGH_PRECISION extent[3] = {max.x() - min.x(), max.y() - min.y(), max.z() - min.z()};
+
+        for (size_t i = 0; i + 2 < positions.size(); i += 3)
+        {
+            for (int c = 0; c < 3; c++)
+                quantized[i + c] = extent[c] > 0 ? MathUtils::normalize<uint16_t>((positions[i + c] - lo[c]) / extent[c]) : 0;
+        }
+    }
+
+    void decodePositions(std::span<const uint16_t> quantized, const Box3 &bounds, std::span<float> positions)
+    {
+        const size_t count = quantized.size() / 3;
+        if (positions.size() < count * 3)
+            throw std::invalid_argument("GeometryCompression: position output too small");
+
+        float offset[3], scale[3];
+        positionTransform(bounds, offset, scale);
+
+        decodePositionsChunk(quantized.data(), count, offset, scale, positions.data());
+    }
+
+    void encodeOctahedral(std::span<const float> normals, std::span<int16_t> encoded)
+    {
+        encodeOctahedralT(normals, encoded);
+    }
+
+    void encodeOctahedral(std::span<const float> normals, std::span<int8_t> encoded)
+    {
+        encodeOctahedralT(normals, encoded);
+    }
+
+    void decodeOctahedral(std::span<const int16_t> encoded, std::span<float> normals)
+    {
+        const size_t count = encoded.size() / 2;
+        if (normals.size() < count * 3)
+            throw std::invalid_argument("GeometryCompression: normal output too small");
+
+        decodeOctahedralChunk(encoded.data(), count, normals.data());
+    }
+
+    void decodeOctahedral(std::span<const int8_t> encoded, std::span<float> normals)
+    {
+        const size_t count = encoded.size() / 2;
+        if (normals.size() < count * 3)
+            throw std::invalid_argument("GeometryCompression: normal output too small");
+
+        decodeOctahedralChunk(encoded.data(), count, normals.data());
+    }
+
+    void encodeHalf(std::span<const float> values, std::span<uint16_t> halves)
+    {
+        if (halves.size() < values.size())
+            throw std::invalid_argument("GeometryCompression: half output too small");
+
+        for (size_t i = 0; i < values.size(); i++)
+            halves[i] = floatToHalf(values[i]);
+    }
+
+    void decodeHalf(std::span<const uint16_t> halves, std::span<float> values)
+    {
+        if (values.size() < halves.size())
+            throw std::invalid_argument("GeometryCompression: half output too small");
+
+        decodeHalfChunk(halves.data(), halves.size(), values.data());
+    }
+
+    std::vector<uint8_t> encodeIndices(std::span<const uint32_t> indices)
+    {
+        std::vector<uint8_t> bytes;
+        bytes.reserve(indices.size() * 2);
+
+        uint32_t previous = 0;
+        for (uint32_t index : indices)
+        {
+            const int32_t delta = static_cast<int32_t>(index - previous);
+            uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+            previous = index;
+
+            while (zigzag >= 0x80)
+            {
+                bytes.push_back(static_cast<uint8_t>(zigzag | 0x80));
+                zigzag >>= 7;
+            }
+            bytes.push_back(static_cast<uint8_t>(zigzag));
+        }
+
+        return bytes;
+    }
+
+    void decodeIndices(std::span<const uint8_t> bytes, std::span<uint32_t> indices)
+    {
+        size_t offset = 0;
+        uint32_t previous = 0;
+
+        for (auto &index : indices)
+        {
+            uint32_t zigzag = 0;
+            uint32_t shift = 0;
+            uint8_t byte;
+
+            do
+            {
+                if (offset == bytes.size() || shift > 28)
+                    throw std::runtime_error("GeometryCompression: truncated index data");
+
+                byte = bytes[offset++];
+                zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+
+            previous += (zigzag >> 1) ^ (0u - (zigzag & 1));
+            index = previous;
+        }
+    }
+
+    CompressedGeometry compress(const BufferGeometry &geometry, const Settings &settings)
+    {
+        if (settings.normalBits != 8 && settings.normalBits != 16)
+            throw std::invalid_argument("GeometryCompression: normalBits must be 8 or 16");
+
+        const auto start = std::chrono::steady_clock::now();
+
+        CompressedGeometry result;
+        auto &stats = result.stats;
+
+        for (const auto &[name, attribute] : geometry.attributes())
+            result.vertexCount = std::max(result.vertexCount, attribute->count());
+
+        for (const auto &[name, attribute] : geometry.attributes())
+        {
+            const auto values = attribute->span();
+            const size_t bytesBefore = values.size() * sizeof(float);
+
+            AttributeStats entry;
+            entry.name = name;
+            entry.bytesBefore = bytesBefore;
+
+            std::vector<float> decoded(values.size());
+
+            if (name == "position" && attribute->itemSize() == 3)
+            {
+                result.bounds.setFromArray(values);
+                result.positions.resize(values.size());
+
+                encodePositions(values, result.bounds, result.positions);
+                decodePositions(result.positions, result.bounds, decoded);
+
+                entry.bytesAfter = result.positions.size() * sizeof(uint16_t);
+                entry.maxError = maxAbsError(values, decoded);
+            }
+            else if (name == "normal" && attribute->itemSize() == 3)
+            {
+                result.normalBits = settings.normalBits;
+
+                if (settings.normalBits == 16)
+                {
+                    result.normals16.resize(attribute->count() * 2);
+                    encodeOctahedral(values, std::span<int16_t>(result.normals16));
+                    decodeOctahedral(std::span<const int16_t>(result.normals16), decoded);
+                    entry.bytesAfter = result.normals16.size() * sizeof(int16_t);
+                }
+                else
+                {
+                    result.normals8.resize(attribute->count() * 2);
+                    encodeOctahedral(values, std::span<int8_t>(result.normals8));
+                    decodeOctahedral(std::span<const int8_t>(result.normals8), decoded);
+                    entry.bytesAfter = result.normals8.size() * sizeof(int8_t);
+                }
+
+                entry.maxError = maxAngleError(values, decoded);
+            }
+            else if (isUV(name, *attribute))
+            {
+                std::vector<uint16_t> halves(values.size());
+                encodeHalf(values, halves);
+                decodeHalf(halves, decoded);
+
+                entry.bytesAfter = halves.size() * sizeof(uint16_t);
+                entry.maxError = maxAbsError(values, decoded);
+                result.uvs.emplace_back(name, std::move(halves));
+            }
+            else
+            {
+                result.uncompressed.emplace(name, attribute);
+                entry.bytesAfter = bytesBefore;
+            }
+
+            stats.bytesBefore += entry.bytesBefore;
+            stats.bytesAfter += entry.bytesAfter;
+            stats.attributes.push_back(std::move(entry));
+        }
+
+        if (geometry.hasIndex())
+        {
+            const auto &index = geometry.getIndex();
+            result.indexCount = index.size();
+            result.indices = encodeIndices(index);
+
+            AttributeStats entry;
+            entry.name = "index";
+            entry.bytesBefore = index.size() * sizeof(uint32_t);
+            entry.bytesAfter = result.indices.size();
+
+            stats.bytesBefore += entry.bytesBefore;
+            stats.bytesAfter += entry.bytesAfter;
+            stats.attributes.push_back(std::move(entry));
+        }
+
+        result.morphTargets = geometry.morphTargets();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return result;
+    }
+
+    std::shared_ptr<BufferGeometry> decompress(const CompressedGeometry &compressed)
+    {
+        auto geometry = std::make_shared<BufferGeometry>();
+        const size_t count = compressed.vertexCount;
+
+        std::shared_ptr<BufferAttribute> position, normal;
+        std::vector<std::shared_ptr<BufferAttribute>> uvs;
+
+        if (!compressed.positions.empty())
+            position = std::make_shared<BufferAttribute>(count, 3);
+        if (compressed.normalBits != 0)
+            normal = std::make_shared<BufferAttribute>(count, 3);
+        for (const auto &uv : compressed.uvs)
+            uvs.push_back(std::make_shared<BufferAttribute>(uv.second.size() / 2, 2));
+
+        float offset[3], scale[3];
+        positionTransform(compressed.bounds, offset, scale);
+
+        // all attributes of a vertex range per task
+        Parallel::parallelFor(0, count, VERTEX_GRAIN, [&](size_t begin, size_t end)
+                              {
+            const size_t n = end - begin;
+
+            if (position)
+                decodePositionsChunk(compressed.positions.data() + begin * 3, n, offset, scale, position->array() + begin * 3);
+
+            if (normal && compressed.normalBits == 16)
+                decodeOctahedralChunk(compressed.normals16.data() + begin * 2, n, normal->array() + begin * 3);
+            else if (normal)
+                decodeOctahedralChunk(compressed.normals8.data() + begin * 2, n, normal->array() + begin * 3);
+
+            for (size_t k = 0; k < uvs.size(); k++)
+                decodeHalfChunk(compressed.uvs[k].second.data() + begin * 2, n * 2, uvs[k]->array() + begin * 2); });
+
+        if (position)
+            geometry->setAttribute("position", position);
+        if (normal)
+            geometry->setAttribute("normal", normal);
+        for (size_t k = 0; k < uvs.size(); k++)
+            geometry->setAttribute(compressed.uvs[k].first, uvs[k]);
+        for (const auto &[name, attribute] : compressed.uncompressed)
+            geometry->setAttribute(name, attribute);
+
+        if (compressed.indexCount > 0)
+        {
+            std::vector<uint32_t> index(compressed.indexCount);
+            decodeIndices(compressed.indices, index);
+            geometry->setIndex(std::move(index));
+        }
+
+        for (const auto &target : compressed.morphTargets)
+            geometry->addMorphTarget(target);
+
+        return geometry;
+    }
+}
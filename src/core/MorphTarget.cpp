@@ -0,0 +1,102 @@
+#include "core/MorphTarget.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+MorphTarget::MorphTarget(std::string name, std::vector<uint32_t> indices, std::vector<float> positionDeltas, std::vector<float> normalDeltas)
+    : m_name(std::move(name)), m_indices(std::move(indices)), m_positionDeltas(std::move(positionDeltas)), m_normalDeltas(std::move(normalDeltas))
+{
+    if (m_positionDeltas.size() != m_indices.size() * 3)
+        throw std::invalid_argument("MorphTarget: expected three position deltas per index in target " + m_name);
+
+    if (!m_normalDeltas.empty() && m_normalDeltas.size() != m_indices.size() * 3)
+        throw std::invalid_argument("MorphTarget: expected three normal deltas per index in target " + m_name);
+
+    // the blend kernel splits vertex ranges with a binary search
+    if (std::adjacent_find(m_indices.begin(), m_indices.end(), std::greater_equal<uint32_t>()) != m_indices.end())
+        throw std::invalid_argument("MorphTarget: indices must be strictly ascending in target " + m_name);
+}
+
+MorphTarget::~MorphTarget()
+{
+}
+
+MorphTarget MorphTarget::fromDense(std::string name, const BufferAttribute &basePosition, const BufferAttribute &position,
+                                   const BufferAttribute *baseNormal, const BufferAttribute *normal,
+                                   bool relative, float epsilon)
+{
+    const size_t count = basePosition.count();
+
+    if (position.count() != count || (normal != nullptr && normal->count() != count))
+        throw std::invalid_argument("MorphTarget: target " + name + " does not match the base vertex count");
+
+    const bool withNormals = normal != nullptr && (relative || baseNormal != nullptr);
+
+    std::vector<uint32_t> indices;
+    std::vector<float> positionDeltas;
+    std::vector<float> normalDeltas;
+
+    float p[3], n[3] = {0, 0, 0};
+
+    for (size_t i = 0; i < count; i++)
+    {
+        bool touched = false;
+
+        for (size_t k = 0; k < 3; k++)
+        {
+            p[k] = position.getComponent(i, k) - (relative ? 0.0f : basePosition.getComponent(i, k));
+            touched |= std::abs(p[k]) > epsilon;
+        }
+
+        if (withNormals)
+        {
+            for (size_t k = 0; k < 3; k++)
+            {
+                n[k] = normal->getComponent(i, k) - (relative ? 0.0f : baseNormal->getComponent(i, k));
+                touched |= std::abs(n[k]) > epsilon;
+            }
+        }
+
+        if (!touched)
+            continue;
+
+        indices.push_back(static_cast<uint32_t>(i));
+        positionDeltas.insert(positionDeltas.end(), p, p + 3);
+
+        if (withNormals)
+            normalDeltas.insert(normalDeltas.end(), n, n + 3);
+    }
+
+    return MorphTarget(std::move(name), std::move(indices), std::move(positionDeltas), std::move(normalDeltas));
+}
+
+const std::string &MorphTarget::name() const
+{
+    return m_name;
+}
+
+std::span<const uint32_t> MorphTarget::indices() const
+{
+    return m_indices;
+}
+
+std::span<const float> MorphTarget::positionDeltas() const
+{
+    return m_positionDeltas;
+}
+
+std::span<const float> MorphTarget::normalDeltas() const
+{
+    return m_normalDeltas;
+}
+
+bool MorphTarget::hasNormals() const
+{
+    return !m_normalDeltas.empty();
+}
+
+size_t MorphTarget::count() const
+{
+    return m_indices.size();
+}
@@ -0,0 +1,283 @@
+#include "core/Object3D.h"
+#include "common/Profiler.h"
+#include "math/MathUtils.h"
+#include <algorithm>
+#include <atomic>
+
+static std::atomic<unsigned int> _object3DId{0};
+
+Object3D::Object3D()
+{
+    m_id = _object3DId++;
+    m_uuid = MathUtils::generateUUID();
+}
+
+Object3D::~Object3D()
+{
+    for (auto &child : m_children)
+        child->m_parent = nullptr;
+}
+
+std::string Object3D::type() const
+{
+    return "Object3D";
+}
+
+unsigned int Object3D::id() const
+{
+    return m_id;
+}
+
+const std::string &Object3D::uuid() const
+{
+    return m_uuid;
+}
+
+void Object3D::uuid(const std::string &value)
+{
+    m_uuid = value;
+}
+
+const std::string &Object3D::name() const
+{
+    return m_name;
+}
+
+void Object3D::name(const std::string &value)
+{
+    m_name = value;
+}
+
+Object3D *Object3D::parent() const
+{
+    return m_parent;
+}
+
+const std::vector<std::shared_ptr<Object3D>> &Object3D::children() const
+{
+    return m_children;
+}
+
+Vector3 &Object3D::position()
+{
+    return m_position;
+}
+
+const Vector3 &Object3D::position() const
+{
+    return m_position;
+}
+
+Quaternion &Object3D::quaternion()
+{
+    return m_quaternion;
+}
+
+const Quaternion &Object3D::quaternion() const
+{
+    return m_quaternion;
+}
+
+Vector3 &Object3D::scale()
+{
+    return m_scale;
+}
+
+const Vector3 &Object3D::scale() const
+{
+    return m_scale;
+}
+
+Matrix4 &Object3D::matrix()
+{
+    return m_matrix;
+}
+
+const Matrix4 &Object3D::matrix() const
+{
+    return m_matrix;
+}
+
+Matrix4 &Object3D::matrixWorld()
+{
+    return m_matrixWorld;
+}
+
+const Matrix4 &Object3D::matrixWorld() const
+{
+    return m_matrixWorld;
+}
+
+Object3D &Object3D::add(const std::shared_ptr<Object3D> &object)
+{
+    if (!object || object.get() == this)
+        return *this;
+
+    // keep the object alive while it moves between parents
+    auto keepAlive = object;
+    object->removeFromParent();
+    object->m_parent = this;
+    m_children.push_back(keepAlive);
+
+    return *this;
+}
+
+Object3D &Object3D::remove(Object3D *object)
+{
+    auto it = std::find_if(m_children.begin(), m_children.end(),
+                           [object](const std::shared_ptr<Object3D> &child)
+                           { return child.get() == object; });
+
+    if (it != m_children.end())
+    {
+        (*it)->m_parent = nullptr;
+        m_children.erase(it);
+    }
+
+    return *this;
+}
+
+Object3D &Object3D::removeFromParent()
+{
+    if (m_parent != nullptr)
+        m_parent->remove(this);
+
+    return *this;
+}
+
+Object3D &Object3D::clear()
+{
+    for (auto &child : m_children)
+        child->m_parent = nullptr;
+    m_children.clear();
+
+    return *this;
+}
+
+Object3D *Object3D::getObjectByName(const std::string &name)
+{
+    if (m_name == name)
+        return this;
+
+    for (auto &child : m_children)
+    {
+        auto object = child->getObjectByName(name);
+        if (object != nullptr)
+            return object;
+    }
+
+    return nullptr;
+}
+
+void Object3D::traverse(const std::function<void(Object3D &)> &callback)
+{
+    callback(*this);
+
+    for (auto &child : m_children)
+        child->traverse(callback);
+}
+
+void Object3D::updateMatrix()
+{
+    m_matrix.compose(m_position, m_quaternion, m_scale);
+    matrixWorldNeedsUpdate = true;
+    THREECPP_PROFILE_COUNT(MatricesComposed, 1);
+}
+
+void Object3D::updateMatrixWorld(bool force)
+{
+    // one zone for the whole traversal, not one per node
+    THREECPP_PROFILE_ZONE_IF("Object3D::updateMatrixWorld", m_parent == nullptr);
+    THREECPP_PROFILE_COUNT(NodesUpdated, 1);
+
+    if (matrixAutoUpdate)
+        updateMatrix();
+
+    if (matrixWorldNeedsUpdate || force)
+    {
+        if (matrixWorldAutoUpdate)
+        {
+            if (m_parent == nullptr)
+            {
+                m_matrixWorld.copy(m_matrix);
+            }
+            else
+            {
+                m_matrixWorld.multiplyMatrices(m_parent->m_matrixWorld, m_matrix);
+            }
+        }
+
+        matrixWorldNeedsUpdate = false;
+        force = true;
+    }
+
+    // make sure descendants are updated if required
+
+    for (auto &child : m_children)
+        child->updateMatrixWorld(force);
+}
+
+void Object3D::updateWorldMatrix(bool updateParents, bool updateChildren)
+{
+    THREECPP_PROFILE_COUNT(NodesUpdated, 1);
+
+    if (updateParents && m_parent != nullptr)
+        m_parent->updateWorldMatrix(true, false);
+
+    if (matrixAutoUpdate)
+        updateMatrix();
+
+    if (matrixWorldAutoUpdate)
+    {
+        if (m_parent == nullptr)
+        {
+            m_matrixWorld.copy(m_matrix);
+        }
+        else
+        {
+            m_matrixWorld.multiplyMatrices(m_parent->m_matrixWorld, m_matrix);
+        }
+    }
+
+    // make sure descendants are updated
+
+    if (updateChildren)
+    {
+        for (auto &child : m_children)
+            child->updateWorldMatrix(false, true);
+    }
+}
+
+void Object3D::localToWorld(Vector3 &vector) const
+{
+    vector.applyMatrix4(m_matrixWorld);
+}
+
+void Object3D::worldToLocal(Vector3 &vector) const
+{
+    Matrix4 _m1;
+    _m1.copy(m_matrixWorld);
+    _m1.invert();
+    vector.applyMatrix4(_m1);
+}
+
+void Object3D::getWorldPosition(Vector3 &target)
+{
+    updateWorldMatrix(true, false);
+    target.setFromMatrixPosition(m_matrixWorld);
+}
+
+void Object3D::getWorldQuaternion(Quaternion &target)
+{
+    updateWorldMatrix(true, false);
+    Vector3 _position, _scale;
+    m_matrixWorld.decompose(_position, target, _scale);
+}
+
+void Object3D::getWorldScale(Vector3 &target)
+{
+    updateWorldMatrix(true, false);
+    Vector3 _position;
+    Quaternion _quaternion;
+    m_matrixWorld.decompose(_position, _quaternion, target);
+}
@@ -0,0 +1,912 @@
+#include "ecs/TransformWorld.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+// chunks per task when a system is split across threads
+static constexpr size_t CHUNK_GRAIN = 8;
+
+static constexpr uint32_t ALL_COMPONENTS = (1u << TransformWorld::COMPONENT_COUNT) - 1;
+static constexpr uint32_t REQUIRED_COMPONENTS = TransformWorld::LocalMatrix | TransformWorld::WorldMatrix;
+
+// floats per entity, indexed by component bit
+static constexpr size_t STRIDES[TransformWorld::COMPONENT_COUNT] = {3, 4, 3, 16, 16, 6};
+
+static constexpr float IDENTITY[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+static size_t componentIndex(uint32_t component)
+{
+    return static_cast<size_t>(std::countr_zero(component));
+}
+
+static void makeEmptyBox(float *box)
+{
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    box[0] = box[1] = box[2] = inf;
+    box[3] = box[4] = box[5] = -inf;
+}
+
+static Box3 toBox3(const float *box)
+{
+    return Box3(Vector3(box[0], box[1], box[2]), Vector3(box[3], box[4], box[5]));
+}
+
+struct TransformWorld::Chunk
+{
+    uint32_t archetype = 0;
+    uint32_t components = 0;
+    uint32_t depth = 0;
+    uint32_t count = 0;
+
+    std::vector<uint32_t> entities;
+    // entity index of each entity's parent, NONE for roots
+    std::vector<uint32_t> parents;
+    // one array per component, empty when the archetype lacks it
+    std::vector<float> data[COMPONENT_COUNT];
+    // world boxes, next to the local ones of the Bounds component
+    std::vector<float> worldBounds;
+    float bounds[6];
+
+    uint32_t versions[COMPONENT_COUNT] = {};
+    // chunks holding parents of entities here; only grows
+    std::vector<uint32_t> parentChunks;
+
+    float *array(uint32_t component)
+    {
+        auto &values = data[componentIndex(component)];
+        return values.empty() ? nullptr : values.data();
+    }
+};
+
+TransformWorld::Entity::operator bool() const
+{
+    return index != UINT32_MAX;
+}
+
+// ChunkView
+
+TransformWorld::ChunkView::ChunkView(Chunk *chunk, uint32_t version)
+    : m_chunk(chunk), m_version(version)
+{
+}
+
+uint32_t TransformWorld::ChunkView::components() const
+{
+    return m_chunk->components;
+}
+
+uint32_t TransformWorld::ChunkView::depth() const
+{
+    return m_chunk->depth;
+}
+
+size_t TransformWorld::ChunkView::size() const
+{
+    return m_chunk->count;
+}
+
+std::span<const uint32_t> TransformWorld::ChunkView::entities() const
+{
+    return {m_chunk->entities.data(), m_chunk->count};
+}
+
+uint32_t TransformWorld::ChunkView::version(Component component) const
+{
+    return m_chunk->versions[componentIndex(component)];
+}
+
+std::span<float> TransformWorld::ChunkView::span(uint32_t component) const
+{
+    auto &array = m_chunk->data[componentIndex(component)];
+    return {array.data(), array.empty() ? 0 : m_chunk->count * STRIDES[componentIndex(component)]};
+}
+
+std::span<float> TransformWorld::ChunkView::positions()
+{
+    m_chunk->versions[componentIndex(Position)] = m_version;
+    return span(Position);
+}
+
+std::span<float> TransformWorld::ChunkView::rotations()
+{
+    m_chunk->versions[componentIndex(Rotation)] = m_version;
+    return span(Rotation);
+}
+
+std::span<float> TransformWorld::ChunkView::scales()
+{
+    m_chunk->versions[componentIndex(Scale)] = m_version;
+    return span(Scale);
+}
+
+std::span<float> TransformWorld::ChunkView::localMatrices()
+{
+    m_chunk->versions[componentIndex(LocalMatrix)] = m_version;
+    return span(LocalMatrix);
+}
+
+std::span<float> TransformWorld::ChunkView::localBounds()
+{
+    m_chunk->versions[componentIndex(Bounds)] = m_version;
+    return span(Bounds);
+}
+
+std::span<const float> TransformWorld::ChunkView::positions() const
+{
+    return span(Position);
+}
+
+std::span<const float> TransformWorld::ChunkView::rotations() const
+{
+    return span(Rotation);
+}
+
+std::span<const float> TransformWorld::ChunkView::scales() const
+{
+    return span(Scale);
+}
+
+std::span<const float> TransformWorld::ChunkView::localMatrices() const
+{
+    return span(LocalMatrix);
+}
+
+std::span<const float> TransformWorld::ChunkView::worldMatrices() const
+{
+    return span(WorldMatrix);
+}
+
+std::span<const float> TransformWorld::ChunkView::localBounds() const
+{
+    return span(Bounds);
+}
+
+std::span<const float> TransformWorld::ChunkView::worldBounds() const
+{
+    return {m_chunk->worldBounds.data(), span(Bounds).size()};
+}
+
+Box3 TransformWorld::ChunkView::bounds() const
+{
+    return toBox3(m_chunk->bounds);
+}
+
+// TransformWorld
+
+TransformWorld::TransformWorld() {}
+
+TransformWorld::~TransformWorld() {}
+
+TransformWorld::Entity TransformWorld::create(uint32_t components)
+{
+    return create(components, Entity{});
+}
+
+TransformWorld::Entity TransformWorld::create(uint32_t components, Entity parent)
+{
+    if (parent && !alive(parent))
+        throw std::invalid_argument("TransformWorld: parent is not alive");
+
+    uint32_t index;
+    if (!m_freeRecords.empty())
+    {
+        index = m_freeRecords.back();
+        m_freeRecords.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_records.size());
+        m_records.emplace_back();
+    }
+
+    const uint32_t depth = parent ? m_chunks[m_records[parent.index].chunk]->depth + 1 : 0;
+
+    if (parent)
+        link(index, parent.index);
+    insert(index, archetype((components & ALL_COMPONENTS) | REQUIRED_COMPONENTS, depth));
+    trackParentChunk(index);
+
+    m_size++;
+    return {index, m_records[index].generation};
+}
+
+void TransformWorld::destroy(Entity entity)
+{
+    record(entity);
+
+    while (m_records[entity.index].firstChild != NONE)
+    {
+        const uint32_t child = m_records[entity.index].firstChild;
+        setParent({child, m_records[child].generation}, Entity{});
+    }
+
+    unlink(entity.index);
+    remove(entity.index);
+
+    m_records[entity.index].generation++;
+    m_freeRecords.push_back(entity.index);
+    m_size--;
+}
+
+bool TransformWorld::alive(Entity entity) const
+{
+    return entity.index < m_records.size() && m_records[entity.index].generation == entity.generation &&
+           m_records[entity.index].chunk != NONE;
+}
+
+size_t TransformWorld::size() const
+{
+    return m_size;
+}
+
+uint32_t TransformWorld::components(Entity entity) const
+{
+    return m_chunks[record(entity).chunk]->components;
+}
+
+void TransformWorld::setComponents(Entity entity, uint32_t components)
+{
+    const Record &r = record(entity);
+    components = (components & ALL_COMPONENTS) | REQUIRED_COMPONENTS;
+
+    const Chunk &chunk = *m_chunks[r.chunk];
+    if (chunk.components != components)
+        move(entity.index, archetype(components, chunk.depth));
+}
+
+TransformWorld::Entity TransformWorld::parent(Entity entity) const
+{
+    const uint32_t parent = record(entity).parent;
+    return parent == NONE ? Entity{} : Entity{parent, m_records[parent].generation};
+}
+
+uint32_t TransformWorld::depth(Entity entity) const
+{
+    return m_chunks[record(entity).chunk]->depth;
+}
+
+void TransformWorld::setParent(Entity entity, Entity parent)
+{
+    record(entity);
+
+    if (parent)
+    {
+        record(parent);
+
+        for (uint32_t ancestor = parent.index; ancestor != NONE; ancestor = m_records[ancestor].parent)
+        {
+            if (ancestor == entity.index)
+                throw std::invalid_argument("TransformWorld: an entity cannot be attached to its descendant");
+        }
+    }
+
+    unlink(entity.index);
+    if (parent)
+        link(entity.index, parent.index);
+
+    const uint32_t depth = parent ? m_chunks[m_records[parent.index].chunk]->depth + 1 : 0;
+    moveSubtree(entity.index, depth);
+
+    // the world matrix changes even when the entity stayed in its chunk
+    trackParentChunk(entity.index);
+    touch(m_records[entity.index].chunk, LocalMatrix);
+}
+
+Vector3 TransformWorld::position(Entity entity) const
+{
+    const float *p = const_cast<TransformWorld *>(this)->component(entity, Position, 3);
+    return Vector3(p[0], p[1], p[2]);
+}
+
+Quaternion TransformWorld::rotation(Entity entity) const
+{
+    const float *q = const_cast<TransformWorld *>(this)->component(entity, Rotation, 4);
+    return Quaternion(q[0], q[1], q[2], q[3]);
+}
+
+Vector3 TransformWorld::scale(Entity entity) const
+{
+    const float *s = const_cast<TransformWorld *>(this)->component(entity, Scale, 3);
+    return Vector3(s[0], s[1], s[2]);
+}
+
+Matrix4 TransformWorld::localMatrix(Entity entity) const
+{
+    Matrix4 matrix;
+    matrix.fromArray(const_cast<TransformWorld *>(this)->component(entity, LocalMatrix, 16));
+    return matrix;
+}
+
+Matrix4 TransformWorld::worldMatrix(Entity entity) const
+{
+    Matrix4 matrix;
+    matrix.fromArray(const_cast<TransformWorld *>(this)->component(entity, WorldMatrix, 16));
+    return matrix;
+}
+
+Box3 TransformWorld::localBounds(Entity entity) const
+{
+    return toBox3(const_cast<TransformWorld *>(this)->component(entity, Bounds, 6));
+}
+
+Box3 TransformWorld::worldBounds(Entity entity) const
+{
+    const Record &r = record(entity);
+    const Chunk &chunk = *m_chunks[r.chunk];
+
+    if (!(chunk.components & Bounds))
+        throw std::invalid_argument("TransformWorld: entity has no such component");
+
+    return toBox3(chunk.worldBounds.data() + r.slot * 6);
+}
+
+void TransformWorld::setPosition(Entity entity, const Vector3 &position)
+{
+    float *p = component(entity, Position, 3);
+    p[0] = static_cast<float>(position.x());
+    p[1] = static_cast<float>(position.y());
+    p[2] = static_cast<float>(position.z());
+    touch(m_records[entity.index].chunk, Position);
+}
+
+void TransformWorld::setRotation(Entity entity, const Quaternion &rotation)
+{
+    float *q = component(entity, Rotation, 4);
+    q[0] = static_cast<float>(rotation.x());
+    q[1] = static_cast<float>(rotation.y());
+    q[2] = static_cast<float>(rotation.z());
+    q[3] = static_cast<float>(rotation.w());
+    touch(m_records[entity.index].chunk, Rotation);
+}
+
+void TransformWorld::setScale(Entity entity, const Vector3 &scale)
+{
+    float *s = component(entity, Scale, 3);
+    s[0] = static_cast<float>(scale.x());
+    s[1] = static_cast<float>(scale.y());
+    s[2] = static_cast<float>(scale.z());
+    touch(m_records[entity.index].chunk, Scale);
+}
+
+void TransformWorld::setLocalMatrix(Entity entity, const Matrix4 &matrix)
+{
+    matrix.toArray(component(entity, LocalMatrix, 16));
+    touch(m_records[entity.index].chunk, LocalMatrix);
+}
+
+void TransformWorld::setLocalBounds(Entity entity, const Box3 &box)
+{
+    float *b = component(entity, Bounds, 6);
+    b[0] = static_cast<float>(box.min().x());
+    b[1] = static_cast<float>(box.min().y());
+    b[2] = static_cast<float>(box.min().z());
+    b[3] = static_cast<float>(box.max().x());
+    b[4] = static_cast<float>(box.max().y());
+    b[5] = static_cast<float>(box.max().z());
+    touch(m_records[entity.index].chunk, Bounds);
+}
+
+void TransformWorld::update()
+{
+    compose();
+    propagate();
+    computeBounds();
+    m_version++;
+}
+
+void TransformWorld::compose()
+{
+    THREECPP_PROFILE_ZONE("TransformWorld::compose");
+    const auto start = std::chrono::steady_clock::now();
+    SystemStats stats;
+
+    m_dirty.clear();
+    for (uint32_t c = 0; c < m_chunks.size(); c++)
+    {
+        const Chunk &chunk = *m_chunks[c];
+        if (!(chunk.components & TRS) || chunk.count == 0)
+            continue;
+
+        uint32_t changed = 0;
+        for (uint32_t component : {Position, Rotation, Scale})
+        {
+            if (chunk.components & component)
+                changed = std::max(changed, chunk.versions[componentIndex(component)]);
+        }
+
+        if (changed > m_composed)
+        {
+            m_dirty.push_back(c);
+            stats.entities += chunk.count;
+        }
+        else
+        {
+            stats.skipped++;
+        }
+    }
+
+    Parallel::parallelFor(0, m_dirty.size(), CHUNK_GRAIN, [this](size_t begin, size_t end)
+                          {
+        for (size_t d = begin; d < end; d++)
+        {
+            Chunk &chunk = *m_chunks[m_dirty[d]];
+            const float *positions = chunk.array(Position);
+            const float *rotations = chunk.array(Rotation);
+            const float *scales = chunk.array(Scale);
+            float *local = chunk.array(LocalMatrix);
+
+            for (size_t i = 0; i < chunk.count; i++)
+            {
+                // same expansion as Matrix4::compose; missing components
+                // read as identity
+                float x = 0, y = 0, z = 0, w = 1;
+                if (rotations)
+                {
+                    x = rotations[i * 4 + 0];
+                    y = rotations[i * 4 + 1];
+                    z = rotations[i * 4 + 2];
+                    w = rotations[i * 4 + 3];
+                }
+
+                float sx = 1, sy = 1, sz = 1;
+                if (scales)
+                {
+                    sx = scales[i * 3 + 0];
+                    sy = scales[i * 3 + 1];
+                    sz = scales[i * 3 + 2];
+                }
+
+                const float x2 = x + x, y2 = y + y, z2 = z + z;
+                const float xx = x * x2, xy = x * y2, xz = x * z2;
+                const float yy = y * y2, yz = y * z2, zz = z * z2;
+                const float wx = w * x2, wy = w * y2, wz = w * z2;
+
+                float *te = local + i * 16;
+                te[0] = (1 - (yy + zz)) * sx;
+                te[1] = (xy + wz) * sx;
+                te[2] = (xz - wy) * sx;
+                te[3] = 0;
+                te[4] = (xy - wz) * sy;
+                te[5] = (1 - (xx + zz)) * sy;
+                te[6] = (yz + wx) * sy;
+                te[7] = 0;
+                te[8] = (xz + wy) * sz;
+                te[9] = (yz - wx) * sz;
+                te[10] = (1 - (xx + yy)) * sz;
+                te[11] = 0;
+                te[12] = positions ? positions[i * 3 + 0] : 0;
+                te[13] = positions ? positions[i * 3 + 1] : 0;
+                te[14] = positions ? positions[i * 3 + 2] : 0;
+                te[15] = 1;
+            }
+
+            chunk.versions[componentIndex(LocalMatrix)] = m_version;
+        } });
+
+    stats.chunks = m_dirty.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_stats.compose = stats;
+    THREECPP_PROFILE_COUNT(MatricesComposed, stats.entities);
+    m_composed = m_version;
+}
+
+void TransformWorld::propagate()
+{
+    THREECPP_PROFILE_ZONE("TransformWorld::propagate");
+    const auto start = std::chrono::steady_clock::now();
+    SystemStats stats;
+
+    const size_t local = componentIndex(LocalMatrix);
+    const size_t world = componentIndex(WorldMatrix);
+
+    // parents are one level up, so every level sees its parents' new matrices
+    for (const auto &level : m_levels)
+    {
+        m_dirty.clear();
+        for (uint32_t c : level)
+        {
+            const Chunk &chunk = *m_chunks[c];
+            if (chunk.count == 0)
+                continue;
+
+            bool changed = chunk.versions[local] > m_propagated;
+            for (size_t p = 0; !changed && p < chunk.parentChunks.size(); p++)
+                changed = m_chunks[chunk.parentChunks[p]]->versions[world] > m_propagated;
+
+            if (changed)
+            {
+                m_dirty.push_back(c);
+                stats.entities += chunk.count;
+            }
+            else
+            {
+                stats.skipped++;
+            }
+        }
+
+        stats.chunks += m_dirty.size();
+
+        Parallel::parallelFor(0, m_dirty.size(), CHUNK_GRAIN, [this, world](size_t begin, size_t end)
+                              {
+            float parents[CHUNK_CAPACITY * 16];
+
+            for (size_t d = begin; d < end; d++)
+            {
+                Chunk &chunk = *m_chunks[m_dirty[d]];
+                const float *localMatrices = chunk.array(LocalMatrix);
+                float *worldMatrices = chunk.array(WorldMatrix);
+
+                if (chunk.depth == 0)
+                {
+                    std::memcpy(worldMatrices, localMatrices, chunk.count * 16 * sizeof(float));
+                }
+                else
+                {
+                    for (size_t i = 0; i < chunk.count; i++)
+                    {
+                        const Record &parent = m_records[chunk.parents[i]];
+                        std::memcpy(parents + i * 16, m_chunks[parent.chunk]->data[world].data() + parent.slot * 16, 16 * sizeof(float));
+                    }
+
+                    Matrix4::multiplyMatricesArray(worldMatrices, parents, localMatrices, chunk.count);
+                }
+
+                chunk.versions[world] = m_version;
+            } });
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_stats.propagate = stats;
+    THREECPP_PROFILE_COUNT(NodesUpdated, stats.entities);
+    m_propagated = m_version;
+}
+
+void TransformWorld::computeBounds()
+{
+    THREECPP_PROFILE_ZONE("TransformWorld::computeBounds");
+    const auto start = std::chrono::steady_clock::now();
+    SystemStats stats;
+
+    const size_t world = componentIndex(WorldMatrix);
+    const size_t bounds = componentIndex(Bounds);
+
+    m_dirty.clear();
+    for (uint32_t c = 0; c < m_chunks.size(); c++)
+    {
+        const Chunk &chunk = *m_chunks[c];
+        if (!(chunk.components & Bounds) || chunk.count == 0)
+            continue;
+
+        if (chunk.versions[world] > m_bounded || chunk.versions[bounds] > m_bounded)
+        {
+            m_dirty.push_back(c);
+            stats.entities += chunk.count;
+        }
+        else
+        {
+            stats.skipped++;
+        }
+    }
+
+    Parallel::parallelFor(0, m_dirty.size(), CHUNK_GRAIN, [this, bounds](size_t begin, size_t end)
+                          {
+        for (size_t d = begin; d < end; d++)
+        {
+            Chunk &chunk = *m_chunks[m_dirty[d]];
+            const float *matrices = chunk.array(WorldMatrix);
+            const float *localBounds = chunk.array(Bounds);
+            float *worldBounds = chunk.worldBounds.data();
+
+            float total[6];
+            makeEmptyBox(total);
+
+            for (size_t i = 0; i < chunk.count; i++)
+            {
+                const float *box = localBounds + i * 6;
+                float *out = worldBounds + i * 6;
+
+                if (box[0] > box[3] || box[1] > box[4] || box[2] > box[5])
+                {
+                    makeEmptyBox(out);
+                    continue;
+                }
+
+                // transform the center, and the extents by the absolute
+                // linear part, which bounds all eight corners
+                const float *te = matrices + i * 16;
+                const float c[3] = {(box[0] + box[3]) * 0.5f, (box[1] + box[4]) * 0.5f, (box[2] + box[5]) * 0.5f};
+                const float e[3] = {(box[3] - box[0]) * 0.5f, (box[4] - box[1]) * 0.5f, (box[5] - box[2]) * 0.5f};
+
+                for (int r = 0; r < 3; r++)
+                {
+                    const float center = te[r] * c[0] + te[4 + r] * c[1] + te[8 + r] * c[2] + te[12 + r];
+                    const float extent = std::abs(te[r]) * e[0] + std::abs(te[4 + r]) * e[1] + std::abs(te[8 + r]) * e[2];
+                    out[r] = center - extent;
+                    out[3 + r] = center + extent;
+                    total[r] = std::min(total[r], out[r]);
+                    total[3 + r] = std::max(total[3 + r], out[3 + r]);
+                }
+            }
+
+            std::copy(total, total + 6, chunk.bounds);
+            chunk.versions[bounds] = m_version;
+        } });
+
+    stats.chunks = m_dirty.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_stats.bounds = stats;
+    m_bounded = m_version;
+}
+
+uint32_t TransformWorld::version() const
+{
+    return m_version;
+}
+
+const TransformWorld::Stats &TransformWorld::stats() const
+{
+    return m_stats;
+}
+
+size_t TransformWorld::chunkCount() const
+{
+    return m_chunks.size();
+}
+
+TransformWorld::ChunkView TransformWorld::chunk(size_t index)
+{
+    return ChunkView(m_chunks.at(index).get(), m_version);
+}
+
+const TransformWorld::Record &TransformWorld::record(Entity entity) const
+{
+    if (!alive(entity))
+        throw std::invalid_argument("TransformWorld: entity is not alive");
+    return m_records[entity.index];
+}
+
+uint32_t TransformWorld::archetype(uint32_t components, uint32_t depth)
+{
+    const auto key = std::make_pair(components, depth);
+    auto found = m_archetypesByKey.find(key);
+    if (found != m_archetypesByKey.end())
+        return found->second;
+
+    const uint32_t index = static_cast<uint32_t>(m_archetypes.size());
+    m_archetypes.push_back({components, depth, {}, {}});
+    m_archetypesByKey.emplace(key, index);
+    return index;
+}
+
+void TransformWorld::insert(uint32_t index, uint32_t archetypeIndex)
+{
+    Archetype &archetype = m_archetypes[archetypeIndex];
+
+    while (!archetype.open.empty() && m_chunks[archetype.open.back()]->count == CHUNK_CAPACITY)
+        archetype.open.pop_back();
+
+    if (archetype.open.empty())
+    {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->archetype = archetypeIndex;
+        chunk->components = archetype.components;
+        chunk->depth = archetype.depth;
+        chunk->entities.resize(CHUNK_CAPACITY);
+        chunk->parents.resize(CHUNK_CAPACITY, NONE);
+        for (size_t k = 0; k < COMPONENT_COUNT; k++)
+        {
+            if (archetype.components & (1u << k))
+                chunk->data[k].resize(CHUNK_CAPACITY * STRIDES[k]);
+        }
+        if (archetype.components & Bounds)
+            chunk->worldBounds.resize(CHUNK_CAPACITY * 6);
+        makeEmptyBox(chunk->bounds);
+
+        const uint32_t chunkIndex = static_cast<uint32_t>(m_chunks.size());
+        m_chunks.push_back(std::move(chunk));
+        archetype.chunks.push_back(chunkIndex);
+        archetype.open.push_back(chunkIndex);
+
+        if (m_levels.size() <= archetype.depth)
+            m_levels.resize(archetype.depth + 1);
+        m_levels[archetype.depth].push_back(chunkIndex);
+    }
+
+    const uint32_t chunkIndex = archetype.open.back();
+    Chunk &chunk = *m_chunks[chunkIndex];
+    const uint32_t slot = chunk.count++;
+
+    Record &r = m_records[index];
+    r.chunk = chunkIndex;
+    r.slot = slot;
+    chunk.entities[slot] = index;
+    chunk.parents[slot] = r.parent;
+
+    // identity transform, empty box
+    if (float *p = chunk.array(Position))
+        std::fill_n(p + slot * 3, 3, 0.0f);
+    if (float *q = chunk.array(Rotation))
+    {
+        std::fill_n(q + slot * 4, 3, 0.0f);
+        q[slot * 4 + 3] = 1;
+    }
+    if (float *s = chunk.array(Scale))
+        std::fill_n(s + slot * 3, 3, 1.0f);
+    std::copy(IDENTITY, IDENTITY + 16, chunk.array(LocalMatrix) + slot * 16);
+    std::copy(IDENTITY, IDENTITY + 16, chunk.array(WorldMatrix) + slot * 16);
+    if (float *b = chunk.array(Bounds))
+    {
+        makeEmptyBox(b + slot * 6);
+        makeEmptyBox(chunk.worldBounds.data() + slot * 6);
+    }
+
+    touch(chunkIndex, ALL_COMPONENTS);
+}
+
+void TransformWorld::remove(uint32_t index)
+{
+    Record &r = m_records[index];
+    const uint32_t chunkIndex = r.chunk;
+    Chunk &chunk = *m_chunks[chunkIndex];
+
+    // the last entity fills the hole
+    const uint32_t last = chunk.count - 1;
+    if (r.slot != last)
+    {
+        const uint32_t moved = chunk.entities[last];
+        chunk.entities[r.slot] = moved;
+        chunk.parents[r.slot] = chunk.parents[last];
+
+        for (size_t k = 0; k < COMPONENT_COUNT; k++)
+        {
+            auto &array = chunk.data[k];
+            if (!array.empty())
+                std::copy_n(array.data() + last * STRIDES[k], STRIDES[k], array.data() + r.slot * STRIDES[k]);
+        }
+        if (!chunk.worldBounds.empty())
+            std::copy_n(chunk.worldBounds.data() + last * 6, 6, chunk.worldBounds.data() + r.slot * 6);
+
+        m_records[moved].slot = r.slot;
+    }
+
+    if (chunk.count-- == CHUNK_CAPACITY)
+        m_archetypes[chunk.archetype].open.push_back(chunkIndex);
+
+    r.chunk = NONE;
+    touch(chunkIndex, ALL_COMPONENTS);
+}
+
+void TransformWorld::move(uint32_t index, uint32_t archetype)
+{
+    float saved[COMPONENT_COUNT][16];
+    float savedWorldBounds[6];
+
+    {
+        const Record &r = m_records[index];
+        Chunk &from = *m_chunks[r.chunk];
+        for (size_t k = 0; k < COMPONENT_COUNT; k++)
+        {
+            if (!from.data[k].empty())
+                std::copy_n(from.data[k].data() + r.slot * STRIDES[k], STRIDES[k], saved[k]);
+        }
+        if (!from.worldBounds.empty())
+            std::copy_n(from.worldBounds.data() + r.slot * 6, 6, savedWorldBounds);
+    }
+    const uint32_t previous = m_chunks[m_records[index].chunk]->components;
+
+    remove(index);
+    insert(index, archetype);
+
+    // components of both archetypes keep their values, new ones start at identity
+    const Record &r = m_records[index];
+    Chunk &to = *m_chunks[r.chunk];
+    for (size_t k = 0; k < COMPONENT_COUNT; k++)
+    {
+        if (!to.data[k].empty() && (previous & (1u << k)))
+            std::copy_n(saved[k], STRIDES[k], to.data[k].data() + r.slot * STRIDES[k]);
+    }
+    if (!to.worldBounds.empty() && (previous & Bounds))
+        std::copy_n(savedWorldBounds, 6, to.worldBounds.data() + r.slot * 6);
+
+    // the entity's children now find their parent in another chunk
+    trackParentChunk(index);
+    for (uint32_t child = r.firstChild; child != NONE; child = m_records[child].nextSibling)
+        trackParentChunk(child);
+}
+
+void TransformWorld::moveSubtree(uint32_t index, uint32_t depth)
+{
+    // iterative, hierarchies can be deep
+    std::vector<std::pair<uint32_t, uint32_t>> stack = {{index, depth}};
+
+    while (!stack.empty())
+    {
+        const auto [entity, entityDepth] = stack.back();
+        stack.pop_back();
+
+        const Chunk &chunk = *m_chunks[m_records[entity].chunk];
+        if (chunk.depth == entityDepth)
+            continue;
+
+        move(entity, archetype(chunk.components, entityDepth));
+
+        for (uint32_t child = m_records[entity].firstChild; child != NONE; child = m_records[child].nextSibling)
+            stack.emplace_back(child, entityDepth + 1);
+    }
+}
+
+void TransformWorld::link(uint32_t index, uint32_t parent)
+{
+    Record &r = m_records[index];
+    Record &p = m_records[parent];
+
+    r.parent = parent;
+    r.previousSibling = NONE;
+    r.nextSibling = p.firstChild;
+    if (p.firstChild != NONE)
+        m_records[p.firstChild].previousSibling = index;
+    p.firstChild = index;
+
+    if (r.chunk != NONE)
+        m_chunks[r.chunk]->parents[r.slot] = parent;
+}
+
+void TransformWorld::unlink(uint32_t index)
+{
+    Record &r = m_records[index];
+    if (r.parent == NONE)
+        return;
+
+    if (r.previousSibling != NONE)
+        m_records[r.previousSibling].nextSibling = r.nextSibling;
+    else
+        m_records[r.parent].firstChild = r.nextSibling;
+
+    if (r.nextSibling != NONE)
+        m_records[r.nextSibling].previousSibling = r.previousSibling;
+
+    r.parent = NONE;
+    r.nextSibling = NONE;
+    r.previousSibling = NONE;
+
+    if (r.chunk != NONE)
+        m_chunks[r.chunk]->parents[r.slot] = NONE;
+}
+
+void TransformWorld::trackParentChunk(uint32_t index)
+{
+    const Record &r = m_records[index];
+    if (r.parent == NONE)
+        return;
+
+    const uint32_t parentChunk = m_records[r.parent].chunk;
+    auto &parentChunks = m_chunks[r.chunk]->parentChunks;
+    if (std::find(parentChunks.begin(), parentChunks.end(), parentChunk) == parentChunks.end())
+        parentChunks.push_back(parentChunk);
+}
+
+void TransformWorld::touch(uint32_t chunk, uint32_t components)
+{
+    Chunk &c = *m_chunks[chunk];
+    for (size_t k = 0; k < COMPONENT_COUNT; k++)
+    {
+        if (components & (1u << k))
+            c.versions[k] = m_version;
+    }
+}
+
+float *TransformWorld::component(Entity entity, Component component, size_t stride)
+{
+    const Record &r = record(entity);
+    float *array = m_chunks[r.chunk]->array(component);
+
+    if (array == nullptr)
+        throw std::invalid_argument("TransformWorld: entity has no such component");
+
+    return array + r.slot * stride;
+}
@@ -0,0 +1,807 @@
+#include "extras/Earcut.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    struct Node
+    {
+        // vertex index in the input
+        uint32_t i;
+        // vertex coordinates
+        double x;
+        double y;
+        // previous and next vertex nodes in a polygon ring
+        Node *prev = nullptr;
+        Node *next = nullptr;
+        // z-order curve value
+        int32_t z = 0;
+        // previous and next nodes in z-order
+        Node *prevZ = nullptr;
+        Node *nextZ = nullptr;
+        // indicates whether this is a steiner point
+        bool steiner = false;
+    };
+
+    // nodes are allocated in blocks and freed all at once, pointers stay valid
+    class NodePool
+    {
+    public:
+        explicit NodePool(size_t blockSize)
+            : m_blockSize(std::max<size_t>(blockSize, 64))
+        {
+        }
+
+        Node *create(uint32_t i, double x, double y)
+        {
+            if (m_used == m_capacity)
+            {
+                m_blocks.push_back(std::make_unique<Node[]>(m_blockSize));
+                m_used = 0;
+                m_capacity = m_blockSize;
+            }
+
+            Node *node = &m_blocks.back()[m_used++];
+            node->i = i;
+            node->x = x;
+            node->y = y;
+            return node;
+        }
+
+    private:
+        std::vector<std::unique_ptr<Node[]>> m_blocks;
+        size_t m_blockSize;
+        size_t m_used = 0;
+        size_t m_capacity = 0;
+    };
+
+    // signed area of a triangle
+    double area(const Node *p, const Node *q, const Node *r)
+    {
+        return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+    }
+
+    // check if two points are equal
+    bool equals(const Node *p1, const Node *p2)
+    {
+        return p1->x == p2->x && p1->y == p2->y;
+    }
+
+    int sign(double num)
+    {
+        return (num > 0) - (num < 0);
+    }
+
+    // for collinear points p, q, r, check if point q lies on segment pr
+    bool onSegment(const Node *p, const Node *q, const Node *r)
+    {
+        return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) && q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
+    }
+
+    // check if two segments intersect
+    bool intersects(const Node *p1, const Node *q1, const Node *p2, const Node *q2)
+    {
+        const int o1 = sign(area(p1, q1, p2));
+        const int o2 = sign(area(p1, q1, q2));
+        const int o3 = sign(area(p2, q2, p1));
+        const int o4 = sign(area(p2, q2, q1));
+
+        if (o1 != o2 && o3 != o4)
+            return true; // general case
+
+        if (o1 == 0 && onSegment(p1, p2, q1))
+            return true; // p1, q1 and p2 are collinear and p2 lies on p1q1
+        if (o2 == 0 && onSegment(p1, q2, q1))
+            return true; // p1, q1 and q2 are collinear and q2 lies on p1q1
+        if (o3 == 0 && onSegment(p2, p1, q2))
+            return true; // p2, q2 and p1 are collinear and p1 lies on p2q2
+        if (o4 == 0 && onSegment(p2, q1, q2))
+            return true; // p2, q2 and q1 are collinear and q1 lies on p2q2
+
+        return false;
+    }
+
+    // check if a polygon diagonal intersects any polygon segments
+    bool intersectsPolygon(const Node *a, const Node *b)
+    {
+        const Node *p = a;
+        do
+        {
+            if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && intersects(p, p->next, a, b))
+                return true;
+            p = p->next;
+        } while (p != a);
+
+        return false;
+    }
+
+    // check if a polygon diagonal is locally inside the polygon
+    bool locallyInside(const Node *a, const Node *b)
+    {
+        return area(a->prev, a, a->next) < 0 ? area(a, b, a->next) >= 0 && area(a, a->prev, b) >= 0 : area(a, b, a->prev) < 0 || area(a, a->next, b) < 0;
+    }
+
+    // check if the middle point of a polygon diagonal is inside the polygon
+    bool middleInside(const Node *a, const Node *b)
+    {
+        const Node *p = a;
+        bool inside = false;
+        const double px = (a->x + b->x) / 2;
+        const double py = (a->y + b->y) / 2;
+
+        do
+        {
+            if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y && (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+                inside = !inside;
+            p = p->next;
+        } while (p != a);
+
+        return inside;
+    }
+
+    // check if a point lies within a convex triangle
+    bool pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+    {
+        return (cx - px) * (ay - py) >= (ax - px) * (cy - py) && (ax - px) * (by - py) >= (bx - px) * (ay - py) && (bx - px) * (cy - py) >= (cx - px) * (by - py);
+    }
+
+    // check if a diagonal between two polygon nodes is valid (lies in polygon interior)
+    bool isValidDiagonal(const Node *a, const Node *b)
+    {
+        return a->next->i != b->i && a->prev->i != b->i && !intersectsPolygon(a, b) &&                                // doesn't intersect other edges
+               ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) &&                                 // locally visible
+                 (area(a->prev, a, b->prev) != 0 || area(a, b->prev, b) != 0)) ||                                    // does not create opposite-facing sectors
+                (equals(a, b) && area(a->prev, a, a->next) > 0 && area(b->prev, b, b->next) > 0)); // special zero-length case
+    }
+
+    // whether sector in vertex m contains sector in vertex p in the same coordinates
+    bool sectorContainsPoint(const Node *m, const Node *p)
+    {
+        return area(m->prev, m, p->prev) < 0 && area(p->next, m, m->next) < 0;
+    }
+
+    // z-order of a point given coords and inverse of the longer side of data bbox
+    int32_t zOrder(double px, double py, double minX, double minY, double invSize)
+    {
+        // coords are transformed into non-negative 15-bit integer range
+        auto x = static_cast<uint32_t>(static_cast<int32_t>((px - minX) * invSize));
+        auto y = static_cast<uint32_t>(static_cast<int32_t>((py - minY) * invSize));
+
+        x = (x | (x << 8)) & 0x00FF00FF;
+        x = (x | (x << 4)) & 0x0F0F0F0F;
+        x = (x | (x << 2)) & 0x33333333;
+        x = (x | (x << 1)) & 0x55555555;
+
+        y = (y | (y << 8)) & 0x00FF00FF;
+        y = (y | (y << 4)) & 0x0F0F0F0F;
+        y = (y | (y << 2)) & 0x33333333;
+        y = (y | (y << 1)) & 0x55555555;
+
+        return static_cast<int32_t>(x | (y << 1));
+    }
+
+    // find the leftmost node of a polygon ring
+    Node *getLeftmost(Node *start)
+    {
+        Node *p = start;
+        Node *leftmost = start;
+        do
+        {
+            if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+                leftmost = p;
+            p = p->next;
+        } while (p != start);
+
+        return leftmost;
+    }
+
+    void removeNode(Node *p)
+    {
+        p->next->prev = p->prev;
+        p->prev->next = p->next;
+
+        if (p->prevZ)
+            p->prevZ->nextZ = p->nextZ;
+        if (p->nextZ)
+            p->nextZ->prevZ = p->prevZ;
+    }
+
+    // Simon Tatham's linked list merge sort algorithm
+    // http://www.chiark.greenend.org.uk/~sgtatham/algorithms/listsort.html
+    Node *sortLinked(Node *list)
+    {
+        size_t inSize = 1;
+        size_t numMerges;
+
+        do
+        {
+            Node *p = list;
+            Node *tail = nullptr;
+            list = nullptr;
+            numMerges = 0;
+
+            while (p)
+            {
+                numMerges++;
+                Node *q = p;
+                size_t pSize = 0;
+                for (size_t i = 0; i < inSize; i++)
+                {
+                    pSize++;
+                    q = q->nextZ;
+                    if (!q)
+                        break;
+                }
+                size_t qSize = inSize;
+
+                while (pSize > 0 || (qSize > 0 && q))
+                {
+                    Node *e;
+                    if (pSize != 0 && (qSize == 0 || !q || p->z <= q->z))
+                    {
+                        e = p;
+                        p = p->nextZ;
+                        pSize--;
+                    }
+                    else
+                    {
+                        e = q;
+                        q = q->nextZ;
+                        qSize--;
+                    }
+
+                    if (tail)
+                        tail->nextZ = e;
+                    else
+                        list = e;
+
+                    e->prevZ = tail;
+                    tail = e;
+                }
+
+                p = q;
+            }
+
+            tail->nextZ = nullptr;
+            inSize *= 2;
+        } while (numMerges > 1);
+
+        return list;
+    }
+
+    double signedArea(std::span<const double> data, size_t start, size_t end)
+    {
+        double sum = 0;
+        for (size_t i = start, j = end - 2; i < end; i += 2)
+        {
+            sum += (data[j] - data[i]) * (data[i + 1] + data[j + 1]);
+            j = i;
+        }
+        return sum;
+    }
+
+    class Triangulator
+    {
+    public:
+        Triangulator(std::span<const double> data, std::vector<uint32_t> &triangles)
+            : m_data(data), m_triangles(triangles), m_nodes(data.size() / 2 + 16)
+        {
+        }
+
+        void run(std::span<const uint32_t> holeIndices)
+        {
+            const size_t outerLen = holeIndices.empty() ? m_data.size() : std::min<size_t>(holeIndices[0] * 2, m_data.size());
+            Node *outerNode = linkedList(0, outerLen, true);
+
+            if (!outerNode || outerNode->next == outerNode->prev)
+                return;
+
+            if (!holeIndices.empty())
+                outerNode = eliminateHoles(holeIndices, outerNode);
+
+            // if the shape is not too simple, we'll use z-order curve hash later; calculate polygon bbox
+            if (m_data.size() > 80 * 2)
+            {
+                double minX = m_data[0], maxX = m_data[0];
+                double minY = m_data[1], maxY = m_data[1];
+
+                for (size_t i = 2; i < outerLen; i += 2)
+                {
+                    minX = std::min(minX, m_data[i]);
+                    minY = std::min(minY, m_data[i + 1]);
+                    maxX = std::max(maxX, m_data[i]);
+                    maxY = std::max(maxY, m_data[i + 1]);
+                }
+
+                // minX, minY and invSize are later used to transform coords into integers for z-order calculation
+                const double size = std::max(maxX - minX, maxY - minY);
+                m_minX = minX;
+                m_minY = minY;
+                m_invSize = size != 0 ? 32767 / size : 0;
+            }
+
+            earcutLinked(outerNode, 0);
+        }
+
+    private:
+        // create a circular doubly linked list from polygon points in the specified winding order
+        Node *linkedList(size_t start, size_t end, bool clockwise)
+        {
+            Node *last = nullptr;
+
+            if (end <= start)
+                return nullptr;
+
+            if (clockwise == (signedArea(m_data, start, end) > 0))
+            {
+                for (size_t i = start; i < end; i += 2)
+                    last = insertNode(static_cast<uint32_t>(i / 2), m_data[i], m_data[i + 1], last);
+            }
+            else
+            {
+                for (size_t i = end; i > start; i -= 2)
+                    last = insertNode(static_cast<uint32_t>((i - 2) / 2), m_data[i - 2], m_data[i - 1], last);
+            }
+
+            if (last && equals(last, last->next))
+            {
+                removeNode(last);
+                last = last->next;
+            }
+
+            return last;
+        }
+
+        // eliminate colinear or duplicate points
+        Node *filterPoints(Node *start, Node *end = nullptr)
+        {
+            if (!start)
+                return start;
+            if (!end)
+                end = start;
+
+            Node *p = start;
+            bool again;
+            do
+            {
+                again = false;
+
+                if (!p->steiner && (equals(p, p->next) || area(p->prev, p, p->next) == 0))
+                {
+                    removeNode(p);
+                    p = end = p->prev;
+                    if (p == p->next)
+                        break;
+                    again = true;
+                }
+                else
+                {
+                    p = p->next;
+                }
+            } while (again || p != end);
+
+            return end;
+        }
+
+        // main ear slicing loop which triangulates a polygon (given as a linked list)
+        void earcutLinked(Node *ear, int pass)
+        {
+            if (!ear)
+                return;
+
+            // interlink polygon nodes in z-order
+            if (!pass && m_invSize != 0)
+                indexCurve(ear);
+
+            Node *stop = ear;
+
+            // iterate through ears, slicing them one by one
+            while (ear->prev != ear->next)
+            {
+                Node *prev = ear->prev;
+                Node *next = ear->next;
+
+                if (m_invSize != 0 ? isEarHashed(ear) : isEar(ear))
+                {
+                    // cut off the triangle
+                    m_triangles.push_back(prev->i);
+                    m_triangles.push_back(ear->i);
+                    m_triangles.push_back(next->i);
+
+                    removeNode(ear);
+
+                    // skipping the next vertex leads to less sliver triangles
+                    ear = next->next;
+                    stop = next->next;
+
+                    continue;
+                }
+
+                ear = next;
+
+                // if we looped through the whole remaining polygon and can't find any more ears
+                if (ear == stop)
+                {
+                    if (!pass)
+                    {
+                        // try filtering points and slicing again
+                        earcutLinked(filterPoints(ear), 1);
+                    }
+                    else if (pass == 1)
+                    {
+                        // if this didn't work, try curing all small self-intersections locally
+                        ear = cureLocalIntersections(filterPoints(ear));
+                        earcutLinked(ear, 2);
+                    }
+                    else if (pass == 2)
+                    {
+                        // as a last resort, try splitting the remaining polygon into two
+                        splitEarcut(ear);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        // check whether a polygon node forms a valid ear with adjacent nodes
+        bool isEar(const Node *ear) const
+        {
+            const Node *a = ear->prev;
+            const Node *b = ear;
+            const Node *c = ear->next;
+
+            if (area(a, b, c) >= 0)
+                return false; // reflex, can't be an ear
+
+            // now make sure we don't have other points inside the potential ear
+            const double ax = a->x, bx = b->x, cx = c->x, ay = a->y, by = b->y, cy = c->y;
+
+            // triangle bbox
+            const double x0 = std::min({ax, bx, cx}), y0 = std::min({ay, by, cy});
+            const double x1 = std::max({ax, bx, cx}), y1 = std::max({ay, by, cy});
+
+            const Node *p = c->next;
+            while (p != a)
+            {
+                if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+                    pointInTriangle(ax, ay, bx, by, cx, cy, p->x, p->y) &&
+                    area(p->prev, p, p->next) >= 0)
+                    return false;
+                p = p->next;
+            }
+
+            return true;
+        }
+
+        bool isEarHashed(const Node *ear) const
+        {
+            const Node *a = ear->prev;
+            const Node *b = ear;
+            const Node *c = ear->next;
+
+            if (area(a, b, c) >= 0)
+                return false; // reflex, can't be an ear
+
+            const double ax = a->x, bx = b->x, cx = c->x, ay = a->y, by = b->y, cy = c->y;
+
+            // triangle bbox
+            const double x0 = std::min({ax, bx, cx}), y0 = std::min({ay, by, cy});
+            const double x1 = std::max({ax, bx, cx}), y1 = std::max({ay, by, cy});
+
+            // z-order range for the current triangle bbox;
+            const int32_t minZ = zOrder(x0, y0, m_minX, m_minY, m_invSize);
+            const int32_t maxZ = zOrder(x1, y1, m_minX, m_minY, m_invSize);
+
+            auto blocks = [&](const Node *p)
+            {
+                return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+                       pointInTriangle(ax, ay, bx, by, cx, cy, p->x, p->y) && area(p->prev, p, p->next) >= 0;
+            };
+
+            const Node *p = ear->prevZ;
+            const Node *n = ear->nextZ;
+
+            // look for points inside the triangle in both directions
+            while (p && p->z >= minZ && n && n->z <= maxZ)
+            {
+                if (blocks(p))
+                    return false;
+                p = p->prevZ;
+
+                if (blocks(n))
+                    return false;
+                n = n->nextZ;
+            }
+
+            // look for remaining points in decreasing z-order
+            while (p && p->z >= minZ)
+            {
+                if (blocks(p))
+                    return false;
+                p = p->prevZ;
+            }
+
+            // look for remaining points in increasing z-order
+            while (n && n->z <= maxZ)
+            {
+                if (blocks(n))
+                    return false;
+                n = n->nextZ;
+            }
+
+            return true;
+        }
+
+        // go through all polygon nodes and cure small local self-intersections
+        Node *cureLocalIntersections(Node *start)
+        {
+            Node *p = start;
+            do
+            {
+                Node *a = p->prev;
+                Node *b = p->next->next;
+
+                if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) && locallyInside(b, a))
+                {
+                    m_triangles.push_back(a->i);
+                    m_triangles.push_back(p->i);
+                    m_triangles.push_back(b->i);
+
+                    // remove two nodes involved
+                    removeNode(p);
+                    removeNode(p->next);
+
+                    p = start = b;
+                }
+
+                p = p->next;
+            } while (p != start);
+
+            return filterPoints(p);
+        }
+
+        // try splitting polygon into two and triangulate them independently
+        void splitEarcut(Node *start)
+        {
+            // look for a valid diagonal that divides the polygon into two
+            Node *a = start;
+            do
+            {
+                Node *b = a->next->next;
+                while (b != a->prev)
+                {
+                    if (a->i != b->i && isValidDiagonal(a, b))
+                    {
+                        // split the polygon in two by the diagonal
+                        Node *c = splitPolygon(a, b);
+
+                        // filter colinear points around the cuts
+                        a = filterPoints(a, a->next);
+                        c = filterPoints(c, c->next);
+
+                        // run earcut on each half
+                        earcutLinked(a, 0);
+                        earcutLinked(c, 0);
+                        return;
+                    }
+
+                    b = b->next;
+                }
+
+                a = a->next;
+            } while (a != start);
+        }
+
+        // link every hole into the outer loop, producing a single-ring polygon without holes
+        Node *eliminateHoles(std::span<const uint32_t> holeIndices, Node *outerNode)
+        {
+            std::vector<Node *> queue;
+            queue.reserve(holeIndices.size());
+
+            for (size_t i = 0; i < holeIndices.size(); i++)
+            {
+                const size_t start = std::min<size_t>(holeIndices[i] * 2, m_data.size());
+                const size_t end = i < holeIndices.size() - 1 ? std::min<size_t>(holeIndices[i + 1] * 2, m_data.size()) : m_data.size();
+
+                Node *list = linkedList(start, end, false);
+                if (!list)
+                    continue;
+                if (list == list->next)
+                    list->steiner = true;
+
+                queue.push_back(getLeftmost(list));
+            }
+
+            std::sort(queue.begin(), queue.end(), [](const Node *a, const Node *b)
+                      { return a->x < b->x; });
+
+            // process holes from left to right
+            for (Node *hole : queue)
+                outerNode = eliminateHole(hole, outerNode);
+
+            return outerNode;
+        }
+
+        // find a bridge between vertices that connects hole with an outer ring and link it
+        Node *eliminateHole(Node *hole, Node *outerNode)
+        {
+            Node *bridge = findHoleBridge(hole, outerNode);
+            if (!bridge)
+                return outerNode;
+
+            Node *bridgeReverse = splitPolygon(bridge, hole);
+
+            // filter collinear points around the cuts
+            filterPoints(bridgeReverse, bridgeReverse->next);
+            return filterPoints(bridge, bridge->next);
+        }
+
+        // David Eberly's algorithm for finding a bridge between hole and outer polygon
+        Node *findHoleBridge(const Node *hole, Node *outerNode) const
+        {
+            Node *p = outerNode;
+            const double hx = hole->x;
+            const double hy = hole->y;
+            double qx = -std::numeric_limits<double>::infinity();
+            Node *m = nullptr;
+
+            // find a segment intersected by a ray from the hole's leftmost point to the left;
+            // segment's endpoint with lesser x will be potential connection point
+            do
+            {
+                if (hy <= p->y && hy >= p->next->y && p->next->y != p->y)
+                {
+                    const double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+                    if (x <= hx && x > qx)
+                    {
+                        qx = x;
+                        m = p->x < p->next->x ? p : p->next;
+                        if (x == hx)
+                            return m; // hole touches outer segment; pick leftmost endpoint
+                    }
+                }
+                p = p->next;
+            } while (p != outerNode);
+
+            if (!m)
+                return nullptr;
+
+            // look for points inside the triangle of hole point, segment intersection and endpoint;
+            // if there are no points found, we have a valid connection;
+            // otherwise choose the point of the minimum angle with the ray as connection point
+
+            const Node *stop = m;
+            const double mx = m->x;
+            const double my = m->y;
+            double tanMin = std::numeric_limits<double>::infinity();
+
+            p = m;
+
+            do
+            {
+                if (hx >= p->x && p->x >= mx && hx != p->x &&
+                    pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+                {
+                    const double tan = std::abs(hy - p->y) / (hx - p->x); // tangential
+
+                    if (locallyInside(p, hole) && (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && sectorContainsPoint(m, p))))))
+                    {
+                        m = p;
+                        tanMin = tan;
+                    }
+                }
+
+                p = p->next;
+            } while (p != stop);
+
+            return m;
+        }
+
+        // interlink polygon nodes in z-order
+        void indexCurve(Node *start)
+        {
+            Node *p = start;
+            do
+            {
+                if (p->z == 0)
+                    p->z = zOrder(p->x, p->y, m_minX, m_minY, m_invSize);
+                p->prevZ = p->prev;
+                p->nextZ = p->next;
+                p = p->next;
+            } while (p != start);
+
+            p->prevZ->nextZ = nullptr;
+            p->prevZ = nullptr;
+
+            sortLinked(p);
+        }
+
+        // link two polygon vertices with a bridge; if the vertices belong to the same ring, it splits polygon into two;
+        // if one belongs to the outer ring and another to a hole, it merges it into a single ring
+        Node *splitPolygon(Node *a, Node *b)
+        {
+            Node *a2 = m_nodes.create(a->i, a->x, a->y);
+            Node *b2 = m_nodes.create(b->i, b->x, b->y);
+            Node *an = a->next;
+            Node *bp = b->prev;
+
+            a->next = b;
+            b->prev = a;
+
+            a2->next = an;
+            an->prev = a2;
+
+            b2->next = a2;
+            a2->prev = b2;
+
+            bp->next = b2;
+            b2->prev = bp;
+
+            return b2;
+        }
+
+        // create a node and optionally link it with previous one (in a circular doubly linked list)
+        Node *insertNode(uint32_t i, double x, double y, Node *last)
+        {
+            Node *p = m_nodes.create(i, x, y);
+
+            if (!last)
+            {
+                p->prev = p;
+                p->next = p;
+            }
+            else
+            {
+                p->next = last->next;
+                p->prev = last;
+                last->next->prev = p;
+                last->next = p;
+            }
+
+            return p;
+        }
+
+        std::span<const double> m_data;
+        std::vector<uint32_t> &m_triangles;
+        NodePool m_nodes;
+
+        double m_minX = 0;
+        double m_minY = 0;
+        // 0 disables the z-order hash
+        double m_invSize = 0;
+    };
+}
+
+namespace Earcut
+{
+    void triangulate(std::span<const double> data, std::span<const uint32_t> holeIndices, std::vector<uint32_t> &triangles)
+    {
+        triangles.clear();
+
+        // an odd trailing value is ignored
+        data = data.first(data.size() & ~size_t(1));
+        if (data.size() < 6)
+            return;
+
+        // a polygon of n vertices and h holes has n + 2h - 2 triangles
+        triangles.reserve((data.size() / 2 + 2 * holeIndices.size()) * 3);
+
+        Triangulator triangulator(data, triangles);
+        triangulator.run(holeIndices);
+    }
+
+    void triangulateBatch(std::span<const Polygon> polygons, std::vector<std::vector<uint32_t>> &triangles)
+    {
+        triangles.resize(polygons.size());
+
+        // footprints are small, so many of them go to one task
+        Parallel::parallelFor(0, polygons.size(), 64, [&](size_t begin, size_t end)
+                              {
+            for (size_t i = begin; i < end; i++)
+                triangulate(polygons[i].data, polygons[i].holeIndices, triangles[i]); });
+    }
+}
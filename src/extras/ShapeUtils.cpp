@@ -0,0 +1,65 @@
+#include "extras/ShapeUtils.h"
+#include "extras/Earcut.h"
+
+namespace ShapeUtils
+{
+    HIGH_PRECISION area(const std::vector<Vector2> &contour)
+    {
+        const size_t n = contour.size();
+        HIGH_PRECISION a = 0;
+
+        for (size_t p = n - 1, q = 0; q < n; p = q++)
+            a += contour[p].cross(contour[q]);
+
+        return a * 0.5;
+    }
+
+    bool isClockWise(const std::vector<Vector2> &pts)
+    {
+        return area(pts) < 0;
+    }
+
+    void removeDupEndPts(std::vector<Vector2> &points)
+    {
+        if (points.size() > 2 && points.back().equals(points.front()))
+            points.pop_back();
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangulateShape(const std::vector<Vector2> &contour, const std::vector<std::vector<Vector2>> &holes)
+    {
+        // flat array of vertices like [ x0,y0, x1,y1, x2,y2, ... ]
+        std::vector<double> vertices;
+        // array of hole indices
+        std::vector<uint32_t> holeIndices;
+
+        auto addContour = [&vertices](const std::vector<Vector2> &points)
+        {
+            size_t count = points.size();
+            if (count > 2 && points.back().equals(points.front()))
+                count--;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                vertices.push_back(static_cast<double>(points[i].x()));
+                vertices.push_back(static_cast<double>(points[i].y()));
+            }
+        };
+
+        addContour(contour);
+
+        for (const auto &hole : holes)
+        {
+            holeIndices.push_back(static_cast<uint32_t>(vertices.size() / 2));
+            addContour(hole);
+        }
+
+        std::vector<uint32_t> triangles;
+        Earcut::triangulate(vertices, holeIndices, triangles);
+
+        std::vector<std::array<uint32_t, 3>> faces(triangles.size() / 3);
+        for (size_t i = 0; i < faces.size(); i++)
+            faces[i] = {triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2]};
+
+        return faces;
+    }
+}
@@ -0,0 +1,550 @@
+#include "extras/core/Curve.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// parameters per task; evaluating a cubic is a few dozen instructions
+static constexpr size_t POINT_GRAIN = 8192;
+
+namespace
+{
+    // t at a target length inside piece `index` of the arc-length table
+    HIGH_PRECISION parameterAt(const std::vector<HIGH_PRECISION> &lengths, size_t index, HIGH_PRECISION target)
+    {
+        const auto divisions = static_cast<HIGH_PRECISION>(lengths.size() - 1);
+        const HIGH_PRECISION before = lengths[index];
+        const HIGH_PRECISION segment = lengths[index + 1] - before;
+
+        if (segment <= 0)
+            return index / divisions;
+
+        const HIGH_PRECISION fraction = std::clamp<HIGH_PRECISION>((target - before) / segment, 0, 1);
+        return (index + fraction) / divisions;
+    }
+
+    void cross(const float *a, const float *b, float *out)
+    {
+        const float x = a[1] * b[2] - a[2] * b[1];
+        const float y = a[2] * b[0] - a[0] * b[2];
+        const float z = a[0] * b[1] - a[1] * b[0];
+        out[0] = x;
+        out[1] = y;
+        out[2] = z;
+    }
+
+    float dot(const float *a, const float *b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    void normalize(float *v)
+    {
+        const float length = std::sqrt(dot(v, v));
+        if (length > 0)
+        {
+            v[0] /= length;
+            v[1] /= length;
+            v[2] /= length;
+        }
+    }
+
+#if defined(__SSE2__)
+    // stores four xyz points given as x, y and z vectors to 12 packed floats
+    void storePoints(float *out, __m128 x, __m128 y, __m128 z)
+    {
+        const __m128 xy01 = _mm_unpacklo_ps(x, y);                            // x0 y0 x1 y1
+        const __m128 xy23 = _mm_unpackhi_ps(x, y);                            // x2 y2 x3 y3
+        const __m128 z0x1 = _mm_shuffle_ps(z, xy01, _MM_SHUFFLE(2, 2, 0, 0)); // z0 z0 x1 x1
+        const __m128 y1z1 = _mm_shuffle_ps(xy01, z, _MM_SHUFFLE(1, 1, 3, 3)); // y1 y1 z1 z1
+        const __m128 z2x3 = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(2, 2, 2, 2)); // z2 z2 x3 x3
+        const __m128 xyz3 = _mm_shuffle_ps(xy23, z, _MM_SHUFFLE(3, 3, 3, 2)); // x3 y3 z3 z3
+
+        _mm_storeu_ps(out + 0, _mm_shuffle_ps(xy01, z0x1, _MM_SHUFFLE(2, 0, 1, 0))); // x0 y0 z0 x1
+        _mm_storeu_ps(out + 4, _mm_shuffle_ps(y1z1, xy23, _MM_SHUFFLE(1, 0, 2, 0))); // y1 z1 x2 y2
+        _mm_storeu_ps(out + 8, _mm_shuffle_ps(z2x3, xyz3, _MM_SHUFFLE(2, 1, 2, 0))); // z2 x3 y3 z3
+    }
+#endif
+}
+
+Curve::Cursor::Cursor(const Curve &curve)
+    : m_curve(&curve), m_lengths(&curve.getLengths())
+{
+}
+
+HIGH_PRECISION Curve::Cursor::map(HIGH_PRECISION u)
+{
+    const std::vector<HIGH_PRECISION> &lengths = *m_lengths;
+    const size_t divisions = lengths.size() - 1;
+    const HIGH_PRECISION target = std::clamp<HIGH_PRECISION>(u, 0, 1) * lengths[divisions];
+
+    while (m_index + 1 < divisions && lengths[m_index + 1] <= target)
+        m_index++;
+    while (m_index > 0 && lengths[m_index] > target)
+        m_index--;
+
+    return parameterAt(lengths, m_index, target);
+}
+
+Vector3 Curve::Cursor::getPointAt(HIGH_PRECISION u)
+{
+    return m_curve->getPoint(map(u));
+}
+
+void Curve::Cursor::reset()
+{
+    m_index = 0;
+}
+
+Curve::Curve() = default;
+
+Curve::~Curve() = default;
+
+std::string Curve::type() const
+{
+    return "Curve";
+}
+
+Vector3 Curve::getPointAt(HIGH_PRECISION u) const
+{
+    return getPoint(getUtoTmapping(u));
+}
+
+std::vector<Vector3> Curve::getPoints(size_t divisions) const
+{
+    std::vector<Vector3> points;
+    points.reserve(divisions + 1);
+
+    for (size_t d = 0; d <= divisions; d++)
+        points.push_back(getPoint(static_cast<HIGH_PRECISION>(d) / divisions));
+
+    return points;
+}
+
+std::vector<Vector3> Curve::getSpacedPoints(size_t divisions) const
+{
+    std::vector<Vector3> points;
+    points.reserve(divisions + 1);
+
+    Cursor cursor(*this);
+    for (size_t d = 0; d <= divisions; d++)
+        points.push_back(cursor.getPointAt(static_cast<HIGH_PRECISION>(d) / divisions));
+
+    return points;
+}
+
+HIGH_PRECISION Curve::getLength() const
+{
+    return getLengths().back();
+}
+
+const std::vector<HIGH_PRECISION> &Curve::getLengths() const
+{
+    if (!m_lengths.empty())
+        return m_lengths;
+
+    const size_t divisions = m_arcLengthDivisions;
+    m_lengths.resize(divisions + 1);
+    m_lengths[0] = 0;
+
+    Vector3 last = getPoint(0);
+    HIGH_PRECISION sum = 0;
+
+    for (size_t p = 1; p <= divisions; p++)
+    {
+        const Vector3 current = getPoint(static_cast<HIGH_PRECISION>(p) / divisions);
+        sum += current.distanceTo(last);
+        m_lengths[p] = sum;
+        last = current;
+    }
+
+    return m_lengths;
+}
+
+void Curve::updateArcLengths()
+{
+    m_lengths.clear();
+    m_cubics.clear();
+    m_cubicsBuilt = false;
+}
+
+HIGH_PRECISION Curve::getUtoTmapping(HIGH_PRECISION u) const
+{
+    const std::vector<HIGH_PRECISION> &lengths = getLengths();
+    const size_t divisions = lengths.size() - 1;
+    const HIGH_PRECISION target = std::clamp<HIGH_PRECISION>(u, 0, 1) * lengths[divisions];
+
+    // the last entry not greater than the target
+    const auto it = std::upper_bound(lengths.begin(), lengths.end(), target);
+    const size_t index = std::min<size_t>(std::max<ptrdiff_t>(it - lengths.begin() - 1, 0), divisions - 1);
+
+    return parameterAt(lengths, index, target);
+}
+
+size_t Curve::arcLengthDivisions() const
+{
+    return m_arcLengthDivisions;
+}
+
+void Curve::setArcLengthDivisions(size_t divisions)
+{
+    m_arcLengthDivisions = std::max<size_t>(1, divisions);
+    m_lengths.clear();
+}
+
+Vector3 Curve::getTangent(HIGH_PRECISION t) const
+{
+    const HIGH_PRECISION delta = 0.0001;
+    const HIGH_PRECISION t1 = std::max<HIGH_PRECISION>(0, t - delta);
+    const HIGH_PRECISION t2 = std::min<HIGH_PRECISION>(1, t + delta);
+
+    Vector3 tangent = getPoint(t2);
+    tangent.sub(getPoint(t1));
+    tangent.normalize();
+    return tangent;
+}
+
+Vector3 Curve::getTangentAt(HIGH_PRECISION u) const
+{
+    return getTangent(getUtoTmapping(u));
+}
+
+Curve::FrenetFrames Curve::computeFrenetFrames(size_t segments, bool closed) const
+{
+    const size_t count = segments + 1;
+    std::vector<float> tangents(count * 3), normals(count * 3), binormals(count * 3);
+    computeFrenetFrames(segments, closed, tangents, normals, binormals);
+
+    FrenetFrames frames;
+    frames.tangents.reserve(count);
+    frames.normals.reserve(count);
+    frames.binormals.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        frames.tangents.emplace_back(tangents[i * 3], tangents[i * 3 + 1], tangents[i * 3 + 2]);
+        frames.normals.emplace_back(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2]);
+        frames.binormals.emplace_back(binormals[i * 3], binormals[i * 3 + 1], binormals[i * 3 + 2]);
+    }
+
+    return frames;
+}
+
+void Curve::computeFrenetFrames(size_t segments, bool closed, std::span<float> tangents, std::span<float> normals, std::span<float> binormals) const
+{
+    if (segments == 0)
+        throw std::invalid_argument("Curve: segments must be positive");
+
+    const size_t count = segments + 1;
+    if (tangents.size() < count * 3 || normals.size() < count * 3 || binormals.size() < count * 3)
+        throw std::invalid_argument("Curve: frames are smaller than (segments + 1) * 3");
+
+    // tangents at equal steps of the arc length, in one batch
+
+    std::vector<float> u(count), points(count * 3);
+    for (size_t i = 0; i < count; i++)
+        u[i] = static_cast<float>(i) / static_cast<float>(segments);
+
+    evaluateAt(u, points, tangents);
+
+    float *T = tangents.data();
+    float *N = normals.data();
+    float *B = binormals.data();
+
+    // the first normal is perpendicular to the tangent and to the axis the
+    // tangent points least along
+
+    float axis[3] = {0, 0, 0};
+    const float tx = std::abs(T[0]), ty = std::abs(T[1]), tz = std::abs(T[2]);
+    float smallest = tx;
+    axis[0] = 1;
+    if (ty <= smallest)
+    {
+        smallest = ty;
+        axis[0] = 0;
+        axis[1] = 1;
+    }
+    if (tz <= smallest)
+    {
+        axis[0] = 0;
+        axis[1] = 0;
+        axis[2] = 1;
+    }
+
+    float vec[3];
+    cross(T, axis, vec);
+    normalize(vec);
+    cross(T, vec, N);
+    cross(T, N, B);
+
+    // transport the normal by the rotation that takes one tangent to the
+    // next (Rodrigues with the unnormalized axis, so no acos/sin needed)
+
+    for (size_t i = 1; i < count; i++)
+    {
+        const float *t0 = T + (i - 1) * 3;
+        const float *t1 = T + i * 3;
+        const float *n0 = N + (i - 1) * 3;
+        float *n1 = N + i * 3;
+
+        float v[3];
+        cross(t0, t1, v);
+        const float c = dot(t0, t1);
+
+        if (1 + c > 1e-6f)
+        {
+            float vn[3];
+            cross(v, n0, vn);
+            const float k = dot(v, n0) / (1 + c);
+            for (size_t a = 0; a < 3; a++)
+                n1[a] = n0[a] * c + vn[a] + v[a] * k;
+        }
+        else
+        {
+            n1[0] = n0[0];
+            n1[1] = n0[1];
+            n1[2] = n0[2];
+        }
+
+        // keep the frame orthonormal against float drift
+        const float along = dot(n1, t1);
+        for (size_t a = 0; a < 3; a++)
+            n1[a] -= t1[a] * along;
+        normalize(n1);
+
+        cross(t1, n1, B + i * 3);
+    }
+
+    // if the curve is closed, spread the twist between the first and the
+    // last normal along the curve
+
+    if (closed)
+    {
+        const float *nLast = N + segments * 3;
+        float theta = std::acos(std::clamp(dot(N, nLast), -1.0f, 1.0f)) / static_cast<float>(segments);
+
+        float turn[3];
+        cross(N, nLast, turn);
+        if (dot(T, turn) > 0)
+            theta = -theta;
+
+        for (size_t i = 1; i < count; i++)
+        {
+            const float *t = T + i * 3;
+            float *n = N + i * 3;
+
+            const float angle = theta * static_cast<float>(i);
+            const float c = std::cos(angle);
+            const float s = std::sin(angle);
+
+            float tn[3];
+            cross(t, n, tn);
+            const float k = dot(t, n) * (1 - c);
+            for (size_t a = 0; a < 3; a++)
+                n[a] = n[a] * c + tn[a] * s + t[a] * k;
+
+            cross(t, n, B + i * 3);
+        }
+    }
+}
+
+void Curve::evaluate(std::span<const float> t, std::span<float> points, std::span<float> tangents) const
+{
+    if (points.size() < t.size() * 3)
+        throw std::invalid_argument("Curve: points is smaller than t");
+    if (!tangents.empty() && tangents.size() < t.size() * 3)
+        throw std::invalid_argument("Curve: tangents is smaller than t");
+
+    prepare();
+
+    const std::vector<Cubic> &pieces = cubics();
+    const float *params = t.data();
+    float *out = points.data();
+    float *tangentOut = tangents.empty() ? nullptr : tangents.data();
+
+    Parallel::parallelFor(0, t.size(), POINT_GRAIN, [&](size_t begin, size_t end)
+                          {
+        if (!pieces.empty())
+        {
+            evaluateCubics(pieces.data(), pieces.size(), params + begin, end - begin, out + begin * 3, tangentOut ? tangentOut + begin * 3 : nullptr);
+            return;
+        }
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const HIGH_PRECISION param = std::clamp(params[i], 0.0f, 1.0f);
+
+            const Vector3 point = getPoint(param);
+            out[i * 3 + 0] = static_cast<float>(point.x());
+            out[i * 3 + 1] = static_cast<float>(point.y());
+            out[i * 3 + 2] = static_cast<float>(point.z());
+
+            if (tangentOut)
+            {
+                const Vector3 tangent = getTangent(param);
+                tangentOut[i * 3 + 0] = static_cast<float>(tangent.x());
+                tangentOut[i * 3 + 1] = static_cast<float>(tangent.y());
+                tangentOut[i * 3 + 2] = static_cast<float>(tangent.z());
+            }
+        } });
+}
+
+void Curve::evaluateAt(std::span<const float> u, std::span<float> points, std::span<float> tangents) const
+{
+    if (points.size() < u.size() * 3)
+        throw std::invalid_argument("Curve: points is smaller than u");
+    if (!tangents.empty() && tangents.size() < u.size() * 3)
+        throw std::invalid_argument("Curve: tangents is smaller than u");
+
+    prepare();
+
+    std::vector<float> t(u.size());
+
+    Parallel::parallelFor(0, u.size(), POINT_GRAIN, [&](size_t begin, size_t end)
+                          {
+        Cursor cursor(*this);
+        for (size_t i = begin; i < end; i++)
+            t[i] = static_cast<float>(cursor.map(u[i])); });
+
+    evaluate(t, points, tangents);
+}
+
+void Curve::buildCubics(std::vector<Cubic> &) const
+{
+}
+
+void Curve::prepare() const
+{
+    getLengths();
+    cubics();
+}
+
+Curve::Cubic Curve::cubicFromCoefficients(const HIGH_PRECISION x[4], const HIGH_PRECISION y[4], const HIGH_PRECISION z[4])
+{
+    Cubic cubic;
+    for (size_t i = 0; i < 4; i++)
+    {
+        cubic.x[i] = static_cast<float>(x[i]);
+        cubic.y[i] = static_cast<float>(y[i]);
+        cubic.z[i] = static_cast<float>(z[i]);
+    }
+    return cubic;
+}
+
+Vector3 Curve::cubicPoint(const HIGH_PRECISION x[4], const HIGH_PRECISION y[4], const HIGH_PRECISION z[4], HIGH_PRECISION t)
+{
+    return Vector3(((x[3] * t + x[2]) * t + x[1]) * t + x[0],
+                   ((y[3] * t + y[2]) * t + y[1]) * t + y[0],
+                   ((z[3] * t + z[2]) * t + z[1]) * t + z[0]);
+}
+
+Vector3 Curve::cubicDerivative(const HIGH_PRECISION x[4], const HIGH_PRECISION y[4], const HIGH_PRECISION z[4], HIGH_PRECISION t)
+{
+    return Vector3((3 * x[3] * t + 2 * x[2]) * t + x[1],
+                   (3 * y[3] * t + 2 * y[2]) * t + y[1],
+                   (3 * z[3] * t + 2 * z[2]) * t + z[1]);
+}
+
+const std::vector<Curve::Cubic> &Curve::cubics() const
+{
+    if (!m_cubicsBuilt)
+    {
+        buildCubics(m_cubics);
+        m_cubicsBuilt = true;
+    }
+
+    return m_cubics;
+}
+
+void Curve::evaluateCubics(const Cubic *pieces, size_t pieceCount, const float *t, size_t count, float *points, float *tangents)
+{
+    const float scale = static_cast<float>(pieceCount);
+    const size_t last = pieceCount - 1;
+
+    // the piece holding t and the parameter local to it
+    auto locate = [&](float param, float &local) -> const Cubic &
+    {
+        const float p = std::clamp(param, 0.0f, 1.0f) * scale;
+        const size_t index = std::min(static_cast<size_t>(p), last);
+        local = p - static_cast<float>(index);
+        return pieces[index];
+    };
+
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    const __m128 tiny = _mm_set1_ps(1e-30f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float local[4];
+        const Cubic &a = locate(t[i + 0], local[0]);
+        const Cubic &b = locate(t[i + 1], local[1]);
+        const Cubic &c = locate(t[i + 2], local[2]);
+        const Cubic &d = locate(t[i + 3], local[3]);
+
+        const __m128 l = _mm_loadu_ps(local);
+
+        // gather coefficient k of one axis across the four pieces
+#define THREECPP_CURVE_GATHER(axis, k) _mm_setr_ps(a.axis[k], b.axis[k], c.axis[k], d.axis[k])
+
+        __m128 position[3];
+        __m128 derivative[3];
+
+        {
+            const __m128 x0 = THREECPP_CURVE_GATHER(x, 0), x1 = THREECPP_CURVE_GATHER(x, 1), x2 = THREECPP_CURVE_GATHER(x, 2), x3 = THREECPP_CURVE_GATHER(x, 3);
+            const __m128 y0 = THREECPP_CURVE_GATHER(y, 0), y1 = THREECPP_CURVE_GATHER(y, 1), y2 = THREECPP_CURVE_GATHER(y, 2), y3 = THREECPP_CURVE_GATHER(y, 3);
+            const __m128 z0 = THREECPP_CURVE_GATHER(z, 0), z1 = THREECPP_CURVE_GATHER(z, 1), z2 = THREECPP_CURVE_GATHER(z, 2), z3 = THREECPP_CURVE_GATHER(z, 3);
+
+            // Horner
+            position[0] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(x3, l), x2), l), x1), l), x0);
+            position[1] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(y3, l), y2), l), y1), l), y0);
+            position[2] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(z3, l), z2), l), z1), l), z0);
+
+            if (tangents)
+            {
+                derivative[0] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(three, x3), l), _mm_mul_ps(two, x2)), l), x1);
+                derivative[1] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(three, y3), l), _mm_mul_ps(two, y2)), l), y1);
+                derivative[2] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(three, z3), l), _mm_mul_ps(two, z2)), l), z1);
+            }
+        }
+
+#undef THREECPP_CURVE_GATHER
+
+        storePoints(points + i * 3, position[0], position[1], position[2]);
+
+        if (tangents)
+        {
+            const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(derivative[0], derivative[0]), _mm_mul_ps(derivative[1], derivative[1])), _mm_mul_ps(derivative[2], derivative[2]));
+            const __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_sqrt_ps(lengthSq), tiny));
+
+            storePoints(tangents + i * 3, _mm_mul_ps(derivative[0], inverse), _mm_mul_ps(derivative[1], inverse), _mm_mul_ps(derivative[2], inverse));
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float l;
+        const Cubic &piece = locate(t[i], l);
+
+        points[i * 3 + 0] = ((piece.x[3] * l + piece.x[2]) * l + piece.x[1]) * l + piece.x[0];
+        points[i * 3 + 1] = ((piece.y[3] * l + piece.y[2]) * l + piece.y[1]) * l + piece.y[0];
+        points[i * 3 + 2] = ((piece.z[3] * l + piece.z[2]) * l + piece.z[1]) * l + piece.z[0];
+
+        if (tangents)
+        {
+            float *tangent = tangents + i * 3;
+            tangent[0] = (3 * piece.x[3] * l + 2 * piece.x[2]) * l + piece.x[1];
+            tangent[1] = (3 * piece.y[3] * l + 2 * piece.y[2]) * l + piece.y[1];
+            tangent[2] = (3 * piece.z[3] * l + 2 * piece.z[2]) * l + piece.z[1];
+            normalize(tangent);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include "extras/core/CurvePath.h"
+#include "extras/curves/CatmullRomCurve3.h"
+#include "extras/curves/EllipseCurve.h"
+#include "extras/curves/LineCurve3.h"
+#include <algorithm>
+
+CurvePath::CurvePath() = default;
+
+CurvePath::~CurvePath() = default;
+
+std::string CurvePath::type() const
+{
+    return "CurvePath";
+}
+
+void CurvePath::add(std::shared_ptr<Curve> curve)
+{
+    m_curves.push_back(std::move(curve));
+    updateArcLengths();
+}
+
+void CurvePath::closePath()
+{
+    if (m_curves.empty())
+        return;
+
+    // add a line curve if start and end of lines are not connected
+    const Vector3 startPoint = m_curves.front()->getPoint(0);
+    const Vector3 endPoint = m_curves.back()->getPoint(1);
+
+    if (!startPoint.equals(endPoint))
+        add(std::make_shared<LineCurve3>(endPoint, startPoint));
+}
+
+const std::vector<std::shared_ptr<Curve>> &CurvePath::curves() const
+{
+    return m_curves;
+}
+
+bool CurvePath::autoClose() const
+{
+    return m_autoClose;
+}
+
+void CurvePath::setAutoClose(bool autoClose)
+{
+    m_autoClose = autoClose;
+}
+
+Vector3 CurvePath::getPoint(HIGH_PRECISION t) const
+{
+    if (m_curves.empty())
+        return Vector3();
+
+    // find the first curve that ends at or after the target length
+    const HIGH_PRECISION d = t * getLength();
+    const std::vector<HIGH_PRECISION> &curveLengths = getCurveLengths();
+
+    const auto it = std::lower_bound(curveLengths.begin(), curveLengths.end(), d);
+    if (it == curveLengths.end())
+        return m_curves.back()->getPoint(1);
+
+    const size_t i = static_cast<size_t>(it - curveLengths.begin());
+    const HIGH_PRECISION diff = curveLengths[i] - d;
+    const HIGH_PRECISION segmentLength = m_curves[i]->getLength();
+    const HIGH_PRECISION u = segmentLength == 0 ? 0 : 1 - diff / segmentLength;
+
+    return m_curves[i]->getPointAt(u);
+}
+
+HIGH_PRECISION CurvePath::getLength() const
+{
+    const std::vector<HIGH_PRECISION> &lengths = getCurveLengths();
+    return lengths.empty() ? 0 : lengths.back();
+}
+
+void CurvePath::updateArcLengths()
+{
+    Curve::updateArcLengths();
+    m_cacheLengths.clear();
+}
+
+const std::vector<HIGH_PRECISION> &CurvePath::getCurveLengths() const
+{
+    if (m_cacheLengths.size() == m_curves.size())
+        return m_cacheLengths;
+
+    // get length of sub-curve, push cumulative distance
+    m_cacheLengths.clear();
+    m_cacheLengths.reserve(m_curves.size());
+
+    HIGH_PRECISION sums = 0;
+    for (const auto &curve : m_curves)
+    {
+        sums += curve->getLength();
+        m_cacheLengths.push_back(sums);
+    }
+
+    return m_cacheLengths;
+}
+
+std::vector<Vector3> CurvePath::getPoints(size_t divisions) const
+{
+    std::vector<Vector3> points;
+
+    for (const auto &curve : m_curves)
+    {
+        size_t resolution = divisions;
+        if (dynamic_cast<const EllipseCurve *>(curve.get()))
+            resolution = divisions * 2;
+        else if (dynamic_cast<const LineCurve3 *>(curve.get()))
+            resolution = 1;
+        else if (const auto *spline = dynamic_cast<const CatmullRomCurve3 *>(curve.get()))
+            resolution = divisions * spline->points().size();
+
+        for (const Vector3 &point : curve->getPoints(resolution))
+        {
+            // ensures no consecutive points are duplicates
+            if (!points.empty() && points.back().equals(point))
+                continue;
+
+            points.push_back(point);
+        }
+    }
+
+    if (m_autoClose && points.size() > 1 && !points.back().equals(points.front()))
+        points.push_back(points.front());
+
+    return points;
+}
+
+void CurvePath::prepare() const
+{
+    // getPoint reaches into the caches of every curve
+    for (const auto &curve : m_curves)
+    {
+        curve->getLengths();
+        curve->getLength();
+    }
+
+    Curve::prepare();
+}
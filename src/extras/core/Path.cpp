@@ -0,0 +1,164 @@
+#include "extras/core/Path.h"
+#include "extras/curves/CatmullRomCurve3.h"
+#include "extras/curves/CubicBezierCurve3.h"
+#include "extras/curves/EllipseCurve.h"
+#include "extras/curves/LineCurve3.h"
+#include "extras/curves/QuadraticBezierCurve3.h"
+
+namespace
+{
+    Vector3 toPlane(const Vector2 &point)
+    {
+        return Vector3(point.x(), point.y(), 0);
+    }
+
+    std::vector<Vector2> fromPlane(const std::vector<Vector3> &points)
+    {
+        std::vector<Vector2> result;
+        result.reserve(points.size());
+        for (const Vector3 &point : points)
+            result.emplace_back(point.x(), point.y());
+        return result;
+    }
+}
+
+Path::Path(const std::vector<Vector2> &points)
+{
+    if (!points.empty())
+        setFromPoints(points);
+}
+
+Path::~Path() = default;
+
+std::string Path::type() const
+{
+    return "Path";
+}
+
+Path &Path::setFromPoints(const std::vector<Vector2> &points)
+{
+    if (points.empty())
+        return *this;
+
+    moveTo(points[0].x(), points[0].y());
+
+    for (size_t i = 1; i < points.size(); i++)
+        lineTo(points[i].x(), points[i].y());
+
+    return *this;
+}
+
+Path &Path::moveTo(HIGH_PRECISION x, HIGH_PRECISION y)
+{
+    m_currentPoint.set(x, y);
+    return *this;
+}
+
+Path &Path::lineTo(HIGH_PRECISION x, HIGH_PRECISION y)
+{
+    m_curvePath.add(std::make_shared<LineCurve3>(toPlane(m_currentPoint), Vector3(x, y, 0)));
+    m_currentPoint.set(x, y);
+    return *this;
+}
+
+Path &Path::quadraticCurveTo(HIGH_PRECISION aCPx, HIGH_PRECISION aCPy, HIGH_PRECISION aX, HIGH_PRECISION aY)
+{
+    m_curvePath.add(std::make_shared<QuadraticBezierCurve3>(toPlane(m_currentPoint), Vector3(aCPx, aCPy, 0), Vector3(aX, aY, 0)));
+    m_currentPoint.set(aX, aY);
+    return *this;
+}
+
+Path &Path::bezierCurveTo(HIGH_PRECISION aCP1x, HIGH_PRECISION aCP1y, HIGH_PRECISION aCP2x, HIGH_PRECISION aCP2y, HIGH_PRECISION aX, HIGH_PRECISION aY)
+{
+    m_curvePath.add(std::make_shared<CubicBezierCurve3>(toPlane(m_currentPoint), Vector3(aCP1x, aCP1y, 0), Vector3(aCP2x, aCP2y, 0), Vector3(aX, aY, 0)));
+    m_currentPoint.set(aX, aY);
+    return *this;
+}
+
+Path &Path::splineThru(const std::vector<Vector2> &pts)
+{
+    if (pts.empty())
+        return *this;
+
+    std::vector<Vector3> npts;
+    npts.reserve(pts.size() + 1);
+    npts.push_back(toPlane(m_currentPoint));
+    for (const Vector2 &point : pts)
+        npts.push_back(toPlane(point));
+
+    m_curvePath.add(std::make_shared<CatmullRomCurve3>(std::move(npts), false, CatmullRomCurve3::CurveType::CatmullRom, 0.5));
+    m_currentPoint.copy(pts.back());
+    return *this;
+}
+
+Path &Path::arc(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION aRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise)
+{
+    const HIGH_PRECISION x0 = m_currentPoint.x();
+    const HIGH_PRECISION y0 = m_currentPoint.y();
+
+    return absarc(aX + x0, aY + y0, aRadius, aStartAngle, aEndAngle, aClockwise);
+}
+
+Path &Path::absarc(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION aRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise)
+{
+    return absellipse(aX, aY, aRadius, aRadius, aStartAngle, aEndAngle, aClockwise);
+}
+
+Path &Path::ellipse(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION xRadius, HIGH_PRECISION yRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise, HIGH_PRECISION aRotation)
+{
+    const HIGH_PRECISION x0 = m_currentPoint.x();
+    const HIGH_PRECISION y0 = m_currentPoint.y();
+
+    return absellipse(aX + x0, aY + y0, xRadius, yRadius, aStartAngle, aEndAngle, aClockwise, aRotation);
+}
+
+Path &Path::absellipse(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION xRadius, HIGH_PRECISION yRadius, HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise, HIGH_PRECISION aRotation)
+{
+    auto curve = std::make_shared<EllipseCurve>(aX, aY, xRadius, yRadius, aStartAngle, aEndAngle, aClockwise, aRotation);
+
+    if (!m_curvePath.curves().empty())
+    {
+        // if a previous curve is present, attempt to join
+        const Vector3 firstPoint = curve->getPoint(0);
+
+        if (!Vector2(firstPoint.x(), firstPoint.y()).equals(m_currentPoint))
+            lineTo(firstPoint.x(), firstPoint.y());
+    }
+
+    const Vector3 lastPoint = curve->getPoint(1);
+    m_curvePath.add(std::move(curve));
+    m_currentPoint.set(lastPoint.x(), lastPoint.y());
+
+    return *this;
+}
+
+Path &Path::closePath()
+{
+    m_curvePath.closePath();
+    return *this;
+}
+
+const Vector2 &Path::currentPoint() const
+{
+    return m_currentPoint;
+}
+
+CurvePath &Path::curvePath()
+{
+    return m_curvePath;
+}
+
+const CurvePath &Path::curvePath() const
+{
+    return m_curvePath;
+}
+
+std::vector<Vector2> Path::getPoints(size_t divisions) const
+{
+    return fromPlane(m_curvePath.getPoints(divisions));
+}
+
+std::vector<Vector2> Path::getSpacedPoints(size_t divisions) const
+{
+    return fromPlane(m_curvePath.getSpacedPoints(divisions));
+}
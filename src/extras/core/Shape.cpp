@@ -0,0 +1,39 @@
+#include "extras/core/Shape.h"
+
+Shape::Shape(const std::vector<Vector2> &points)
+    : Path(points)
+{
+}
+
+Shape::~Shape() = default;
+
+std::string Shape::type() const
+{
+    return "Shape";
+}
+
+std::vector<Path> &Shape::holes()
+{
+    return m_holes;
+}
+
+const std::vector<Path> &Shape::holes() const
+{
+    return m_holes;
+}
+
+std::vector<std::vector<Vector2>> Shape::getPointsHoles(size_t divisions) const
+{
+    std::vector<std::vector<Vector2>> holesPts;
+    holesPts.reserve(m_holes.size());
+
+    for (const Path &hole : m_holes)
+        holesPts.push_back(hole.getPoints(divisions));
+
+    return holesPts;
+}
+
+Shape::Points Shape::extractPoints(size_t divisions) const
+{
+    return {getPoints(divisions), getPointsHoles(divisions)};
+}
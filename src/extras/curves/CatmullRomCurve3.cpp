@@ -0,0 +1,213 @@
+#include "extras/curves/CatmullRomCurve3.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // cubic with the given values and derivatives at t = 0 and t = 1
+    void hermite(HIGH_PRECISION x0, HIGH_PRECISION x1, HIGH_PRECISION t0, HIGH_PRECISION t1, HIGH_PRECISION c[4])
+    {
+        c[0] = x0;
+        c[1] = t0;
+        c[2] = -3 * x0 + 3 * x1 - 2 * t0 - t1;
+        c[3] = 2 * x0 - 2 * x1 + t0 + t1;
+    }
+
+    void uniform(HIGH_PRECISION x0, HIGH_PRECISION x1, HIGH_PRECISION x2, HIGH_PRECISION x3, HIGH_PRECISION tension, HIGH_PRECISION c[4])
+    {
+        hermite(x1, x2, tension * (x2 - x0), tension * (x3 - x1), c);
+    }
+
+    void nonuniform(HIGH_PRECISION x0, HIGH_PRECISION x1, HIGH_PRECISION x2, HIGH_PRECISION x3, HIGH_PRECISION dt0, HIGH_PRECISION dt1, HIGH_PRECISION dt2, HIGH_PRECISION c[4])
+    {
+        // compute tangents when parameterized in [t1,t2]
+        HIGH_PRECISION t1 = (x1 - x0) / dt0 - (x2 - x0) / (dt0 + dt1) + (x2 - x1) / dt1;
+        HIGH_PRECISION t2 = (x2 - x1) / dt1 - (x3 - x1) / (dt1 + dt2) + (x3 - x2) / dt2;
+
+        // rescale tangents for parametrization in [0,1]
+        t1 *= dt1;
+        t2 *= dt1;
+
+        hermite(x1, x2, t1, t2, c);
+    }
+}
+
+CatmullRomCurve3::CatmullRomCurve3(std::vector<Vector3> points, bool closed, CurveType curveType, HIGH_PRECISION tension)
+    : m_points(std::move(points)), m_closed(closed), m_curveType(curveType), m_tension(tension)
+{
+}
+
+CatmullRomCurve3::~CatmullRomCurve3() = default;
+
+std::string CatmullRomCurve3::type() const
+{
+    return "CatmullRomCurve3";
+}
+
+const std::vector<Vector3> &CatmullRomCurve3::points() const
+{
+    return m_points;
+}
+
+void CatmullRomCurve3::setPoints(std::vector<Vector3> points)
+{
+    m_points = std::move(points);
+    updateArcLengths();
+}
+
+bool CatmullRomCurve3::closed() const
+{
+    return m_closed;
+}
+
+void CatmullRomCurve3::setClosed(bool closed)
+{
+    m_closed = closed;
+    updateArcLengths();
+}
+
+CatmullRomCurve3::CurveType CatmullRomCurve3::curveType() const
+{
+    return m_curveType;
+}
+
+void CatmullRomCurve3::setCurveType(CurveType curveType)
+{
+    m_curveType = curveType;
+    updateArcLengths();
+}
+
+HIGH_PRECISION CatmullRomCurve3::tension() const
+{
+    return m_tension;
+}
+
+void CatmullRomCurve3::setTension(HIGH_PRECISION tension)
+{
+    m_tension = tension;
+    updateArcLengths();
+}
+
+Vector3 CatmullRomCurve3::getPoint(HIGH_PRECISION t) const
+{
+    HIGH_PRECISION local;
+    const Span &span = locate(t, local);
+    return cubicPoint(&span[0], &span[4], &span[8], local);
+}
+
+Vector3 CatmullRomCurve3::getTangent(HIGH_PRECISION t) const
+{
+    HIGH_PRECISION local;
+    const Span &span = locate(t, local);
+
+    Vector3 tangent = cubicDerivative(&span[0], &span[4], &span[8], local);
+    if (tangent.lengthSq() == 0)
+        return Curve::getTangent(t);
+
+    tangent.normalize();
+    return tangent;
+}
+
+void CatmullRomCurve3::updateArcLengths()
+{
+    Curve::updateArcLengths();
+    m_spans.clear();
+}
+
+void CatmullRomCurve3::buildCubics(std::vector<Cubic> &cubics) const
+{
+    cubics.reserve(spans().size());
+    for (const Span &span : spans())
+        cubics.push_back(cubicFromCoefficients(&span[0], &span[4], &span[8]));
+}
+
+const CatmullRomCurve3::Span &CatmullRomCurve3::locate(HIGH_PRECISION t, HIGH_PRECISION &local) const
+{
+    const std::vector<Span> &all = spans();
+    const HIGH_PRECISION p = std::clamp<HIGH_PRECISION>(t, 0, 1) * all.size();
+
+    // t = 1 is the end of the last span
+    const size_t index = std::min(static_cast<size_t>(p), all.size() - 1);
+    local = p - index;
+    return all[index];
+}
+
+const std::vector<CatmullRomCurve3::Span> &CatmullRomCurve3::spans() const
+{
+    if (!m_spans.empty())
+        return m_spans;
+
+    const size_t l = m_points.size();
+    if (l < 2)
+    {
+        // a constant
+        const Vector3 point = l == 1 ? m_points[0] : Vector3();
+        Span span{};
+        span[0] = point.x();
+        span[4] = point.y();
+        span[8] = point.z();
+        m_spans.push_back(span);
+        return m_spans;
+    }
+
+    const size_t count = m_closed ? l : l - 1;
+    m_spans.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        m_spans.push_back(computeSpan(i));
+
+    return m_spans;
+}
+
+CatmullRomCurve3::Span CatmullRomCurve3::computeSpan(size_t index) const
+{
+    const size_t l = m_points.size();
+
+    const Vector3 &p1 = m_points[index % l];
+    const Vector3 &p2 = m_points[(index + 1) % l];
+
+    // the points before and after the span; an open curve extrapolates its
+    // first and last span
+    Vector3 p0, p3;
+
+    if (m_closed || index > 0)
+        p0 = m_points[(index + l - 1) % l];
+    else
+        p0.set(2 * m_points[0].x() - m_points[1].x(), 2 * m_points[0].y() - m_points[1].y(), 2 * m_points[0].z() - m_points[1].z());
+
+    if (m_closed || index + 2 < l)
+        p3 = m_points[(index + 2) % l];
+    else
+        p3.set(2 * m_points[l - 1].x() - m_points[l - 2].x(), 2 * m_points[l - 1].y() - m_points[l - 2].y(), 2 * m_points[l - 1].z() - m_points[l - 2].z());
+
+    Span span;
+    HIGH_PRECISION *x = &span[0];
+    HIGH_PRECISION *y = &span[4];
+    HIGH_PRECISION *z = &span[8];
+
+    if (m_curveType == CurveType::CatmullRom)
+    {
+        uniform(p0.x(), p1.x(), p2.x(), p3.x(), m_tension, x);
+        uniform(p0.y(), p1.y(), p2.y(), p3.y(), m_tension, y);
+        uniform(p0.z(), p1.z(), p2.z(), p3.z(), m_tension, z);
+        return span;
+    }
+
+    // init Centripetal / Chordal Catmull-Rom
+    const HIGH_PRECISION power = m_curveType == CurveType::Chordal ? 0.5 : 0.25;
+    HIGH_PRECISION dt0 = std::pow(p0.distanceToSquared(p1), power);
+    HIGH_PRECISION dt1 = std::pow(p1.distanceToSquared(p2), power);
+    HIGH_PRECISION dt2 = std::pow(p2.distanceToSquared(p3), power);
+
+    // safety check for repeated points
+    if (dt1 < 1e-4)
+        dt1 = 1.0;
+    if (dt0 < 1e-4)
+        dt0 = dt1;
+    if (dt2 < 1e-4)
+        dt2 = dt1;
+
+    nonuniform(p0.x(), p1.x(), p2.x(), p3.x(), dt0, dt1, dt2, x);
+    nonuniform(p0.y(), p1.y(), p2.y(), p3.y(), dt0, dt1, dt2, y);
+    nonuniform(p0.z(), p1.z(), p2.z(), p3.z(), dt0, dt1, dt2, z);
+    return span;
+}
@@ -0,0 +1,96 @@
+#include "extras/curves/CubicBezierCurve3.h"
+
+CubicBezierCurve3::CubicBezierCurve3(const Vector3 &v0, const Vector3 &v1, const Vector3 &v2, const Vector3 &v3)
+    : m_v0(v0), m_v1(v1), m_v2(v2), m_v3(v3)
+{
+}
+
+CubicBezierCurve3::~CubicBezierCurve3() = default;
+
+std::string CubicBezierCurve3::type() const
+{
+    return "CubicBezierCurve3";
+}
+
+Vector3 &CubicBezierCurve3::v0()
+{
+    return m_v0;
+}
+
+const Vector3 &CubicBezierCurve3::v0() const
+{
+    return m_v0;
+}
+
+Vector3 &CubicBezierCurve3::v1()
+{
+    return m_v1;
+}
+
+const Vector3 &CubicBezierCurve3::v1() const
+{
+    return m_v1;
+}
+
+Vector3 &CubicBezierCurve3::v2()
+{
+    return m_v2;
+}
+
+const Vector3 &CubicBezierCurve3::v2() const
+{
+    return m_v2;
+}
+
+Vector3 &CubicBezierCurve3::v3()
+{
+    return m_v3;
+}
+
+const Vector3 &CubicBezierCurve3::v3() const
+{
+    return m_v3;
+}
+
+Vector3 CubicBezierCurve3::getPoint(HIGH_PRECISION t) const
+{
+    HIGH_PRECISION x[4], y[4], z[4];
+    coefficients(x, y, z);
+    return cubicPoint(x, y, z, t);
+}
+
+Vector3 CubicBezierCurve3::getTangent(HIGH_PRECISION t) const
+{
+    HIGH_PRECISION x[4], y[4], z[4];
+    coefficients(x, y, z);
+
+    Vector3 tangent = cubicDerivative(x, y, z, t);
+    if (tangent.lengthSq() == 0)
+        return Curve::getTangent(t);
+
+    tangent.normalize();
+    return tangent;
+}
+
+void CubicBezierCurve3::buildCubics(std::vector<Cubic> &cubics) const
+{
+    HIGH_PRECISION x[4], y[4], z[4];
+    coefficients(x, y, z);
+    cubics.push_back(cubicFromCoefficients(x, y, z));
+}
+
+void CubicBezierCurve3::coefficients(HIGH_PRECISION x[4], HIGH_PRECISION y[4], HIGH_PRECISION z[4]) const
+{
+    // (1-t)³ p0 + 3 (1-t)² t p1 + 3 (1-t) t² p2 + t³ p3
+    auto axis = [](HIGH_PRECISION p0, HIGH_PRECISION p1, HIGH_PRECISION p2, HIGH_PRECISION p3, HIGH_PRECISION c[4])
+    {
+        c[0] = p0;
+        c[1] = 3 * (p1 - p0);
+        c[2] = 3 * (p0 - 2 * p1 + p2);
+        c[3] = p3 - p0 + 3 * (p1 - p2);
+    };
+
+    axis(m_v0.x(), m_v1.x(), m_v2.x(), m_v3.x(), x);
+    axis(m_v0.y(), m_v1.y(), m_v2.y(), m_v3.y(), y);
+    axis(m_v0.z(), m_v1.z(), m_v2.z(), m_v3.z(), z);
+}
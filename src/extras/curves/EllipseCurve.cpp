@@ -0,0 +1,56 @@
+#include "extras/curves/EllipseCurve.h"
+#include <cmath>
+#include <limits>
+
+EllipseCurve::EllipseCurve(HIGH_PRECISION aX, HIGH_PRECISION aY, HIGH_PRECISION xRadius, HIGH_PRECISION yRadius,
+                           HIGH_PRECISION aStartAngle, HIGH_PRECISION aEndAngle, bool aClockwise, HIGH_PRECISION aRotation)
+    : m_aX(aX), m_aY(aY), m_xRadius(xRadius), m_yRadius(yRadius),
+      m_aStartAngle(aStartAngle), m_aEndAngle(aEndAngle), m_aClockwise(aClockwise), m_aRotation(aRotation)
+{
+}
+
+EllipseCurve::~EllipseCurve() = default;
+
+std::string EllipseCurve::type() const
+{
+    return "EllipseCurve";
+}
+
+Vector3 EllipseCurve::getPoint(HIGH_PRECISION t) const
+{
+    const HIGH_PRECISION twoPi = MATH_PI * 2;
+    const HIGH_PRECISION epsilon = std::numeric_limits<double>::epsilon();
+    HIGH_PRECISION deltaAngle = m_aEndAngle - m_aStartAngle;
+    const bool samePoints = std::abs(deltaAngle) < epsilon;
+
+    // ensures that deltaAngle is 0 .. 2 PI
+    while (deltaAngle < 0)
+        deltaAngle += twoPi;
+    while (deltaAngle > twoPi)
+        deltaAngle -= twoPi;
+
+    if (deltaAngle < epsilon)
+        deltaAngle = samePoints ? 0 : twoPi;
+
+    if (m_aClockwise && !samePoints)
+        deltaAngle = deltaAngle == twoPi ? -twoPi : deltaAngle - twoPi;
+
+    const HIGH_PRECISION angle = m_aStartAngle + t * deltaAngle;
+    HIGH_PRECISION x = m_aX + m_xRadius * std::cos(angle);
+    HIGH_PRECISION y = m_aY + m_yRadius * std::sin(angle);
+
+    if (m_aRotation != 0)
+    {
+        const HIGH_PRECISION cos = std::cos(m_aRotation);
+        const HIGH_PRECISION sin = std::sin(m_aRotation);
+
+        const HIGH_PRECISION tx = x - m_aX;
+        const HIGH_PRECISION ty = y - m_aY;
+
+        // rotate the point about the center of the ellipse
+        x = tx * cos - ty * sin + m_aX;
+        y = tx * sin + ty * cos + m_aY;
+    }
+
+    return Vector3(x, y, 0);
+}
@@ -0,0 +1,75 @@
+#include "extras/curves/LineCurve3.h"
+
+LineCurve3::LineCurve3(const Vector3 &v1, const Vector3 &v2)
+    : m_v1(v1), m_v2(v2)
+{
+}
+
+LineCurve3::~LineCurve3() = default;
+
+std::string LineCurve3::type() const
+{
+    return "LineCurve3";
+}
+
+Vector3 &LineCurve3::v1()
+{
+    return m_v1;
+}
+
+const Vector3 &LineCurve3::v1() const
+{
+    return m_v1;
+}
+
+Vector3 &LineCurve3::v2()
+{
+    return m_v2;
+}
+
+const Vector3 &LineCurve3::v2() const
+{
+    return m_v2;
+}
+
+Vector3 LineCurve3::getPoint(HIGH_PRECISION t) const
+{
+    if (t == 1)
+        return m_v2;
+
+    Vector3 point;
+    point.lerpVectors(m_v1, m_v2, t);
+    return point;
+}
+
+Vector3 LineCurve3::getPointAt(HIGH_PRECISION u) const
+{
+    return getPoint(u);
+}
+
+HIGH_PRECISION LineCurve3::getLength() const
+{
+    return m_v1.distanceTo(m_v2);
+}
+
+Vector3 LineCurve3::getTangent(HIGH_PRECISION) const
+{
+    Vector3 tangent;
+    tangent.subVectors(m_v2, m_v1);
+    tangent.normalize();
+    return tangent;
+}
+
+Vector3 LineCurve3::getTangentAt(HIGH_PRECISION u) const
+{
+    return getTangent(u);
+}
+
+void LineCurve3::buildCubics(std::vector<Cubic> &cubics) const
+{
+    const HIGH_PRECISION x[4] = {m_v1.x(), m_v2.x() - m_v1.x(), 0, 0};
+    const HIGH_PRECISION y[4] = {m_v1.y(), m_v2.y() - m_v1.y(), 0, 0};
+    const HIGH_PRECISION z[4] = {m_v1.z(), m_v2.z() - m_v1.z(), 0, 0};
+
+    cubics.push_back(cubicFromCoefficients(x, y, z));
+}
@@ -0,0 +1,86 @@
+#include "extras/curves/QuadraticBezierCurve3.h"
+
+QuadraticBezierCurve3::QuadraticBezierCurve3(const Vector3 &v0, const Vector3 &v1, const Vector3 &v2)
+    : m_v0(v0), m_v1(v1), m_v2(v2)
+{
+}
+
+QuadraticBezierCurve3::~QuadraticBezierCurve3() = default;
+
+std::string QuadraticBezierCurve3::type() const
+{
+    return "QuadraticBezierCurve3";
+}
+
+Vector3 &QuadraticBezierCurve3::v0()
+{
+    return m_v0;
+}
+
+const Vector3 &QuadraticBezierCurve3::v0() const
+{
+    return m_v0;
+}
+
+Vector3 &QuadraticBezierCurve3::v1()
+{
+    return m_v1;
+}
+
+const Vector3 &QuadraticBezierCurve3::v1() const
+{
+    return m_v1;
+}
+
+Vector3 &QuadraticBezierCurve3::v2()
+{
+    return m_v2;
+}
+
+const Vector3 &QuadraticBezierCurve3::v2() const
+{
+    return m_v2;
+}
+
+Vector3 QuadraticBezierCurve3::getPoint(HIGH_PRECISION t) const
+{
+    HIGH_PRECISION x[4], y[4], z[4];
+    coefficients(x, y, z);
+    return cubicPoint(x, y, z, t);
+}
+
+Vector3 QuadraticBezierCurve3::getTangent(HIGH_PRECISION t) const
+{
+    HIGH_PRECISION x[4], y[4], z[4];
+    coefficients(x, y, z);
+
+    Vector3 tangent = cubicDerivative(x, y, z, t);
+    if (tangent.lengthSq() == 0)
+        return Curve::getTangent(t);
+
+    tangent.normalize();
+    return tangent;
+}
+
+void QuadraticBezierCurve3::buildCubics(std::vector<Cubic> &cubics) const
+{
+    HIGH_PRECISION x[4], y[4], z[4];
+    coefficients(x, y, z);
+    cubics.push_back(cubicFromCoefficients(x, y, z));
+}
+
+void QuadraticBezierCurve3::coefficients(HIGH_PRECISION x[4], HIGH_PRECISION y[4], HIGH_PRECISION z[4]) const
+{
+    // (1-t)² p0 + 2 (1-t) t p1 + t² p2
+    auto axis = [](HIGH_PRECISION p0, HIGH_PRECISION p1, HIGH_PRECISION p2, HIGH_PRECISION c[4])
+    {
+        c[0] = p0;
+        c[1] = 2 * (p1 - p0);
+        c[2] = p0 - 2 * p1 + p2;
+        c[3] = 0;
+    };
+
+    axis(m_v0.x(), m_v1.x(), m_v2.x(), x);
+    axis(m_v0.y(), m_v1.y(), m_v2.y(), y);
+    axis(m_v0.z(), m_v1.z(), m_v2.z(), z);
+}
@@ -0,0 +1,137 @@
+#include "geometries/BoxGeometry.h"
+#include "common/Parallel.h"
+#include <algorithm>
+
+BoxGeometry::BoxGeometry(float width, float height, float depth, size_t widthSegments, size_t heightSegments, size_t depthSegments)
+    : m_parameters{width, height, depth, std::max<size_t>(1, widthSegments), std::max<size_t>(1, heightSegments), std::max<size_t>(1, depthSegments)}
+{
+    const size_t ws = m_parameters.widthSegments;
+    const size_t hs = m_parameters.heightSegments;
+    const size_t ds = m_parameters.depthSegments;
+
+    // the six faces as (u, v, w) axes, directions, sizes and grids, in the
+    // three.js order px, nx, py, ny, pz, nz
+    struct Face
+    {
+        size_t u, v, w;
+        float udir, vdir;
+        float width, height, depth;
+        size_t gridX, gridY;
+    };
+
+    const Face faces[6] = {
+        {2, 1, 0, -1, -1, depth, height, width, ds, hs},
+        {2, 1, 0, 1, -1, depth, height, -width, ds, hs},
+        {0, 2, 1, 1, 1, width, depth, height, ws, ds},
+        {0, 2, 1, 1, -1, width, depth, -height, ws, ds},
+        {0, 1, 2, 1, -1, width, height, depth, ws, hs},
+        {0, 1, 2, -1, -1, width, height, -depth, ws, hs},
+    };
+
+    // exact sizes up front
+
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (auto &face : faces)
+    {
+        vertexCount += (face.gridX + 1) * (face.gridY + 1);
+        indexCount += face.gridX * face.gridY * 6;
+    }
+
+    const auto streams = GeometryUtils::allocate(*this, vertexCount, indexCount);
+
+    size_t vertexOffset = 0;
+    size_t indexOffset = 0;
+    for (auto &face : faces)
+    {
+        buildPlane(streams, vertexOffset, indexOffset, face.u, face.v, face.w, face.udir, face.vdir,
+                   face.width, face.height, face.depth, face.gridX, face.gridY);
+
+        vertexOffset += (face.gridX + 1) * (face.gridY + 1);
+        indexOffset += face.gridX * face.gridY * 6;
+    }
+}
+
+BoxGeometry::~BoxGeometry()
+{
+}
+
+std::string BoxGeometry::type() const
+{
+    return "BoxGeometry";
+}
+
+const BoxGeometry::Parameters &BoxGeometry::parameters() const
+{
+    return m_parameters;
+}
+
+void BoxGeometry::buildPlane(const GeometryUtils::Streams &streams, size_t vertexOffset, size_t indexOffset,
+                             size_t u, size_t v, size_t w, float udir, float vdir,
+                             float width, float height, float depth, size_t gridX, size_t gridY)
+{
+    const float segmentWidth = width / static_cast<float>(gridX);
+    const float segmentHeight = height / static_cast<float>(gridY);
+
+    const float widthHalf = width / 2;
+    const float heightHalf = height / 2;
+    const float depthHalf = depth / 2;
+    const float normalSign = depth > 0 ? 1.0f : -1.0f;
+
+    const size_t gridX1 = gridX + 1;
+    const size_t gridY1 = gridY + 1;
+
+    // generate vertices, normals and uvs
+
+    Parallel::parallelFor(0, gridY1, GeometryUtils::rowGrain(gridX1), [&](size_t begin, size_t end)
+                          {
+        for (size_t iy = begin; iy < end; iy++)
+        {
+            const float y = static_cast<float>(iy) * segmentHeight - heightHalf;
+            const float uvY = 1 - static_cast<float>(iy) / static_cast<float>(gridY);
+            const size_t row = vertexOffset + iy * gridX1;
+
+            for (size_t ix = 0; ix < gridX1; ix++)
+            {
+                const float x = static_cast<float>(ix) * segmentWidth - widthHalf;
+
+                float *position = streams.position + (row + ix) * 3;
+                position[u] = x * udir;
+                position[v] = y * vdir;
+                position[w] = depthHalf;
+
+                float *normal = streams.normal + (row + ix) * 3;
+                normal[u] = 0;
+                normal[v] = 0;
+                normal[w] = normalSign;
+
+                float *uv = streams.uv + (row + ix) * 2;
+                uv[0] = static_cast<float>(ix) / static_cast<float>(gridX);
+                uv[1] = uvY;
+            }
+        } });
+
+    // indices: two faces per segment
+
+    Parallel::parallelFor(0, gridY, GeometryUtils::rowGrain(gridX * 6), [&](size_t begin, size_t end)
+                          {
+        for (size_t iy = begin; iy < end; iy++)
+        {
+            uint32_t *index = streams.index + indexOffset + iy * gridX * 6;
+
+            for (size_t ix = 0; ix < gridX; ix++)
+            {
+                const auto a = static_cast<uint32_t>(vertexOffset + ix + gridX1 * iy);
+                const auto b = static_cast<uint32_t>(vertexOffset + ix + gridX1 * (iy + 1));
+                const auto c = static_cast<uint32_t>(vertexOffset + (ix + 1) + gridX1 * (iy + 1));
+                const auto d = static_cast<uint32_t>(vertexOffset + (ix + 1) + gridX1 * iy);
+
+                *index++ = a;
+                *index++ = b;
+                *index++ = d;
+                *index++ = b;
+                *index++ = c;
+                *index++ = d;
+            }
+        } });
+}
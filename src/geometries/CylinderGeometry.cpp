@@ -0,0 +1,193 @@
+#include "geometries/CylinderGeometry.h"
+#include "geometries/GeometryUtils.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <cmath>
+
+CylinderGeometry::CylinderGeometry(float radiusTop, float radiusBottom, float height, size_t radialSegments, size_t heightSegments,
+                                   bool openEnded, float thetaStart, float thetaLength)
+    : m_parameters{radiusTop, radiusBottom, height, std::max<size_t>(1, radialSegments), std::max<size_t>(1, heightSegments), openEnded, thetaStart, thetaLength}
+{
+    const size_t rs = m_parameters.radialSegments;
+    const size_t hs = m_parameters.heightSegments;
+    const size_t rs1 = rs + 1;
+    const float halfHeight = height / 2;
+
+    const bool topCap = !openEnded && radiusTop > 0;
+    const bool bottomCap = !openEnded && radiusBottom > 0;
+
+    // exact sizes: the torso grid, then per cap one center vertex per
+    // segment plus a ring
+
+    std::vector<size_t> rowIndexOffsets(hs + 1, 0);
+    for (size_t y = 0; y < hs; y++)
+    {
+        const size_t triangles = (radiusTop > 0 || y != 0 ? 1 : 0) + (radiusBottom > 0 || y != hs - 1 ? 1 : 0);
+        rowIndexOffsets[y + 1] = rowIndexOffsets[y] + rs * triangles * 3;
+    }
+
+    const size_t torsoVertices = rs1 * (hs + 1);
+    const size_t capVertices = rs + rs1;
+    const size_t capCount = (topCap ? 1 : 0) + (bottomCap ? 1 : 0);
+
+    const auto streams = GeometryUtils::allocate(*this, torsoVertices + capCount * capVertices, rowIndexOffsets.back() + capCount * rs * 3);
+
+    std::vector<float> sinTheta, cosTheta;
+    GeometryUtils::sinCosTable(thetaStart, thetaLength, rs, sinTheta, cosTheta);
+
+    // torso: this will be used to calculate the normal
+    const float slope = (radiusBottom - radiusTop) / height;
+    const float normalScale = 1 / std::sqrt(1 + slope * slope);
+
+    Parallel::parallelFor(0, hs + 1, GeometryUtils::rowGrain(rs1), [&](size_t begin, size_t end)
+                          {
+        for (size_t y = begin; y < end; y++)
+        {
+            const float v = static_cast<float>(y) / static_cast<float>(hs);
+
+            // calculate the radius of the current row
+            const float radius = v * (radiusBottom - radiusTop) + radiusTop;
+            const float py = -v * height + halfHeight;
+
+            float *position = streams.position + y * rs1 * 3;
+            float *normal = streams.normal + y * rs1 * 3;
+            float *uv = streams.uv + y * rs1 * 2;
+
+            for (size_t x = 0; x <= rs; x++)
+            {
+                position[x * 3 + 0] = radius * sinTheta[x];
+                position[x * 3 + 1] = py;
+                position[x * 3 + 2] = radius * cosTheta[x];
+
+                // (sin, slope, cos) normalized; sin² + cos² = 1
+                normal[x * 3 + 0] = sinTheta[x] * normalScale;
+                normal[x * 3 + 1] = slope * normalScale;
+                normal[x * 3 + 2] = cosTheta[x] * normalScale;
+
+                uv[x * 2 + 0] = static_cast<float>(x) / static_cast<float>(rs);
+                uv[x * 2 + 1] = 1 - v;
+            }
+        } });
+
+    Parallel::parallelFor(0, hs, GeometryUtils::rowGrain(rs * 6), [&](size_t begin, size_t end)
+                          {
+        for (size_t y = begin; y < end; y++)
+        {
+            uint32_t *index = streams.index + rowIndexOffsets[y];
+            const bool first = radiusTop > 0 || y != 0;
+            const bool second = radiusBottom > 0 || y != hs - 1;
+
+            for (size_t x = 0; x < rs; x++)
+            {
+                // we use the index array to access the correct indices
+                const auto a = static_cast<uint32_t>(y * rs1 + x);
+                const auto b = static_cast<uint32_t>((y + 1) * rs1 + x);
+                const auto c = static_cast<uint32_t>((y + 1) * rs1 + x + 1);
+                const auto d = static_cast<uint32_t>(y * rs1 + x + 1);
+
+                if (first)
+                {
+                    *index++ = a;
+                    *index++ = b;
+                    *index++ = d;
+                }
+
+                if (second)
+                {
+                    *index++ = b;
+                    *index++ = c;
+                    *index++ = d;
+                }
+            }
+        } });
+
+    // caps: small, filled on this thread
+
+    size_t vertex = torsoVertices;
+    uint32_t *index = streams.index + rowIndexOffsets.back();
+
+    const auto generateCap = [&](bool top)
+    {
+        const float radius = top ? radiusTop : radiusBottom;
+        const float sign = top ? 1.0f : -1.0f;
+
+        const size_t centerIndexStart = vertex;
+
+        // first we generate the center vertex data of the cap; because the
+        // geometry needs one set of uvs per face, we must generate a center
+        // vertex per face/segment
+        for (size_t x = 0; x < rs; x++, vertex++)
+        {
+            float *position = streams.position + vertex * 3;
+            float *normal = streams.normal + vertex * 3;
+            float *uv = streams.uv + vertex * 2;
+
+            position[0] = 0;
+            position[1] = halfHeight * sign;
+            position[2] = 0;
+            normal[0] = 0;
+            normal[1] = sign;
+            normal[2] = 0;
+            uv[0] = 0.5f;
+            uv[1] = 0.5f;
+        }
+
+        const size_t centerIndexEnd = vertex;
+
+        // now we generate the surrounding vertices, normals and uvs
+        for (size_t x = 0; x <= rs; x++, vertex++)
+        {
+            float *position = streams.position + vertex * 3;
+            float *normal = streams.normal + vertex * 3;
+            float *uv = streams.uv + vertex * 2;
+
+            position[0] = radius * sinTheta[x];
+            position[1] = halfHeight * sign;
+            position[2] = radius * cosTheta[x];
+            normal[0] = 0;
+            normal[1] = sign;
+            normal[2] = 0;
+            uv[0] = cosTheta[x] * 0.5f + 0.5f;
+            uv[1] = sinTheta[x] * 0.5f * sign + 0.5f;
+        }
+
+        // generate indices
+        for (size_t x = 0; x < rs; x++)
+        {
+            const auto c = static_cast<uint32_t>(centerIndexStart + x);
+            const auto i = static_cast<uint32_t>(centerIndexEnd + x);
+
+            if (top)
+            {
+                *index++ = i;
+                *index++ = i + 1;
+                *index++ = c;
+            }
+            else
+            {
+                *index++ = i + 1;
+                *index++ = i;
+                *index++ = c;
+            }
+        }
+    };
+
+    if (topCap)
+        generateCap(true);
+    if (bottomCap)
+        generateCap(false);
+}
+
+CylinderGeometry::~CylinderGeometry()
+{
+}
+
+std::string CylinderGeometry::type() const
+{
+    return "CylinderGeometry";
+}
+
+const CylinderGeometry::Parameters &CylinderGeometry::parameters() const
+{
+    return m_parameters;
+}
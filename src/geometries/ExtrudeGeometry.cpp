@@ -0,0 +1,512 @@
+#include "geometries/ExtrudeGeometry.h"
+#include "geometries/GeometryUtils.h"
+#include "extras/ShapeUtils.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * A shape sampled, triangulated and beveled, ready to be written.
+     */
+    struct Extrusion
+    {
+        // the contour followed by the holes; vlen = vertexCount
+        size_t vertexCount = 0;
+        // xyz of every vertex per layer, layer by layer
+        std::vector<double> layers;
+        std::vector<std::array<uint32_t, 3>> faces;
+        // the preceding vertex of every vertex within its ring
+        std::vector<uint32_t> previous;
+        size_t vertexOffset = 0;
+        size_t indexOffset = 0;
+    };
+
+    /**
+     * The direction a ring vertex moves along when the ring is inset by
+     * `1`; longer than `1` at sharp corners, capped at `sqrt(2)`.
+     */
+    Vector2 getBevelVec(const Vector2 &inPt, const Vector2 &inPrev, const Vector2 &inNext)
+    {
+        // computes for a given 2D vector a point "inside" the shape, along the bisector
+
+        HIGH_PRECISION transX, transY, shrinkBy;
+
+        const Vector2 prev(inPt.x() - inPrev.x(), inPt.y() - inPrev.y());
+        const Vector2 next(inNext.x() - inPt.x(), inNext.y() - inPt.y());
+
+        const HIGH_PRECISION prevLengthSq = prev.dot(prev);
+
+        // check for collinear edges
+        const HIGH_PRECISION collinear0 = prev.cross(next);
+
+        if (std::abs(collinear0) > std::numeric_limits<double>::epsilon())
+        {
+            // not collinear
+
+            // length of vectors for normalizing
+            const HIGH_PRECISION prevLength = std::sqrt(prevLengthSq);
+            const HIGH_PRECISION nextLength = std::sqrt(next.dot(next));
+
+            // shift adjacent points by unit vectors to the left
+            const HIGH_PRECISION prevShiftX = inPrev.x() - prev.y() / prevLength;
+            const HIGH_PRECISION prevShiftY = inPrev.y() + prev.x() / prevLength;
+
+            const HIGH_PRECISION nextShiftX = inNext.x() - next.y() / nextLength;
+            const HIGH_PRECISION nextShiftY = inNext.y() + next.x() / nextLength;
+
+            // scaling factor for v_prev to intersection point
+            const HIGH_PRECISION sf = ((nextShiftX - prevShiftX) * next.y() - (nextShiftY - prevShiftY) * next.x()) / collinear0;
+
+            // vector from inPt to intersection point
+            transX = prevShiftX + prev.x() * sf - inPt.x();
+            transY = prevShiftY + prev.y() * sf - inPt.y();
+
+            // don't normalize!, otherwise sharp corners become ugly
+            // but prevent crazy spikes
+            const HIGH_PRECISION transLengthSq = transX * transX + transY * transY;
+            if (transLengthSq <= 2)
+                return Vector2(transX, transY);
+
+            shrinkBy = std::sqrt(transLengthSq / 2);
+        }
+        else
+        {
+            // handle special case of collinear edges
+
+            const HIGH_PRECISION epsilon = std::numeric_limits<double>::epsilon();
+            bool directionEq = false; // assumes: opposite
+
+            if (prev.x() > epsilon)
+                directionEq = next.x() > epsilon;
+            else if (prev.x() < -epsilon)
+                directionEq = next.x() < -epsilon;
+            else
+                directionEq = std::signbit(prev.y()) == std::signbit(next.y());
+
+            if (directionEq)
+            {
+                // perpendicular to the edges, to the left
+                transX = -prev.y();
+                transY = prev.x();
+                shrinkBy = std::sqrt(prevLengthSq);
+            }
+            else
+            {
+                // the ring turns back on itself
+                transX = prev.x();
+                transY = prev.y();
+                shrinkBy = std::sqrt(prevLengthSq / 2);
+            }
+        }
+
+        return Vector2(transX / shrinkBy, transY / shrinkBy);
+    }
+
+    Extrusion prepareShape(const Shape &shape, const Matrix3 *transform, const ExtrudeGeometry::Options &options, size_t bevelSegments,
+                           const std::vector<Vector3> &extrudePts, const Curve::FrenetFrames &splineTube)
+    {
+        Extrusion extrusion;
+
+        auto shapePoints = shape.extractPoints(options.curveSegments);
+
+        auto &vertices = shapePoints.shape;
+        auto &holes = shapePoints.holes;
+
+        if (transform)
+        {
+            for (auto &point : vertices)
+                point.applyMatrix3(*transform);
+            for (auto &hole : holes)
+                for (auto &point : hole)
+                    point.applyMatrix3(*transform);
+        }
+
+        ShapeUtils::removeDupEndPts(vertices);
+        for (auto &hole : holes)
+            ShapeUtils::removeDupEndPts(hole);
+
+        if (vertices.size() < 3)
+            return extrusion;
+
+        // the outline runs clockwise, the holes counterclockwise
+
+        if (!ShapeUtils::isClockWise(vertices))
+            std::reverse(vertices.begin(), vertices.end());
+
+        for (auto &hole : holes)
+            if (ShapeUtils::isClockWise(hole))
+                std::reverse(hole.begin(), hole.end());
+
+        extrusion.faces = ShapeUtils::triangulateShape(vertices, holes);
+
+        // the rings back to back, with the bevel direction of every vertex
+
+        std::vector<Vector2> points;
+        std::vector<Vector2> movements;
+
+        auto addRing = [&](const std::vector<Vector2> &ring)
+        {
+            const size_t first = points.size();
+            const size_t length = ring.size();
+
+            for (size_t i = 0; i < length; i++)
+            {
+                const size_t j = i == 0 ? length - 1 : i - 1;
+                const size_t k = i + 1 == length ? 0 : i + 1;
+
+                points.push_back(ring[i]);
+                extrusion.previous.push_back(static_cast<uint32_t>(first + j));
+
+                if (bevelSegments > 0)
+                    movements.push_back(getBevelVec(ring[i], ring[j], ring[k]));
+            }
+        };
+
+        addRing(vertices);
+        for (const auto &hole : holes)
+            addRing(hole);
+
+        const size_t vlen = points.size();
+        const size_t steps = options.steps;
+        const size_t layerCount = steps + 1 + bevelSegments * 2;
+        const bool extrudeByPath = !extrudePts.empty();
+
+        extrusion.vertexCount = vlen;
+        extrusion.layers.resize(layerCount * vlen * 3);
+
+        auto writeLayer = [&](size_t layer, HIGH_PRECISION bs, HIGH_PRECISION z)
+        {
+            double *out = extrusion.layers.data() + layer * vlen * 3;
+
+            for (size_t i = 0; i < vlen; i++)
+            {
+                HIGH_PRECISION x = points[i].x();
+                HIGH_PRECISION y = points[i].y();
+
+                if (bevelSegments > 0)
+                {
+                    x += movements[i].x() * bs;
+                    y += movements[i].y() * bs;
+                }
+
+                out[i * 3 + 0] = static_cast<double>(x);
+                out[i * 3 + 1] = static_cast<double>(y);
+                out[i * 3 + 2] = static_cast<double>(z);
+            }
+        };
+
+        auto bevelLayer = [&](size_t b, HIGH_PRECISION &bs, HIGH_PRECISION &z)
+        {
+            const HIGH_PRECISION t = static_cast<HIGH_PRECISION>(b) / static_cast<HIGH_PRECISION>(bevelSegments);
+            z = options.bevelThickness * std::cos(t * MATH_PI / 2);
+            bs = options.bevelSize * std::sin(t * MATH_PI / 2) + options.bevelOffset;
+        };
+
+        HIGH_PRECISION bs, z;
+
+        // contracted front bevel layers
+
+        for (size_t b = 0; b < bevelSegments; b++)
+        {
+            bevelLayer(b, bs, z);
+            writeLayer(b, bs, -z);
+        }
+
+        // stepped layers, along the path if there is one
+
+        bs = options.bevelSize + options.bevelOffset;
+
+        for (size_t s = 0; s <= steps; s++)
+        {
+            const size_t layer = bevelSegments + s;
+
+            if (!extrudeByPath)
+            {
+                writeLayer(layer, bs, options.depth / static_cast<HIGH_PRECISION>(steps) * static_cast<HIGH_PRECISION>(s));
+                continue;
+            }
+
+            const Vector3 &origin = extrudePts[s];
+            const Vector3 &normal = splineTube.normals[s];
+            const Vector3 &binormal = splineTube.binormals[s];
+
+            double *out = extrusion.layers.data() + layer * vlen * 3;
+
+            for (size_t i = 0; i < vlen; i++)
+            {
+                const HIGH_PRECISION x = points[i].x();
+                const HIGH_PRECISION y = points[i].y();
+
+                out[i * 3 + 0] = static_cast<double>(origin.x() + normal.x() * x + binormal.x() * y);
+                out[i * 3 + 1] = static_cast<double>(origin.y() + normal.y() * x + binormal.y() * y);
+                out[i * 3 + 2] = static_cast<double>(origin.z() + normal.z() * x + binormal.z() * y);
+            }
+        }
+
+        // expanding back bevel layers
+
+        for (size_t b = bevelSegments; b-- > 0;)
+        {
+            bevelLayer(b, bs, z);
+            writeLayer(layerCount - 1 - b, bs, options.depth + z);
+        }
+
+        return extrusion;
+    }
+
+    /**
+     * The area weighted normal of the faces of one layer.
+     */
+    void capNormal(const Extrusion &extrusion, size_t layer, bool flip, float *normal)
+    {
+        const double *p = extrusion.layers.data() + layer * extrusion.vertexCount * 3;
+        double nx = 0, ny = 0, nz = 0;
+
+        for (const auto &face : extrusion.faces)
+        {
+            const double *a = p + face[0] * 3;
+            const double *b = p + face[1] * 3;
+            const double *c = p + face[2] * 3;
+
+            const double abx = b[0] - a[0], aby = b[1] - a[1], abz = b[2] - a[2];
+            const double acx = c[0] - a[0], acy = c[1] - a[1], acz = c[2] - a[2];
+
+            nx += aby * acz - abz * acy;
+            ny += abz * acx - abx * acz;
+            nz += abx * acy - aby * acx;
+        }
+
+        const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        const double scale = (flip ? -1.0 : 1.0) / (length > 0 ? length : 1.0);
+
+        normal[0] = static_cast<float>(nx * scale);
+        normal[1] = static_cast<float>(ny * scale);
+        normal[2] = static_cast<float>(length > 0 ? nz * scale : (flip ? -1.0 : 1.0));
+    }
+
+    void writeExtrusion(const Extrusion &extrusion, const GeometryUtils::Streams &streams)
+    {
+        const size_t vlen = extrusion.vertexCount;
+        const size_t flen = extrusion.faces.size();
+
+        if (vlen == 0)
+            return;
+
+        const size_t layerCount = extrusion.layers.size() / (vlen * 3);
+        const auto offset = static_cast<uint32_t>(extrusion.vertexOffset);
+
+        float *position = streams.position + extrusion.vertexOffset * 3;
+        float *normal = streams.normal + extrusion.vertexOffset * 3;
+        float *uv = streams.uv + extrusion.vertexOffset * 2;
+        uint32_t *index = streams.index + extrusion.indexOffset;
+
+        // lids: the first layer faces backwards, the last one forwards
+
+        for (size_t lid = 0; lid < 2; lid++)
+        {
+            const size_t layer = lid == 0 ? 0 : layerCount - 1;
+            const double *p = extrusion.layers.data() + layer * vlen * 3;
+
+            float lidNormal[3];
+            capNormal(extrusion, layer, lid == 0, lidNormal);
+
+            for (size_t i = 0; i < vlen; i++)
+            {
+                position[i * 3 + 0] = static_cast<float>(p[i * 3 + 0]);
+                position[i * 3 + 1] = static_cast<float>(p[i * 3 + 1]);
+                position[i * 3 + 2] = static_cast<float>(p[i * 3 + 2]);
+
+                normal[i * 3 + 0] = lidNormal[0];
+                normal[i * 3 + 1] = lidNormal[1];
+                normal[i * 3 + 2] = lidNormal[2];
+
+                uv[i * 2 + 0] = static_cast<float>(p[i * 3 + 0]);
+                uv[i * 2 + 1] = static_cast<float>(p[i * 3 + 1]);
+            }
+
+            const uint32_t first = offset + static_cast<uint32_t>(lid * vlen);
+
+            for (const auto &face : extrusion.faces)
+            {
+                if (lid == 0)
+                {
+                    *index++ = first + face[2];
+                    *index++ = first + face[1];
+                    *index++ = first + face[0];
+                }
+                else
+                {
+                    *index++ = first + face[0];
+                    *index++ = first + face[1];
+                    *index++ = first + face[2];
+                }
+            }
+
+            position += vlen * 3;
+            normal += vlen * 3;
+            uv += vlen * 2;
+        }
+
+        // side walls, one flat quad per ring edge and layer
+
+        const size_t sideVertex = extrusion.vertexOffset + vlen * 2;
+        const size_t sideIndex = extrusion.indexOffset + flen * 6;
+
+        Parallel::parallelFor(0, layerCount - 1, GeometryUtils::rowGrain(vlen * 4), [&](size_t begin, size_t end)
+                              {
+            for (size_t s = begin; s < end; s++)
+            {
+                const double *layer1 = extrusion.layers.data() + s * vlen * 3;
+                const double *layer2 = layer1 + vlen * 3;
+
+                const size_t row = sideVertex + s * vlen * 4;
+
+                float *rowPosition = streams.position + row * 3;
+                float *rowNormal = streams.normal + row * 3;
+                float *rowUv = streams.uv + row * 2;
+                uint32_t *rowIndex = streams.index + sideIndex + s * vlen * 6;
+
+                for (size_t j = 0; j < vlen; j++)
+                {
+                    const size_t k = extrusion.previous[j];
+
+                    const double *quad[4] = {layer1 + j * 3, layer1 + k * 3, layer2 + k * 3, layer2 + j * 3};
+                    const double *a = quad[0], *b = quad[1], *c = quad[2], *d = quad[3];
+
+                    // the cross product of the diagonals, also for slightly bent quads
+                    const double acx = c[0] - a[0], acy = c[1] - a[1], acz = c[2] - a[2];
+                    const double bdx = d[0] - b[0], bdy = d[1] - b[1], bdz = d[2] - b[2];
+
+                    double nx = acy * bdz - acz * bdy;
+                    double ny = acz * bdx - acx * bdz;
+                    double nz = acx * bdy - acy * bdx;
+
+                    const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+                    if (length > 0)
+                    {
+                        nx /= length;
+                        ny /= length;
+                        nz /= length;
+                    }
+
+                    // project onto the axis the edge runs along most
+                    const bool alongX = std::abs(a[1] - b[1]) < std::abs(a[0] - b[0]);
+
+                    for (size_t v = 0; v < 4; v++)
+                    {
+                        rowPosition[v * 3 + 0] = static_cast<float>(quad[v][0]);
+                        rowPosition[v * 3 + 1] = static_cast<float>(quad[v][1]);
+                        rowPosition[v * 3 + 2] = static_cast<float>(quad[v][2]);
+
+                        rowNormal[v * 3 + 0] = static_cast<float>(nx);
+                        rowNormal[v * 3 + 1] = static_cast<float>(ny);
+                        rowNormal[v * 3 + 2] = static_cast<float>(nz);
+
+                        rowUv[v * 2 + 0] = static_cast<float>(alongX ? quad[v][0] : quad[v][1]);
+                        rowUv[v * 2 + 1] = static_cast<float>(1 - quad[v][2]);
+                    }
+
+                    const auto first = static_cast<uint32_t>(row + j * 4);
+
+                    // faces
+                    *rowIndex++ = first;
+                    *rowIndex++ = first + 1;
+                    *rowIndex++ = first + 3;
+                    *rowIndex++ = first + 1;
+                    *rowIndex++ = first + 2;
+                    *rowIndex++ = first + 3;
+
+                    rowPosition += 12;
+                    rowNormal += 12;
+                    rowUv += 8;
+                }
+            } });
+    }
+}
+
+ExtrudeGeometry::ExtrudeGeometry(const std::vector<Shape> &shapes, const Options &options, const std::vector<Matrix3> &transforms)
+    : m_options(options)
+{
+    if (!transforms.empty() && transforms.size() != shapes.size())
+        throw std::invalid_argument("ExtrudeGeometry: expected one transform per shape");
+
+    m_options.steps = std::max<size_t>(1, m_options.steps);
+
+    // extruding along a path disables beveling
+
+    std::vector<Vector3> extrudePts;
+    Curve::FrenetFrames splineTube;
+
+    if (m_options.extrudePath)
+    {
+        m_options.bevelEnabled = false;
+
+        extrudePts = m_options.extrudePath->getSpacedPoints(m_options.steps);
+        splineTube = m_options.extrudePath->computeFrenetFrames(m_options.steps, false);
+    }
+
+    const size_t bevelSegments = m_options.bevelEnabled ? m_options.bevelSegments : 0;
+
+    // sample, triangulate and bevel every shape on its own
+
+    std::vector<Extrusion> extrusions(shapes.size());
+
+    Parallel::parallelFor(0, shapes.size(), 1, [&](size_t begin, size_t end)
+                          {
+        for (size_t i = begin; i < end; i++)
+            extrusions[i] = prepareShape(shapes[i], transforms.empty() ? nullptr : &transforms[i], m_options, bevelSegments, extrudePts, splineTube); });
+
+    // two lids plus four vertices per side quad
+
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+
+    for (auto &extrusion : extrusions)
+    {
+        const size_t vlen = extrusion.vertexCount;
+        const size_t layerCount = vlen > 0 ? extrusion.layers.size() / (vlen * 3) : 0;
+        const size_t quads = vlen > 0 ? vlen * (layerCount - 1) : 0;
+
+        extrusion.vertexOffset = vertexCount;
+        extrusion.indexOffset = indexCount;
+
+        vertexCount += vlen * 2 + quads * 4;
+        indexCount += extrusion.faces.size() * 6 + quads * 6;
+    }
+
+    const auto streams = GeometryUtils::allocate(*this, vertexCount, indexCount);
+
+    Parallel::parallelFor(0, extrusions.size(), 1, [&](size_t begin, size_t end)
+                          {
+        for (size_t i = begin; i < end; i++)
+            writeExtrusion(extrusions[i], streams); });
+}
+
+ExtrudeGeometry::ExtrudeGeometry(const std::vector<Shape> &shapes)
+    : ExtrudeGeometry(shapes, Options())
+{
+}
+
+ExtrudeGeometry::ExtrudeGeometry(const Shape &shape, const Options &options)
+    : ExtrudeGeometry(std::vector<Shape>{shape}, options)
+{
+}
+
+ExtrudeGeometry::~ExtrudeGeometry()
+{
+}
+
+std::string ExtrudeGeometry::type() const
+{
+    return "ExtrudeGeometry";
+}
+
+const ExtrudeGeometry::Options &ExtrudeGeometry::options() const
+{
+    return m_options;
+}
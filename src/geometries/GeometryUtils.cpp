@@ -0,0 +1,41 @@
+#include "geometries/GeometryUtils.h"
+#include <algorithm>
+#include <cmath>
+
+// vertices per task when filling rows in parallel
+static constexpr size_t VERTEX_GRAIN = 1 << 14;
+
+namespace GeometryUtils
+{
+    Streams allocate(BufferGeometry &geometry, size_t vertexCount, size_t indexCount)
+    {
+        auto position = std::make_shared<BufferAttribute>(vertexCount, 3);
+        auto normal = std::make_shared<BufferAttribute>(vertexCount, 3);
+        auto uv = std::make_shared<BufferAttribute>(vertexCount, 2);
+
+        geometry.setAttribute("position", position);
+        geometry.setAttribute("normal", normal);
+        geometry.setAttribute("uv", uv);
+        geometry.setIndex(std::vector<uint32_t>(indexCount));
+
+        return {position->array(), normal->array(), uv->array(), geometry.getIndex().data()};
+    }
+
+    void sinCosTable(double start, double length, size_t segments, std::vector<float> &sines, std::vector<float> &cosines)
+    {
+        sines.resize(segments + 1);
+        cosines.resize(segments + 1);
+
+        for (size_t i = 0; i <= segments; i++)
+        {
+            const double angle = start + length * static_cast<double>(i) / static_cast<double>(segments);
+            sines[i] = static_cast<float>(std::sin(angle));
+            cosines[i] = static_cast<float>(std::cos(angle));
+        }
+    }
+
+    size_t rowGrain(size_t verticesPerRow)
+    {
+        return std::max<size_t>(1, VERTEX_GRAIN / std::max<size_t>(1, verticesPerRow));
+    }
+}
@@ -0,0 +1,87 @@
+#include "geometries/PlaneGeometry.h"
+#include "geometries/GeometryUtils.h"
+#include "common/Parallel.h"
+#include <algorithm>
+
+PlaneGeometry::PlaneGeometry(float width, float height, size_t widthSegments, size_t heightSegments)
+    : m_parameters{width, height, std::max<size_t>(1, widthSegments), std::max<size_t>(1, heightSegments)}
+{
+    const size_t gridX = m_parameters.widthSegments;
+    const size_t gridY = m_parameters.heightSegments;
+    const size_t gridX1 = gridX + 1;
+    const size_t gridY1 = gridY + 1;
+
+    const float widthHalf = width / 2;
+    const float heightHalf = height / 2;
+    const float segmentWidth = width / static_cast<float>(gridX);
+    const float segmentHeight = height / static_cast<float>(gridY);
+
+    const auto streams = GeometryUtils::allocate(*this, gridX1 * gridY1, gridX * gridY * 6);
+
+    // vertices, normals and uvs
+
+    Parallel::parallelFor(0, gridY1, GeometryUtils::rowGrain(gridX1), [&](size_t begin, size_t end)
+                          {
+        for (size_t iy = begin; iy < end; iy++)
+        {
+            const float y = static_cast<float>(iy) * segmentHeight - heightHalf;
+            const float v = 1 - static_cast<float>(iy) / static_cast<float>(gridY);
+
+            float *position = streams.position + iy * gridX1 * 3;
+            float *normal = streams.normal + iy * gridX1 * 3;
+            float *uv = streams.uv + iy * gridX1 * 2;
+
+            for (size_t ix = 0; ix < gridX1; ix++)
+            {
+                position[ix * 3 + 0] = static_cast<float>(ix) * segmentWidth - widthHalf;
+                position[ix * 3 + 1] = -y;
+                position[ix * 3 + 2] = 0;
+
+                normal[ix * 3 + 0] = 0;
+                normal[ix * 3 + 1] = 0;
+                normal[ix * 3 + 2] = 1;
+
+                uv[ix * 2 + 0] = static_cast<float>(ix) / static_cast<float>(gridX);
+                uv[ix * 2 + 1] = v;
+            }
+        } });
+
+    // indices
+
+    Parallel::parallelFor(0, gridY, GeometryUtils::rowGrain(gridX * 6), [&](size_t begin, size_t end)
+                          {
+        for (size_t iy = begin; iy < end; iy++)
+        {
+            uint32_t *index = streams.index + iy * gridX * 6;
+
+            for (size_t ix = 0; ix < gridX; ix++)
+            {
+                const auto a = static_cast<uint32_t>(ix + gridX1 * iy);
+                const auto b = static_cast<uint32_t>(ix + gridX1 * (iy + 1));
+                const auto c = static_cast<uint32_t>((ix + 1) + gridX1 * (iy + 1));
+                const auto d = static_cast<uint32_t>((ix + 1) + gridX1 * iy);
+
+                // faces
+                *index++ = a;
+                *index++ = b;
+                *index++ = d;
+                *index++ = b;
+                *index++ = c;
+                *index++ = d;
+            }
+        } });
+}
+
+PlaneGeometry::~PlaneGeometry()
+{
+}
+
+std::string PlaneGeometry::type() const
+{
+    return "PlaneGeometry";
+}
+
+const PlaneGeometry::Parameters &PlaneGeometry::parameters() const
+{
+    return m_parameters;
+}
@@ -0,0 +1,118 @@
+#include "geometries/SphereGeometry.h"
+#include "geometries/GeometryUtils.h"
+#include "common/Parallel.h"
+#include <algorithm>
+
+SphereGeometry::SphereGeometry(float radius, size_t widthSegments, size_t heightSegments,
+                               float phiStart, float phiLength, float thetaStart, float thetaLength)
+    : m_parameters{radius, std::max<size_t>(3, widthSegments), std::max<size_t>(2, heightSegments), phiStart, phiLength, thetaStart, thetaLength}
+{
+    const size_t ws = m_parameters.widthSegments;
+    const size_t hs = m_parameters.heightSegments;
+    const size_t ws1 = ws + 1;
+
+    const double thetaEnd = std::min<double>(thetaStart + thetaLength, MATH_PI);
+
+    // the poles collapse one triangle of each quad next to them
+    const bool topCap = thetaStart > 0;
+    const bool bottomCap = thetaEnd < MATH_PI;
+
+    std::vector<size_t> rowIndexOffsets(hs + 1, 0);
+    for (size_t iy = 0; iy < hs; iy++)
+    {
+        const size_t triangles = (iy != 0 || topCap ? 1 : 0) + (iy != hs - 1 || bottomCap ? 1 : 0);
+        rowIndexOffsets[iy + 1] = rowIndexOffsets[iy] + ws * triangles * 3;
+    }
+
+    const auto streams = GeometryUtils::allocate(*this, ws1 * (hs + 1), rowIndexOffsets.back());
+
+    std::vector<float> sinPhi, cosPhi, sinTheta, cosTheta;
+    GeometryUtils::sinCosTable(phiStart, phiLength, ws, sinPhi, cosPhi);
+    GeometryUtils::sinCosTable(thetaStart, thetaLength, hs, sinTheta, cosTheta);
+
+    // generate vertices, normals and uvs
+
+    Parallel::parallelFor(0, hs + 1, GeometryUtils::rowGrain(ws1), [&](size_t begin, size_t end)
+                          {
+        for (size_t iy = begin; iy < end; iy++)
+        {
+            const float v = static_cast<float>(iy) / static_cast<float>(hs);
+
+            // special case for the poles
+            float uOffset = 0;
+            if (iy == 0 && thetaStart == 0)
+                uOffset = 0.5f / static_cast<float>(ws);
+            else if (iy == hs && thetaEnd == MATH_PI)
+                uOffset = -0.5f / static_cast<float>(ws);
+
+            float *position = streams.position + iy * ws1 * 3;
+            float *normal = streams.normal + iy * ws1 * 3;
+            float *uv = streams.uv + iy * ws1 * 2;
+
+            for (size_t ix = 0; ix <= ws; ix++)
+            {
+                // the unit direction doubles as the normal
+                const float nx = -cosPhi[ix] * sinTheta[iy];
+                const float ny = cosTheta[iy];
+                const float nz = sinPhi[ix] * sinTheta[iy];
+
+                position[ix * 3 + 0] = radius * nx;
+                position[ix * 3 + 1] = radius * ny;
+                position[ix * 3 + 2] = radius * nz;
+
+                normal[ix * 3 + 0] = nx;
+                normal[ix * 3 + 1] = ny;
+                normal[ix * 3 + 2] = nz;
+
+                uv[ix * 2 + 0] = static_cast<float>(ix) / static_cast<float>(ws) + uOffset;
+                uv[ix * 2 + 1] = 1 - v;
+            }
+        } });
+
+    // indices
+
+    Parallel::parallelFor(0, hs, GeometryUtils::rowGrain(ws * 6), [&](size_t begin, size_t end)
+                          {
+        for (size_t iy = begin; iy < end; iy++)
+        {
+            uint32_t *index = streams.index + rowIndexOffsets[iy];
+            const bool first = iy != 0 || topCap;
+            const bool second = iy != hs - 1 || bottomCap;
+
+            for (size_t ix = 0; ix < ws; ix++)
+            {
+                const auto a = static_cast<uint32_t>(iy * ws1 + ix + 1);
+                const auto b = static_cast<uint32_t>(iy * ws1 + ix);
+                const auto c = static_cast<uint32_t>((iy + 1) * ws1 + ix);
+                const auto d = static_cast<uint32_t>((iy + 1) * ws1 + ix + 1);
+
+                if (first)
+                {
+                    *index++ = a;
+                    *index++ = b;
+                    *index++ = d;
+                }
+
+                if (second)
+                {
+                    *index++ = b;
+                    *index++ = c;
+                    *index++ = d;
+                }
+            }
+        } });
+}
+
+SphereGeometry::~SphereGeometry()
+{
+}
+
+std::string SphereGeometry::type() const
+{
+    return "SphereGeometry";
+}
+
+const SphereGeometry::Parameters &SphereGeometry::parameters() const
+{
+    return m_parameters;
+}
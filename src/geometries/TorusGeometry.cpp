@@ -0,0 +1,87 @@
+#include "geometries/TorusGeometry.h"
+#include "geometries/GeometryUtils.h"
+#include "common/Parallel.h"
+#include <algorithm>
+
+TorusGeometry::TorusGeometry(float radius, float tube, size_t radialSegments, size_t tubularSegments, float arc)
+    : m_parameters{radius, tube, std::max<size_t>(1, radialSegments), std::max<size_t>(1, tubularSegments), arc}
+{
+    const size_t rs = m_parameters.radialSegments;
+    const size_t ts = m_parameters.tubularSegments;
+    const size_t ts1 = ts + 1;
+
+    const auto streams = GeometryUtils::allocate(*this, (rs + 1) * ts1, rs * ts * 6);
+
+    std::vector<float> sinU, cosU, sinV, cosV;
+    GeometryUtils::sinCosTable(0, arc, ts, sinU, cosU);
+    GeometryUtils::sinCosTable(0, MATH_PI * 2, rs, sinV, cosV);
+
+    // generate vertices, normals and uvs
+
+    Parallel::parallelFor(0, rs + 1, GeometryUtils::rowGrain(ts1), [&](size_t begin, size_t end)
+                          {
+        for (size_t j = begin; j < end; j++)
+        {
+            const float ring = radius + tube * cosV[j];
+            const float uvY = static_cast<float>(j) / static_cast<float>(rs);
+
+            float *position = streams.position + j * ts1 * 3;
+            float *normal = streams.normal + j * ts1 * 3;
+            float *uv = streams.uv + j * ts1 * 2;
+
+            for (size_t i = 0; i <= ts; i++)
+            {
+                position[i * 3 + 0] = ring * cosU[i];
+                position[i * 3 + 1] = ring * sinU[i];
+                position[i * 3 + 2] = tube * sinV[j];
+
+                // the vertex minus the tube center, normalized
+                normal[i * 3 + 0] = cosV[j] * cosU[i];
+                normal[i * 3 + 1] = cosV[j] * sinU[i];
+                normal[i * 3 + 2] = sinV[j];
+
+                uv[i * 2 + 0] = static_cast<float>(i) / static_cast<float>(ts);
+                uv[i * 2 + 1] = uvY;
+            }
+        } });
+
+    // generate indices
+
+    Parallel::parallelFor(1, rs + 1, GeometryUtils::rowGrain(ts * 6), [&](size_t begin, size_t end)
+                          {
+        for (size_t j = begin; j < end; j++)
+        {
+            uint32_t *index = streams.index + (j - 1) * ts * 6;
+
+            for (size_t i = 1; i <= ts; i++)
+            {
+                // indices
+                const auto a = static_cast<uint32_t>(ts1 * j + i - 1);
+                const auto b = static_cast<uint32_t>(ts1 * (j - 1) + i - 1);
+                const auto c = static_cast<uint32_t>(ts1 * (j - 1) + i);
+                const auto d = static_cast<uint32_t>(ts1 * j + i);
+
+                // faces
+                *index++ = a;
+                *index++ = b;
+                *index++ = d;
+                *index++ = b;
+                *index++ = c;
+                *index++ = d;
+            }
+        } });
+}
+
+TorusGeometry::~TorusGeometry()
+{
+}
+
+std::string TorusGeometry::type() const
+{
+    return "TorusGeometry";
+}
+
+const TorusGeometry::Parameters &TorusGeometry::parameters() const
+{
+    return m_parameters;
+}
@@ -0,0 +1,1180 @@
+#include "loaders/GLTFLoader.h"
+#include "animation/tracks/NumberKeyframeTrack.h"
+#include "animation/tracks/QuaternionKeyframeTrack.h"
+#include "animation/tracks/VectorKeyframeTrack.h"
+#include "common/JSON.h"
+#include "common/MappedFile.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include "math/MathUtils.h"
+#include "objects/Bone.h"
+#include "objects/SkinnedMesh.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+// accessor items per decode task; large accessors are split across threads
+static constexpr size_t ITEM_GRAIN = 1 << 16;
+
+static constexpr uint32_t GLB_MAGIC = 0x46546C67; // "glTF"
+static constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+static constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+static constexpr int MODE_TRIANGLES = 4;
+static constexpr int MODE_TRIANGLE_STRIP = 5;
+static constexpr int MODE_TRIANGLE_FAN = 6;
+
+using ComponentType = GLTFLoader::ComponentType;
+using AccessorView = GLTFLoader::AccessorView;
+
+static size_t componentSize(ComponentType type)
+{
+    switch (type)
+    {
+    case ComponentType::Int8:
+    case ComponentType::UInt8:
+        return 1;
+    case ComponentType::Int16:
+    case ComponentType::UInt16:
+        return 2;
+    case ComponentType::UInt32:
+    case ComponentType::Float32:
+        return 4;
+    }
+
+    throw std::runtime_error("GLTFLoader: unknown component type");
+}
+
+static size_t typeItemSize(const std::string &type)
+{
+    if (type == "SCALAR")
+        return 1;
+    if (type == "VEC2")
+        return 2;
+    if (type == "VEC3")
+        return 3;
+    if (type == "VEC4" || type == "MAT2")
+        return 4;
+    if (type == "MAT3")
+        return 9;
+    if (type == "MAT4")
+        return 16;
+
+    throw std::runtime_error("GLTFLoader: unknown accessor type " + type);
+}
+
+// a byte offset, length or count; negative values would wrap when cast
+static size_t sizeValue(const JSON::Value &value, const char *name, long long fallback = 0)
+{
+    const long long result = value.asInt(fallback);
+    if (result < 0)
+        throw std::runtime_error(std::string("GLTFLoader: negative ") + name);
+    return static_cast<size_t>(result);
+}
+
+// MathUtils::denormalize over every value of an 8 or 16 bit type, built once
+template <typename T>
+static const float *denormalizeTable()
+{
+    static const std::vector<float> table = []()
+    {
+        using Bits = std::make_unsigned_t<T>;
+        std::vector<float> values(size_t(1) << (8 * sizeof(T)));
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = static_cast<float>(MathUtils::denormalize<T>(static_cast<T>(static_cast<Bits>(i))));
+        return values;
+    }();
+
+    return table.data();
+}
+
+template <typename T>
+static inline float convert(T value, bool normalized)
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return value;
+    else if constexpr (sizeof(T) <= 2)
+        return normalized ? denormalizeTable<T>()[static_cast<std::make_unsigned_t<T>>(value)] : static_cast<float>(value);
+    else
+        return normalized ? static_cast<float>(MathUtils::denormalize<T>(value)) : static_cast<float>(value);
+}
+
+template <typename T>
+static void readItems(const AccessorView &view, float *target, size_t begin, size_t end)
+{
+    const size_t itemSize = view.itemSize;
+    const char *src = view.data + begin * view.byteStride;
+
+    if constexpr (std::is_same_v<T, float> && std::endian::native == std::endian::little)
+    {
+        // tightly packed floats are copied as they are
+        if (view.byteStride == itemSize * sizeof(float))
+        {
+            std::memcpy(target, src, (end - begin) * itemSize * sizeof(float));
+            return;
+        }
+    }
+
+    for (size_t i = begin; i < end; i++, src += view.byteStride)
+    {
+        for (size_t k = 0; k < itemSize; k++)
+            *target++ = convert(LoaderUtils::readValue<T>(src + k * sizeof(T)), view.normalized);
+    }
+}
+
+template <typename T>
+static void readIntegers(const AccessorView &view, uint32_t *target, size_t begin, size_t end)
+{
+    const char *src = view.data + begin * view.byteStride;
+
+    for (size_t i = begin; i < end; i++, src += view.byteStride)
+    {
+        for (size_t k = 0; k < view.itemSize; k++)
+            *target++ = static_cast<uint32_t>(LoaderUtils::readValue<T>(src + k * sizeof(T)));
+    }
+}
+
+float AccessorView::get(size_t index, size_t component) const
+{
+    const char *src = data + index * byteStride + component * componentSize(componentType);
+
+    switch (componentType)
+    {
+    case ComponentType::Int8:
+        return convert(LoaderUtils::readValue<int8_t>(src), normalized);
+    case ComponentType::UInt8:
+        return convert(LoaderUtils::readValue<uint8_t>(src), normalized);
+    case ComponentType::Int16:
+        return convert(LoaderUtils::readValue<int16_t>(src), normalized);
+    case ComponentType::UInt16:
+        return convert(LoaderUtils::readValue<uint16_t>(src), normalized);
+    case ComponentType::UInt32:
+        return convert(LoaderUtils::readValue<uint32_t>(src), normalized);
+    case ComponentType::Float32:
+        return LoaderUtils::readValue<float>(src);
+    }
+
+    return 0;
+}
+
+void AccessorView::read(float *target, size_t begin, size_t end) const
+{
+    switch (componentType)
+    {
+    case ComponentType::Int8:
+        return readItems<int8_t>(*this, target, begin, end);
+    case ComponentType::UInt8:
+        return readItems<uint8_t>(*this, target, begin, end);
+    case ComponentType::Int16:
+        return readItems<int16_t>(*this, target, begin, end);
+    case ComponentType::UInt16:
+        return readItems<uint16_t>(*this, target, begin, end);
+    case ComponentType::UInt32:
+        return readItems<uint32_t>(*this, target, begin, end);
+    case ComponentType::Float32:
+        return readItems<float>(*this, target, begin, end);
+    }
+}
+
+void AccessorView::read(uint32_t *target, size_t begin, size_t end) const
+{
+    switch (componentType)
+    {
+    case ComponentType::UInt8:
+        return readIntegers<uint8_t>(*this, target, begin, end);
+    case ComponentType::UInt16:
+        return readIntegers<uint16_t>(*this, target, begin, end);
+    case ComponentType::UInt32:
+        return readIntegers<uint32_t>(*this, target, begin, end);
+    default:
+        throw std::runtime_error("GLTFLoader: invalid index component type");
+    }
+}
+
+static std::vector<char> decodeBase64(std::string_view text)
+{
+    static const auto table = []()
+    {
+        std::array<int8_t, 256> values;
+        values.fill(-1);
+        const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; i++)
+            values[static_cast<uint8_t>(alphabet[i])] = static_cast<int8_t>(i);
+        return values;
+    }();
+
+    std::vector<char> bytes;
+    bytes.reserve(text.size() / 4 * 3);
+
+    uint32_t accumulator = 0;
+    int bits = 0;
+
+    for (char c : text)
+    {
+        const int8_t value = table[static_cast<uint8_t>(c)];
+        if (value < 0)
+        {
+            if (c == '=')
+                break;
+            continue;
+        }
+
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+
+        if (bits >= 8)
+        {
+            bits -= 8;
+            bytes.push_back(static_cast<char>((accumulator >> bits) & 0xFF));
+        }
+    }
+
+    return bytes;
+}
+
+static std::string decodeURI(const std::string &uri)
+{
+    std::string out;
+    out.reserve(uri.size());
+
+    for (size_t i = 0; i < uri.size(); i++)
+    {
+        if (uri[i] == '%' && i + 2 < uri.size())
+        {
+            unsigned value = 0;
+            const auto result = std::from_chars(uri.data() + i + 1, uri.data() + i + 3, value, 16);
+            if (result.ec == std::errc() && result.ptr == uri.data() + i + 3)
+            {
+                out += static_cast<char>(value);
+                i += 2;
+                continue;
+            }
+        }
+
+        out += uri[i];
+    }
+
+    return out;
+}
+
+// same rules as three.js PropertyBinding.sanitizeNodeName, so track names
+// like "Arm.L.quaternion" still split at the right dot
+static std::string sanitizeNodeName(const std::string &name)
+{
+    std::string out;
+    out.reserve(name.size());
+
+    for (char c : name)
+    {
+        if (c == ' ' || c == '\t' || c == '\n')
+            out += '_';
+        else if (c != '[' && c != ']' && c != '.' && c != ':' && c != '/')
+            out += c;
+    }
+
+    return out;
+}
+
+namespace
+{
+    struct DecodeJob
+    {
+        AccessorView view;
+        float *floats;
+        uint32_t *integers;
+        size_t begin;
+        size_t end;
+    };
+
+    struct SparseJob
+    {
+        size_t accessor;
+        float *floats;
+        uint32_t *integers;
+    };
+
+    struct MorphPlan
+    {
+        std::string name;
+        // dense deltas, decoded with the other accessors
+        std::shared_ptr<BufferAttribute> position;
+        std::shared_ptr<BufferAttribute> normal;
+        // set when the target was built straight from a sparse accessor
+        bool sparse = false;
+    };
+
+    struct PrimitivePlan
+    {
+        std::shared_ptr<BufferGeometry> geometry;
+        std::vector<uint32_t> index;
+        bool indexed = false;
+        int mode = MODE_TRIANGLES;
+        std::vector<MorphPlan> targets;
+        // largest JOINTS_0 value, checked against the skin of every node using the mesh
+        float maxJoint = 0;
+    };
+
+    class Parser
+    {
+    public:
+        Parser(const JSON::Value &json, std::vector<std::span<const char>> buffers)
+            : m_json(json), m_buffers(std::move(buffers))
+        {
+        }
+
+        GLTF parse()
+        {
+            const auto &meshes = m_json["meshes"];
+            m_meshes.resize(meshes.size());
+
+            for (size_t m = 0; m < meshes.size(); m++)
+            {
+                for (auto &primitive : meshes[m]["primitives"].elements())
+                {
+                    if (auto plan = planPrimitive(meshes[m], primitive))
+                        m_meshes[m].push_back(std::move(*plan));
+                }
+            }
+
+            runJobs();
+            finishPrimitives();
+
+            GLTF gltf;
+            buildNodes(gltf);
+            buildSkins(gltf);
+            buildScenes(gltf);
+            buildAnimations(gltf);
+
+            return gltf;
+        }
+
+        size_t outputBytes() const
+        {
+            size_t bytes = 0;
+            std::unordered_set<const BufferGeometry *> seen;
+
+            for (auto &mesh : m_meshes)
+            {
+                for (auto &primitive : mesh)
+                {
+                    if (!seen.insert(primitive.geometry.get()).second)
+                        continue;
+
+                    for (auto &[name, attribute] : primitive.geometry->attributes())
+                        bytes += attribute->span().size_bytes();
+                    bytes += primitive.geometry->getIndex().size() * sizeof(uint32_t);
+                }
+            }
+
+            return bytes;
+        }
+
+    private:
+        const JSON::Value &m_json;
+        std::vector<std::span<const char>> m_buffers;
+
+        std::vector<std::vector<PrimitivePlan>> m_meshes;
+        std::vector<DecodeJob> m_jobs;
+        std::vector<SparseJob> m_sparseJobs;
+
+        std::vector<bool> m_isJoint;
+        std::unordered_set<std::string> m_names;
+
+        const JSON::Value &accessor(size_t index) const
+        {
+            const auto &value = m_json["accessors"][index];
+            if (!value.isObject())
+                throw std::runtime_error("GLTFLoader: invalid accessor " + std::to_string(index));
+            return value;
+        }
+
+        size_t accessorCount(size_t index) const
+        {
+            return sizeValue(accessor(index)["count"], "count");
+        }
+
+        size_t accessorItemSize(size_t index) const
+        {
+            return typeItemSize(accessor(index)["type"].asString());
+        }
+
+        // a view of `count` items of the given layout inside a buffer view,
+        // bounds-checked so decoding itself cannot fail
+        AccessorView makeView(size_t bufferViewIndex, size_t byteOffset, size_t count, size_t itemSize, ComponentType componentType, bool normalized) const
+        {
+            const auto &bufferView = m_json["bufferViews"][bufferViewIndex];
+            if (!bufferView.isObject())
+                throw std::runtime_error("GLTFLoader: invalid buffer view " + std::to_string(bufferViewIndex));
+
+            const size_t bufferIndex = static_cast<size_t>(bufferView["buffer"].asInt());
+            if (bufferIndex >= m_buffers.size())
+                throw std::runtime_error("GLTFLoader: invalid buffer " + std::to_string(bufferIndex));
+
+            const auto buffer = m_buffers[bufferIndex];
+            const size_t viewOffset = sizeValue(bufferView["byteOffset"], "byteOffset");
+            const size_t viewLength = sizeValue(bufferView["byteLength"], "byteLength");
+
+            if (viewOffset > buffer.size() || viewLength > buffer.size() - viewOffset)
+                throw std::runtime_error("GLTFLoader: buffer view exceeds its buffer");
+
+            AccessorView view;
+            view.count = count;
+            view.itemSize = itemSize;
+            view.componentType = componentType;
+            view.normalized = normalized;
+
+            const size_t elementSize = itemSize * componentSize(componentType);
+            view.byteStride = sizeValue(bufferView["byteStride"], "byteStride", static_cast<long long>(elementSize));
+
+            if (view.byteStride < elementSize)
+                throw std::runtime_error("GLTFLoader: byte stride smaller than the element");
+
+            // in this order, so none of the terms can wrap
+            if (count > 0 && (byteOffset > viewLength || elementSize > viewLength - byteOffset ||
+                              count - 1 > (viewLength - byteOffset - elementSize) / view.byteStride))
+                throw std::runtime_error("GLTFLoader: accessor exceeds its buffer view");
+
+            view.data = buffer.data() + viewOffset + byteOffset;
+            return view;
+        }
+
+        AccessorView accessorView(size_t index) const
+        {
+            const auto &value = accessor(index);
+
+            const size_t count = sizeValue(value["count"], "count");
+            const size_t itemSize = typeItemSize(value["type"].asString());
+            const auto componentType = static_cast<ComponentType>(value["componentType"].asInt());
+            componentSize(componentType);
+
+            // no buffer view: all zeros, possibly with sparse values on top
+            if (!value.contains("bufferView"))
+            {
+                AccessorView view;
+                view.count = count;
+                view.itemSize = itemSize;
+                view.componentType = componentType;
+                return view;
+            }
+
+            return makeView(static_cast<size_t>(value["bufferView"].asInt()), sizeValue(value["byteOffset"], "byteOffset"),
+                            count, itemSize, componentType, value["normalized"].asBool());
+        }
+
+        // sparse index and value views of an accessor
+        std::pair<AccessorView, AccessorView> sparseViews(size_t index) const
+        {
+            const auto &value = accessor(index);
+            const auto &sparse = value["sparse"];
+
+            const size_t count = sizeValue(sparse["count"], "count");
+            const auto &indices = sparse["indices"];
+            const auto &values = sparse["values"];
+
+            const AccessorView indexView = makeView(static_cast<size_t>(indices["bufferView"].asInt()), sizeValue(indices["byteOffset"], "byteOffset"),
+                                                    count, 1, static_cast<ComponentType>(indices["componentType"].asInt()), false);
+            AccessorView valueView = makeView(static_cast<size_t>(values["bufferView"].asInt()), sizeValue(values["byteOffset"], "byteOffset"),
+                                              count, typeItemSize(value["type"].asString()), static_cast<ComponentType>(value["componentType"].asInt()),
+                                              value["normalized"].asBool());
+            // sparse values are always tightly packed
+            valueView.byteStride = valueView.itemSize * componentSize(valueView.componentType);
+
+            return {indexView, valueView};
+        }
+
+        template <typename Target>
+        void schedule(size_t index, Target *target)
+        {
+            const AccessorView view = accessorView(index);
+
+            if (view.data != nullptr)
+            {
+                for (size_t begin = 0; begin < view.count; begin += ITEM_GRAIN)
+                {
+                    DecodeJob job{view, nullptr, nullptr, begin, std::min(view.count, begin + ITEM_GRAIN)};
+
+                    if constexpr (std::is_same_v<Target, float>)
+                        job.floats = target + begin * view.itemSize;
+                    else
+                        job.integers = target + begin * view.itemSize;
+
+                    m_jobs.push_back(job);
+                }
+            }
+
+            if (accessor(index).contains("sparse"))
+            {
+                sparseViews(index);
+
+                if constexpr (std::is_same_v<Target, float>)
+                    m_sparseJobs.push_back({index, target, nullptr});
+                else
+                    m_sparseJobs.push_back({index, nullptr, target});
+            }
+        }
+
+        // runs all scheduled conversions in parallel, then applies sparse substitutions
+        void runJobs()
+        {
+            Parallel::parallelFor(0, m_jobs.size(), 1, [this](size_t begin, size_t end)
+                                  {
+                for (size_t j = begin; j < end; j++)
+                {
+                    const auto &job = m_jobs[j];
+                    if (job.floats != nullptr)
+                        job.view.read(job.floats, job.begin, job.end);
+                    else
+                        job.view.read(job.integers, job.begin, job.end);
+                } });
+
+            for (auto &job : m_sparseJobs)
+            {
+                const auto [indices, values] = sparseViews(job.accessor);
+                const size_t count = accessorCount(job.accessor);
+
+                std::vector<uint32_t> targets(indices.count);
+                indices.read(targets.data(), 0, indices.count);
+
+                for (size_t i = 0; i < targets.size(); i++)
+                {
+                    if (targets[i] >= count)
+                        throw std::runtime_error("GLTFLoader: sparse index out of range");
+
+                    if (job.floats != nullptr)
+                        values.read(job.floats + targets[i] * values.itemSize, i, i + 1);
+                    else
+                        values.read(job.integers + targets[i] * values.itemSize, i, i + 1);
+                }
+            }
+
+            m_jobs.clear();
+            m_sparseJobs.clear();
+        }
+
+        static std::string attributeName(const std::string &semantic)
+        {
+            static const std::unordered_map<std::string, std::string> names = {
+                {"POSITION", "position"},
+                {"NORMAL", "normal"},
+                {"TANGENT", "tangent"},
+                {"TEXCOORD_0", "uv"},
+                {"TEXCOORD_1", "uv1"},
+                {"TEXCOORD_2", "uv2"},
+                {"TEXCOORD_3", "uv3"},
+                {"COLOR_0", "color"},
+                {"WEIGHTS_0", "skinWeight"},
+                {"JOINTS_0", "skinIndex"},
+            };
+
+            auto it = names.find(semantic);
+            if (it != names.end())
+                return it->second;
+
+            std::string lower = semantic;
+            std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            return lower;
+        }
+
+        std::optional<PrimitivePlan> planPrimitive(const JSON::Value &mesh, const JSON::Value &primitive)
+        {
+            PrimitivePlan plan;
+            plan.mode = static_cast<int>(primitive["mode"].asInt(MODE_TRIANGLES));
+
+            // points and lines have no counterpart here
+            if (plan.mode != MODE_TRIANGLES && plan.mode != MODE_TRIANGLE_STRIP && plan.mode != MODE_TRIANGLE_FAN)
+                return std::nullopt;
+
+            plan.geometry = std::make_shared<BufferGeometry>();
+
+            for (auto &[semantic, index] : primitive["attributes"].members())
+            {
+                const size_t accessorIndex = static_cast<size_t>(index.asInt());
+                auto attribute = std::make_shared<BufferAttribute>(accessorCount(accessorIndex), accessorItemSize(accessorIndex));
+                schedule(accessorIndex, attribute->array());
+                plan.geometry->setAttribute(attributeName(semantic), attribute);
+            }
+
+            if (!plan.geometry->getAttribute("position"))
+                throw std::runtime_error("GLTFLoader: primitive without POSITION");
+
+            if (primitive.contains("indices"))
+            {
+                const size_t accessorIndex = static_cast<size_t>(primitive["indices"].asInt());
+                plan.index.resize(accessorCount(accessorIndex));
+                plan.indexed = true;
+                schedule(accessorIndex, plan.index.data());
+            }
+
+            const auto &targetNames = mesh["extras"]["targetNames"];
+            const size_t vertexCount = plan.geometry->getAttribute("position")->count();
+
+            for (size_t t = 0; t < primitive["targets"].size(); t++)
+            {
+                const auto &target = primitive["targets"][t];
+
+                MorphPlan morph;
+                morph.name = targetNames[t].isString() ? targetNames[t].asString() : std::to_string(t);
+
+                if (target.contains("POSITION"))
+                {
+                    const size_t accessorIndex = static_cast<size_t>(target["POSITION"].asInt());
+                    const auto &value = accessor(accessorIndex);
+
+                    // a sparse target without base data is already in MorphTarget form
+                    if (!value.contains("bufferView") && value.contains("sparse") && !target.contains("NORMAL"))
+                    {
+                        addSparseTarget(plan, morph.name, accessorIndex);
+                        morph.sparse = true;
+                        plan.targets.push_back(std::move(morph));
+                        continue;
+                    }
+
+                    morph.position = std::make_shared<BufferAttribute>(vertexCount, 3);
+                    schedule(accessorIndex, morph.position->array());
+                }
+                else
+                {
+                    morph.position = std::make_shared<BufferAttribute>(vertexCount, 3);
+                }
+
+                if (target.contains("NORMAL"))
+                {
+                    morph.normal = std::make_shared<BufferAttribute>(vertexCount, 3);
+                    schedule(static_cast<size_t>(target["NORMAL"].asInt()), morph.normal->array());
+                }
+
+                plan.targets.push_back(std::move(morph));
+            }
+
+            return plan;
+        }
+
+        void addSparseTarget(PrimitivePlan &plan, const std::string &name, size_t accessorIndex)
+        {
+            const auto [indices, values] = sparseViews(accessorIndex);
+            const size_t vertexCount = plan.geometry->getAttribute("position")->count();
+
+            std::vector<uint32_t> targetIndices(indices.count);
+            std::vector<float> deltas(values.count * 3);
+
+            indices.read(targetIndices.data(), 0, indices.count);
+            values.read(deltas.data(), 0, values.count);
+
+            if (!targetIndices.empty() && targetIndices.back() >= vertexCount)
+                throw std::runtime_error("GLTFLoader: sparse index out of range");
+
+            // MorphTarget validates the ascending order glTF already requires
+            plan.geometry->addMorphTarget(MorphTarget(name, std::move(targetIndices), std::move(deltas)));
+        }
+
+        void finishPrimitives()
+        {
+            for (auto &mesh : m_meshes)
+            {
+                for (auto &plan : mesh)
+                {
+                    const size_t vertexCount = plan.geometry->getAttribute("position")->count();
+
+                    if (!plan.indexed && plan.mode != MODE_TRIANGLES)
+                    {
+                        plan.index.resize(vertexCount);
+                        for (size_t i = 0; i < vertexCount; i++)
+                            plan.index[i] = static_cast<uint32_t>(i);
+                    }
+
+                    for (uint32_t i : plan.index)
+                    {
+                        if (i >= vertexCount)
+                            throw std::runtime_error("GLTFLoader: index out of range");
+                    }
+
+                    if (auto skinIndex = plan.geometry->getAttribute("skinIndex"))
+                    {
+                        auto skinWeight = plan.geometry->getAttribute("skinWeight");
+                        if (skinIndex->itemSize() != 4 || !skinWeight || skinWeight->itemSize() != 4 || skinWeight->count() != skinIndex->count())
+                            throw std::runtime_error("GLTFLoader: JOINTS_0 and WEIGHTS_0 must be matching VEC4 accessors");
+
+                        const float *joints = skinIndex->array();
+                        for (size_t i = 0; i < skinIndex->count() * 4; i++)
+                        {
+                            if (!(joints[i] >= 0))
+                                throw std::runtime_error("GLTFLoader: invalid joint index");
+                            plan.maxJoint = std::max(plan.maxJoint, joints[i]);
+                        }
+                    }
+
+                    if (plan.mode == MODE_TRIANGLE_STRIP || plan.mode == MODE_TRIANGLE_FAN)
+                        plan.index = triangulate(plan.index, plan.mode);
+
+                    if (!plan.index.empty())
+                        plan.geometry->setIndex(std::move(plan.index));
+
+                    // dense targets, in order with the sparse ones already added
+                    std::vector<MorphTarget> sparse = std::move(plan.geometry->morphTargets());
+                    plan.geometry->morphTargets().clear();
+
+                    auto basePosition = plan.geometry->getAttribute("position");
+                    auto baseNormal = plan.geometry->getAttribute("normal");
+                    size_t nextSparse = 0;
+
+                    for (auto &morph : plan.targets)
+                    {
+                        if (morph.sparse)
+                        {
+                            plan.geometry->addMorphTarget(std::move(sparse[nextSparse++]));
+                            continue;
+                        }
+
+                        plan.geometry->addMorphTarget(MorphTarget::fromDense(morph.name, *basePosition, *morph.position,
+                                                                             morph.normal ? baseNormal.get() : nullptr, morph.normal.get(), true));
+                        morph.position.reset();
+                        morph.normal.reset();
+                    }
+                }
+            }
+        }
+
+        static std::vector<uint32_t> triangulate(const std::vector<uint32_t> &index, int mode)
+        {
+            std::vector<uint32_t> triangles;
+            if (index.size() < 3)
+                return triangles;
+
+            triangles.reserve((index.size() - 2) * 3);
+
+            for (size_t i = 2; i < index.size(); i++)
+            {
+                if (mode == MODE_TRIANGLE_FAN)
+                {
+                    triangles.insert(triangles.end(), {index[0], index[i - 1], index[i]});
+                }
+                else if (i % 2 == 0)
+                {
+                    triangles.insert(triangles.end(), {index[i - 2], index[i - 1], index[i]});
+                }
+                else
+                {
+                    // keep the winding of odd strip triangles
+                    triangles.insert(triangles.end(), {index[i - 2], index[i], index[i - 1]});
+                }
+            }
+
+            return triangles;
+        }
+
+        std::string uniqueName(const std::string &name)
+        {
+            const std::string base = sanitizeNodeName(name);
+            std::string candidate = base;
+
+            for (size_t suffix = 1; !m_names.insert(candidate).second; suffix++)
+                candidate = base + "_" + std::to_string(suffix);
+
+            return candidate;
+        }
+
+        static void applyTransform(Object3D &object, const JSON::Value &node)
+        {
+            if (node.contains("matrix"))
+            {
+                float elements[16];
+                for (size_t i = 0; i < 16; i++)
+                    elements[i] = static_cast<float>(node["matrix"][i].asNumber(i % 5 == 0 ? 1 : 0));
+
+                Matrix4 matrix;
+                matrix.fromArray(elements);
+                matrix.decompose(object.position(), object.quaternion(), object.scale());
+                return;
+            }
+
+            const auto &t = node["translation"];
+            const auto &r = node["rotation"];
+            const auto &s = node["scale"];
+
+            if (t.isArray())
+                object.position().set(t[0].asNumber(), t[1].asNumber(), t[2].asNumber());
+            if (r.isArray())
+                object.quaternion().set(r[0].asNumber(), r[1].asNumber(), r[2].asNumber(), r[3].asNumber(1));
+            if (s.isArray())
+                object.scale().set(s[0].asNumber(1), s[1].asNumber(1), s[2].asNumber(1));
+        }
+
+        std::shared_ptr<Mesh> createMesh(const PrimitivePlan &plan, const JSON::Value &node, const JSON::Value &mesh)
+        {
+            std::shared_ptr<Mesh> object;
+            if (node.contains("skin"))
+                object = std::make_shared<SkinnedMesh>(plan.geometry);
+            else
+                object = std::make_shared<Mesh>(plan.geometry);
+
+            object->updateMorphTargets();
+
+            // node weights override the mesh defaults
+            const auto &weights = node.contains("weights") ? node["weights"] : mesh["weights"];
+            for (size_t i = 0; i < std::min(weights.size(), object->morphTargetInfluences.size()); i++)
+                object->morphTargetInfluences[i] = static_cast<float>(weights[i].asNumber());
+
+            return object;
+        }
+
+        void buildNodes(GLTF &gltf)
+        {
+            const auto &nodes = m_json["nodes"];
+
+            m_isJoint.assign(nodes.size(), false);
+            for (auto &skin : m_json["skins"].elements())
+            {
+                for (auto &joint : skin["joints"].elements())
+                {
+                    const size_t index = static_cast<size_t>(joint.asInt());
+                    if (index >= nodes.size())
+                        throw std::runtime_error("GLTFLoader: invalid joint " + std::to_string(index));
+                    m_isJoint[index] = true;
+                }
+            }
+
+            gltf.nodes.resize(nodes.size());
+
+            for (size_t n = 0; n < nodes.size(); n++)
+            {
+                const auto &node = nodes[n];
+                std::vector<std::shared_ptr<Mesh>> meshes;
+
+                if (node.contains("mesh"))
+                {
+                    const size_t meshIndex = static_cast<size_t>(node["mesh"].asInt());
+                    if (meshIndex >= m_meshes.size())
+                        throw std::runtime_error("GLTFLoader: invalid mesh " + std::to_string(meshIndex));
+
+                    if (node.contains("skin"))
+                    {
+                        const size_t skinIndex = static_cast<size_t>(node["skin"].asInt());
+                        if (skinIndex >= m_json["skins"].size())
+                            throw std::runtime_error("GLTFLoader: invalid skin " + std::to_string(skinIndex));
+
+                        const size_t jointCount = m_json["skins"][skinIndex]["joints"].size();
+                        for (auto &plan : m_meshes[meshIndex])
+                        {
+                            if (plan.geometry->getAttribute("skinIndex") && plan.maxJoint >= static_cast<float>(jointCount))
+                                throw std::runtime_error("GLTFLoader: joint index out of range");
+                        }
+                    }
+
+                    for (auto &plan : m_meshes[meshIndex])
+                        meshes.push_back(createMesh(plan, node, m_json["meshes"][meshIndex]));
+                }
+
+                std::shared_ptr<Object3D> object;
+
+                // a single-primitive mesh node is the mesh itself, others hold
+                // their meshes as children
+                if (meshes.size() == 1 && !m_isJoint[n])
+                {
+                    object = meshes.front();
+                }
+                else
+                {
+                    if (m_isJoint[n])
+                        object = std::make_shared<Bone>();
+                    else
+                        object = std::make_shared<Object3D>();
+
+                    for (auto &mesh : meshes)
+                        object->add(mesh);
+                }
+
+                const std::string name = node["name"].isString() ? node["name"].asString() : (m_isJoint[n] ? "bone_" : "node_") + std::to_string(n);
+                object->name(uniqueName(name));
+
+                applyTransform(*object, node);
+                gltf.nodes[n] = object;
+            }
+
+            for (size_t n = 0; n < nodes.size(); n++)
+            {
+                for (auto &child : nodes[n]["children"].elements())
+                {
+                    const size_t index = static_cast<size_t>(child.asInt());
+                    if (index >= nodes.size() || gltf.nodes[index]->parent() != nullptr || index == n)
+                        throw std::runtime_error("GLTFLoader: invalid node hierarchy");
+
+                    gltf.nodes[n]->add(gltf.nodes[index]);
+                }
+            }
+        }
+
+        void buildSkins(GLTF &gltf)
+        {
+            for (auto &skin : m_json["skins"].elements())
+            {
+                std::vector<std::shared_ptr<Bone>> bones;
+                for (auto &joint : skin["joints"].elements())
+                    bones.push_back(std::static_pointer_cast<Bone>(gltf.nodes[static_cast<size_t>(joint.asInt())]));
+
+                std::vector<Matrix4> boneInverses(bones.size());
+
+                if (skin.contains("inverseBindMatrices"))
+                {
+                    const size_t accessorIndex = static_cast<size_t>(skin["inverseBindMatrices"].asInt());
+                    if (accessorItemSize(accessorIndex) != 16 || accessorCount(accessorIndex) < bones.size())
+                        throw std::runtime_error("GLTFLoader: invalid inverse bind matrices");
+
+                    std::vector<float> elements(accessorCount(accessorIndex) * 16);
+                    schedule(accessorIndex, elements.data());
+                    runJobs();
+
+                    for (size_t b = 0; b < bones.size(); b++)
+                        boneInverses[b].fromArray(elements.data(), b * 16);
+                }
+
+                gltf.skins.push_back(std::make_shared<Skeleton>(std::move(bones), std::move(boneInverses)));
+            }
+        }
+
+        void buildScenes(GLTF &gltf)
+        {
+            for (auto &scene : m_json["scenes"].elements())
+            {
+                auto root = std::make_shared<Object3D>();
+                if (scene["name"].isString())
+                    root->name(scene["name"].asString());
+
+                for (auto &node : scene["nodes"].elements())
+                {
+                    const size_t index = static_cast<size_t>(node.asInt());
+                    if (index >= gltf.nodes.size() || gltf.nodes[index]->parent() != nullptr)
+                        throw std::runtime_error("GLTFLoader: invalid scene node");
+
+                    root->add(gltf.nodes[index]);
+                }
+
+                root->updateMatrixWorld(true);
+                gltf.scenes.push_back(root);
+            }
+
+            if (!gltf.scenes.empty())
+            {
+                const size_t defaultScene = static_cast<size_t>(m_json["scene"].asInt(0));
+                gltf.scene = gltf.scenes[std::min(defaultScene, gltf.scenes.size() - 1)];
+            }
+
+            // bind with the world matrices of the assembled scenes
+            const auto &nodes = m_json["nodes"];
+            for (size_t n = 0; n < nodes.size(); n++)
+            {
+                if (!nodes[n].contains("skin"))
+                    continue;
+
+                const size_t skinIndex = static_cast<size_t>(nodes[n]["skin"].asInt());
+                if (skinIndex >= gltf.skins.size())
+                    throw std::runtime_error("GLTFLoader: invalid skin " + std::to_string(skinIndex));
+
+                gltf.nodes[n]->traverse([&gltf, skinIndex](Object3D &object)
+                                        {
+                    if (auto *mesh = dynamic_cast<SkinnedMesh *>(&object))
+                    {
+                        mesh->updateWorldMatrix(true, false);
+                        mesh->bind(gltf.skins[skinIndex], mesh->matrixWorld());
+                    } });
+            }
+        }
+
+        std::vector<float> readAccessor(size_t index)
+        {
+            std::vector<float> values(accessorCount(index) * accessorItemSize(index));
+            schedule(index, values.data());
+            runJobs();
+            return values;
+        }
+
+        void buildAnimations(GLTF &gltf)
+        {
+            const auto &animations = m_json["animations"];
+
+            for (size_t a = 0; a < animations.size(); a++)
+            {
+                const auto &animation = animations[a];
+                const auto &samplers = animation["samplers"];
+                std::vector<std::shared_ptr<KeyframeTrack>> tracks;
+
+                for (auto &channel : animation["channels"].elements())
+                {
+                    const auto &target = channel["target"];
+                    if (!target.contains("node"))
+                        continue;
+
+                    const size_t nodeIndex = static_cast<size_t>(target["node"].asInt());
+                    const auto &sampler = samplers[static_cast<size_t>(channel["sampler"].asInt())];
+                    if (nodeIndex >= gltf.nodes.size() || !sampler.isObject())
+                        throw std::runtime_error("GLTFLoader: invalid animation channel");
+
+                    std::vector<float> times = readAccessor(static_cast<size_t>(sampler["input"].asInt()));
+                    std::vector<float> values = readAccessor(static_cast<size_t>(sampler["output"].asInt()));
+
+                    const std::string &interpolationName = sampler["interpolation"].asString();
+                    InterpolationMode interpolation = interpolationName == "STEP" ? InterpolationMode::Discrete : InterpolationMode::Linear;
+
+                    if (times.empty() || values.size() % times.size() != 0)
+                        throw std::runtime_error("GLTFLoader: animation sampler size mismatch");
+
+                    if (interpolationName == "CUBICSPLINE")
+                    {
+                        // in-tangent, value, out-tangent per key: keep the values
+                        const size_t stride = values.size() / times.size();
+                        const size_t valueSize = stride / 3;
+                        std::vector<float> keys(times.size() * valueSize);
+
+                        for (size_t k = 0; k < times.size(); k++)
+                            std::copy_n(values.begin() + k * stride + valueSize, valueSize, keys.begin() + k * valueSize);
+
+                        values = std::move(keys);
+                    }
+
+                    const std::string &path = target["path"].asString();
+                    const std::string &nodeName = gltf.nodes[nodeIndex]->name();
+
+                    if (path == "translation")
+                        tracks.push_back(std::make_shared<VectorKeyframeTrack>(nodeName + ".position", std::move(times), std::move(values), interpolation));
+                    else if (path == "rotation")
+                        tracks.push_back(std::make_shared<QuaternionKeyframeTrack>(nodeName + ".quaternion", std::move(times), std::move(values), interpolation));
+                    else if (path == "scale")
+                        tracks.push_back(std::make_shared<VectorKeyframeTrack>(nodeName + ".scale", std::move(times), std::move(values), interpolation));
+                    else if (path == "weights")
+                        tracks.push_back(std::make_shared<NumberKeyframeTrack>(nodeName + ".morphTargetInfluences", std::move(times), std::move(values), interpolation));
+                }
+
+                const std::string name = animation["name"].isString() ? animation["name"].asString() : "animation_" + std::to_string(a);
+                gltf.animations.push_back(std::make_shared<AnimationClip>(name, -1, std::move(tracks)));
+            }
+        }
+    };
+}
+
+GLTFLoader::GLTFLoader()
+{
+}
+
+GLTFLoader::~GLTFLoader()
+{
+}
+
+const LoadStats &GLTFLoader::stats() const
+{
+    return m_stats;
+}
+
+GLTF GLTFLoader::load(const std::string &path)
+{
+    MappedFile file(path);
+
+    const auto slash = path.find_last_of("/\\");
+    const std::string resourcePath = slash == std::string::npos ? "" : path.substr(0, slash + 1);
+
+    return parse(file.span(), resourcePath);
+}
+
+GLTF GLTFLoader::parse(std::span<const char> data, const std::string &resourcePath)
+{
+    THREECPP_PROFILE_ZONE("GLTFLoader::parse");
+    const auto start = std::chrono::steady_clock::now();
+
+    m_stats = LoadStats();
+    m_stats.fileBytes = data.size();
+
+    std::string_view jsonText(data.data(), data.size());
+    std::span<const char> binaryChunk;
+
+    if (data.size() >= 12 && LoaderUtils::readValue<uint32_t>(data.data()) == GLB_MAGIC)
+    {
+        const size_t length = std::min<size_t>(LoaderUtils::readValue<uint32_t>(data.data() + 8), data.size());
+        size_t offset = 12;
+        jsonText = {};
+
+        while (offset + 8 <= length)
+        {
+            const size_t chunkLength = LoaderUtils::readValue<uint32_t>(data.data() + offset);
+            const uint32_t chunkType = LoaderUtils::readValue<uint32_t>(data.data() + offset + 4);
+            offset += 8;
+
+            if (offset + chunkLength > length)
+                throw std::runtime_error("GLTFLoader: truncated GLB chunk");
+
+            if (chunkType == GLB_CHUNK_JSON)
+                jsonText = std::string_view(data.data() + offset, chunkLength);
+            else if (chunkType == GLB_CHUNK_BIN)
+                binaryChunk = data.subspan(offset, chunkLength);
+
+            offset += chunkLength;
+        }
+
+        if (jsonText.empty())
+            throw std::runtime_error("GLTFLoader: GLB without JSON chunk");
+    }
+
+    const JSON::Value json = JSON::parse(jsonText);
+
+    if (json["asset"]["version"].asString().rfind("2.", 0) != 0)
+        throw std::runtime_error("GLTFLoader: unsupported asset version");
+
+    for (auto &extension : json["extensionsRequired"].elements())
+        throw std::runtime_error("GLTFLoader: unsupported required extension " + extension.asString());
+
+    // external buffers are mapped too and stay mapped until parsing is done
+
+    std::vector<std::span<const char>> buffers;
+    std::vector<MappedFile> externalFiles;
+    std::vector<std::vector<char>> embedded;
+
+    externalFiles.reserve(json["buffers"].size());
+    embedded.reserve(json["buffers"].size());
+
+    for (auto &buffer : json["buffers"].elements())
+    {
+        const std::string &uri = buffer["uri"].asString();
+        const size_t byteLength = sizeValue(buffer["byteLength"], "byteLength");
+        std::span<const char> bytes;
+
+        if (uri.empty())
+        {
+            bytes = binaryChunk;
+        }
+        else if (uri.rfind("data:", 0) == 0)
+        {
+            const auto comma = uri.find(',');
+            if (comma == std::string::npos || uri.find(";base64") > comma)
+                throw std::runtime_error("GLTFLoader: unsupported data URI");
+
+            embedded.push_back(decodeBase64(std::string_view(uri).substr(comma + 1)));
+            bytes = embedded.back();
+        }
+        else
+        {
+            externalFiles.emplace_back(resourcePath + decodeURI(uri));
+            bytes = externalFiles.back().span();
+            m_stats.fileBytes += bytes.size();
+        }
+
+        if (bytes.size() < byteLength)
+            throw std::runtime_error("GLTFLoader: buffer shorter than its byteLength");
+
+        buffers.push_back(bytes.first(byteLength));
+    }
+
+    Parser parser(json, std::move(buffers));
+    GLTF gltf = parser.parse();
+
+    m_stats.outputBytes = parser.outputBytes();
+    m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_stats.peakResidentBytes = LoaderUtils::peakResidentBytes();
+
+    return gltf;
+}
@@ -0,0 +1,54 @@
+#include "loaders/LoaderUtils.h"
+#include <algorithm>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace LoaderUtils
+{
+    size_t peakResidentBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<size_t>(counters.PeakWorkingSetSize);
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#if defined(__APPLE__)
+        return static_cast<size_t>(usage.ru_maxrss);
+#else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
+
+    std::vector<std::span<const char>> splitLines(std::span<const char> text, size_t chunkCount, size_t minChunkSize)
+    {
+        std::vector<std::span<const char>> chunks;
+
+        const char *begin = text.data();
+        const char *end = begin + text.size();
+
+        const size_t target = std::max(minChunkSize, text.size() / std::max<size_t>(1, chunkCount) + 1);
+
+        while (begin < end)
+        {
+            const char *split = begin + std::min(target, static_cast<size_t>(end - begin));
+            if (split < end)
+                split = skipLine(split, end);
+
+            chunks.emplace_back(begin, static_cast<size_t>(split - begin));
+            begin = split;
+        }
+
+        return chunks;
+    }
+}
@@ -0,0 +1,412 @@
+#include "loaders/OBJLoader.h"
+#include "common/MappedFile.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <stdexcept>
+
+// output vertices per task when filling the attributes
+static constexpr size_t VERTEX_GRAIN = 1 << 16;
+
+static constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+namespace
+{
+    // one polygon corner: indices into the v, vt and vn lists
+    struct Corner
+    {
+        uint32_t v;
+        uint32_t vt;
+        uint32_t vn;
+
+        bool operator==(const Corner &other) const
+        {
+            return v == other.v && vt == other.vt && vn == other.vn;
+        }
+    };
+
+    struct Chunk
+    {
+        size_t positionCount = 0;
+        size_t uvCount = 0;
+        size_t normalCount = 0;
+        size_t positionOffset = 0;
+        size_t uvOffset = 0;
+        size_t normalOffset = 0;
+        bool hasColor = false;
+        // triangulated corners, three per triangle
+        std::vector<Corner> corners;
+    };
+
+    /**
+     * Open-addressing map from corners to output vertices; linear probing
+     * over a power-of-two table.
+     */
+    class CornerMap
+    {
+    public:
+        explicit CornerMap(size_t capacity)
+            : m_mask(std::bit_ceil(std::max<size_t>(16, capacity * 2)) - 1), m_slots(m_mask + 1, NO_INDEX)
+        {
+        }
+
+        // the output vertex of `corner`, appending it to `unique` when new
+        uint32_t insert(const Corner &corner, std::vector<Corner> &unique)
+        {
+            size_t slot = hash(corner) & m_mask;
+
+            while (true)
+            {
+                const uint32_t index = m_slots[slot];
+
+                if (index == NO_INDEX)
+                {
+                    m_slots[slot] = static_cast<uint32_t>(unique.size());
+                    unique.push_back(corner);
+                    return m_slots[slot];
+                }
+
+                if (unique[index] == corner)
+                    return index;
+
+                slot = (slot + 1) & m_mask;
+            }
+        }
+
+    private:
+        size_t m_mask;
+        std::vector<uint32_t> m_slots;
+
+        static size_t hash(const Corner &corner)
+        {
+            uint64_t h = corner.v * 0x9E3779B97F4A7C15ull;
+            h ^= (corner.vt + 0x7F4A7C15ull) * 0xC2B2AE3D27D4EB4Full;
+            h ^= (corner.vn + 0x27D4EB4Full) * 0x165667B19E3779F9ull;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+}
+
+// resolves a 1-based or negative (relative) OBJ index against `count` elements seen so far
+static inline uint32_t resolveIndex(int64_t index, size_t count)
+{
+    if (index > 0)
+        return static_cast<uint32_t>(index - 1);
+    if (index < 0 && static_cast<size_t>(-index) <= count)
+        return static_cast<uint32_t>(static_cast<int64_t>(count) + index);
+    return NO_INDEX - 1; // out of range, rejected when the output is built
+}
+
+// parses one `v`, `v/vt`, `v//vn` or `v/vt/vn` corner
+static bool parseCorner(const char *&p, const char *end, const Chunk &chunk, size_t positions, size_t uvs, size_t normals, Corner &corner)
+{
+    int64_t index;
+    if (!LoaderUtils::parseNumber(p, end, index))
+        return false;
+
+    corner = {resolveIndex(index, chunk.positionOffset + positions), NO_INDEX, NO_INDEX};
+
+    if (p < end && *p == '/')
+    {
+        ++p;
+        if (p < end && *p != '/')
+        {
+            if (!LoaderUtils::parseNumber(p, end, index))
+                return false;
+            corner.vt = resolveIndex(index, chunk.uvOffset + uvs);
+        }
+
+        if (p < end && *p == '/')
+        {
+            ++p;
+            if (!LoaderUtils::parseNumber(p, end, index))
+                return false;
+            corner.vn = resolveIndex(index, chunk.normalOffset + normals);
+        }
+    }
+
+    return true;
+}
+
+OBJLoader::OBJLoader()
+{
+}
+
+OBJLoader::~OBJLoader()
+{
+}
+
+const LoadStats &OBJLoader::stats() const
+{
+    return m_stats;
+}
+
+std::shared_ptr<BufferGeometry> OBJLoader::load(const std::string &path)
+{
+    MappedFile file(path);
+    return parse(file.span(), &file);
+}
+
+std::shared_ptr<BufferGeometry> OBJLoader::parse(std::span<const char> data)
+{
+    return parse(data, nullptr);
+}
+
+std::shared_ptr<BufferGeometry> OBJLoader::parse(std::span<const char> data, const MappedFile *source)
+{
+    THREECPP_PROFILE_ZONE("OBJLoader::parse");
+    const auto start = std::chrono::steady_clock::now();
+
+    m_stats = LoadStats();
+    m_stats.fileBytes = data.size();
+
+    const auto chunks = LoaderUtils::splitLines(data, Parallel::workerCount() * 4);
+    std::vector<Chunk> info(chunks.size());
+
+    // pass 1: count v, vt and vn per chunk, so each chunk knows where its
+    // elements go and how to resolve relative indices
+
+    Parallel::parallelFor(0, chunks.size(), 1, [&](size_t begin, size_t end)
+                          {
+        for (size_t c = begin; c < end; c++)
+        {
+            const char *p = chunks[c].data();
+            const char *last = p + chunks[c].size();
+
+            while (p < last)
+            {
+                const char *line = LoaderUtils::skipSpaces(p, last);
+                p = LoaderUtils::skipLine(line, last);
+
+                if (p - line < 2 || line[0] != 'v')
+                    continue;
+
+                if (LoaderUtils::isSpace(line[1]))
+                    info[c].positionCount++;
+                else if (line[1] == 't')
+                    info[c].uvCount++;
+                else if (line[1] == 'n')
+                    info[c].normalCount++;
+            }
+        } });
+
+    size_t positionCount = 0, uvCount = 0, normalCount = 0;
+    for (auto &chunk : info)
+    {
+        chunk.positionOffset = positionCount;
+        chunk.uvOffset = uvCount;
+        chunk.normalOffset = normalCount;
+        positionCount += chunk.positionCount;
+        uvCount += chunk.uvCount;
+        normalCount += chunk.normalCount;
+    }
+
+    std::vector<float> positions(positionCount * 3);
+    std::vector<float> colors(positionCount * 3, 1.0f);
+    std::vector<float> uvs(uvCount * 2);
+    std::vector<float> normals(normalCount * 3);
+
+    // pass 2: vertex data straight into the shared arrays, faces into
+    // per-chunk corner lists with absolute indices
+
+    Parallel::parallelFor(0, chunks.size(), 1, [&](size_t begin, size_t end)
+                          {
+        for (size_t c = begin; c < end; c++)
+        {
+            auto &chunk = info[c];
+            size_t v = 0, vt = 0, vn = 0;
+
+            const char *p = chunks[c].data();
+            const char *last = p + chunks[c].size();
+
+            std::vector<Corner> polygon;
+
+            while (p < last)
+            {
+                const char *line = p;
+                p = LoaderUtils::skipLine(p, last);
+
+                const auto keyword = LoaderUtils::nextToken(line, p);
+                bool valid = true;
+
+                if (keyword == "v")
+                {
+                    float *position = positions.data() + (chunk.positionOffset + v) * 3;
+                    valid = LoaderUtils::parseNumber(line, p, position[0]) && LoaderUtils::parseNumber(line, p, position[1]) && LoaderUtils::parseNumber(line, p, position[2]);
+
+                    // a lone fourth value is the optional w; exactly three
+                    // more are a vertex color, as in three.js
+                    float extra[4];
+                    size_t extraCount = 0;
+                    while (valid && extraCount < 4 && LoaderUtils::parseNumber(line, p, extra[extraCount]))
+                        extraCount++;
+
+                    if (extraCount == 3)
+                    {
+                        std::copy(extra, extra + 3, colors.data() + (chunk.positionOffset + v) * 3);
+                        chunk.hasColor = true;
+                    }
+
+                    v++;
+                }
+                else if (keyword == "vt")
+                {
+                    float *uv = uvs.data() + (chunk.uvOffset + vt) * 2;
+                    valid = LoaderUtils::parseNumber(line, p, uv[0]);
+                    // the v coordinate is optional
+                    LoaderUtils::parseNumber(line, p, uv[1]);
+                    vt++;
+                }
+                else if (keyword == "vn")
+                {
+                    float *normal = normals.data() + (chunk.normalOffset + vn) * 3;
+                    valid = LoaderUtils::parseNumber(line, p, normal[0]) && LoaderUtils::parseNumber(line, p, normal[1]) && LoaderUtils::parseNumber(line, p, normal[2]);
+                    vn++;
+                }
+                else if (keyword == "f")
+                {
+                    polygon.clear();
+
+                    while (true)
+                    {
+                        line = LoaderUtils::skipSpaces(line, p);
+                        if (line >= p || *line == '\n' || *line == '#')
+                            break;
+
+                        Corner corner;
+                        if (!parseCorner(line, p, chunk, v, vt, vn, corner))
+                        {
+                            valid = false;
+                            break;
+                        }
+
+                        polygon.push_back(corner);
+                    }
+
+                    for (size_t k = 2; k < polygon.size(); k++)
+                    {
+                        chunk.corners.push_back(polygon[0]);
+                        chunk.corners.push_back(polygon[k - 1]);
+                        chunk.corners.push_back(polygon[k]);
+                    }
+                }
+
+                // Parallel::parallelFor rethrows once every chunk has finished
+                if (!valid)
+                    throw std::runtime_error("OBJLoader: malformed statement");
+            }
+
+            if (source != nullptr)
+                source->release(static_cast<size_t>(chunks[c].data() - source->data()), chunks[c].size());
+        } });
+
+    size_t cornerCount = 0;
+    bool hasColor = false, hasUV = false, hasNormal = false;
+
+    for (auto &chunk : info)
+    {
+        cornerCount += chunk.corners.size();
+        hasColor = hasColor || chunk.hasColor;
+
+        for (auto &corner : chunk.corners)
+        {
+            if (corner.v >= positionCount || (corner.vt != NO_INDEX && corner.vt >= uvCount) || (corner.vn != NO_INDEX && corner.vn >= normalCount))
+                throw std::runtime_error("OBJLoader: face index out of range");
+
+            hasUV = hasUV || corner.vt != NO_INDEX;
+            hasNormal = hasNormal || corner.vn != NO_INDEX;
+        }
+    }
+
+    // the corners of the output vertices, in order
+
+    std::vector<Corner> unique;
+    std::vector<uint32_t> index;
+
+    if (deduplicateVertices)
+    {
+        CornerMap map(cornerCount);
+        unique.reserve(std::min(cornerCount, positionCount * 2));
+        index.reserve(cornerCount);
+
+        for (auto &chunk : info)
+        {
+            for (auto &corner : chunk.corners)
+                index.push_back(map.insert(corner, unique));
+
+            std::vector<Corner>().swap(chunk.corners);
+        }
+    }
+    else
+    {
+        unique.reserve(cornerCount);
+        for (auto &chunk : info)
+        {
+            unique.insert(unique.end(), chunk.corners.begin(), chunk.corners.end());
+            std::vector<Corner>().swap(chunk.corners);
+        }
+    }
+
+    const size_t vertexCount = unique.size();
+
+    auto position = std::make_shared<BufferAttribute>(vertexCount, 3);
+    auto color = hasColor ? std::make_shared<BufferAttribute>(vertexCount, 3) : nullptr;
+    auto uv = hasUV ? std::make_shared<BufferAttribute>(vertexCount, 2) : nullptr;
+    auto normal = hasNormal ? std::make_shared<BufferAttribute>(vertexCount, 3) : nullptr;
+
+    Parallel::parallelFor(0, vertexCount, VERTEX_GRAIN, [&](size_t begin, size_t end)
+                          {
+        float *outPosition = position->array();
+        float *outColor = color ? color->array() : nullptr;
+        float *outUV = uv ? uv->array() : nullptr;
+        float *outNormal = normal ? normal->array() : nullptr;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const Corner &corner = unique[i];
+
+            std::copy_n(positions.data() + corner.v * 3, 3, outPosition + i * 3);
+
+            if (outColor != nullptr)
+                std::copy_n(colors.data() + corner.v * 3, 3, outColor + i * 3);
+
+            if (outUV != nullptr)
+            {
+                if (corner.vt != NO_INDEX)
+                    std::copy_n(uvs.data() + corner.vt * 2, 2, outUV + i * 2);
+                else
+                    std::fill_n(outUV + i * 2, 2, 0.0f);
+            }
+
+            if (outNormal != nullptr)
+            {
+                if (corner.vn != NO_INDEX)
+                    std::copy_n(normals.data() + corner.vn * 3, 3, outNormal + i * 3);
+                else
+                    std::fill_n(outNormal + i * 3, 3, 0.0f);
+            }
+        } });
+
+    auto geometry = std::make_shared<BufferGeometry>();
+    geometry->setAttribute("position", position);
+
+    if (normal)
+        geometry->setAttribute("normal", normal);
+    if (color)
+        geometry->setAttribute("color", color);
+    if (uv)
+        geometry->setAttribute("uv", uv);
+    if (!index.empty())
+        geometry->setIndex(std::move(index));
+
+    for (auto &[name, attribute] : geometry->attributes())
+        m_stats.outputBytes += attribute->span().size_bytes();
+    m_stats.outputBytes += geometry->getIndex().size() * sizeof(uint32_t);
+
+    m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_stats.peakResidentBytes = LoaderUtils::peakResidentBytes();
+
+    return geometry;
+}
@@ -0,0 +1,663 @@
+#include "loaders/PLYLoader.h"
+#include "common/MappedFile.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// vertices per task when decoding binary files
+static constexpr size_t VERTEX_GRAIN = 1 << 16;
+
+namespace
+{
+    enum class PropertyType
+    {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    struct Property
+    {
+        std::string name;
+        PropertyType type = PropertyType::Float32;
+        bool isList = false;
+        PropertyType countType = PropertyType::UInt8;
+        // byte offset inside a fixed-size binary record
+        size_t offset = 0;
+    };
+
+    struct Element
+    {
+        std::string name;
+        size_t count = 0;
+        std::vector<Property> properties;
+        bool fixedSize = true;
+        size_t stride = 0;
+    };
+
+    enum class Format
+    {
+        ASCII,
+        BinaryLittleEndian,
+        BinaryBigEndian
+    };
+
+    struct Header
+    {
+        Format format = Format::ASCII;
+        std::vector<Element> elements;
+        size_t bodyOffset = 0;
+    };
+
+    // destination of one vertex property: attribute slot and component
+    struct Target
+    {
+        int attribute = -1; // 0 position, 1 normal, 2 uv, 3 color
+        size_t component = 0;
+    };
+
+    enum AttributeSlot
+    {
+        POSITION,
+        NORMAL,
+        UV,
+        COLOR,
+        SLOT_COUNT
+    };
+
+    static constexpr size_t SLOT_SIZES[SLOT_COUNT] = {3, 3, 2, 3};
+    static constexpr const char *SLOT_NAMES[SLOT_COUNT] = {"position", "normal", "uv", "color"};
+}
+
+static size_t typeSize(PropertyType type)
+{
+    switch (type)
+    {
+    case PropertyType::Int8:
+    case PropertyType::UInt8:
+        return 1;
+    case PropertyType::Int16:
+    case PropertyType::UInt16:
+        return 2;
+    case PropertyType::Int32:
+    case PropertyType::UInt32:
+    case PropertyType::Float32:
+        return 4;
+    case PropertyType::Float64:
+        return 8;
+    }
+
+    return 0;
+}
+
+static PropertyType parseType(std::string_view name)
+{
+    if (name == "char" || name == "int8")
+        return PropertyType::Int8;
+    if (name == "uchar" || name == "uint8")
+        return PropertyType::UInt8;
+    if (name == "short" || name == "int16")
+        return PropertyType::Int16;
+    if (name == "ushort" || name == "uint16")
+        return PropertyType::UInt16;
+    if (name == "int" || name == "int32")
+        return PropertyType::Int32;
+    if (name == "uint" || name == "uint32")
+        return PropertyType::UInt32;
+    if (name == "float" || name == "float32")
+        return PropertyType::Float32;
+    if (name == "double" || name == "float64")
+        return PropertyType::Float64;
+
+    throw std::runtime_error("PLYLoader: unknown property type " + std::string(name));
+}
+
+static double readBinary(const char *p, PropertyType type, bool littleEndian)
+{
+    switch (type)
+    {
+    case PropertyType::Int8:
+        return LoaderUtils::readValue<int8_t>(p, littleEndian);
+    case PropertyType::UInt8:
+        return LoaderUtils::readValue<uint8_t>(p, littleEndian);
+    case PropertyType::Int16:
+        return LoaderUtils::readValue<int16_t>(p, littleEndian);
+    case PropertyType::UInt16:
+        return LoaderUtils::readValue<uint16_t>(p, littleEndian);
+    case PropertyType::Int32:
+        return LoaderUtils::readValue<int32_t>(p, littleEndian);
+    case PropertyType::UInt32:
+        return LoaderUtils::readValue<uint32_t>(p, littleEndian);
+    case PropertyType::Float32:
+        return LoaderUtils::readValue<float>(p, littleEndian);
+    case PropertyType::Float64:
+        return LoaderUtils::readValue<double>(p, littleEndian);
+    }
+
+    return 0;
+}
+
+// list counts and face indices arrive as any property type; reject values
+// that would not survive the cast to an index
+static uint32_t readBinaryIndex(const char *p, PropertyType type, bool littleEndian)
+{
+    const double value = readBinary(p, type, littleEndian);
+    if (!(value >= 0.0 && value <= static_cast<double>(std::numeric_limits<uint32_t>::max())))
+        throw std::runtime_error("PLYLoader: invalid list count or index");
+
+    return static_cast<uint32_t>(value);
+}
+
+static Header parseHeader(std::span<const char> data)
+{
+    const char *p = data.data();
+    const char *end = p + data.size();
+
+    Header header;
+
+    if (LoaderUtils::nextToken(p, end) != "ply")
+        throw std::runtime_error("PLYLoader: missing ply magic");
+
+    p = LoaderUtils::skipLine(p, end);
+
+    while (p < end)
+    {
+        const char *line = p;
+        p = LoaderUtils::skipLine(p, end);
+
+        const auto keyword = LoaderUtils::nextToken(line, p);
+
+        if (keyword == "format")
+        {
+            const auto format = LoaderUtils::nextToken(line, p);
+
+            if (format == "ascii")
+                header.format = Format::ASCII;
+            else if (format == "binary_little_endian")
+                header.format = Format::BinaryLittleEndian;
+            else if (format == "binary_big_endian")
+                header.format = Format::BinaryBigEndian;
+            else
+                throw std::runtime_error("PLYLoader: unknown format " + std::string(format));
+        }
+        else if (keyword == "element")
+        {
+            Element element;
+            element.name = LoaderUtils::nextToken(line, p);
+            if (!LoaderUtils::parseNumber(line, p, element.count))
+                throw std::runtime_error("PLYLoader: invalid element count");
+            header.elements.push_back(std::move(element));
+        }
+        else if (keyword == "property")
+        {
+            if (header.elements.empty())
+                throw std::runtime_error("PLYLoader: property outside of an element");
+
+            auto &element = header.elements.back();
+            Property property;
+
+            const auto type = LoaderUtils::nextToken(line, p);
+            if (type == "list")
+            {
+                property.isList = true;
+                property.countType = parseType(LoaderUtils::nextToken(line, p));
+                property.type = parseType(LoaderUtils::nextToken(line, p));
+                element.fixedSize = false;
+            }
+            else
+            {
+                property.type = parseType(type);
+                property.offset = element.stride;
+                element.stride += typeSize(property.type);
+            }
+
+            property.name = LoaderUtils::nextToken(line, p);
+            element.properties.push_back(std::move(property));
+        }
+        else if (keyword == "end_header")
+        {
+            header.bodyOffset = static_cast<size_t>(p - data.data());
+
+            // every record takes at least a byte, so larger counts are not
+            // worth allocating for
+            for (auto &element : header.elements)
+            {
+                if (!element.properties.empty() && element.count > data.size() - header.bodyOffset)
+                    throw std::runtime_error("PLYLoader: element count exceeds the file size");
+            }
+
+            return header;
+        }
+    }
+
+    throw std::runtime_error("PLYLoader: missing end_header");
+}
+
+static Target mapProperty(const std::string &name)
+{
+    if (name == "x")
+        return {POSITION, 0};
+    if (name == "y")
+        return {POSITION, 1};
+    if (name == "z")
+        return {POSITION, 2};
+    if (name == "nx")
+        return {NORMAL, 0};
+    if (name == "ny")
+        return {NORMAL, 1};
+    if (name == "nz")
+        return {NORMAL, 2};
+    if (name == "s" || name == "u" || name == "texture_u" || name == "texture_s")
+        return {UV, 0};
+    if (name == "t" || name == "v" || name == "texture_v" || name == "texture_t")
+        return {UV, 1};
+    if (name == "red" || name == "diffuse_red")
+        return {COLOR, 0};
+    if (name == "green" || name == "diffuse_green")
+        return {COLOR, 1};
+    if (name == "blue" || name == "diffuse_blue")
+        return {COLOR, 2};
+
+    return {};
+}
+
+static inline float srgbToLinear(float c)
+{
+    return (c < 0.04045f) ? c * 0.0773993808f : std::pow(c * 0.9478672986f + 0.0521327014f, 2.4f);
+}
+
+static inline void storeVertexValue(float **slots, const Target &target, size_t vertex, double value)
+{
+    if (target.attribute < 0 || slots[target.attribute] == nullptr)
+        return;
+
+    float v = static_cast<float>(value);
+
+    if (target.attribute == COLOR)
+        v = srgbToLinear(v / 255.0f);
+
+    slots[target.attribute][vertex * SLOT_SIZES[target.attribute] + target.component] = v;
+}
+
+// whether `count` records of `size` bytes fit in `[p, end)`, without
+// forming a pointer past `end` on hostile counts
+static inline bool fitsBefore(const char *p, const char *end, size_t count, size_t size)
+{
+    return size == 0 || count <= static_cast<size_t>(end - p) / size;
+}
+
+// fan triangulation of one polygon into `index`
+template <typename Read>
+static inline void emitPolygon(std::vector<uint32_t> &index, size_t corners, Read read)
+{
+    if (corners < 3)
+        return;
+
+    const uint32_t first = read(0);
+    uint32_t previous = read(1);
+
+    for (size_t k = 2; k < corners; k++)
+    {
+        const uint32_t current = read(k);
+        index.push_back(first);
+        index.push_back(previous);
+        index.push_back(current);
+        previous = current;
+    }
+}
+
+namespace
+{
+    struct VertexLayout
+    {
+        const Element *element = nullptr;
+        std::vector<Target> targets;
+        std::shared_ptr<BufferAttribute> attributes[SLOT_COUNT];
+        float *slots[SLOT_COUNT] = {};
+
+        void allocate()
+        {
+            bool present[SLOT_COUNT] = {};
+            for (auto &target : targets)
+            {
+                if (target.attribute >= 0)
+                    present[target.attribute] = true;
+            }
+
+            for (size_t s = 0; s < SLOT_COUNT; s++)
+            {
+                if (!present[s])
+                    continue;
+
+                attributes[s] = std::make_shared<BufferAttribute>(element->count, SLOT_SIZES[s]);
+                slots[s] = attributes[s]->array();
+            }
+        }
+    };
+
+    struct ASCIIChunk
+    {
+        size_t lineCount = 0;
+        size_t firstLine = 0;
+        std::vector<uint32_t> index;
+    };
+}
+
+PLYLoader::PLYLoader()
+{
+}
+
+PLYLoader::~PLYLoader()
+{
+}
+
+const LoadStats &PLYLoader::stats() const
+{
+    return m_stats;
+}
+
+std::shared_ptr<BufferGeometry> PLYLoader::load(const std::string &path)
+{
+    MappedFile file(path);
+    return parse(file.span(), &file);
+}
+
+std::shared_ptr<BufferGeometry> PLYLoader::parse(std::span<const char> data)
+{
+    return parse(data, nullptr);
+}
+
+std::shared_ptr<BufferGeometry> PLYLoader::parse(std::span<const char> data, const MappedFile *source)
+{
+    THREECPP_PROFILE_ZONE("PLYLoader::parse");
+    const auto start = std::chrono::steady_clock::now();
+
+    m_stats = LoadStats();
+    m_stats.fileBytes = data.size();
+
+    const Header header = parseHeader(data);
+
+    VertexLayout layout;
+    const Element *faceElement = nullptr;
+
+    for (auto &element : header.elements)
+    {
+        if (element.name == "vertex")
+            layout.element = &element;
+        else if (element.name == "face")
+            faceElement = &element;
+    }
+
+    if (layout.element != nullptr)
+    {
+        for (auto &property : layout.element->properties)
+            layout.targets.push_back(property.isList ? Target() : mapProperty(property.name));
+
+        layout.allocate();
+    }
+
+    std::vector<uint32_t> index;
+
+    const auto isFaceList = [](const Property &property)
+    { return property.isList && (property.name == "vertex_indices" || property.name == "vertex_index"); };
+
+    const auto releaseRange = [source](const char *begin, size_t length)
+    {
+        if (source != nullptr)
+            source->release(static_cast<size_t>(begin - source->data()), length);
+    };
+
+    if (header.format == Format::ASCII)
+    {
+        const auto body = data.subspan(header.bodyOffset);
+        const auto chunks = LoaderUtils::splitLines(body, Parallel::workerCount() * 4);
+        std::vector<ASCIIChunk> info(chunks.size());
+
+        // pass 1: line counts give every chunk the index of its first line,
+        // and so which element each of its lines belongs to
+
+        Parallel::parallelFor(0, chunks.size(), 1, [&](size_t begin, size_t end)
+                              {
+            for (size_t c = begin; c < end; c++)
+                info[c].lineCount = static_cast<size_t>(std::count(chunks[c].begin(), chunks[c].end(), '\n')); });
+
+        size_t line = 0;
+        for (auto &chunk : info)
+        {
+            chunk.firstLine = line;
+            line += chunk.lineCount;
+        }
+
+        // line ranges of the vertex and face elements
+        size_t vertexFirst = 0, faceFirst = 0, elementLine = 0;
+        for (auto &element : header.elements)
+        {
+            if (&element == layout.element)
+                vertexFirst = elementLine;
+            if (&element == faceElement)
+                faceFirst = elementLine;
+            elementLine += element.count;
+        }
+
+        const size_t vertexCount = layout.element ? layout.element->count : 0;
+        const size_t faceCount = faceElement ? faceElement->count : 0;
+
+        // pass 2: vertices go straight into the attributes, faces into
+        // per-chunk index lists
+
+        Parallel::parallelFor(0, chunks.size(), 1, [&](size_t begin, size_t end)
+                              {
+            for (size_t c = begin; c < end; c++)
+            {
+                const char *p = chunks[c].data();
+                const char *last = p + chunks[c].size();
+                size_t lineIndex = info[c].firstLine;
+                // corners of the current face, reused across the chunk
+                std::vector<uint32_t> polygon;
+
+                for (; p < last; lineIndex++)
+                {
+                    const char *cursor = p;
+                    p = LoaderUtils::skipLine(p, last);
+
+                    if (layout.element != nullptr && lineIndex >= vertexFirst && lineIndex < vertexFirst + vertexCount)
+                    {
+                        const size_t vertex = lineIndex - vertexFirst;
+
+                        for (size_t k = 0; k < layout.targets.size(); k++)
+                        {
+                            double value;
+                            if (!LoaderUtils::parseNumber(cursor, p, value))
+                                throw std::runtime_error("PLYLoader: malformed element data");
+
+                            storeVertexValue(layout.slots, layout.targets[k], vertex, value);
+                        }
+                    }
+                    else if (faceElement != nullptr && lineIndex >= faceFirst && lineIndex < faceFirst + faceCount)
+                    {
+                        for (auto &property : faceElement->properties)
+                        {
+                            if (!property.isList)
+                            {
+                                double ignored;
+                                if (!LoaderUtils::parseNumber(cursor, p, ignored))
+                                    throw std::runtime_error("PLYLoader: malformed element data");
+                                continue;
+                            }
+
+                            size_t corners = 0;
+                            if (!LoaderUtils::parseNumber(cursor, p, corners))
+                                throw std::runtime_error("PLYLoader: malformed element data");
+
+                            if (!isFaceList(property))
+                            {
+                                for (size_t k = 0; k < corners; k++)
+                                {
+                                    double ignored;
+                                    if (!LoaderUtils::parseNumber(cursor, p, ignored))
+                                        throw std::runtime_error("PLYLoader: malformed element data");
+                                }
+                                continue;
+                            }
+
+                            polygon.clear();
+                            for (size_t k = 0; k < corners; k++)
+                            {
+                                uint32_t value = 0;
+                                if (!LoaderUtils::parseNumber(cursor, p, value))
+                                    throw std::runtime_error("PLYLoader: malformed element data");
+                                polygon.push_back(value);
+                            }
+
+                            emitPolygon(info[c].index, polygon.size(), [&polygon](size_t k)
+                                        { return polygon[k]; });
+                        }
+                    }
+                }
+
+                releaseRange(chunks[c].data(), chunks[c].size());
+            } });
+
+        size_t indexCount = 0;
+        for (auto &chunk : info)
+            indexCount += chunk.index.size();
+
+        index.reserve(indexCount);
+        for (auto &chunk : info)
+        {
+            index.insert(index.end(), chunk.index.begin(), chunk.index.end());
+            std::vector<uint32_t>().swap(chunk.index);
+        }
+    }
+    else
+    {
+        const bool littleEndian = header.format == Format::BinaryLittleEndian;
+        const char *p = data.data() + header.bodyOffset;
+        const char *end = data.data() + data.size();
+
+        for (auto &element : header.elements)
+        {
+            if (&element == layout.element && element.fixedSize)
+            {
+                // fixed-size records: decode in parallel from the mapped pages
+
+                if (!fitsBefore(p, end, element.count, element.stride))
+                    throw std::runtime_error("PLYLoader: unexpected end of file");
+
+                const char *records = p;
+                Parallel::parallelFor(0, element.count, VERTEX_GRAIN, [&](size_t begin, size_t last)
+                                      {
+                    for (size_t vertex = begin; vertex < last; vertex++)
+                    {
+                        const char *record = records + vertex * element.stride;
+
+                        for (size_t k = 0; k < element.properties.size(); k++)
+                        {
+                            const auto &property = element.properties[k];
+                            storeVertexValue(layout.slots, layout.targets[k], vertex, readBinary(record + property.offset, property.type, littleEndian));
+                        }
+                    }
+
+                    releaseRange(records + begin * element.stride, (last - begin) * element.stride); });
+
+                p += element.count * element.stride;
+                continue;
+            }
+
+            if (element.fixedSize && &element != faceElement)
+            {
+                if (!fitsBefore(p, end, element.count, element.stride))
+                    throw std::runtime_error("PLYLoader: unexpected end of file");
+
+                p += element.count * element.stride;
+                continue;
+            }
+
+            // variable-size records are walked in order
+
+            const bool isVertex = &element == layout.element;
+            const bool isFace = &element == faceElement;
+            const char *elementStart = p;
+
+            if (isFace)
+                index.reserve(element.count * 3);
+
+            for (size_t item = 0; item < element.count; item++)
+            {
+                for (size_t k = 0; k < element.properties.size(); k++)
+                {
+                    const auto &property = element.properties[k];
+
+                    if (!property.isList)
+                    {
+                        if (!fitsBefore(p, end, 1, typeSize(property.type)))
+                            throw std::runtime_error("PLYLoader: unexpected end of file");
+
+                        if (isVertex)
+                            storeVertexValue(layout.slots, layout.targets[k], item, readBinary(p, property.type, littleEndian));
+
+                        p += typeSize(property.type);
+                        continue;
+                    }
+
+                    if (!fitsBefore(p, end, 1, typeSize(property.countType)))
+                        throw std::runtime_error("PLYLoader: unexpected end of file");
+
+                    const size_t corners = readBinaryIndex(p, property.countType, littleEndian);
+                    p += typeSize(property.countType);
+
+                    const size_t itemSize = typeSize(property.type);
+                    if (!fitsBefore(p, end, corners, itemSize))
+                        throw std::runtime_error("PLYLoader: unexpected end of file");
+
+                    if (isFace && isFaceList(property))
+                    {
+                        const char *items = p;
+                        emitPolygon(index, corners, [items, itemSize, &property, littleEndian](size_t c)
+                                    { return readBinaryIndex(items + c * itemSize, property.type, littleEndian); });
+                    }
+
+                    p += corners * itemSize;
+                }
+            }
+
+            releaseRange(elementStart, static_cast<size_t>(p - elementStart));
+        }
+    }
+
+    auto geometry = std::make_shared<BufferGeometry>();
+
+    for (size_t s = 0; s < SLOT_COUNT; s++)
+    {
+        if (layout.attributes[s])
+            geometry->setAttribute(SLOT_NAMES[s], layout.attributes[s]);
+    }
+
+    const size_t vertexCount = layout.element != nullptr ? layout.element->count : 0;
+    for (uint32_t i : index)
+    {
+        if (i >= vertexCount)
+            throw std::runtime_error("PLYLoader: face index out of range");
+    }
+
+    if (!index.empty())
+        geometry->setIndex(std::move(index));
+
+    for (auto &[name, attribute] : geometry->attributes())
+        m_stats.outputBytes += attribute->span().size_bytes();
+    m_stats.outputBytes += geometry->getIndex().size() * sizeof(uint32_t);
+
+    m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_stats.peakResidentBytes = LoaderUtils::peakResidentBytes();
+
+    return geometry;
+}
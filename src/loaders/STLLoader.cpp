@@ -0,0 +1,224 @@
+#include "loaders/STLLoader.h"
+#include "common/MappedFile.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+// triangles per task when decoding binary files
+static constexpr size_t TRIANGLE_GRAIN = 1 << 16;
+
+static constexpr size_t HEADER_SIZE = 80;
+static constexpr size_t FACE_SIZE = 50;
+
+STLLoader::STLLoader()
+{
+}
+
+STLLoader::~STLLoader()
+{
+}
+
+const LoadStats &STLLoader::stats() const
+{
+    return m_stats;
+}
+
+std::shared_ptr<BufferGeometry> STLLoader::load(const std::string &path)
+{
+    MappedFile file(path);
+    return parse(file.span(), &file);
+}
+
+std::shared_ptr<BufferGeometry> STLLoader::parse(std::span<const char> data)
+{
+    return parse(data, nullptr);
+}
+
+std::shared_ptr<BufferGeometry> STLLoader::parse(std::span<const char> data, const MappedFile *source)
+{
+    THREECPP_PROFILE_ZONE("STLLoader::parse");
+    const auto start = std::chrono::steady_clock::now();
+
+    m_stats = LoadStats();
+    m_stats.fileBytes = data.size();
+
+    // binary files carry the triangle count right after the 80 byte header
+    bool binary = false;
+    if (data.size() >= HEADER_SIZE + 4)
+    {
+        const size_t faces = LoaderUtils::readValue<uint32_t>(data.data() + HEADER_SIZE);
+        binary = HEADER_SIZE + 4 + faces * FACE_SIZE == data.size();
+    }
+
+    auto geometry = binary ? parseBinary(data, source) : parseASCII(data, source);
+
+    for (auto &[name, attribute] : geometry->attributes())
+        m_stats.outputBytes += attribute->span().size_bytes();
+
+    m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    m_stats.peakResidentBytes = LoaderUtils::peakResidentBytes();
+
+    return geometry;
+}
+
+std::shared_ptr<BufferGeometry> STLLoader::parseBinary(std::span<const char> data, const MappedFile *source)
+{
+    const size_t faces = LoaderUtils::readValue<uint32_t>(data.data() + HEADER_SIZE);
+    const char *records = data.data() + HEADER_SIZE + 4;
+
+    auto position = std::make_shared<BufferAttribute>(faces * 3, 3);
+    auto normal = std::make_shared<BufferAttribute>(faces * 3, 3);
+
+    float *positions = position->array();
+    float *normals = normal->array();
+
+    Parallel::parallelFor(0, faces, TRIANGLE_GRAIN, [=](size_t begin, size_t end)
+                          {
+        for (size_t face = begin; face < end; face++)
+        {
+            const char *record = records + face * FACE_SIZE;
+
+            float n[3];
+            for (size_t k = 0; k < 3; k++)
+                n[k] = LoaderUtils::readValue<float>(record + k * 4);
+
+            float *p = positions + face * 9;
+            float *o = normals + face * 9;
+
+            for (size_t k = 0; k < 9; k++)
+                p[k] = LoaderUtils::readValue<float>(record + 12 + k * 4);
+
+            for (size_t v = 0; v < 3; v++)
+            {
+                o[v * 3 + 0] = n[0];
+                o[v * 3 + 1] = n[1];
+                o[v * 3 + 2] = n[2];
+            }
+        }
+
+        if (source != nullptr)
+            source->release(static_cast<size_t>(records - source->data()) + begin * FACE_SIZE, (end - begin) * FACE_SIZE); });
+
+    auto geometry = std::make_shared<BufferGeometry>();
+    geometry->setAttribute("position", position);
+    geometry->setAttribute("normal", normal);
+
+    return geometry;
+}
+
+namespace
+{
+    struct ASCIIChunk
+    {
+        size_t vertexCount = 0;
+        size_t vertexOffset = 0;
+        bool hasNormal = false;
+        float lastNormal[3] = {0, 0, 0};
+    };
+}
+
+std::shared_ptr<BufferGeometry> STLLoader::parseASCII(std::span<const char> data, const MappedFile *source)
+{
+    const auto chunks = LoaderUtils::splitLines(data, Parallel::workerCount() * 4);
+    std::vector<ASCIIChunk> info(chunks.size());
+
+    // pass 1: vertices per chunk and the last facet normal of each chunk, so
+    // a chunk starting inside a facet knows that facet's normal
+
+    Parallel::parallelFor(0, chunks.size(), 1, [&](size_t begin, size_t end)
+                          {
+        for (size_t c = begin; c < end; c++)
+        {
+            const char *p = chunks[c].data();
+            const char *last = p + chunks[c].size();
+
+            while (p < last)
+            {
+                const char *line = p;
+                p = LoaderUtils::skipLine(p, last);
+
+                const auto keyword = LoaderUtils::nextToken(line, p);
+
+                if (keyword == "vertex")
+                {
+                    info[c].vertexCount++;
+                }
+                else if (keyword == "facet")
+                {
+                    LoaderUtils::nextToken(line, p); // "normal"
+                    for (size_t k = 0; k < 3; k++)
+                        LoaderUtils::parseNumber(line, p, info[c].lastNormal[k]);
+                    info[c].hasNormal = true;
+                }
+            }
+        } });
+
+    size_t vertexCount = 0;
+    for (auto &chunk : info)
+    {
+        chunk.vertexOffset = vertexCount;
+        vertexCount += chunk.vertexCount;
+    }
+
+    auto position = std::make_shared<BufferAttribute>(vertexCount, 3);
+    auto normal = std::make_shared<BufferAttribute>(vertexCount, 3);
+
+    float *positions = position->array();
+    float *normals = normal->array();
+
+    // pass 2: parse straight into the attributes
+
+    Parallel::parallelFor(0, chunks.size(), 1, [&](size_t begin, size_t end)
+                          {
+        for (size_t c = begin; c < end; c++)
+        {
+            float n[3] = {0, 0, 0};
+            for (size_t prev = c; prev-- > 0;)
+            {
+                if (info[prev].hasNormal)
+                {
+                    std::copy(info[prev].lastNormal, info[prev].lastNormal + 3, n);
+                    break;
+                }
+            }
+
+            size_t vertex = info[c].vertexOffset;
+            const char *p = chunks[c].data();
+            const char *last = p + chunks[c].size();
+
+            while (p < last)
+            {
+                const char *line = p;
+                p = LoaderUtils::skipLine(p, last);
+
+                const auto keyword = LoaderUtils::nextToken(line, p);
+
+                if (keyword == "vertex")
+                {
+                    float *v = positions + vertex * 3;
+                    if (!LoaderUtils::parseNumber(line, p, v[0]) || !LoaderUtils::parseNumber(line, p, v[1]) || !LoaderUtils::parseNumber(line, p, v[2]))
+                        throw std::runtime_error("STLLoader: malformed vertex");
+
+                    std::copy(n, n + 3, normals + vertex * 3);
+                    vertex++;
+                }
+                else if (keyword == "facet")
+                {
+                    LoaderUtils::nextToken(line, p);
+                    for (size_t k = 0; k < 3; k++)
+                        LoaderUtils::parseNumber(line, p, n[k]);
+                }
+            }
+
+            if (source != nullptr)
+                source->release(static_cast<size_t>(chunks[c].data() - source->data()), chunks[c].size());
+        } });
+
+    auto geometry = std::make_shared<BufferGeometry>();
+    geometry->setAttribute("position", position);
+    geometry->setAttribute("normal", normal);
+
+    return geometry;
+}
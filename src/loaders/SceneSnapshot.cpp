@@ -0,0 +1,875 @@
+#include "loaders/SceneSnapshot.h"
+#include "animation/tracks/NumberKeyframeTrack.h"
+#include "animation/tracks/QuaternionKeyframeTrack.h"
+#include "animation/tracks/VectorKeyframeTrack.h"
+#include "loaders/LoaderUtils.h"
+#include "objects/Bone.h"
+#include "objects/InstancedMesh.h"
+#include "objects/SkinnedMesh.h"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+static constexpr char MAGIC[8] = {'T', '3', 'S', 'N', 'A', 'P', 0, 0};
+static constexpr uint32_t ENDIAN_MARKER = 0x01020304;
+static constexpr size_t SECTION_COUNT = static_cast<size_t>(SceneSnapshot::Section::Count);
+
+namespace
+{
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t endianMarker;
+        uint64_t fileSize;
+        uint64_t contentHash;
+        uint32_t sectionCount;
+        uint32_t reserved;
+        uint64_t padding[3];
+    };
+
+    struct SectionEntry
+    {
+        uint32_t type;
+        uint32_t elementSize;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static_assert(sizeof(Header) == SceneSnapshot::ALIGNMENT);
+
+    size_t alignUp(size_t value)
+    {
+        return (value + SceneSnapshot::ALIGNMENT - 1) & ~(SceneSnapshot::ALIGNMENT - 1);
+    }
+
+    void requireLittleEndian()
+    {
+        if constexpr (std::endian::native != std::endian::little)
+            throw std::runtime_error("SceneSnapshot: big-endian hosts are not supported");
+    }
+
+    class Writer
+    {
+    public:
+        using S = SceneSnapshot;
+
+        Writer()
+        {
+            // offset 0 of the data section stays unused so it can mean "none"
+            m_data.resize(S::ALIGNMENT, 0);
+        }
+
+        std::vector<char> write(const Object3D &root, const std::vector<std::shared_ptr<AnimationClip>> &animations)
+        {
+            addNodes(root);
+            addSkins();
+            for (auto &clip : animations)
+                addClip(*clip);
+
+            return assemble();
+        }
+
+    private:
+        std::vector<char> m_strings;
+        std::vector<S::String> m_stringTable;
+        std::unordered_map<std::string, uint32_t> m_stringIndex;
+
+        std::vector<S::Node> m_nodes;
+        std::vector<S::Transform> m_transforms;
+        std::vector<float> m_worldMatrices;
+        std::vector<S::Geometry> m_geometries;
+        std::vector<S::Attribute> m_attributes;
+        std::vector<S::MorphTarget> m_morphTargets;
+        std::vector<S::Skin> m_skins;
+        std::vector<uint32_t> m_joints;
+        std::vector<S::SkinBinding> m_skinBindings;
+        std::vector<S::Instances> m_instances;
+        std::vector<S::Clip> m_clips;
+        std::vector<S::Channel> m_channels;
+        std::vector<char> m_data;
+
+        std::unordered_map<const Object3D *, uint32_t> m_nodeIndex;
+        std::unordered_map<const BufferGeometry *, uint32_t> m_geometryIndex;
+        std::unordered_map<const Skeleton *, uint32_t> m_skinIndex;
+        std::vector<const Skeleton *> m_skeletons;
+
+        // names and attribute names repeat and are shared; UUIDs are unique
+        // and skip the lookup
+        uint32_t addString(const std::string &value, bool shared = true)
+        {
+            if (shared)
+            {
+                auto it = m_stringIndex.find(value);
+                if (it != m_stringIndex.end())
+                    return it->second;
+            }
+
+            const uint32_t index = static_cast<uint32_t>(m_stringTable.size());
+            m_stringTable.push_back({static_cast<uint32_t>(m_strings.size()), static_cast<uint32_t>(value.size())});
+            m_strings.insert(m_strings.end(), value.begin(), value.end());
+
+            if (shared)
+                m_stringIndex.emplace(value, index);
+
+            return index;
+        }
+
+        template <typename T>
+        uint64_t addData(const T *values, size_t count)
+        {
+            m_data.resize(alignUp(m_data.size()), 0);
+            const uint64_t offset = m_data.size();
+
+            const auto *bytes = reinterpret_cast<const char *>(values);
+            m_data.insert(m_data.end(), bytes, bytes + count * sizeof(T));
+
+            return offset;
+        }
+
+        uint64_t addMatrix(const Matrix4 &matrix)
+        {
+            float elements[16];
+            matrix.toArray(elements);
+            return addData(elements, 16);
+        }
+
+        uint32_t addGeometry(const BufferGeometry &geometry)
+        {
+            auto it = m_geometryIndex.find(&geometry);
+            if (it != m_geometryIndex.end())
+                return it->second;
+
+            S::Geometry record{};
+            record.firstAttribute = static_cast<uint32_t>(m_attributes.size());
+            record.firstMorphTarget = static_cast<uint32_t>(m_morphTargets.size());
+
+            // attribute order of the map is unspecified; sort for stable output
+            std::vector<std::pair<std::string, std::shared_ptr<BufferAttribute>>> attributes(geometry.attributes().begin(), geometry.attributes().end());
+            std::sort(attributes.begin(), attributes.end(), [](const auto &a, const auto &b)
+                      { return a.first < b.first; });
+
+            for (auto &[name, attribute] : attributes)
+            {
+                S::Attribute entry{};
+                entry.name = addString(name);
+                entry.itemSize = static_cast<uint32_t>(attribute->itemSize());
+                entry.normalized = attribute->normalized() ? 1 : 0;
+                entry.count = attribute->count();
+                entry.data = addData(attribute->array(), attribute->span().size());
+                m_attributes.push_back(entry);
+            }
+
+            for (auto &target : geometry.morphTargets())
+            {
+                S::MorphTarget entry{};
+                entry.name = addString(target.name());
+                entry.hasNormals = target.hasNormals() ? 1 : 0;
+                entry.count = target.count();
+                entry.indices = addData(target.indices().data(), target.indices().size());
+                entry.positionDeltas = addData(target.positionDeltas().data(), target.positionDeltas().size());
+                entry.normalDeltas = target.hasNormals() ? addData(target.normalDeltas().data(), target.normalDeltas().size()) : 0;
+                m_morphTargets.push_back(entry);
+            }
+
+            const auto &index = geometry.getIndex();
+            record.indexCount = index.size();
+            record.index = index.empty() ? 0 : addData(index.data(), index.size());
+            record.attributeCount = static_cast<uint32_t>(m_attributes.size()) - record.firstAttribute;
+            record.morphTargetCount = static_cast<uint32_t>(m_morphTargets.size()) - record.firstMorphTarget;
+
+            const uint32_t result = static_cast<uint32_t>(m_geometries.size());
+            m_geometries.push_back(record);
+            m_geometryIndex.emplace(&geometry, result);
+
+            return result;
+        }
+
+        void addNodes(const Object3D &root)
+        {
+            // depth-first with an explicit stack; scenes can be very deep
+            std::vector<std::pair<const Object3D *, uint32_t>> stack = {{&root, S::NONE}};
+
+            while (!stack.empty())
+            {
+                const auto [object, parent] = stack.back();
+                stack.pop_back();
+
+                const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+                m_nodeIndex.emplace(object, index);
+
+                S::Node node{};
+                node.parent = parent;
+                node.type = S::NodeType::Object3D;
+                node.name = addString(object->name());
+                node.uuid = addString(object->uuid(), false);
+                node.geometry = S::NONE;
+                node.skin = S::NONE;
+                node.instances = S::NONE;
+                node.flags = 0;
+                if (object->visible)
+                    node.flags |= S::VISIBLE;
+                if (object->matrixAutoUpdate)
+                    node.flags |= S::MATRIX_AUTO_UPDATE;
+
+                if (auto *mesh = dynamic_cast<const Mesh *>(object))
+                {
+                    node.type = S::NodeType::Mesh;
+                    node.geometry = addGeometry(*mesh->geometry());
+
+                    if (!mesh->morphTargetInfluences.empty())
+                    {
+                        node.morphInfluenceCount = static_cast<uint32_t>(mesh->morphTargetInfluences.size());
+                        node.morphInfluences = addData(mesh->morphTargetInfluences.data(), mesh->morphTargetInfluences.size());
+                    }
+
+                    if (auto *skinned = dynamic_cast<const SkinnedMesh *>(object))
+                    {
+                        node.type = S::NodeType::SkinnedMesh;
+
+                        if (auto skeleton = skinned->skeleton())
+                        {
+                            auto it = m_skinIndex.find(skeleton.get());
+                            if (it == m_skinIndex.end())
+                            {
+                                it = m_skinIndex.emplace(skeleton.get(), static_cast<uint32_t>(m_skeletons.size())).first;
+                                m_skeletons.push_back(skeleton.get());
+                            }
+
+                            node.skin = static_cast<uint32_t>(m_skinBindings.size());
+                            m_skinBindings.push_back({it->second, 0, addMatrix(skinned->bindMatrix())});
+                        }
+                    }
+                    else if (auto *instanced = dynamic_cast<const InstancedMesh *>(object))
+                    {
+                        node.type = S::NodeType::InstancedMesh;
+                        node.instances = static_cast<uint32_t>(m_instances.size());
+
+                        S::Instances instances{};
+                        instances.count = instanced->count();
+                        instances.matrices = addData(instanced->instanceMatrix()->array(), instanced->instanceMatrix()->span().size());
+                        if (auto color = instanced->instanceColor())
+                            instances.colors = addData(color->array(), color->span().size());
+                        m_instances.push_back(instances);
+                    }
+                }
+                else if (dynamic_cast<const Bone *>(object) != nullptr)
+                {
+                    node.type = S::NodeType::Bone;
+                }
+
+                addTransform(*object, parent);
+                m_nodes.push_back(node);
+
+                const auto &children = object->children();
+                for (auto it = children.rbegin(); it != children.rend(); ++it)
+                    stack.emplace_back(it->get(), index);
+            }
+        }
+
+        void addTransform(const Object3D &object, uint32_t parent)
+        {
+            Vector3 position = object.position();
+            Quaternion quaternion = object.quaternion();
+            Vector3 scale = object.scale();
+
+            // nodes with a manual matrix are stored by that matrix
+            if (!object.matrixAutoUpdate)
+                object.matrix().decompose(position, quaternion, scale);
+
+            m_transforms.push_back({{static_cast<float>(position.x()), static_cast<float>(position.y()), static_cast<float>(position.z())},
+                                    {static_cast<float>(quaternion.x()), static_cast<float>(quaternion.y()), static_cast<float>(quaternion.z()), static_cast<float>(quaternion.w())},
+                                    {static_cast<float>(scale.x()), static_cast<float>(scale.y()), static_cast<float>(scale.z())}});
+
+            Matrix4 local;
+            local.compose(position, quaternion, scale);
+
+            float elements[16];
+            local.toArray(elements);
+
+            const size_t offset = m_worldMatrices.size();
+            m_worldMatrices.resize(offset + 16);
+
+            if (parent == S::NONE)
+                std::copy_n(elements, 16, m_worldMatrices.data() + offset);
+            else
+                Matrix4::multiplyMatricesArray(m_worldMatrices.data() + offset, m_worldMatrices.data() + parent * 16, elements, 1);
+        }
+
+        void addSkins()
+        {
+            for (const Skeleton *skeleton : m_skeletons)
+            {
+                S::Skin skin{};
+                skin.firstJoint = static_cast<uint32_t>(m_joints.size());
+                skin.jointCount = static_cast<uint32_t>(skeleton->boneCount());
+
+                for (auto &bone : skeleton->bones())
+                {
+                    auto it = m_nodeIndex.find(bone.get());
+                    if (it == m_nodeIndex.end())
+                        throw std::invalid_argument("SceneSnapshot: skeleton bone outside of the scene");
+                    m_joints.push_back(it->second);
+                }
+
+                std::vector<float> inverses(skeleton->boneCount() * 16);
+                for (size_t b = 0; b < skeleton->boneCount(); b++)
+                    skeleton->boneInverses()[b].toArray(inverses.data() + b * 16);
+                skin.boneInverses = addData(inverses.data(), inverses.size());
+
+                m_skins.push_back(skin);
+            }
+        }
+
+        void addClip(const AnimationClip &clip)
+        {
+            if (clip.isCompressed())
+                throw std::invalid_argument("SceneSnapshot: compressed clips cannot be stored");
+
+            S::Clip record{};
+            record.name = addString(clip.name());
+            record.uuid = addString(clip.uuid(), false);
+            record.duration = clip.duration();
+            record.firstChannel = static_cast<uint32_t>(m_channels.size());
+            record.channelCount = static_cast<uint32_t>(clip.channels().size());
+            record.timeCount = clip.packedTimes().size();
+            record.times = addData(clip.packedTimes().data(), clip.packedTimes().size());
+            record.valueCount = clip.packedValues().size();
+            record.values = addData(clip.packedValues().data(), clip.packedValues().size());
+
+            for (size_t c = 0; c < clip.channels().size(); c++)
+            {
+                const auto &channel = clip.channels()[c];
+                m_channels.push_back({addString(clip.channelNames()[c]), channel.timeOffset, channel.keyCount, channel.valueOffset, channel.valueSize,
+                                      static_cast<uint32_t>(channel.interpolation), static_cast<uint32_t>(channel.type), 0});
+            }
+
+            m_clips.push_back(record);
+        }
+
+        std::vector<char> assemble()
+        {
+            struct Source
+            {
+                const void *data;
+                size_t size;
+                size_t elementSize;
+            };
+
+            auto source = [](const auto &values)
+            {
+                using T = typename std::decay_t<decltype(values)>::value_type;
+                return Source{values.data(), values.size() * sizeof(T), sizeof(T)};
+            };
+
+            const Source sources[SECTION_COUNT] = {
+                source(m_strings),
+                source(m_stringTable),
+                source(m_nodes),
+                source(m_transforms),
+                {m_worldMatrices.data(), m_worldMatrices.size() * sizeof(float), 16 * sizeof(float)},
+                source(m_geometries),
+                source(m_attributes),
+                source(m_morphTargets),
+                source(m_skins),
+                source(m_joints),
+                source(m_skinBindings),
+                source(m_instances),
+                source(m_clips),
+                source(m_channels),
+                source(m_data),
+            };
+
+            SectionEntry entries[SECTION_COUNT];
+            size_t offset = alignUp(sizeof(Header) + sizeof(entries));
+
+            for (size_t s = 0; s < SECTION_COUNT; s++)
+            {
+                entries[s] = {static_cast<uint32_t>(s), static_cast<uint32_t>(sources[s].elementSize), offset, sources[s].size};
+                offset = alignUp(offset + sources[s].size);
+            }
+
+            std::vector<char> bytes(offset, 0);
+            std::memcpy(bytes.data() + sizeof(Header), entries, sizeof(entries));
+
+            for (size_t s = 0; s < SECTION_COUNT; s++)
+            {
+                if (sources[s].size > 0)
+                    std::memcpy(bytes.data() + entries[s].offset, sources[s].data, sources[s].size);
+            }
+
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = SceneSnapshot::VERSION;
+            header.endianMarker = ENDIAN_MARKER;
+            header.fileSize = bytes.size();
+            header.sectionCount = static_cast<uint32_t>(SECTION_COUNT);
+            header.contentHash = SceneSnapshot::hash(std::span<const char>(bytes).subspan(sizeof(Header)));
+            std::memcpy(bytes.data(), &header, sizeof(Header));
+
+            return bytes;
+        }
+    };
+}
+
+std::vector<char> SceneSnapshot::serialize(const Object3D &root, const std::vector<std::shared_ptr<AnimationClip>> &animations)
+{
+    requireLittleEndian();
+    return Writer().write(root, animations);
+}
+
+void SceneSnapshot::write(const std::string &path, const Object3D &root, const std::vector<std::shared_ptr<AnimationClip>> &animations)
+{
+    const auto bytes = serialize(root, animations);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("SceneSnapshot: cannot open " + path);
+
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!file)
+        throw std::runtime_error("SceneSnapshot: cannot write " + path);
+}
+
+uint64_t SceneSnapshot::hash(std::span<const char> bytes)
+{
+    // four independent multiply-rotate lanes over 32-byte stripes, then the tail
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t PRIME3 = 0x165667B19E3779F9ull;
+
+    const char *p = bytes.data();
+    size_t remaining = bytes.size();
+
+    uint64_t lanes[4] = {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+
+    while (remaining >= 32)
+    {
+        for (size_t k = 0; k < 4; k++)
+            lanes[k] = std::rotl(lanes[k] + LoaderUtils::readValue<uint64_t>(p + k * 8) * PRIME2, 31) * PRIME1;
+
+        p += 32;
+        remaining -= 32;
+    }
+
+    uint64_t h = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+    h += bytes.size();
+
+    while (remaining >= 8)
+    {
+        h ^= std::rotl(LoaderUtils::readValue<uint64_t>(p) * PRIME2, 31) * PRIME1;
+        h = std::rotl(h, 27) * PRIME1 + PRIME3;
+        p += 8;
+        remaining -= 8;
+    }
+
+    while (remaining > 0)
+    {
+        h ^= static_cast<uint8_t>(*p++) * PRIME3;
+        h = std::rotl(h, 11) * PRIME1;
+        remaining--;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+SceneSnapshot::SceneSnapshot(const std::string &path)
+    : m_file(path)
+{
+    m_bytes = m_file.span();
+    open();
+}
+
+SceneSnapshot::~SceneSnapshot()
+{
+}
+
+SceneSnapshot SceneSnapshot::fromBytes(std::span<const char> bytes)
+{
+    if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(uint64_t) != 0)
+        throw std::invalid_argument("SceneSnapshot: snapshot bytes must be 8-byte aligned");
+
+    SceneSnapshot snapshot;
+    snapshot.m_bytes = bytes;
+    snapshot.open();
+
+    return snapshot;
+}
+
+void SceneSnapshot::open()
+{
+    requireLittleEndian();
+
+    if (m_bytes.size() < sizeof(Header) + SECTION_COUNT * sizeof(SectionEntry))
+        throw std::runtime_error("SceneSnapshot: file too small");
+
+    Header header;
+    std::memcpy(&header, m_bytes.data(), sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("SceneSnapshot: not a snapshot");
+    if (header.version != VERSION)
+        throw std::runtime_error("SceneSnapshot: unsupported version " + std::to_string(header.version));
+    if (header.endianMarker != ENDIAN_MARKER || header.fileSize != m_bytes.size() || header.sectionCount != SECTION_COUNT)
+        throw std::runtime_error("SceneSnapshot: corrupt header");
+
+    m_version = header.version;
+    m_contentHash = header.contentHash;
+
+    // the one fixup: section offsets become views into the mapping
+
+    static constexpr size_t ELEMENT_SIZES[SECTION_COUNT] = {
+        1, sizeof(String), sizeof(Node), sizeof(Transform), 16 * sizeof(float), sizeof(Geometry), sizeof(Attribute),
+        sizeof(MorphTarget), sizeof(Skin), sizeof(uint32_t), sizeof(SkinBinding), sizeof(Instances), sizeof(Clip),
+        sizeof(Channel), 1};
+
+    for (size_t s = 0; s < SECTION_COUNT; s++)
+    {
+        SectionEntry entry;
+        std::memcpy(&entry, m_bytes.data() + sizeof(Header) + s * sizeof(SectionEntry), sizeof(SectionEntry));
+
+        if (entry.type != s || entry.elementSize != ELEMENT_SIZES[s] || entry.offset % ALIGNMENT != 0 ||
+            entry.offset > m_bytes.size() || entry.size > m_bytes.size() - entry.offset || entry.size % entry.elementSize != 0)
+            throw std::runtime_error("SceneSnapshot: corrupt section table");
+
+        m_sections[s] = m_bytes.subspan(entry.offset, entry.size);
+    }
+
+    m_data = m_sections[static_cast<size_t>(Section::Data)];
+
+    if (nodes().empty())
+        throw std::runtime_error("SceneSnapshot: no nodes");
+    if (transforms().size() != nodes().size() || worldMatrices().size() != nodes().size() * 16)
+        throw std::runtime_error("SceneSnapshot: node sections differ in size");
+}
+
+void SceneSnapshot::checkData(uint64_t offset, size_t bytes, size_t alignment) const
+{
+    if (offset > m_data.size() || bytes > m_data.size() - offset || offset % alignment != 0)
+        throw std::out_of_range("SceneSnapshot: data reference out of range");
+}
+
+uint32_t SceneSnapshot::version() const
+{
+    return m_version;
+}
+
+uint64_t SceneSnapshot::contentHash() const
+{
+    return m_contentHash;
+}
+
+bool SceneSnapshot::verify() const
+{
+    return hash(m_bytes.subspan(sizeof(Header))) == m_contentHash;
+}
+
+std::string_view SceneSnapshot::string(uint32_t index) const
+{
+    const auto table = section<String>(Section::StringTable);
+    const auto strings = m_sections[static_cast<size_t>(Section::Strings)];
+
+    if (index >= table.size() || table[index].offset > strings.size() || table[index].length > strings.size() - table[index].offset)
+        throw std::out_of_range("SceneSnapshot: string index out of range");
+
+    return std::string_view(strings.data() + table[index].offset, table[index].length);
+}
+
+std::span<const SceneSnapshot::Node> SceneSnapshot::nodes() const
+{
+    return section<Node>(Section::Nodes);
+}
+
+std::span<const SceneSnapshot::Transform> SceneSnapshot::transforms() const
+{
+    return section<Transform>(Section::Transforms);
+}
+
+std::span<const float> SceneSnapshot::worldMatrices() const
+{
+    return section<float>(Section::WorldMatrices);
+}
+
+std::span<const SceneSnapshot::Geometry> SceneSnapshot::geometries() const
+{
+    return section<Geometry>(Section::Geometries);
+}
+
+// the `count` records starting at `first`, bounds-checked
+template <typename T>
+static std::span<const T> subrange(std::span<const T> records, uint64_t first, uint64_t count)
+{
+    if (first > records.size() || count > records.size() - first)
+        throw std::out_of_range("SceneSnapshot: record range out of range");
+
+    return records.subspan(first, count);
+}
+
+std::span<const SceneSnapshot::Attribute> SceneSnapshot::attributes(const Geometry &geometry) const
+{
+    return subrange(section<Attribute>(Section::Attributes), geometry.firstAttribute, geometry.attributeCount);
+}
+
+std::span<const SceneSnapshot::MorphTarget> SceneSnapshot::morphTargets(const Geometry &geometry) const
+{
+    return subrange(section<MorphTarget>(Section::MorphTargets), geometry.firstMorphTarget, geometry.morphTargetCount);
+}
+
+std::span<const SceneSnapshot::Skin> SceneSnapshot::skins() const
+{
+    return section<Skin>(Section::Skins);
+}
+
+std::span<const uint32_t> SceneSnapshot::joints(const Skin &skin) const
+{
+    return subrange(section<uint32_t>(Section::Joints), skin.firstJoint, skin.jointCount);
+}
+
+std::span<const SceneSnapshot::SkinBinding> SceneSnapshot::skinBindings() const
+{
+    return section<SkinBinding>(Section::SkinBindings);
+}
+
+std::span<const SceneSnapshot::Instances> SceneSnapshot::instances() const
+{
+    return section<Instances>(Section::Instances);
+}
+
+std::span<const SceneSnapshot::Clip> SceneSnapshot::clips() const
+{
+    return section<Clip>(Section::Clips);
+}
+
+std::span<const SceneSnapshot::Channel> SceneSnapshot::channels(const Clip &clip) const
+{
+    return subrange(section<Channel>(Section::Channels), clip.firstChannel, clip.channelCount);
+}
+
+template <typename T>
+static std::vector<T> toVector(std::span<const T> values)
+{
+    return std::vector<T>(values.begin(), values.end());
+}
+
+std::shared_ptr<Object3D> SceneSnapshot::instantiate() const
+{
+    const auto nodeRecords = nodes();
+    const auto transformRecords = transforms();
+    const auto geometryRecords = geometries();
+
+    std::vector<std::shared_ptr<BufferGeometry>> geometryObjects(geometryRecords.size());
+
+    for (size_t g = 0; g < geometryRecords.size(); g++)
+    {
+        const auto &record = geometryRecords[g];
+        auto geometry = std::make_shared<BufferGeometry>();
+
+        for (auto &attribute : attributes(record))
+        {
+            if (attribute.itemSize == 0)
+                throw std::runtime_error("SceneSnapshot: invalid attribute");
+
+            auto values = data<float>(attribute.data, attribute.count * attribute.itemSize);
+            geometry->setAttribute(std::string(string(attribute.name)),
+                                   std::make_shared<BufferAttribute>(toVector(values), attribute.itemSize, attribute.normalized != 0));
+        }
+
+        if (record.indexCount > 0)
+            geometry->setIndex(toVector(data<uint32_t>(record.index, record.indexCount)));
+
+        for (auto &target : morphTargets(record))
+        {
+            geometry->addMorphTarget(::MorphTarget(std::string(string(target.name)),
+                                                   toVector(data<uint32_t>(target.indices, target.count)),
+                                                   toVector(data<float>(target.positionDeltas, target.count * 3)),
+                                                   target.hasNormals ? toVector(data<float>(target.normalDeltas, target.count * 3)) : std::vector<float>()));
+        }
+
+        geometryObjects[g] = geometry;
+    }
+
+    const auto geometryAt = [&geometryObjects](uint32_t index)
+    {
+        if (index >= geometryObjects.size())
+            throw std::out_of_range("SceneSnapshot: geometry index out of range");
+        return geometryObjects[index];
+    };
+
+    std::vector<std::shared_ptr<Object3D>> objects(nodeRecords.size());
+    std::vector<std::pair<SkinnedMesh *, const SkinBinding *>> bindings;
+
+    for (size_t n = 0; n < nodeRecords.size(); n++)
+    {
+        const auto &node = nodeRecords[n];
+        std::shared_ptr<Object3D> object;
+
+        switch (node.type)
+        {
+        case NodeType::Object3D:
+            object = std::make_shared<Object3D>();
+            break;
+        case NodeType::Bone:
+            object = std::make_shared<Bone>();
+            break;
+        case NodeType::Mesh:
+            object = std::make_shared<Mesh>(geometryAt(node.geometry));
+            break;
+        case NodeType::SkinnedMesh:
+        {
+            auto mesh = std::make_shared<SkinnedMesh>(geometryAt(node.geometry));
+            if (node.skin != NONE)
+            {
+                if (node.skin >= skinBindings().size())
+                    throw std::out_of_range("SceneSnapshot: skin binding out of range");
+                bindings.emplace_back(mesh.get(), &skinBindings()[node.skin]);
+            }
+            object = mesh;
+            break;
+        }
+        case NodeType::InstancedMesh:
+        {
+            if (node.instances >= instances().size())
+                throw std::out_of_range("SceneSnapshot: instances out of range");
+
+            const auto &record = instances()[node.instances];
+            auto mesh = std::make_shared<InstancedMesh>(geometryAt(node.geometry), record.count);
+            mesh->setMatricesAt(0, data<float>(record.matrices, record.count * 16));
+
+            if (record.colors != 0)
+            {
+                const auto colors = data<float>(record.colors, record.count * 3);
+                for (size_t i = 0; i < record.count; i++)
+                    mesh->setColorAt(i, colors[i * 3], colors[i * 3 + 1], colors[i * 3 + 2]);
+            }
+
+            mesh->clearUpdateRanges();
+            object = mesh;
+            break;
+        }
+        default:
+            throw std::runtime_error("SceneSnapshot: unknown node type");
+        }
+
+        object->name(std::string(string(node.name)));
+        object->uuid(std::string(string(node.uuid)));
+        object->visible = (node.flags & VISIBLE) != 0;
+        object->matrixAutoUpdate = (node.flags & MATRIX_AUTO_UPDATE) != 0;
+
+        const auto &t = transformRecords[n];
+        object->position().set(t.position[0], t.position[1], t.position[2]);
+        object->quaternion().set(t.quaternion[0], t.quaternion[1], t.quaternion[2], t.quaternion[3]);
+        object->scale().set(t.scale[0], t.scale[1], t.scale[2]);
+
+        if (!object->matrixAutoUpdate)
+            object->updateMatrix();
+
+        if (node.morphInfluenceCount > 0)
+        {
+            auto *mesh = static_cast<Mesh *>(object.get());
+            mesh->updateMorphTargets();
+            mesh->morphTargetInfluences = toVector(data<float>(node.morphInfluences, node.morphInfluenceCount));
+        }
+
+        if (n == 0)
+        {
+            if (node.parent != NONE)
+                throw std::runtime_error("SceneSnapshot: first node is not a root");
+        }
+        else
+        {
+            if (node.parent >= n)
+                throw std::runtime_error("SceneSnapshot: node precedes its parent");
+            objects[node.parent]->add(object);
+        }
+
+        objects[n] = std::move(object);
+    }
+
+    std::vector<std::shared_ptr<Skeleton>> skeletons;
+
+    for (auto &skin : skins())
+    {
+        std::vector<std::shared_ptr<Bone>> bones;
+        for (uint32_t joint : joints(skin))
+        {
+            if (joint >= objects.size() || nodeRecords[joint].type != NodeType::Bone)
+                throw std::runtime_error("SceneSnapshot: joint is not a bone");
+            bones.push_back(std::static_pointer_cast<Bone>(objects[joint]));
+        }
+
+        const auto elements = data<float>(skin.boneInverses, bones.size() * 16);
+        std::vector<Matrix4> boneInverses(bones.size());
+        for (size_t b = 0; b < bones.size(); b++)
+            boneInverses[b].fromArray(elements.data(), b * 16);
+
+        skeletons.push_back(std::make_shared<Skeleton>(std::move(bones), std::move(boneInverses)));
+    }
+
+    for (auto &[mesh, binding] : bindings)
+    {
+        if (binding->skin >= skeletons.size())
+            throw std::out_of_range("SceneSnapshot: skin out of range");
+
+        Matrix4 bindMatrix;
+        bindMatrix.fromArray(data<float>(binding->bindMatrix, 16).data());
+        mesh->bind(skeletons[binding->skin], bindMatrix);
+    }
+
+    objects.front()->updateMatrixWorld(true);
+
+    return objects.front();
+}
+
+std::vector<std::shared_ptr<AnimationClip>> SceneSnapshot::animations() const
+{
+    std::vector<std::shared_ptr<AnimationClip>> result;
+
+    for (auto &clip : clips())
+    {
+        const auto times = data<float>(clip.times, clip.timeCount);
+        const auto values = data<float>(clip.values, clip.valueCount);
+
+        std::vector<std::shared_ptr<KeyframeTrack>> tracks;
+
+        for (auto &channel : channels(clip))
+        {
+            const size_t valueCount = static_cast<size_t>(channel.keyCount) * channel.valueSize;
+            if (channel.timeOffset + static_cast<size_t>(channel.keyCount) > times.size() || channel.valueOffset + valueCount > values.size())
+                throw std::out_of_range("SceneSnapshot: channel out of range");
+
+            std::string name(string(channel.name));
+            std::vector<float> trackTimes(times.begin() + channel.timeOffset, times.begin() + channel.timeOffset + channel.keyCount);
+            std::vector<float> trackValues(values.begin() + channel.valueOffset, values.begin() + channel.valueOffset + valueCount);
+            const auto interpolation = static_cast<InterpolationMode>(channel.interpolation);
+
+            switch (static_cast<TrackValueType>(channel.type))
+            {
+            case TrackValueType::Number:
+                tracks.push_back(std::make_shared<NumberKeyframeTrack>(std::move(name), std::move(trackTimes), std::move(trackValues), interpolation));
+                break;
+            case TrackValueType::Vector:
+                tracks.push_back(std::make_shared<VectorKeyframeTrack>(std::move(name), std::move(trackTimes), std::move(trackValues), interpolation));
+                break;
+            case TrackValueType::Quaternion:
+                tracks.push_back(std::make_shared<QuaternionKeyframeTrack>(std::move(name), std::move(trackTimes), std::move(trackValues), interpolation));
+                break;
+            default:
+                throw std::runtime_error("SceneSnapshot: unknown track type");
+            }
+        }
+
+        auto animation = std::make_shared<AnimationClip>(std::string(string(clip.name)), clip.duration, std::move(tracks));
+        animation->uuid(std::string(string(clip.uuid)));
+        result.push_back(animation);
+    }
+
+    return result;
+}
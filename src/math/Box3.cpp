@@ -0,0 +1,314 @@
+#include "math/Box3.h"
+#include "math/Sphere.h"
+#include "math/Plane.h"
+#include "math/Matrix4.h"
+#include "core/BufferAttribute.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr HIGH_PRECISION _infinity = std::numeric_limits<HIGH_PRECISION>::infinity();
+
+Box3::Box3()
+    : m_min(_infinity, _infinity, _infinity), m_max(-_infinity, -_infinity, -_infinity)
+{
+}
+
+Box3::Box3(const Vector3 &min, const Vector3 &max)
+    : m_min(min.x(), min.y(), min.z()), m_max(max.x(), max.y(), max.z())
+{
+}
+
+Box3::~Box3()
+{
+}
+
+Vector3 &Box3::min()
+{
+    return m_min;
+}
+
+const Vector3 &Box3::min() const
+{
+    return m_min;
+}
+
+Vector3 &Box3::max()
+{
+    return m_max;
+}
+
+const Vector3 &Box3::max() const
+{
+    return m_max;
+}
+
+void Box3::set(const Vector3 &min, const Vector3 &max)
+{
+    m_min.copy(min);
+    m_max.copy(max);
+}
+
+void Box3::setFromArray(std::span<const float> array, size_t itemSize)
+{
+    // plain float min/max, converted once at the end
+    float minX = std::numeric_limits<float>::infinity(), minY = minX, minZ = minX;
+    float maxX = -minX, maxY = -minX, maxZ = -minX;
+
+    for (size_t i = 0; i + 2 < array.size(); i += itemSize)
+    {
+        minX = std::min(minX, array[i]);
+        minY = std::min(minY, array[i + 1]);
+        minZ = std::min(minZ, array[i + 2]);
+        maxX = std::max(maxX, array[i]);
+        maxY = std::max(maxY, array[i + 1]);
+        maxZ = std::max(maxZ, array[i + 2]);
+    }
+
+    if (minX > maxX)
+    {
+        makeEmpty();
+        return;
+    }
+
+    m_min.set(minX, minY, minZ);
+    m_max.set(maxX, maxY, maxZ);
+}
+
+void Box3::setFromBufferAttribute(const BufferAttribute &attribute)
+{
+    setFromArray(attribute.span(), attribute.itemSize());
+}
+
+void Box3::setFromPoints(const std::vector<Vector3> &points)
+{
+    makeEmpty();
+
+    for (auto &point : points)
+        expandByPoint(point);
+}
+
+void Box3::setFromCenterAndSize(const Vector3 &center, const Vector3 &size)
+{
+    const HIGH_PRECISION hx = size.x() * 0.5, hy = size.y() * 0.5, hz = size.z() * 0.5;
+
+    m_min.set(center.x() - hx, center.y() - hy, center.z() - hz);
+    m_max.set(center.x() + hx, center.y() + hy, center.z() + hz);
+}
+
+Box3 Box3::clone() const
+{
+    return Box3(m_min, m_max);
+}
+
+void Box3::copy(const Box3 &box)
+{
+    m_min.copy(box.m_min);
+    m_max.copy(box.m_max);
+}
+
+void Box3::makeEmpty()
+{
+    m_min.set(_infinity, _infinity, _infinity);
+    m_max.set(-_infinity, -_infinity, -_infinity);
+}
+
+bool Box3::isEmpty() const
+{
+    // this is a more robust check for empty than ( volume <= 0 ) because volume can get positive with two negative axes
+
+    return m_max.x() < m_min.x() || m_max.y() < m_min.y() || m_max.z() < m_min.z();
+}
+
+void Box3::getCenter(Vector3 &target) const
+{
+    if (isEmpty())
+    {
+        target.set(0, 0, 0);
+        return;
+    }
+
+    target.addVectors(m_min, m_max);
+    target.multiplyScalar(0.5);
+}
+
+void Box3::getSize(Vector3 &target) const
+{
+    if (isEmpty())
+    {
+        target.set(0, 0, 0);
+        return;
+    }
+
+    target.subVectors(m_max, m_min);
+}
+
+void Box3::expandByPoint(const Vector3 &point)
+{
+    m_min.min(point);
+    m_max.max(point);
+}
+
+void Box3::expandByVector(const Vector3 &vector)
+{
+    m_min.sub(vector);
+    m_max.add(vector);
+}
+
+void Box3::expandByScalar(HIGH_PRECISION scalar)
+{
+    m_min.addScalar(-scalar);
+    m_max.addScalar(scalar);
+}
+
+bool Box3::containsPoint(const Vector3 &point) const
+{
+    return !(point.x() < m_min.x() || point.x() > m_max.x() ||
+             point.y() < m_min.y() || point.y() > m_max.y() ||
+             point.z() < m_min.z() || point.z() > m_max.z());
+}
+
+bool Box3::containsBox(const Box3 &box) const
+{
+    return m_min.x() <= box.m_min.x() && box.m_max.x() <= m_max.x() &&
+           m_min.y() <= box.m_min.y() && box.m_max.y() <= m_max.y() &&
+           m_min.z() <= box.m_min.z() && box.m_max.z() <= m_max.z();
+}
+
+bool Box3::intersectsBox(const Box3 &box) const
+{
+    // using 6 splitting planes to rule out intersections.
+    return !(box.m_max.x() < m_min.x() || box.m_min.x() > m_max.x() ||
+             box.m_max.y() < m_min.y() || box.m_min.y() > m_max.y() ||
+             box.m_max.z() < m_min.z() || box.m_min.z() > m_max.z());
+}
+
+bool Box3::intersectsSphere(const Sphere &sphere) const
+{
+    // Find the point on the AABB closest to the sphere center.
+    Vector3 _vector;
+    clampPoint(sphere.center(), _vector);
+
+    // If that point is inside the sphere, the AABB and sphere intersect.
+    return _vector.distanceToSquared(sphere.center()) <= sphere.radius * sphere.radius;
+}
+
+bool Box3::intersectsPlane(const Plane &plane) const
+{
+    // We compute the minimum and maximum dot product values. If those values
+    // are on the same side (back or front) of the plane, then there is no intersection.
+
+    HIGH_PRECISION min, max;
+    const Vector3 &normal = plane.normal();
+
+    if (normal.x() > 0)
+    {
+        min = normal.x() * m_min.x();
+        max = normal.x() * m_max.x();
+    }
+    else
+    {
+        min = normal.x() * m_max.x();
+        max = normal.x() * m_min.x();
+    }
+
+    if (normal.y() > 0)
+    {
+        min += normal.y() * m_min.y();
+        max += normal.y() * m_max.y();
+    }
+    else
+    {
+        min += normal.y() * m_max.y();
+        max += normal.y() * m_min.y();
+    }
+
+    if (normal.z() > 0)
+    {
+        min += normal.z() * m_min.z();
+        max += normal.z() * m_max.z();
+    }
+    else
+    {
+        min += normal.z() * m_max.z();
+        max += normal.z() * m_min.z();
+    }
+
+    return (min <= -plane.constant && max >= -plane.constant);
+}
+
+void Box3::clampPoint(const Vector3 &point, Vector3 &target) const
+{
+    target.copy(point);
+    target.clamp(m_min, m_max);
+}
+
+HIGH_PRECISION Box3::distanceToPoint(const Vector3 &point) const
+{
+    Vector3 _vector;
+    clampPoint(point, _vector);
+    return _vector.distanceTo(point);
+}
+
+void Box3::getBoundingSphere(Sphere &target) const
+{
+    if (isEmpty())
+    {
+        target.makeEmpty();
+        return;
+    }
+
+    getCenter(target.center());
+
+    Vector3 _size;
+    getSize(_size);
+    target.radius = _size.length() * 0.5;
+}
+
+void Box3::intersect(const Box3 &box)
+{
+    m_min.max(box.m_min);
+    m_max.min(box.m_max);
+
+    // ensure that if there is no overlap, the result is fully empty, not slightly empty with non-inf/+inf values that will cause subsequence intersects to erroneously return valid values.
+    if (isEmpty())
+        makeEmpty();
+}
+
+void Box3::unionBox(const Box3 &box)
+{
+    m_min.min(box.m_min);
+    m_max.max(box.m_max);
+}
+
+void Box3::applyMatrix4(const Matrix4 &matrix)
+{
+    // transform of empty box is an empty box.
+    if (isEmpty())
+        return;
+
+    const HIGH_PRECISION xs[2] = {m_min.x(), m_max.x()};
+    const HIGH_PRECISION ys[2] = {m_min.y(), m_max.y()};
+    const HIGH_PRECISION zs[2] = {m_min.z(), m_max.z()};
+
+    makeEmpty();
+
+    Vector3 _point;
+    for (size_t i = 0; i < 8; i++)
+    {
+        _point.set(xs[i & 1], ys[(i >> 1) & 1], zs[(i >> 2) & 1]);
+        _point.applyMatrix4(matrix);
+        expandByPoint(_point);
+    }
+}
+
+void Box3::translate(const Vector3 &offset)
+{
+    m_min.add(offset);
+    m_max.add(offset);
+}
+
+bool Box3::equals(const Box3 &box) const
+{
+    return box.m_min.equals(m_min) && box.m_max.equals(m_max);
+}
@@ -0,0 +1,544 @@
+#include "math/Color.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// values per task for the batch conversions
+static constexpr size_t VALUE_GRAIN = 65536;
+
+// log2(1 + t) / t on [√½ - 1, √2 - 1] and 2^f on [-½, ½], least-squares
+// minimax fits; x^p = 2^(p·log2 x) stays within 1e-6 relative error
+static constexpr float LOG2_C[7] = {1.44269973f, -0.721375871f, 0.480465014f, -0.358961895f, 0.297262908f, -0.272697536f, 0.170632828f};
+static constexpr float EXP2_C[6] = {1.00000007f, 0.693146967f, 0.240221197f, 0.0555071329f, 0.0096755413f, 0.00132764665f};
+static constexpr float SQRT2 = 1.41421356f;
+
+static constexpr float SRGB_THRESHOLD = 0.04045f;
+static constexpr float LINEAR_THRESHOLD = 0.0031308f;
+
+// the scalar versions do the same float operations in the same order as
+// the SSE versions, so both paths return identical results
+
+static inline float fastLog2(float x)
+{
+    const uint32_t bits = std::bit_cast<uint32_t>(x);
+    int exponent = static_cast<int>(bits >> 23) - 127;
+    float m = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000);
+
+    if (m > SQRT2)
+    {
+        m = m * 0.5f;
+        exponent += 1;
+    }
+
+    const float t = m - 1.0f;
+    float p = LOG2_C[6];
+    for (int k = 5; k >= 0; k--)
+        p = p * t + LOG2_C[k];
+
+    return static_cast<float>(exponent) + t * p;
+}
+
+static inline float fastExp2(float y)
+{
+    y = std::clamp(y, -126.0f, 127.0f);
+
+    const float n = std::nearbyint(y);
+    const float f = y - n;
+
+    float p = EXP2_C[5];
+    for (int k = 4; k >= 0; k--)
+        p = p * f + EXP2_C[k];
+
+    return p * std::bit_cast<float>(static_cast<uint32_t>(static_cast<int>(n) + 127) << 23);
+}
+
+static inline float fastPow(float x, float exponent)
+{
+    return fastExp2(exponent * fastLog2(x));
+}
+
+#if defined(__SSE2__)
+static inline __m128 fastLog2(__m128 x)
+{
+    const __m128i bits = _mm_castps_si128(x);
+    __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+
+    const __m128 above = _mm_cmpgt_ps(m, _mm_set1_ps(SQRT2));
+    m = _mm_or_ps(_mm_and_ps(above, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(above, m));
+    exponent = _mm_sub_epi32(exponent, _mm_castps_si128(above));
+
+    const __m128 t = _mm_sub_ps(m, _mm_set1_ps(1.0f));
+    __m128 p = _mm_set1_ps(LOG2_C[6]);
+    for (int k = 5; k >= 0; k--)
+        p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C[k]));
+
+    return _mm_add_ps(_mm_cvtepi32_ps(exponent), _mm_mul_ps(t, p));
+}
+
+static inline __m128 fastExp2(__m128 y)
+{
+    y = _mm_min_ps(_mm_max_ps(y, _mm_set1_ps(-126.0f)), _mm_set1_ps(127.0f));
+
+    // round to nearest, as nearbyint in the default rounding mode
+    const __m128i n = _mm_cvtps_epi32(y);
+    const __m128 f = _mm_sub_ps(y, _mm_cvtepi32_ps(n));
+
+    __m128 p = _mm_set1_ps(EXP2_C[5]);
+    for (int k = 4; k >= 0; k--)
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(EXP2_C[k]));
+
+    const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+    return _mm_mul_ps(p, scale);
+}
+
+static inline __m128 fastPow(__m128 x, float exponent)
+{
+    return fastExp2(_mm_mul_ps(_mm_set1_ps(exponent), fastLog2(x)));
+}
+
+static inline __m128 select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 SRGBToLinear4(__m128 c)
+{
+    const __m128 low = _mm_mul_ps(c, _mm_set1_ps(0.0773993808f));
+    // the pow branch is discarded below the threshold; keep its input positive
+    const __m128 base = _mm_max_ps(_mm_add_ps(_mm_mul_ps(c, _mm_set1_ps(0.9478672986f)), _mm_set1_ps(0.0521327014f)), _mm_set1_ps(SRGB_THRESHOLD));
+
+    return select(_mm_cmplt_ps(c, _mm_set1_ps(SRGB_THRESHOLD)), low, fastPow(base, 2.4f));
+}
+
+static inline __m128 LinearToSRGB4(__m128 c)
+{
+    const __m128 low = _mm_mul_ps(c, _mm_set1_ps(12.92f));
+    const __m128 high = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.055f), fastPow(_mm_max_ps(c, _mm_set1_ps(LINEAR_THRESHOLD)), 0.41666f)), _mm_set1_ps(0.055f));
+
+    return select(_mm_cmplt_ps(c, _mm_set1_ps(LINEAR_THRESHOLD)), low, high);
+}
+#endif
+
+static void SRGBToLinearChunk(const float *values, float *result, size_t count)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(result + i, SRGBToLinear4(_mm_loadu_ps(values + i)));
+#endif
+
+    for (; i < count; i++)
+        result[i] = Color::SRGBToLinear(values[i]);
+}
+
+static void LinearToSRGBChunk(const float *values, float *result, size_t count)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(result + i, LinearToSRGB4(_mm_loadu_ps(values + i)));
+#endif
+
+    for (; i < count; i++)
+        result[i] = Color::LinearToSRGB(values[i]);
+}
+
+static void LinearToSRGB8Chunk(const float *values, uint8_t *result, size_t count)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 c = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(values + i), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        const __m128 scaled = _mm_add_ps(_mm_mul_ps(LinearToSRGB4(c), _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+        const __m128i words = _mm_packs_epi32(_mm_cvttps_epi32(scaled), _mm_setzero_si128());
+        const uint32_t packed = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(words, _mm_setzero_si128())));
+
+        result[i] = static_cast<uint8_t>(packed);
+        result[i + 1] = static_cast<uint8_t>(packed >> 8);
+        result[i + 2] = static_cast<uint8_t>(packed >> 16);
+        result[i + 3] = static_cast<uint8_t>(packed >> 24);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float c = std::clamp(values[i], 0.0f, 1.0f);
+        result[i] = static_cast<uint8_t>(static_cast<int>(Color::LinearToSRGB(c) * 255.0f + 0.5f));
+    }
+}
+
+static float hue2rgb(float p, float q, float t)
+{
+    if (t < 0)
+        t += 1;
+    if (t > 1)
+        t -= 1;
+    if (t < 1.0f / 6)
+        return p + (q - p) * 6 * t;
+    if (t < 1.0f / 2)
+        return q;
+    if (t < 2.0f / 3)
+        return p + (q - p) * 6 * (2.0f / 3 - t);
+    return p;
+}
+
+Color::Color()
+{
+}
+
+Color::Color(float r, float g, float b)
+{
+    setRGB(r, g, b);
+}
+
+Color::Color(uint32_t hex)
+{
+    setHex(hex);
+}
+
+Color::~Color()
+{
+}
+
+Color &Color::setScalar(float scalar)
+{
+    r = scalar;
+    g = scalar;
+    b = scalar;
+    return *this;
+}
+
+Color &Color::setHex(uint32_t hex, ColorSpace colorSpace)
+{
+    r = static_cast<float>((hex >> 16) & 255) / 255;
+    g = static_cast<float>((hex >> 8) & 255) / 255;
+    b = static_cast<float>(hex & 255) / 255;
+
+    if (colorSpace == ColorSpace::SRGB)
+        convertSRGBToLinear();
+
+    return *this;
+}
+
+Color &Color::setRGB(float r, float g, float b, ColorSpace colorSpace)
+{
+    this->r = r;
+    this->g = g;
+    this->b = b;
+
+    if (colorSpace == ColorSpace::SRGB)
+        convertSRGBToLinear();
+
+    return *this;
+}
+
+Color &Color::setHSL(float h, float s, float l, ColorSpace colorSpace)
+{
+    h = h - std::floor(h);
+    s = std::clamp(s, 0.0f, 1.0f);
+    l = std::clamp(l, 0.0f, 1.0f);
+
+    if (s == 0)
+    {
+        r = g = b = l;
+    }
+    else
+    {
+        const float p = l <= 0.5f ? l * (1 + s) : l + s - (l * s);
+        const float q = (2 * l) - p;
+
+        r = hue2rgb(q, p, h + 1.0f / 3);
+        g = hue2rgb(q, p, h);
+        b = hue2rgb(q, p, h - 1.0f / 3);
+    }
+
+    if (colorSpace == ColorSpace::SRGB)
+        convertSRGBToLinear();
+
+    return *this;
+}
+
+Color Color::clone() const
+{
+    return *this;
+}
+
+Color &Color::copy(const Color &color)
+{
+    r = color.r;
+    g = color.g;
+    b = color.b;
+    return *this;
+}
+
+Color &Color::copySRGBToLinear(const Color &color)
+{
+    r = SRGBToLinear(color.r);
+    g = SRGBToLinear(color.g);
+    b = SRGBToLinear(color.b);
+    return *this;
+}
+
+Color &Color::copyLinearToSRGB(const Color &color)
+{
+    r = LinearToSRGB(color.r);
+    g = LinearToSRGB(color.g);
+    b = LinearToSRGB(color.b);
+    return *this;
+}
+
+Color &Color::convertSRGBToLinear()
+{
+    return copySRGBToLinear(*this);
+}
+
+Color &Color::convertLinearToSRGB()
+{
+    return copyLinearToSRGB(*this);
+}
+
+uint32_t Color::getHex(ColorSpace colorSpace) const
+{
+    const Color c = getRGB(colorSpace);
+
+    const auto byte = [](float value)
+    {
+        return static_cast<uint32_t>(std::round(std::clamp(value * 255, 0.0f, 255.0f)));
+    };
+
+    return byte(c.r) << 16 | byte(c.g) << 8 | byte(c.b);
+}
+
+std::string Color::getHexString(ColorSpace colorSpace) const
+{
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "%06x", getHex(colorSpace));
+    return buffer;
+}
+
+Color::HSL Color::getHSL(ColorSpace colorSpace) const
+{
+    const Color c = getRGB(colorSpace);
+
+    const float max = std::max({c.r, c.g, c.b});
+    const float min = std::min({c.r, c.g, c.b});
+
+    HSL hsl;
+    hsl.l = (min + max) / 2;
+
+    if (min == max)
+        return hsl;
+
+    const float delta = max - min;
+    hsl.s = hsl.l <= 0.5f ? delta / (max + min) : delta / (2 - max - min);
+
+    if (max == c.r)
+        hsl.h = (c.g - c.b) / delta + (c.g < c.b ? 6 : 0);
+    else if (max == c.g)
+        hsl.h = (c.b - c.r) / delta + 2;
+    else
+        hsl.h = (c.r - c.g) / delta + 4;
+
+    hsl.h /= 6;
+
+    return hsl;
+}
+
+Color Color::getRGB(ColorSpace colorSpace) const
+{
+    Color c = *this;
+
+    if (colorSpace == ColorSpace::SRGB)
+        c.convertLinearToSRGB();
+
+    return c;
+}
+
+Color &Color::offsetHSL(float h, float s, float l)
+{
+    const HSL hsl = getHSL();
+    return setHSL(hsl.h + h, hsl.s + s, hsl.l + l);
+}
+
+Color &Color::add(const Color &color)
+{
+    r += color.r;
+    g += color.g;
+    b += color.b;
+    return *this;
+}
+
+Color &Color::addColors(const Color &color1, const Color &color2)
+{
+    r = color1.r + color2.r;
+    g = color1.g + color2.g;
+    b = color1.b + color2.b;
+    return *this;
+}
+
+Color &Color::addScalar(float s)
+{
+    r += s;
+    g += s;
+    b += s;
+    return *this;
+}
+
+Color &Color::sub(const Color &color)
+{
+    r = std::max(0.0f, r - color.r);
+    g = std::max(0.0f, g - color.g);
+    b = std::max(0.0f, b - color.b);
+    return *this;
+}
+
+Color &Color::multiply(const Color &color)
+{
+    r *= color.r;
+    g *= color.g;
+    b *= color.b;
+    return *this;
+}
+
+Color &Color::multiplyScalar(float s)
+{
+    r *= s;
+    g *= s;
+    b *= s;
+    return *this;
+}
+
+Color &Color::lerp(const Color &color, float alpha)
+{
+    r += (color.r - r) * alpha;
+    g += (color.g - g) * alpha;
+    b += (color.b - b) * alpha;
+    return *this;
+}
+
+Color &Color::lerpColors(const Color &color1, const Color &color2, float alpha)
+{
+    r = color1.r + (color2.r - color1.r) * alpha;
+    g = color1.g + (color2.g - color1.g) * alpha;
+    b = color1.b + (color2.b - color1.b) * alpha;
+    return *this;
+}
+
+Color &Color::lerpHSL(const Color &color, float alpha)
+{
+    const HSL a = getHSL();
+    const HSL b = color.getHSL();
+
+    return setHSL(a.h + (b.h - a.h) * alpha, a.s + (b.s - a.s) * alpha, a.l + (b.l - a.l) * alpha);
+}
+
+bool Color::equals(const Color &color) const
+{
+    return color.r == r && color.g == g && color.b == b;
+}
+
+Color &Color::fromArray(const float *array, size_t offset)
+{
+    r = array[offset];
+    g = array[offset + 1];
+    b = array[offset + 2];
+    return *this;
+}
+
+void Color::toArray(float *array, size_t offset) const
+{
+    array[offset] = r;
+    array[offset + 1] = g;
+    array[offset + 2] = b;
+}
+
+float Color::SRGBToLinear(float c)
+{
+    if (c < SRGB_THRESHOLD)
+        return c * 0.0773993808f;
+
+    return fastPow(c * 0.9478672986f + 0.0521327014f, 2.4f);
+}
+
+float Color::LinearToSRGB(float c)
+{
+    if (c < LINEAR_THRESHOLD)
+        return c * 12.92f;
+
+    return 1.055f * fastPow(c, 0.41666f) - 0.055f;
+}
+
+void Color::SRGBToLinear(std::span<const float> values, std::span<float> result)
+{
+    if (result.size() < values.size())
+        throw std::invalid_argument("Color: result is smaller than values");
+
+    const float *src = values.data();
+    float *dst = result.data();
+
+    Parallel::parallelFor(0, values.size(), VALUE_GRAIN, [src, dst](size_t begin, size_t end)
+                          { SRGBToLinearChunk(src + begin, dst + begin, end - begin); });
+}
+
+void Color::LinearToSRGB(std::span<const float> values, std::span<float> result)
+{
+    if (result.size() < values.size())
+        throw std::invalid_argument("Color: result is smaller than values");
+
+    const float *src = values.data();
+    float *dst = result.data();
+
+    Parallel::parallelFor(0, values.size(), VALUE_GRAIN, [src, dst](size_t begin, size_t end)
+                          { LinearToSRGBChunk(src + begin, dst + begin, end - begin); });
+}
+
+void Color::SRGB8ToLinear(std::span<const uint8_t> values, std::span<float> result)
+{
+    if (result.size() < values.size())
+        throw std::invalid_argument("Color: result is smaller than values");
+
+    // exact conversions of the 256 possible inputs
+    static const std::array<float, 256> table = []()
+    {
+        std::array<float, 256> t;
+        for (size_t i = 0; i < 256; i++)
+        {
+            const double c = static_cast<double>(i) / 255;
+            t[i] = static_cast<float>(c < 0.04045 ? c * 0.0773993808 : std::pow(c * 0.9478672986 + 0.0521327014, 2.4));
+        }
+        return t;
+    }();
+
+    const uint8_t *src = values.data();
+    float *dst = result.data();
+
+    Parallel::parallelFor(0, values.size(), VALUE_GRAIN, [src, dst](size_t begin, size_t end)
+                          {
+        for (size_t i = begin; i < end; i++)
+            dst[i] = table[src[i]]; });
+}
+
+void Color::LinearToSRGB8(std::span<const float> values, std::span<uint8_t> result)
+{
+    if (result.size() < values.size())
+        throw std::invalid_argument("Color: result is smaller than values");
+
+    const float *src = values.data();
+    uint8_t *dst = result.data();
+
+    Parallel::parallelFor(0, values.size(), VALUE_GRAIN, [src, dst](size_t begin, size_t end)
+                          { LinearToSRGB8Chunk(src + begin, dst + begin, end - begin); });
+}
@@ -0,0 +1,312 @@
+#include "math/FloatingOrigin.h"
+#include "common/Parallel.h"
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// matrices and positions per task; the kernels are memory bound
+static constexpr size_t MATRIX_GRAIN = 4096;
+static constexpr size_t VALUE_GRAIN = 65536;
+
+namespace
+{
+    void rebaseMatricesChunk(const double *world, float *out, size_t count, const double *origin)
+    {
+        for (size_t m = 0; m < count; m++, world += 16, out += 16)
+        {
+#if defined(__SSE2__)
+            auto pack = [](__m128d a, __m128d b)
+            { return _mm_movelh_ps(_mm_cvtpd_ps(a), _mm_cvtpd_ps(b)); };
+
+            // the upper 3x3 part and the last row convert as they are
+            _mm_storeu_ps(out + 0, pack(_mm_loadu_pd(world + 0), _mm_loadu_pd(world + 2)));
+            _mm_storeu_ps(out + 4, pack(_mm_loadu_pd(world + 4), _mm_loadu_pd(world + 6)));
+            _mm_storeu_ps(out + 8, pack(_mm_loadu_pd(world + 8), _mm_loadu_pd(world + 10)));
+
+            const __m128d txy = _mm_sub_pd(_mm_loadu_pd(world + 12), _mm_loadu_pd(origin));
+            const __m128d tzw = _mm_sub_pd(_mm_loadu_pd(world + 14), _mm_set_pd(0.0, origin[2]));
+            _mm_storeu_ps(out + 12, pack(txy, tzw));
+#else
+            for (size_t i = 0; i < 12; i++)
+                out[i] = static_cast<float>(world[i]);
+
+            out[12] = static_cast<float>(world[12] - origin[0]);
+            out[13] = static_cast<float>(world[13] - origin[1]);
+            out[14] = static_cast<float>(world[14] - origin[2]);
+            out[15] = static_cast<float>(world[15]);
+#endif
+        }
+    }
+
+    void rebasePositionsChunk(const double *positions, float *out, size_t count, const double *origin)
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        // two positions are six values, three pairs that each see the origin
+        // rotated by one component
+        const __m128d oxy = _mm_set_pd(origin[1], origin[0]);
+        const __m128d ozx = _mm_set_pd(origin[0], origin[2]);
+        const __m128d oyz = _mm_set_pd(origin[2], origin[1]);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            const double *p = positions + i * 3;
+            float *o = out + i * 3;
+
+            const __m128 a = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 0), oxy));
+            const __m128 b = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 2), ozx));
+            const __m128 c = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 4), oyz));
+
+            _mm_storeu_ps(o, _mm_movelh_ps(a, b));
+            _mm_storel_pi(reinterpret_cast<__m64 *>(o + 4), c);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            out[i * 3 + 0] = static_cast<float>(positions[i * 3 + 0] - origin[0]);
+            out[i * 3 + 1] = static_cast<float>(positions[i * 3 + 1] - origin[1]);
+            out[i * 3 + 2] = static_cast<float>(positions[i * 3 + 2] - origin[2]);
+        }
+    }
+
+    void rebaseSpheresChunk(const double *spheres, float *out, size_t count, const double *origin)
+    {
+#if defined(__SSE2__)
+        const __m128d oxy = _mm_loadu_pd(origin);
+        const __m128d oz = _mm_set_pd(0.0, origin[2]);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const __m128 xy = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(spheres + i * 4), oxy));
+            const __m128 zr = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(spheres + i * 4 + 2), oz));
+            _mm_storeu_ps(out + i * 4, _mm_movelh_ps(xy, zr));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i * 4 + 0] = static_cast<float>(spheres[i * 4 + 0] - origin[0]);
+            out[i * 4 + 1] = static_cast<float>(spheres[i * 4 + 1] - origin[1]);
+            out[i * 4 + 2] = static_cast<float>(spheres[i * 4 + 2] - origin[2]);
+            out[i * 4 + 3] = static_cast<float>(spheres[i * 4 + 3]);
+        }
+#endif
+    }
+
+    void rebaseSplitChunk(const float *high, const float *low, float *out, size_t count, const float *originHigh, const float *originLow)
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        // four positions are twelve values, three vectors with the origin
+        // rotated by one component each
+        const __m128 hA = _mm_setr_ps(originHigh[0], originHigh[1], originHigh[2], originHigh[0]);
+        const __m128 hB = _mm_setr_ps(originHigh[1], originHigh[2], originHigh[0], originHigh[1]);
+        const __m128 hC = _mm_setr_ps(originHigh[2], originHigh[0], originHigh[1], originHigh[2]);
+        const __m128 lA = _mm_setr_ps(originLow[0], originLow[1], originLow[2], originLow[0]);
+        const __m128 lB = _mm_setr_ps(originLow[1], originLow[2], originLow[0], originLow[1]);
+        const __m128 lC = _mm_setr_ps(originLow[2], originLow[0], originLow[1], originLow[2]);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const size_t v = i * 3;
+            _mm_storeu_ps(out + v + 0, _mm_add_ps(_mm_sub_ps(_mm_loadu_ps(high + v + 0), hA), _mm_sub_ps(_mm_loadu_ps(low + v + 0), lA)));
+            _mm_storeu_ps(out + v + 4, _mm_add_ps(_mm_sub_ps(_mm_loadu_ps(high + v + 4), hB), _mm_sub_ps(_mm_loadu_ps(low + v + 4), lB)));
+            _mm_storeu_ps(out + v + 8, _mm_add_ps(_mm_sub_ps(_mm_loadu_ps(high + v + 8), hC), _mm_sub_ps(_mm_loadu_ps(low + v + 8), lC)));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            for (size_t c = 0; c < 3; c++)
+                out[i * 3 + c] = (high[i * 3 + c] - originHigh[c]) + (low[i * 3 + c] - originLow[c]);
+        }
+    }
+
+    void splitChunk(const double *values, float *high, float *low, size_t count)
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        for (; i + 2 <= count; i += 2)
+        {
+            const __m128d v = _mm_loadu_pd(values + i);
+            const __m128 h = _mm_cvtpd_ps(v);
+            const __m128 l = _mm_cvtpd_ps(_mm_sub_pd(v, _mm_cvtps_pd(h)));
+
+            _mm_storel_pi(reinterpret_cast<__m64 *>(high + i), h);
+            _mm_storel_pi(reinterpret_cast<__m64 *>(low + i), l);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            high[i] = static_cast<float>(values[i]);
+            low[i] = static_cast<float>(values[i] - static_cast<double>(high[i]));
+        }
+    }
+}
+
+FloatingOrigin::FloatingOrigin(double threshold)
+{
+    setThreshold(threshold);
+}
+
+const std::array<double, 3> &FloatingOrigin::origin() const
+{
+    return m_origin;
+}
+
+void FloatingOrigin::setOrigin(const std::array<double, 3> &origin)
+{
+    m_origin = origin;
+    split(m_origin, m_originHigh, m_originLow);
+    m_version++;
+}
+
+bool FloatingOrigin::update(const std::array<double, 3> &position)
+{
+    bool far = false;
+    for (size_t i = 0; i < 3; i++)
+        far = far || std::abs(position[i] - m_origin[i]) > m_threshold;
+
+    if (!far)
+        return false;
+
+    std::array<double, 3> origin;
+    for (size_t i = 0; i < 3; i++)
+        origin[i] = std::round(position[i] / m_threshold) * m_threshold;
+
+    setOrigin(origin);
+    return true;
+}
+
+double FloatingOrigin::threshold() const
+{
+    return m_threshold;
+}
+
+void FloatingOrigin::setThreshold(double threshold)
+{
+    if (!(threshold > 0))
+        throw std::invalid_argument("FloatingOrigin: threshold must be positive");
+
+    m_threshold = threshold;
+}
+
+uint32_t FloatingOrigin::version() const
+{
+    return m_version;
+}
+
+Matrix4 FloatingOrigin::rebase(std::span<const double, 16> world) const
+{
+    double relative[16];
+    for (size_t i = 0; i < 16; i++)
+        relative[i] = world[i];
+
+    relative[12] -= m_origin[0];
+    relative[13] -= m_origin[1];
+    relative[14] -= m_origin[2];
+
+    Matrix4 matrix;
+    matrix.fromArray(relative);
+    return matrix;
+}
+
+Matrix4 FloatingOrigin::viewMatrix(std::span<const double, 16> cameraWorld) const
+{
+    // the rebased translation is small, so the inverse is exact enough in
+    // any precision
+    Matrix4 view = rebase(cameraWorld);
+    view.invert();
+    return view;
+}
+
+void FloatingOrigin::rebaseMatrices(std::span<const double> world, std::span<float> result) const
+{
+    if (world.size() % 16 != 0)
+        throw std::invalid_argument("FloatingOrigin: world matrices need 16 values each");
+    if (result.size() < world.size())
+        throw std::invalid_argument("FloatingOrigin: result is smaller than world");
+
+    const double *src = world.data();
+    float *dst = result.data();
+    const double *origin = m_origin.data();
+
+    Parallel::parallelFor(0, world.size() / 16, MATRIX_GRAIN, [src, dst, origin](size_t begin, size_t end)
+                          { rebaseMatricesChunk(src + begin * 16, dst + begin * 16, end - begin, origin); });
+}
+
+void FloatingOrigin::rebasePositions(std::span<const double> positions, std::span<float> result) const
+{
+    if (positions.size() % 3 != 0)
+        throw std::invalid_argument("FloatingOrigin: positions need 3 values each");
+    if (result.size() < positions.size())
+        throw std::invalid_argument("FloatingOrigin: result is smaller than positions");
+
+    const double *src = positions.data();
+    float *dst = result.data();
+    const double *origin = m_origin.data();
+
+    Parallel::parallelFor(0, positions.size() / 3, VALUE_GRAIN, [src, dst, origin](size_t begin, size_t end)
+                          { rebasePositionsChunk(src + begin * 3, dst + begin * 3, end - begin, origin); });
+}
+
+void FloatingOrigin::rebaseSpheres(std::span<const double> spheres, std::span<float> result) const
+{
+    if (spheres.size() % 4 != 0)
+        throw std::invalid_argument("FloatingOrigin: spheres need 4 values each");
+    if (result.size() < spheres.size())
+        throw std::invalid_argument("FloatingOrigin: result is smaller than spheres");
+
+    const double *src = spheres.data();
+    float *dst = result.data();
+    const double *origin = m_origin.data();
+
+    Parallel::parallelFor(0, spheres.size() / 4, VALUE_GRAIN, [src, dst, origin](size_t begin, size_t end)
+                          { rebaseSpheresChunk(src + begin * 4, dst + begin * 4, end - begin, origin); });
+}
+
+void FloatingOrigin::rebaseSplitPositions(std::span<const float> high, std::span<const float> low, std::span<float> result) const
+{
+    if (high.size() % 3 != 0 || low.size() != high.size())
+        throw std::invalid_argument("FloatingOrigin: high and low need 3 values per position each");
+    if (result.size() < high.size())
+        throw std::invalid_argument("FloatingOrigin: result is smaller than high");
+
+    const float *h = high.data();
+    const float *l = low.data();
+    float *dst = result.data();
+    const float *originHigh = m_originHigh.data();
+    const float *originLow = m_originLow.data();
+
+    Parallel::parallelFor(0, high.size() / 3, VALUE_GRAIN, [h, l, dst, originHigh, originLow](size_t begin, size_t end)
+                          { rebaseSplitChunk(h + begin * 3, l + begin * 3, dst + begin * 3, end - begin, originHigh, originLow); });
+}
+
+void FloatingOrigin::splitOrigin(float *high, float *low) const
+{
+    for (size_t i = 0; i < 3; i++)
+    {
+        high[i] = m_originHigh[i];
+        low[i] = m_originLow[i];
+    }
+}
+
+void FloatingOrigin::split(std::span<const double> values, std::span<float> high, std::span<float> low)
+{
+    if (high.size() < values.size() || low.size() < values.size())
+        throw std::invalid_argument("FloatingOrigin: high or low is smaller than values");
+
+    const double *src = values.data();
+    float *h = high.data();
+    float *l = low.data();
+
+    Parallel::parallelFor(0, values.size(), VALUE_GRAIN, [src, h, l](size_t begin, size_t end)
+                          { splitChunk(src + begin, h + begin, l + begin, end - begin); });
+}
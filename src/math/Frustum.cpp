@@ -0,0 +1,188 @@
+#include "math/Frustum.h"
+#include "math/Matrix4.h"
+#include "math/Sphere.h"
+#include "math/Box3.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+Frustum::Frustum()
+{
+    pack();
+}
+
+Frustum::Frustum(const Plane &p0, const Plane &p1, const Plane &p2, const Plane &p3, const Plane &p4, const Plane &p5)
+{
+    set(p0, p1, p2, p3, p4, p5);
+}
+
+Frustum::~Frustum()
+{
+}
+
+const std::array<Plane, 6> &Frustum::planes() const
+{
+    return m_planes;
+}
+
+void Frustum::set(const Plane &p0, const Plane &p1, const Plane &p2, const Plane &p3, const Plane &p4, const Plane &p5)
+{
+    m_planes[0].copy(p0);
+    m_planes[1].copy(p1);
+    m_planes[2].copy(p2);
+    m_planes[3].copy(p3);
+    m_planes[4].copy(p4);
+    m_planes[5].copy(p5);
+
+    pack();
+}
+
+void Frustum::copy(const Frustum &frustum)
+{
+    for (size_t i = 0; i < 6; i++)
+        m_planes[i].copy(frustum.m_planes[i]);
+
+    pack();
+}
+
+void Frustum::setFromProjectionMatrix(const Matrix4 &m)
+{
+    auto me = m.elements();
+    const HIGH_PRECISION me0 = me[0], me1 = me[1], me2 = me[2], me3 = me[3];
+    const HIGH_PRECISION me4 = me[4], me5 = me[5], me6 = me[6], me7 = me[7];
+    const HIGH_PRECISION me8 = me[8], me9 = me[9], me10 = me[10], me11 = me[11];
+    const HIGH_PRECISION me12 = me[12], me13 = me[13], me14 = me[14], me15 = me[15];
+
+    m_planes[0].setComponents(me3 - me0, me7 - me4, me11 - me8, me15 - me12);
+    m_planes[1].setComponents(me3 + me0, me7 + me4, me11 + me8, me15 + me12);
+    m_planes[2].setComponents(me3 + me1, me7 + me5, me11 + me9, me15 + me13);
+    m_planes[3].setComponents(me3 - me1, me7 - me5, me11 - me9, me15 - me13);
+    m_planes[4].setComponents(me3 - me2, me7 - me6, me11 - me10, me15 - me14);
+    m_planes[5].setComponents(me3 + me2, me7 + me6, me11 + me10, me15 + me14);
+
+    for (auto &plane : m_planes)
+        plane.normalize();
+
+    pack();
+}
+
+bool Frustum::intersectsSphere(const Sphere &sphere) const
+{
+    const Vector3 &center = sphere.center();
+    const HIGH_PRECISION negRadius = -sphere.radius;
+
+    for (auto &plane : m_planes)
+    {
+        const HIGH_PRECISION distance = plane.distanceToPoint(center);
+
+        if (distance < negRadius)
+            return false;
+    }
+
+    return true;
+}
+
+bool Frustum::intersectsBox(const Box3 &box) const
+{
+    Vector3 _vector;
+
+    for (auto &plane : m_planes)
+    {
+        // corner at max distance
+        const Vector3 &normal = plane.normal();
+
+        _vector.setX(normal.x() > 0 ? box.max().x() : box.min().x());
+        _vector.setY(normal.y() > 0 ? box.max().y() : box.min().y());
+        _vector.setZ(normal.z() > 0 ? box.max().z() : box.min().z());
+
+        if (plane.distanceToPoint(_vector) < 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool Frustum::containsPoint(const Vector3 &point) const
+{
+    for (auto &plane : m_planes)
+    {
+        if (plane.distanceToPoint(point) < 0)
+            return false;
+    }
+
+    return true;
+}
+
+void Frustum::pack()
+{
+    for (size_t i = 0; i < 6; i++)
+    {
+        m_packed[i][0] = static_cast<float>(m_planes[i].normal().x());
+        m_packed[i][1] = static_cast<float>(m_planes[i].normal().y());
+        m_packed[i][2] = static_cast<float>(m_planes[i].normal().z());
+        m_packed[i][3] = static_cast<float>(m_planes[i].constant);
+    }
+}
+
+size_t Frustum::intersectsSpheres(const float *spheres, size_t count, uint32_t *visible, uint32_t indexOffset) const
+{
+    size_t written = 0;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    // four spheres at a time: transpose to x/y/z/r lanes, then one
+    // multiply-add chain per plane
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(spheres + i * 4);
+        __m128 y = _mm_loadu_ps(spheres + i * 4 + 4);
+        __m128 z = _mm_loadu_ps(spheres + i * 4 + 8);
+        __m128 r = _mm_loadu_ps(spheres + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, r);
+
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), r);
+        __m128 outside = _mm_setzero_ps();
+
+        for (size_t p = 0; p < 6; p++)
+        {
+            const float *plane = m_packed[p];
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), x), _mm_mul_ps(_mm_set1_ps(plane[1]), y)),
+                                               _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[2]), z), _mm_set1_ps(plane[3])));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negRadius));
+        }
+
+        // branch-free compaction: always write, advance only when visible
+        const int mask = _mm_movemask_ps(outside);
+        const uint32_t index = indexOffset + static_cast<uint32_t>(i);
+
+        visible[written] = index;
+        written += (mask & 1) == 0;
+        visible[written] = index + 1;
+        written += (mask & 2) == 0;
+        visible[written] = index + 2;
+        written += (mask & 4) == 0;
+        visible[written] = index + 3;
+        written += (mask & 8) == 0;
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float *s = spheres + i * 4;
+        bool inside = true;
+
+        for (size_t p = 0; p < 6; p++)
+        {
+            const float *plane = m_packed[p];
+            const float distance = plane[0] * s[0] + plane[1] * s[1] + plane[2] * s[2] + plane[3];
+            inside &= distance >= -s[3];
+        }
+
+        visible[written] = indexOffset + static_cast<uint32_t>(i);
+        written += inside;
+    }
+
+    return written;
+}
@@ -207,4 +207,14 @@ namespace MathUtils
     {
         return std::vector<HIGH_PRECISION>(src_span.begin(), src_span.end());
     }
+
+    std::pmr::vector<HIGH_PRECISION> convertSpanToVector(const std::span<const HIGH_PRECISION, 9> &src_span, std::pmr::memory_resource *resource)
+    {
+        return std::pmr::vector<HIGH_PRECISION>(src_span.begin(), src_span.end(), resource);
+    }
+
+    std::pmr::vector<HIGH_PRECISION> convertSpanToVector(const std::span<const HIGH_PRECISION, 16> &src_span, std::pmr::memory_resource *resource)
+    {
+        return std::pmr::vector<HIGH_PRECISION>(src_span.begin(), src_span.end(), resource);
+    }
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "math/Matrix4.h"
+#include "common/CPUFeatures.h"
 #include "math/Matrix3.h"
 #include "math/Vector3.h"
+#include "math/Quaternion.h"
 
 Matrix4::Matrix4(
     HIGH_PRECISION n11, HIGH_PRECISION n12, HIGH_PRECISION n13, HIGH_PRECISION n14,
@@ -100,7 +102,7 @@ void Matrix4::copyPosition(const Matrix4 &m)
 
 void Matrix4::setFromMatrix3(const Matrix3 &m)
 {
-    auto &me = m_elements;
+    auto me = m.elements();
 
     set(
         me[0], me[3], me[6], 0,
@@ -159,6 +161,13 @@ void Matrix4::extractRotation(const Matrix4 &m)
     te[15] = 1;
 }
 
+void Matrix4::makeRotationFromQuaternion(const Quaternion &q)
+{
+    Vector3 _zero(0, 0, 0);
+    Vector3 _one(1, 1, 1);
+    compose(_zero, q, _one);
+}
+
 void Matrix4::lookAt(Vector3 &eye, Vector3 &target, Vector3 &up)
 {
     auto &te = m_elements;
@@ -399,7 +408,7 @@ void Matrix4::scale(const Vector3 &v)
     te[11] *= z;
 }
 
-HIGH_PRECISION Matrix4::getMaxScaleOnAxis()
+HIGH_PRECISION Matrix4::getMaxScaleOnAxis() const
 {
     auto &te = m_elements;
 
@@ -516,3 +525,223 @@ void Matrix4::makeShear(HIGH_PRECISION xy, HIGH_PRECISION xz, HIGH_PRECISION yx,
 
     );
 }
+
+void Matrix4::makePerspective(HIGH_PRECISION left, HIGH_PRECISION right, HIGH_PRECISION top, HIGH_PRECISION bottom, HIGH_PRECISION near, HIGH_PRECISION far)
+{
+    auto &te = m_elements;
+
+    const HIGH_PRECISION x = 2 * near / (right - left);
+    const HIGH_PRECISION y = 2 * near / (top - bottom);
+
+    const HIGH_PRECISION a = (right + left) / (right - left);
+    const HIGH_PRECISION b = (top + bottom) / (top - bottom);
+    const HIGH_PRECISION c = -(far + near) / (far - near);
+    const HIGH_PRECISION d = (-2 * far * near) / (far - near);
+
+    te[0] = x;
+    te[4] = 0;
+    te[8] = a;
+    te[12] = 0;
+    te[1] = 0;
+    te[5] = y;
+    te[9] = b;
+    te[13] = 0;
+    te[2] = 0;
+    te[6] = 0;
+    te[10] = c;
+    te[14] = d;
+    te[3] = 0;
+    te[7] = 0;
+    te[11] = -1;
+    te[15] = 0;
+}
+
+void Matrix4::makeOrthographic(HIGH_PRECISION left, HIGH_PRECISION right, HIGH_PRECISION top, HIGH_PRECISION bottom, HIGH_PRECISION near, HIGH_PRECISION far)
+{
+    auto &te = m_elements;
+
+    const HIGH_PRECISION w = 1 / (right - left);
+    const HIGH_PRECISION h = 1 / (top - bottom);
+    const HIGH_PRECISION p = 1 / (far - near);
+
+    const HIGH_PRECISION x = (right + left) * w;
+    const HIGH_PRECISION y = (top + bottom) * h;
+    const HIGH_PRECISION z = (far + near) * p;
+
+    te[0] = 2 * w;
+    te[4] = 0;
+    te[8] = 0;
+    te[12] = -x;
+    te[1] = 0;
+    te[5] = 2 * h;
+    te[9] = 0;
+    te[13] = -y;
+    te[2] = 0;
+    te[6] = 0;
+    te[10] = -2 * p;
+    te[14] = -z;
+    te[3] = 0;
+    te[7] = 0;
+    te[11] = 0;
+    te[15] = 1;
+}
+
+void Matrix4::compose(const Vector3 &position, const Quaternion &quaternion, const Vector3 &scale)
+{
+    auto &te = m_elements;
+
+    auto x = quaternion.x(), y = quaternion.y(), z = quaternion.z(), w = quaternion.w();
+    auto x2 = x + x, y2 = y + y, z2 = z + z;
+    auto xx = x * x2, xy = x * y2, xz = x * z2;
+    auto yy = y * y2, yz = y * z2, zz = z * z2;
+    auto wx = w * x2, wy = w * y2, wz = w * z2;
+
+    auto sx = scale.x(), sy = scale.y(), sz = scale.z();
+
+    te[0] = (1 - (yy + zz)) * sx;
+    te[1] = (xy + wz) * sx;
+    te[2] = (xz - wy) * sx;
+    te[3] = 0;
+
+    te[4] = (xy - wz) * sy;
+    te[5] = (1 - (xx + zz)) * sy;
+    te[6] = (yz + wx) * sy;
+    te[7] = 0;
+
+    te[8] = (xz + wy) * sz;
+    te[9] = (yz - wx) * sz;
+    te[10] = (1 - (xx + yy)) * sz;
+    te[11] = 0;
+
+    te[12] = position.x();
+    te[13] = position.y();
+    te[14] = position.z();
+    te[15] = 1;
+}
+
+void Matrix4::decompose(Vector3 &position, Quaternion &quaternion, Vector3 &scale) const
+{
+    auto &te = m_elements;
+
+    Vector3 _v1(te[0], te[1], te[2]);
+    auto sx = _v1.length();
+    _v1.set(te[4], te[5], te[6]);
+    auto sy = _v1.length();
+    _v1.set(te[8], te[9], te[10]);
+    auto sz = _v1.length();
+
+    // if determine is negative, we need to invert one scale
+    Matrix4 _m1;
+    _m1.copy(*this);
+    if (_m1.determinant() < 0)
+        sx = -sx;
+
+    position.set(te[12], te[13], te[14]);
+
+    // scale the rotation part
+    auto invSX = 1 / sx;
+    auto invSY = 1 / sy;
+    auto invSZ = 1 / sz;
+
+    _m1.m_elements[0] *= invSX;
+    _m1.m_elements[1] *= invSX;
+    _m1.m_elements[2] *= invSX;
+
+    _m1.m_elements[4] *= invSY;
+    _m1.m_elements[5] *= invSY;
+    _m1.m_elements[6] *= invSY;
+
+    _m1.m_elements[8] *= invSZ;
+    _m1.m_elements[9] *= invSZ;
+    _m1.m_elements[10] *= invSZ;
+
+    quaternion.setFromRotationMatrix(_m1);
+
+    scale.set(sx, sy, sz);
+}
+
+bool Matrix4::equals(const Matrix4 &matrix, float epsilon) const
+{
+    auto &te = m_elements;
+    auto me = matrix.elements();
+
+    for (auto i = 0; i < 16; i++)
+    {
+        if (std::abs(te[i] - me[i]) > epsilon)
+            return false;
+    }
+
+    return true;
+}
+
+void Matrix4::fromArray(const std::vector<HIGH_PRECISION> &array, size_t offset)
+{
+    for (auto i = 0; i < 16; i++)
+    {
+        m_elements[i] = array[i + offset];
+    }
+}
+
+void Matrix4::fromArray(const float *array, size_t offset)
+{
+    for (auto i = 0; i < 16; i++)
+    {
+        m_elements[i] = array[i + offset];
+    }
+}
+
+void Matrix4::fromArray(const double *array, size_t offset)
+{
+    for (auto i = 0; i < 16; i++)
+    {
+        m_elements[i] = array[i + offset];
+    }
+}
+
+void Matrix4::toArray(std::vector<HIGH_PRECISION> &array, size_t offset) const
+{
+    for (auto i = 0; i < 16; i++)
+    {
+        array[i + offset] = m_elements[i];
+    }
+}
+
+void Matrix4::toArray(float *array, size_t offset) const
+{
+    for (auto i = 0; i < 16; i++)
+    {
+        array[i + offset] = static_cast<float>(m_elements[i]);
+    }
+}
+
+void Matrix4::toArray(double *array, size_t offset) const
+{
+    for (auto i = 0; i < 16; i++)
+    {
+        array[i + offset] = static_cast<double>(m_elements[i]);
+    }
+}
+
+// cloned per instruction set: the inner loop widens to whole matrices with AVX2 and AVX-512
+THREECPP_TARGET_CLONES
+void Matrix4::multiplyMatricesArray(float *__restrict out, const float *__restrict a, const float *__restrict b, size_t count)
+{
+    // column j of a * b is a linear combination of the columns of a, weighted
+    // by column j of b; the inner loop over the 4 rows maps onto one SIMD lane set
+    for (size_t m = 0; m < count; m++)
+    {
+        const float *ae = a + m * 16;
+        const float *be = b + m * 16;
+        float *te = out + m * 16;
+
+        for (size_t j = 0; j < 4; j++)
+        {
+            const float b0 = be[j * 4 + 0], b1 = be[j * 4 + 1], b2 = be[j * 4 + 2], b3 = be[j * 4 + 3];
+
+            for (size_t r = 0; r < 4; r++)
+            {
+                te[j * 4 + r] = ae[r] * b0 + ae[4 + r] * b1 + ae[8 + r] * b2 + ae[12 + r] * b3;
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#include "math/Plane.h"
+#include "math/Sphere.h"
+#include "math/Box3.h"
+
+Plane::Plane(const Vector3 &normal, HIGH_PRECISION constant)
+    : constant(constant), m_normal(normal.x(), normal.y(), normal.z())
+{
+}
+
+Plane::~Plane()
+{
+}
+
+Vector3 &Plane::normal()
+{
+    return m_normal;
+}
+
+const Vector3 &Plane::normal() const
+{
+    return m_normal;
+}
+
+void Plane::set(const Vector3 &normal, HIGH_PRECISION constant)
+{
+    m_normal.copy(normal);
+    this->constant = constant;
+}
+
+void Plane::setComponents(HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z, HIGH_PRECISION w)
+{
+    m_normal.set(x, y, z);
+    constant = w;
+}
+
+void Plane::setFromNormalAndCoplanarPoint(const Vector3 &normal, const Vector3 &point)
+{
+    m_normal.copy(normal);
+    constant = -point.dot(m_normal);
+}
+
+void Plane::setFromCoplanarPoints(const Vector3 &a, const Vector3 &b, const Vector3 &c)
+{
+    Vector3 _vector1, _vector2;
+    _vector1.subVectors(c, b);
+    _vector2.subVectors(a, b);
+    _vector1.cross(_vector2);
+    _vector1.normalize();
+
+    // Q: should an error be thrown if normal is zero (e.g. degenerate plane)?
+
+    setFromNormalAndCoplanarPoint(_vector1, a);
+}
+
+Plane Plane::clone() const
+{
+    return Plane(m_normal, constant);
+}
+
+void Plane::copy(const Plane &plane)
+{
+    m_normal.copy(plane.m_normal);
+    constant = plane.constant;
+}
+
+void Plane::normalize()
+{
+    // Note: will lead to a divide by zero if the plane is invalid.
+
+    const HIGH_PRECISION inverseNormalLength = 1.0 / m_normal.length();
+    m_normal.multiplyScalar(inverseNormalLength);
+    constant *= inverseNormalLength;
+}
+
+void Plane::negate()
+{
+    constant *= -1;
+    m_normal.negate();
+}
+
+HIGH_PRECISION Plane::distanceToPoint(const Vector3 &point) const
+{
+    return m_normal.dot(point) + constant;
+}
+
+HIGH_PRECISION Plane::distanceToSphere(const Sphere &sphere) const
+{
+    return distanceToPoint(sphere.center()) - sphere.radius;
+}
+
+void Plane::projectPoint(const Vector3 &point, Vector3 &target) const
+{
+    target.copy(point);
+    target.addScaledVector(m_normal, -distanceToPoint(point));
+}
+
+bool Plane::intersectsBox(const Box3 &box) const
+{
+    return box.intersectsPlane(*this);
+}
+
+bool Plane::intersectsSphere(const Sphere &sphere) const
+{
+    return sphere.intersectsPlane(*this);
+}
+
+void Plane::coplanarPoint(Vector3 &target) const
+{
+    target.copy(m_normal);
+    target.multiplyScalar(-constant);
+}
+
+void Plane::translate(const Vector3 &offset)
+{
+    constant -= offset.dot(m_normal);
+}
+
+bool Plane::equals(const Plane &plane) const
+{
+    return plane.m_normal.equals(m_normal) && (plane.constant == constant);
+}
@@ -0,0 +1,410 @@
+#include "math/Quaternion.h"
+#include "math/Vector3.h"
+#include "math/Matrix4.h"
+#include "math/MathUtils.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+Quaternion::Quaternion(HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z, HIGH_PRECISION w)
+{
+    m_x = x;
+    m_y = y;
+    m_z = z;
+    m_w = w;
+}
+
+Quaternion::~Quaternion()
+{
+}
+
+HIGH_PRECISION Quaternion::x() const
+{
+    return m_x;
+}
+HIGH_PRECISION Quaternion::y() const
+{
+    return m_y;
+}
+HIGH_PRECISION Quaternion::z() const
+{
+    return m_z;
+}
+HIGH_PRECISION Quaternion::w() const
+{
+    return m_w;
+}
+
+Quaternion &Quaternion::set(HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z, HIGH_PRECISION w)
+{
+    m_x = x;
+    m_y = y;
+    m_z = z;
+    m_w = w;
+    return *this;
+}
+
+Quaternion &Quaternion::identity()
+{
+    return this->set(0, 0, 0, 1);
+}
+
+Quaternion Quaternion::clone() const
+{
+    return Quaternion(m_x, m_y, m_z, m_w);
+}
+
+Quaternion &Quaternion::copy(const Quaternion &quaternion)
+{
+    m_x = quaternion.x();
+    m_y = quaternion.y();
+    m_z = quaternion.z();
+    m_w = quaternion.w();
+    return *this;
+}
+
+Quaternion &Quaternion::setFromAxisAngle(const Vector3 &axis, HIGH_PRECISION angle)
+{
+    // http://www.euclideanspace.com/maths/geometry/rotations/conversions/angleToQuaternion/index.htm
+
+    // assumes axis is normalized
+
+    auto halfAngle = angle / 2, s = std::sin(halfAngle);
+
+    m_x = axis.x() * s;
+    m_y = axis.y() * s;
+    m_z = axis.z() * s;
+    m_w = std::cos(halfAngle);
+    return *this;
+}
+
+Quaternion &Quaternion::setFromRotationMatrix(const Matrix4 &m)
+{
+    // http://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/index.htm
+
+    // assumes the upper 3x3 of m is a pure rotation matrix (i.e, unscaled)
+
+    auto te = m.elements();
+
+    auto m11 = te[0], m12 = te[4], m13 = te[8],
+         m21 = te[1], m22 = te[5], m23 = te[9],
+         m31 = te[2], m32 = te[6], m33 = te[10],
+
+         trace = m11 + m22 + m33;
+
+    if (trace > 0)
+    {
+        auto s = 0.5 / std::sqrt(trace + 1.0);
+
+        m_w = 0.25 / s;
+        m_x = (m32 - m23) * s;
+        m_y = (m13 - m31) * s;
+        m_z = (m21 - m12) * s;
+    }
+    else if (m11 > m22 && m11 > m33)
+    {
+        auto s = 2.0 * std::sqrt(1.0 + m11 - m22 - m33);
+
+        m_w = (m32 - m23) / s;
+        m_x = 0.25 * s;
+        m_y = (m12 + m21) / s;
+        m_z = (m13 + m31) / s;
+    }
+    else if (m22 > m33)
+    {
+        auto s = 2.0 * std::sqrt(1.0 + m22 - m11 - m33);
+
+        m_w = (m13 - m31) / s;
+        m_x = (m12 + m21) / s;
+        m_y = 0.25 * s;
+        m_z = (m23 + m32) / s;
+    }
+    else
+    {
+        auto s = 2.0 * std::sqrt(1.0 + m33 - m11 - m22);
+
+        m_w = (m21 - m12) / s;
+        m_x = (m13 + m31) / s;
+        m_y = (m23 + m32) / s;
+        m_z = 0.25 * s;
+    }
+
+    return *this;
+}
+
+Quaternion &Quaternion::setFromUnitVectors(const Vector3 &vFrom, const Vector3 &vTo)
+{
+    // assumes direction vectors vFrom and vTo are normalized
+
+    auto r = vFrom.dot(vTo) + 1;
+
+    if (r < std::numeric_limits<float>::epsilon())
+    {
+        // vFrom and vTo point in opposite directions
+
+        r = 0;
+
+        if (std::abs(vFrom.x()) > std::abs(vFrom.z()))
+        {
+            m_x = -vFrom.y();
+            m_y = vFrom.x();
+            m_z = 0;
+            m_w = r;
+        }
+        else
+        {
+            m_x = 0;
+            m_y = -vFrom.z();
+            m_z = vFrom.y();
+            m_w = r;
+        }
+    }
+    else
+    {
+        // crossVectors( vFrom, vTo ); // inlined to avoid cyclic dependency on Vector3
+
+        m_x = vFrom.y() * vTo.z() - vFrom.z() * vTo.y();
+        m_y = vFrom.z() * vTo.x() - vFrom.x() * vTo.z();
+        m_z = vFrom.x() * vTo.y() - vFrom.y() * vTo.x();
+        m_w = r;
+    }
+
+    return this->normalize();
+}
+
+HIGH_PRECISION Quaternion::angleTo(const Quaternion &q) const
+{
+    return 2 * std::acos(std::abs(MathUtils::clamp(this->dot(q), -1, 1)));
+}
+
+Quaternion &Quaternion::rotateTowards(const Quaternion &q, HIGH_PRECISION step)
+{
+    auto angle = this->angleTo(q);
+
+    if (angle == 0)
+        return *this;
+
+    auto t = std::min((HIGH_PRECISION)1, step / angle);
+
+    return this->slerp(q, t);
+}
+
+Quaternion &Quaternion::invert()
+{
+    // quaternion is assumed to have unit length
+    return this->conjugate();
+}
+
+Quaternion &Quaternion::conjugate()
+{
+    m_x *= -1;
+    m_y *= -1;
+    m_z *= -1;
+    return *this;
+}
+
+HIGH_PRECISION Quaternion::dot(const Quaternion &v) const
+{
+    return m_x * v.x() + m_y * v.y() + m_z * v.z() + m_w * v.w();
+}
+
+HIGH_PRECISION Quaternion::lengthSq() const
+{
+    return m_x * m_x + m_y * m_y + m_z * m_z + m_w * m_w;
+}
+
+HIGH_PRECISION Quaternion::length() const
+{
+    return std::sqrt(m_x * m_x + m_y * m_y + m_z * m_z + m_w * m_w);
+}
+
+Quaternion &Quaternion::normalize()
+{
+    auto l = this->length();
+
+    if (l == 0)
+    {
+        m_x = 0;
+        m_y = 0;
+        m_z = 0;
+        m_w = 1;
+    }
+    else
+    {
+        l = 1 / l;
+
+        m_x = m_x * l;
+        m_y = m_y * l;
+        m_z = m_z * l;
+        m_w = m_w * l;
+    }
+
+    return *this;
+}
+
+Quaternion &Quaternion::multiply(const Quaternion &q)
+{
+    return this->multiplyQuaternions(*this, q);
+}
+
+Quaternion &Quaternion::premultiply(const Quaternion &q)
+{
+    return this->multiplyQuaternions(q, *this);
+}
+
+Quaternion &Quaternion::multiplyQuaternions(const Quaternion &a, const Quaternion &b)
+{
+    // from http://www.euclideanspace.com/maths/algebra/realNormedAlgebra/quaternions/code/index.htm
+
+    auto qax = a.x(), qay = a.y(), qaz = a.z(), qaw = a.w();
+    auto qbx = b.x(), qby = b.y(), qbz = b.z(), qbw = b.w();
+
+    m_x = qax * qbw + qaw * qbx + qay * qbz - qaz * qby;
+    m_y = qay * qbw + qaw * qby + qaz * qbx - qax * qbz;
+    m_z = qaz * qbw + qaw * qbz + qax * qby - qay * qbx;
+    m_w = qaw * qbw - qax * qbx - qay * qby - qaz * qbz;
+
+    return *this;
+}
+
+Quaternion &Quaternion::slerp(const Quaternion &qb, HIGH_PRECISION t)
+{
+    if (t == 0)
+        return *this;
+    if (t == 1)
+        return this->copy(qb);
+
+    auto x = m_x, y = m_y, z = m_z, w = m_w;
+
+    // http://www.euclideanspace.com/maths/algebra/realNormedAlgebra/quaternions/slerp/
+
+    auto cosHalfTheta = w * qb.w() + x * qb.x() + y * qb.y() + z * qb.z();
+
+    if (cosHalfTheta < 0)
+    {
+        m_w = -qb.w();
+        m_x = -qb.x();
+        m_y = -qb.y();
+        m_z = -qb.z();
+
+        cosHalfTheta = -cosHalfTheta;
+    }
+    else
+    {
+        this->copy(qb);
+    }
+
+    if (cosHalfTheta >= 1.0)
+    {
+        m_w = w;
+        m_x = x;
+        m_y = y;
+        m_z = z;
+
+        return *this;
+    }
+
+    auto sqrSinHalfTheta = 1.0 - cosHalfTheta * cosHalfTheta;
+
+    if (sqrSinHalfTheta <= std::numeric_limits<float>::epsilon())
+    {
+        auto s = 1 - t;
+        m_w = s * w + t * m_w;
+        m_x = s * x + t * m_x;
+        m_y = s * y + t * m_y;
+        m_z = s * z + t * m_z;
+
+        return this->normalize();
+    }
+
+    auto sinHalfTheta = std::sqrt(sqrSinHalfTheta);
+    auto halfTheta = std::atan2(sinHalfTheta, cosHalfTheta);
+    auto ratioA = std::sin((1 - t) * halfTheta) / sinHalfTheta,
+         ratioB = std::sin(t * halfTheta) / sinHalfTheta;
+
+    m_w = (w * ratioA + m_w * ratioB);
+    m_x = (x * ratioA + m_x * ratioB);
+    m_y = (y * ratioA + m_y * ratioB);
+    m_z = (z * ratioA + m_z * ratioB);
+
+    return *this;
+}
+
+Quaternion &Quaternion::slerpQuaternions(const Quaternion &qa, const Quaternion &qb, HIGH_PRECISION t)
+{
+    return this->copy(qa).slerp(qb, t);
+}
+
+bool Quaternion::equals(const Quaternion &quaternion, float epsilon) const
+{
+    return std::abs(quaternion.x() - m_x) <= epsilon &&
+           std::abs(quaternion.y() - m_y) <= epsilon &&
+           std::abs(quaternion.z() - m_z) <= epsilon &&
+           std::abs(quaternion.w() - m_w) <= epsilon;
+}
+
+Quaternion &Quaternion::fromArray(const std::vector<HIGH_PRECISION> &array, size_t offset)
+{
+    m_x = array[offset];
+    m_y = array[offset + 1];
+    m_z = array[offset + 2];
+    m_w = array[offset + 3];
+    return *this;
+}
+
+std::vector<HIGH_PRECISION> &Quaternion::toArray(std::vector<HIGH_PRECISION> &array, size_t offset) const
+{
+    array[offset] = m_x;
+    array[offset + 1] = m_y;
+    array[offset + 2] = m_z;
+    array[offset + 3] = m_w;
+    return array;
+}
+
+Quaternion &Quaternion::random()
+{
+    // Ken Shoemake
+    // Uniform random rotations
+    // D. Kirk, editor, Graphics Gems III, pages 124-132. Academic Press, New York, 1992.
+
+    auto theta1 = 2 * MATH_PI * DIST_DOUBLE(RANDOM_ENGINE);
+    auto theta2 = 2 * MATH_PI * DIST_DOUBLE(RANDOM_ENGINE);
+
+    auto x0 = DIST_DOUBLE(RANDOM_ENGINE);
+    auto r1 = std::sqrt(1 - x0);
+    auto r2 = std::sqrt(x0);
+
+    return this->set(
+        r1 * std::sin(theta1),
+        r1 * std::cos(theta1),
+        r2 * std::sin(theta2),
+        r2 * std::cos(theta2));
+}
+
+Quaternion Quaternion::operator*(const Quaternion &q) const
+{
+    Quaternion _q;
+    return _q.multiplyQuaternions(*this, q);
+}
+
+bool Quaternion::operator==(const Quaternion &q) const
+{
+    return this->equals(q);
+}
+
+HIGH_PRECISION Quaternion::operator[](size_t index) const
+{
+    switch (index)
+    {
+    case 0:
+        return m_x;
+    case 1:
+        return m_y;
+    case 2:
+        return m_z;
+    case 3:
+        return m_w;
+    default:
+        throw std::out_of_range("Index " + std::to_string(index) + " is out of range [0,3]");
+    }
+}
@@ -0,0 +1,209 @@
+#include "math/Sphere.h"
+#include "math/Box3.h"
+#include "math/Plane.h"
+#include "math/Matrix4.h"
+#include <algorithm>
+#include <cmath>
+
+Sphere::Sphere(const Vector3 &center, HIGH_PRECISION radius)
+    : radius(radius), m_center(center.x(), center.y(), center.z())
+{
+}
+
+Sphere::~Sphere()
+{
+}
+
+Vector3 &Sphere::center()
+{
+    return m_center;
+}
+
+const Vector3 &Sphere::center() const
+{
+    return m_center;
+}
+
+void Sphere::set(const Vector3 &center, HIGH_PRECISION radius)
+{
+    m_center.copy(center);
+    this->radius = radius;
+}
+
+void Sphere::setFromPoints(const std::vector<Vector3> &points, const Vector3 *optionalCenter)
+{
+    if (optionalCenter != nullptr)
+    {
+        m_center.copy(*optionalCenter);
+    }
+    else
+    {
+        Box3 _box;
+        _box.setFromPoints(points);
+        _box.getCenter(m_center);
+    }
+
+    HIGH_PRECISION maxRadiusSq = 0;
+
+    for (auto &point : points)
+        maxRadiusSq = std::max(maxRadiusSq, m_center.distanceToSquared(point));
+
+    radius = std::sqrt(maxRadiusSq);
+}
+
+Sphere Sphere::clone() const
+{
+    return Sphere(m_center, radius);
+}
+
+void Sphere::copy(const Sphere &sphere)
+{
+    m_center.copy(sphere.m_center);
+    radius = sphere.radius;
+}
+
+bool Sphere::isEmpty() const
+{
+    return radius < 0;
+}
+
+void Sphere::makeEmpty()
+{
+    m_center.set(0, 0, 0);
+    radius = -1;
+}
+
+bool Sphere::containsPoint(const Vector3 &point) const
+{
+    return point.distanceToSquared(m_center) <= radius * radius;
+}
+
+HIGH_PRECISION Sphere::distanceToPoint(const Vector3 &point) const
+{
+    return point.distanceTo(m_center) - radius;
+}
+
+bool Sphere::intersectsSphere(const Sphere &sphere) const
+{
+    const HIGH_PRECISION radiusSum = radius + sphere.radius;
+
+    return sphere.m_center.distanceToSquared(m_center) <= radiusSum * radiusSum;
+}
+
+bool Sphere::intersectsBox(const Box3 &box) const
+{
+    return box.intersectsSphere(*this);
+}
+
+bool Sphere::intersectsPlane(const Plane &plane) const
+{
+    return std::abs(plane.distanceToPoint(m_center)) <= radius;
+}
+
+void Sphere::clampPoint(const Vector3 &point, Vector3 &target) const
+{
+    const HIGH_PRECISION deltaLengthSq = m_center.distanceToSquared(point);
+
+    target.copy(point);
+
+    if (deltaLengthSq > radius * radius)
+    {
+        target.sub(m_center);
+        target.normalize();
+        target.multiplyScalar(radius);
+        target.add(m_center);
+    }
+}
+
+void Sphere::getBoundingBox(Box3 &target) const
+{
+    if (isEmpty())
+    {
+        // Empty sphere produces empty bounding box
+        target.makeEmpty();
+        return;
+    }
+
+    target.set(m_center, m_center);
+    target.expandByScalar(radius);
+}
+
+void Sphere::applyMatrix4(const Matrix4 &matrix)
+{
+    m_center.applyMatrix4(matrix);
+
+    auto e = matrix.elements();
+    const HIGH_PRECISION scaleXSq = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+    const HIGH_PRECISION scaleYSq = e[4] * e[4] + e[5] * e[5] + e[6] * e[6];
+    const HIGH_PRECISION scaleZSq = e[8] * e[8] + e[9] * e[9] + e[10] * e[10];
+
+    radius = radius * std::sqrt(std::max(std::max(scaleXSq, scaleYSq), scaleZSq));
+}
+
+void Sphere::translate(const Vector3 &offset)
+{
+    m_center.add(offset);
+}
+
+void Sphere::expandByPoint(const Vector3 &point)
+{
+    if (isEmpty())
+    {
+        m_center.copy(point);
+        radius = 0;
+        return;
+    }
+
+    Vector3 _v1;
+    _v1.subVectors(point, m_center);
+
+    const HIGH_PRECISION lengthSq = _v1.lengthSq();
+
+    if (lengthSq > radius * radius)
+    {
+        // calculate the minimal sphere
+
+        const HIGH_PRECISION length = std::sqrt(lengthSq);
+
+        const HIGH_PRECISION delta = (length - radius) * 0.5;
+
+        m_center.addScaledVector(_v1, delta / length);
+
+        radius += delta;
+    }
+}
+
+void Sphere::unionSphere(const Sphere &sphere)
+{
+    if (sphere.isEmpty())
+        return;
+
+    if (isEmpty())
+    {
+        copy(sphere);
+        return;
+    }
+
+    if (m_center.equals(sphere.m_center))
+    {
+        radius = std::max(radius, sphere.radius);
+    }
+    else
+    {
+        Vector3 _v2;
+        _v2.subVectors(sphere.m_center, m_center);
+        _v2.setLength(sphere.radius);
+
+        Vector3 _point;
+        _point.addVectors(sphere.m_center, _v2);
+        expandByPoint(_point);
+
+        _point.subVectors(sphere.m_center, _v2);
+        expandByPoint(_point);
+    }
+}
+
+bool Sphere::equals(const Sphere &sphere) const
+{
+    return sphere.m_center.equals(m_center) && (sphere.radius == radius);
+}
@@ -0,0 +1,732 @@
+#include "math/Triangle.h"
+#include "math/Box3.h"
+#include "math/Plane.h"
+#include "core/BufferAttribute.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// triangles or hits per task of the batch kernels
+static constexpr size_t BATCH_GRAIN = 4096;
+
+namespace
+{
+    /**
+     * The closest point on triangle `abc` to `p` as `a + s * ab + t * ac`,
+     * by the Voronoi regions of the corners and edges (Ericson, Real-Time
+     * Collision Detection, 5.1.5).
+     */
+    template <typename T>
+    void closestCoefficients(const T a[3], const T b[3], const T c[3], const T p[3], T &s, T &t)
+    {
+        const T ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const T ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+
+        auto dot = [](const T u[3], const T x[3], const T y[3])
+        {
+            return u[0] * (x[0] - y[0]) + u[1] * (x[1] - y[1]) + u[2] * (x[2] - y[2]);
+        };
+
+        s = 0;
+        t = 0;
+
+        // region A
+        const T d1 = dot(ab, p, a);
+        const T d2 = dot(ac, p, a);
+        if (d1 <= 0 && d2 <= 0)
+            return;
+
+        // region B
+        const T d3 = dot(ab, p, b);
+        const T d4 = dot(ac, p, b);
+        if (d3 >= 0 && d4 <= d3)
+        {
+            s = 1;
+            return;
+        }
+
+        // edge AB
+        const T vc = d1 * d4 - d3 * d2;
+        if (vc <= 0 && d1 >= 0 && d3 <= 0)
+        {
+            s = d1 / (d1 - d3);
+            return;
+        }
+
+        // region C
+        const T d5 = dot(ab, p, c);
+        const T d6 = dot(ac, p, c);
+        if (d6 >= 0 && d5 <= d6)
+        {
+            t = 1;
+            return;
+        }
+
+        // edge AC
+        const T vb = d5 * d2 - d1 * d6;
+        if (vb <= 0 && d2 >= 0 && d6 <= 0)
+        {
+            t = d2 / (d2 - d6);
+            return;
+        }
+
+        // edge BC
+        const T va = d3 * d6 - d5 * d4;
+        if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+        {
+            t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            s = 1 - t;
+            return;
+        }
+
+        // face region
+        const T denom = 1 / (va + vb + vc);
+        s = vb * denom;
+        t = vc * denom;
+    }
+
+    void closestPoint(const Triangle::Arrays &triangles, size_t i, const float p[3], float target[3])
+    {
+        const float a[3] = {triangles.ax[i], triangles.ay[i], triangles.az[i]};
+        const float b[3] = {triangles.bx[i], triangles.by[i], triangles.bz[i]};
+        const float c[3] = {triangles.cx[i], triangles.cy[i], triangles.cz[i]};
+
+        float s, t;
+        closestCoefficients(a, b, c, p, s, t);
+
+        for (size_t k = 0; k < 3; k++)
+            target[k] = a[k] + (b[k] - a[k]) * s + (c[k] - a[k]) * t;
+    }
+
+#if defined(__SSE2__)
+    inline __m128 select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    inline __m128 dot4(__m128 ux, __m128 uy, __m128 uz, __m128 vx, __m128 vy, __m128 vz)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ux, vx), _mm_mul_ps(uy, vy)), _mm_mul_ps(uz, vz));
+    }
+
+    /**
+     * {@link closestCoefficients} for triangles `i..i+3`: every region is
+     * evaluated and the one of highest priority selected per lane.
+     */
+    void closestPoint4(const Triangle::Arrays &triangles, size_t i, __m128 px, __m128 py, __m128 pz, __m128 &qx, __m128 &qy, __m128 &qz)
+    {
+        const __m128 ax = _mm_loadu_ps(triangles.ax.data() + i);
+        const __m128 ay = _mm_loadu_ps(triangles.ay.data() + i);
+        const __m128 az = _mm_loadu_ps(triangles.az.data() + i);
+
+        const __m128 abx = _mm_sub_ps(_mm_loadu_ps(triangles.bx.data() + i), ax);
+        const __m128 aby = _mm_sub_ps(_mm_loadu_ps(triangles.by.data() + i), ay);
+        const __m128 abz = _mm_sub_ps(_mm_loadu_ps(triangles.bz.data() + i), az);
+        const __m128 acx = _mm_sub_ps(_mm_loadu_ps(triangles.cx.data() + i), ax);
+        const __m128 acy = _mm_sub_ps(_mm_loadu_ps(triangles.cy.data() + i), ay);
+        const __m128 acz = _mm_sub_ps(_mm_loadu_ps(triangles.cz.data() + i), az);
+
+        // p relative to a; p - b and p - c follow by subtracting the edges
+        const __m128 apx = _mm_sub_ps(px, ax);
+        const __m128 apy = _mm_sub_ps(py, ay);
+        const __m128 apz = _mm_sub_ps(pz, az);
+
+        const __m128 d1 = dot4(abx, aby, abz, apx, apy, apz);
+        const __m128 d2 = dot4(acx, acy, acz, apx, apy, apz);
+        const __m128 d3 = dot4(abx, aby, abz, _mm_sub_ps(apx, abx), _mm_sub_ps(apy, aby), _mm_sub_ps(apz, abz));
+        const __m128 d4 = dot4(acx, acy, acz, _mm_sub_ps(apx, abx), _mm_sub_ps(apy, aby), _mm_sub_ps(apz, abz));
+        const __m128 d5 = dot4(abx, aby, abz, _mm_sub_ps(apx, acx), _mm_sub_ps(apy, acy), _mm_sub_ps(apz, acz));
+        const __m128 d6 = dot4(acx, acy, acz, _mm_sub_ps(apx, acx), _mm_sub_ps(apy, acy), _mm_sub_ps(apz, acz));
+
+        const __m128 va = _mm_sub_ps(_mm_mul_ps(d3, d6), _mm_mul_ps(d5, d4));
+        const __m128 vb = _mm_sub_ps(_mm_mul_ps(d5, d2), _mm_mul_ps(d1, d6));
+        const __m128 vc = _mm_sub_ps(_mm_mul_ps(d1, d4), _mm_mul_ps(d3, d2));
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1);
+
+        // lowest priority first: face, edge BC, edge AC, C, edge AB, B, A
+
+        const __m128 denom = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(va, vb), vc));
+        __m128 s = _mm_mul_ps(vb, denom);
+        __m128 t = _mm_mul_ps(vc, denom);
+
+        const __m128 d43 = _mm_sub_ps(d4, d3);
+        const __m128 d56 = _mm_sub_ps(d5, d6);
+        const __m128 bc = _mm_and_ps(_mm_cmple_ps(va, zero), _mm_and_ps(_mm_cmpge_ps(d43, zero), _mm_cmpge_ps(d56, zero)));
+        const __m128 w = _mm_div_ps(d43, _mm_add_ps(d43, d56));
+        s = select(bc, _mm_sub_ps(one, w), s);
+        t = select(bc, w, t);
+
+        const __m128 ac = _mm_and_ps(_mm_cmple_ps(vb, zero), _mm_and_ps(_mm_cmpge_ps(d2, zero), _mm_cmple_ps(d6, zero)));
+        s = select(ac, zero, s);
+        t = select(ac, _mm_div_ps(d2, _mm_sub_ps(d2, d6)), t);
+
+        const __m128 c = _mm_and_ps(_mm_cmpge_ps(d6, zero), _mm_cmple_ps(d5, d6));
+        s = select(c, zero, s);
+        t = select(c, one, t);
+
+        const __m128 ab = _mm_and_ps(_mm_cmple_ps(vc, zero), _mm_and_ps(_mm_cmpge_ps(d1, zero), _mm_cmple_ps(d3, zero)));
+        s = select(ab, _mm_div_ps(d1, _mm_sub_ps(d1, d3)), s);
+        t = select(ab, zero, t);
+
+        const __m128 b = _mm_and_ps(_mm_cmpge_ps(d3, zero), _mm_cmple_ps(d4, d3));
+        s = select(b, one, s);
+        t = select(b, zero, t);
+
+        const __m128 a = _mm_and_ps(_mm_cmple_ps(d1, zero), _mm_cmple_ps(d2, zero));
+        s = _mm_andnot_ps(a, s);
+        t = _mm_andnot_ps(a, t);
+
+        qx = _mm_add_ps(ax, _mm_add_ps(_mm_mul_ps(abx, s), _mm_mul_ps(acx, t)));
+        qy = _mm_add_ps(ay, _mm_add_ps(_mm_mul_ps(aby, s), _mm_mul_ps(acy, t)));
+        qz = _mm_add_ps(az, _mm_add_ps(_mm_mul_ps(abz, s), _mm_mul_ps(acz, t)));
+    }
+#endif
+
+    template <size_t N>
+    void interpolateItems(size_t begin, size_t end, std::span<const uint32_t> faces, std::span<const float> barycoords, std::span<const uint32_t> index,
+                          const float *attribute, size_t itemSize, float *target)
+    {
+        const size_t size = N > 0 ? N : itemSize;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const size_t face = faces[i];
+            const size_t i0 = index.empty() ? face * 3 : index[face * 3];
+            const size_t i1 = index.empty() ? face * 3 + 1 : index[face * 3 + 1];
+            const size_t i2 = index.empty() ? face * 3 + 2 : index[face * 3 + 2];
+
+            const float *w = barycoords.data() + i * 3;
+            const float *v1 = attribute + i0 * size;
+            const float *v2 = attribute + i1 * size;
+            const float *v3 = attribute + i2 * size;
+            float *out = target + i * size;
+
+            for (size_t k = 0; k < size; k++)
+                out[k] = v1[k] * w[0] + v2[k] * w[1] + v3[k] * w[2];
+        }
+    }
+}
+
+size_t Triangle::Arrays::size() const
+{
+    return ax.size();
+}
+
+void Triangle::Arrays::clear()
+{
+    for (auto *column : {&ax, &ay, &az, &bx, &by, &bz, &cx, &cy, &cz})
+        column->clear();
+}
+
+void Triangle::Arrays::reserve(size_t count)
+{
+    for (auto *column : {&ax, &ay, &az, &bx, &by, &bz, &cx, &cy, &cz})
+        column->reserve(count);
+}
+
+void Triangle::Arrays::push(const Triangle &triangle)
+{
+    ax.push_back(static_cast<float>(triangle.m_a.x()));
+    ay.push_back(static_cast<float>(triangle.m_a.y()));
+    az.push_back(static_cast<float>(triangle.m_a.z()));
+    bx.push_back(static_cast<float>(triangle.m_b.x()));
+    by.push_back(static_cast<float>(triangle.m_b.y()));
+    bz.push_back(static_cast<float>(triangle.m_b.z()));
+    cx.push_back(static_cast<float>(triangle.m_c.x()));
+    cy.push_back(static_cast<float>(triangle.m_c.y()));
+    cz.push_back(static_cast<float>(triangle.m_c.z()));
+}
+
+void Triangle::Arrays::setFromArrays(std::span<const float> positions, std::span<const uint32_t> index)
+{
+    const size_t count = index.empty() ? positions.size() / 9 : index.size() / 3;
+
+    for (auto *column : {&ax, &ay, &az, &bx, &by, &bz, &cx, &cy, &cz})
+        column->resize(count);
+
+    std::vector<float> *corners[3][3] = {{&ax, &ay, &az}, {&bx, &by, &bz}, {&cx, &cy, &cz}};
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            const size_t vertex = index.empty() ? i * 3 + k : index[i * 3 + k];
+            if (vertex * 3 + 2 >= positions.size())
+                throw std::invalid_argument("Triangle: index out of range of positions");
+
+            (*corners[k][0])[i] = positions[vertex * 3];
+            (*corners[k][1])[i] = positions[vertex * 3 + 1];
+            (*corners[k][2])[i] = positions[vertex * 3 + 2];
+        }
+    }
+}
+
+Triangle::Triangle(const Vector3 &a, const Vector3 &b, const Vector3 &c)
+    : m_a(a.x(), a.y(), a.z()), m_b(b.x(), b.y(), b.z()), m_c(c.x(), c.y(), c.z())
+{
+}
+
+Triangle::~Triangle()
+{
+}
+
+Vector3 &Triangle::a()
+{
+    return m_a;
+}
+
+const Vector3 &Triangle::a() const
+{
+    return m_a;
+}
+
+Vector3 &Triangle::b()
+{
+    return m_b;
+}
+
+const Vector3 &Triangle::b() const
+{
+    return m_b;
+}
+
+Vector3 &Triangle::c()
+{
+    return m_c;
+}
+
+const Vector3 &Triangle::c() const
+{
+    return m_c;
+}
+
+void Triangle::getNormal(const Vector3 &a, const Vector3 &b, const Vector3 &c, Vector3 &target)
+{
+    Vector3 _v0;
+
+    target.subVectors(c, b);
+    _v0.subVectors(a, b);
+    target.cross(_v0);
+
+    const HIGH_PRECISION targetLengthSq = target.lengthSq();
+    if (targetLengthSq > 0)
+        target.multiplyScalar(1 / std::sqrt(targetLengthSq));
+    else
+        target.set(0, 0, 0);
+}
+
+bool Triangle::getBarycoord(const Vector3 &point, const Vector3 &a, const Vector3 &b, const Vector3 &c, Vector3 &target)
+{
+    // based on: http://www.blackpawn.com/texts/pointinpoly/default.html
+
+    Vector3 _v0, _v1, _v2;
+    _v0.subVectors(c, a);
+    _v1.subVectors(b, a);
+    _v2.subVectors(point, a);
+
+    const HIGH_PRECISION dot00 = _v0.dot(_v0);
+    const HIGH_PRECISION dot01 = _v0.dot(_v1);
+    const HIGH_PRECISION dot02 = _v0.dot(_v2);
+    const HIGH_PRECISION dot11 = _v1.dot(_v1);
+    const HIGH_PRECISION dot12 = _v1.dot(_v2);
+
+    const HIGH_PRECISION denom = dot00 * dot11 - dot01 * dot01;
+
+    // collinear or singular triangle
+    if (denom == 0)
+    {
+        target.set(0, 0, 0);
+        return false;
+    }
+
+    const HIGH_PRECISION invDenom = 1 / denom;
+    const HIGH_PRECISION u = (dot11 * dot02 - dot01 * dot12) * invDenom;
+    const HIGH_PRECISION v = (dot00 * dot12 - dot01 * dot02) * invDenom;
+
+    // barycentric coordinates must always sum to 1
+    target.set(1 - u - v, v, u);
+    return true;
+}
+
+bool Triangle::containsPoint(const Vector3 &point, const Vector3 &a, const Vector3 &b, const Vector3 &c)
+{
+    Vector3 _v3;
+
+    // if the triangle is degenerate then we can't contain a point
+    if (!getBarycoord(point, a, b, c, _v3))
+        return false;
+
+    return _v3.x() >= 0 && _v3.y() >= 0 && _v3.x() + _v3.y() <= 1;
+}
+
+bool Triangle::getInterpolation(const Vector3 &point, const Vector3 &p1, const Vector3 &p2, const Vector3 &p3,
+                                const Vector3 &v1, const Vector3 &v2, const Vector3 &v3, Vector3 &target)
+{
+    Vector3 _v3;
+
+    if (!getBarycoord(point, p1, p2, p3, _v3))
+    {
+        target.set(0, 0, 0);
+        return false;
+    }
+
+    target.set(0, 0, 0);
+    target.addScaledVector(v1, _v3.x());
+    target.addScaledVector(v2, _v3.y());
+    target.addScaledVector(v3, _v3.z());
+    return true;
+}
+
+bool Triangle::isFrontFacing(const Vector3 &a, const Vector3 &b, const Vector3 &c, const Vector3 &direction)
+{
+    Vector3 _v0, _v1;
+    _v0.subVectors(c, b);
+    _v1.subVectors(a, b);
+    _v0.cross(_v1);
+
+    // strictly front facing
+    return _v0.dot(direction) < 0;
+}
+
+void Triangle::set(const Vector3 &a, const Vector3 &b, const Vector3 &c)
+{
+    m_a.copy(a);
+    m_b.copy(b);
+    m_c.copy(c);
+}
+
+void Triangle::setFromPointsAndIndices(const std::vector<Vector3> &points, size_t i0, size_t i1, size_t i2)
+{
+    m_a.copy(points[i0]);
+    m_b.copy(points[i1]);
+    m_c.copy(points[i2]);
+}
+
+void Triangle::setFromAttributeAndIndices(const BufferAttribute &attribute, size_t i0, size_t i1, size_t i2)
+{
+    m_a.fromBufferAttribute(attribute, i0);
+    m_b.fromBufferAttribute(attribute, i1);
+    m_c.fromBufferAttribute(attribute, i2);
+}
+
+Triangle Triangle::clone() const
+{
+    return Triangle(m_a, m_b, m_c);
+}
+
+void Triangle::copy(const Triangle &triangle)
+{
+    set(triangle.m_a, triangle.m_b, triangle.m_c);
+}
+
+HIGH_PRECISION Triangle::getArea() const
+{
+    Vector3 _v0, _v1;
+    _v0.subVectors(m_c, m_b);
+    _v1.subVectors(m_a, m_b);
+    _v0.cross(_v1);
+
+    return _v0.length() * 0.5;
+}
+
+void Triangle::getMidpoint(Vector3 &target) const
+{
+    target.addVectors(m_a, m_b);
+    target.add(m_c);
+    target.multiplyScalar(1.0 / 3.0);
+}
+
+void Triangle::getNormal(Vector3 &target) const
+{
+    getNormal(m_a, m_b, m_c, target);
+}
+
+void Triangle::getPlane(Plane &target) const
+{
+    target.setFromCoplanarPoints(m_a, m_b, m_c);
+}
+
+bool Triangle::getBarycoord(const Vector3 &point, Vector3 &target) const
+{
+    return getBarycoord(point, m_a, m_b, m_c, target);
+}
+
+bool Triangle::getInterpolation(const Vector3 &point, const Vector3 &v1, const Vector3 &v2, const Vector3 &v3, Vector3 &target) const
+{
+    return getInterpolation(point, m_a, m_b, m_c, v1, v2, v3, target);
+}
+
+bool Triangle::containsPoint(const Vector3 &point) const
+{
+    return containsPoint(point, m_a, m_b, m_c);
+}
+
+bool Triangle::isFrontFacing(const Vector3 &direction) const
+{
+    return isFrontFacing(m_a, m_b, m_c, direction);
+}
+
+bool Triangle::intersectsBox(const Box3 &box) const
+{
+    if (box.isEmpty())
+        return false;
+
+    // compute box center and extents
+    Vector3 center, extents;
+    box.getCenter(center);
+    extents.subVectors(box.max(), center);
+
+    // translate triangle to aabb origin
+    Vector3 v0, v1, v2;
+    v0.subVectors(m_a, center);
+    v1.subVectors(m_b, center);
+    v2.subVectors(m_c, center);
+
+    // compute edge vectors for triangle
+    Vector3 f0, f1, f2;
+    f0.subVectors(v1, v0);
+    f1.subVectors(v2, v1);
+    f2.subVectors(v0, v2);
+
+    // project the triangle and the box onto an axis; disjoint intervals separate them
+    auto separated = [&](HIGH_PRECISION x, HIGH_PRECISION y, HIGH_PRECISION z)
+    {
+        const HIGH_PRECISION r = extents.x() * std::abs(x) + extents.y() * std::abs(y) + extents.z() * std::abs(z);
+
+        const HIGH_PRECISION p0 = v0.x() * x + v0.y() * y + v0.z() * z;
+        const HIGH_PRECISION p1 = v1.x() * x + v1.y() * y + v1.z() * z;
+        const HIGH_PRECISION p2 = v2.x() * x + v2.y() * y + v2.z() * z;
+
+        return std::max(-std::max({p0, p1, p2}), std::min({p0, p1, p2})) > r;
+    };
+
+    // test against axes that are given by cross product combinations of the edges of the triangle and the edges of the aabb
+    for (const Vector3 *f : {&f0, &f1, &f2})
+    {
+        if (separated(0, -f->z(), f->y()) || separated(f->z(), 0, -f->x()) || separated(-f->y(), f->x(), 0))
+            return false;
+    }
+
+    // test 3 face normals from the aabb
+    if (separated(1, 0, 0) || separated(0, 1, 0) || separated(0, 0, 1))
+        return false;
+
+    // finally testing the face normal of the triangle
+    Vector3 triangleNormal;
+    triangleNormal.crossVectors(f0, f1);
+
+    return !separated(triangleNormal.x(), triangleNormal.y(), triangleNormal.z());
+}
+
+void Triangle::closestPointToPoint(const Vector3 &point, Vector3 &target) const
+{
+    const HIGH_PRECISION a[3] = {m_a.x(), m_a.y(), m_a.z()};
+    const HIGH_PRECISION b[3] = {m_b.x(), m_b.y(), m_b.z()};
+    const HIGH_PRECISION c[3] = {m_c.x(), m_c.y(), m_c.z()};
+    const HIGH_PRECISION p[3] = {point.x(), point.y(), point.z()};
+
+    HIGH_PRECISION s, t;
+    closestCoefficients(a, b, c, p, s, t);
+
+    target.copy(m_a);
+    target.addScaledVector(Vector3(b[0] - a[0], b[1] - a[1], b[2] - a[2]), s);
+    target.addScaledVector(Vector3(c[0] - a[0], c[1] - a[1], c[2] - a[2]), t);
+}
+
+bool Triangle::equals(const Triangle &triangle) const
+{
+    return triangle.m_a.equals(m_a) && triangle.m_b.equals(m_b) && triangle.m_c.equals(m_c);
+}
+
+void Triangle::closestPointsToPoint(const Arrays &triangles, const Vector3 &point, std::span<float> targets, std::span<float> distancesSq)
+{
+    const size_t count = triangles.size();
+
+    if (targets.size() < count * 3)
+        throw std::invalid_argument("Triangle: targets is smaller than the triangles");
+    if (!distancesSq.empty() && distancesSq.size() < count)
+        throw std::invalid_argument("Triangle: distancesSq is smaller than the triangles");
+
+    const float p[3] = {static_cast<float>(point.x()), static_cast<float>(point.y()), static_cast<float>(point.z())};
+
+    Parallel::parallelFor(0, count, BATCH_GRAIN, [&](size_t begin, size_t end)
+                          {
+        size_t i = begin;
+
+#if defined(__SSE2__)
+        const __m128 px = _mm_set1_ps(p[0]);
+        const __m128 py = _mm_set1_ps(p[1]);
+        const __m128 pz = _mm_set1_ps(p[2]);
+
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 qx, qy, qz;
+            closestPoint4(triangles, i, px, py, pz, qx, qy, qz);
+
+            if (!distancesSq.empty())
+            {
+                const __m128 dx = _mm_sub_ps(qx, px);
+                const __m128 dy = _mm_sub_ps(qy, py);
+                const __m128 dz = _mm_sub_ps(qz, pz);
+                _mm_storeu_ps(distancesSq.data() + i, dot4(dx, dy, dz, dx, dy, dz));
+            }
+
+            // back to xyz triples
+            __m128 w = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(qx, qy, qz, w);
+
+            float *out = targets.data() + i * 3;
+            float lanes[4][4];
+            _mm_storeu_ps(lanes[0], qx);
+            _mm_storeu_ps(lanes[1], qy);
+            _mm_storeu_ps(lanes[2], qz);
+            _mm_storeu_ps(lanes[3], w);
+
+            for (size_t k = 0; k < 4; k++)
+            {
+                out[k * 3 + 0] = lanes[k][0];
+                out[k * 3 + 1] = lanes[k][1];
+                out[k * 3 + 2] = lanes[k][2];
+            }
+        }
+#endif
+
+        for (; i < end; i++)
+        {
+            float *out = targets.data() + i * 3;
+            closestPoint(triangles, i, p, out);
+
+            if (!distancesSq.empty())
+            {
+                const float dx = out[0] - p[0], dy = out[1] - p[1], dz = out[2] - p[2];
+                distancesSq[i] = dx * dx + dy * dy + dz * dz;
+            }
+        } });
+}
+
+size_t Triangle::nearestToPoint(const Arrays &triangles, size_t begin, size_t end, const Vector3 &point, Vector3 &target, float &distanceSq)
+{
+    end = std::min(end, triangles.size());
+
+    const float p[3] = {static_cast<float>(point.x()), static_cast<float>(point.y()), static_cast<float>(point.z())};
+
+    size_t nearest = end;
+    float best = distanceSq;
+    size_t i = begin;
+
+#if defined(__SSE2__)
+    if (i + 4 <= end)
+    {
+        const __m128 px = _mm_set1_ps(p[0]);
+        const __m128 py = _mm_set1_ps(p[1]);
+        const __m128 pz = _mm_set1_ps(p[2]);
+
+        // the best distance and triangle offset per lane
+        __m128 bestDistance = _mm_set1_ps(best);
+        __m128i bestIndex = _mm_set1_epi32(-1);
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i four = _mm_set1_epi32(4);
+
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 qx, qy, qz;
+            closestPoint4(triangles, i, px, py, pz, qx, qy, qz);
+
+            const __m128 dx = _mm_sub_ps(qx, px);
+            const __m128 dy = _mm_sub_ps(qy, py);
+            const __m128 dz = _mm_sub_ps(qz, pz);
+            const __m128 distance = dot4(dx, dy, dz, dx, dy, dz);
+
+            const __m128 closer = _mm_cmplt_ps(distance, bestDistance);
+            bestDistance = select(closer, distance, bestDistance);
+            bestIndex = _mm_or_si128(_mm_and_si128(_mm_castps_si128(closer), index), _mm_andnot_si128(_mm_castps_si128(closer), bestIndex));
+            index = _mm_add_epi32(index, four);
+        }
+
+        float distances[4];
+        int32_t indices[4];
+        _mm_storeu_ps(distances, bestDistance);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(indices), bestIndex);
+
+        // the lowest triangle among equally close lanes, as the scalar loop picks
+        for (size_t lane = 0; lane < 4; lane++)
+        {
+            if (indices[lane] < 0)
+                continue;
+
+            const size_t candidate = begin + static_cast<size_t>(indices[lane]);
+            if (distances[lane] < best || (distances[lane] == best && candidate < nearest))
+            {
+                best = distances[lane];
+                nearest = candidate;
+            }
+        }
+    }
+#endif
+
+    for (; i < end; i++)
+    {
+        float q[3];
+        closestPoint(triangles, i, p, q);
+
+        const float dx = q[0] - p[0], dy = q[1] - p[1], dz = q[2] - p[2];
+        const float distance = dx * dx + dy * dy + dz * dz;
+
+        if (distance < best)
+        {
+            best = distance;
+            nearest = i;
+        }
+    }
+
+    if (nearest == end)
+        return end;
+
+    float q[3];
+    closestPoint(triangles, nearest, p, q);
+    target.set(q[0], q[1], q[2]);
+    distanceSq = best;
+
+    return nearest;
+}
+
+void Triangle::interpolateAttribute(std::span<const uint32_t> faces, std::span<const float> barycoords, std::span<const uint32_t> index,
+                                    std::span<const float> attribute, size_t itemSize, std::span<float> target)
+{
+    const size_t count = faces.size();
+
+    if (itemSize == 0)
+        throw std::invalid_argument("Triangle: itemSize must be positive");
+    if (barycoords.size() < count * 3)
+        throw std::invalid_argument("Triangle: barycoords is smaller than the hits");
+    if (target.size() < count * itemSize)
+        throw std::invalid_argument("Triangle: target is smaller than the hits");
+
+    // fixed item sizes unroll the component loop
+
+    Parallel::parallelFor(0, count, BATCH_GRAIN, [&](size_t begin, size_t end)
+                          {
+        switch (itemSize)
+        {
+        case 2:
+            interpolateItems<2>(begin, end, faces, barycoords, index, attribute.data(), itemSize, target.data());
+            break;
+        case 3:
+            interpolateItems<3>(begin, end, faces, barycoords, index, attribute.data(), itemSize, target.data());
+            break;
+        case 4:
+            interpolateItems<4>(begin, end, faces, barycoords, index, attribute.data(), itemSize, target.data());
+            break;
+        default:
+            interpolateItems<0>(begin, end, faces, barycoords, index, attribute.data(), itemSize, target.data());
+            break;
+        } });
+}
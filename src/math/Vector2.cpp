@@ -266,12 +266,12 @@ Vector2 &Vector2::negate()
     return *this;
 }
 
-HIGH_PRECISION Vector2::dot(const Vector2 &v)
+HIGH_PRECISION Vector2::dot(const Vector2 &v) const
 {
     return m_x * v.x() + m_y * v.y();
 }
 
-HIGH_PRECISION Vector2::cross(const Vector2 &v)
+HIGH_PRECISION Vector2::cross(const Vector2 &v) const
 {
     return m_x * v.y() - m_y * v.x();
 }
@@ -283,7 +283,7 @@ HIGH_PRECISION Vector2::lengthSq() const
 
 HIGH_PRECISION Vector2::length() const
 {
-    return std::sqrtf(m_x * m_x + m_y * m_y);
+    return std::sqrt(m_x * m_x + m_y * m_y);
 }
 
 HIGH_PRECISION Vector2::manhattanLength()
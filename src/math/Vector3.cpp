@@ -1,7 +1,9 @@
 #include "math/Vector3.h"
 #include "math/Matrix3.h"
 #include "math/Matrix4.h"
+#include "math/Quaternion.h"
 #include "math/MathUtils.h"
+#include "core/BufferAttribute.h"
 #include <stdexcept>
 #include <string>
 
@@ -186,6 +188,51 @@ void Vector3::applyNormalMatrix(Matrix3 &m)
     this->normalize();
 }
 
+void Vector3::applyMatrix4(const Matrix4 &m)
+{
+    auto x = this->m_x, y = this->m_y, z = this->m_z;
+    auto e = m.elements();
+
+    auto w = 1 / (e[3] * x + e[7] * y + e[11] * z + e[15]);
+
+    this->m_x = (e[0] * x + e[4] * y + e[8] * z + e[12]) * w;
+    this->m_y = (e[1] * x + e[5] * y + e[9] * z + e[13]) * w;
+    this->m_z = (e[2] * x + e[6] * y + e[10] * z + e[14]) * w;
+}
+
+void Vector3::applyQuaternion(const Quaternion &q)
+{
+    // quaternion q is assumed to have unit length
+
+    auto vx = this->m_x, vy = this->m_y, vz = this->m_z;
+    auto qx = q.x(), qy = q.y(), qz = q.z(), qw = q.w();
+
+    // t = 2 * cross( q.xyz, v );
+    auto tx = 2 * (qy * vz - qz * vy);
+    auto ty = 2 * (qz * vx - qx * vz);
+    auto tz = 2 * (qx * vy - qy * vx);
+
+    // v + q.w * t + cross( q.xyz, t );
+    this->m_x = vx + qw * tx + qy * tz - qz * ty;
+    this->m_y = vy + qw * ty + qz * tx - qx * tz;
+    this->m_z = vz + qw * tz + qx * ty - qy * tx;
+}
+
+void Vector3::transformDirection(const Matrix4 &m)
+{
+    // input: Matrix4 affine matrix
+    // vector interpreted as a direction
+
+    auto x = this->m_x, y = this->m_y, z = this->m_z;
+    auto e = m.elements();
+
+    this->m_x = e[0] * x + e[4] * y + e[8] * z;
+    this->m_y = e[1] * x + e[5] * y + e[9] * z;
+    this->m_z = e[2] * x + e[6] * y + e[10] * z;
+
+    this->normalize();
+}
+
 void Vector3::divide(const Vector3 &v)
 {
     this->m_x /= v.x();
@@ -413,16 +460,38 @@ void Vector3::setFromCylindricalCoords(float radius, float theta, HIGH_PRECISION
     this->m_z = radius * std::cos(theta);
 }
 
+void Vector3::setFromMatrixPosition(const Matrix4 &m)
+{
+    auto e = m.elements();
+
+    this->m_x = e[12];
+    this->m_y = e[13];
+    this->m_z = e[14];
+}
+
+void Vector3::setFromMatrixScale(const Matrix4 &m)
+{
+    Vector3 _column;
+    _column.setFromMatrixColumn(m, 0);
+    auto sx = _column.length();
+    _column.setFromMatrixColumn(m, 1);
+    auto sy = _column.length();
+    _column.setFromMatrixColumn(m, 2);
+    auto sz = _column.length();
+
+    this->m_x = sx;
+    this->m_y = sy;
+    this->m_z = sz;
+}
+
 void Vector3::setFromMatrixColumn(const Matrix4 &m, size_t index)
 {
-    auto ele_list = MathUtils::convertSpanToVector(m.elements());
-    fromArray(ele_list, index * 4);
+    fromArray(m.elements(), index * 4);
 }
 
 void Vector3::setFromMatrix3Column(const Matrix3 &m, size_t index)
 {
-    auto ele_list = MathUtils::convertSpanToVector(m.elements());
-    fromArray(ele_list, index * 3);
+    fromArray(m.elements(), index * 3);
 }
 
 bool Vector3::equals(const Vector3 &v, float epsilon) const
@@ -433,7 +502,7 @@ bool Vector3::equals(const Vector3 &v, float epsilon) const
     return x_equal && y_equal && z_equal;
 }
 
-void Vector3::fromArray(const std::vector<HIGH_PRECISION> &array, size_t offset)
+void Vector3::fromArray(std::span<const HIGH_PRECISION> array, size_t offset)
 {
     m_x = array[offset];
     m_y = array[offset + 1];
@@ -447,6 +516,13 @@ void Vector3::toArray(std::vector<HIGH_PRECISION> &array, size_t offset)
     array[offset + 2] = m_z;
 }
 
+void Vector3::fromBufferAttribute(const BufferAttribute &attribute, size_t index)
+{
+    m_x = attribute.getX(index);
+    m_y = attribute.getY(index);
+    m_z = attribute.getZ(index);
+}
+
 void Vector3::random()
 {
     m_x = DIST_DOUBLE(RANDOM_ENGINE);
@@ -0,0 +1,444 @@
+#include "modifiers/IndexOptimizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+static constexpr uint32_t NONE = ~0u;
+
+namespace
+{
+    /**
+     * FIFO cache simulated with timestamps: a vertex is cached while fewer
+     * than `size` misses happened since it was loaded. Resetting advances
+     * the clock past every entry.
+     */
+    class VertexCache
+    {
+    public:
+        VertexCache(size_t vertexCount, size_t size)
+            : m_size(static_cast<uint32_t>(size)), m_timestamp(static_cast<uint32_t>(size) + 1), m_time(vertexCount, 0)
+        {
+        }
+
+        bool cached(uint32_t v) const
+        {
+            return m_timestamp - m_time[v] <= m_size;
+        }
+
+        uint32_t age(uint32_t v) const
+        {
+            return m_timestamp - m_time[v];
+        }
+
+        // loads `v` if needed; returns whether it missed
+        bool touch(uint32_t v)
+        {
+            if (cached(v))
+                return false;
+
+            m_time[v] = m_timestamp++;
+            return true;
+        }
+
+        unsigned int triangle(const uint32_t *t)
+        {
+            return touch(t[0]) + touch(t[1]) + touch(t[2]);
+        }
+
+        void reset()
+        {
+            m_timestamp += m_size + 1;
+        }
+
+    private:
+        uint32_t m_size;
+        uint32_t m_timestamp;
+        std::vector<uint32_t> m_time;
+    };
+
+    void checkIndices(std::span<const uint32_t> indices, size_t vertexCount)
+    {
+        if (indices.size() % 3 != 0)
+            throw std::invalid_argument("IndexOptimizer: index count is not a multiple of 3");
+
+        for (uint32_t index : indices)
+        {
+            if (index >= vertexCount)
+                throw std::out_of_range("IndexOptimizer: index out of range");
+        }
+    }
+
+    std::shared_ptr<BufferAttribute> remapAttribute(const BufferAttribute &source, const std::vector<uint32_t> &remap, size_t uniqueCount)
+    {
+        const size_t itemSize = source.itemSize();
+        const float *src = source.array();
+        std::vector<float> array(uniqueCount * itemSize);
+
+        for (size_t i = 0; i < source.count(); i++)
+        {
+            if (remap[i] != NONE)
+                std::copy(src + i * itemSize, src + (i + 1) * itemSize, array.data() + size_t(remap[i]) * itemSize);
+        }
+
+        auto attribute = std::make_shared<BufferAttribute>(std::move(array), itemSize, source.normalized());
+        attribute->name(source.name());
+        return attribute;
+    }
+
+    MorphTarget remapMorphTarget(const MorphTarget &source, const std::vector<uint32_t> &remap)
+    {
+        const auto indices = source.indices();
+
+        std::vector<std::pair<uint32_t, size_t>> order;
+        order.reserve(indices.size());
+        for (size_t k = 0; k < indices.size(); k++)
+        {
+            if (indices[k] < remap.size() && remap[indices[k]] != NONE)
+                order.emplace_back(remap[indices[k]], k);
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<uint32_t> targetIndices(order.size());
+        std::vector<float> positionDeltas(order.size() * 3);
+        std::vector<float> normalDeltas(source.hasNormals() ? order.size() * 3 : 0);
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            const size_t k = order[i].second;
+            targetIndices[i] = order[i].first;
+            std::copy_n(source.positionDeltas().data() + k * 3, 3, positionDeltas.data() + i * 3);
+            if (source.hasNormals())
+                std::copy_n(source.normalDeltas().data() + k * 3, 3, normalDeltas.data() + i * 3);
+        }
+
+        return MorphTarget(source.name(), std::move(targetIndices), std::move(positionDeltas), std::move(normalDeltas));
+    }
+}
+
+namespace IndexOptimizer
+{
+    CacheStats analyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, size_t cacheSize)
+    {
+        checkIndices(indices, vertexCount);
+
+        VertexCache cache(vertexCount, cacheSize);
+        std::vector<uint8_t> referenced(vertexCount, 0);
+
+        CacheStats stats;
+        size_t unique = 0;
+
+        for (uint32_t v : indices)
+        {
+            stats.transformed += cache.touch(v);
+            unique += referenced[v] == 0;
+            referenced[v] = 1;
+        }
+
+        const size_t triangles = indices.size() / 3;
+        stats.acmr = triangles == 0 ? 0 : static_cast<float>(stats.transformed) / static_cast<float>(triangles);
+        stats.atvr = unique == 0 ? 0 : static_cast<float>(stats.transformed) / static_cast<float>(unique);
+
+        return stats;
+    }
+
+    std::vector<uint32_t> optimizeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, size_t cacheSize)
+    {
+        checkIndices(indices, vertexCount);
+
+        const size_t triangleCount = indices.size() / 3;
+
+        // triangles around each vertex
+        std::vector<uint32_t> offsets(vertexCount + 1, 0);
+        for (uint32_t v : indices)
+            offsets[v + 1]++;
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+                adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        // triangles not emitted yet, per vertex
+        std::vector<uint32_t> live(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+            live[v] = offsets[v + 1] - offsets[v];
+
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> deadEnd;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> result;
+        deadEnd.reserve(indices.size());
+        result.reserve(indices.size());
+
+        VertexCache cache(vertexCount, cacheSize);
+        size_t cursor = 0;
+
+        // a vertex with triangles left: the most recent dead end, else the
+        // next one in input order
+        const auto skipDeadEnd = [&]()
+        {
+            while (!deadEnd.empty())
+            {
+                const uint32_t v = deadEnd.back();
+                deadEnd.pop_back();
+
+                if (live[v] > 0)
+                    return v;
+            }
+
+            while (cursor < vertexCount)
+            {
+                if (live[cursor] > 0)
+                    return static_cast<uint32_t>(cursor);
+                cursor++;
+            }
+
+            return NONE;
+        };
+
+        uint32_t fan = skipDeadEnd();
+
+        while (fan != NONE)
+        {
+            candidates.clear();
+
+            // emit all remaining triangles around the fanning vertex
+            for (uint32_t k = offsets[fan]; k < offsets[fan + 1]; k++)
+            {
+                const uint32_t t = adjacency[k];
+                if (emitted[t])
+                    continue;
+
+                for (int e = 0; e < 3; e++)
+                {
+                    const uint32_t v = indices[size_t(t) * 3 + e];
+
+                    result.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    cache.touch(v);
+                }
+
+                emitted[t] = 1;
+            }
+
+            // next fanning vertex: the oldest candidate that will still be
+            // cached after its remaining triangles are emitted
+            uint32_t best = NONE;
+            int64_t bestPriority = -1;
+
+            for (uint32_t v : candidates)
+            {
+                if (live[v] == 0)
+                    continue;
+
+                int64_t priority = 0;
+                if (cache.age(v) + 2 * live[v] <= cacheSize)
+                    priority = cache.age(v);
+
+                if (priority > bestPriority)
+                {
+                    best = v;
+                    bestPriority = priority;
+                }
+            }
+
+            fan = best != NONE ? best : skipDeadEnd();
+        }
+
+        return result;
+    }
+
+    std::vector<uint32_t> optimizeOverdraw(std::span<const uint32_t> indices, std::span<const float> positions, size_t cacheSize, float threshold)
+    {
+        const size_t vertexCount = positions.size() / 3;
+        checkIndices(indices, vertexCount);
+
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+            return {};
+
+        VertexCache cache(vertexCount, cacheSize);
+
+        // hard boundaries: the cache order restarts where a triangle misses
+        // all three vertices
+        std::vector<uint32_t> hard;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            if (cache.triangle(indices.data() + t * 3) == 3 || t == 0)
+                hard.push_back(static_cast<uint32_t>(t));
+        }
+        hard.push_back(static_cast<uint32_t>(triangleCount));
+
+        // soft boundaries: split a hard cluster as soon as the part so far
+        // is within `threshold` of the cluster's own ACMR
+        std::vector<uint32_t> clusters;
+
+        for (size_t h = 0; h + 1 < hard.size(); h++)
+        {
+            const uint32_t start = hard[h];
+            const uint32_t end = hard[h + 1];
+
+            cache.reset();
+            size_t clusterMisses = 0;
+            for (uint32_t t = start; t < end; t++)
+                clusterMisses += cache.triangle(indices.data() + size_t(t) * 3);
+
+            const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+            cache.reset();
+            clusters.push_back(start);
+
+            size_t runningMisses = 0;
+            size_t runningTriangles = 0;
+
+            for (uint32_t t = start; t + 1 < end; t++)
+            {
+                runningMisses += cache.triangle(indices.data() + size_t(t) * 3);
+                runningTriangles++;
+
+                if (static_cast<float>(runningMisses) <= clusterThreshold * static_cast<float>(runningTriangles))
+                {
+                    clusters.push_back(t + 1);
+                    cache.reset();
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+        }
+        clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+        // sort key: how far the cluster lies outward along its own normal
+        double meshCentroid[3] = {0, 0, 0};
+        for (uint32_t v : indices)
+        {
+            for (int k = 0; k < 3; k++)
+                meshCentroid[k] += positions[size_t(v) * 3 + k];
+        }
+        for (int k = 0; k < 3; k++)
+            meshCentroid[k] /= static_cast<double>(indices.size());
+
+        const size_t clusterCount = clusters.size() - 1;
+        std::vector<float> keys(clusterCount);
+
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            double centroid[3] = {0, 0, 0};
+            double normal[3] = {0, 0, 0};
+            double area = 0;
+
+            for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++)
+            {
+                const float *p0 = positions.data() + size_t(indices[size_t(t) * 3 + 0]) * 3;
+                const float *p1 = positions.data() + size_t(indices[size_t(t) * 3 + 1]) * 3;
+                const float *p2 = positions.data() + size_t(indices[size_t(t) * 3 + 2]) * 3;
+
+                const double e0[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                const double e1[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                const double n[3] = {e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0]};
+                const double a = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+                for (int k = 0; k < 3; k++)
+                {
+                    centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.0 * a;
+                    normal[k] += n[k];
+                }
+                area += a;
+            }
+
+            const double inverseArea = area == 0 ? 0 : 1 / area;
+            const double normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            const double inverseNormal = normalLength == 0 ? 0 : 1 / normalLength;
+
+            double key = 0;
+            for (int k = 0; k < 3; k++)
+                key += (centroid[k] * inverseArea - meshCentroid[k]) * normal[k] * inverseNormal;
+
+            keys[c] = static_cast<float>(key);
+        }
+
+        std::vector<uint32_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b)
+                         { return keys[a] > keys[b]; });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        for (uint32_t c : order)
+            result.insert(result.end(), indices.begin() + size_t(clusters[c]) * 3, indices.begin() + size_t(clusters[c + 1]) * 3);
+
+        return result;
+    }
+
+    size_t optimizeVertexFetch(std::span<const uint32_t> indices, size_t vertexCount, std::vector<uint32_t> &remap)
+    {
+        checkIndices(indices, vertexCount);
+
+        remap.assign(vertexCount, NONE);
+        uint32_t next = 0;
+
+        for (uint32_t v : indices)
+        {
+            if (remap[v] == NONE)
+                remap[v] = next++;
+        }
+
+        return next;
+    }
+
+    Stats optimize(BufferGeometry &geometry, const Options &options)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        Stats stats;
+        if (!geometry.hasIndex())
+            return stats;
+
+        size_t vertexCount = 0;
+        for (const auto &[name, attribute] : geometry.attributes())
+            vertexCount = std::max(vertexCount, attribute->count());
+
+        auto &index = geometry.getIndex();
+        stats.before = analyzeVertexCache(index, vertexCount, options.cacheSize);
+
+        std::vector<uint32_t> result = optimizeVertexCache(index, vertexCount, options.cacheSize);
+
+        const auto position = geometry.getAttribute("position");
+        if (options.overdraw && position != nullptr && position->itemSize() == 3)
+            result = optimizeOverdraw(result, position->span(), options.cacheSize, options.overdrawThreshold);
+
+        if (options.vertexFetch)
+        {
+            std::vector<uint32_t> remap;
+            const size_t uniqueCount = optimizeVertexFetch(result, vertexCount, remap);
+
+            for (uint32_t &v : result)
+                v = remap[v];
+
+            // new attributes rather than in place: others may share the old ones
+            std::vector<std::pair<std::string, std::shared_ptr<BufferAttribute>>> attributes;
+            for (const auto &[name, attribute] : geometry.attributes())
+                attributes.emplace_back(name, remapAttribute(*attribute, remap, uniqueCount));
+            for (auto &[name, attribute] : attributes)
+                geometry.setAttribute(name, std::move(attribute));
+
+            for (auto &target : geometry.morphTargets())
+                target = remapMorphTarget(target, remap);
+
+            stats.verticesRemoved = vertexCount - uniqueCount;
+            vertexCount = uniqueCount;
+        }
+
+        geometry.setIndex(std::move(result));
+        stats.after = analyzeVertexCache(geometry.getIndex(), vertexCount, options.cacheSize);
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return stats;
+    }
+}
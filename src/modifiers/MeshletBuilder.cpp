@@ -0,0 +1,502 @@
+#include "modifiers/MeshletBuilder.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+static constexpr uint32_t NONE = ~0u;
+static constexpr uint16_t NOT_LOCAL = 0xffff;
+
+// meshlets per task for bounds and culling
+static constexpr size_t MESHLET_GRAIN = 16384;
+
+namespace
+{
+    struct Builder
+    {
+        std::span<const uint32_t> indices;
+        std::span<const float> positions;
+        size_t maxVertices;
+        size_t maxTriangles;
+
+        // triangles around each vertex, and how many are not emitted yet
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> adjacency;
+        std::vector<uint32_t> live;
+        std::vector<uint8_t> emitted;
+
+        // the meshlet being built
+        std::vector<uint16_t> local;
+        std::vector<uint32_t> vertices;
+        std::vector<uint8_t> triangles;
+        float sum[3] = {0, 0, 0};
+        // vertices of the last finished meshlet, to seed the next one
+        std::vector<uint32_t> previous;
+        float lo[3] = {INFINITY, INFINITY, INFINITY};
+        float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+
+        MeshletBuilder::Meshlets result;
+
+        void buildAdjacency(size_t vertexCount)
+        {
+            offsets.assign(vertexCount + 1, 0);
+            for (uint32_t v : indices)
+                offsets[v + 1]++;
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            adjacency.resize(indices.size());
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+                adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+            live.resize(vertexCount);
+            for (size_t v = 0; v < vertexCount; v++)
+                live[v] = offsets[v + 1] - offsets[v];
+
+            emitted.assign(indices.size() / 3, 0);
+            local.assign(vertexCount, NOT_LOCAL);
+        }
+
+        size_t extraVertices(uint32_t t) const
+        {
+            const uint32_t *tri = indices.data() + size_t(t) * 3;
+            return (local[tri[0]] == NOT_LOCAL) + (local[tri[1]] == NOT_LOCAL) + (local[tri[2]] == NOT_LOCAL);
+        }
+
+        /**
+         * The unemitted triangle around the meshlet adding the fewest new
+         * vertices, nearest to the meshlet center on ties. `connected` tells
+         * whether any unemitted triangle touches the meshlet, fitting or not.
+         */
+        uint32_t neighbor(bool &connected) const
+        {
+            connected = false;
+            if (vertices.empty())
+                return NONE;
+
+            const float inverse = 1.0f / static_cast<float>(vertices.size());
+            const float center[3] = {sum[0] * inverse, sum[1] * inverse, sum[2] * inverse};
+
+            uint32_t best = NONE;
+            size_t bestExtra = 4;
+            float bestDistance = std::numeric_limits<float>::infinity();
+
+            for (uint32_t v : vertices)
+            {
+                if (live[v] == 0)
+                    continue;
+
+                for (uint32_t k = offsets[v]; k < offsets[v + 1]; k++)
+                {
+                    const uint32_t t = adjacency[k];
+                    if (emitted[t])
+                        continue;
+
+                    connected = true;
+                    const uint32_t *tri = indices.data() + size_t(t) * 3;
+                    size_t extra = extraVertices(t);
+                    if (vertices.size() + extra > maxVertices)
+                        continue;
+
+                    // a triangle that is the last one of a vertex goes first,
+                    // or it ends up alone in a later meshlet
+                    if (live[tri[0]] == 1 || live[tri[1]] == 1 || live[tri[2]] == 1)
+                        extra = 0;
+                    if (extra > bestExtra)
+                        continue;
+
+                    float distance = 0;
+                    for (int c = 0; c < 3; c++)
+                    {
+                        const float d = (positions[size_t(tri[0]) * 3 + c] + positions[size_t(tri[1]) * 3 + c] + positions[size_t(tri[2]) * 3 + c]) / 3 - center[c];
+                        distance += d * d;
+                    }
+
+                    if (extra < bestExtra || distance < bestDistance)
+                    {
+                        best = t;
+                        bestExtra = extra;
+                        bestDistance = distance;
+                    }
+                }
+            }
+
+            return best;
+        }
+
+        void add(uint32_t t)
+        {
+            const uint32_t *tri = indices.data() + size_t(t) * 3;
+
+            for (int e = 0; e < 3; e++)
+            {
+                const uint32_t v = tri[e];
+
+                if (local[v] == NOT_LOCAL)
+                {
+                    local[v] = static_cast<uint16_t>(vertices.size());
+                    vertices.push_back(v);
+                    for (int c = 0; c < 3; c++)
+                    {
+                        const float x = positions[size_t(v) * 3 + c];
+                        sum[c] += x;
+                        lo[c] = std::min(lo[c], x);
+                        hi[c] = std::max(hi[c], x);
+                    }
+                }
+
+                triangles.push_back(static_cast<uint8_t>(local[v]));
+                live[v]--;
+            }
+
+            emitted[t] = 1;
+        }
+
+        void flush()
+        {
+            if (triangles.empty())
+                return;
+
+            MeshletBuilder::Meshlet meshlet;
+            meshlet.vertexOffset = static_cast<uint32_t>(result.vertices.size());
+            meshlet.vertexCount = static_cast<uint32_t>(vertices.size());
+            meshlet.triangleOffset = static_cast<uint32_t>(result.triangles.size() / 3);
+            meshlet.triangleCount = static_cast<uint32_t>(triangles.size() / 3);
+            result.meshlets.push_back(meshlet);
+
+            result.vertices.insert(result.vertices.end(), vertices.begin(), vertices.end());
+            result.triangles.insert(result.triangles.end(), triangles.begin(), triangles.end());
+
+            for (uint32_t v : vertices)
+                local[v] = NOT_LOCAL;
+            previous.swap(vertices);
+            vertices.clear();
+            triangles.clear();
+            for (int c = 0; c < 3; c++)
+            {
+                sum[c] = 0;
+                lo[c] = INFINITY;
+                hi[c] = -INFINITY;
+            }
+        }
+
+        /**
+         * Seed for a new meshlet: a triangle on the border of the previous
+         * one, around the vertex with the fewest triangles left, so that
+         * leftover pockets are filled before they are cut off.
+         */
+        uint32_t seed() const
+        {
+            uint32_t best = NONE;
+            for (uint32_t v : previous)
+            {
+                if (live[v] > 0 && (best == NONE || live[v] < live[best]))
+                    best = v;
+            }
+
+            if (best == NONE)
+                return NONE;
+
+            for (uint32_t k = offsets[best]; k < offsets[best + 1]; k++)
+            {
+                if (!emitted[adjacency[k]])
+                    return adjacency[k];
+            }
+
+            return NONE;
+        }
+
+        // whether triangle `t` lies within the meshlet's own size of its box
+        bool nearby(uint32_t t) const
+        {
+            const float extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+
+            for (int e = 0; e < 3; e++)
+            {
+                const float *p = positions.data() + size_t(indices[size_t(t) * 3 + e]) * 3;
+                for (int c = 0; c < 3; c++)
+                {
+                    if (p[c] < lo[c] - extent || p[c] > hi[c] + extent)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        void run()
+        {
+            const size_t triangleCount = indices.size() / 3;
+            size_t cursor = 0;
+
+            while (true)
+            {
+                bool connected = false;
+                uint32_t t = vertices.empty() ? seed() : neighbor(connected);
+
+                // continue with the next triangle in index order. Small
+                // disconnected pieces close by share a meshlet; when the
+                // surface continues but nothing fits, the meshlet is done
+                if (t == NONE)
+                {
+                    while (cursor < triangleCount && emitted[cursor])
+                        cursor++;
+
+                    if (cursor == triangleCount)
+                        break;
+
+                    t = static_cast<uint32_t>(cursor);
+                    if (connected || !nearby(t) || vertices.size() + extraVertices(t) > maxVertices)
+                        flush();
+                }
+
+                add(t);
+
+                if (triangles.size() / 3 == maxTriangles)
+                    flush();
+            }
+
+            flush();
+        }
+    };
+
+    void computeBounds(MeshletBuilder::Meshlets &result, std::span<const float> positions, size_t first, size_t last)
+    {
+        for (size_t m = first; m < last; m++)
+        {
+            auto &meshlet = result.meshlets[m];
+            const uint32_t *vertices = result.vertices.data() + meshlet.vertexOffset;
+            const uint8_t *triangles = result.triangles.data() + size_t(meshlet.triangleOffset) * 3;
+
+            // sphere around the box center, as Sphere#setFromPoints
+            double min[3] = {INFINITY, INFINITY, INFINITY};
+            double max[3] = {-INFINITY, -INFINITY, -INFINITY};
+
+            for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+            {
+                const float *p = positions.data() + size_t(vertices[i]) * 3;
+                for (int c = 0; c < 3; c++)
+                {
+                    min[c] = std::min(min[c], double(p[c]));
+                    max[c] = std::max(max[c], double(p[c]));
+                }
+            }
+
+            // centered on a float point so the packed copy encloses the same vertices
+            float packed[3];
+            for (int c = 0; c < 3; c++)
+                packed[c] = static_cast<float>((min[c] + max[c]) / 2);
+            const double center[3] = {packed[0], packed[1], packed[2]};
+            double radiusSq = 0;
+
+            for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+            {
+                const float *p = positions.data() + size_t(vertices[i]) * 3;
+                const double dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+                radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+            }
+
+            const double radius = std::sqrt(radiusSq);
+            meshlet.boundingSphere.set(Vector3(center[0], center[1], center[2]), radius);
+
+            // normal cone: the axis is the mean triangle normal, the cutoff
+            // follows from the normal furthest from it
+            std::vector<std::array<double, 6>> faces;
+            faces.reserve(meshlet.triangleCount);
+            double axis[3] = {0, 0, 0};
+
+            for (uint32_t t = 0; t < meshlet.triangleCount; t++)
+            {
+                const float *p0 = positions.data() + size_t(vertices[triangles[t * 3 + 0]]) * 3;
+                const float *p1 = positions.data() + size_t(vertices[triangles[t * 3 + 1]]) * 3;
+                const float *p2 = positions.data() + size_t(vertices[triangles[t * 3 + 2]]) * 3;
+
+                const double e0[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                const double e1[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                double n[3] = {e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0]};
+                const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+                // degenerate triangles have no facing
+                if (length == 0)
+                    continue;
+
+                for (int c = 0; c < 3; c++)
+                {
+                    n[c] /= length;
+                    axis[c] += n[c];
+                }
+                faces.push_back({n[0], n[1], n[2], double(p0[0]), double(p0[1]), double(p0[2])});
+            }
+
+            const double axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+            double minDot = 1;
+
+            if (axisLength > 0)
+            {
+                for (int c = 0; c < 3; c++)
+                    axis[c] /= axisLength;
+
+                for (const auto &face : faces)
+                    minDot = std::min(minDot, face[0] * axis[0] + face[1] * axis[1] + face[2] * axis[2]);
+            }
+
+            double cutoff = 2;
+            double apex[3] = {center[0], center[1], center[2]};
+
+            // past ~84 degrees the cone can hardly cull, and the apex below
+            // diverges
+            if (axisLength > 0 && minDot > 0.1)
+            {
+                // move the apex back along the axis until it is behind every
+                // triangle plane
+                double maxT = 0;
+                for (const auto &face : faces)
+                {
+                    const double dc = (center[0] - face[3]) * face[0] + (center[1] - face[4]) * face[1] + (center[2] - face[5]) * face[2];
+                    const double dn = axis[0] * face[0] + axis[1] * face[1] + axis[2] * face[2];
+                    maxT = std::max(maxT, dc / dn);
+                }
+
+                for (int c = 0; c < 3; c++)
+                    apex[c] = center[c] - axis[c] * maxT;
+                cutoff = std::sqrt(1 - minDot * minDot);
+            }
+
+            meshlet.coneApex.set(apex[0], apex[1], apex[2]);
+            meshlet.coneAxis.set(axis[0], axis[1], axis[2]);
+            meshlet.coneCutoff = static_cast<float>(cutoff);
+
+            float *sphere = result.spheres.data() + m * 4;
+            sphere[0] = static_cast<float>(center[0]);
+            sphere[1] = static_cast<float>(center[1]);
+            sphere[2] = static_cast<float>(center[2]);
+            sphere[3] = std::nextafter(static_cast<float>(radius), INFINITY);
+
+            float *cone = result.cones.data() + m * 8;
+            cone[0] = static_cast<float>(apex[0]);
+            cone[1] = static_cast<float>(apex[1]);
+            cone[2] = static_cast<float>(apex[2]);
+            cone[3] = meshlet.coneCutoff;
+            cone[4] = static_cast<float>(axis[0]);
+            cone[5] = static_cast<float>(axis[1]);
+            cone[6] = static_cast<float>(axis[2]);
+            cone[7] = 0;
+        }
+    }
+}
+
+namespace MeshletBuilder
+{
+    Meshlets build(std::span<const uint32_t> indices, std::span<const float> positions, const Options &options)
+    {
+        if (options.maxVertices < 3 || options.maxVertices > 256)
+            throw std::invalid_argument("MeshletBuilder: maxVertices must be in [3, 256]");
+        if (options.maxTriangles < 1 || options.maxTriangles > 512)
+            throw std::invalid_argument("MeshletBuilder: maxTriangles must be in [1, 512]");
+        if (indices.size() % 3 != 0)
+            throw std::invalid_argument("MeshletBuilder: index count is not a multiple of 3");
+
+        const size_t vertexCount = positions.size() / 3;
+        for (uint32_t index : indices)
+        {
+            if (index >= vertexCount)
+                throw std::out_of_range("MeshletBuilder: index out of range");
+        }
+
+        Builder builder;
+        builder.indices = indices;
+        builder.positions = positions;
+        builder.maxVertices = options.maxVertices;
+        builder.maxTriangles = options.maxTriangles;
+        builder.buildAdjacency(vertexCount);
+        builder.run();
+
+        Meshlets result = std::move(builder.result);
+        result.spheres.resize(result.meshlets.size() * 4);
+        result.cones.resize(result.meshlets.size() * 8);
+
+        Parallel::parallelFor(0, result.meshlets.size(), MESHLET_GRAIN / 16, [&result, positions](size_t begin, size_t end)
+                              { computeBounds(result, positions, begin, end); });
+
+        return result;
+    }
+
+    Meshlets build(const BufferGeometry &geometry, const Options &options)
+    {
+        const auto position = geometry.getAttribute("position");
+        if (position == nullptr || position->itemSize() != 3)
+            throw std::invalid_argument("MeshletBuilder: geometry needs a position attribute with itemSize 3");
+
+        if (geometry.hasIndex())
+            return build(geometry.getIndex(), position->span(), options);
+
+        std::vector<uint32_t> indices(position->count() - position->count() % 3);
+        std::iota(indices.begin(), indices.end(), 0u);
+
+        return build(indices, position->span(), options);
+    }
+
+    size_t cull(const Meshlets &meshlets, const Frustum &frustum, const Vector3 &cameraPosition, std::vector<uint32_t> &visible)
+    {
+        const size_t count = meshlets.meshlets.size();
+        visible.resize(count);
+
+        // every chunk compacts into its own slice, as InstancedMesh#cull
+
+        const size_t chunkCount = (count + MESHLET_GRAIN - 1) / MESHLET_GRAIN;
+        std::vector<uint32_t> chunkCounts(chunkCount, 0);
+
+        const float *spheres = meshlets.spheres.data();
+        const float *cones = meshlets.cones.data();
+        const float camera[3] = {static_cast<float>(cameraPosition.x()), static_cast<float>(cameraPosition.y()), static_cast<float>(cameraPosition.z())};
+        uint32_t *out = visible.data();
+        uint32_t *counts = chunkCounts.data();
+
+        Parallel::parallelFor(0, chunkCount, 1, [&frustum, &camera, spheres, cones, out, counts, count](size_t begin, size_t end)
+                              {
+            for (size_t chunk = begin; chunk < end; chunk++)
+            {
+                const size_t first = chunk * MESHLET_GRAIN;
+                const size_t n = std::min(MESHLET_GRAIN, count - first);
+                uint32_t *slice = out + first;
+
+                const size_t inFrustum = frustum.intersectsSpheres(spheres + first * 4, n, slice, static_cast<uint32_t>(first));
+
+                // cone test on the survivors, compacted in place
+                size_t written = 0;
+                for (size_t j = 0; j < inFrustum; j++)
+                {
+                    const uint32_t i = slice[j];
+                    const float *cone = cones + size_t(i) * 8;
+
+                    const float dx = cone[0] - camera[0], dy = cone[1] - camera[1], dz = cone[2] - camera[2];
+                    const float d = dx * cone[4] + dy * cone[5] + dz * cone[6];
+                    const bool backfacing = cone[3] <= 1 && d >= cone[3] * std::sqrt(dx * dx + dy * dy + dz * dz);
+
+                    slice[written] = i;
+                    written += !backfacing;
+                }
+
+                counts[chunk] = static_cast<uint32_t>(written);
+            } });
+
+        size_t written = 0;
+        for (size_t chunk = 0; chunk < chunkCount; chunk++)
+        {
+            const size_t first = chunk * MESHLET_GRAIN;
+
+            if (written != first)
+                std::memmove(out + written, out + first, chunkCounts[chunk] * sizeof(uint32_t));
+
+            written += chunkCounts[chunk];
+        }
+
+        visible.resize(written);
+
+        return written;
+    }
+}
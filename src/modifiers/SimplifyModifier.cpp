@@ -0,0 +1,800 @@
+#include "modifiers/SimplifyModifier.h"
+#include "common/Parallel.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+// items per task for the parallel passes
+static constexpr size_t GRAIN = 1 << 15;
+
+// no open edge, and more than one open edge, at a vertex
+static constexpr uint32_t NONE = ~0u;
+static constexpr uint32_t MANY = ~0u - 1;
+
+// collapses skipped because of locks make the cheapest `goal` collapses of a
+// pass unreachable; accept somewhat more expensive ones (on distance)
+static constexpr float PASS_ERROR_BOUND = 1.5f;
+
+// digits of the radix sort ordering collapse candidates
+static constexpr int RADIX_BITS = 11;
+static constexpr uint32_t RADIX_MASK = (1u << RADIX_BITS) - 1;
+
+namespace
+{
+    enum Kind : uint8_t
+    {
+        Manifold,
+        Border,
+        Seam,
+        Locked
+    };
+
+    // whether a vertex of the first kind may collapse onto one of the second
+    constexpr bool CAN_COLLAPSE[4][4] = {
+        {true, true, true, true},
+        {false, true, false, false},
+        {false, false, true, false},
+        {false, false, false, false}};
+
+    // whether an edge between the two kinds has a twin half-edge and is thus
+    // met twice; such edges are only evaluated from one side
+    constexpr bool HAS_OPPOSITE[4][4] = {
+        {true, true, true, false},
+        {true, false, true, false},
+        {true, true, true, false},
+        {false, false, false, false}};
+
+    /**
+     * Symmetric 4x4 error quadric in 10 floats: the upper 3x3 block `a`, the
+     * vector `b` and the constant `c`, so that the error at `v` is
+     * `vᵀ a v + 2 bᵀ v + c`.
+     */
+    struct Quadric
+    {
+        float a00, a11, a22, a10, a20, a21;
+        float b0, b1, b2;
+        float c;
+    };
+
+    struct Collapse
+    {
+        uint32_t v0;
+        uint32_t v1;
+        // squared distance bound of moving v0 onto v1
+        float error;
+    };
+
+    inline void addPlane(Quadric &q, float a, float b, float c, float d)
+    {
+        q.a00 += a * a;
+        q.a11 += b * b;
+        q.a22 += c * c;
+        q.a10 += a * b;
+        q.a20 += a * c;
+        q.a21 += b * c;
+        q.b0 += a * d;
+        q.b1 += b * d;
+        q.b2 += c * d;
+        q.c += d * d;
+    }
+
+    inline void add(Quadric &q, const Quadric &r)
+    {
+        q.a00 += r.a00;
+        q.a11 += r.a11;
+        q.a22 += r.a22;
+        q.a10 += r.a10;
+        q.a20 += r.a20;
+        q.a21 += r.a21;
+        q.b0 += r.b0;
+        q.b1 += r.b1;
+        q.b2 += r.b2;
+        q.c += r.c;
+    }
+
+    // evaluated in double: the terms are of the order of the squared extent
+    // and mostly cancel out
+    inline float quadricError(const Quadric &q, const float *v)
+    {
+        const double x = v[0], y = v[1], z = v[2];
+
+        const double rx = 2 * (q.b0 + q.a10 * y) + q.a00 * x;
+        const double ry = 2 * (q.b1 + q.a21 * z) + q.a11 * y;
+        const double rz = 2 * (q.b2 + q.a20 * x) + q.a22 * z;
+
+        return static_cast<float>(std::abs(q.c + rx * x + ry * y + rz * z));
+    }
+
+    inline void cross(const float *a, const float *b, const float *c, float *n)
+    {
+        const float e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float e1[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+
+        n[0] = e0[1] * e1[2] - e0[2] * e1[1];
+        n[1] = e0[2] * e1[0] - e0[0] * e1[2];
+        n[2] = e0[0] * e1[1] - e0[1] * e1[0];
+    }
+
+    inline uint32_t hashPosition(const float *p)
+    {
+        // +0 and -0 are the same position
+        const uint32_t x = std::bit_cast<uint32_t>(p[0] + 0.0f);
+        const uint32_t y = std::bit_cast<uint32_t>(p[1] + 0.0f);
+        const uint32_t z = std::bit_cast<uint32_t>(p[2] + 0.0f);
+
+        uint32_t h = (x * 73856093u) ^ (y * 19349663u) ^ (z * 83492791u);
+        h ^= h >> 16;
+        h *= 0x7feb352du;
+        h ^= h >> 15;
+        return h;
+    }
+
+    /**
+     * Working state of one simplification; vertex arrays are indexed by
+     * vertex, quadrics by position (the first vertex with that position).
+     */
+    class Simplifier
+    {
+    public:
+        Simplifier(std::span<const uint32_t> indices, std::span<const float> positions, bool lockBorder)
+            : m_vertexCount(positions.size() / 3), m_result(indices.begin(), indices.end())
+        {
+            normalizePositions(positions);
+            buildPositionRemap(positions);
+            classifyVertices(lockBorder);
+            computeQuadrics();
+        }
+
+        float scale() const
+        {
+            return m_scale;
+        }
+
+        std::vector<uint32_t> &result()
+        {
+            return m_result;
+        }
+
+        /**
+         * Runs collapse passes until `targetCount` triangles remain or no
+         * collapse within `maxError` (normalized units) is left. Returns the
+         * number of passes and the largest squared error accepted.
+         */
+        std::pair<size_t, float> run(size_t targetCount, float maxError)
+        {
+            const float errorLimit = maxError * maxError;
+            float resultError = 0;
+            size_t passes = 0;
+
+            m_collapseRemap.resize(m_vertexCount);
+            m_collapseLocked.resize(m_vertexCount);
+
+            while (m_result.size() / 3 > targetCount)
+            {
+                buildAdjacency();
+                pickCollapses(errorLimit);
+
+                if (m_collapses.empty())
+                    break;
+
+                const size_t triangleCount = m_result.size() / 3;
+                const size_t goal = std::max<size_t>(1, (triangleCount - targetCount) / 2);
+
+                // the error of the goal-th cheapest collapse bounds this pass
+                float passLimit = errorLimit;
+                if (goal < m_collapses.size())
+                {
+                    m_errors.resize(m_collapses.size());
+                    for (size_t i = 0; i < m_collapses.size(); i++)
+                        m_errors[i] = m_collapses[i].error;
+
+                    std::nth_element(m_errors.begin(), m_errors.begin() + static_cast<ptrdiff_t>(goal), m_errors.end());
+                    passLimit = std::min(passLimit, m_errors[goal] * PASS_ERROR_BOUND * PASS_ERROR_BOUND);
+                }
+
+                const size_t collapsed = performCollapses(goal, passLimit, resultError);
+                if (collapsed == 0)
+                    break;
+
+                remapIndices();
+                remapEdgeLoops(m_loop);
+                remapEdgeLoops(m_loopback);
+                passes++;
+            }
+
+            return {passes, resultError};
+        }
+
+    private:
+        size_t m_vertexCount;
+        std::vector<uint32_t> m_result;
+
+        float m_scale = 1;
+        std::vector<float> m_positions;
+
+        std::vector<uint32_t> m_remap;
+        std::vector<uint32_t> m_wedge;
+        std::vector<Kind> m_kind;
+        std::vector<uint32_t> m_loop;
+        std::vector<uint32_t> m_loopback;
+        std::vector<Quadric> m_quadrics;
+
+        // triangles around each position, rebuilt every pass
+        std::vector<uint32_t> m_adjacencyOffsets;
+        std::vector<uint32_t> m_adjacency;
+
+        std::vector<Collapse> m_collapses;
+        std::vector<float> m_errors;
+        std::vector<uint64_t> m_order;
+        std::vector<uint64_t> m_orderScratch;
+        std::vector<uint32_t> m_collapseRemap;
+        std::vector<uint8_t> m_collapseLocked;
+
+        const float *position(uint32_t v) const
+        {
+            return m_positions.data() + size_t(v) * 3;
+        }
+
+        // quadrics lose precision far from the origin; work in the unit cube
+        void normalizePositions(std::span<const float> positions)
+        {
+            float min[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+            float max[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+
+            for (size_t i = 0; i < m_vertexCount; i++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    min[k] = std::min(min[k], positions[i * 3 + k]);
+                    max[k] = std::max(max[k], positions[i * 3 + k]);
+                }
+            }
+
+            const float extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2], 0.0f});
+            m_scale = extent > 0 ? extent : 1;
+            const float inverse = 1 / m_scale;
+
+            m_positions.resize(m_vertexCount * 3);
+            Parallel::parallelFor(0, m_vertexCount, GRAIN, [&](size_t begin, size_t end)
+                                  {
+                for (size_t i = begin; i < end; i++)
+                {
+                    for (int k = 0; k < 3; k++)
+                        m_positions[i * 3 + k] = (positions[i * 3 + k] - min[k]) * inverse;
+                } });
+        }
+
+        // m_remap: the first vertex with the same position; m_wedge: a cycle
+        // through all vertices sharing a position
+        void buildPositionRemap(std::span<const float> positions)
+        {
+            m_remap.resize(m_vertexCount);
+            m_wedge.resize(m_vertexCount);
+
+            const size_t capacity = std::bit_ceil(std::max<size_t>(16, m_vertexCount * 2));
+            std::vector<uint32_t> table(capacity, NONE);
+
+            for (size_t i = 0; i < m_vertexCount; i++)
+            {
+                const float *p = positions.data() + i * 3;
+                size_t slot = hashPosition(p) & (capacity - 1);
+
+                while (true)
+                {
+                    const uint32_t other = table[slot];
+
+                    if (other == NONE)
+                    {
+                        table[slot] = static_cast<uint32_t>(i);
+                        m_remap[i] = static_cast<uint32_t>(i);
+                        m_wedge[i] = static_cast<uint32_t>(i);
+                        break;
+                    }
+
+                    const float *q = positions.data() + size_t(other) * 3;
+                    if (p[0] == q[0] && p[1] == q[1] && p[2] == q[2])
+                    {
+                        m_remap[i] = other;
+                        m_wedge[i] = m_wedge[other];
+                        m_wedge[other] = static_cast<uint32_t>(i);
+                        break;
+                    }
+
+                    slot = (slot + 1) & (capacity - 1);
+                }
+            }
+        }
+
+        // finds the open (unpaired) half-edges at each vertex and sorts
+        // vertices into manifold, border, seam and locked
+        void classifyVertices(bool lockBorder)
+        {
+            // outgoing and incoming neighbours per vertex
+            std::vector<uint32_t> offsets(m_vertexCount + 1, 0);
+            for (uint32_t v : m_result)
+                offsets[v + 1]++;
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<uint32_t> next(m_result.size()), prev(m_result.size());
+            {
+                std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < m_result.size(); i += 3)
+                {
+                    for (int e = 0; e < 3; e++)
+                    {
+                        const uint32_t v = m_result[i + e];
+                        const uint32_t slot = fill[v]++;
+                        next[slot] = m_result[i + (e + 1) % 3];
+                        prev[slot] = m_result[i + (e + 2) % 3];
+                    }
+                }
+            }
+
+            const auto hasEdge = [&](uint32_t a, uint32_t b)
+            {
+                for (uint32_t k = offsets[a]; k < offsets[a + 1]; k++)
+                {
+                    if (next[k] == b)
+                        return true;
+                }
+                return false;
+            };
+
+            std::vector<uint32_t> openOut(m_vertexCount, NONE), openIn(m_vertexCount, NONE);
+
+            Parallel::parallelFor(0, m_vertexCount, GRAIN, [&](size_t begin, size_t end)
+                                  {
+                for (size_t v = begin; v < end; v++)
+                {
+                    const auto a = static_cast<uint32_t>(v);
+
+                    for (uint32_t k = offsets[v]; k < offsets[v + 1]; k++)
+                    {
+                        if (!hasEdge(next[k], a))
+                            openOut[v] = openOut[v] == NONE ? next[k] : MANY;
+                        if (!hasEdge(a, prev[k]))
+                            openIn[v] = openIn[v] == NONE ? prev[k] : MANY;
+                    }
+                } });
+
+            m_kind.resize(m_vertexCount);
+            m_loop.resize(m_vertexCount);
+            m_loopback.resize(m_vertexCount);
+
+            const auto single = [](uint32_t v)
+            { return v != NONE && v != MANY; };
+
+            Parallel::parallelFor(0, m_vertexCount, GRAIN, [&](size_t begin, size_t end)
+                                  {
+                for (size_t v = begin; v < end; v++)
+                {
+                    Kind kind = Locked;
+                    const uint32_t w = m_wedge[v];
+
+                    if (w == v)
+                    {
+                        if (openOut[v] == NONE && openIn[v] == NONE)
+                            kind = Manifold;
+                        else if (single(openOut[v]) && single(openIn[v]))
+                            kind = lockBorder ? Locked : Border;
+                    }
+                    else if (m_wedge[w] == v)
+                    {
+                        // the open edges of both sides must run between the same two positions
+                        if (single(openOut[v]) && single(openIn[v]) && single(openOut[w]) && single(openIn[w]) &&
+                            m_remap[openOut[v]] == m_remap[openIn[w]] && m_remap[openIn[v]] == m_remap[openOut[w]])
+                            kind = Seam;
+                    }
+
+                    m_kind[v] = kind;
+                    m_loop[v] = single(openOut[v]) ? openOut[v] : NONE;
+                    m_loopback[v] = single(openIn[v]) ? openIn[v] : NONE;
+                } });
+        }
+
+        // triangle planes, plus a plane through each border and seam edge
+        // perpendicular to its triangle so such edges keep their course
+        void computeQuadrics()
+        {
+            m_quadrics.assign(m_vertexCount, Quadric{});
+
+            for (size_t i = 0; i < m_result.size(); i += 3)
+            {
+                const uint32_t v[3] = {m_result[i], m_result[i + 1], m_result[i + 2]};
+
+                float n[3];
+                cross(position(v[0]), position(v[1]), position(v[2]), n);
+
+                const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length == 0)
+                    continue;
+
+                n[0] /= length;
+                n[1] /= length;
+                n[2] /= length;
+
+                const float *p0 = position(v[0]);
+                Quadric q{};
+                addPlane(q, n[0], n[1], n[2], -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]));
+
+                for (int e = 0; e < 3; e++)
+                    add(m_quadrics[m_remap[v[e]]], q);
+
+                for (int e = 0; e < 3; e++)
+                {
+                    const uint32_t a = v[e];
+                    const uint32_t b = v[(e + 1) % 3];
+
+                    if ((m_kind[a] != Border && m_kind[a] != Seam) || m_loop[a] != b)
+                        continue;
+
+                    const float *pa = position(a);
+                    const float *pb = position(b);
+                    const float edge[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+
+                    float m[3] = {edge[1] * n[2] - edge[2] * n[1], edge[2] * n[0] - edge[0] * n[2], edge[0] * n[1] - edge[1] * n[0]};
+                    const float ml = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+                    if (ml == 0)
+                        continue;
+
+                    m[0] /= ml;
+                    m[1] /= ml;
+                    m[2] /= ml;
+
+                    Quadric eq{};
+                    addPlane(eq, m[0], m[1], m[2], -(m[0] * pa[0] + m[1] * pa[1] + m[2] * pa[2]));
+
+                    add(m_quadrics[m_remap[a]], eq);
+                    add(m_quadrics[m_remap[b]], eq);
+                }
+            }
+        }
+
+        void buildAdjacency()
+        {
+            m_adjacencyOffsets.assign(m_vertexCount + 1, 0);
+            for (uint32_t v : m_result)
+                m_adjacencyOffsets[m_remap[v] + 1]++;
+            std::partial_sum(m_adjacencyOffsets.begin(), m_adjacencyOffsets.end(), m_adjacencyOffsets.begin());
+
+            m_adjacency.resize(m_result.size());
+            std::vector<uint32_t> fill(m_adjacencyOffsets.begin(), m_adjacencyOffsets.end() - 1);
+
+            for (size_t i = 0; i < m_result.size(); i++)
+                m_adjacency[fill[m_remap[m_result[i]]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        // border and seam vertices may only move along their open edge; the
+        // other side of a seam must have a matching edge
+        bool canCollapse(uint32_t v0, uint32_t v1) const
+        {
+            const Kind k0 = m_kind[v0];
+
+            if (!CAN_COLLAPSE[k0][m_kind[v1]])
+                return false;
+
+            if (k0 == Border)
+                return m_loop[v0] == v1 || m_loopback[v0] == v1;
+
+            if (k0 == Seam)
+            {
+                if (m_loop[v0] != v1 && m_loopback[v0] != v1)
+                    return false;
+
+                const uint32_t s0 = m_wedge[v0];
+                const uint32_t s1 = m_loop[v0] == v1 ? m_loopback[s0] : m_loop[s0];
+                return s1 != NONE && m_remap[s1] == m_remap[v1];
+            }
+
+            return true;
+        }
+
+        void pickCollapses(float errorLimit)
+        {
+            m_collapses.clear();
+
+            for (size_t i = 0; i < m_result.size(); i += 3)
+            {
+                for (int e = 0; e < 3; e++)
+                {
+                    const uint32_t v0 = m_result[i + e];
+                    const uint32_t v1 = m_result[i + (e + 1) % 3];
+                    const Kind k0 = m_kind[v0];
+                    const Kind k1 = m_kind[v1];
+
+                    if (!CAN_COLLAPSE[k0][k1] && !CAN_COLLAPSE[k1][k0])
+                        continue;
+
+                    const uint32_t r0 = m_remap[v0];
+                    const uint32_t r1 = m_remap[v1];
+
+                    if (r0 == r1 || (HAS_OPPOSITE[k0][k1] && r1 > r0))
+                        continue;
+
+                    m_collapses.push_back({v0, v1, 0});
+                }
+            }
+
+            // evaluate both directions and keep the cheaper one that passes
+            // the flip test. Positions and triangles stay put during a pass,
+            // so the test can run here in parallel rather than when collapsing
+            Parallel::parallelFor(0, m_collapses.size(), GRAIN, [this, errorLimit](size_t begin, size_t end)
+                                  {
+                constexpr float infinity = std::numeric_limits<float>::infinity();
+
+                for (size_t i = begin; i < end; i++)
+                {
+                    uint32_t v0 = m_collapses[i].v0;
+                    uint32_t v1 = m_collapses[i].v1;
+
+                    float e01 = canCollapse(v0, v1) ? quadricError(m_quadrics[m_remap[v0]], position(v1)) : infinity;
+                    float e10 = canCollapse(v1, v0) ? quadricError(m_quadrics[m_remap[v1]], position(v0)) : infinity;
+
+                    if (e10 < e01)
+                    {
+                        std::swap(v0, v1);
+                        std::swap(e01, e10);
+                    }
+
+                    if (e01 <= errorLimit && hasTriangleFlips(m_remap[v0], v1))
+                    {
+                        std::swap(v0, v1);
+                        e01 = e10 <= errorLimit && !hasTriangleFlips(m_remap[v0], v1) ? e10 : infinity;
+                    }
+
+                    m_collapses[i] = {v0, v1, e01 <= errorLimit ? e01 : infinity};
+                } });
+
+            std::erase_if(m_collapses, [](const Collapse &collapse)
+                          { return collapse.error == std::numeric_limits<float>::infinity(); });
+        }
+
+        // whether moving position r0 onto v1 turns a surviving triangle over
+        bool hasTriangleFlips(uint32_t r0, uint32_t v1) const
+        {
+            const uint32_t r1 = m_remap[v1];
+            const float *target = position(v1);
+
+            for (uint32_t k = m_adjacencyOffsets[r0]; k < m_adjacencyOffsets[r0 + 1]; k++)
+            {
+                const uint32_t *t = m_result.data() + size_t(m_adjacency[k]) * 3;
+                const uint32_t a = m_remap[t[0]], b = m_remap[t[1]], c = m_remap[t[2]];
+
+                // triangles containing the edge collapse away
+                if (a == r1 || b == r1 || c == r1)
+                    continue;
+
+                // the two other corners, in winding order
+                const uint32_t o1 = a == r0 ? b : (b == r0 ? c : a);
+                const uint32_t o2 = a == r0 ? c : (b == r0 ? a : b);
+
+                float before[3], after[3];
+                cross(position(r0), position(o1), position(o2), before);
+                cross(target, position(o1), position(o2), after);
+
+                const float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+                const float lengths = (before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) *
+                                      (after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+
+                // also rejects rotations beyond ~75 degrees and new slivers
+                if (dot <= 0.25f * std::sqrt(lengths))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // orders the candidates within `limit` by error, ties by candidate
+        // index: a stable LSD radix sort of (error, index) keys on the float
+        // bits, which order like the (non-negative) floats
+        void sortCollapses(float limit)
+        {
+            m_order.clear();
+            for (size_t i = 0; i < m_collapses.size(); i++)
+            {
+                if (m_collapses[i].error <= limit)
+                    m_order.push_back(uint64_t(std::bit_cast<uint32_t>(m_collapses[i].error)) << 32 | i);
+            }
+
+            m_orderScratch.resize(m_order.size());
+
+            for (int shift = 32; shift < 64; shift += RADIX_BITS)
+            {
+                size_t histogram[1 << RADIX_BITS] = {};
+
+                for (const uint64_t key : m_order)
+                    histogram[(key >> shift) & RADIX_MASK]++;
+
+                size_t sum = 0;
+                for (auto &bucket : histogram)
+                {
+                    const size_t count = bucket;
+                    bucket = sum;
+                    sum += count;
+                }
+
+                for (const uint64_t key : m_order)
+                    m_orderScratch[histogram[(key >> shift) & RADIX_MASK]++] = key;
+
+                m_order.swap(m_orderScratch);
+            }
+        }
+
+        size_t performCollapses(size_t goal, float passLimit, float &resultError)
+        {
+            std::iota(m_collapseRemap.begin(), m_collapseRemap.end(), 0u);
+            std::fill(m_collapseLocked.begin(), m_collapseLocked.end(), uint8_t(0));
+
+            sortCollapses(passLimit);
+
+            size_t collapsed = 0;
+
+            for (const uint64_t key : m_order)
+            {
+                if (collapsed >= goal)
+                    break;
+
+                const Collapse &collapse = m_collapses[key & 0xffffffffu];
+
+                const uint32_t v0 = collapse.v0;
+                const uint32_t v1 = collapse.v1;
+                const uint32_t r0 = m_remap[v0];
+                const uint32_t r1 = m_remap[v1];
+
+                if (m_collapseLocked[r0] || m_collapseLocked[r1])
+                    continue;
+
+                if (m_kind[v0] == Seam)
+                {
+                    // the other side of the seam follows along its own edge
+                    const uint32_t s0 = m_wedge[v0];
+                    const uint32_t s1 = m_loop[v0] == v1 ? m_loopback[s0] : m_loop[s0];
+
+                    m_collapseRemap[v0] = v1;
+                    m_collapseRemap[s0] = s1;
+                }
+                else
+                {
+                    uint32_t v = v0;
+                    do
+                    {
+                        m_collapseRemap[v] = v1;
+                        v = m_wedge[v];
+                    } while (v != v0);
+                }
+
+                m_collapseLocked[r0] = 1;
+                m_collapseLocked[r1] = 1;
+
+                add(m_quadrics[r1], m_quadrics[r0]);
+                resultError = std::max(resultError, collapse.error);
+                collapsed++;
+            }
+
+            return collapsed;
+        }
+
+        void remapIndices()
+        {
+            size_t write = 0;
+
+            for (size_t i = 0; i < m_result.size(); i += 3)
+            {
+                const uint32_t a = m_collapseRemap[m_result[i]];
+                const uint32_t b = m_collapseRemap[m_result[i + 1]];
+                const uint32_t c = m_collapseRemap[m_result[i + 2]];
+
+                if (a == b || b == c || c == a)
+                    continue;
+
+                m_result[write++] = a;
+                m_result[write++] = b;
+                m_result[write++] = c;
+            }
+
+            m_result.resize(write);
+        }
+
+        // keeps the open edge chains intact after their vertices collapsed
+        void remapEdgeLoops(std::vector<uint32_t> &loop)
+        {
+            for (size_t v = 0; v < m_vertexCount; v++)
+            {
+                const uint32_t l = loop[v];
+                if (l == NONE)
+                    continue;
+
+                const uint32_t r = m_collapseRemap[l];
+
+                // the neighbour collapsed onto this vertex: skip over it
+                loop[v] = r == v ? loop[l] : r;
+            }
+        }
+    };
+}
+
+SimplifyModifier::SimplifyModifier()
+{
+}
+
+SimplifyModifier::~SimplifyModifier()
+{
+}
+
+std::shared_ptr<BufferGeometry> SimplifyModifier::modify(const BufferGeometry &geometry, const Options &options)
+{
+    const auto position = geometry.getAttribute("position");
+    if (position == nullptr || position->itemSize() != 3)
+        throw std::invalid_argument("SimplifyModifier: geometry has no 3-component position attribute");
+
+    std::vector<uint32_t> identity;
+    if (!geometry.hasIndex())
+    {
+        identity.resize(position->count() - position->count() % 3);
+        std::iota(identity.begin(), identity.end(), 0u);
+    }
+
+    auto index = simplify(geometry.hasIndex() ? std::span<const uint32_t>(geometry.getIndex()) : std::span<const uint32_t>(identity),
+                          position->span(), options);
+
+    auto result = std::make_shared<BufferGeometry>();
+    result->name(geometry.name());
+
+    for (const auto &[name, attribute] : geometry.attributes())
+        result->setAttribute(name, attribute);
+    for (const auto &target : geometry.morphTargets())
+        result->addMorphTarget(target);
+
+    result->setIndex(std::move(index));
+
+    return result;
+}
+
+std::shared_ptr<BufferGeometry> SimplifyModifier::modify(const BufferGeometry &geometry)
+{
+    return modify(geometry, Options());
+}
+
+std::vector<uint32_t> SimplifyModifier::simplify(std::span<const uint32_t> indices, std::span<const float> positions, const Options &options)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    if (indices.size() % 3 != 0)
+        throw std::invalid_argument("SimplifyModifier: index count is not a multiple of 3");
+
+    const size_t vertexCount = positions.size() / 3;
+    for (uint32_t index : indices)
+    {
+        if (index >= vertexCount)
+            throw std::out_of_range("SimplifyModifier: index out of range");
+    }
+
+    m_stats = {};
+    m_stats.trianglesBefore = indices.size() / 3;
+
+    Simplifier simplifier(indices, positions, options.lockBorder);
+    const auto [passes, error] = simplifier.run(options.targetCount, options.targetError);
+
+    std::vector<uint32_t> result = std::move(simplifier.result());
+
+    m_stats.trianglesAfter = result.size() / 3;
+    m_stats.passes = passes;
+    m_stats.error = std::sqrt(error) * simplifier.scale();
+    m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+std::vector<uint32_t> SimplifyModifier::simplify(std::span<const uint32_t> indices, std::span<const float> positions)
+{
+    return simplify(indices, positions, Options());
+}
+
+const SimplifyModifier::Stats &SimplifyModifier::stats() const
+{
+    return m_stats;
+}
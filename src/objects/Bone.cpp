@@ -0,0 +1,14 @@
+#include "objects/Bone.h"
+
+Bone::Bone()
+{
+}
+
+Bone::~Bone()
+{
+}
+
+std::string Bone::type() const
+{
+    return "Bone";
+}
@@ -0,0 +1,102 @@
+#include "objects/CPUMorphing.h"
+#include "objects/Mesh.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace CPUMorphing
+{
+    // vertices per task; blending is memory bound, so chunks stay large
+    static constexpr size_t MORPHING_GRAIN = 16384;
+
+    // out[indices[i]] += weight * deltas[i] over one slice of a target
+    static inline void accumulate(float *__restrict out, const uint32_t *__restrict indices, const float *__restrict deltas,
+                                  size_t count, float weight)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            float *v = out + static_cast<size_t>(indices[i]) * 3;
+            const float *d = deltas + i * 3;
+
+            v[0] += weight * d[0];
+            v[1] += weight * d[1];
+            v[2] += weight * d[2];
+        }
+    }
+
+    void blendMorphTargets(const MorphStreams &streams, std::span<const MorphTarget> targets, std::span<const float> influences,
+                           size_t begin, size_t end)
+    {
+        if (begin >= end)
+            return;
+
+        std::memcpy(streams.outPositions + begin * 3, streams.positions + begin * 3, (end - begin) * 3 * sizeof(float));
+
+        const bool withNormals = streams.normals != nullptr && streams.outNormals != nullptr;
+        if (withNormals)
+            std::memcpy(streams.outNormals + begin * 3, streams.normals + begin * 3, (end - begin) * 3 * sizeof(float));
+
+        const size_t targetCount = std::min(targets.size(), influences.size());
+
+        for (size_t t = 0; t < targetCount; t++)
+        {
+            const float weight = influences[t];
+            if (weight == 0)
+                continue;
+
+            const auto &target = targets[t];
+            const auto indices = target.indices();
+
+            // slice of the target inside [begin, end)
+            const auto first = std::lower_bound(indices.begin(), indices.end(), static_cast<uint32_t>(begin));
+            const auto last = std::lower_bound(first, indices.end(), static_cast<uint32_t>(std::min<size_t>(end, UINT32_MAX)));
+
+            const size_t offset = static_cast<size_t>(first - indices.begin());
+            const size_t count = static_cast<size_t>(last - first);
+
+            if (count == 0)
+                continue;
+
+            accumulate(streams.outPositions, indices.data() + offset, target.positionDeltas().data() + offset * 3, count, weight);
+
+            if (withNormals && target.hasNormals())
+                accumulate(streams.outNormals, indices.data() + offset, target.normalDeltas().data() + offset * 3, count, weight);
+        }
+    }
+
+    void morphMesh(Mesh &mesh, bool parallel)
+    {
+        THREECPP_PROFILE_ZONE("CPUMorphing::morphMesh");
+
+        auto geometry = mesh.geometry();
+        if (!geometry)
+            return;
+
+        auto position = geometry->getAttribute("position");
+        auto normal = geometry->getAttribute("normal");
+        if (!position)
+            return;
+
+        mesh.allocateMorphedAttributes();
+
+        MorphStreams streams;
+        streams.positions = position->array();
+        streams.normals = normal ? normal->array() : nullptr;
+        streams.outPositions = mesh.morphedPosition()->array();
+        streams.outNormals = normal ? mesh.morphedNormal()->array() : nullptr;
+
+        const std::span<const MorphTarget> targets = geometry->morphTargets();
+        const std::span<const float> influences = mesh.morphTargetInfluences;
+
+        const size_t vertexCount = position->count();
+        const size_t grain = parallel ? MORPHING_GRAIN : vertexCount + 1;
+
+        Parallel::parallelFor(0, vertexCount, grain, [&streams, targets, influences](size_t begin, size_t end)
+                              { blendMorphTargets(streams, targets, influences, begin, end); });
+
+        mesh.morphedPosition()->needsUpdate();
+        if (normal)
+            mesh.morphedNormal()->needsUpdate();
+    }
+}
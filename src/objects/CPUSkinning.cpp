@@ -0,0 +1,348 @@
+#include "objects/CPUSkinning.h"
+#include "objects/SkinnedMesh.h"
+#include "math/Quaternion.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace CPUSkinning
+{
+    // vertices per task when a single mesh is split across threads
+    static constexpr size_t SKINNING_GRAIN = 4096;
+
+    static inline void normalize3(float *v)
+    {
+        const float lengthSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+        const float inv = lengthSq > 0 ? 1.0f / std::sqrt(lengthSq) : 1.0f;
+        v[0] *= inv;
+        v[1] *= inv;
+        v[2] *= inv;
+    }
+
+    void computeSkinningMatrices(const SkinnedMesh &mesh, std::vector<float> &palette)
+    {
+        const auto &boneMatrices = mesh.skeleton()->boneMatrices();
+        const size_t boneCount = boneMatrices.size() / 16;
+
+        float bindMatrix[16], bindMatrixInverse[16], tmp[16];
+        mesh.bindMatrix().toArray(bindMatrix);
+        mesh.bindMatrixInverse().toArray(bindMatrixInverse);
+
+        palette.resize(boneCount * 16);
+
+        for (size_t i = 0; i < boneCount; i++)
+        {
+            Matrix4::multiplyMatricesArray(tmp, boneMatrices.data() + i * 16, bindMatrix, 1);
+            Matrix4::multiplyMatricesArray(palette.data() + i * 16, bindMatrixInverse, tmp, 1);
+        }
+    }
+
+    void computeDualQuaternions(const float *palette, size_t boneCount, float *dualQuaternions)
+    {
+        Vector3 _position, _scale;
+        Quaternion _quaternion;
+        Matrix4 _matrix;
+        std::vector<HIGH_PRECISION> _elements(16);
+
+        for (size_t i = 0; i < boneCount; i++)
+        {
+            const float *m = palette + i * 16;
+            for (size_t k = 0; k < 16; k++)
+                _elements[k] = m[k];
+
+            _matrix.fromArray(_elements);
+            _matrix.decompose(_position, _quaternion, _scale);
+
+            float *dq = dualQuaternions + i * 8;
+            const float real[4] = {(float)_quaternion.x(), (float)_quaternion.y(), (float)_quaternion.z(), (float)_quaternion.w()};
+            const float translation[4] = {(float)_position.x(), (float)_position.y(), (float)_position.z(), 0.0f};
+
+            dq[0] = real[0];
+            dq[1] = real[1];
+            dq[2] = real[2];
+            dq[3] = real[3];
+
+            // dual = 0.5 * translation * real
+            Quaternion::multiplyQuaternionsFlat(dq, 4, translation, 0, real, 0);
+            dq[4] *= 0.5f;
+            dq[5] *= 0.5f;
+            dq[6] *= 0.5f;
+            dq[7] *= 0.5f;
+        }
+    }
+
+    void validateSkinAttributes(const BufferAttribute &skinIndex, const BufferAttribute &skinWeight, size_t vertexCount, size_t boneCount)
+    {
+        if (skinIndex.itemSize() != 4 || skinWeight.itemSize() != 4)
+            throw std::invalid_argument("CPUSkinning: skinIndex and skinWeight need itemSize 4");
+        if (skinIndex.count() < vertexCount || skinWeight.count() < vertexCount)
+            throw std::invalid_argument("CPUSkinning: skinIndex or skinWeight has fewer items than position");
+
+        const float *indices = skinIndex.array();
+        const auto bones = static_cast<float>(boneCount);
+
+        for (size_t i = 0, n = vertexCount * 4; i < n; i++)
+        {
+            // also rejects NaN and negative indices, which the size_t cast would wrap
+            if (!(indices[i] >= 0 && indices[i] < bones))
+                throw std::invalid_argument("CPUSkinning: skinIndex refers to a bone outside the skeleton");
+        }
+    }
+
+    void skinLinearBlend(const SkinningStreams &streams, const float *palette, size_t begin, size_t end)
+    {
+        const float *__restrict positions = streams.positions;
+        const float *__restrict normals = streams.normals;
+        const float *__restrict skinIndices = streams.skinIndices;
+        const float *__restrict skinWeights = streams.skinWeights;
+        float *__restrict outPositions = streams.outPositions;
+        float *__restrict outNormals = streams.outNormals;
+
+        for (size_t v = begin; v < end; v++)
+        {
+            const float *index = skinIndices + v * 4;
+            const float *weight = skinWeights + v * 4;
+
+            const float *m0 = palette + static_cast<size_t>(index[0]) * 16;
+            const float *m1 = palette + static_cast<size_t>(index[1]) * 16;
+            const float *m2 = palette + static_cast<size_t>(index[2]) * 16;
+            const float *m3 = palette + static_cast<size_t>(index[3]) * 16;
+
+            const float *p = positions + v * 3;
+            float *op = outPositions + v * 3;
+
+#if defined(__SSE2__)
+            // blend the four bone matrices column by column, one column per register
+            const __m128 w0 = _mm_set1_ps(weight[0]);
+            const __m128 w1 = _mm_set1_ps(weight[1]);
+            const __m128 w2 = _mm_set1_ps(weight[2]);
+            const __m128 w3 = _mm_set1_ps(weight[3]);
+
+            __m128 columns[4];
+            for (size_t c = 0; c < 4; c++)
+            {
+                columns[c] = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m0 + c * 4), w0), _mm_mul_ps(_mm_loadu_ps(m1 + c * 4), w1)),
+                    _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m2 + c * 4), w2), _mm_mul_ps(_mm_loadu_ps(m3 + c * 4), w3)));
+            }
+
+            alignas(16) float result[4];
+
+            __m128 position = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(p[0])), _mm_mul_ps(columns[1], _mm_set1_ps(p[1]))),
+                _mm_add_ps(_mm_mul_ps(columns[2], _mm_set1_ps(p[2])), columns[3]));
+            _mm_store_ps(result, position);
+
+            op[0] = result[0];
+            op[1] = result[1];
+            op[2] = result[2];
+
+            if (normals != nullptr)
+            {
+                const float *n = normals + v * 3;
+                float *on = outNormals + v * 3;
+
+                __m128 normal = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(n[0])), _mm_mul_ps(columns[1], _mm_set1_ps(n[1]))),
+                    _mm_mul_ps(columns[2], _mm_set1_ps(n[2])));
+                _mm_store_ps(result, normal);
+
+                on[0] = result[0];
+                on[1] = result[1];
+                on[2] = result[2];
+                normalize3(on);
+            }
+#else
+            float blended[12];
+            for (size_t k = 0; k < 12; k++)
+            {
+                // skip the projective row: rows 0-2 of each of the 4 columns
+                const size_t e = (k / 3) * 4 + (k % 3);
+                blended[k] = m0[e] * weight[0] + m1[e] * weight[1] + m2[e] * weight[2] + m3[e] * weight[3];
+            }
+
+            const float px = p[0], py = p[1], pz = p[2];
+            op[0] = blended[0] * px + blended[3] * py + blended[6] * pz + blended[9];
+            op[1] = blended[1] * px + blended[4] * py + blended[7] * pz + blended[10];
+            op[2] = blended[2] * px + blended[5] * py + blended[8] * pz + blended[11];
+
+            if (normals != nullptr)
+            {
+                const float *n = normals + v * 3;
+                float *on = outNormals + v * 3;
+                const float nx = n[0], ny = n[1], nz = n[2];
+
+                on[0] = blended[0] * nx + blended[3] * ny + blended[6] * nz;
+                on[1] = blended[1] * nx + blended[4] * ny + blended[7] * nz;
+                on[2] = blended[2] * nx + blended[5] * ny + blended[8] * nz;
+                normalize3(on);
+            }
+#endif
+        }
+    }
+
+    void skinDualQuaternion(const SkinningStreams &streams, const float *dualQuaternions, size_t begin, size_t end)
+    {
+        const float *__restrict positions = streams.positions;
+        const float *__restrict normals = streams.normals;
+        const float *__restrict skinIndices = streams.skinIndices;
+        const float *__restrict skinWeights = streams.skinWeights;
+        float *__restrict outPositions = streams.outPositions;
+        float *__restrict outNormals = streams.outNormals;
+
+        for (size_t v = begin; v < end; v++)
+        {
+            const float *index = skinIndices + v * 4;
+            const float *weight = skinWeights + v * 4;
+
+            const float *dq0 = dualQuaternions + static_cast<size_t>(index[0]) * 8;
+
+            float blend[8];
+            for (size_t k = 0; k < 8; k++)
+                blend[k] = dq0[k] * weight[0];
+
+            for (size_t i = 1; i < 4; i++)
+            {
+                const float *dq = dualQuaternions + static_cast<size_t>(index[i]) * 8;
+
+                // keep all rotations in the hemisphere of the first influence
+                const float d = dq0[0] * dq[0] + dq0[1] * dq[1] + dq0[2] * dq[2] + dq0[3] * dq[3];
+                const float w = d < 0 ? -weight[i] : weight[i];
+
+                for (size_t k = 0; k < 8; k++)
+                    blend[k] += dq[k] * w;
+            }
+
+            const float length = std::sqrt(blend[0] * blend[0] + blend[1] * blend[1] + blend[2] * blend[2] + blend[3] * blend[3]);
+            const float inv = length > 0 ? 1.0f / length : 0.0f;
+            for (size_t k = 0; k < 8; k++)
+                blend[k] *= inv;
+
+            const float rx = blend[0], ry = blend[1], rz = blend[2], rw = blend[3];
+            const float dx = blend[4], dy = blend[5], dz = blend[6], dw = blend[7];
+
+            // translation = 2 * ( rw * d - dw * r + cross( r, d ) )
+            const float tx = 2 * (rw * dx - dw * rx + ry * dz - rz * dy);
+            const float ty = 2 * (rw * dy - dw * ry + rz * dx - rx * dz);
+            const float tz = 2 * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+            const float *p = positions + v * 3;
+            float *op = outPositions + v * 3;
+
+            // p + 2 * cross( r, cross( r, p ) + rw * p ) + translation
+            {
+                const float px = p[0], py = p[1], pz = p[2];
+                const float cx = ry * pz - rz * py + rw * px;
+                const float cy = rz * px - rx * pz + rw * py;
+                const float cz = rx * py - ry * px + rw * pz;
+
+                op[0] = px + 2 * (ry * cz - rz * cy) + tx;
+                op[1] = py + 2 * (rz * cx - rx * cz) + ty;
+                op[2] = pz + 2 * (rx * cy - ry * cx) + tz;
+            }
+
+            if (normals != nullptr)
+            {
+                const float *n = normals + v * 3;
+                float *on = outNormals + v * 3;
+
+                const float nx = n[0], ny = n[1], nz = n[2];
+                const float cx = ry * nz - rz * ny + rw * nx;
+                const float cy = rz * nx - rx * nz + rw * ny;
+                const float cz = rx * ny - ry * nx + rw * nz;
+
+                on[0] = nx + 2 * (ry * cz - rz * cy);
+                on[1] = ny + 2 * (rz * cx - rx * cz);
+                on[2] = nz + 2 * (rx * cy - ry * cx);
+            }
+        }
+    }
+
+    void skinMesh(SkinnedMesh &mesh, SkinningMethod method, bool parallel)
+    {
+        THREECPP_PROFILE_ZONE("CPUSkinning::skinMesh");
+
+        auto skeleton = mesh.skeleton();
+        auto geometry = mesh.geometry();
+        if (!skeleton || !geometry)
+            return;
+
+        auto position = geometry->getAttribute("position");
+        auto normal = geometry->getAttribute("normal");
+
+        auto skinIndex = geometry->getAttribute("skinIndex");
+        auto skinWeight = geometry->getAttribute("skinWeight");
+        if (!position || !skinIndex || !skinWeight)
+            return;
+
+        // morph targets apply before skinning, as in three.js
+        if (!geometry->morphTargets().empty() && mesh.morphedPosition() && mesh.morphedPosition()->count() == position->count())
+        {
+            position = mesh.morphedPosition();
+            normal = normal ? mesh.morphedNormal() : nullptr;
+        }
+
+        // the palette is indexed unchecked by the kernels
+        const size_t boneCount = skeleton->boneMatrices().size() / 16;
+        mesh.validateSkinAttributes(boneCount);
+
+        mesh.allocateSkinnedAttributes();
+
+        SkinningStreams streams;
+        streams.positions = position->array();
+        streams.normals = normal ? normal->array() : nullptr;
+        streams.skinIndices = skinIndex->array();
+        streams.skinWeights = skinWeight->array();
+        streams.outPositions = mesh.skinnedPosition()->array();
+        streams.outNormals = normal ? mesh.skinnedNormal()->array() : nullptr;
+
+        // per-mesh scratch so steady-state frames do not allocate; not
+        // thread_local, as this thread may run a nested pass while the jobs
+        // below still read the palette
+        std::vector<float> &palette = mesh.m_palette;
+        std::vector<float> &dualQuaternions = mesh.m_dualQuaternions;
+
+        computeSkinningMatrices(mesh, palette);
+
+        const size_t vertexCount = position->count();
+        const size_t grain = parallel ? SKINNING_GRAIN : vertexCount + 1;
+
+        if (method == SkinningMethod::DualQuaternion)
+        {
+            dualQuaternions.resize(boneCount * 8);
+            computeDualQuaternions(palette.data(), boneCount, dualQuaternions.data());
+
+            const float *dq = dualQuaternions.data();
+            Parallel::parallelFor(0, vertexCount, grain, [&streams, dq](size_t begin, size_t end)
+                                  { skinDualQuaternion(streams, dq, begin, end); });
+        }
+        else
+        {
+            const float *matrices = palette.data();
+            Parallel::parallelFor(0, vertexCount, grain, [&streams, matrices](size_t begin, size_t end)
+                                  { skinLinearBlend(streams, matrices, begin, end); });
+        }
+
+        mesh.skinnedPosition()->needsUpdate();
+        if (mesh.skinnedNormal())
+            mesh.skinnedNormal()->needsUpdate();
+    }
+
+    void skinMeshes(std::span<SkinnedMesh *const> meshes, SkinningMethod method)
+    {
+        THREECPP_PROFILE_ZONE("CPUSkinning::skinMeshes");
+
+        // one mesh per task: crowds have many small meshes, so splitting
+        // inside a mesh would only add scheduling overhead
+        Parallel::parallelFor(0, meshes.size(), 1, [&meshes, method](size_t begin, size_t end)
+                              {
+                                  for (size_t i = begin; i < end; i++)
+                                      skinMesh(*meshes[i], method, false);
+                              });
+    }
+}
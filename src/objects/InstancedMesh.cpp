@@ -0,0 +1,312 @@
+#include "objects/InstancedMesh.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// instances per task for sphere refresh and culling
+static constexpr size_t INSTANCE_GRAIN = 65536;
+
+// past this many ranges the list collapses into one covering range
+static constexpr size_t MAX_UPDATE_RANGES = 64;
+
+static void addUpdateRange(std::vector<InstancedMesh::UpdateRange> &ranges, size_t start, size_t count)
+{
+    if (!ranges.empty())
+    {
+        auto &last = ranges.back();
+
+        // coalesce with the previous range when touching or overlapping
+        if (start <= last.start + last.count && start + count >= last.start)
+        {
+            const size_t end = std::max(last.start + last.count, start + count);
+            last.start = std::min(last.start, start);
+            last.count = end - last.start;
+            return;
+        }
+    }
+
+    ranges.push_back({start, count});
+
+    if (ranges.size() > MAX_UPDATE_RANGES)
+    {
+        size_t first = ranges.front().start, end = 0;
+        for (auto &range : ranges)
+        {
+            first = std::min(first, range.start);
+            end = std::max(end, range.start + range.count);
+        }
+
+        ranges.assign(1, {first, end - first});
+    }
+}
+
+// sphere of one instance: the geometry sphere moved by the instance matrix,
+// scaled by its largest axis
+static void transformSpheres(const float *__restrict matrices, float *__restrict spheres, size_t begin, size_t end,
+                             float cx, float cy, float cz, float radius)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        const float *e = matrices + i * 16;
+        float *s = spheres + i * 4;
+
+        s[0] = e[0] * cx + e[4] * cy + e[8] * cz + e[12];
+        s[1] = e[1] * cx + e[5] * cy + e[9] * cz + e[13];
+        s[2] = e[2] * cx + e[6] * cy + e[10] * cz + e[14];
+
+        const float scaleXSq = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+        const float scaleYSq = e[4] * e[4] + e[5] * e[5] + e[6] * e[6];
+        const float scaleZSq = e[8] * e[8] + e[9] * e[9] + e[10] * e[10];
+
+        s[3] = radius * std::sqrt(std::max(std::max(scaleXSq, scaleYSq), scaleZSq));
+    }
+}
+
+InstancedMesh::InstancedMesh(std::shared_ptr<BufferGeometry> geometry, size_t count)
+    : Mesh(std::move(geometry)), m_count(count)
+{
+    m_instanceMatrix = std::make_shared<BufferAttribute>(count, 16);
+
+    float *array = m_instanceMatrix->array();
+    for (size_t i = 0; i < count; i++)
+    {
+        float *e = array + i * 16;
+        e[0] = e[5] = e[10] = e[15] = 1.0f;
+    }
+
+    m_instanceSpheres.resize(count * 4);
+    m_sphereRanges.push_back({0, count});
+}
+
+InstancedMesh::~InstancedMesh()
+{
+}
+
+std::string InstancedMesh::type() const
+{
+    return "InstancedMesh";
+}
+
+size_t InstancedMesh::count() const
+{
+    return m_count;
+}
+
+std::shared_ptr<BufferAttribute> InstancedMesh::instanceMatrix() const
+{
+    return m_instanceMatrix;
+}
+
+std::shared_ptr<BufferAttribute> InstancedMesh::instanceColor() const
+{
+    return m_instanceColor;
+}
+
+void InstancedMesh::getMatrixAt(size_t index, Matrix4 &matrix) const
+{
+    matrix.fromArray(m_instanceMatrix->array(), index * 16);
+}
+
+void InstancedMesh::setMatrixAt(size_t index, const Matrix4 &matrix)
+{
+    matrix.toArray(m_instanceMatrix->array(), index * 16);
+    markDirty(index, 1);
+}
+
+void InstancedMesh::setMatricesAt(size_t start, std::span<const float> matrices)
+{
+    const size_t count = matrices.size() / 16;
+
+    if (start + count > m_count)
+        throw std::out_of_range("InstancedMesh: setMatricesAt writes past the instance count");
+
+    std::memcpy(m_instanceMatrix->array() + start * 16, matrices.data(), count * 16 * sizeof(float));
+    markDirty(start, count);
+}
+
+void InstancedMesh::getColorAt(size_t index, float *rgb) const
+{
+    if (!m_instanceColor)
+    {
+        rgb[0] = rgb[1] = rgb[2] = 1.0f;
+        return;
+    }
+
+    const float *c = m_instanceColor->array() + index * 3;
+    rgb[0] = c[0];
+    rgb[1] = c[1];
+    rgb[2] = c[2];
+}
+
+void InstancedMesh::getColorAt(size_t index, Color &color) const
+{
+    float rgb[3];
+    getColorAt(index, rgb);
+    color.fromArray(rgb);
+}
+
+void InstancedMesh::setColorAt(size_t index, float r, float g, float b)
+{
+    if (!m_instanceColor)
+    {
+        // instances without an explicit color render white
+        m_instanceColor = std::make_shared<BufferAttribute>(std::vector<float>(m_count * 3, 1.0f), 3);
+        addUpdateRange(m_colorRanges, 0, m_count);
+    }
+
+    float *c = m_instanceColor->array() + index * 3;
+    c[0] = r;
+    c[1] = g;
+    c[2] = b;
+
+    addUpdateRange(m_colorRanges, index, 1);
+    m_instanceColor->needsUpdate();
+}
+
+void InstancedMesh::setColorAt(size_t index, const Color &color)
+{
+    setColorAt(index, color.r, color.g, color.b);
+}
+
+const std::vector<InstancedMesh::UpdateRange> &InstancedMesh::matrixUpdateRanges() const
+{
+    return m_matrixRanges;
+}
+
+const std::vector<InstancedMesh::UpdateRange> &InstancedMesh::colorUpdateRanges() const
+{
+    return m_colorRanges;
+}
+
+void InstancedMesh::clearUpdateRanges()
+{
+    m_matrixRanges.clear();
+    m_colorRanges.clear();
+}
+
+void InstancedMesh::markDirty(size_t start, size_t count)
+{
+    addUpdateRange(m_matrixRanges, start, count);
+    addUpdateRange(m_sphereRanges, start, count);
+    m_instanceMatrix->needsUpdate();
+}
+
+void InstancedMesh::updateInstanceSpheres()
+{
+    auto geometry = this->geometry();
+
+    if (geometry->boundingSphere() == nullptr)
+        geometry->computeBoundingSphere();
+
+    // a new geometry sphere invalidates every instance
+    if (!geometry->boundingSphere()->equals(m_geometrySphere))
+    {
+        m_geometrySphere.copy(*geometry->boundingSphere());
+        m_sphereRanges.assign(1, {0, m_count});
+    }
+
+    const float cx = static_cast<float>(m_geometrySphere.center().x());
+    const float cy = static_cast<float>(m_geometrySphere.center().y());
+    const float cz = static_cast<float>(m_geometrySphere.center().z());
+    const float radius = static_cast<float>(m_geometrySphere.radius);
+
+    const float *matrices = m_instanceMatrix->array();
+    float *spheres = m_instanceSpheres.data();
+
+    for (auto &range : m_sphereRanges)
+    {
+        Parallel::parallelFor(range.start, range.start + range.count, INSTANCE_GRAIN, [=](size_t begin, size_t end)
+                              { transformSpheres(matrices, spheres, begin, end, cx, cy, cz, radius); });
+    }
+
+    m_sphereRanges.clear();
+}
+
+const std::vector<float> &InstancedMesh::instanceSpheres()
+{
+    updateInstanceSpheres();
+    return m_instanceSpheres;
+}
+
+const Sphere *InstancedMesh::boundingSphere() const
+{
+    return m_boundingSphere ? &*m_boundingSphere : nullptr;
+}
+
+void InstancedMesh::computeBoundingSphere()
+{
+    updateInstanceSpheres();
+
+    if (!m_boundingSphere)
+        m_boundingSphere.emplace();
+
+    m_boundingSphere->makeEmpty();
+
+    Sphere _sphere;
+    for (size_t i = 0; i < m_count; i++)
+    {
+        const float *s = m_instanceSpheres.data() + i * 4;
+        _sphere.set(Vector3(s[0], s[1], s[2]), s[3]);
+        m_boundingSphere->unionSphere(_sphere);
+    }
+}
+
+size_t InstancedMesh::cull(const Frustum &frustum, std::vector<uint32_t> &drawList)
+{
+    THREECPP_PROFILE_ZONE("InstancedMesh::cull");
+
+    updateInstanceSpheres();
+
+    drawList.resize(m_count);
+
+    // every chunk compacts into its own slice of the draw list, then the
+    // slices are packed together in order
+
+    const size_t chunkCount = (m_count + INSTANCE_GRAIN - 1) / INSTANCE_GRAIN;
+    m_chunkCounts.assign(chunkCount, 0);
+
+    const float *spheres = m_instanceSpheres.data();
+    uint32_t *visible = drawList.data();
+    uint32_t *chunkCounts = m_chunkCounts.data();
+    const size_t count = m_count;
+
+    Parallel::parallelFor(0, chunkCount, 1, [&frustum, spheres, visible, chunkCounts, count](size_t begin, size_t end)
+                          {
+        for (size_t chunk = begin; chunk < end; chunk++)
+        {
+            const size_t first = chunk * INSTANCE_GRAIN;
+            const size_t n = std::min(INSTANCE_GRAIN, count - first);
+
+            chunkCounts[chunk] = static_cast<uint32_t>(frustum.intersectsSpheres(spheres + first * 4, n, visible + first, static_cast<uint32_t>(first)));
+        } });
+
+    size_t written = 0;
+    for (size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        const size_t first = chunk * INSTANCE_GRAIN;
+
+        if (written != first)
+            std::memmove(visible + written, visible + first, chunkCounts[chunk] * sizeof(uint32_t));
+
+        written += chunkCounts[chunk];
+    }
+
+    drawList.resize(written);
+    THREECPP_PROFILE_COUNT(ObjectsCulled, count - written);
+
+    return written;
+}
+
+size_t InstancedMesh::cull(const Matrix4 &viewProjection, std::vector<uint32_t> &drawList)
+{
+    Matrix4 _projScreenMatrix;
+    _projScreenMatrix.multiplyMatrices(viewProjection, matrixWorld());
+
+    Frustum _frustum;
+    _frustum.setFromProjectionMatrix(_projScreenMatrix);
+
+    return cull(_frustum, drawList);
+}
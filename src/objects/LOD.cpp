@@ -0,0 +1,172 @@
+#include "objects/LOD.h"
+#include "cameras/Camera.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+// LOD nodes per task in the batch update
+static constexpr size_t LOD_GRAIN = 1024;
+
+namespace
+{
+    /**
+     * What the level selection needs from the camera: its world position
+     * and the pixels covered by one world unit at distance one (or at any
+     * distance, for orthographic projections).
+     */
+    struct View
+    {
+        HIGH_PRECISION position[3];
+        HIGH_PRECISION pixelsPerUnit;
+        bool perspective;
+    };
+
+    View viewOf(const Camera &camera, float screenHeight)
+    {
+        const auto world = camera.matrixWorld().elements();
+        const auto projection = camera.projectionMatrix().elements();
+
+        // projection[5] maps view space y to clip space y, which spans two
+        // units across the viewport; perspective projections divide by depth
+        return {{world[12], world[13], world[14]}, static_cast<float>(projection[5] * screenHeight * 0.5), projection[11] != 0};
+    }
+
+    float pixelsPerUnit(const LOD &lod, const View &view)
+    {
+        const auto &matrixWorld = lod.matrixWorld();
+        const HIGH_PRECISION scale = matrixWorld.getMaxScaleOnAxis();
+
+        if (!view.perspective)
+            return static_cast<float>(view.pixelsPerUnit * scale);
+
+        const auto te = matrixWorld.elements();
+        const HIGH_PRECISION dx = te[12] - view.position[0];
+        const HIGH_PRECISION dy = te[13] - view.position[1];
+        const HIGH_PRECISION dz = te[14] - view.position[2];
+        const HIGH_PRECISION distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        return static_cast<float>(view.pixelsPerUnit * scale / std::max<HIGH_PRECISION>(distance, 1e-6));
+    }
+}
+
+LOD::LOD()
+{
+}
+
+LOD::~LOD()
+{
+}
+
+std::string LOD::type() const
+{
+    return "LOD";
+}
+
+LOD &LOD::addLevel(const std::shared_ptr<Object3D> &object, float error, float hysteresis)
+{
+    error = std::abs(error);
+
+    const auto position = std::upper_bound(m_levels.begin(), m_levels.end(), error, [](float value, const Level &level)
+                                           { return value < level.error; });
+    const auto index = static_cast<size_t>(position - m_levels.begin());
+
+    // keep showing the same object
+    if (!m_levels.empty() && index <= m_currentLevel)
+        m_currentLevel++;
+
+    m_levels.insert(position, {object, error, hysteresis});
+    add(object);
+
+    for (size_t i = 0; i < m_levels.size(); i++)
+        m_levels[i].object->visible = i == m_currentLevel;
+
+    return *this;
+}
+
+const std::vector<LOD::Level> &LOD::levels() const
+{
+    return m_levels;
+}
+
+size_t LOD::getCurrentLevel() const
+{
+    return m_currentLevel;
+}
+
+size_t LOD::getLevelForScale(float pixelsPerUnit) const
+{
+    if (m_levels.empty())
+        return 0;
+
+    size_t level = std::min(m_currentLevel, m_levels.size() - 1);
+
+    // refine as long as the shown level is too coarse ...
+    while (level > 0 && m_levels[level].error * pixelsPerUnit > maxScreenError)
+        level--;
+
+    // ... and coarsen while the next level is clearly fine enough
+    while (level + 1 < m_levels.size() &&
+           m_levels[level + 1].error * pixelsPerUnit <= maxScreenError * (1 - m_levels[level + 1].hysteresis))
+        level++;
+
+    return level;
+}
+
+void LOD::update(const Camera &camera, float screenHeight)
+{
+    if (m_levels.size() > 1)
+        select(getLevelForScale(pixelsPerUnit(*this, viewOf(camera, screenHeight))));
+}
+
+size_t LOD::update(std::span<LOD *const> lods, const Camera &camera, float screenHeight)
+{
+    THREECPP_PROFILE_ZONE("LOD::update");
+
+    const View view = viewOf(camera, screenHeight);
+    std::atomic<size_t> switched = 0;
+
+    Parallel::parallelFor(0, lods.size(), LOD_GRAIN, [&](size_t begin, size_t end)
+                          {
+        size_t count = 0;
+
+        for (size_t i = begin; i < end; i++)
+        {
+            LOD &lod = *lods[i];
+
+            if (!lod.autoUpdate || lod.m_levels.size() < 2)
+                continue;
+
+            if (lod.select(lod.getLevelForScale(pixelsPerUnit(lod, view))))
+                count++;
+        }
+
+        switched += count; });
+
+    return switched;
+}
+
+std::vector<LOD *> LOD::collect(Object3D &root)
+{
+    std::vector<LOD *> lods;
+
+    root.traverse([&lods](Object3D &object)
+                  {
+        if (auto lod = dynamic_cast<LOD *>(&object))
+            lods.push_back(lod); });
+
+    return lods;
+}
+
+bool LOD::select(size_t level)
+{
+    if (level == m_currentLevel)
+        return false;
+
+    m_levels[m_currentLevel].object->visible = false;
+    m_levels[level].object->visible = true;
+    m_currentLevel = level;
+
+    return true;
+}
@@ -0,0 +1,79 @@
+#include "objects/Mesh.h"
+#include "objects/CPUMorphing.h"
+
+Mesh::Mesh(std::shared_ptr<BufferGeometry> geometry)
+    : m_geometry(std::move(geometry))
+{
+}
+
+Mesh::~Mesh()
+{
+}
+
+std::string Mesh::type() const
+{
+    return "Mesh";
+}
+
+std::shared_ptr<BufferGeometry> Mesh::geometry() const
+{
+    return m_geometry;
+}
+
+void Mesh::geometry(std::shared_ptr<BufferGeometry> value)
+{
+    m_geometry = std::move(value);
+}
+
+void Mesh::updateMorphTargets()
+{
+    morphTargetDictionary.clear();
+
+    if (!m_geometry)
+    {
+        morphTargetInfluences.clear();
+        return;
+    }
+
+    const auto &targets = m_geometry->morphTargets();
+    morphTargetInfluences.resize(targets.size(), 0.0f);
+
+    for (size_t i = 0; i < targets.size(); i++)
+        morphTargetDictionary[targets[i].name()] = i;
+}
+
+void Mesh::computeMorphedAttributes(bool parallel)
+{
+    CPUMorphing::morphMesh(*this, parallel);
+}
+
+std::shared_ptr<BufferAttribute> Mesh::morphedPosition() const
+{
+    return m_morphedPosition;
+}
+
+std::shared_ptr<BufferAttribute> Mesh::morphedNormal() const
+{
+    return m_morphedNormal;
+}
+
+void Mesh::allocateMorphedAttributes()
+{
+    auto position = m_geometry ? m_geometry->getAttribute("position") : nullptr;
+    auto normal = m_geometry ? m_geometry->getAttribute("normal") : nullptr;
+
+    const size_t count = position ? position->count() : 0;
+
+    if (!m_morphedPosition || m_morphedPosition->count() != count)
+        m_morphedPosition = std::make_shared<BufferAttribute>(count, 3);
+
+    if (normal)
+    {
+        if (!m_morphedNormal || m_morphedNormal->count() != count)
+            m_morphedNormal = std::make_shared<BufferAttribute>(count, 3);
+    }
+    else
+    {
+        m_morphedNormal = nullptr;
+    }
+}
@@ -0,0 +1,171 @@
+#include "objects/Skeleton.h"
+#include "math/MathUtils.h"
+#include "common/Parallel.h"
+#include "common/Profiler.h"
+#include <stdexcept>
+
+Skeleton::Skeleton(std::vector<std::shared_ptr<Bone>> bones, std::vector<Matrix4> boneInverses)
+    : m_bones(std::move(bones)), m_boneInverses(std::move(boneInverses))
+{
+    m_uuid = MathUtils::generateUUID();
+
+    m_boneMatrices.assign(m_bones.size() * 16, 0.0f);
+    m_boneWorldElements.assign(m_bones.size() * 16, 0.0f);
+
+    // calculate inverse bone matrices if necessary
+
+    if (m_boneInverses.empty())
+    {
+        calculateInverses();
+    }
+    else
+    {
+        // handle special case
+
+        if (m_bones.size() != m_boneInverses.size())
+            throw std::invalid_argument("Skeleton: Number of inverse bone matrices does not match amount of bones.");
+
+        syncInverseElements();
+    }
+}
+
+Skeleton::~Skeleton()
+{
+}
+
+void Skeleton::updateSkeletons(std::span<Skeleton *const> skeletons)
+{
+    THREECPP_PROFILE_ZONE("Skeleton::updateSkeletons");
+
+    Parallel::parallelFor(0, skeletons.size(), 64, [&skeletons](size_t begin, size_t end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                                  skeletons[i]->update();
+                          });
+}
+
+const std::string &Skeleton::uuid() const
+{
+    return m_uuid;
+}
+
+size_t Skeleton::boneCount() const
+{
+    return m_bones.size();
+}
+
+const std::vector<std::shared_ptr<Bone>> &Skeleton::bones() const
+{
+    return m_bones;
+}
+
+const std::vector<Matrix4> &Skeleton::boneInverses() const
+{
+    return m_boneInverses;
+}
+
+const std::vector<float> &Skeleton::boneMatrices() const
+{
+    return m_boneMatrices;
+}
+
+void Skeleton::calculateInverses()
+{
+    m_boneInverses.assign(m_bones.size(), Matrix4());
+
+    for (size_t i = 0; i < m_bones.size(); i++)
+    {
+        if (m_bones[i])
+        {
+            m_boneInverses[i].copy(m_bones[i]->matrixWorld());
+            m_boneInverses[i].invert();
+        }
+    }
+
+    syncInverseElements();
+}
+
+void Skeleton::pose()
+{
+    // recover the bind-time world matrices
+
+    for (size_t i = 0; i < m_bones.size(); i++)
+    {
+        if (m_bones[i])
+        {
+            m_bones[i]->matrixWorld().copy(m_boneInverses[i]);
+            m_bones[i]->matrixWorld().invert();
+        }
+    }
+
+    // compute the local matrices, positions, rotations and scales
+
+    for (auto &bone : m_bones)
+    {
+        if (!bone)
+            continue;
+
+        auto parent = bone->parent();
+
+        if (parent != nullptr && parent->type() == "Bone")
+        {
+            Matrix4 _parentInverse;
+            _parentInverse.copy(parent->matrixWorld());
+            _parentInverse.invert();
+            bone->matrix().multiplyMatrices(_parentInverse, bone->matrixWorld());
+        }
+        else
+        {
+            bone->matrix().copy(bone->matrixWorld());
+        }
+
+        bone->matrix().decompose(bone->position(), bone->quaternion(), bone->scale());
+    }
+}
+
+void Skeleton::update()
+{
+    THREECPP_PROFILE_ZONE("Skeleton::update");
+
+    const size_t count = m_bones.size();
+
+    // gather the world matrices into one contiguous float buffer, so the
+    // palette multiply below runs as a single batched pass
+
+    for (size_t i = 0; i < count; i++)
+    {
+        float *dst = m_boneWorldElements.data() + i * 16;
+
+        if (m_bones[i])
+        {
+            m_bones[i]->matrixWorld().toArray(dst);
+        }
+        else
+        {
+            // a missing bone falls back to the identity matrix
+            for (size_t k = 0; k < 16; k++)
+                dst[k] = (k % 5 == 0) ? 1.0f : 0.0f;
+        }
+    }
+
+    Matrix4::multiplyMatricesArray(m_boneMatrices.data(), m_boneWorldElements.data(), m_boneInverseElements.data(), count);
+}
+
+std::shared_ptr<Bone> Skeleton::getBoneByName(const std::string &name) const
+{
+    for (auto &bone : m_bones)
+    {
+        if (bone && bone->name() == name)
+            return bone;
+    }
+
+    return nullptr;
+}
+
+void Skeleton::syncInverseElements()
+{
+    m_boneInverseElements.assign(m_boneInverses.size() * 16, 0.0f);
+
+    for (size_t i = 0; i < m_boneInverses.size(); i++)
+        m_boneInverses[i].toArray(m_boneInverseElements.data(), i * 16);
+}
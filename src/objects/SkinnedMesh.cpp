@@ -0,0 +1,208 @@
+#include "objects/SkinnedMesh.h"
+#include <cmath>
+#include <stdexcept>
+
+SkinnedMesh::SkinnedMesh(std::shared_ptr<BufferGeometry> geometry)
+    : Mesh(std::move(geometry))
+{
+}
+
+SkinnedMesh::~SkinnedMesh()
+{
+}
+
+std::string SkinnedMesh::type() const
+{
+    return "SkinnedMesh";
+}
+
+std::shared_ptr<Skeleton> SkinnedMesh::skeleton() const
+{
+    return m_skeleton;
+}
+
+const Matrix4 &SkinnedMesh::bindMatrix() const
+{
+    return m_bindMatrix;
+}
+
+const Matrix4 &SkinnedMesh::bindMatrixInverse() const
+{
+    return m_bindMatrixInverse;
+}
+
+void SkinnedMesh::bind(std::shared_ptr<Skeleton> skeleton)
+{
+    updateMatrixWorld(true);
+    bind(std::move(skeleton), matrixWorld());
+}
+
+void SkinnedMesh::bind(std::shared_ptr<Skeleton> skeleton, const Matrix4 &bindMatrix)
+{
+    m_skeleton = std::move(skeleton);
+
+    m_bindMatrix.copy(bindMatrix);
+    m_bindMatrixInverse.copy(bindMatrix);
+    m_bindMatrixInverse.invert();
+
+    // reject bad skin indices at bind time rather than on the first pass
+    if (m_skeleton && geometry()->getAttribute("skinIndex"))
+        validateSkinAttributes(m_skeleton->bones().size());
+}
+
+void SkinnedMesh::pose()
+{
+    if (m_skeleton)
+        m_skeleton->pose();
+}
+
+void SkinnedMesh::normalizeSkinWeights()
+{
+    auto skinWeight = geometry()->getAttribute("skinWeight");
+    if (!skinWeight)
+        return;
+
+    float *weights = skinWeight->array();
+
+    for (size_t i = 0, l = skinWeight->count(); i < l; i++)
+    {
+        float *w = weights + i * 4;
+        const float scale = std::abs(w[0]) + std::abs(w[1]) + std::abs(w[2]) + std::abs(w[3]);
+
+        if (scale != 0)
+        {
+            const float inv = 1.0f / scale;
+            w[0] *= inv;
+            w[1] *= inv;
+            w[2] *= inv;
+            w[3] *= inv;
+        }
+        else
+        {
+            // do something reasonable
+            w[0] = 1;
+            w[1] = 0;
+            w[2] = 0;
+            w[3] = 0;
+        }
+    }
+
+    skinWeight->needsUpdate();
+}
+
+void SkinnedMesh::updateMatrixWorld(bool force)
+{
+    Mesh::updateMatrixWorld(force);
+
+    if (bindMode == BindMode::Attached)
+    {
+        m_bindMatrixInverse.copy(matrixWorld());
+        m_bindMatrixInverse.invert();
+    }
+    else if (bindMode == BindMode::Detached)
+    {
+        m_bindMatrixInverse.copy(m_bindMatrix);
+        m_bindMatrixInverse.invert();
+    }
+}
+
+Vector3 &SkinnedMesh::applyBoneTransform(size_t index, Vector3 &target) const
+{
+    auto geometry = this->geometry();
+    auto skinIndex = geometry->getAttribute("skinIndex");
+    auto skinWeight = geometry->getAttribute("skinWeight");
+
+    Vector3 _basePosition;
+    _basePosition.copy(target);
+    _basePosition.applyMatrix4(m_bindMatrix);
+
+    target.set(0, 0, 0);
+
+    const auto &boneMatrices = m_skeleton->boneMatrices();
+
+    for (size_t i = 0; i < 4; i++)
+    {
+        const float weight = skinWeight->getComponent(index, i);
+
+        if (weight != 0)
+        {
+            const size_t boneIndex = static_cast<size_t>(skinIndex->getComponent(index, i));
+
+            Matrix4 _matrix;
+            std::vector<HIGH_PRECISION> elements(boneMatrices.begin() + boneIndex * 16, boneMatrices.begin() + boneIndex * 16 + 16);
+            _matrix.fromArray(elements);
+
+            Vector3 _vector;
+            _vector.copy(_basePosition);
+            _vector.applyMatrix4(_matrix);
+            target.addScaledVector(_vector, weight);
+        }
+    }
+
+    target.applyMatrix4(m_bindMatrixInverse);
+    return target;
+}
+
+void SkinnedMesh::computeSkinnedAttributes(CPUSkinning::SkinningMethod method)
+{
+    CPUSkinning::skinMesh(*this, method);
+}
+
+std::shared_ptr<BufferAttribute> SkinnedMesh::skinnedPosition() const
+{
+    return m_skinnedPosition;
+}
+
+std::shared_ptr<BufferAttribute> SkinnedMesh::skinnedNormal() const
+{
+    return m_skinnedNormal;
+}
+
+void SkinnedMesh::allocateSkinnedAttributes()
+{
+    auto geometry = this->geometry();
+    auto position = geometry->getAttribute("position");
+    auto normal = geometry->getAttribute("normal");
+
+    const size_t count = position ? position->count() : 0;
+
+    if (!m_skinnedPosition || m_skinnedPosition->count() != count)
+        m_skinnedPosition = std::make_shared<BufferAttribute>(count, 3);
+
+    if (normal)
+    {
+        if (!m_skinnedNormal || m_skinnedNormal->count() != count)
+            m_skinnedNormal = std::make_shared<BufferAttribute>(count, 3);
+    }
+    else
+    {
+        m_skinnedNormal = nullptr;
+    }
+}
+
+void SkinnedMesh::validateSkinAttributes(size_t boneCount)
+{
+    auto geometry = this->geometry();
+    auto position = geometry->getAttribute("position");
+    auto skinIndex = geometry->getAttribute("skinIndex");
+    auto skinWeight = geometry->getAttribute("skinWeight");
+
+    if (!skinIndex || !skinWeight)
+        throw std::invalid_argument("SkinnedMesh: geometry needs skinIndex and skinWeight attributes");
+
+    const size_t vertexCount = position ? position->count() : 0;
+
+    if (skinIndex == m_validatedSkinIndex && skinIndex->version() == m_validatedSkinIndexVersion &&
+        skinWeight == m_validatedSkinWeight && skinWeight->version() == m_validatedSkinWeightVersion &&
+        vertexCount == m_validatedVertexCount && boneCount == m_validatedBoneCount)
+        return;
+
+    CPUSkinning::validateSkinAttributes(*skinIndex, *skinWeight, vertexCount, boneCount);
+
+    m_validatedSkinIndex = skinIndex;
+    m_validatedSkinWeight = skinWeight;
+    m_validatedSkinIndexVersion = skinIndex->version();
+    m_validatedSkinWeightVersion = skinWeight->version();
+    m_validatedVertexCount = vertexCount;
+    m_validatedBoneCount = boneCount;
+}
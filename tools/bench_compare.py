@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Compares two threecpp_bench (or Google Benchmark) JSON files.
+
+    tools/bench_compare.py baseline.json contender.json [--threshold 5] [--metric real_time]
+
+Benchmarks are matched by name. A benchmark whose time grew by more than the
+threshold, in percent, is a regression and makes the script exit with 1, so it
+can gate a CI job. Benchmarks present in only one file are listed but do not
+fail the comparison.
+"""
+
+import argparse
+import json
+import sys
+
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    with open(path) as file:
+        data = json.load(file)
+
+    benchmarks = {}
+    for benchmark in data.get("benchmarks", []):
+        # skip mean/median/stddev rows that Google Benchmark adds for repetitions
+        if benchmark.get("run_type", "iteration") != "iteration":
+            continue
+        benchmarks[benchmark["name"]] = benchmark
+
+    return data.get("context", {}), benchmarks
+
+
+def nanoseconds(benchmark, metric):
+    return benchmark[metric] * UNITS[benchmark.get("time_unit", "ns")]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flags benchmark regressions between two JSON runs.")
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=5.0, help="allowed slowdown in percent (default 5)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time")
+    parser.add_argument("--filter", default="", help="only compare names containing this text")
+    arguments = parser.parse_args()
+
+    baseContext, base = load(arguments.baseline)
+    newContext, new = load(arguments.contender)
+
+    for key in ("scalar", "simd", "cpu_simd", "num_cpus", "library_build_type"):
+        if key in baseContext and key in newContext and baseContext[key] != newContext[key]:
+            print(f"warning: {key} differs: {baseContext[key]} vs {newContext[key]}", file=sys.stderr)
+
+    names = [name for name in base if name in new and arguments.filter in name]
+    width = max([len(name) for name in names] + [9])
+
+    print(f"{'benchmark':<{width}}  {'baseline':>14}  {'contender':>14}  {'change':>8}")
+    regressions = []
+    for name in names:
+        before = nanoseconds(base[name], arguments.metric)
+        after = nanoseconds(new[name], arguments.metric)
+        change = (after - before) / before * 100 if before > 0 else 0.0
+
+        status = ""
+        if change > arguments.threshold:
+            status = "  REGRESSION"
+            regressions.append(name)
+        elif change < -arguments.threshold:
+            status = "  improved"
+
+        print(f"{name:<{width}}  {before:>11.1f} ns  {after:>11.1f} ns  {change:>+7.1f}%{status}")
+
+    for name in base:
+        if name not in new and arguments.filter in name:
+            print(f"only in baseline: {name}")
+    for name in new:
+        if name not in base and arguments.filter in name:
+            print(f"only in contender: {name}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {arguments.threshold}%", file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+# Builds the library in several optimization configurations and records the
+# build time, the library and benchmark sizes and a benchmark run of each.
+#
+#   tools/build_matrix.sh [--configs "baseline default lto native pgo"] [--filter <regex>] [--out <dir>]
+#
+# Configurations:
+#   baseline  Release, no multiversioning
+#   default   Release, kernels cloned for AVX2 / AVX-512
+#   lto       default plus link time optimization
+#   native    default plus -march=native
+#   pgo       default plus a profile recorded by the benchmarks
+#
+# Every configuration writes <out>/<name>.json; compare two of them with
+#   tools/bench_compare.py <out>/baseline.json <out>/lto.json
+
+set -euo pipefail
+
+root="$(cd "$(dirname "$0")/.." && pwd)"
+configs="baseline default lto native pgo"
+filter="."
+out="$root/build-matrix"
+jobs="$(nproc 2>/dev/null || echo 4)"
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+    --configs) configs="$2"; shift 2 ;;
+    --filter) filter="$2"; shift 2 ;;
+    --out) out="$2"; shift 2 ;;
+    *) echo "unknown argument: $1" >&2; exit 2 ;;
+    esac
+done
+
+mkdir -p "$out"
+summary="$out/summary.txt"
+printf "%-10s %12s %14s %14s\n" "config" "build (s)" "library (KiB)" "bench (KiB)" > "$summary"
+
+kib() {
+    echo $(( $(stat -c %s "$1") / 1024 ))
+}
+
+build() {
+    local dir="$1"
+    shift
+    cmake -S "$root" -B "$dir" -DCMAKE_BUILD_TYPE=Release "$@" > /dev/null
+    cmake --build "$dir" -j"$jobs" > /dev/null
+}
+
+for config in $configs; do
+    dir="$out/build-$config"
+    start=$(date +%s)
+
+    case "$config" in
+    baseline) build "$dir" -DTHREECPP_ENABLE_MULTIVERSIONING=OFF ;;
+    default) build "$dir" ;;
+    lto) build "$dir" -DTHREECPP_ENABLE_LTO=ON ;;
+    native) build "$dir" -DTHREECPP_ARCH=native ;;
+    pgo)
+        build "$dir" -DTHREECPP_PGO=GENERATE
+        cmake --build "$dir" --target pgo_train > /dev/null
+        build "$dir" -DTHREECPP_PGO=USE
+        ;;
+    *) echo "unknown configuration: $config" >&2; exit 2 ;;
+    esac
+
+    seconds=$(( $(date +%s) - start ))
+    printf "%-10s %12d %14d %14d\n" "$config" "$seconds" "$(kib "$dir/lib/libthreecpp.a")" "$(kib "$dir/bin/threecpp_bench")" >> "$summary"
+
+    echo "== $config"
+    "$dir/bin/threecpp_bench" --benchmark_filter="$filter" --benchmark_out="$out/$config.json"
+done
+
+echo
+cat "$summary"